@@ -152,6 +152,36 @@ ccnxContentObject_GetKeyId(const CCNxContentObject *contentObject)
     return result;
 }
 
+bool
+ccnxContentObject_SetUnsigned(CCNxContentObject *contentObject)
+{
+    ccnxContentObject_OptionalAssertValid(contentObject);
+    CCNxContentObjectInterface *impl = ccnxContentObjectInterface_GetInterface(contentObject);
+
+    bool result = false;
+
+    if (impl->setUnsigned != NULL) {
+        result = impl->setUnsigned(contentObject);
+    }
+
+    return result;
+}
+
+bool
+ccnxContentObject_IsUnsigned(const CCNxContentObject *contentObject)
+{
+    ccnxContentObject_OptionalAssertValid(contentObject);
+
+    bool result = false;
+
+    CCNxContentObjectInterface *impl = ccnxContentObjectInterface_GetInterface(contentObject);
+    if (impl->isUnsigned != NULL) {
+        result = impl->isUnsigned(contentObject);
+    }
+
+    return result;
+}
+
 CCNxName *
 ccnxContentObject_GetName(const CCNxContentObject *contentObject)
 {
@@ -410,6 +410,51 @@ bool ccnxContentObject_SetSignature(CCNxContentObject *contentObject, const PARC
  */
 PARCBuffer *ccnxContentObject_GetKeyId(const CCNxContentObject *contentObject);
 
+/**
+ * Mark the specified `CCNxContentObject` to be sent without a signature.
+ *
+ * A `CCNxContentObject` is normally signed when it is encoded with a signer.  When the object is a chunk of a
+ * larger object that is published with a manifest, the manifest binds the chunk by its ContentObjectHash,
+ * so only the root manifest needs a signature.  Marking each chunk unsigned skips the per-chunk signature.
+ *
+ * An object that already has a signature algorithm, e.g. from {@link ccnxContentObject_SetSignature}, cannot be marked unsigned.
+ *
+ * @param [in] contentObject A pointer to the `CCNxContentObject`.
+ *
+ * @return true if the object is now marked unsigned, false otherwise.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxContentObject *chunk = ccnxContentObject_CreateWithNameAndPayload(name, payload);
+ *     ccnxContentObject_SetUnsigned(chunk);
+ *     ccnxManifestBuilder_AppendData(builder, payload);
+ * }
+ * @endcode
+ *
+ * @see `ccnxContentObject_IsUnsigned`
+ * @see `ccnxManifestBuilder_SetRootSigner`
+ */
+bool ccnxContentObject_SetUnsigned(CCNxContentObject *contentObject);
+
+/**
+ * Determine if the specified `CCNxContentObject` is marked to be sent without a signature.
+ *
+ * @param [in] contentObject A pointer to the `CCNxContentObject`.
+ *
+ * @return true if the object was marked with {@link ccnxContentObject_SetUnsigned}, false otherwise.
+ *
+ * Example:
+ * @code
+ * {
+ *     if (ccnxContentObject_IsUnsigned(contentObject)) {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxContentObject_IsUnsigned(const CCNxContentObject *contentObject);
+
 /**
  * Increase the number of references to a `CCNxContentObject`.
  *
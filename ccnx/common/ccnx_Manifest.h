@@ -185,6 +185,9 @@ void ccnxManifest_AssertValid(const CCNxManifest *manifest);
 /**
  * Add a HashGroup to the given `CCNxManifest`.
  *
+ * The manifest keeps a reference to the group, not a copy, so the group should not be modified after it is added.
+ * Groups are numbered in the order they are added, starting from 0.
+ *
  * @param [in] manifest A pointer to an instance of `CCNxManifest`.
  * @param [in] group A pointer to an instance of `CCNxManifestHashGroup`.
  *
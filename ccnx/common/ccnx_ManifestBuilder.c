@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+#include <parc/security/parc_CryptoHasher.h>
+
+#include <ccnx/common/ccnx_ManifestBuilder.h>
+#include <ccnx/common/ccnx_WireFormatMessage.h>
+
+#include <ccnx/common/codec/ccnxCodec_TlvPacket.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_FixedHeader.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_TlvDictionary.h>
+
+#include <ccnx/common/validation/ccnxValidation_RsaSha256.h>
+#include <ccnx/common/validation/ccnxValidation_EcSecp256K1.h>
+#include <ccnx/common/validation/ccnxValidation_HmacSha256.h>
+
+#define _ccnxManifestBuilder_InitialLevelCapacity 8
+
+/*
+ * One level of the tree.  Level 0 points to the data chunks and level n to the manifests of level n - 1.
+ * The group is the manifest of this level that is still being filled, NULL if there is none.
+ */
+typedef struct {
+    CCNxManifestHashGroup *group;
+    uint64_t dataSize;
+} _CCNxManifestBuilderLevel;
+
+struct ccnx_manifest_builder {
+    CCNxName *name;
+    size_t fanout;
+    size_t blockSize;
+    CCNxManifestBuilderEmitter *emitter;
+    void *context;
+
+    size_t numberOfLevels;
+    size_t levelCapacity;
+    _CCNxManifestBuilderLevel *levels;
+
+    // Signs the root, NULL for an unsigned root
+    PARCSigner *rootSigner;
+    PARCBuffer *rootKeyId;
+    CCNxKeyLocator *rootKeyLocator;
+
+    PARCCryptoHasher *chunkHasher;
+    // The hash of all the data, NULL once a chunk has been added by digest
+    PARCCryptoHasher *dataHasher;
+
+    size_t manifestCount;
+    bool finished;
+};
+
+static bool
+_ccnxManifestBuilder_Destructor(CCNxManifestBuilder **builderP)
+{
+    CCNxManifestBuilder *builder = *builderP;
+
+    for (size_t i = 0; i < builder->numberOfLevels; i++) {
+        if (builder->levels[i].group != NULL) {
+            ccnxManifestHashGroup_Release(&builder->levels[i].group);
+        }
+    }
+    parcMemory_Deallocate(&builder->levels);
+
+    if (builder->dataHasher != NULL) {
+        parcCryptoHasher_Release(&builder->dataHasher);
+    }
+    parcCryptoHasher_Release(&builder->chunkHasher);
+
+    if (builder->rootSigner != NULL) {
+        parcSigner_Release(&builder->rootSigner);
+    }
+    if (builder->rootKeyId != NULL) {
+        parcBuffer_Release(&builder->rootKeyId);
+    }
+    if (builder->rootKeyLocator != NULL) {
+        ccnxKeyLocator_Release(&builder->rootKeyLocator);
+    }
+
+    if (builder->name != NULL) {
+        ccnxName_Release(&builder->name);
+    }
+    return true;
+}
+
+parcObject_Override(CCNxManifestBuilder, PARCObject,
+                    .destructor = (PARCObjectDestructor *) _ccnxManifestBuilder_Destructor);
+
+parcObject_ImplementAcquire(ccnxManifestBuilder, CCNxManifestBuilder);
+
+parcObject_ImplementRelease(ccnxManifestBuilder, CCNxManifestBuilder);
+
+CCNxManifestBuilder *
+ccnxManifestBuilder_Create(const CCNxName *name, size_t fanout, size_t blockSize,
+                           CCNxManifestBuilderEmitter *emitter, void *context)
+{
+    assertTrue(fanout >= 2, "A manifest tree needs a fanout of at least 2, got %zu", fanout);
+    assertNotNull(emitter, "Parameter emitter must be non-null");
+
+    CCNxManifestBuilder *result = parcObject_CreateAndClearInstance(CCNxManifestBuilder);
+    if (result != NULL) {
+        result->name = (name != NULL) ? ccnxName_Acquire(name) : NULL;
+        result->fanout = fanout;
+        result->blockSize = blockSize;
+        result->emitter = emitter;
+        result->context = context;
+
+        result->levelCapacity = _ccnxManifestBuilder_InitialLevelCapacity;
+        result->levels = parcMemory_AllocateAndClear(result->levelCapacity * sizeof(_CCNxManifestBuilderLevel));
+        assertNotNull(result->levels, "parcMemory_AllocateAndClear(%zu) returned NULL", result->levelCapacity * sizeof(_CCNxManifestBuilderLevel));
+
+        result->chunkHasher = parcCryptoHasher_Create(PARCCryptoHashType_SHA256);
+        result->dataHasher = parcCryptoHasher_Create(PARCCryptoHashType_SHA256);
+        parcCryptoHasher_Init(result->dataHasher);
+    }
+    return result;
+}
+
+bool
+ccnxManifestBuilder_SetRootSigner(CCNxManifestBuilder *builder, PARCSigner *signer, const PARCBuffer *keyid, const CCNxKeyLocator *keyLocator)
+{
+    assertNotNull(signer, "Parameter signer must be non-null");
+
+    if (builder->finished) {
+        return false;
+    }
+
+    switch (parcSigner_GetSigningAlgorithm(signer)) {
+        case PARCSigningAlgorithm_RSA:
+        case PARCSigningAlgorithm_ECDSA:
+        case PARCSigningAlgorithm_HMAC:
+            break;
+        default:
+            return false;
+    }
+
+    if (builder->rootSigner != NULL) {
+        parcSigner_Release(&builder->rootSigner);
+    }
+    if (builder->rootKeyId != NULL) {
+        parcBuffer_Release(&builder->rootKeyId);
+    }
+    if (builder->rootKeyLocator != NULL) {
+        ccnxKeyLocator_Release(&builder->rootKeyLocator);
+    }
+
+    builder->rootSigner = parcSigner_Acquire(signer);
+    builder->rootKeyId = (keyid != NULL) ? parcBuffer_Acquire(keyid) : NULL;
+    builder->rootKeyLocator = (keyLocator != NULL) ? ccnxKeyLocator_Acquire(keyLocator) : NULL;
+    return true;
+}
+
+/*
+ * Put the ValidationAlg of the root signer in the root manifest.
+ */
+static void
+_ccnxManifestBuilder_SetRootValidation(CCNxManifestBuilder *builder, CCNxManifest *manifest)
+{
+    bool success = false;
+    switch (parcSigner_GetSigningAlgorithm(builder->rootSigner)) {
+        case PARCSigningAlgorithm_RSA:
+            success = ccnxValidationRsaSha256_Set(manifest, builder->rootKeyId, builder->rootKeyLocator);
+            break;
+        case PARCSigningAlgorithm_ECDSA:
+            success = ccnxValidationEcSecp256K1_Set(manifest, builder->rootKeyId, builder->rootKeyLocator);
+            break;
+        case PARCSigningAlgorithm_HMAC:
+            success = ccnxValidationHmacSha256_Set(manifest, builder->rootKeyId);
+            break;
+        default:
+            break;
+    }
+    assertTrue(success, "Could not set the validation algorithm of the root manifest");
+}
+
+/*
+ * Encode the manifest, keep the encoding as its wire format and return its ContentObject hash.
+ * The hash covers everything after the fixed and optional headers, including the signature of a signed root.
+ */
+static PARCCryptoHash *
+_ccnxManifestBuilder_Encode(CCNxManifest *manifest, PARCSigner *signer)
+{
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecTlvPacket_DictionaryEncode(manifest, signer);
+    assertNotNull(vec, "Could not encode the manifest");
+
+    const struct iovec *iov = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(vec) > 0 && iov[0].iov_len >= sizeof(CCNxCodecSchemaV1FixedHeader),
+               "The encoded manifest does not start with a fixed header");
+
+    const CCNxCodecSchemaV1FixedHeader *header = iov[0].iov_base;
+    size_t packetLength = ccnxCodecNetworkBufferIoVec_Length(vec);
+
+    ccnxTlvDictionary_PutInteger(manifest, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ContentObjectHashRegionStart, header->headerLength);
+    ccnxTlvDictionary_PutInteger(manifest, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ContentObjectHashRegionLength, packetLength - header->headerLength);
+    ccnxWireFormatMessage_PutIoVec(manifest, vec);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+
+    return ccnxWireFormatMessage_CreateContentObjectHash(manifest);
+}
+
+static void _ccnxManifestBuilder_AppendPointer(CCNxManifestBuilder *builder, size_t level, CCNxManifestHashGroupPointerType type,
+                                               const PARCBuffer *digest, uint64_t dataSize);
+
+/*
+ * Turn the open group of a level into a manifest, emit it and point to it from the level above.
+ */
+static void
+_ccnxManifestBuilder_FlushLevel(CCNxManifestBuilder *builder, size_t level, bool isRoot)
+{
+    CCNxManifestHashGroup *group = builder->levels[level].group;
+    uint64_t dataSize = builder->levels[level].dataSize;
+    builder->levels[level].group = NULL;
+    builder->levels[level].dataSize = 0;
+
+    ccnxManifestHashGroup_SetTreeHeight(group, level + 1);
+    ccnxManifestHashGroup_SetDataSize(group, dataSize);
+    if (builder->blockSize > 0) {
+        ccnxManifestHashGroup_SetBlockSize(group, builder->blockSize);
+    }
+    if (isRoot && builder->dataHasher != NULL) {
+        PARCCryptoHash *overallHash = parcCryptoHasher_Finalize(builder->dataHasher);
+        ccnxManifestHashGroup_SetOverallDataDigest(group, parcCryptoHash_GetDigest(overallHash));
+        parcCryptoHash_Release(&overallHash);
+    }
+
+    CCNxManifest *manifest;
+    if (isRoot && builder->name != NULL) {
+        manifest = ccnxManifest_Create(builder->name);
+    } else {
+        manifest = ccnxManifest_CreateNameless();
+    }
+    ccnxManifest_AddHashGroup(manifest, group);
+    ccnxManifestHashGroup_Release(&group);
+
+    PARCSigner *signer = NULL;
+    if (isRoot && builder->rootSigner != NULL) {
+        _ccnxManifestBuilder_SetRootValidation(builder, manifest);
+        signer = builder->rootSigner;
+    }
+
+    PARCCryptoHash *hash = _ccnxManifestBuilder_Encode(manifest, signer);
+    assertNotNull(hash, "Could not compute the ContentObject hash of the manifest");
+    const PARCBuffer *digest = parcCryptoHash_GetDigest(hash);
+
+    builder->emitter(manifest, digest, isRoot, builder->context);
+    builder->manifestCount++;
+
+    if (!isRoot) {
+        _ccnxManifestBuilder_AppendPointer(builder, level + 1, CCNxManifestHashGroupPointerType_Manifest, digest, dataSize);
+    }
+
+    parcCryptoHash_Release(&hash);
+    ccnxManifest_Release(&manifest);
+}
+
+static void
+_ccnxManifestBuilder_AppendPointer(CCNxManifestBuilder *builder, size_t level, CCNxManifestHashGroupPointerType type,
+                                   const PARCBuffer *digest, uint64_t dataSize)
+{
+    if (level == builder->numberOfLevels) {
+        if (builder->numberOfLevels == builder->levelCapacity) {
+            size_t capacity = builder->levelCapacity * 2;
+            builder->levels = parcMemory_Reallocate(builder->levels, capacity * sizeof(_CCNxManifestBuilderLevel));
+            assertNotNull(builder->levels, "parcMemory_Reallocate(%zu) returned NULL", capacity * sizeof(_CCNxManifestBuilderLevel));
+            builder->levelCapacity = capacity;
+        }
+        builder->levels[level].group = NULL;
+        builder->levels[level].dataSize = 0;
+        builder->numberOfLevels++;
+    }
+
+    // A full group is only flushed when the next pointer arrives, so the last group of a level can become the root.
+    if (builder->levels[level].group != NULL && ccnxManifestHashGroup_GetNumberOfPointers(builder->levels[level].group) >= builder->fanout) {
+        _ccnxManifestBuilder_FlushLevel(builder, level, false);
+    }
+
+    _CCNxManifestBuilderLevel *entry = &builder->levels[level];
+    if (entry->group == NULL) {
+        entry->group = ccnxManifestHashGroup_Create();
+    }
+
+    bool added = ccnxManifestHashGroup_AppendPointer(entry->group, type, digest);
+    assertTrue(added, "Could not add pointer %zu to a manifest at level %zu, fanout %zu",
+               ccnxManifestHashGroup_GetNumberOfPointers(entry->group), level, builder->fanout);
+    entry->dataSize += dataSize;
+}
+
+bool
+ccnxManifestBuilder_AppendDigest(CCNxManifestBuilder *builder, const PARCBuffer *digest, size_t dataSize)
+{
+    if (builder->finished || parcBuffer_Remaining(digest) > CCNxManifestHashGroup_MaxDigestLength) {
+        return false;
+    }
+
+    if (builder->dataHasher != NULL) {
+        parcCryptoHasher_Release(&builder->dataHasher);
+    }
+
+    _ccnxManifestBuilder_AppendPointer(builder, 0, CCNxManifestHashGroupPointerType_Data, digest, dataSize);
+    return true;
+}
+
+bool
+ccnxManifestBuilder_AppendData(CCNxManifestBuilder *builder, const PARCBuffer *data)
+{
+    if (builder->finished) {
+        return false;
+    }
+
+    if (builder->dataHasher != NULL) {
+        parcCryptoHasher_UpdateBuffer(builder->dataHasher, data);
+    }
+
+    parcCryptoHasher_Init(builder->chunkHasher);
+    parcCryptoHasher_UpdateBuffer(builder->chunkHasher, data);
+    PARCCryptoHash *hash = parcCryptoHasher_Finalize(builder->chunkHasher);
+
+    _ccnxManifestBuilder_AppendPointer(builder, 0, CCNxManifestHashGroupPointerType_Data, parcCryptoHash_GetDigest(hash), parcBuffer_Remaining(data));
+
+    parcCryptoHash_Release(&hash);
+    return true;
+}
+
+size_t
+ccnxManifestBuilder_Finish(CCNxManifestBuilder *builder)
+{
+    if (builder->finished) {
+        return builder->manifestCount;
+    }
+    builder->finished = true;
+
+    if (builder->numberOfLevels == 0) {
+        builder->levels[0].group = ccnxManifestHashGroup_Create();
+        builder->levels[0].dataSize = 0;
+        builder->numberOfLevels = 1;
+    }
+
+    // Close the open group of each level from the bottom up.  Flushing a level can add a level above it,
+    // so the top is found again on each pass.  The top level always has an open group, and it is the root.
+    for (size_t level = 0; level < builder->numberOfLevels; level++) {
+        if (level == builder->numberOfLevels - 1) {
+            _ccnxManifestBuilder_FlushLevel(builder, level, true);
+        } else if (builder->levels[level].group != NULL) {
+            _ccnxManifestBuilder_FlushLevel(builder, level, false);
+        }
+    }
+
+    return builder->manifestCount;
+}
+
+size_t
+ccnxManifestBuilder_GetTreeHeight(const CCNxManifestBuilder *builder)
+{
+    return builder->numberOfLevels;
+}
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file ccnx_ManifestBuilder.h
+ * @ingroup ContentObject
+ * @brief Build the manifest tree of a large object one chunk at a time.
+ *
+ * A `CCNxManifestBuilder` takes the chunks of an object in order, either as the digests of the
+ * chunks or as the chunk data itself, and produces the FLIC-style manifest tree that points to them.
+ * Each manifest is encoded and handed to a caller supplied {@link CCNxManifestBuilderEmitter}
+ * as soon as it is complete, leaves first and the root last.
+ *
+ * The builder holds one partly filled hash group per level of the tree, so its memory use grows with the
+ * height of the tree, not the size of the object.
+ *
+ * Every hash group carries `TreeHeight`, `DataSize` and `BlockSize` metadata.
+ * If the chunks were given as data, the root also carries the `OverallDataSha256` of the whole object.
+ *
+ * Only the root needs a signature: it binds its children by ContentObjectHash, and they bind theirs, down to
+ * the data chunks.  Give the builder a signer with {@link ccnxManifestBuilder_SetRootSigner} and publish the chunks
+ * unsigned with {@link ccnxContentObject_SetUnsigned}, so an object of N chunks costs one signature instead of N.
+ *
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef libccnx_ccnx_ManifestBuilder_h
+#define libccnx_ccnx_ManifestBuilder_h
+
+#include <stdbool.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/security/parc_Signer.h>
+
+#include <ccnx/common/ccnx_Name.h>
+#include <ccnx/common/ccnx_Manifest.h>
+#include <ccnx/common/ccnx_KeyLocator.h>
+
+struct ccnx_manifest_builder;
+/**
+ * @typedef CCNxManifestBuilder
+ * @brief Builds a manifest tree incrementally.
+ */
+typedef struct ccnx_manifest_builder CCNxManifestBuilder;
+
+/**
+ * @typedef CCNxManifestBuilderEmitter
+ * @brief The function called with each manifest the builder completes.
+ *
+ * The manifest holds its encoded wire format, and `digest` is its ContentObject hash,
+ * the value its parent uses to point to it.
+ * Both are valid only for the duration of the call.  Acquire them to keep them.
+ *
+ * @param [in] manifest The completed manifest.
+ * @param [in] digest The SHA-256 ContentObject hash of the encoded manifest.
+ * @param [in] isRoot true if this is the root of the tree and the last manifest emitted.
+ * @param [in] context The context given to {@link ccnxManifestBuilder_Create}.
+ */
+typedef void (CCNxManifestBuilderEmitter)(CCNxManifest *manifest, const PARCBuffer *digest, bool isRoot, void *context);
+
+/**
+ * Create a new `CCNxManifestBuilder`.
+ *
+ * Only the root manifest is given `name`.  The other manifests are nameless, so their ContentObject hash
+ * does not change when they are published and they are retrieved by hash restriction.
+ *
+ * @param [in] name The name of the root manifest, or NULL for a nameless root.
+ * @param [in] fanout The most pointers in one manifest, at least 2.
+ * @param [in] blockSize The size of each data chunk, recorded as the `BlockSize` metadata.
+ * @param [in] emitter The function called with each completed manifest.
+ * @param [in] context Passed to `emitter`.
+ *
+ * @return A pointer to a new `CCNxManifestBuilder` instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(name, 1000, 4096, _publishManifest, portal);
+ *
+ *     ccnxManifestBuilder_Release(&builder);
+ * }
+ * @endcode
+ */
+CCNxManifestBuilder *ccnxManifestBuilder_Create(const CCNxName *name, size_t fanout, size_t blockSize,
+                                                CCNxManifestBuilderEmitter *emitter, void *context);
+
+/**
+ * Increase the number of references to a `CCNxManifestBuilder`.
+ *
+ * @param [in] builder A pointer to a `CCNxManifestBuilder` instance.
+ * @return The value of the input parameter @p builder.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxManifestBuilder *reference = ccnxManifestBuilder_Acquire(builder);
+ *
+ *     ccnxManifestBuilder_Release(&reference);
+ * }
+ * @endcode
+ */
+CCNxManifestBuilder *ccnxManifestBuilder_Acquire(const CCNxManifestBuilder *builder);
+
+/**
+ * Release a previously acquired reference to the specified `CCNxManifestBuilder` instance,
+ * decrementing the reference count for the instance.
+ *
+ * Releasing a builder before {@link ccnxManifestBuilder_Finish} discards the partly built tree.
+ *
+ * @param [in,out] builderP A pointer to a pointer to the instance to release.
+ *
+ * Example:
+ * @code
+ * {
+ *     ccnxManifestBuilder_Release(&builder);
+ * }
+ * @endcode
+ */
+void ccnxManifestBuilder_Release(CCNxManifestBuilder **builderP);
+
+/**
+ * Sign the root manifest with `signer`.
+ *
+ * The root gets the ValidationAlg matching the signer's algorithm, RSA-SHA256, ECSECP256K1 or HMAC-SHA256,
+ * and a ValidationPayload computed over its wire format.  The other manifests stay unsigned.
+ * Call this before {@link ccnxManifestBuilder_Finish}.
+ *
+ * @param [in] builder A `CCNxManifestBuilder` instance.
+ * @param [in] signer The signer for the root manifest.
+ * @param [in] keyid The KeyId to put in the ValidationAlg, may be NULL.
+ * @param [in] keyLocator The KeyLocator to put in the ValidationAlg, may be NULL.  HMAC does not use it.
+ *
+ * @return true The root will be signed.
+ * @return false The signer's algorithm has no CCNx validation type, or the root has already been emitted.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(name, 1000, 4096, _publishManifest, portal);
+ *     ccnxManifestBuilder_SetRootSigner(builder, signer, keyid, NULL);
+ *
+ *     for (size_t i = 0; i < chunkCount; i++) {
+ *         CCNxContentObject *chunk = ccnxContentObject_CreateWithPayload(chunks[i]);
+ *         ccnxContentObject_SetUnsigned(chunk);
+ *         _publishChunk(portal, chunk);
+ *         ccnxManifestBuilder_AppendData(builder, chunks[i]);
+ *         ccnxContentObject_Release(&chunk);
+ *     }
+ *     ccnxManifestBuilder_Finish(builder);
+ * }
+ * @endcode
+ */
+bool ccnxManifestBuilder_SetRootSigner(CCNxManifestBuilder *builder, PARCSigner *signer, const PARCBuffer *keyid, const CCNxKeyLocator *keyLocator);
+
+/**
+ * Add the next chunk of the object by its digest.
+ *
+ * Usually the digest is the ContentObject hash of the chunk's ContentObject.
+ * A builder given digests cannot compute the `OverallDataSha256` of the object.
+ *
+ * @param [in] builder A `CCNxManifestBuilder` instance.
+ * @param [in] digest The digest of the chunk, at most `CCNxManifestHashGroup_MaxDigestLength` bytes.
+ * @param [in] dataSize The number of bytes in the chunk.
+ *
+ * @return true The chunk was added.
+ * @return false The digest is too long or the builder has finished.
+ *
+ * Example:
+ * @code
+ * {
+ *     ccnxManifestBuilder_AppendDigest(builder, chunkHash, chunkLength);
+ * }
+ * @endcode
+ */
+bool ccnxManifestBuilder_AppendDigest(CCNxManifestBuilder *builder, const PARCBuffer *digest, size_t dataSize);
+
+/**
+ * Add the next chunk of the object by its data.
+ *
+ * The chunk is pointed to by the SHA-256 digest of its bytes, and the bytes are added to the `OverallDataSha256` of the object.
+ *
+ * @param [in] builder A `CCNxManifestBuilder` instance.
+ * @param [in] data The chunk, from its position to its limit.
+ *
+ * @return true The chunk was added.
+ * @return false The builder has finished.
+ *
+ * Example:
+ * @code
+ * {
+ *     ccnxManifestBuilder_AppendData(builder, chunk);
+ * }
+ * @endcode
+ */
+bool ccnxManifestBuilder_AppendData(CCNxManifestBuilder *builder, const PARCBuffer *data);
+
+/**
+ * Complete the tree, emitting every manifest still open and the root last.
+ *
+ * After this the builder accepts no more chunks.  A builder given no chunks emits a root manifest with no pointers.
+ *
+ * @param [in] builder A `CCNxManifestBuilder` instance.
+ *
+ * @return The number of manifests emitted over the life of the builder.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t manifests = ccnxManifestBuilder_Finish(builder);
+ * }
+ * @endcode
+ */
+size_t ccnxManifestBuilder_Finish(CCNxManifestBuilder *builder);
+
+/**
+ * Get the height of the tree built so far, 1 for a tree that is a single manifest and 0 before any chunk is added.
+ *
+ * @param [in] builder A `CCNxManifestBuilder` instance.
+ *
+ * @return The height of the tree.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t height = ccnxManifestBuilder_GetTreeHeight(builder);
+ * }
+ * @endcode
+ */
+size_t ccnxManifestBuilder_GetTreeHeight(const CCNxManifestBuilder *builder);
+#endif // libccnx_ccnx_ManifestBuilder_h
@@ -70,9 +70,19 @@
 #include <ccnx/common/internal/ccnx_WireFormatMessageInterface.h>
 
 #define MAX_NUMBER_OF_POINTERS 1500 // loose upper bound imposed by packet format
+#define _ccnxManifestHashGroup_InitialCapacity 16
 
 struct ccnx_manifest_hash_group {
-    PARCLinkedList *pointers;
+    // The pointers are a flat table with one CCNxManifestHashGroup_MaxDigestLength slot per digest,
+    // so a pointer is found by index and the digests can be encoded straight from the table.
+    size_t numberOfPointers;
+    size_t capacity;
+    uint8_t *digests;
+    uint8_t *digestLengths;
+    uint8_t *manifestBitmap; // bit i is set if pointer i is a Manifest pointer, clear if Data
+
+    // The CCNxManifestHashGroupPointer objects returned by ccnxManifestHashGroup_GetPointerAtIndex, created on demand
+    CCNxManifestHashGroupPointer **pointerObjects;
 
     // Metadata
     const PARCBuffer *overallDataDigest; // overall *application data* digest
@@ -147,8 +157,17 @@ ccnxManifestHashGroupPointer_GetDigest(const CCNxManifestHashGroupPointer *ptr)
 static bool
 _ccnxManifestHashGroup_Destructor(CCNxManifestHashGroup **groupP)
 {
-    if ((*groupP)->pointers != NULL) {
-        parcLinkedList_Release(&(*groupP)->pointers);
+    CCNxManifestHashGroup *group = *groupP;
+    if (group->capacity > 0) {
+        for (size_t i = 0; i < group->numberOfPointers; i++) {
+            if (group->pointerObjects[i] != NULL) {
+                ccnxManifestHashGroupPointer_Release(&group->pointerObjects[i]);
+            }
+        }
+        parcMemory_Deallocate(&group->pointerObjects);
+        parcMemory_Deallocate(&group->manifestBitmap);
+        parcMemory_Deallocate(&group->digestLengths);
+        parcMemory_Deallocate(&group->digests);
     }
     if ((*groupP)->overallDataDigest != NULL) {
         parcBuffer_Release((PARCBuffer **) &(*groupP)->overallDataDigest);
@@ -173,7 +192,8 @@ ccnxManifestHashGroup_Create(void)
     CCNxManifestHashGroup *section = parcObject_CreateAndClearInstance(CCNxManifestHashGroup);
 
     if (section != NULL) {
-        section->pointers = parcLinkedList_Create();
+        section->numberOfPointers = 0;
+        section->capacity = 0;
 
         section->overallDataDigest = NULL;
         section->dataSize = 0;
@@ -186,28 +206,138 @@ ccnxManifestHashGroup_Create(void)
     return section;
 }
 
+static inline const uint8_t *
+_ccnxManifestHashGroup_DigestAt(const CCNxManifestHashGroup *group, size_t index)
+{
+    return &group->digests[index * CCNxManifestHashGroup_MaxDigestLength];
+}
+
+static inline bool
+_ccnxManifestHashGroup_IsManifestPointer(const CCNxManifestHashGroup *group, size_t index)
+{
+    return (group->manifestBitmap[index / 8] & (1 << (index % 8))) != 0;
+}
+
+static inline void
+_ccnxManifestHashGroup_SetManifestPointer(CCNxManifestHashGroup *group, size_t index, bool isManifest)
+{
+    if (isManifest) {
+        group->manifestBitmap[index / 8] |= (uint8_t) (1 << (index % 8));
+    } else {
+        group->manifestBitmap[index / 8] &= (uint8_t) ~(1 << (index % 8));
+    }
+}
+
+static void
+_ccnxManifestHashGroup_EnsureCapacity(CCNxManifestHashGroup *group, size_t count)
+{
+    if (count <= group->capacity) {
+        return;
+    }
+
+    size_t capacity = (group->capacity == 0) ? _ccnxManifestHashGroup_InitialCapacity : group->capacity * 2;
+    while (capacity < count) {
+        capacity *= 2;
+    }
+    if (capacity > MAX_NUMBER_OF_POINTERS) {
+        capacity = MAX_NUMBER_OF_POINTERS;
+    }
+
+    size_t bitmapLength = (capacity + 7) / 8;
+    if (group->capacity == 0) {
+        group->digests = parcMemory_Allocate(capacity * CCNxManifestHashGroup_MaxDigestLength);
+        group->digestLengths = parcMemory_Allocate(capacity);
+        group->manifestBitmap = parcMemory_AllocateAndClear(bitmapLength);
+        group->pointerObjects = parcMemory_AllocateAndClear(capacity * sizeof(CCNxManifestHashGroupPointer *));
+    } else {
+        size_t oldBitmapLength = (group->capacity + 7) / 8;
+        group->digests = parcMemory_Reallocate(group->digests, capacity * CCNxManifestHashGroup_MaxDigestLength);
+        group->digestLengths = parcMemory_Reallocate(group->digestLengths, capacity);
+        group->manifestBitmap = parcMemory_Reallocate(group->manifestBitmap, bitmapLength);
+        memset(&group->manifestBitmap[oldBitmapLength], 0, bitmapLength - oldBitmapLength);
+        group->pointerObjects = parcMemory_Reallocate(group->pointerObjects, capacity * sizeof(CCNxManifestHashGroupPointer *));
+    }
+    assertNotNull(group->digests, "parcMemory_Reallocate(%zu) returned NULL", capacity * CCNxManifestHashGroup_MaxDigestLength);
+    assertNotNull(group->digestLengths, "parcMemory_Reallocate(%zu) returned NULL", capacity);
+    assertNotNull(group->manifestBitmap, "parcMemory_Reallocate(%zu) returned NULL", bitmapLength);
+    assertNotNull(group->pointerObjects, "parcMemory_Reallocate(%zu) returned NULL", capacity * sizeof(CCNxManifestHashGroupPointer *));
+
+    group->capacity = capacity;
+}
+
+static bool
+_ccnxManifestHashGroup_InsertPointer(CCNxManifestHashGroup *group, size_t index, CCNxManifestHashGroupPointerType type, const PARCBuffer *buffer)
+{
+    size_t length = parcBuffer_Remaining(buffer);
+    if (ccnxManifestHashGroup_IsFull(group) || length > CCNxManifestHashGroup_MaxDigestLength) {
+        return false;
+    }
+
+    _ccnxManifestHashGroup_EnsureCapacity(group, group->numberOfPointers + 1);
+
+    size_t moved = group->numberOfPointers - index;
+    if (moved > 0) {
+        memmove(&group->digests[(index + 1) * CCNxManifestHashGroup_MaxDigestLength],
+                &group->digests[index * CCNxManifestHashGroup_MaxDigestLength],
+                moved * CCNxManifestHashGroup_MaxDigestLength);
+        memmove(&group->digestLengths[index + 1], &group->digestLengths[index], moved);
+        memmove(&group->pointerObjects[index + 1], &group->pointerObjects[index], moved * sizeof(CCNxManifestHashGroupPointer *));
+        for (size_t i = group->numberOfPointers; i > index; i--) {
+            _ccnxManifestHashGroup_SetManifestPointer(group, i, _ccnxManifestHashGroup_IsManifestPointer(group, i - 1));
+        }
+    }
+
+    uint8_t *digest = &group->digests[index * CCNxManifestHashGroup_MaxDigestLength];
+    memcpy(digest, parcBuffer_Overlay((PARCBuffer *) buffer, 0), length);
+    memset(&digest[length], 0, CCNxManifestHashGroup_MaxDigestLength - length);
+    group->digestLengths[index] = (uint8_t) length;
+    group->pointerObjects[index] = NULL;
+    _ccnxManifestHashGroup_SetManifestPointer(group, index, type == CCNxManifestHashGroupPointerType_Manifest);
+
+    group->numberOfPointers++;
+    return true;
+}
+
 bool
 ccnxManifestHashGroup_AppendPointer(CCNxManifestHashGroup *group, CCNxManifestHashGroupPointerType type, const PARCBuffer *buffer)
 {
-    if (!ccnxManifestHashGroup_IsFull(group)) {
-        CCNxManifestHashGroupPointer *ptr = ccnxManifestHashGroupPointer_Create(type, buffer);
-        parcLinkedList_Append(group->pointers, ptr);
-        ccnxManifestHashGroupPointer_Release(&ptr);
-        return true;
-    }
-    return false;
+    return _ccnxManifestHashGroup_InsertPointer(group, group->numberOfPointers, type, buffer);
 }
 
 bool
 ccnxManifestHashGroup_PrependPointer(CCNxManifestHashGroup *group, CCNxManifestHashGroupPointerType type, const PARCBuffer *buffer)
 {
-    if (!ccnxManifestHashGroup_IsFull(group)) {
-        CCNxManifestHashGroupPointer *ptr = ccnxManifestHashGroupPointer_Create(type, buffer);
-        parcLinkedList_Prepend(group->pointers, ptr);
-        ccnxManifestHashGroupPointer_Release(&ptr);
-        return true;
+    return _ccnxManifestHashGroup_InsertPointer(group, 0, type, buffer);
+}
+
+CCNxManifestHashGroup *
+ccnxManifestHashGroup_Copy(const CCNxManifestHashGroup *group)
+{
+    CCNxManifestHashGroup *copy = ccnxManifestHashGroup_Create();
+
+    if (copy != NULL) {
+        size_t count = group->numberOfPointers;
+        if (count > 0) {
+            _ccnxManifestHashGroup_EnsureCapacity(copy, count);
+            memcpy(copy->digests, group->digests, count * CCNxManifestHashGroup_MaxDigestLength);
+            memcpy(copy->digestLengths, group->digestLengths, count);
+            memcpy(copy->manifestBitmap, group->manifestBitmap, (count + 7) / 8);
+            copy->numberOfPointers = count;
+        }
+
+        if (group->overallDataDigest != NULL) {
+            copy->overallDataDigest = parcBuffer_Acquire(group->overallDataDigest);
+        }
+        if (group->locator != NULL) {
+            copy->locator = ccnxName_Acquire(group->locator);
+        }
+        copy->dataSize = group->dataSize;
+        copy->entrySize = group->entrySize;
+        copy->blockSize = group->blockSize;
+        copy->treeHeight = group->treeHeight;
     }
-    return false;
+
+    return copy;
 }
 
 void
@@ -249,35 +379,68 @@ ccnxManifestHashGroup_GetLocator(const CCNxManifestHashGroup *group)
 size_t
 ccnxManifestHashGroup_GetNumberOfPointers(const CCNxManifestHashGroup *group)
 {
-    return parcLinkedList_Size(group->pointers);
+    return group->numberOfPointers;
 }
 
 CCNxManifestHashGroupPointer *
 ccnxManifestHashGroup_GetPointerAtIndex(const CCNxManifestHashGroup *group, size_t index)
 {
-    CCNxManifestHashGroupPointer *entry = parcLinkedList_GetAtIndex(group->pointers, index);
-    return entry;
+    assertTrue(index < group->numberOfPointers, "Index %zu out of range, the group has %zu pointers", index, group->numberOfPointers);
+
+    CCNxManifestHashGroupPointer *result = group->pointerObjects[index];
+
+    if (result == NULL) {
+        PARCBuffer *digest = parcBuffer_Flip(parcBuffer_CreateFromArray(_ccnxManifestHashGroup_DigestAt(group, index), group->digestLengths[index]));
+        result = ccnxManifestHashGroupPointer_Create(ccnxManifestHashGroup_GetPointerTypeAtIndex(group, index), digest);
+        parcBuffer_Release(&digest);
+
+        // The pointer cache is not part of the value of the group, so filling it is permitted on a const group.
+        // If another thread filled this slot first, use its pointer and discard ours.
+        if (!__sync_bool_compare_and_swap(&group->pointerObjects[index], NULL, result)) {
+            ccnxManifestHashGroupPointer_Release(&result);
+            result = group->pointerObjects[index];
+        }
+    }
+
+    return result;
 }
 
 CCNxManifestHashGroupPointerType
 ccnxManifestHashGroup_GetPointerTypeAtIndex(const CCNxManifestHashGroup *group, size_t index)
 {
-    CCNxManifestHashGroupPointer *entry = parcLinkedList_GetAtIndex(group->pointers, index);
-    return entry->pointerType;
+    assertTrue(index < group->numberOfPointers, "Index %zu out of range, the group has %zu pointers", index, group->numberOfPointers);
+
+    if (_ccnxManifestHashGroup_IsManifestPointer(group, index)) {
+        return CCNxManifestHashGroupPointerType_Manifest;
+    }
+    return CCNxManifestHashGroupPointerType_Data;
 }
 
 PARCBuffer *
 ccnxManifestHashGroup_GetPointerDigestAtIndex(const CCNxManifestHashGroup *group, size_t index)
 {
-    CCNxManifestHashGroupPointer *entry = parcLinkedList_GetAtIndex(group->pointers, index);
+    CCNxManifestHashGroupPointer *entry = ccnxManifestHashGroup_GetPointerAtIndex(group, index);
     return entry->digest;
 }
 
+bool
+ccnxManifestHashGroup_GetPointerBytesAtIndex(const CCNxManifestHashGroup *group, size_t index,
+                                             CCNxManifestHashGroupPointerType *typePtr, const uint8_t **digestPtr, size_t *lengthPtr)
+{
+    if (index >= group->numberOfPointers) {
+        return false;
+    }
+
+    *typePtr = ccnxManifestHashGroup_GetPointerTypeAtIndex(group, index);
+    *digestPtr = _ccnxManifestHashGroup_DigestAt(group, index);
+    *lengthPtr = group->digestLengths[index];
+    return true;
+}
+
 bool
 ccnxManifestHashGroup_IsFull(const CCNxManifestHashGroup *group)
 {
-    size_t size = parcLinkedList_Size(group->pointers);
-    return size >= MAX_NUMBER_OF_POINTERS;
+    return group->numberOfPointers >= MAX_NUMBER_OF_POINTERS;
 }
 
 bool
@@ -296,11 +459,15 @@ ccnxManifestHashGroup_Equals(const CCNxManifestHashGroup *objectA, const CCNxMan
                 if (objectA->treeHeight == objectB->treeHeight) {
                     if (ccnxName_Equals(objectA->locator, objectB->locator)) {
                         if (parcBuffer_Equals(objectA->overallDataDigest, objectB->overallDataDigest)) {
-                            if (parcLinkedList_Size(objectA->pointers) == parcLinkedList_Size(objectB->pointers)) {
-                                for (size_t i = 0; i < parcLinkedList_Size(objectA->pointers); i++) {
-                                    CCNxManifestHashGroupPointer *ptrA = parcLinkedList_GetAtIndex(objectA->pointers, i);
-                                    CCNxManifestHashGroupPointer *ptrB = parcLinkedList_GetAtIndex(objectB->pointers, i);
-                                    if (!_CCNxManifestHashGroupPointer_Equals(ptrA, ptrB)) {
+                            if (objectA->numberOfPointers == objectB->numberOfPointers) {
+                                for (size_t i = 0; i < objectA->numberOfPointers; i++) {
+                                    if (_ccnxManifestHashGroup_IsManifestPointer(objectA, i) != _ccnxManifestHashGroup_IsManifestPointer(objectB, i)) {
+                                        return false;
+                                    }
+                                    if (objectA->digestLengths[i] != objectB->digestLengths[i]) {
+                                        return false;
+                                    }
+                                    if (memcmp(_ccnxManifestHashGroup_DigestAt(objectA, i), _ccnxManifestHashGroup_DigestAt(objectB, i), objectA->digestLengths[i]) != 0) {
                                         return false;
                                     }
                                 }
@@ -331,17 +498,21 @@ ccnxManifestHashGroup_ToJson(const CCNxManifestHashGroup *group)
     PARCJSON *root = parcJSON_Create();
 
     PARCJSONArray *ptrList = parcJSONArray_Create();
-    for (size_t i = 0; i < parcLinkedList_Size(group->pointers); i++) {
-        CCNxManifestHashGroupPointer *ptr = (CCNxManifestHashGroupPointer *) parcLinkedList_GetAtIndex(group->pointers, i);
+    CCNxManifestHashGroupPointerType type;
+    const uint8_t *digestBytes;
+    size_t digestLength;
+    for (size_t i = 0; ccnxManifestHashGroup_GetPointerBytesAtIndex(group, i, &type, &digestBytes, &digestLength); i++) {
         PARCJSON *ptrJson = parcJSON_Create();
 
         // Type.
-        parcJSON_AddInteger(ptrJson, "type", ccnxManifestHashGroupPointer_GetType(ptr));
+        parcJSON_AddInteger(ptrJson, "type", type);
 
         // Digest.
-        char *digestString = parcBuffer_ToHexString(ptr->digest);
+        PARCBuffer *digest = parcBuffer_Wrap((uint8_t *) digestBytes, digestLength, 0, digestLength);
+        char *digestString = parcBuffer_ToHexString(digest);
         parcJSON_AddString(ptrJson, "digest", digestString);
         parcMemory_Deallocate(&digestString);
+        parcBuffer_Release(&digest);
 
         // Add the tuple to the list.
         PARCJSONValue *val = parcJSONValue_CreateFromJSON(ptrJson);
@@ -469,7 +640,7 @@ _ccnxManifestHashGroupIterator_Init(CCNxManifestHashGroup *group)
 {
     _HashgroupIteratorState *state = parcMemory_Allocate(sizeof(_HashgroupIteratorState));
     state->pointerNumber = 0;
-    state->atEnd = false;
+    state->atEnd = (group->numberOfPointers == 0);
     return state;
 }
 
@@ -486,7 +657,7 @@ _ccnxManifestHashGroupIterator_Next(CCNxManifestHashGroup *group, void *state)
     _HashgroupIteratorState *thestate = (_HashgroupIteratorState *) state;
     thestate->pointerNumber++;
 
-    if (thestate->pointerNumber == parcLinkedList_Size(group->pointers)) {
+    if (thestate->pointerNumber == group->numberOfPointers) {
         thestate->atEnd = true;
     }
 
@@ -503,9 +674,7 @@ static void *
 _ccnxManifestHashGroupIterator_GetElement(CCNxManifestHashGroup *group, void *state)
 {
     _HashgroupIteratorState *thestate = (_HashgroupIteratorState *) state;
-    CCNxManifestHashGroupPointer *ptr =
-        (CCNxManifestHashGroupPointer *) parcLinkedList_GetAtIndex(group->pointers, thestate->pointerNumber - 1);
-    return ptr;
+    return ccnxManifestHashGroup_GetPointerAtIndex(group, thestate->pointerNumber - 1);
 }
 
 static void
@@ -597,6 +766,9 @@ ccnxManifestHashGroup_HasMetadata(const CCNxManifestHashGroup *group)
     if (group->entrySize > 0) {
         return true;
     }
+    if (group->treeHeight > 0) {
+        return true;
+    }
     if (group->locator != NULL) {
         return true;
     }
@@ -612,22 +784,21 @@ ccnxManifestHashGroup_CreateInterestList(const CCNxManifestHashGroup *group, con
 {
     PARCLinkedList *interestList = parcLinkedList_Create();
 
-    PARCIterator *itr = ccnxManifestHashGroup_Iterator(group);
-    while (parcIterator_HasNext(itr)) {
-        // Extract the name and digest
-        CCNxManifestHashGroupPointer *ptr = parcIterator_Next(itr);
-        const PARCBuffer *digest = ccnxManifestHashGroupPointer_GetDigest(ptr);
-        const CCNxName *name = group->locator == NULL ? locator : group->locator;
-
-        // Build the interest and append it to the running list
-        if (name != NULL) {
+    const CCNxName *name = group->locator == NULL ? locator : group->locator;
+    if (name != NULL) {
+        CCNxManifestHashGroupPointerType type;
+        const uint8_t *digestBytes;
+        size_t digestLength;
+        for (size_t i = 0; ccnxManifestHashGroup_GetPointerBytesAtIndex(group, i, &type, &digestBytes, &digestLength); i++) {
+            // Build the interest and append it to the running list
+            PARCBuffer *digest = parcBuffer_Flip(parcBuffer_CreateFromArray(digestBytes, digestLength));
             CCNxInterest *interest = ccnxInterest_CreateSimple(name);
             ccnxInterest_SetContentObjectHashRestriction(interest, digest);
             parcLinkedList_Append(interestList, interest);
             ccnxInterest_Release(&interest);
+            parcBuffer_Release(&digest);
         }
     }
-    parcIterator_Release(&itr);
 
     return interestList;
 }
@@ -81,6 +81,11 @@ struct ccnx_manifest_hash_group;
  */
 typedef struct ccnx_manifest_hash_group CCNxManifestHashGroup;
 
+/**
+ * The largest pointer digest a {@link CCNxManifestHashGroup} can hold, the length of a SHA-256 digest.
+ */
+#define CCNxManifestHashGroup_MaxDigestLength 32
+
 typedef enum {
     CCNxManifestHashGroupPointerType_Data,
     CCNxManifestHashGroupPointerType_Manifest
@@ -173,6 +178,27 @@ CCNxManifestHashGroup *ccnxManifestHashGroup_Create();
  */
 CCNxManifestHashGroup *ccnxManifestHashGroup_CreateFromJson(const PARCJSON *jsonRepresentation);
 
+/**
+ * Create an independent copy of a {@link CCNxManifestHashGroup}.
+ *
+ * The copy has the same pointers and metadata.  Changing one group afterwards does not change the other.
+ *
+ * @param [in] group A pointer to the {@link CCNxManifestHashGroup} to copy.
+ *
+ * @return A pointer to a new {@link CCNxManifestHashGroup} instance, or NULL if out of memory.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxManifestHashGroup *copy = ccnxManifestHashGroup_Copy(group);
+ *     ccnxManifestHashGroup_AppendPointer(group, CCNxManifestHashGroupPointerType_Data, digest);
+ *     // copy still has the old pointers
+ *     ccnxManifestHashGroup_Release(&copy);
+ * }
+ * @endcode
+ */
+CCNxManifestHashGroup *ccnxManifestHashGroup_Copy(const CCNxManifestHashGroup *group);
+
 /**
  * Increase the number of references to an instance of this object.
  *
@@ -245,6 +271,9 @@ void ccnxManifestHashGroup_AssertValid(const CCNxManifestHashGroup *manifest);
  * @param [in] type - The {@link CCNxManifestHashGroupPointerType} type.
  * @param [in] buffer - The {@link PARCBuffer} containing the pointer digest.
  *
+ * @return true The pointer was added.
+ * @return false The group is full, or the digest is longer than `CCNxManifestHashGroup_MaxDigestLength`.
+ *
  * Example:
  * @code
  * {
@@ -268,6 +297,9 @@ bool ccnxManifestHashGroup_AppendPointer(CCNxManifestHashGroup *group, CCNxManif
  * @param [in] type - The {@link CCNxManifestHashGroupPointerType} type.
  * @param [in] buffer - The {@link PARCBuffer} containing the pointer digest.
  *
+ * @return true The pointer was added.
+ * @return false The group is full, or the digest is longer than `CCNxManifestHashGroup_MaxDigestLength`.
+ *
  * Example:
  * @code
  * {
@@ -288,6 +320,9 @@ bool ccnxManifestHashGroup_PrependPointer(CCNxManifestHashGroup *group, CCNxMani
  * Retrieve the {@link CCNxManifestHashGroupPointer} in the {@link CCNxManifestHashGroup} at
  * the specified index.
  *
+ * The pointer is created on first use and kept by the group.  Several threads may read the same
+ * group at once; they all get the same pointer.  The group still must not be changed while it is read.
+ *
  * @param [in] group - A {@link CCNxManifestHashGroup} instance.
  * @param [in] index - The index of the `CCNxManifestHashGroupPointer` to retrieve.
  *
@@ -311,6 +346,54 @@ bool ccnxManifestHashGroup_PrependPointer(CCNxManifestHashGroup *group, CCNxMani
  */
 CCNxManifestHashGroupPointer *ccnxManifestHashGroup_GetPointerAtIndex(const CCNxManifestHashGroup *group, size_t index);
 
+/**
+ * Retrieve the type of the pointer in the {@link CCNxManifestHashGroup} at the specified index.
+ *
+ * @param [in] group - A {@link CCNxManifestHashGroup} instance.
+ * @param [in] index - The index of the pointer.
+ *
+ * @retval The {@link CCNxManifestHashGroupPointerType} of the pointer at the specified index.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxManifestHashGroupPointerType type = ccnxManifestHashGroup_GetPointerTypeAtIndex(group, 0);
+ * }
+ * @endcode
+ */
+CCNxManifestHashGroupPointerType ccnxManifestHashGroup_GetPointerTypeAtIndex(const CCNxManifestHashGroup *group, size_t index);
+
+/**
+ * Retrieve the type and digest of the pointer in the {@link CCNxManifestHashGroup} at the specified index
+ * without allocating memory.
+ *
+ * The digest points into the group's own storage and is valid until the group is modified or released.
+ * Because it returns false past the last pointer, it can drive a loop over every pointer in the group.
+ *
+ * @param [in] group - A {@link CCNxManifestHashGroup} instance.
+ * @param [in] index - The index of the pointer.
+ * @param [out] typePtr - Set to the type of the pointer.
+ * @param [out] digestPtr - Set to the first byte of the pointer digest.
+ * @param [out] lengthPtr - Set to the length of the pointer digest.
+ *
+ * @return true The outputs were set.
+ * @return false The index is past the last pointer and the outputs are unchanged.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxManifestHashGroupPointerType type;
+ *     const uint8_t *digest;
+ *     size_t length;
+ *     for (size_t i = 0; ccnxManifestHashGroup_GetPointerBytesAtIndex(group, i, &type, &digest, &length); i++) {
+ *         // use the digest
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxManifestHashGroup_GetPointerBytesAtIndex(const CCNxManifestHashGroup *group, size_t index,
+                                                  CCNxManifestHashGroupPointerType *typePtr, const uint8_t **digestPtr, size_t *lengthPtr);
+
 /**
  * Determine if two {@link CCNxManifestHashGroup} instances are equal.
  *
@@ -0,0 +1,476 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+
+#include <ccnx/common/ccnx_ManifestTraversal.h>
+#include <ccnx/common/ccnx_WireFormatMessage.h>
+
+#include <ccnx/common/codec/ccnxCodec_TlvPacket.h>
+
+#define _ccnxManifestTraversal_InitialCapacity 8
+
+/*
+ * A manifest pointer of a manifest that has arrived, kept from when it is found until the walk descends into it.
+ */
+typedef struct {
+    uint8_t digest[CCNxManifestHashGroup_MaxDigestLength];
+    size_t digestLength;
+    CCNxName *locator;      // The name the manifest is requested with, may be NULL
+    bool requested;         // Returned by Next
+    CCNxManifest *manifest; // NULL until it is added
+} _CCNxManifestTraversalChild;
+
+/*
+ * A manifest on the path from the root to the next data pointer.
+ */
+typedef struct {
+    CCNxManifest *manifest;
+    CCNxName *locator;             // The name of the manifest, or the name it was fetched with, may be NULL
+    CCNxManifestHashGroup *group;  // The group being walked, NULL between groups
+    size_t groupIndex;
+    size_t pointerIndex;
+} _CCNxManifestTraversalFrame;
+
+struct ccnx_manifest_traversal {
+    size_t prefetchDepth;
+    size_t outstanding; // Requested and not yet added
+    size_t requested;   // Requested and not yet descended into, at most prefetchDepth
+
+    size_t numberOfFrames;
+    size_t frameCapacity;
+    _CCNxManifestTraversalFrame *frames;
+
+    // The children in the order the walk will reach them.  The children of a manifest are inserted
+    // right after it when it arrives, so requesting from the front follows the walk depth first.
+    size_t numberOfChildren;
+    size_t childCapacity;
+    _CCNxManifestTraversalChild *children;
+};
+
+static void
+_ccnxManifestTraversal_ReleaseFrame(_CCNxManifestTraversalFrame *frame)
+{
+    if (frame->group != NULL) {
+        ccnxManifestHashGroup_Release(&frame->group);
+    }
+    if (frame->locator != NULL) {
+        ccnxName_Release(&frame->locator);
+    }
+    ccnxManifest_Release(&frame->manifest);
+}
+
+static bool
+_ccnxManifestTraversal_Destructor(CCNxManifestTraversal **traversalP)
+{
+    CCNxManifestTraversal *traversal = *traversalP;
+
+    for (size_t i = 0; i < traversal->numberOfFrames; i++) {
+        _ccnxManifestTraversal_ReleaseFrame(&traversal->frames[i]);
+    }
+    parcMemory_Deallocate(&traversal->frames);
+
+    for (size_t i = 0; i < traversal->numberOfChildren; i++) {
+        _CCNxManifestTraversalChild *child = &traversal->children[i];
+        if (child->locator != NULL) {
+            ccnxName_Release(&child->locator);
+        }
+        if (child->manifest != NULL) {
+            ccnxManifest_Release(&child->manifest);
+        }
+    }
+    parcMemory_Deallocate(&traversal->children);
+    return true;
+}
+
+parcObject_Override(CCNxManifestTraversal, PARCObject,
+                    .destructor = (PARCObjectDestructor *) _ccnxManifestTraversal_Destructor);
+
+parcObject_ImplementAcquire(ccnxManifestTraversal, CCNxManifestTraversal);
+
+parcObject_ImplementRelease(ccnxManifestTraversal, CCNxManifestTraversal);
+
+static const CCNxName *
+_ccnxManifestTraversal_GroupLocator(const CCNxManifestHashGroup *group, const CCNxName *manifestLocator)
+{
+    const CCNxName *locator = ccnxManifestHashGroup_GetLocator(group);
+    return (locator != NULL) ? locator : manifestLocator;
+}
+
+static size_t
+_ccnxManifestTraversal_CountManifestPointers(const CCNxManifest *manifest)
+{
+    size_t count = 0;
+    for (size_t g = 0; g < ccnxManifest_GetNumberOfHashGroups(manifest); g++) {
+        CCNxManifestHashGroup *group = ccnxManifest_GetHashGroupByIndex(manifest, g);
+
+        CCNxManifestHashGroupPointerType type;
+        const uint8_t *digest;
+        size_t digestLength;
+        for (size_t i = 0; ccnxManifestHashGroup_GetPointerBytesAtIndex(group, i, &type, &digest, &digestLength); i++) {
+            if (type == CCNxManifestHashGroupPointerType_Manifest) {
+                count++;
+            }
+        }
+
+        ccnxManifestHashGroup_Release(&group);
+    }
+    return count;
+}
+
+/*
+ * Remember the manifest pointers of a manifest that has arrived, so they can be requested.
+ * They are inserted at `position`, so they come before anything the walk reaches after the manifest.
+ *
+ * Returns the number of children inserted.
+ */
+static size_t
+_ccnxManifestTraversal_FindChildren(CCNxManifestTraversal *traversal, size_t position,
+                                    const CCNxManifest *manifest, const CCNxName *manifestLocator)
+{
+    size_t count = _ccnxManifestTraversal_CountManifestPointers(manifest);
+    if (count == 0) {
+        return 0;
+    }
+
+    if (traversal->numberOfChildren + count > traversal->childCapacity) {
+        size_t capacity = traversal->childCapacity * 2;
+        while (capacity < traversal->numberOfChildren + count) {
+            capacity *= 2;
+        }
+        traversal->children = parcMemory_Reallocate(traversal->children, capacity * sizeof(_CCNxManifestTraversalChild));
+        assertNotNull(traversal->children, "parcMemory_Reallocate(%zu) returned NULL", capacity * sizeof(_CCNxManifestTraversalChild));
+        traversal->childCapacity = capacity;
+    }
+
+    memmove(&traversal->children[position + count], &traversal->children[position],
+            (traversal->numberOfChildren - position) * sizeof(_CCNxManifestTraversalChild));
+    traversal->numberOfChildren += count;
+
+    _CCNxManifestTraversalChild *child = &traversal->children[position];
+    for (size_t g = 0; g < ccnxManifest_GetNumberOfHashGroups(manifest); g++) {
+        CCNxManifestHashGroup *group = ccnxManifest_GetHashGroupByIndex(manifest, g);
+        const CCNxName *locator = _ccnxManifestTraversal_GroupLocator(group, manifestLocator);
+
+        CCNxManifestHashGroupPointerType type;
+        const uint8_t *digest;
+        size_t digestLength;
+        for (size_t i = 0; ccnxManifestHashGroup_GetPointerBytesAtIndex(group, i, &type, &digest, &digestLength); i++) {
+            if (type != CCNxManifestHashGroupPointerType_Manifest) {
+                continue;
+            }
+
+            memcpy(child->digest, digest, digestLength);
+            child->digestLength = digestLength;
+            child->locator = (locator != NULL) ? ccnxName_Acquire(locator) : NULL;
+            child->requested = false;
+            child->manifest = NULL;
+            child++;
+        }
+
+        ccnxManifestHashGroup_Release(&group);
+    }
+    return count;
+}
+
+/*
+ * Make the manifest the next level of the walk.  The frame takes the references to the manifest and locator.
+ */
+static void
+_ccnxManifestTraversal_PushFrame(CCNxManifestTraversal *traversal, CCNxManifest *manifest, CCNxName *locator)
+{
+    if (traversal->numberOfFrames == traversal->frameCapacity) {
+        size_t capacity = traversal->frameCapacity * 2;
+        traversal->frames = parcMemory_Reallocate(traversal->frames, capacity * sizeof(_CCNxManifestTraversalFrame));
+        assertNotNull(traversal->frames, "parcMemory_Reallocate(%zu) returned NULL", capacity * sizeof(_CCNxManifestTraversalFrame));
+        traversal->frameCapacity = capacity;
+    }
+
+    _CCNxManifestTraversalFrame *frame = &traversal->frames[traversal->numberOfFrames++];
+    frame->manifest = manifest;
+    frame->locator = locator;
+    frame->group = NULL;
+    frame->groupIndex = 0;
+    frame->pointerIndex = 0;
+}
+
+static CCNxName *
+_ccnxManifestTraversal_ManifestLocator(const CCNxManifest *manifest, const CCNxName *fetchedWith)
+{
+    const CCNxName *name = ccnxManifest_GetName(manifest);
+    if (name == NULL) {
+        name = fetchedWith;
+    }
+    return (name != NULL) ? ccnxName_Acquire(name) : NULL;
+}
+
+CCNxManifestTraversal *
+ccnxManifestTraversal_Create(const CCNxManifest *root, const CCNxName *locator, size_t prefetchDepth)
+{
+    assertNotNull(root, "Parameter root must be non-null");
+    assertTrue(prefetchDepth >= 1, "The prefetch depth must be at least 1, got %zu", prefetchDepth);
+
+    CCNxManifestTraversal *result = parcObject_CreateAndClearInstance(CCNxManifestTraversal);
+    if (result != NULL) {
+        result->prefetchDepth = prefetchDepth;
+
+        result->frameCapacity = _ccnxManifestTraversal_InitialCapacity;
+        result->frames = parcMemory_Allocate(result->frameCapacity * sizeof(_CCNxManifestTraversalFrame));
+        assertNotNull(result->frames, "parcMemory_Allocate(%zu) returned NULL", result->frameCapacity * sizeof(_CCNxManifestTraversalFrame));
+
+        result->childCapacity = _ccnxManifestTraversal_InitialCapacity;
+        result->children = parcMemory_Allocate(result->childCapacity * sizeof(_CCNxManifestTraversalChild));
+        assertNotNull(result->children, "parcMemory_Allocate(%zu) returned NULL", result->childCapacity * sizeof(_CCNxManifestTraversalChild));
+
+        CCNxName *rootLocator = _ccnxManifestTraversal_ManifestLocator(root, locator);
+        _ccnxManifestTraversal_FindChildren(result, 0, root, rootLocator);
+        _ccnxManifestTraversal_PushFrame(result, ccnxManifest_Acquire(root), rootLocator);
+    }
+    return result;
+}
+
+static bool
+_ccnxManifestTraversal_ChildHasDigest(const _CCNxManifestTraversalChild *child, size_t length, const uint8_t digest[length])
+{
+    return child->digestLength == length && memcmp(child->digest, digest, length) == 0;
+}
+
+/*
+ * Descend into the manifest at the current pointer of the top frame, if it has arrived.
+ */
+static bool
+_ccnxManifestTraversal_Descend(CCNxManifestTraversal *traversal, size_t length, const uint8_t digest[length])
+{
+    for (size_t i = 0; i < traversal->numberOfChildren; i++) {
+        _CCNxManifestTraversalChild *child = &traversal->children[i];
+        if (child->manifest != NULL && _ccnxManifestTraversal_ChildHasDigest(child, length, digest)) {
+            CCNxManifest *manifest = child->manifest;
+            CCNxName *locator = _ccnxManifestTraversal_ManifestLocator(manifest, child->locator);
+            if (child->locator != NULL) {
+                ccnxName_Release(&child->locator);
+            }
+
+            memmove(&traversal->children[i], &traversal->children[i + 1], (traversal->numberOfChildren - i - 1) * sizeof(_CCNxManifestTraversalChild));
+            traversal->numberOfChildren--;
+            traversal->requested--;
+
+            traversal->frames[traversal->numberOfFrames - 1].pointerIndex++;
+            _ccnxManifestTraversal_PushFrame(traversal, manifest, locator);
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Walk the tree in order to the next data pointer.
+ */
+static CCNxManifestTraversalStatus
+_ccnxManifestTraversal_NextData(CCNxManifestTraversal *traversal, CCNxManifestTraversalEntry *entry)
+{
+    while (traversal->numberOfFrames > 0) {
+        _CCNxManifestTraversalFrame *frame = &traversal->frames[traversal->numberOfFrames - 1];
+
+        if (frame->group == NULL) {
+            if (frame->groupIndex == ccnxManifest_GetNumberOfHashGroups(frame->manifest)) {
+                _ccnxManifestTraversal_ReleaseFrame(frame);
+                traversal->numberOfFrames--;
+                continue;
+            }
+            frame->group = ccnxManifest_GetHashGroupByIndex(frame->manifest, frame->groupIndex);
+            frame->pointerIndex = 0;
+        }
+
+        CCNxManifestHashGroupPointerType type;
+        const uint8_t *digest;
+        size_t digestLength;
+        if (!ccnxManifestHashGroup_GetPointerBytesAtIndex(frame->group, frame->pointerIndex, &type, &digest, &digestLength)) {
+            ccnxManifestHashGroup_Release(&frame->group);
+            frame->groupIndex++;
+            continue;
+        }
+
+        if (type == CCNxManifestHashGroupPointerType_Data) {
+            entry->type = type;
+            entry->name = _ccnxManifestTraversal_GroupLocator(frame->group, frame->locator);
+            entry->digest = digest;
+            entry->digestLength = digestLength;
+            frame->pointerIndex++;
+            return CCNxManifestTraversalStatus_Entry;
+        }
+
+        if (!_ccnxManifestTraversal_Descend(traversal, digestLength, digest)) {
+            return CCNxManifestTraversalStatus_Waiting;
+        }
+    }
+
+    return CCNxManifestTraversalStatus_Done;
+}
+
+/*
+ * Request the first child the walk will reach that has not been requested, if the prefetch depth allows.
+ * A child counts against the depth until the walk descends into it, so arrived manifests waiting for the
+ * walk are bounded too.
+ */
+static bool
+_ccnxManifestTraversal_NextManifest(CCNxManifestTraversal *traversal, CCNxManifestTraversalEntry *entry)
+{
+    if (traversal->requested == traversal->prefetchDepth) {
+        return false;
+    }
+
+    for (size_t i = 0; i < traversal->numberOfChildren; i++) {
+        _CCNxManifestTraversalChild *child = &traversal->children[i];
+        if (!child->requested) {
+            child->requested = true;
+            traversal->requested++;
+            traversal->outstanding++;
+
+            entry->type = CCNxManifestHashGroupPointerType_Manifest;
+            entry->name = child->locator;
+            entry->digest = child->digest;
+            entry->digestLength = child->digestLength;
+            return true;
+        }
+    }
+    return false;
+}
+
+CCNxManifestTraversalStatus
+ccnxManifestTraversal_Next(CCNxManifestTraversal *traversal, CCNxManifestTraversalEntry *entry)
+{
+    // Request the manifests first, so the lower levels of the tree are on their way while the data is fetched.
+    if (_ccnxManifestTraversal_NextManifest(traversal, entry)) {
+        return CCNxManifestTraversalStatus_Entry;
+    }
+
+    CCNxManifestTraversalStatus status = _ccnxManifestTraversal_NextData(traversal, entry);
+
+    // Descending on the way may have made room for the manifest the walk is waiting for
+    if (status == CCNxManifestTraversalStatus_Waiting && _ccnxManifestTraversal_NextManifest(traversal, entry)) {
+        status = CCNxManifestTraversalStatus_Entry;
+    }
+    return status;
+}
+
+CCNxManifestTraversalStatus
+ccnxManifestTraversal_NextInterest(CCNxManifestTraversal *traversal, CCNxManifestTraversalEntry *entry, CCNxInterest **interestPtr)
+{
+    CCNxManifestTraversalEntry localEntry;
+    if (entry == NULL) {
+        entry = &localEntry;
+    }
+
+    *interestPtr = NULL;
+
+    CCNxManifestTraversalStatus status = ccnxManifestTraversal_Next(traversal, entry);
+    if (status == CCNxManifestTraversalStatus_Entry && entry->name != NULL) {
+        CCNxInterest *interest = ccnxInterest_CreateSimple(entry->name);
+
+        PARCBuffer *digest = parcBuffer_Flip(parcBuffer_CreateFromArray(entry->digest, entry->digestLength));
+        ccnxInterest_SetContentObjectHashRestriction(interest, digest);
+        parcBuffer_Release(&digest);
+
+        CCNxCodecNetworkBufferIoVec *vec = ccnxCodecTlvPacket_DictionaryEncode(interest, NULL);
+        assertNotNull(vec, "Could not encode the Interest");
+        ccnxWireFormatMessage_PutIoVec(interest, vec);
+        ccnxCodecNetworkBufferIoVec_Release(&vec);
+
+        *interestPtr = interest;
+    }
+
+    return status;
+}
+
+bool
+ccnxManifestTraversal_AddManifest(CCNxManifestTraversal *traversal, const PARCBuffer *digest, const CCNxManifest *manifest)
+{
+    size_t length = parcBuffer_Remaining(digest);
+    const uint8_t *bytes = parcBuffer_Overlay((PARCBuffer *) digest, 0);
+
+    // A manifest the tree points to more than once answers every request for it.
+    bool added = false;
+    for (size_t i = 0; i < traversal->numberOfChildren; i++) {
+        _CCNxManifestTraversalChild *child = &traversal->children[i];
+        if (child->requested && child->manifest == NULL && _ccnxManifestTraversal_ChildHasDigest(child, length, bytes)) {
+            child->manifest = ccnxManifest_Acquire(manifest);
+            traversal->outstanding--;
+            added = true;
+
+            CCNxName *locator = _ccnxManifestTraversal_ManifestLocator(manifest, child->locator);
+            i += _ccnxManifestTraversal_FindChildren(traversal, i + 1, manifest, locator);
+            if (locator != NULL) {
+                ccnxName_Release(&locator);
+            }
+        }
+    }
+    return added;
+}
+
+size_t
+ccnxManifestTraversal_GetOutstanding(const CCNxManifestTraversal *traversal)
+{
+    return traversal->outstanding;
+}
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file ccnx_ManifestTraversal.h
+ * @ingroup ContentObject
+ * @brief Walk a manifest tree on demand, yielding the pointers to fetch.
+ *
+ * A `CCNxManifestTraversal` starts from the root manifest of a tree and yields one pointer at a time,
+ * as a locator name and digest or as an encoded {@link CCNxInterest}, so a consumer can keep a bounded
+ * window of Interests outstanding instead of building every Interest up front as
+ * {@link ccnxManifest_CreateInterestList} does.
+ *
+ * Data pointers are yielded in the order of the object.  The pointers to child manifests are yielded
+ * ahead of the data, in the order the depth-first walk will reach them, so the manifests the walk needs next
+ * are fetched while the data is.  The prefetch depth limits how many manifests may be requested and not yet
+ * walked into, whether or not they have been given back with {@link ccnxManifestTraversal_AddManifest}, so the
+ * traversal holds a bounded number of manifests however large the tree.  When the next data pointer is inside a
+ * manifest that has not arrived, and no more manifests may be requested, the traversal reports that it is waiting.
+ *
+ * The name of a pointer is the locator of its hash group, or else the name of its manifest,
+ * or else the name its manifest was fetched with.  The root uses the locator given to
+ * {@link ccnxManifestTraversal_Create} if it has no name.
+ *
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef libccnx_ccnx_ManifestTraversal_h
+#define libccnx_ccnx_ManifestTraversal_h
+
+#include <stdbool.h>
+
+#include <parc/algol/parc_Buffer.h>
+
+#include <ccnx/common/ccnx_Name.h>
+#include <ccnx/common/ccnx_Interest.h>
+#include <ccnx/common/ccnx_Manifest.h>
+
+struct ccnx_manifest_traversal;
+/**
+ * @typedef CCNxManifestTraversal
+ * @brief A pull-style walk over a manifest tree.
+ */
+typedef struct ccnx_manifest_traversal CCNxManifestTraversal;
+
+/**
+ * @typedef CCNxManifestTraversalStatus
+ * @brief The result of asking a `CCNxManifestTraversal` for its next pointer.
+ */
+typedef enum {
+    CCNxManifestTraversalStatus_Entry,   // A pointer was returned
+    CCNxManifestTraversalStatus_Waiting, // Nothing can be returned until a requested manifest is added
+    CCNxManifestTraversalStatus_Done     // Every pointer in the tree has been returned
+} CCNxManifestTraversalStatus;
+
+/**
+ * @typedef CCNxManifestTraversalEntry
+ * @brief One pointer of a manifest tree.
+ *
+ * The name and digest belong to the traversal and are valid until the next call on it.
+ */
+typedef struct {
+    CCNxManifestHashGroupPointerType type;
+    const CCNxName *name;   // The locator to fetch the pointer with, or NULL if the tree gives none
+    const uint8_t *digest;  // The ContentObject hash of the pointer
+    size_t digestLength;
+} CCNxManifestTraversalEntry;
+
+/**
+ * Create a traversal of the manifest tree under `root`.
+ *
+ * @param [in] root The root manifest of the tree.
+ * @param [in] locator The name for the pointers of the root if the root has no name, or NULL.
+ * @param [in] prefetchDepth The most manifests that may be requested and not yet walked into, at least 1.
+ *
+ * @return A pointer to a new `CCNxManifestTraversal` instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxManifestTraversal *traversal = ccnxManifestTraversal_Create(root, NULL, 4);
+ *
+ *     ccnxManifestTraversal_Release(&traversal);
+ * }
+ * @endcode
+ */
+CCNxManifestTraversal *ccnxManifestTraversal_Create(const CCNxManifest *root, const CCNxName *locator, size_t prefetchDepth);
+
+/**
+ * Increase the number of references to a `CCNxManifestTraversal`.
+ *
+ * @param [in] traversal A pointer to a `CCNxManifestTraversal` instance.
+ * @return The value of the input parameter @p traversal.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxManifestTraversal *reference = ccnxManifestTraversal_Acquire(traversal);
+ *
+ *     ccnxManifestTraversal_Release(&reference);
+ * }
+ * @endcode
+ */
+CCNxManifestTraversal *ccnxManifestTraversal_Acquire(const CCNxManifestTraversal *traversal);
+
+/**
+ * Release a previously acquired reference to the specified `CCNxManifestTraversal` instance,
+ * decrementing the reference count for the instance.
+ *
+ * @param [in,out] traversalP A pointer to a pointer to the instance to release.
+ *
+ * Example:
+ * @code
+ * {
+ *     ccnxManifestTraversal_Release(&traversal);
+ * }
+ * @endcode
+ */
+void ccnxManifestTraversal_Release(CCNxManifestTraversal **traversalP);
+
+/**
+ * Get the next pointer to fetch.
+ *
+ * A pointer of type `CCNxManifestHashGroupPointerType_Manifest` counts against the prefetch depth until
+ * the manifest it refers to is given to {@link ccnxManifestTraversal_AddManifest} and the walk descends into it.
+ *
+ * @param [in] traversal A `CCNxManifestTraversal` instance.
+ * @param [out] entry Set to the pointer if the result is `CCNxManifestTraversalStatus_Entry`.
+ *
+ * @return The `CCNxManifestTraversalStatus` of the traversal.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxManifestTraversalEntry entry;
+ *     while (ccnxManifestTraversal_Next(traversal, &entry) == CCNxManifestTraversalStatus_Entry) {
+ *         // request entry.digest from entry.name
+ *     }
+ * }
+ * @endcode
+ */
+CCNxManifestTraversalStatus ccnxManifestTraversal_Next(CCNxManifestTraversal *traversal, CCNxManifestTraversalEntry *entry);
+
+/**
+ * Get the next pointer to fetch as an encoded Interest with a ContentObject hash restriction.
+ *
+ * The Interest holds its wire format.  If the pointer has no name, no Interest can be built and
+ * `interestPtr` is set to NULL, but the pointer is still returned in `entry`.
+ *
+ * @param [in] traversal A `CCNxManifestTraversal` instance.
+ * @param [out] entry If not NULL, set to the pointer if the result is `CCNxManifestTraversalStatus_Entry`.
+ * @param [out] interestPtr Set to a new Interest, which the caller must release, if the result is `CCNxManifestTraversalStatus_Entry`.
+ *
+ * @return The `CCNxManifestTraversalStatus` of the traversal.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxInterest *interest;
+ *     while (ccnxManifestTraversal_NextInterest(traversal, NULL, &interest) == CCNxManifestTraversalStatus_Entry) {
+ *         // send the interest
+ *         ccnxInterest_Release(&interest);
+ *     }
+ * }
+ * @endcode
+ */
+CCNxManifestTraversalStatus ccnxManifestTraversal_NextInterest(CCNxManifestTraversal *traversal, CCNxManifestTraversalEntry *entry,
+                                                               CCNxInterest **interestPtr);
+
+/**
+ * Give the traversal a manifest it requested, so it can descend into it.
+ *
+ * @param [in] traversal A `CCNxManifestTraversal` instance.
+ * @param [in] digest The digest of the pointer the manifest was requested with.
+ * @param [in] manifest The manifest.
+ *
+ * @return true The manifest was added.
+ * @return false No requested manifest has that digest.
+ *
+ * Example:
+ * @code
+ * {
+ *     ccnxManifestTraversal_AddManifest(traversal, contentObjectHash, manifest);
+ * }
+ * @endcode
+ */
+bool ccnxManifestTraversal_AddManifest(CCNxManifestTraversal *traversal, const PARCBuffer *digest, const CCNxManifest *manifest);
+
+/**
+ * Get the number of manifests requested and not yet added.
+ *
+ * @param [in] traversal A `CCNxManifestTraversal` instance.
+ *
+ * @return The number of outstanding manifests, never more than the prefetch depth.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t outstanding = ccnxManifestTraversal_GetOutstanding(traversal);
+ * }
+ * @endcode
+ */
+size_t ccnxManifestTraversal_GetOutstanding(const CCNxManifestTraversal *traversal);
+#endif // libccnx_ccnx_ManifestTraversal_h
@@ -67,14 +67,48 @@
 #include <ccnx/common/ccnx_Name.h>
 
 #include <parc/algol/parc_Memory.h>
-#include <parc/algol/parc_LinkedList.h>
+#include <parc/algol/parc_Hash.h>
 #include <parc/algol/parc_URI.h>
 #include <parc/algol/parc_URIPath.h>
 #include <parc/algol/parc_DisplayIndented.h>
 #include <parc/algol/parc_Object.h>
 
+#define _ccnxName_InitialSegmentCapacity 8
+#define _ccnxName_InitialValueCapacity 64
+
+/*
+ * A CCNxName is a packed array of segment descriptors over one contiguous value buffer.
+ * The value of segment i occupies the bytes [offset, offset + length) of `value`,
+ * and the segments are laid out in order, so the value of segment i + 1 begins where segment i ends.
+ *
+ * `segments` is a parallel array of CCNxNameSegment instances.
+ * An entry is either the segment given to ccnxName_Append, or it is created on first use by ccnxName_GetSegment.
+ * Compare, Equals, StartsWith and the hash functions work directly on the descriptors and never create segments.
+ *
+ * `prefixHashCode` is ccnxName_LeftMostHashCode(name, i + 1).  It is computed lazily for all the segments at once
+ * and is valid for the first `hashedSegmentCount` descriptors.  Appending a segment does not change the hash code
+ * of any existing prefix, and trimming only discards the hash codes of the removed segments.
+ *
+ * A shared name may have its hash codes filled by several threads at once, so `hashedSegmentCount` is published
+ * with a release store after the hash codes and read with an acquire load.
+ */
+typedef struct {
+    CCNxNameLabelType type;
+    uint32_t offset;
+    uint32_t length;
+    PARCHashCode prefixHashCode;
+} _CCNxNameSegmentDescriptor;
+
 struct ccnx_name {
-    PARCLinkedList *segments;
+    size_t segmentCount;
+    size_t segmentCapacity;
+    _CCNxNameSegmentDescriptor *descriptors;
+    CCNxNameSegment **segments;
+    size_t hashedSegmentCount;
+
+    size_t valueLength;
+    size_t valueCapacity;
+    uint8_t *value;
 };
 
 static bool
@@ -82,7 +116,21 @@ _ccnxName_Destructor(CCNxName **pointer)
 {
     CCNxName *name = *pointer;
 
-    parcLinkedList_Release(&name->segments);
+    for (size_t i = 0; i < name->segmentCount; i++) {
+        if (name->segments[i] != NULL) {
+            ccnxNameSegment_Release(&name->segments[i]);
+        }
+    }
+
+    if (name->descriptors != NULL) {
+        parcMemory_Deallocate(&name->descriptors);
+    }
+    if (name->segments != NULL) {
+        parcMemory_Deallocate(&name->segments);
+    }
+    if (name->value != NULL) {
+        parcMemory_Deallocate(&name->value);
+    }
     return true;
 }
 
@@ -94,13 +142,150 @@ parcObject_Override(CCNxName, PARCObject,
                     .hashCode = (PARCObjectHashCode *) ccnxName_HashCode,
                     .toString = (PARCObjectToString *) ccnxName_ToString,
                     .display = (PARCObjectDisplay *) ccnxName_Display);
+
+/*
+ * Ensure the name can hold at least `segmentCount` segments and `valueLength` bytes of segment values.
+ */
+static void
+_ccnxName_EnsureCapacity(CCNxName *name, size_t segmentCount, size_t valueLength)
+{
+    if (segmentCount > name->segmentCapacity) {
+        size_t capacity = name->segmentCapacity == 0 ? _ccnxName_InitialSegmentCapacity : name->segmentCapacity;
+        while (capacity < segmentCount) {
+            capacity *= 2;
+        }
+
+        name->descriptors = parcMemory_Reallocate(name->descriptors, capacity * sizeof(_CCNxNameSegmentDescriptor));
+        assertNotNull(name->descriptors, "parcMemory_Reallocate(%zu) returned NULL", capacity * sizeof(_CCNxNameSegmentDescriptor));
+
+        name->segments = parcMemory_Reallocate(name->segments, capacity * sizeof(CCNxNameSegment *));
+        assertNotNull(name->segments, "parcMemory_Reallocate(%zu) returned NULL", capacity * sizeof(CCNxNameSegment *));
+        memset(&name->segments[name->segmentCapacity], 0, (capacity - name->segmentCapacity) * sizeof(CCNxNameSegment *));
+
+        name->segmentCapacity = capacity;
+    }
+
+    if (valueLength > name->valueCapacity) {
+        size_t capacity = name->valueCapacity == 0 ? _ccnxName_InitialValueCapacity : name->valueCapacity;
+        while (capacity < valueLength) {
+            capacity *= 2;
+        }
+
+        name->value = parcMemory_Reallocate(name->value, capacity);
+        assertNotNull(name->value, "parcMemory_Reallocate(%zu) returned NULL", capacity);
+
+        name->valueCapacity = capacity;
+    }
+}
+
+/*
+ * Append a segment of the given type and value to the descriptor table, copying the value into the value buffer.
+ */
+static void
+_ccnxName_AppendTypeValue(CCNxName *name, CCNxNameLabelType type, size_t length, const uint8_t *value)
+{
+    trapIllegalValueIf(name->valueLength + length > UINT32_MAX, "CCNxName value buffer exceeds %u bytes", UINT32_MAX);
+
+    _ccnxName_EnsureCapacity(name, name->segmentCount + 1, name->valueLength + length);
+
+    _CCNxNameSegmentDescriptor *descriptor = &name->descriptors[name->segmentCount];
+    descriptor->type = type;
+    descriptor->offset = (uint32_t) name->valueLength;
+    descriptor->length = (uint32_t) length;
+
+    if (length > 0) {
+        memcpy(&name->value[name->valueLength], value, length);
+    }
+    name->segments[name->segmentCount] = NULL;
+
+    name->valueLength += length;
+    name->segmentCount++;
+}
+
+static inline const uint8_t *
+_ccnxName_SegmentValue(const CCNxName *name, size_t index)
+{
+    return &name->value[name->descriptors[index].offset];
+}
+
+/*
+ * Compare two segment values the same way as ccnxNameSegment_Compare: shorter values sort first,
+ * values of the same length are compared byte by byte.
+ */
+static inline int
+_ccnxName_CompareSegments(const CCNxName *nameA, size_t indexA, const CCNxName *nameB, size_t indexB)
+{
+    uint32_t lengthA = nameA->descriptors[indexA].length;
+    uint32_t lengthB = nameB->descriptors[indexB].length;
+
+    if (lengthA < lengthB) {
+        return -1;
+    }
+    if (lengthA > lengthB) {
+        return +1;
+    }
+    if (lengthA == 0) {
+        return 0;
+    }
+    return memcmp(_ccnxName_SegmentValue(nameA, indexA), _ccnxName_SegmentValue(nameB, indexB), lengthA);
+}
+
+/*
+ * The same value as ccnxNameSegment_HashCode for a segment with this type and value.
+ */
+static inline PARCHashCode
+_ccnxName_SegmentHashCode(const CCNxName *name, size_t index)
+{
+    const _CCNxNameSegmentDescriptor *descriptor = &name->descriptors[index];
+    return ccnxNameSegment_HashCodeTypeValue(descriptor->type, descriptor->length, _ccnxName_SegmentValue(name, index));
+}
+
+static size_t
+_ccnxName_HashedSegmentCount(const CCNxName *name)
+{
+    return __atomic_load_n(&name->hashedSegmentCount, __ATOMIC_ACQUIRE);
+}
+
+static PARCHashCode
+_ccnxName_PrefixHashCode(const CCNxName *name, size_t index)
+{
+    return __atomic_load_n(&name->descriptors[index].prefixHashCode, __ATOMIC_RELAXED);
+}
+
+/*
+ * Fill in the prefix hash code of every segment that does not have one yet.
+ *
+ * The cached hash codes are not part of the value of the name, so filling them is permitted on a const CCNxName.
+ * Concurrent callers compute and store identical values, and the count is only published once they are stored.
+ */
+static void
+_ccnxName_ComputePrefixHashCodes(const CCNxName *name)
+{
+    size_t first = _ccnxName_HashedSegmentCount(name);
+    PARCHashCode hashCode = (first == 0) ? 0 : _ccnxName_PrefixHashCode(name, first - 1);
+
+    for (size_t i = first; i < name->segmentCount; i++) {
+        hashCode = parcHashCode_HashHashCode(hashCode, _ccnxName_SegmentHashCode(name, i));
+        __atomic_store_n(&name->descriptors[i].prefixHashCode, hashCode, __ATOMIC_RELAXED);
+    }
+
+    __atomic_store_n(&((CCNxName *) name)->hashedSegmentCount, name->segmentCount, __ATOMIC_RELEASE);
+}
+
 CCNxName *
 ccnxName_Create(void)
 {
     CCNxName *result = parcObject_CreateInstance(CCNxName);
 
     if (result != NULL) {
-        result->segments = parcLinkedList_Create();
+        result->segmentCount = 0;
+        result->segmentCapacity = 0;
+        result->descriptors = NULL;
+        result->segments = NULL;
+        result->hashedSegmentCount = 0;
+        result->valueLength = 0;
+        result->valueCapacity = 0;
+        result->value = NULL;
     }
 
     return result;
@@ -122,7 +307,11 @@ ccnxName_IsValid(const CCNxName *name)
     bool result = false;
 
     if (name != NULL) {
-        result = parcLinkedList_IsValid(name->segments);
+        if (name->segmentCount <= name->segmentCapacity && name->valueLength <= name->valueCapacity) {
+            if (name->segmentCount == 0 || (name->descriptors != NULL && name->segments != NULL)) {
+                result = true;
+            }
+        }
     }
 
     return result;
@@ -136,11 +325,18 @@ ccnxName_Copy(const CCNxName *originalName)
     CCNxName *result = ccnxName_Create();
 
     if (result != NULL) {
-        for (int i = 0; i < ccnxName_GetSegmentCount(originalName); i++) {
-            CCNxNameSegment *component = ccnxName_GetSegment(originalName, i);
-            CCNxNameSegment *copy = ccnxNameSegment_Copy(component);
-            ccnxName_Append(result, copy);
-            ccnxNameSegment_Release(&copy);
+        if (originalName->segmentCount > 0) {
+            _ccnxName_EnsureCapacity(result, originalName->segmentCount, originalName->valueLength);
+
+            // Read the count first, so the hash codes it covers are published before they are copied
+            size_t hashedSegmentCount = _ccnxName_HashedSegmentCount(originalName);
+            memcpy(result->descriptors, originalName->descriptors, originalName->segmentCount * sizeof(_CCNxNameSegmentDescriptor));
+            if (originalName->valueLength > 0) {
+                memcpy(result->value, originalName->value, originalName->valueLength);
+            }
+            result->segmentCount = originalName->segmentCount;
+            result->hashedSegmentCount = hashedSegmentCount;
+            result->valueLength = originalName->valueLength;
         }
     }
 
@@ -157,10 +353,18 @@ ccnxName_Equals(const CCNxName *a, const CCNxName *b)
         return false;
     }
 
-    if (ccnxName_GetSegmentCount(a) == ccnxName_GetSegmentCount(b)) {
-        return parcLinkedList_Equals(a->segments, b->segments);
+    if (a->segmentCount != b->segmentCount || a->valueLength != b->valueLength) {
+        return false;
+    }
+
+    for (size_t i = 0; i < a->segmentCount; i++) {
+        if (a->descriptors[i].type != b->descriptors[i].type || a->descriptors[i].length != b->descriptors[i].length) {
+            return false;
+        }
     }
-    return false;
+
+    // The segment lengths are identical, so the values are laid out identically.
+    return a->valueLength == 0 || memcmp(a->value, b->value, a->valueLength) == 0;
 }
 
 CCNxName *
@@ -192,7 +396,7 @@ ccnxName_FromURI(const PARCURI *uri)
                 ccnxName_Release(&result);
                 break;
             }
-            parcLinkedList_Append(result->segments, segment);
+            ccnxName_Append(result, segment);
             ccnxNameSegment_Release(&segment);
         }
     }
@@ -244,7 +448,20 @@ ccnxName_Append(CCNxName *name, const CCNxNameSegment *segment)
     ccnxName_OptionalAssertValid(name);
     ccnxNameSegment_OptionalAssertValid(segment);
 
-    parcLinkedList_Append(name->segments, segment);
+    PARCBuffer *value = ccnxNameSegment_GetValue(segment);
+    _ccnxName_AppendTypeValue(name, ccnxNameSegment_GetType(segment), parcBuffer_Remaining(value), parcBuffer_Overlay(value, 0));
+
+    name->segments[name->segmentCount - 1] = ccnxNameSegment_Acquire(segment);
+
+    return name;
+}
+
+CCNxName *
+ccnxName_AppendTypeValueArray(CCNxName *name, CCNxNameLabelType type, size_t length, const uint8_t value[length])
+{
+    ccnxName_OptionalAssertValid(name);
+
+    _ccnxName_AppendTypeValue(name, type, length, value);
 
     return name;
 }
@@ -287,13 +504,45 @@ ccnxName_ToString(const CCNxName *name)
 CCNxNameSegment *
 ccnxName_GetSegment(const CCNxName *name, size_t index)
 {
-    return parcLinkedList_GetAtIndex(name->segments, index);
+    trapOutOfBoundsIf(index >= name->segmentCount, "Index %zu exceeds the number of segments %zu", index, name->segmentCount);
+
+    CCNxNameSegment *result = name->segments[index];
+
+    if (result == NULL) {
+        const _CCNxNameSegmentDescriptor *descriptor = &name->descriptors[index];
+
+        PARCBuffer *value = parcBuffer_Allocate(descriptor->length);
+        parcBuffer_Flip(parcBuffer_PutArray(value, descriptor->length, _ccnxName_SegmentValue(name, index)));
+        result = ccnxNameSegment_CreateTypeValue(descriptor->type, value);
+        parcBuffer_Release(&value);
+
+        // The segment cache is not part of the value of the name, so filling it is permitted on a const CCNxName.
+        // If another thread filled this slot first, use its segment and discard ours.
+        if (!__sync_bool_compare_and_swap(&name->segments[index], NULL, result)) {
+            ccnxNameSegment_Release(&result);
+            result = name->segments[index];
+        }
+    }
+
+    return result;
+}
+
+const uint8_t *
+ccnxName_GetSegmentTypeValueArray(const CCNxName *name, size_t index, CCNxNameLabelType *type, size_t *length)
+{
+    trapOutOfBoundsIf(index >= name->segmentCount, "Index %zu exceeds the number of segments %zu", index, name->segmentCount);
+
+    const _CCNxNameSegmentDescriptor *descriptor = &name->descriptors[index];
+    *type = descriptor->type;
+    *length = descriptor->length;
+
+    return _ccnxName_SegmentValue(name, index);
 }
 
 size_t
 ccnxName_GetSegmentCount(const CCNxName *name)
 {
-    return parcLinkedList_Size(name->segments);
+    return name->segmentCount;
 }
 
 int
@@ -321,9 +570,7 @@ ccnxName_Compare(const CCNxName *name1, const CCNxName *name2)
     int result = 0;
 
     for (size_t i = 0; i < mininimumSegments; i++) {
-        CCNxNameSegment *segment1 = ccnxName_GetSegment(name1, i);
-        CCNxNameSegment *segment2 = ccnxName_GetSegment(name2, i);
-        result = ccnxNameSegment_Compare(segment1, segment2);
+        result = _ccnxName_CompareSegments(name1, i, name2, i);
         if (result != 0) {
             break;
         }
@@ -359,13 +606,15 @@ ccnxName_LeftMostHashCode(const CCNxName *name, size_t count)
         count = ccnxName_GetSegmentCount(name);
     }
 
-    PARCHashCode result = 0;
-    for (int i = 0; i < count; i++) {
-        PARCHashCode hashCode = ccnxNameSegment_HashCode(ccnxName_GetSegment(name, i));
-        result = parcHashCode_HashHashCode(result, hashCode);
+    if (count == 0) {
+        return 0;
     }
 
-    return result;
+    if (count > _ccnxName_HashedSegmentCount(name)) {
+        _ccnxName_ComputePrefixHashCodes(name);
+    }
+
+    return _ccnxName_PrefixHashCode(name, count - 1);
 }
 
 CCNxName *
@@ -375,9 +624,20 @@ ccnxName_Trim(CCNxName *name, size_t numberToRemove)
         numberToRemove = ccnxName_GetSegmentCount(name);
     }
 
-    for (int i = 0; i < numberToRemove; i++) {
-        CCNxNameSegment *segment = parcLinkedList_RemoveLast(name->segments);
-        ccnxNameSegment_Release(&segment);
+    size_t segmentCount = name->segmentCount - numberToRemove;
+
+    for (size_t i = segmentCount; i < name->segmentCount; i++) {
+        if (name->segments[i] != NULL) {
+            ccnxNameSegment_Release(&name->segments[i]);
+        }
+    }
+
+    if (segmentCount < name->segmentCount) {
+        name->valueLength = name->descriptors[segmentCount].offset;
+        name->segmentCount = segmentCount;
+        if (name->hashedSegmentCount > segmentCount) {
+            name->hashedSegmentCount = segmentCount;
+        }
     }
 
     return name;
@@ -390,11 +650,8 @@ ccnxName_StartsWith(const CCNxName *name, const CCNxName *prefix)
         return false;
     }
 
-    for (int i = 0; i < ccnxName_GetSegmentCount(prefix); i++) {
-        CCNxNameSegment *prefix_comp = ccnxName_GetSegment(prefix, i);
-        CCNxNameSegment *other_comp = ccnxName_GetSegment(name, i);
-
-        if (ccnxNameSegment_Compare(prefix_comp, other_comp) != 0) {
+    for (size_t i = 0; i < prefix->segmentCount; i++) {
+        if (_ccnxName_CompareSegments(prefix, i, name, i) != 0) {
             return false;
         }
     }
@@ -441,16 +698,32 @@ ccnxName_CreatePrefix(const CCNxName *name, size_t length)
     CCNxName *result = ccnxName_Create();
 
     if (result != NULL) {
+        if (length > name->segmentCount) {
+            length = name->segmentCount;
+        }
+
         if (length > 0) {
-            size_t numberOfSegmentsAvailable = parcLinkedList_Size(name->segments);
+            const _CCNxNameSegmentDescriptor *last = &name->descriptors[length - 1];
+            size_t valueLength = last->offset + last->length;
+
+            _ccnxName_EnsureCapacity(result, length, valueLength);
 
-            if (length > numberOfSegmentsAvailable) {
-                length = numberOfSegmentsAvailable;
+            size_t hashedSegmentCount = _ccnxName_HashedSegmentCount(name);
+            memcpy(result->descriptors, name->descriptors, length * sizeof(_CCNxNameSegmentDescriptor));
+            if (valueLength > 0) {
+                memcpy(result->value, name->value, valueLength);
             }
 
+            // Share any segment instances that already exist, as ccnxName_Append would have.
             for (size_t i = 0; i < length; i++) {
-                ccnxName_Append(result, ccnxName_GetSegment(name, i));
+                if (name->segments[i] != NULL) {
+                    result->segments[i] = ccnxNameSegment_Acquire(name->segments[i]);
+                }
             }
+
+            result->segmentCount = length;
+            result->hashedSegmentCount = (hashedSegmentCount < length) ? hashedSegmentCount : length;
+            result->valueLength = valueLength;
         }
     }
 
@@ -393,6 +393,32 @@ void ccnxName_Display(const CCNxName *name, int indentation);
  */
 CCNxName *ccnxName_Append(CCNxName *name, const CCNxNameSegment *segment);
 
+/**
+ * Append a segment with the given type and value to the given `CCNxName`.
+ *
+ * The value is copied into @p name.  This is equivalent to creating a `CCNxNameSegment`
+ * with {@link ccnxNameSegment_CreateTypeValueArray} and appending it with {@link ccnxName_Append},
+ * but no `CCNxNameSegment` instance is created until one is requested with {@link ccnxName_GetSegment}.
+ *
+ * @param [in,out] name The base `CCNxName` to append the segment to.
+ * @param [in] type The `CCNxNameLabelType` of the segment.
+ * @param [in] length The number of bytes in @p value.
+ * @param [in] value A pointer to the bytes of the value of the segment.
+ * @return The modifed @p name.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxName *name = ccnxName_Create();
+ *
+ *     ccnxName_AppendTypeValueArray(name, CCNxNameLabelType_NAME, 4, (const uint8_t *) "parc");
+ *
+ *     ccnxName_Release(&name);
+ * }
+ * @endcode
+ */
+CCNxName *ccnxName_AppendTypeValueArray(CCNxName *name, CCNxNameLabelType type, size_t length, const uint8_t value[length]);
+
 /**
  * Determine if a `CCNxName` is starts with another.
  *
@@ -571,6 +597,35 @@ int ccnxName_Compare(const CCNxName *name1, const CCNxName *name2);
  */
 CCNxNameSegment *ccnxName_GetSegment(const CCNxName *name, size_t index);
 
+/**
+ * Get the type, length and value of the segment at the given index without creating a `CCNxNameSegment`.
+ *
+ * The returned pointer refers to storage inside @p name and is valid until @p name is modified or released.
+ * The index must be greater than or equal to zero and less than {@link ccnxName_GetSegmentCount}().
+ *
+ * @param [in] name The target `CCNxName`
+ * @param [in] index The index of the segment.
+ * @param [out] type Set to the type of the segment.
+ * @param [out] length Set to the length of the value of the segment.
+ *
+ * @return A pointer to the first byte of the value of the segment.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxName *name = ccnxName_CreateFromCString("lci:/parc/csl/things/b00se");
+ *     CCNxNameLabelType type;
+ *     size_t length;
+ *     const uint8_t *value = ccnxName_GetSegmentTypeValueArray(name, 2, &type, &length);
+ *
+ *     ccnxName_Release(&name);
+ * }
+ * @endcode
+ *
+ * @see ccnxName_AppendTypeValueArray
+ */
+const uint8_t *ccnxName_GetSegmentTypeValueArray(const CCNxName *name, size_t index, CCNxNameLabelType *type, size_t *length);
+
 /**
  * Get the number of `CCNxNameSegments` in the specified `CCNxName`.
  *
@@ -630,6 +685,10 @@ PARCHashCode ccnxName_HashCode(const CCNxName *name);
  *
  * See @{link ccnxName_HashCode} for more information.
  *
+ * The hash codes of all the prefixes of @p name are computed together the first time they are needed
+ * and are kept with the name, so a longest-prefix match that asks for every prefix length does linear work in total.
+ * {@link ccnxName_Trim} discards the hash codes of the removed segments, and {@link ccnxName_Append} keeps the others.
+ *
  * @param [in] name A pointer to a `CCNxName` instance.
  * @param [in] count The number, starting from the left, of path segments to use to compute the hash.
  *
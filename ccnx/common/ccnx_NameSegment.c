@@ -69,6 +69,7 @@
 #include <parc/algol/parc_Varint.h>
 #include <parc/algol/parc_DisplayIndented.h>
 #include <parc/algol/parc_Hash.h>
+#include <parc/algol/parc_HashCode.h>
 #include <parc/algol/parc_Object.h>
 
 #include <ccnx/common/ccnx_NameSegment.h>
@@ -286,20 +287,27 @@ ccnxNameSegment_BuildString(const CCNxNameSegment *segment, PARCBufferComposer *
 }
 
 PARCHashCode
-ccnxNameSegment_HashCode(const CCNxNameSegment *segment)
+ccnxNameSegment_HashCodeTypeValue(CCNxNameLabelType type, size_t length, const uint8_t value[length])
 {
-    PARCHash32Bits *hash = parcHash32Bits_Create();
+    // Equivalent to updating a PARCHash32Bits with the type and then the hash code of the value,
+    // but without creating and releasing a PARCHash32Bits instance.
+    uint32_t result = parcHash32_Data_Cumulative(&type, sizeof(type), 0);
 
-    parcHash32Bits_Update(hash, &segment->type, sizeof(segment->type));
-    if (parcBuffer_Remaining(segment->value) > 0) {
-        parcHash32Bits_UpdateUint32(hash, parcBuffer_HashCode(segment->value));
+    if (length > 0) {
+        uint32_t valueHashCode = (uint32_t) parcHashCode_Hash(value, length);
+        result = parcHash32_Data_Cumulative(&valueHashCode, sizeof(valueHashCode), result);
     }
 
-    uint32_t result = parcHash32Bits_Hash(hash);
+    return result;
+}
 
-    parcHash32Bits_Release(&hash);
+PARCHashCode
+ccnxNameSegment_HashCode(const CCNxNameSegment *segment)
+{
+    size_t length = parcBuffer_Remaining(segment->value);
+    const uint8_t *value = (length > 0) ? parcBuffer_Overlay(segment->value, 0) : NULL;
 
-    return result;
+    return ccnxNameSegment_HashCodeTypeValue(segment->type, length, value);
 }
 
 char *
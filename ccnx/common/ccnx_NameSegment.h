@@ -497,6 +497,29 @@ CCNxNameLabelType ccnxNameSegment_GetType(const CCNxNameSegment *segment);
  */
 PARCHashCode ccnxNameSegment_HashCode(const CCNxNameSegment *segment);
 
+/**
+ * Compute the hash code of a name segment with the given type and value, without a `CCNxNameSegment` instance.
+ *
+ * The result is the same value that {@link ccnxNameSegment_HashCode} returns for a segment with this type and value.
+ * This function does not allocate memory.
+ *
+ * @param [in] type A valid CCNxNameLabelType
+ * @param [in] length The number of bytes in @p value.
+ * @param [in] value A pointer to the bytes of the value of the name segment.
+ *
+ * @return An unsigned 32-bit integer hash code value.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCHashCode hashCode = ccnxNameSegment_HashCodeTypeValue(CCNxNameLabelType_NAME, 4, (const uint8_t *) "Test");
+ * }
+ * @endcode
+ *
+ * @see ccnxNameSegment_HashCode
+ */
+PARCHashCode ccnxNameSegment_HashCodeTypeValue(CCNxNameLabelType type, size_t length, const uint8_t value[length]);
+
 /**
  * Increase the number of references to a `CCNxNameSegment`.
  *
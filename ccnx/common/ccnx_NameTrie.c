@@ -0,0 +1,706 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <LongBow/runtime.h>
+
+#include <ccnx/common/ccnx_NameTrie.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_HashCode.h>
+
+#define _ccnxNameTrie_None UINT32_MAX
+#define _ccnxNameTrie_Root 0
+
+#define _ccnxNameTrie_InitialNodeCapacity 64
+#define _ccnxNameTrie_InitialSlotBits 7
+#define _ccnxNameTrie_InitialSegmentValueCapacity 1024
+
+// Segment value storage is compacted once at least this many bytes, and at least half of it, belong to removed nodes.
+#define _ccnxNameTrie_MinimumGarbage 4096
+
+/*
+ * Every prefix of every name in the trie is a node.  Node 0 is the root, the name with no segments.
+ * A node is identified by its parent and its segment, and it is filed in `slots` under the cumulative hash code
+ * of its prefix, which is ccnxName_LeftMostHashCode of the prefix.
+ *
+ * The children of a node are a doubly linked list through `nextSibling` and `previousSibling`,
+ * used only to enumerate and to unlink, never to look up.
+ * A node without a value and without children is removed.  Removed nodes are chained through `nextSibling`
+ * from `freeNode` and have a `parent` of _ccnxNameTrie_None.
+ *
+ * `liveNodeCount` does not include the root, which is never in the hash table.
+ *
+ * The value of each segment is stored at [offset, offset + length) of `segmentValues`.
+ * The space of removed segments is reclaimed by compacting the array.
+ */
+typedef struct {
+    PARCHashCode hashCode;
+    uint32_t parent;
+    uint32_t firstChild;
+    uint32_t nextSibling;
+    uint32_t previousSibling;
+    CCNxNameLabelType type;
+    uint32_t offset;
+    uint32_t length;
+    PARCObject *value;
+} _CCNxNameTrieNode;
+
+/*
+ * An open addressing hash table with linear probing.  A slot keeps (part of) the hash code of its node
+ * so that most mismatches are rejected without touching the node.
+ */
+typedef struct {
+    uint32_t hashCode;
+    uint32_t node;
+} _CCNxNameTrieSlot;
+
+struct ccnx_name_trie {
+    size_t size;
+
+    _CCNxNameTrieNode *nodes;
+    uint32_t nodeCount;
+    uint32_t nodeCapacity;
+    uint32_t liveNodeCount;
+    uint32_t freeNode;
+
+    _CCNxNameTrieSlot *slots;
+    unsigned slotBits;
+    size_t slotMask;
+
+    uint8_t *segmentValues;
+    size_t segmentValuesLength;
+    size_t segmentValuesCapacity;
+    size_t segmentValuesGarbage;
+};
+
+/*
+ * The segments of a name being looked up, from either a CCNxName or a CCNxNameView,
+ * together with the cumulative hash code of the prefix ending at the current segment.
+ */
+typedef struct {
+    const CCNxName *name;
+    CCNxNameViewIterator iterator;
+    size_t count;
+    size_t index;
+    PARCHashCode hashCode;
+    CCNxNameLabelType type;
+    size_t length;
+    const uint8_t *value;
+} _CCNxNameTrieKey;
+
+static void
+_ccnxNameTrieKey_InitName(_CCNxNameTrieKey *key, const CCNxName *name)
+{
+    key->name = name;
+    key->count = ccnxName_GetSegmentCount(name);
+    key->index = 0;
+    key->hashCode = 0;
+}
+
+static void
+_ccnxNameTrieKey_InitView(_CCNxNameTrieKey *key, const CCNxNameView *view)
+{
+    key->name = NULL;
+    ccnxNameViewIterator_Init(&key->iterator, view);
+    key->count = ccnxNameView_GetSegmentCount(view);
+    key->index = 0;
+    key->hashCode = 0;
+}
+
+/*
+ * Advance to the next segment of the key.  The prefix hash codes of a CCNxName are cached on the name.
+ */
+static inline bool
+_ccnxNameTrieKey_Next(_CCNxNameTrieKey *key)
+{
+    if (key->index >= key->count) {
+        return false;
+    }
+
+    if (key->name != NULL) {
+        key->value = ccnxName_GetSegmentTypeValueArray(key->name, key->index, &key->type, &key->length);
+        key->hashCode = ccnxName_LeftMostHashCode(key->name, key->index + 1);
+    } else {
+        CCNxNameViewSegment segment;
+        ccnxNameViewIterator_Next(&key->iterator, &segment);
+        key->type = segment.type;
+        key->length = segment.length;
+        key->value = segment.value;
+        key->hashCode = parcHashCode_HashHashCode(key->hashCode, ccnxNameSegment_HashCodeTypeValue(segment.type, segment.length, segment.value));
+    }
+
+    key->index++;
+    return true;
+}
+
+static inline size_t
+_ccnxNameTrie_HomeSlot(const CCNxNameTrie *trie, uint32_t hashCode)
+{
+    // Fibonacci hashing spreads hash codes that differ only in their high bits across the table.
+    return (size_t) ((uint32_t) (hashCode * 2654435769u) >> (32 - trie->slotBits));
+}
+
+static uint32_t
+_ccnxNameTrie_FindChild(const CCNxNameTrie *trie, uint32_t parent, const _CCNxNameTrieKey *key)
+{
+    uint32_t hashCode = (uint32_t) key->hashCode;
+
+    for (size_t i = _ccnxNameTrie_HomeSlot(trie, hashCode); trie->slots[i].node != _ccnxNameTrie_None; i = (i + 1) & trie->slotMask) {
+        if (trie->slots[i].hashCode == hashCode) {
+            const _CCNxNameTrieNode *node = &trie->nodes[trie->slots[i].node];
+            if (node->parent == parent && node->type == key->type && node->length == key->length
+                && memcmp(&trie->segmentValues[node->offset], key->value, key->length) == 0) {
+                return trie->slots[i].node;
+            }
+        }
+    }
+
+    return _ccnxNameTrie_None;
+}
+
+/*
+ * Follow the key from the root for as long as the trie has a matching node.
+ * Return the number of segments of the key that were matched and set `node` to the deepest node reached.
+ * If `match` is not NULL, set it to the deepest node on the path that has a value, and `matchLength` to its depth,
+ * or set it to _ccnxNameTrie_None if there is no such node.
+ */
+static size_t
+_ccnxNameTrie_Walk(const CCNxNameTrie *trie, _CCNxNameTrieKey *key, uint32_t *node, uint32_t *match, size_t *matchLength)
+{
+    uint32_t current = _ccnxNameTrie_Root;
+    size_t depth = 0;
+
+    if (match != NULL) {
+        *match = (trie->nodes[current].value != NULL) ? current : _ccnxNameTrie_None;
+        *matchLength = 0;
+    }
+
+    while (_ccnxNameTrieKey_Next(key)) {
+        uint32_t child = _ccnxNameTrie_FindChild(trie, current, key);
+        if (child == _ccnxNameTrie_None) {
+            break;
+        }
+        current = child;
+        depth++;
+
+        if (match != NULL && trie->nodes[current].value != NULL) {
+            *match = current;
+            *matchLength = depth;
+        }
+    }
+
+    *node = current;
+    return depth;
+}
+
+static void
+_ccnxNameTrie_InsertSlot(CCNxNameTrie *trie, uint32_t index)
+{
+    uint32_t hashCode = (uint32_t) trie->nodes[index].hashCode;
+
+    size_t i = _ccnxNameTrie_HomeSlot(trie, hashCode);
+    while (trie->slots[i].node != _ccnxNameTrie_None) {
+        i = (i + 1) & trie->slotMask;
+    }
+    trie->slots[i].hashCode = hashCode;
+    trie->slots[i].node = index;
+}
+
+/*
+ * Remove a node from the hash table by shifting back the entries that follow it in its probe sequence,
+ * so that the table never needs tombstones.
+ */
+static void
+_ccnxNameTrie_RemoveSlot(CCNxNameTrie *trie, uint32_t index)
+{
+    size_t i = _ccnxNameTrie_HomeSlot(trie, (uint32_t) trie->nodes[index].hashCode);
+    while (trie->slots[i].node != index) {
+        i = (i + 1) & trie->slotMask;
+    }
+
+    for (size_t j = (i + 1) & trie->slotMask; trie->slots[j].node != _ccnxNameTrie_None; j = (j + 1) & trie->slotMask) {
+        size_t home = _ccnxNameTrie_HomeSlot(trie, trie->slots[j].hashCode);
+
+        // The entry in slot j may move to slot i only if its home slot is not cyclically within (i, j].
+        bool homeBetween = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+        if (!homeBetween) {
+            trie->slots[i] = trie->slots[j];
+            i = j;
+        }
+    }
+
+    trie->slots[i].node = _ccnxNameTrie_None;
+}
+
+static bool
+_ccnxNameTrie_AllocateSlots(CCNxNameTrie *trie, unsigned slotBits)
+{
+    size_t slotCount = (size_t) 1 << slotBits;
+
+    _CCNxNameTrieSlot *slots = parcMemory_Allocate(slotCount * sizeof(_CCNxNameTrieSlot));
+    if (slots == NULL) {
+        return false;
+    }
+    for (size_t i = 0; i < slotCount; i++) {
+        slots[i].node = _ccnxNameTrie_None;
+    }
+
+    if (trie->slots != NULL) {
+        parcMemory_Deallocate(&trie->slots);
+    }
+    trie->slots = slots;
+    trie->slotBits = slotBits;
+    trie->slotMask = slotCount - 1;
+
+    for (uint32_t i = 1; i < trie->nodeCount; i++) {
+        if (trie->nodes[i].parent != _ccnxNameTrie_None) {
+            _ccnxNameTrie_InsertSlot(trie, i);
+        }
+    }
+    return true;
+}
+
+/*
+ * Keep the hash table at most half full.
+ */
+static void
+_ccnxNameTrie_EnsureSlot(CCNxNameTrie *trie)
+{
+    if (((size_t) trie->liveNodeCount + 1) * 2 > trie->slotMask + 1) {
+        bool success = _ccnxNameTrie_AllocateSlots(trie, trie->slotBits + 1);
+        trapOutOfMemoryIf(!success, "Cannot grow the hash table of the CCNxNameTrie");
+    }
+}
+
+static uint32_t
+_ccnxNameTrie_AllocateNode(CCNxNameTrie *trie)
+{
+    uint32_t result = trie->freeNode;
+
+    if (result != _ccnxNameTrie_None) {
+        trie->freeNode = trie->nodes[result].nextSibling;
+    } else {
+        if (trie->nodeCount == trie->nodeCapacity) {
+            trapOutOfMemoryIf(trie->nodeCapacity > UINT32_MAX / 2, "Too many nodes in the CCNxNameTrie");
+            uint32_t capacity = trie->nodeCapacity * 2;
+            trie->nodes = parcMemory_Reallocate(trie->nodes, capacity * sizeof(_CCNxNameTrieNode));
+            trapOutOfMemoryIf(trie->nodes == NULL, "Cannot grow the nodes of the CCNxNameTrie");
+            trie->nodeCapacity = capacity;
+        }
+        result = trie->nodeCount++;
+    }
+
+    trie->liveNodeCount++;
+    return result;
+}
+
+static uint32_t
+_ccnxNameTrie_StoreSegmentValue(CCNxNameTrie *trie, size_t length, const uint8_t value[length])
+{
+    if (trie->segmentValuesLength + length > trie->segmentValuesCapacity) {
+        size_t capacity = trie->segmentValuesCapacity * 2;
+        while (trie->segmentValuesLength + length > capacity) {
+            capacity *= 2;
+        }
+        trie->segmentValues = parcMemory_Reallocate(trie->segmentValues, capacity);
+        trapOutOfMemoryIf(trie->segmentValues == NULL, "Cannot grow the segment values of the CCNxNameTrie");
+        trie->segmentValuesCapacity = capacity;
+    }
+    trapOutOfMemoryIf(trie->segmentValuesLength + length > UINT32_MAX, "Too many segment value bytes in the CCNxNameTrie");
+
+    uint32_t result = (uint32_t) trie->segmentValuesLength;
+    memcpy(&trie->segmentValues[result], value, length);
+    trie->segmentValuesLength += length;
+    return result;
+}
+
+static uint32_t
+_ccnxNameTrie_AddChild(CCNxNameTrie *trie, uint32_t parent, const _CCNxNameTrieKey *key)
+{
+    _ccnxNameTrie_EnsureSlot(trie);
+
+    uint32_t index = _ccnxNameTrie_AllocateNode(trie);
+    _CCNxNameTrieNode *node = &trie->nodes[index];
+    _CCNxNameTrieNode *parentNode = &trie->nodes[parent];
+
+    node->hashCode = key->hashCode;
+    node->parent = parent;
+    node->firstChild = _ccnxNameTrie_None;
+    node->previousSibling = _ccnxNameTrie_None;
+    node->nextSibling = parentNode->firstChild;
+    node->type = key->type;
+    node->length = (uint32_t) key->length;
+    node->offset = _ccnxNameTrie_StoreSegmentValue(trie, key->length, key->value);
+    node->value = NULL;
+
+    if (parentNode->firstChild != _ccnxNameTrie_None) {
+        trie->nodes[parentNode->firstChild].previousSibling = index;
+    }
+    parentNode->firstChild = index;
+
+    _ccnxNameTrie_InsertSlot(trie, index);
+    return index;
+}
+
+static void
+_ccnxNameTrie_FreeNode(CCNxNameTrie *trie, uint32_t index)
+{
+    _ccnxNameTrie_RemoveSlot(trie, index);
+
+    _CCNxNameTrieNode *node = &trie->nodes[index];
+    if (node->previousSibling != _ccnxNameTrie_None) {
+        trie->nodes[node->previousSibling].nextSibling = node->nextSibling;
+    } else {
+        trie->nodes[node->parent].firstChild = node->nextSibling;
+    }
+    if (node->nextSibling != _ccnxNameTrie_None) {
+        trie->nodes[node->nextSibling].previousSibling = node->previousSibling;
+    }
+
+    trie->segmentValuesGarbage += node->length;
+
+    node->parent = _ccnxNameTrie_None;
+    node->nextSibling = trie->freeNode;
+    trie->freeNode = index;
+    trie->liveNodeCount--;
+}
+
+/*
+ * Copy the values of the remaining segments into a new array if removed segments have left too much unused space.
+ */
+static void
+_ccnxNameTrie_CompactSegmentValues(CCNxNameTrie *trie)
+{
+    if (trie->segmentValuesGarbage < _ccnxNameTrie_MinimumGarbage || trie->segmentValuesGarbage * 2 < trie->segmentValuesLength) {
+        return;
+    }
+
+    size_t capacity = trie->segmentValuesCapacity;
+    while (capacity / 2 >= trie->segmentValuesLength - trie->segmentValuesGarbage
+           && capacity / 2 >= _ccnxNameTrie_InitialSegmentValueCapacity) {
+        capacity /= 2;
+    }
+
+    uint8_t *segmentValues = parcMemory_Allocate(capacity);
+    if (segmentValues == NULL) {
+        // Keep using the old array; compaction is only an optimisation.
+        return;
+    }
+
+    size_t length = 0;
+    for (uint32_t i = 1; i < trie->nodeCount; i++) {
+        _CCNxNameTrieNode *node = &trie->nodes[i];
+        if (node->parent != _ccnxNameTrie_None) {
+            memcpy(&segmentValues[length], &trie->segmentValues[node->offset], node->length);
+            node->offset = (uint32_t) length;
+            length += node->length;
+        }
+    }
+
+    parcMemory_Deallocate(&trie->segmentValues);
+    trie->segmentValues = segmentValues;
+    trie->segmentValuesLength = length;
+    trie->segmentValuesCapacity = capacity;
+    trie->segmentValuesGarbage = 0;
+}
+
+static bool
+_ccnxNameTrie_Destructor(CCNxNameTrie **trieP)
+{
+    CCNxNameTrie *trie = *trieP;
+
+    if (trie->nodes != NULL) {
+        for (uint32_t i = 0; i < trie->nodeCount; i++) {
+            // Removed nodes never have a value.
+            if (trie->nodes[i].value != NULL) {
+                parcObject_Release(&trie->nodes[i].value);
+            }
+        }
+        parcMemory_Deallocate(&trie->nodes);
+    }
+    if (trie->slots != NULL) {
+        parcMemory_Deallocate(&trie->slots);
+    }
+    if (trie->segmentValues != NULL) {
+        parcMemory_Deallocate(&trie->segmentValues);
+    }
+    return true;
+}
+
+parcObject_Override(CCNxNameTrie, PARCObject,
+                    .destructor = (PARCObjectDestructor *) _ccnxNameTrie_Destructor);
+
+parcObject_ImplementAcquire(ccnxNameTrie, CCNxNameTrie);
+
+parcObject_ImplementRelease(ccnxNameTrie, CCNxNameTrie);
+
+CCNxNameTrie *
+ccnxNameTrie_Create(void)
+{
+    CCNxNameTrie *result = parcObject_CreateAndClearInstance(CCNxNameTrie);
+
+    if (result != NULL) {
+        result->nodes = parcMemory_Allocate(_ccnxNameTrie_InitialNodeCapacity * sizeof(_CCNxNameTrieNode));
+        result->segmentValues = parcMemory_Allocate(_ccnxNameTrie_InitialSegmentValueCapacity);
+        result->nodeCount = 1;
+        result->freeNode = _ccnxNameTrie_None;
+
+        if (result->nodes == NULL || result->segmentValues == NULL || !_ccnxNameTrie_AllocateSlots(result, _ccnxNameTrie_InitialSlotBits)) {
+            ccnxNameTrie_Release(&result);
+            return NULL;
+        }
+        result->nodeCapacity = _ccnxNameTrie_InitialNodeCapacity;
+        result->segmentValuesCapacity = _ccnxNameTrie_InitialSegmentValueCapacity;
+
+        _CCNxNameTrieNode *root = &result->nodes[_ccnxNameTrie_Root];
+        root->hashCode = 0;
+        root->parent = _ccnxNameTrie_None;
+        root->firstChild = _ccnxNameTrie_None;
+        root->nextSibling = _ccnxNameTrie_None;
+        root->previousSibling = _ccnxNameTrie_None;
+        root->type = 0;
+        root->offset = 0;
+        root->length = 0;
+        root->value = NULL;
+    }
+
+    return result;
+}
+
+size_t
+ccnxNameTrie_Size(const CCNxNameTrie *trie)
+{
+    return trie->size;
+}
+
+bool
+ccnxNameTrie_Put(CCNxNameTrie *trie, const CCNxName *name, const PARCObject *value)
+{
+    assertNotNull(value, "Parameter value must be non-null");
+
+    _CCNxNameTrieKey key;
+    _ccnxNameTrieKey_InitName(&key, name);
+
+    uint32_t node;
+    size_t depth = _ccnxNameTrie_Walk(trie, &key, &node, NULL, NULL);
+
+    // The walk stopped at the first segment without a node, and the key is positioned on it.
+    if (depth < key.count) {
+        do {
+            node = _ccnxNameTrie_AddChild(trie, node, &key);
+        } while (_ccnxNameTrieKey_Next(&key));
+    }
+
+    bool result = (trie->nodes[node].value == NULL);
+    if (result) {
+        trie->size++;
+    } else {
+        parcObject_Release(&trie->nodes[node].value);
+    }
+    trie->nodes[node].value = parcObject_Acquire(value);
+
+    return result;
+}
+
+bool
+ccnxNameTrie_Remove(CCNxNameTrie *trie, const CCNxName *name)
+{
+    _CCNxNameTrieKey key;
+    _ccnxNameTrieKey_InitName(&key, name);
+
+    uint32_t node;
+    size_t depth = _ccnxNameTrie_Walk(trie, &key, &node, NULL, NULL);
+
+    if (depth < key.count || trie->nodes[node].value == NULL) {
+        return false;
+    }
+
+    parcObject_Release(&trie->nodes[node].value);
+    trie->size--;
+
+    while (node != _ccnxNameTrie_Root && trie->nodes[node].value == NULL && trie->nodes[node].firstChild == _ccnxNameTrie_None) {
+        uint32_t parent = trie->nodes[node].parent;
+        _ccnxNameTrie_FreeNode(trie, node);
+        node = parent;
+    }
+
+    _ccnxNameTrie_CompactSegmentValues(trie);
+    return true;
+}
+
+static PARCObject *
+_ccnxNameTrie_Get(const CCNxNameTrie *trie, _CCNxNameTrieKey *key)
+{
+    uint32_t node;
+    size_t depth = _ccnxNameTrie_Walk(trie, key, &node, NULL, NULL);
+
+    return (depth == key->count) ? trie->nodes[node].value : NULL;
+}
+
+PARCObject *
+ccnxNameTrie_Get(const CCNxNameTrie *trie, const CCNxName *name)
+{
+    _CCNxNameTrieKey key;
+    _ccnxNameTrieKey_InitName(&key, name);
+
+    return _ccnxNameTrie_Get(trie, &key);
+}
+
+PARCObject *
+ccnxNameTrie_GetView(const CCNxNameTrie *trie, const CCNxNameView *view)
+{
+    _CCNxNameTrieKey key;
+    _ccnxNameTrieKey_InitView(&key, view);
+
+    return _ccnxNameTrie_Get(trie, &key);
+}
+
+static PARCObject *
+_ccnxNameTrie_LongestPrefixMatch(const CCNxNameTrie *trie, _CCNxNameTrieKey *key, size_t *matchLength)
+{
+    uint32_t node;
+    uint32_t match;
+    size_t length;
+    _ccnxNameTrie_Walk(trie, key, &node, &match, &length);
+
+    if (match == _ccnxNameTrie_None) {
+        return NULL;
+    }
+    if (matchLength != NULL) {
+        *matchLength = length;
+    }
+    return trie->nodes[match].value;
+}
+
+PARCObject *
+ccnxNameTrie_LongestPrefixMatch(const CCNxNameTrie *trie, const CCNxName *name, size_t *matchLength)
+{
+    _CCNxNameTrieKey key;
+    _ccnxNameTrieKey_InitName(&key, name);
+
+    return _ccnxNameTrie_LongestPrefixMatch(trie, &key, matchLength);
+}
+
+PARCObject *
+ccnxNameTrie_LongestPrefixMatchView(const CCNxNameTrie *trie, const CCNxNameView *view, size_t *matchLength)
+{
+    _CCNxNameTrieKey key;
+    _ccnxNameTrieKey_InitView(&key, view);
+
+    return _ccnxNameTrie_LongestPrefixMatch(trie, &key, matchLength);
+}
+
+static void
+_ccnxNameTrie_AppendSegment(const CCNxNameTrie *trie, CCNxName *name, uint32_t index)
+{
+    const _CCNxNameTrieNode *node = &trie->nodes[index];
+    ccnxName_AppendTypeValueArray(name, node->type, node->length, &trie->segmentValues[node->offset]);
+}
+
+size_t
+ccnxNameTrie_ForEachWithPrefix(const CCNxNameTrie *trie, const CCNxName *prefix, CCNxNameTrieVisitor *visitor, void *context)
+{
+    _CCNxNameTrieKey key;
+    _ccnxNameTrieKey_InitName(&key, prefix);
+
+    uint32_t top;
+    if (_ccnxNameTrie_Walk(trie, &key, &top, NULL, NULL) < key.count) {
+        return 0;
+    }
+
+    // The name of the current node is kept in `name` by appending a segment on the way down and trimming on the way up.
+    CCNxName *name = ccnxName_Copy(prefix);
+    size_t result = 0;
+
+    uint32_t current = top;
+    for (;;) {
+        const _CCNxNameTrieNode *node = &trie->nodes[current];
+
+        if (node->value != NULL) {
+            result++;
+            if (!visitor(name, node->value, context)) {
+                break;
+            }
+        }
+
+        if (node->firstChild != _ccnxNameTrie_None) {
+            current = node->firstChild;
+            _ccnxNameTrie_AppendSegment(trie, name, current);
+            continue;
+        }
+
+        while (current != top && trie->nodes[current].nextSibling == _ccnxNameTrie_None) {
+            current = trie->nodes[current].parent;
+            ccnxName_Trim(name, 1);
+        }
+        if (current == top) {
+            break;
+        }
+
+        current = trie->nodes[current].nextSibling;
+        ccnxName_Trim(name, 1);
+        _ccnxNameTrie_AppendSegment(trie, name, current);
+    }
+
+    ccnxName_Release(&name);
+    return result;
+}
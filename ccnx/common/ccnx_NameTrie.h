@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file ccnx_NameTrie.h
+ * @ingroup Naming
+ * @brief A table of values keyed by CCNx Name, with longest prefix match.
+ *
+ * A `CCNxNameTrie` maps a {@link CCNxName} to a `PARCObject` value.
+ * It supports insertion, removal, exact match, longest prefix match and enumeration of every entry under a prefix,
+ * and can look names up directly from a wire format {@link CCNxNameView} without creating a `CCNxName`.
+ *
+ * The trie is stored as a hashed table of name prefixes.
+ * Each node is one name segment and is found by the cumulative hash code of its prefix,
+ * the same value as {@link ccnxName_LeftMostHashCode}, in an open addressing table.
+ * Matching a name of n segments costs at most n probes of that table,
+ * and a name reuses its cached prefix hash codes across lookups.
+ * Nodes and segment values are held in contiguous arrays, so a lookup does not chase a pointer per segment.
+ *
+ * Lookups may run concurrently with each other.  Put and Remove require exclusive access to the trie.
+ *
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef libccnx_ccnx_NameTrie_h
+#define libccnx_ccnx_NameTrie_h
+
+#include <stdbool.h>
+
+#include <parc/algol/parc_Object.h>
+
+#include <ccnx/common/ccnx_Name.h>
+#include <ccnx/common/ccnx_NameView.h>
+
+struct ccnx_name_trie;
+/**
+ * @typedef CCNxNameTrie
+ * @brief A table of values keyed by `CCNxName`.
+ */
+typedef struct ccnx_name_trie CCNxNameTrie;
+
+/**
+ * @typedef CCNxNameTrieVisitor
+ * @brief The function called for each entry by {@link ccnxNameTrie_ForEachWithPrefix}.
+ *
+ * The `name` is valid only for the duration of the call.  Copy it to keep it.
+ * The visitor must not modify the trie.
+ *
+ * @return true Continue the enumeration.
+ * @return false Stop the enumeration.
+ */
+typedef bool (CCNxNameTrieVisitor)(const CCNxName *name, PARCObject *value, void *context);
+
+/**
+ * Create a new, empty `CCNxNameTrie`.
+ *
+ * @return A pointer to a new `CCNxNameTrie` instance, or NULL if out of memory.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxNameTrie *trie = ccnxNameTrie_Create();
+ *
+ *     ccnxNameTrie_Release(&trie);
+ * }
+ * @endcode
+ */
+CCNxNameTrie *ccnxNameTrie_Create(void);
+
+/**
+ * Increase the number of references to a `CCNxNameTrie`.
+ *
+ * Note that a new `CCNxNameTrie` is not created,
+ * only that the given `CCNxNameTrie` reference count is incremented.
+ * Discard the reference by invoking {@link ccnxNameTrie_Release}.
+ *
+ * @param [in] trie A pointer to the original instance.
+ * @return The value of the input parameter @p trie.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxNameTrie *reference = ccnxNameTrie_Acquire(trie);
+ *
+ *     ccnxNameTrie_Release(&reference);
+ * }
+ * @endcode
+ *
+ * @see ccnxNameTrie_Release
+ */
+CCNxNameTrie *ccnxNameTrie_Acquire(const CCNxNameTrie *trie);
+
+/**
+ * Release a previously acquired reference to the specified instance,
+ * decrementing the reference count for the instance.
+ *
+ * The pointer to the instance is set to NULL as a side-effect of this function.
+ *
+ * If the invocation causes the last reference to the instance to be released,
+ * the instance is deallocated and every value in the trie is released.
+ *
+ * @param [in,out] trieP A pointer to a pointer to the instance to release.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxNameTrie *trie = ccnxNameTrie_Create();
+ *
+ *     ccnxNameTrie_Release(&trie);
+ * }
+ * @endcode
+ */
+void ccnxNameTrie_Release(CCNxNameTrie **trieP);
+
+/**
+ * Return the number of entries in the given `CCNxNameTrie`.
+ *
+ * @param [in] trie A pointer to a valid `CCNxNameTrie`.
+ *
+ * @return The number of names that have a value.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t size = ccnxNameTrie_Size(trie);
+ * }
+ * @endcode
+ */
+size_t ccnxNameTrie_Size(const CCNxNameTrie *trie);
+
+/**
+ * Associate a value with a name, replacing any value that the name already has.
+ *
+ * The trie acquires a reference to @p value and releases the reference to any value it replaces.
+ * Neither @p name nor any of its segments is retained.
+ *
+ * @param [in] trie A pointer to a valid `CCNxNameTrie`.
+ * @param [in] name A pointer to a valid `CCNxName`.
+ * @param [in] value A pointer to a valid `PARCObject`.
+ *
+ * @return true The name was not in the trie and has been added.
+ * @return false The name was in the trie and its value has been replaced.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxName *name = ccnxName_CreateFromCString("lci:/parc/csl");
+ *     ccnxNameTrie_Put(trie, name, value);
+ *     ccnxName_Release(&name);
+ * }
+ * @endcode
+ */
+bool ccnxNameTrie_Put(CCNxNameTrie *trie, const CCNxName *name, const PARCObject *value);
+
+/**
+ * Remove the value associated with a name.
+ *
+ * @param [in] trie A pointer to a valid `CCNxNameTrie`.
+ * @param [in] name A pointer to a valid `CCNxName`.
+ *
+ * @return true The name was in the trie and its value has been released.
+ * @return false The name was not in the trie.
+ *
+ * Example:
+ * @code
+ * {
+ *     ccnxNameTrie_Remove(trie, name);
+ * }
+ * @endcode
+ */
+bool ccnxNameTrie_Remove(CCNxNameTrie *trie, const CCNxName *name);
+
+/**
+ * Get the value associated with exactly the given name.
+ *
+ * The trie keeps its reference to the returned value.  Acquire it to keep it beyond the next modification of the trie.
+ *
+ * @param [in] trie A pointer to a valid `CCNxNameTrie`.
+ * @param [in] name A pointer to a valid `CCNxName`.
+ *
+ * @return non-NULL The value associated with @p name.
+ * @return NULL The name is not in the trie.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCObject *value = ccnxNameTrie_Get(trie, name);
+ * }
+ * @endcode
+ */
+PARCObject *ccnxNameTrie_Get(const CCNxNameTrie *trie, const CCNxName *name);
+
+/**
+ * Get the value associated with exactly the name in the given `CCNxNameView`.
+ *
+ * @param [in] trie A pointer to a valid `CCNxNameTrie`.
+ * @param [in] view A pointer to a valid `CCNxNameView`.
+ *
+ * @return non-NULL The value associated with the name.
+ * @return NULL The name is not in the trie.
+ *
+ * @see ccnxNameTrie_Get
+ */
+PARCObject *ccnxNameTrie_GetView(const CCNxNameTrie *trie, const CCNxNameView *view);
+
+/**
+ * Get the value of the longest name in the trie that is a prefix of the given name.
+ *
+ * A name is a prefix of itself, and the name with no segments is a prefix of every name.
+ * Segments match when their types and values are equal.
+ *
+ * @param [in] trie A pointer to a valid `CCNxNameTrie`.
+ * @param [in] name A pointer to a valid `CCNxName`.
+ * @param [out] matchLength If not NULL, set to the number of segments in the matching prefix.
+ *
+ * @return non-NULL The value of the longest matching prefix.
+ * @return NULL No prefix of @p name is in the trie.  @p matchLength is not set.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxName *name = ccnxName_CreateFromCString("lci:/parc/csl/things/b00se");
+ *     size_t matchLength;
+ *     PARCObject *value = ccnxNameTrie_LongestPrefixMatch(trie, name, &matchLength);
+ *     ccnxName_Release(&name);
+ * }
+ * @endcode
+ */
+PARCObject *ccnxNameTrie_LongestPrefixMatch(const CCNxNameTrie *trie, const CCNxName *name, size_t *matchLength);
+
+/**
+ * Get the value of the longest name in the trie that is a prefix of the name in the given `CCNxNameView`.
+ *
+ * This does not allocate memory.
+ *
+ * @param [in] trie A pointer to a valid `CCNxNameTrie`.
+ * @param [in] view A pointer to a valid `CCNxNameView`.
+ * @param [out] matchLength If not NULL, set to the number of segments in the matching prefix.
+ *
+ * @return non-NULL The value of the longest matching prefix.
+ * @return NULL No prefix of the name is in the trie.  @p matchLength is not set.
+ *
+ * @see ccnxNameTrie_LongestPrefixMatch
+ */
+PARCObject *ccnxNameTrie_LongestPrefixMatchView(const CCNxNameTrie *trie, const CCNxNameView *view, size_t *matchLength);
+
+/**
+ * Call a function for every entry whose name starts with the given prefix, including the prefix itself.
+ *
+ * Entries are visited depth first: a name is visited before the longer names that it is a prefix of.
+ * The order of names that share a parent is not specified.
+ *
+ * @param [in] trie A pointer to a valid `CCNxNameTrie`.
+ * @param [in] prefix A pointer to a valid `CCNxName`.
+ * @param [in] visitor The function to call for each entry.
+ * @param [in] context Passed to @p visitor.
+ *
+ * @return The number of entries visited.
+ *
+ * Example:
+ * @code
+ * static bool
+ * _print(const CCNxName *name, PARCObject *value, void *context)
+ * {
+ *     char *string = ccnxName_ToString(name);
+ *     printf("%s\n", string);
+ *     parcMemory_Deallocate(&string);
+ *     return true;
+ * }
+ *
+ * {
+ *     CCNxName *prefix = ccnxName_CreateFromCString("lci:/parc");
+ *     ccnxNameTrie_ForEachWithPrefix(trie, prefix, _print, NULL);
+ *     ccnxName_Release(&prefix);
+ * }
+ * @endcode
+ */
+size_t ccnxNameTrie_ForEachWithPrefix(const CCNxNameTrie *trie, const CCNxName *prefix, CCNxNameTrieVisitor *visitor, void *context);
+#endif // libccnx_ccnx_NameTrie_h
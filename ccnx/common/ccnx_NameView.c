@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <string.h>
+
+#include <LongBow/runtime.h>
+
+#include <ccnx/common/ccnx_NameView.h>
+
+#include <parc/algol/parc_HashCode.h>
+
+// Each name segment is a TLV with a 2-byte type and a 2-byte length, in network byte order.
+#define _ccnxNameView_SegmentHeaderLength 4
+
+static inline uint16_t
+_ccnxNameView_GetUint16(const uint8_t *p)
+{
+    return (uint16_t) ((p[0] << 8) | p[1]);
+}
+
+bool
+ccnxNameView_Init(CCNxNameView *view, size_t length, const uint8_t value[length])
+{
+    assertNotNull(view, "Parameter view must be non-null");
+
+    size_t segmentCount = 0;
+    size_t offset = 0;
+
+    while (offset < length) {
+        if (length - offset < _ccnxNameView_SegmentHeaderLength) {
+            return false;
+        }
+        size_t segmentLength = _ccnxNameView_GetUint16(&value[offset + 2]);
+        offset += _ccnxNameView_SegmentHeaderLength;
+
+        if (length - offset < segmentLength) {
+            return false;
+        }
+        offset += segmentLength;
+        segmentCount++;
+    }
+
+    view->value = value;
+    view->length = length;
+    view->segmentCount = segmentCount;
+    return true;
+}
+
+size_t
+ccnxNameView_GetSegmentCount(const CCNxNameView *view)
+{
+    return view->segmentCount;
+}
+
+void
+ccnxNameViewIterator_Init(CCNxNameViewIterator *iterator, const CCNxNameView *view)
+{
+    iterator->view = view;
+    iterator->offset = 0;
+}
+
+bool
+ccnxNameViewIterator_Next(CCNxNameViewIterator *iterator, CCNxNameViewSegment *segment)
+{
+    const CCNxNameView *view = iterator->view;
+
+    if (iterator->offset >= view->length) {
+        return false;
+    }
+
+    // ccnxNameView_Init has verified that the segments tile the value exactly.
+    const uint8_t *p = &view->value[iterator->offset];
+    segment->type = (CCNxNameLabelType) _ccnxNameView_GetUint16(p);
+    segment->length = _ccnxNameView_GetUint16(p + 2);
+    segment->value = p + _ccnxNameView_SegmentHeaderLength;
+
+    iterator->offset += _ccnxNameView_SegmentHeaderLength + segment->length;
+    return true;
+}
+
+bool
+ccnxNameView_GetSegment(const CCNxNameView *view, size_t index, CCNxNameViewSegment *segment)
+{
+    if (index >= view->segmentCount) {
+        return false;
+    }
+
+    CCNxNameViewIterator iterator;
+    ccnxNameViewIterator_Init(&iterator, view);
+    for (size_t i = 0; i <= index; i++) {
+        ccnxNameViewIterator_Next(&iterator, segment);
+    }
+    return true;
+}
+
+/*
+ * Compare two segment values the same way as ccnxNameSegment_Compare: shorter values sort first,
+ * values of the same length are compared byte by byte.  The segment types are not compared.
+ */
+static inline int
+_ccnxNameView_CompareValues(size_t lengthA, const uint8_t *valueA, size_t lengthB, const uint8_t *valueB)
+{
+    if (lengthA < lengthB) {
+        return -1;
+    }
+    if (lengthA > lengthB) {
+        return +1;
+    }
+    if (lengthA == 0) {
+        return 0;
+    }
+    return memcmp(valueA, valueB, lengthA);
+}
+
+bool
+ccnxNameView_Equals(const CCNxNameView *a, const CCNxNameView *b)
+{
+    if (a == b) {
+        return true;
+    }
+    if (a == NULL || b == NULL) {
+        return false;
+    }
+
+    // The encodings of two equal names are identical.
+    if (a->length != b->length || a->segmentCount != b->segmentCount) {
+        return false;
+    }
+    return a->length == 0 || memcmp(a->value, b->value, a->length) == 0;
+}
+
+bool
+ccnxNameView_EqualsName(const CCNxNameView *view, const CCNxName *name)
+{
+    if (view == NULL || name == NULL) {
+        return false;
+    }
+    if (view->segmentCount != ccnxName_GetSegmentCount(name)) {
+        return false;
+    }
+
+    CCNxNameViewIterator iterator;
+    CCNxNameViewSegment segment;
+    ccnxNameViewIterator_Init(&iterator, view);
+
+    // Read the name's segments in place; ccnxName_GetSegment would allocate a CCNxNameSegment for each.
+    for (size_t i = 0; ccnxNameViewIterator_Next(&iterator, &segment); i++) {
+        CCNxNameLabelType type;
+        size_t length;
+        const uint8_t *value = ccnxName_GetSegmentTypeValueArray(name, i, &type, &length);
+        if (segment.type != type || segment.length != length) {
+            return false;
+        }
+        if (length > 0 && memcmp(segment.value, value, length) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int
+ccnxNameView_Compare(const CCNxNameView *a, const CCNxNameView *b)
+{
+    if (a == NULL) {
+        if (b == NULL) {
+            return 0;
+        }
+        return -1;
+    }
+    if (b == NULL) {
+        return +1;
+    }
+
+    CCNxNameViewIterator iteratorA;
+    CCNxNameViewIterator iteratorB;
+    CCNxNameViewSegment segmentA;
+    CCNxNameViewSegment segmentB;
+    ccnxNameViewIterator_Init(&iteratorA, a);
+    ccnxNameViewIterator_Init(&iteratorB, b);
+
+    int result = 0;
+    while (result == 0 && ccnxNameViewIterator_Next(&iteratorA, &segmentA) && ccnxNameViewIterator_Next(&iteratorB, &segmentB)) {
+        result = _ccnxNameView_CompareValues(segmentA.length, segmentA.value, segmentB.length, segmentB.value);
+    }
+
+    if (result == 0) {
+        // we got to the end of the shortest name and they are still equal.
+        if (a->segmentCount < b->segmentCount) {
+            result = -1;
+        } else if (a->segmentCount > b->segmentCount) {
+            result = +1;
+        }
+    }
+
+    return result;
+}
+
+bool
+ccnxNameView_StartsWith(const CCNxNameView *view, const CCNxNameView *prefix)
+{
+    if (prefix->segmentCount > view->segmentCount) {
+        return false;
+    }
+
+    CCNxNameViewIterator viewIterator;
+    CCNxNameViewIterator prefixIterator;
+    CCNxNameViewSegment viewSegment;
+    CCNxNameViewSegment prefixSegment;
+    ccnxNameViewIterator_Init(&viewIterator, view);
+    ccnxNameViewIterator_Init(&prefixIterator, prefix);
+
+    while (ccnxNameViewIterator_Next(&prefixIterator, &prefixSegment)) {
+        ccnxNameViewIterator_Next(&viewIterator, &viewSegment);
+        if (_ccnxNameView_CompareValues(prefixSegment.length, prefixSegment.value, viewSegment.length, viewSegment.value) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+ccnxNameView_StartsWithName(const CCNxNameView *view, const CCNxName *prefix)
+{
+    size_t prefixSegmentCount = ccnxName_GetSegmentCount(prefix);
+    if (prefixSegmentCount > view->segmentCount) {
+        return false;
+    }
+
+    CCNxNameViewIterator iterator;
+    CCNxNameViewSegment segment;
+    ccnxNameViewIterator_Init(&iterator, view);
+
+    for (size_t i = 0; i < prefixSegmentCount; i++) {
+        ccnxNameViewIterator_Next(&iterator, &segment);
+
+        CCNxNameLabelType type;
+        size_t length;
+        const uint8_t *value = ccnxName_GetSegmentTypeValueArray(prefix, i, &type, &length);
+
+        if (_ccnxNameView_CompareValues(length, value, segment.length, segment.value) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t
+ccnxNameView_PrefixHashCodes(const CCNxNameView *view, size_t count, PARCHashCode hashCodes[count])
+{
+    if (count > view->segmentCount) {
+        count = view->segmentCount;
+    }
+
+    CCNxNameViewIterator iterator;
+    CCNxNameViewSegment segment;
+    ccnxNameViewIterator_Init(&iterator, view);
+
+    PARCHashCode hashCode = 0;
+    for (size_t i = 0; i < count; i++) {
+        ccnxNameViewIterator_Next(&iterator, &segment);
+        hashCode = parcHashCode_HashHashCode(hashCode, ccnxNameSegment_HashCodeTypeValue(segment.type, segment.length, segment.value));
+        hashCodes[i] = hashCode;
+    }
+
+    return count;
+}
+
+PARCHashCode
+ccnxNameView_LeftMostHashCode(const CCNxNameView *view, size_t count)
+{
+    if (count > view->segmentCount) {
+        count = view->segmentCount;
+    }
+
+    CCNxNameViewIterator iterator;
+    CCNxNameViewSegment segment;
+    ccnxNameViewIterator_Init(&iterator, view);
+
+    PARCHashCode result = 0;
+    for (size_t i = 0; i < count; i++) {
+        ccnxNameViewIterator_Next(&iterator, &segment);
+        result = parcHashCode_HashHashCode(result, ccnxNameSegment_HashCodeTypeValue(segment.type, segment.length, segment.value));
+    }
+
+    return result;
+}
+
+PARCHashCode
+ccnxNameView_HashCode(const CCNxNameView *view)
+{
+    return ccnxNameView_LeftMostHashCode(view, view->segmentCount);
+}
+
+CCNxName *
+ccnxNameView_CreateName(const CCNxNameView *view)
+{
+    CCNxName *result = ccnxName_Create();
+
+    if (result != NULL) {
+        CCNxNameViewIterator iterator;
+        CCNxNameViewSegment segment;
+        ccnxNameViewIterator_Init(&iterator, view);
+
+        while (ccnxNameViewIterator_Next(&iterator, &segment)) {
+            ccnxName_AppendTypeValueArray(result, segment.type, segment.length, segment.value);
+        }
+    }
+
+    return result;
+}
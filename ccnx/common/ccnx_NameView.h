@@ -0,0 +1,412 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file ccnx_NameView.h
+ * @ingroup Naming
+ * @brief A read-only view of a CCNx Name encoded in a wire format buffer.
+ *
+ * A `CCNxNameView` indexes the value of a Name TLV in place: a sequence of name segment TLVs,
+ * each with a 2-byte type and a 2-byte length.
+ * It supports comparison, hashing, prefix matching and segment iteration without allocating memory,
+ * and creates a full {@link CCNxName} only when {@link ccnxNameView_CreateName} is called.
+ *
+ * A `CCNxNameView` is a plain structure, usually on the stack, and is not reference counted.
+ * It does not copy or reference count the memory it views,
+ * so it is valid only for as long as the underlying buffer is valid and unmodified.
+ *
+ * Comparison, prefix matching and hash codes are consistent with the corresponding `CCNxName` functions,
+ * so a view may be used to look up names that are stored as `CCNxName` instances.
+ *
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef libccnx_ccnx_NameView_h
+#define libccnx_ccnx_NameView_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <parc/algol/parc_HashCode.h>
+#include <ccnx/common/ccnx_Name.h>
+
+/**
+ * @typedef CCNxNameView
+ * @brief A read-only view of the value of a wire format Name TLV.
+ */
+typedef struct ccnx_name_view {
+    const uint8_t *value;
+    size_t length;
+    size_t segmentCount;
+} CCNxNameView;
+
+/**
+ * @typedef CCNxNameViewSegment
+ * @brief One name segment of a `CCNxNameView`.  The value points into the viewed buffer.
+ */
+typedef struct ccnx_name_view_segment {
+    CCNxNameLabelType type;
+    size_t length;
+    const uint8_t *value;
+} CCNxNameViewSegment;
+
+/**
+ * @typedef CCNxNameViewIterator
+ * @brief Iterates the segments of a `CCNxNameView` in order.
+ */
+typedef struct ccnx_name_view_iterator {
+    const CCNxNameView *view;
+    size_t offset;
+} CCNxNameViewIterator;
+
+/**
+ * Initialise a `CCNxNameView` over the value of a Name TLV.
+ *
+ * The value must be exactly tiled by name segment TLVs.
+ * A zero length value is the name with no segments.
+ *
+ * @param [out] view The `CCNxNameView` to initialise.
+ * @param [in] length The number of bytes in @p value.
+ * @param [in] value A pointer to the first byte of the Name TLV value (the type of the first segment).
+ *
+ * @return true The view was initialised.
+ * @return false The value is not a well-formed sequence of name segments.  The view is not valid.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t value[] = { 0x00, 0x01, 0x00, 0x04, 'p', 'a', 'r', 'c' };
+ *     CCNxNameView view;
+ *     if (ccnxNameView_Init(&view, sizeof(value), value)) {
+ *         printf("%zu segments\n", ccnxNameView_GetSegmentCount(&view));
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxNameView_Init(CCNxNameView *view, size_t length, const uint8_t value[length]);
+
+/**
+ * Return the number of name segments in the given `CCNxNameView`.
+ *
+ * @param [in] view A pointer to a valid `CCNxNameView`.
+ *
+ * @return The number of segments.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t count = ccnxNameView_GetSegmentCount(&view);
+ * }
+ * @endcode
+ */
+size_t ccnxNameView_GetSegmentCount(const CCNxNameView *view);
+
+/**
+ * Get the segment at the given index.
+ *
+ * This walks the segments from the start of the name.  Use a {@link CCNxNameViewIterator} to visit every segment.
+ *
+ * @param [in] view A pointer to a valid `CCNxNameView`.
+ * @param [in] index The index of the segment, starting at 0.
+ * @param [out] segment Set to the segment at @p index.
+ *
+ * @return true @p segment was set.
+ * @return false @p index is not less than the number of segments.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxNameViewSegment segment;
+ *     if (ccnxNameView_GetSegment(&view, 0, &segment)) {
+ *         printf("type %d length %zu\n", segment.type, segment.length);
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxNameView_GetSegment(const CCNxNameView *view, size_t index, CCNxNameViewSegment *segment);
+
+/**
+ * Initialise an iterator positioned before the first segment of the given `CCNxNameView`.
+ *
+ * @param [out] iterator The `CCNxNameViewIterator` to initialise.
+ * @param [in] view A pointer to a valid `CCNxNameView`.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxNameViewIterator iterator;
+ *     CCNxNameViewSegment segment;
+ *
+ *     ccnxNameViewIterator_Init(&iterator, &view);
+ *     while (ccnxNameViewIterator_Next(&iterator, &segment)) {
+ *         printf("type %d length %zu\n", segment.type, segment.length);
+ *     }
+ * }
+ * @endcode
+ */
+void ccnxNameViewIterator_Init(CCNxNameViewIterator *iterator, const CCNxNameView *view);
+
+/**
+ * Get the next segment from the iterator.
+ *
+ * @param [in,out] iterator A pointer to an initialised `CCNxNameViewIterator`.
+ * @param [out] segment Set to the next segment.
+ *
+ * @return true @p segment was set.
+ * @return false There are no more segments.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxNameViewIterator iterator;
+ *     CCNxNameViewSegment segment;
+ *
+ *     ccnxNameViewIterator_Init(&iterator, &view);
+ *     while (ccnxNameViewIterator_Next(&iterator, &segment)) {
+ *         printf("type %d length %zu\n", segment.type, segment.length);
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxNameViewIterator_Next(CCNxNameViewIterator *iterator, CCNxNameViewSegment *segment);
+
+/**
+ * Determine if two `CCNxNameView` instances view equal names.
+ *
+ * Two names are equal if they have the same segments with the same types and values,
+ * as with {@link ccnxName_Equals}.
+ *
+ * @param [in] a A pointer to a valid `CCNxNameView`.
+ * @param [in] b A pointer to a valid `CCNxNameView`.
+ *
+ * @return true The names are equal.
+ * @return false The names are not equal.
+ *
+ * Example:
+ * @code
+ * {
+ *     if (ccnxNameView_Equals(&viewA, &viewB)) {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxNameView_Equals(const CCNxNameView *a, const CCNxNameView *b);
+
+/**
+ * Determine if a `CCNxNameView` views a name equal to the given `CCNxName`.
+ *
+ * @param [in] view A pointer to a valid `CCNxNameView`.
+ * @param [in] name A pointer to a valid `CCNxName`.
+ *
+ * @return true The names are equal.
+ * @return false The names are not equal.
+ *
+ * Example:
+ * @code
+ * {
+ *     if (ccnxNameView_EqualsName(&view, name)) {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxNameView_EqualsName(const CCNxNameView *view, const CCNxName *name);
+
+/**
+ * Compare two `CCNxNameView` instances in the same order as {@link ccnxName_Compare}.
+ *
+ * @param [in] a A pointer to a valid `CCNxNameView`.
+ * @param [in] b A pointer to a valid `CCNxNameView`.
+ *
+ * @return < 0 @p a sorts before @p b.
+ * @return 0 @p a and @p b are equivalent.
+ * @return > 0 @p a sorts after @p b.
+ *
+ * Example:
+ * @code
+ * {
+ *     int order = ccnxNameView_Compare(&viewA, &viewB);
+ * }
+ * @endcode
+ */
+int ccnxNameView_Compare(const CCNxNameView *a, const CCNxNameView *b);
+
+/**
+ * Determine if the name viewed by @p view starts with the name viewed by @p prefix,
+ * in the same way as {@link ccnxName_StartsWith}.
+ *
+ * @param [in] view A pointer to a valid `CCNxNameView`.
+ * @param [in] prefix A pointer to a valid `CCNxNameView`.
+ *
+ * @return true @p prefix is a prefix of @p view.
+ * @return false @p prefix is not a prefix of @p view.
+ *
+ * Example:
+ * @code
+ * {
+ *     if (ccnxNameView_StartsWith(&view, &prefix)) {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxNameView_StartsWith(const CCNxNameView *view, const CCNxNameView *prefix);
+
+/**
+ * Determine if the name viewed by @p view starts with the given `CCNxName`,
+ * in the same way as {@link ccnxName_StartsWith}.
+ *
+ * @param [in] view A pointer to a valid `CCNxNameView`.
+ * @param [in] prefix A pointer to a valid `CCNxName`.
+ *
+ * @return true @p prefix is a prefix of @p view.
+ * @return false @p prefix is not a prefix of @p view.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxName *prefix = ccnxName_CreateFromCString("lci:/parc");
+ *     if (ccnxNameView_StartsWithName(&view, prefix)) {
+ *         ...
+ *     }
+ *     ccnxName_Release(&prefix);
+ * }
+ * @endcode
+ */
+bool ccnxNameView_StartsWithName(const CCNxNameView *view, const CCNxName *prefix);
+
+/**
+ * Return the hash code of the viewed name.
+ *
+ * The result is the same value that {@link ccnxName_HashCode} returns for an equal `CCNxName`.
+ *
+ * @param [in] view A pointer to a valid `CCNxNameView`.
+ *
+ * @return The hash code of the viewed name.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCHashCode hashCode = ccnxNameView_HashCode(&view);
+ * }
+ * @endcode
+ */
+PARCHashCode ccnxNameView_HashCode(const CCNxNameView *view);
+
+/**
+ * Return the hash code of the first @p count segments of the viewed name.
+ *
+ * The result is the same value that {@link ccnxName_LeftMostHashCode} returns for an equal `CCNxName`.
+ * If @p count is greater than the number of segments, all the segments are used.
+ *
+ * @param [in] view A pointer to a valid `CCNxNameView`.
+ * @param [in] count The number of segments to include.
+ *
+ * @return The hash code of the first @p count segments.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCHashCode hashCode = ccnxNameView_LeftMostHashCode(&view, 2);
+ * }
+ * @endcode
+ */
+PARCHashCode ccnxNameView_LeftMostHashCode(const CCNxNameView *view, size_t count);
+
+/**
+ * Compute the hash codes of every prefix of the viewed name in one pass.
+ *
+ * On return, `hashCodes[i]` is `ccnxNameView_LeftMostHashCode(view, i + 1)` for each `i` less than the returned count.
+ * This is what a longest-prefix match needs, without repeating the work for each prefix length.
+ *
+ * @param [in] view A pointer to a valid `CCNxNameView`.
+ * @param [in] count The number of elements in @p hashCodes.
+ * @param [out] hashCodes The array to fill.
+ *
+ * @return The number of elements of @p hashCodes that were set: the smaller of @p count and the number of segments.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCHashCode hashCodes[16];
+ *     size_t prefixes = ccnxNameView_PrefixHashCodes(&view, 16, hashCodes);
+ *     for (size_t i = prefixes; i > 0; i--) {
+ *         // look up the prefix of i segments using hashCodes[i - 1]
+ *     }
+ * }
+ * @endcode
+ */
+size_t ccnxNameView_PrefixHashCodes(const CCNxNameView *view, size_t count, PARCHashCode hashCodes[count]);
+
+/**
+ * Create a `CCNxName` equal to the viewed name.
+ *
+ * The segment values are copied, so the result remains valid after the viewed buffer is released.
+ *
+ * @param [in] view A pointer to a valid `CCNxNameView`.
+ *
+ * @return non-NULL A pointer to a new `CCNxName` which must be released by calling {@link ccnxName_Release}.
+ * @return NULL Memory could not be allocated.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxName *name = ccnxNameView_CreateName(&view);
+ *
+ *     ccnxName_Release(&name);
+ * }
+ * @endcode
+ */
+CCNxName *ccnxNameView_CreateName(const CCNxNameView *view);
+#endif // libccnx_ccnx_NameView_h
@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <string.h>
+#include <sys/uio.h>
+
+#include <LongBow/runtime.h>
+
+#include <ccnx/common/ccnx_PacketSummary.h>
+#include <ccnx/common/ccnx_NameView.h>
+
+// The fixed header is 8 bytes and every TLV starts with a 2-byte type and a 2-byte length, in network byte order.
+#define _ccnxPacketSummary_FixedHeaderLength 8
+#define _ccnxPacketSummary_TlvHeaderLength 4
+
+/*
+ * Reads the packet through its iovec extents.  Reads mostly move forward, so it remembers the last extent it used.
+ */
+typedef struct ccnx_packet_summary_reader {
+    const struct iovec *extents;
+    size_t count;
+    size_t length;
+
+    size_t current;
+    size_t currentStart;
+} _CCNxPacketSummaryReader;
+
+/*
+ * Returns the extent holding `offset`, or NULL if it is past the end.  Sets `currentStart` to the offset of the extent.
+ */
+static const struct iovec *
+_ccnxPacketSummaryReader_Seek(_CCNxPacketSummaryReader *reader, size_t offset)
+{
+    if (offset < reader->currentStart) {
+        reader->current = 0;
+        reader->currentStart = 0;
+    }
+
+    while (reader->current < reader->count && offset >= reader->currentStart + reader->extents[reader->current].iov_len) {
+        reader->currentStart += reader->extents[reader->current].iov_len;
+        reader->current++;
+    }
+
+    return (reader->current < reader->count) ? &reader->extents[reader->current] : NULL;
+}
+
+/*
+ * A pointer to the `length` bytes at `offset` if they are all in one extent, otherwise NULL.
+ */
+static const uint8_t *
+_ccnxPacketSummaryReader_Contiguous(_CCNxPacketSummaryReader *reader, size_t offset, size_t length)
+{
+    const struct iovec *extent = _ccnxPacketSummaryReader_Seek(reader, offset);
+    if (extent != NULL && offset + length <= reader->currentStart + extent->iov_len) {
+        return (const uint8_t *) extent->iov_base + (offset - reader->currentStart);
+    }
+    return NULL;
+}
+
+/*
+ * Copy the `length` bytes at `offset`, which may span extents.  The caller has checked they are in the packet.
+ */
+static void
+_ccnxPacketSummaryReader_Copy(_CCNxPacketSummaryReader *reader, size_t offset, size_t length, uint8_t output[length])
+{
+    while (length > 0) {
+        const struct iovec *extent = _ccnxPacketSummaryReader_Seek(reader, offset);
+        size_t skip = offset - reader->currentStart;
+        size_t chunk = extent->iov_len - skip;
+        if (chunk > length) {
+            chunk = length;
+        }
+
+        memcpy(output, (const uint8_t *) extent->iov_base + skip, chunk);
+        output += chunk;
+        offset += chunk;
+        length -= chunk;
+    }
+}
+
+static uint64_t
+_ccnxPacketSummaryReader_GetUint(_CCNxPacketSummaryReader *reader, size_t offset, size_t length)
+{
+    uint8_t bytes[sizeof(uint64_t)];
+    const uint8_t *p = _ccnxPacketSummaryReader_Contiguous(reader, offset, length);
+    if (p == NULL) {
+        _ccnxPacketSummaryReader_Copy(reader, offset, length, bytes);
+        p = bytes;
+    }
+
+    uint64_t value = 0;
+    for (size_t i = 0; i < length; i++) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+/*
+ * Reads the TLV header at `offset` and checks that the TLV ends by `end`.
+ */
+static bool
+_ccnxPacketSummaryReader_GetTlv(_CCNxPacketSummaryReader *reader, size_t offset, size_t end, uint16_t *typePtr, size_t *lengthPtr)
+{
+    if (end - offset < _ccnxPacketSummary_TlvHeaderLength) {
+        return false;
+    }
+
+    uint32_t header = (uint32_t) _ccnxPacketSummaryReader_GetUint(reader, offset, _ccnxPacketSummary_TlvHeaderLength);
+    *typePtr = (uint16_t) (header >> 16);
+    *lengthPtr = header & 0xFFFF;
+    return *lengthPtr <= end - offset - _ccnxPacketSummary_TlvHeaderLength;
+}
+
+static bool
+_ccnxPacketSummary_ParseName(CCNxPacketSummary *summary, _CCNxPacketSummaryReader *reader, size_t offset, size_t length)
+{
+    summary->name = (CCNxPacketSummaryExtent) { .offset = offset, .length = length };
+    if (length == 0) {
+        return true;
+    }
+
+    const uint8_t *value = _ccnxPacketSummaryReader_Contiguous(reader, offset, length);
+    if (value != NULL) {
+        CCNxNameView view;
+        if (!ccnxNameView_Init(&view, length, value)) {
+            return false;
+        }
+        summary->nameSegmentCount = ccnxNameView_GetSegmentCount(&view);
+        summary->prefixHashCodeCount = ccnxNameView_PrefixHashCodes(&view, CCNxPacketSummary_MaxPrefixHashCodes, summary->prefixHashCodes);
+        return true;
+    }
+
+    // The name is split across extents, so only count its segments
+    size_t end = offset + length;
+    while (offset < end) {
+        uint16_t type;
+        size_t segmentLength;
+        if (!_ccnxPacketSummaryReader_GetTlv(reader, offset, end, &type, &segmentLength)) {
+            return false;
+        }
+        offset += _ccnxPacketSummary_TlvHeaderLength + segmentLength;
+        summary->nameSegmentCount++;
+    }
+    return true;
+}
+
+/*
+ * The TLVs inside an Interest, Content Object or Manifest.  Only the first of each summarised field is used.
+ */
+static bool
+_ccnxPacketSummary_ParseMessage(CCNxPacketSummary *summary, _CCNxPacketSummaryReader *reader, size_t offset, size_t end)
+{
+    bool hasName = false;
+    while (offset < end) {
+        uint16_t type;
+        size_t length;
+        if (!_ccnxPacketSummaryReader_GetTlv(reader, offset, end, &type, &length)) {
+            return false;
+        }
+        offset += _ccnxPacketSummary_TlvHeaderLength;
+
+        switch (type) {
+            case CCNxCodecSchemaV1Types_CCNxMessage_Name:
+                if (!hasName) {
+                    if (!_ccnxPacketSummary_ParseName(summary, reader, offset, length)) {
+                        return false;
+                    }
+                    hasName = true;
+                }
+                break;
+
+            case CCNxCodecSchemaV1Types_CCNxMessage_KeyIdRestriction:
+                if (summary->keyIdRestriction.offset == 0) {
+                    summary->keyIdRestriction = (CCNxPacketSummaryExtent) { .offset = offset, .length = length };
+                }
+                break;
+
+            case CCNxCodecSchemaV1Types_CCNxMessage_ContentObjectHashRestriction:
+                if (summary->objectHashRestriction.offset == 0) {
+                    summary->objectHashRestriction = (CCNxPacketSummaryExtent) { .offset = offset, .length = length };
+                }
+                break;
+
+            default:
+                // not summarised
+                break;
+        }
+
+        offset += length;
+    }
+    return true;
+}
+
+/*
+ * The hop-by-hop headers between the fixed header and the message.
+ */
+static bool
+_ccnxPacketSummary_ParseOptionalHeaders(CCNxPacketSummary *summary, _CCNxPacketSummaryReader *reader, size_t offset, size_t end)
+{
+    while (offset < end) {
+        uint16_t type;
+        size_t length;
+        if (!_ccnxPacketSummaryReader_GetTlv(reader, offset, end, &type, &length)) {
+            return false;
+        }
+        offset += _ccnxPacketSummary_TlvHeaderLength;
+
+        if (type == CCNxCodecSchemaV1Types_OptionalHeaders_InterestLifetime) {
+            if (length < 1 || length > sizeof(uint64_t)) {
+                return false;
+            }
+            summary->hasInterestLifetime = true;
+            summary->interestLifetime = _ccnxPacketSummaryReader_GetUint(reader, offset, length);
+        }
+
+        offset += length;
+    }
+    return true;
+}
+
+/*
+ * The ValidationAlg and ValidationPayload after the message, if there are any.
+ */
+static bool
+_ccnxPacketSummary_ParseValidation(CCNxPacketSummary *summary, _CCNxPacketSummaryReader *reader, size_t offset, size_t end)
+{
+    if (offset == end) {
+        return true;
+    }
+
+    uint16_t type;
+    size_t length;
+    if (!_ccnxPacketSummaryReader_GetTlv(reader, offset, end, &type, &length) || type != CCNxCodecSchemaV1Types_MessageType_ValidationAlg) {
+        return false;
+    }
+    offset += _ccnxPacketSummary_TlvHeaderLength;
+
+    // The first TLV in the ValidationAlg is the suite
+    uint16_t suite;
+    size_t suiteLength;
+    if (!_ccnxPacketSummaryReader_GetTlv(reader, offset, offset + length, &suite, &suiteLength)) {
+        return false;
+    }
+    summary->validationAlg = (CCNxCodecSchemaV1Types_ValidationAlg) suite;
+    offset += length;
+
+    return _ccnxPacketSummaryReader_GetTlv(reader, offset, end, &type, &length) && type == CCNxCodecSchemaV1Types_MessageType_ValidationPayload;
+}
+
+static bool
+_ccnxPacketSummary_ParseReader(CCNxPacketSummary *summary, _CCNxPacketSummaryReader *reader)
+{
+    memset(summary, 0, sizeof(CCNxPacketSummary));
+
+    if (reader->length < _ccnxPacketSummary_FixedHeaderLength) {
+        return false;
+    }
+
+    uint8_t fixedHeader[_ccnxPacketSummary_FixedHeaderLength];
+    _ccnxPacketSummaryReader_Copy(reader, 0, sizeof(fixedHeader), fixedHeader);
+    if (fixedHeader[0] != CCNxTlvDictionary_SchemaVersion_V1) {
+        return false;
+    }
+
+    summary->packetType = (CCNxCodecSchemaV1Types_PacketType) fixedHeader[1];
+    summary->packetLength = (fixedHeader[2] << 8) | fixedHeader[3];
+    summary->hopLimit = fixedHeader[4];
+    summary->headerLength = fixedHeader[7];
+
+    if (summary->headerLength < _ccnxPacketSummary_FixedHeaderLength ||
+        summary->headerLength > summary->packetLength ||
+        summary->packetLength > reader->length) {
+        return false;
+    }
+
+    if (!_ccnxPacketSummary_ParseOptionalHeaders(summary, reader, _ccnxPacketSummary_FixedHeaderLength, summary->headerLength)) {
+        return false;
+    }
+
+    uint16_t type;
+    size_t length;
+    if (!_ccnxPacketSummaryReader_GetTlv(reader, summary->headerLength, summary->packetLength, &type, &length)) {
+        return false;
+    }
+
+    size_t messageStart = summary->headerLength + _ccnxPacketSummary_TlvHeaderLength;
+    size_t messageEnd = messageStart + length;
+    summary->messageType = (CCNxCodecSchemaV1Types_MessageType) type;
+
+    switch (type) {
+        case CCNxCodecSchemaV1Types_MessageType_Interest: // fallthrough
+        case CCNxCodecSchemaV1Types_MessageType_ContentObject: // fallthrough
+        case CCNxCodecSchemaV1Types_MessageType_Manifest:
+            if (!_ccnxPacketSummary_ParseMessage(summary, reader, messageStart, messageEnd)) {
+                return false;
+            }
+            break;
+
+        case CCNxCodecSchemaV1Types_MessageType_Control:
+            // the CPI payload is JSON, not TLVs
+            break;
+
+        default:
+            return false;
+    }
+
+    return _ccnxPacketSummary_ParseValidation(summary, reader, messageEnd, summary->packetLength);
+}
+
+bool
+ccnxPacketSummary_Parse(CCNxPacketSummary *summary, size_t length, const uint8_t packet[length])
+{
+    assertNotNull(summary, "Parameter summary must be non-null");
+    assertNotNull(packet, "Parameter packet must be non-null");
+
+    struct iovec extent = { .iov_base = (void *) packet, .iov_len = length };
+    _CCNxPacketSummaryReader reader = { .extents = &extent, .count = 1, .length = length };
+    return _ccnxPacketSummary_ParseReader(summary, &reader);
+}
+
+bool
+ccnxPacketSummary_ParseIoVec(CCNxPacketSummary *summary, CCNxCodecNetworkBufferIoVec *vec)
+{
+    assertNotNull(summary, "Parameter summary must be non-null");
+    assertNotNull(vec, "Parameter vec must be non-null");
+
+    _CCNxPacketSummaryReader reader = {
+        .extents = ccnxCodecNetworkBufferIoVec_GetArray(vec),
+        .count   = ccnxCodecNetworkBufferIoVec_GetCount(vec),
+    };
+    for (size_t i = 0; i < reader.count; i++) {
+        reader.length += reader.extents[i].iov_len;
+    }
+    return _ccnxPacketSummary_ParseReader(summary, &reader);
+}
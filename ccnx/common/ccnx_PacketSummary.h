@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file ccnx_PacketSummary.h
+ * @ingroup Utility
+ * @brief The facts a forwarder needs about a packet, read straight from the wire format.
+ *
+ * A `CCNxPacketSummary` is filled in by one pass over a V1 packet, from a byte array or a
+ * `CCNxCodecNetworkBufferIoVec`.  It holds the fixed header fields, the extents of the name and
+ * restrictions as offsets into the packet, the prefix hash codes of the name, the Interest Lifetime
+ * and the validation suite.  Parsing does not allocate memory and does not create a `CCNxTlvDictionary`,
+ * so a forwarder can decide what to do with a packet before paying for a full decode.
+ *
+ * A `CCNxPacketSummary` is a plain structure, usually on the stack.  It does not reference the packet,
+ * so its extents are only meaningful together with the packet it was parsed from.
+ *
+ * The prefix hash codes are the same values as {@link ccnxName_LeftMostHashCode}, so they may be used
+ * to look up a {@link CCNxNameTrie} or any other table keyed by `CCNxName` hash codes.
+ *
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef libccnx_ccnx_PacketSummary_h
+#define libccnx_ccnx_PacketSummary_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <parc/algol/parc_HashCode.h>
+#include <ccnx/common/codec/ccnxCodec_NetworkBuffer.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_Types.h>
+
+/**
+ * The number of name prefixes a `CCNxPacketSummary` holds hash codes for.
+ */
+#define CCNxPacketSummary_MaxPrefixHashCodes 16
+
+/**
+ * @typedef CCNxPacketSummaryExtent
+ * @brief The value of a TLV inside a packet.
+ *
+ * `offset` counts from the first byte of the fixed header.  Since no TLV value can start there,
+ * an `offset` of 0 means the TLV is not in the packet.  A present TLV may have a zero `length`.
+ */
+typedef struct ccnx_packet_summary_extent {
+    size_t offset;
+    size_t length;
+} CCNxPacketSummaryExtent;
+
+/**
+ * @typedef CCNxPacketSummary
+ * @brief The fields of a packet a forwarder looks at before anything else.
+ */
+typedef struct ccnx_packet_summary {
+    CCNxCodecSchemaV1Types_PacketType packetType;
+    CCNxCodecSchemaV1Types_MessageType messageType;
+    uint8_t hopLimit;
+    size_t packetLength;
+    size_t headerLength;
+
+    // The value of the Name TLV
+    CCNxPacketSummaryExtent name;
+    size_t nameSegmentCount;
+
+    // prefixHashCodes[i] is the hash code of the first i + 1 name segments.  If the name is split
+    // across iovec extents, no prefix hash codes are computed.
+    size_t prefixHashCodeCount;
+    PARCHashCode prefixHashCodes[CCNxPacketSummary_MaxPrefixHashCodes];
+
+    CCNxPacketSummaryExtent keyIdRestriction;
+    CCNxPacketSummaryExtent objectHashRestriction;
+
+    // The Interest Lifetime hop-by-hop header, in milliseconds
+    bool hasInterestLifetime;
+    uint64_t interestLifetime;
+
+    // The type of the first TLV in the ValidationAlg, e.g. CCNxCodecSchemaV1Types_ValidationAlg_RSA_SHA256,
+    // or 0 if the packet has no validation section
+    CCNxCodecSchemaV1Types_ValidationAlg validationAlg;
+} CCNxPacketSummary;
+
+/**
+ * Fill in a `CCNxPacketSummary` from a V1 packet in a byte array.
+ *
+ * The array must start with the fixed header.  It may be longer than the packet, in which case
+ * the bytes after `packetLength` are ignored.
+ *
+ * The parse checks the fixed header and that every TLV it steps over fits in its container, but it does
+ * not look inside the TLVs it does not summarise.  A packet it accepts may still fail a full decode.
+ *
+ * @param [out] summary The summary to fill in.
+ * @param [in] length The number of bytes in @p packet.
+ * @param [in] packet The wire format packet.
+ *
+ * @return true The summary was filled in.
+ * @return false The packet is not a well-formed V1 packet.  The summary is not valid.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxPacketSummary summary;
+ *     if (ccnxPacketSummary_Parse(&summary, length, packet)) {
+ *         if (summary.packetType == CCNxCodecSchemaV1Types_PacketType_Interest && summary.hopLimit == 0) {
+ *             // drop it
+ *         }
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxPacketSummary_Parse(CCNxPacketSummary *summary, size_t length, const uint8_t packet[length]);
+
+/**
+ * Fill in a `CCNxPacketSummary` from a V1 packet held in a `CCNxCodecNetworkBufferIoVec`.
+ *
+ * Same as {@link ccnxPacketSummary_Parse}, but the packet may be split over several extents.
+ * The offsets in the summary count across the extents, from the first byte of the first extent.
+ *
+ * @param [out] summary The summary to fill in.
+ * @param [in] vec The packet.
+ *
+ * @return true The summary was filled in.
+ * @return false The packet is not a well-formed V1 packet.  The summary is not valid.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxPacketSummary summary;
+ *     if (ccnxPacketSummary_ParseIoVec(&summary, vec)) {
+ *         for (size_t i = summary.prefixHashCodeCount; i > 0; i--) {
+ *             // look up the prefix of i segments using summary.prefixHashCodes[i - 1]
+ *         }
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxPacketSummary_ParseIoVec(CCNxPacketSummary *summary, CCNxCodecNetworkBufferIoVec *vec);
+#endif // libccnx_ccnx_PacketSummary_h
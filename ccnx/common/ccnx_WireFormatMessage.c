@@ -309,6 +309,33 @@ ccnxWireFormatMessage_HashProtectedRegion(const CCNxWireFormatMessage *message,
     return result;
 }
 
+size_t
+ccnxWireFormatMessage_HashProtectedRegions(size_t count, CCNxWireFormatMessage *messages[count],
+                                           uint8_t digests[count][CCNxWireFormatMessage_SHA256DigestLength],
+                                           bool hashed[count])
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    CCNxWireFormatMessageInterface *impl = ccnxWireFormatMessageInterface_GetInterface(messages[0]);
+    for (size_t i = 0; i < count; i++) {
+        ccnxWireFormatMessage_OptionalAssertValid(messages[i]);
+        assertTrue(ccnxWireFormatMessageInterface_GetInterface(messages[i]) == impl,
+                   "All messages must have the same schema version, message %zu differs", i);
+    }
+
+    size_t result = 0;
+
+    if (impl->hashProtectedRegions != NULL) {
+        result = impl->hashProtectedRegions(count, messages, digests, hashed);
+    } else {
+        trapNotImplemented("ccnxWireFormatMessage_HashProtectedRegions");
+    }
+
+    return result;
+}
+
 PARCCryptoHash *
 ccnxWireFormatMessage_CreateContentObjectHash(CCNxWireFormatMessage *message)
 {
@@ -326,6 +353,52 @@ ccnxWireFormatMessage_CreateContentObjectHash(CCNxWireFormatMessage *message)
     return result;
 }
 
+bool
+ccnxWireFormatMessage_ComputeContentObjectHashDigest(const CCNxWireFormatMessage *message,
+                                                     uint8_t digest[CCNxWireFormatMessage_ContentObjectHashLength])
+{
+    ccnxWireFormatMessage_AssertValid(message);
+    assertNotNull(digest, "Parameter digest must be non-null");
+    CCNxWireFormatMessageInterface *impl = ccnxWireFormatMessageInterface_GetInterface(message);
+
+    bool result = false;
+
+    if (impl->computeContentObjectHashDigest != NULL) {
+        result = impl->computeContentObjectHashDigest(message, digest);
+    } else {
+        trapNotImplemented("ccnxWireFormatMessage_ComputeContentObjectHashDigest");
+    }
+
+    return result;
+}
+
+size_t
+ccnxWireFormatMessage_ComputeContentObjectHashDigests(size_t count, CCNxWireFormatMessage *messages[count],
+                                                      uint8_t digests[count][CCNxWireFormatMessage_ContentObjectHashLength],
+                                                      bool hashed[count])
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    CCNxWireFormatMessageInterface *impl = ccnxWireFormatMessageInterface_GetInterface(messages[0]);
+    for (size_t i = 0; i < count; i++) {
+        ccnxWireFormatMessage_OptionalAssertValid(messages[i]);
+        assertTrue(ccnxWireFormatMessageInterface_GetInterface(messages[i]) == impl,
+                   "All messages must have the same schema version, message %zu differs", i);
+    }
+
+    size_t result = 0;
+
+    if (impl->computeContentObjectHashDigests != NULL) {
+        result = impl->computeContentObjectHashDigests(count, messages, digests, hashed);
+    } else {
+        trapNotImplemented("ccnxWireFormatMessage_ComputeContentObjectHashDigests");
+    }
+
+    return result;
+}
+
 CCNxWireFormatMessage *
 ccnxWireFormatMessage_Acquire(const CCNxWireFormatMessage *message)
 {
@@ -335,6 +335,36 @@ bool ccnxWireFormatMessage_SetProtectedRegionLength(CCNxWireFormatMessage *dicti
  */
 PARCCryptoHash *ccnxWireFormatMessage_HashProtectedRegion(const CCNxWireFormatMessage *dictionary, PARCCryptoHasher *hasher);
 
+/**
+ * Computes the SHA256 digest of the protected region of each of several messages.
+ *
+ * This is the batch form of `ccnxWireFormatMessage_HashProtectedRegion()` with a SHA256 hasher, for
+ * verifying a burst of received packets.  Where the CPU allows, several protected regions are hashed
+ * at once (see `ccnxValidationSHA256Batch_Hash()`).  The messages are not modified, and no memory is allocated
+ * for a burst of up to 32 messages.
+ *
+ * All the messages must use the same schema version.
+ *
+ * @param [in] count The number of messages.
+ * @param [in] messages The decoded messages.
+ * @param [out] digests `digests[i]` receives the digest of the protected region of `messages[i]`.
+ * @param [out] hashed If not NULL, `hashed[i]` is set to false if `messages[i]` has no protected region.
+ *
+ * @return The number of messages whose digest was written.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t digests[count][CCNxWireFormatMessage_SHA256DigestLength];
+ *     bool hashed[count];
+ *     ccnxWireFormatMessage_HashProtectedRegions(count, messages, digests, hashed);
+ * }
+ * @endcode
+ */
+size_t ccnxWireFormatMessage_HashProtectedRegions(size_t count, CCNxWireFormatMessage *messages[count],
+                                                  uint8_t digests[count][CCNxWireFormatMessage_SHA256DigestLength],
+                                                  bool hashed[count]);
+
 /**
  * Calculates the ContentObject Hash, which is the SHA256 hash of the protected part of the wire format message.
  *
@@ -358,6 +388,64 @@ PARCCryptoHash *ccnxWireFormatMessage_HashProtectedRegion(const CCNxWireFormatMe
 
 PARCCryptoHash *ccnxWireFormatMessage_CreateContentObjectHash(CCNxWireFormatMessage *dictionary);
 
+/**
+ * Calculates the ContentObject Hash into a caller-provided buffer.
+ *
+ * Computes the same SHA256 digest as `ccnxWireFormatMessage_CreateContentObjectHash()`, but writes
+ * the `CCNxWireFormatMessage_ContentObjectHashLength` bytes of the digest into `digest` and does not
+ * allocate memory.  It does not modify the message, so several threads may hash the same message.
+ *
+ * This function must only be called on a dictionary that contains a ContentObject and a WireFormat buffer.
+ *
+ * @param [in] message The ContentObject message on which to calculate its hash.
+ * @param [out] digest Receives the SHA256 digest.
+ *
+ * @return true The digest was written
+ * @return false The hash region was not set or lies outside the wire format. `digest` is unchanged.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t digest[CCNxWireFormatMessage_ContentObjectHashLength];
+ *     if (ccnxWireFormatMessage_ComputeContentObjectHashDigest(message, digest)) {
+ *         // compare digest to the Interest's ContentObjectHashRestriction
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxWireFormatMessage_ComputeContentObjectHashDigest(const CCNxWireFormatMessage *message,
+                                                          uint8_t digest[CCNxWireFormatMessage_ContentObjectHashLength]);
+
+/**
+ * Calculates the ContentObject Hash of each of several messages.
+ *
+ * Writes the same digest as `ccnxWireFormatMessage_ComputeContentObjectHashDigest()` for each message,
+ * but gathers the ContentObject Hash region of every message and hashes them together with
+ * `ccnxValidationSHA256Batch_Hash()`.  Use it when a forwarder has a burst of ContentObjects to match
+ * against pending Interests.  The messages are not modified.
+ *
+ * All the messages must be ContentObjects or Manifests of the same schema version.
+ *
+ * @param [in] count The number of messages.
+ * @param [in] messages The decoded ContentObject messages.
+ * @param [out] digests `digests[i]` receives the ContentObject Hash of `messages[i]`.
+ * @param [out] hashed If not NULL, `hashed[i]` is set to false if `messages[i]` has no valid hash region.
+ *
+ * @return The number of messages whose digest was written.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint8_t digests[count][CCNxWireFormatMessage_ContentObjectHashLength];
+ *     bool hashed[count];
+ *     ccnxWireFormatMessage_ComputeContentObjectHashDigests(count, messages, digests, hashed);
+ * }
+ * @endcode
+ */
+size_t ccnxWireFormatMessage_ComputeContentObjectHashDigests(size_t count, CCNxWireFormatMessage *messages[count],
+                                                             uint8_t digests[count][CCNxWireFormatMessage_ContentObjectHashLength],
+                                                             bool hashed[count]);
+
 /**
  * Returns a pointer to the CCNxTlvDictionary underlying the specified CCNxWireFormatMessage.
  *
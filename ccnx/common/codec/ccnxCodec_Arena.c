@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * Allocation takes the next aligned bytes of the current chunk.  When the current chunk cannot hold a request,
+ * a new chunk big enough for it is pushed on the chunk list and becomes current; whatever was left in the old
+ * chunk is abandoned.  Cleanup records are allocated from the arena itself.
+ *
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+
+#include <ccnx/common/codec/ccnxCodec_Arena.h>
+
+// The built-in first chunk.  Enough for the decoders of a typical Interest or Content Object.
+#define _ccnxCodecArena_InitialSize 1024
+
+static const size_t _ccnxCodecArena_ChunkSize = 4096;
+static const size_t _ccnxCodecArena_Alignment = sizeof(uint64_t);
+
+typedef struct ccnx_codec_arena_chunk {
+    struct ccnx_codec_arena_chunk *next;
+    uint64_t memory[];
+} _CCNxCodecArenaChunk;
+
+typedef struct ccnx_codec_arena_cleanup_entry {
+    struct ccnx_codec_arena_cleanup_entry *next;
+    CCNxCodecArenaCleanup *cleanup;
+    void *data;
+} _CCNxCodecArenaCleanupEntry;
+
+struct ccnx_codec_arena {
+    uint8_t *next;
+    size_t remaining;
+
+    _CCNxCodecArenaChunk *chunks;
+    _CCNxCodecArenaCleanupEntry *cleanups;
+
+    size_t bytesUsed;
+    size_t chunkCount;
+
+    uint64_t initial[_ccnxCodecArena_InitialSize / sizeof(uint64_t)];
+};
+
+static bool
+_ccnxCodecArena_Destructor(CCNxCodecArena **arenaPtr)
+{
+    CCNxCodecArena *arena = *arenaPtr;
+
+    // The cleanup list is a stack, so cleanups run newest first.
+    for (_CCNxCodecArenaCleanupEntry *entry = arena->cleanups; entry != NULL; entry = entry->next) {
+        entry->cleanup(entry->data);
+    }
+
+    while (arena->chunks != NULL) {
+        _CCNxCodecArenaChunk *chunk = arena->chunks;
+        arena->chunks = chunk->next;
+        parcMemory_Deallocate((void **) &chunk);
+    }
+    return true;
+}
+
+parcObject_Override(CCNxCodecArena, PARCObject,
+                    .destructor = (PARCObjectDestructor *) _ccnxCodecArena_Destructor);
+
+parcObject_ImplementAcquire(ccnxCodecArena, CCNxCodecArena);
+
+parcObject_ImplementRelease(ccnxCodecArena, CCNxCodecArena);
+
+CCNxCodecArena *
+ccnxCodecArena_Create(void)
+{
+    CCNxCodecArena *arena = parcObject_CreateInstance(CCNxCodecArena);
+    if (arena != NULL) {
+        arena->next = (uint8_t *) arena->initial;
+        arena->remaining = sizeof(arena->initial);
+        arena->chunks = NULL;
+        arena->cleanups = NULL;
+        arena->bytesUsed = 0;
+        arena->chunkCount = 0;
+    }
+    return arena;
+}
+
+/**
+ * Start a new chunk with room for at least `length` bytes.
+ */
+static void
+_ccnxCodecArena_AddChunk(CCNxCodecArena *arena, size_t length)
+{
+    size_t capacity = (length > _ccnxCodecArena_ChunkSize) ? length : _ccnxCodecArena_ChunkSize;
+
+    _CCNxCodecArenaChunk *chunk = parcMemory_Allocate(sizeof(_CCNxCodecArenaChunk) + capacity);
+    assertNotNull(chunk, "parcMemory_Allocate(%zu) returned NULL", sizeof(_CCNxCodecArenaChunk) + capacity);
+
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+    arena->chunkCount++;
+
+    arena->next = (uint8_t *) chunk->memory;
+    arena->remaining = capacity;
+}
+
+void *
+ccnxCodecArena_Allocate(CCNxCodecArena *arena, size_t length)
+{
+    assertNotNull(arena, "Parameter arena must be non-null");
+
+    size_t padding = (size_t) (-(uintptr_t) arena->next) & (_ccnxCodecArena_Alignment - 1);
+    if (padding + length > arena->remaining) {
+        // Chunk memory is already aligned.
+        _ccnxCodecArena_AddChunk(arena, length);
+        padding = 0;
+    }
+
+    void *result = arena->next + padding;
+    arena->next += padding + length;
+    arena->remaining -= padding + length;
+    arena->bytesUsed += padding + length;
+    return result;
+}
+
+void *
+ccnxCodecArena_AllocateAndClear(CCNxCodecArena *arena, size_t length)
+{
+    void *result = ccnxCodecArena_Allocate(arena, length);
+    memset(result, 0, length);
+    return result;
+}
+
+void
+ccnxCodecArena_AddCleanup(CCNxCodecArena *arena, CCNxCodecArenaCleanup *cleanup, void *data)
+{
+    assertNotNull(cleanup, "Parameter cleanup must be non-null");
+
+    _CCNxCodecArenaCleanupEntry *entry = ccnxCodecArena_Allocate(arena, sizeof(_CCNxCodecArenaCleanupEntry));
+    entry->cleanup = cleanup;
+    entry->data = data;
+    entry->next = arena->cleanups;
+    arena->cleanups = entry;
+}
+
+size_t
+ccnxCodecArena_GetBytesUsed(const CCNxCodecArena *arena)
+{
+    assertNotNull(arena, "Parameter arena must be non-null");
+    return arena->bytesUsed;
+}
+
+size_t
+ccnxCodecArena_GetChunkCount(const CCNxCodecArena *arena)
+{
+    assertNotNull(arena, "Parameter arena must be non-null");
+    return arena->chunkCount;
+}
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file ccnxCodec_Arena.h
+ * @brief A bump allocator for memory that lives exactly as long as one decoded packet
+ *
+ * A `CCNxCodecArena` hands out memory by advancing a pointer through a chunk, and frees all of it at once
+ * when its last reference is released.  There is no per-allocation free.  The first chunk is part of the
+ * arena itself, so a typical packet decode costs one heap allocation for all of its bookkeeping; larger
+ * decodes chain more chunks from the heap.
+ *
+ * Objects that must release references of their own (for example a PARCBuffer held in arena memory) register
+ * a cleanup with {@link ccnxCodecArena_AddCleanup}.  Cleanups run in reverse order of registration just
+ * before the memory is freed.
+ *
+ * An arena is not thread safe.  Only one thread should allocate from it at a time, though any thread may
+ * release a reference.
+ *
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef Libccnx_codec_ccnxCodecArena_h
+#define Libccnx_codec_ccnxCodecArena_h
+
+#include <stddef.h>
+
+struct ccnx_codec_arena;
+/**
+ * @typedef CCNxCodecArena
+ * @brief A bump allocator freed in one shot.
+ */
+typedef struct ccnx_codec_arena CCNxCodecArena;
+
+/**
+ * @typedef CCNxCodecArenaCleanup
+ * @brief A function run with its `data` when the arena is destroyed.
+ */
+typedef void (CCNxCodecArenaCleanup)(void *data);
+
+/**
+ * Create an empty arena.
+ *
+ * @return non-null A new arena.
+ * @return null Out of memory.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecArena *arena = ccnxCodecArena_Create();
+ *     ccnxCodecArena_Release(&arena);
+ * }
+ * @endcode
+ */
+CCNxCodecArena *ccnxCodecArena_Create(void);
+
+/**
+ * Increase the number of references to a `CCNxCodecArena`.
+ *
+ * @param [in] arena A pointer to the original instance.
+ * @return The value of the input parameter @p arena.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecArena *reference = ccnxCodecArena_Acquire(arena);
+ *     ccnxCodecArena_Release(&reference);
+ * }
+ * @endcode
+ *
+ * @see ccnxCodecArena_Release
+ */
+CCNxCodecArena *ccnxCodecArena_Acquire(const CCNxCodecArena *arena);
+
+/**
+ * Release a previously acquired reference to the specified instance,
+ * decrementing the reference count for the instance.
+ *
+ * When the last reference is released the cleanups run and all memory allocated from the arena is freed.
+ *
+ * @param [in,out] arenaPtr A pointer to a pointer to the instance to release, set to NULL on return.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecArena *arena = ccnxCodecArena_Create();
+ *     ccnxCodecArena_Release(&arena);
+ * }
+ * @endcode
+ */
+void ccnxCodecArena_Release(CCNxCodecArena **arenaPtr);
+
+/**
+ * Allocate `length` bytes from the arena.
+ *
+ * The memory is aligned for any integer or pointer type and is not initialized.
+ * It stays valid until the arena is destroyed.
+ *
+ * @param [in] arena A `CCNxCodecArena` instance.
+ * @param [in] length The number of bytes to allocate.
+ *
+ * @return non-null The allocated memory.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t *offsets = ccnxCodecArena_Allocate(arena, 4 * sizeof(size_t));
+ * }
+ * @endcode
+ */
+void *ccnxCodecArena_Allocate(CCNxCodecArena *arena, size_t length);
+
+/**
+ * Allocate `length` bytes from the arena and set them to zero.
+ *
+ * @param [in] arena A `CCNxCodecArena` instance.
+ * @param [in] length The number of bytes to allocate.
+ *
+ * @return non-null The allocated memory.
+ *
+ * Example:
+ * @code
+ * {
+ *     struct iovec *iov = ccnxCodecArena_AllocateAndClear(arena, sizeof(struct iovec));
+ * }
+ * @endcode
+ */
+void *ccnxCodecArena_AllocateAndClear(CCNxCodecArena *arena, size_t length);
+
+/**
+ * Run `cleanup(data)` when the arena is destroyed.
+ *
+ * @param [in] arena A `CCNxCodecArena` instance.
+ * @param [in] cleanup The function to run.
+ * @param [in] data Passed to `cleanup`.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer **slot = ccnxCodecArena_Allocate(arena, sizeof(PARCBuffer *));
+ *     *slot = parcBuffer_Acquire(buffer);
+ *     ccnxCodecArena_AddCleanup(arena, (CCNxCodecArenaCleanup *) parcBuffer_Release, slot);
+ * }
+ * @endcode
+ */
+void ccnxCodecArena_AddCleanup(CCNxCodecArena *arena, CCNxCodecArenaCleanup *cleanup, void *data);
+
+/**
+ * Return the number of bytes allocated from the arena, including alignment padding.
+ *
+ * @param [in] arena A `CCNxCodecArena` instance.
+ *
+ * @return The bytes handed out so far.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t used = ccnxCodecArena_GetBytesUsed(arena);
+ * }
+ * @endcode
+ */
+size_t ccnxCodecArena_GetBytesUsed(const CCNxCodecArena *arena);
+
+/**
+ * Return the number of chunks the arena has taken from the heap beyond its built-in first chunk.
+ *
+ * @param [in] arena A `CCNxCodecArena` instance.
+ *
+ * @return 0 Everything fit in the first chunk.
+ * @return positive The number of extra heap allocations made by the arena.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t chunks = ccnxCodecArena_GetChunkCount(arena);
+ * }
+ * @endcode
+ */
+size_t ccnxCodecArena_GetChunkCount(const CCNxCodecArena *arena);
+#endif // Libccnx_codec_ccnxCodecArena_h
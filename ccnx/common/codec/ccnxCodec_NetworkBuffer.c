@@ -387,10 +387,16 @@ ccnxCodecNetworkBuffer_Allocate(const CCNxCodecNetworkBufferMemoryBlockFunctions
 
 CCNxCodecNetworkBuffer *
 ccnxCodecNetworkBuffer_Create(const CCNxCodecNetworkBufferMemoryBlockFunctions *memoryFunctions, void *userarg)
+{
+    return ccnxCodecNetworkBuffer_CreateWithCapacity(memoryFunctions, userarg, 1536);
+}
+
+CCNxCodecNetworkBuffer *
+ccnxCodecNetworkBuffer_CreateWithCapacity(const CCNxCodecNetworkBufferMemoryBlockFunctions *memoryFunctions, void *userarg, size_t capacity)
 {
     CCNxCodecNetworkBuffer *buffer = ccnxCodecNetworkBuffer_Allocate(memoryFunctions, userarg);
 
-    buffer->head = _ccnxCodecNetworkBufferMemory_Allocate(buffer, 1536);
+    buffer->head = _ccnxCodecNetworkBufferMemory_Allocate(buffer, capacity);
     buffer->tail = buffer->head;
     buffer->current = buffer->head;
     buffer->capacity = buffer->head->capacity;
@@ -658,42 +664,60 @@ ccnxCodecNetworkBuffer_CreateParcBuffer(CCNxCodecNetworkBuffer *buffer)
     return output;
 }
 
-PARCSignature *
-ccnxCodecNetworkBuffer_ComputeSignature(CCNxCodecNetworkBuffer *buffer, size_t start, size_t end, PARCSigner *signer)
+void
+ccnxCodecNetworkBuffer_UpdateHashers(const CCNxCodecNetworkBuffer *buffer, size_t start, size_t end, size_t count, PARCCryptoHasher *hashers[count])
 {
-    // Most positions (start, end, position, roof) below are in **absolute** coordinates
-    // The position relativePosition is relative to the memory block start
+    // Positions (start, end, position, roof) below are in **absolute** coordinates.
+    // The position relativePosition is relative to the memory block start.
     assertNotNull(buffer, "Parameter buffer must be non-null");
     assertTrue(end >= start, "End is less than start: start %zu end %zu", start, end);
 
-    PARCSignature *signature = NULL;
-    if (signer) {
-        // compute the signature over the specified area
-
-        PARCCryptoHasher *hasher = parcSigner_GetCryptoHasher(signer);
-        parcCryptoHasher_Init(hasher);
+    size_t position = start;
+    CCNxCodecNetworkBufferMemory *block = buffer->head;
+    while (block && position < end) {
+        if (_ccnxCodecNetworkBufferMemory_ContainsPosition(block, position)) {
+            // determine if we're going all the way to the block's end or are we
+            // stopping early because that's the end of the designated area
+            size_t blockEnd = block->begin + block->limit;
+            size_t roof = (end > blockEnd) ? blockEnd : end;
+            size_t length = roof - position;
+
+            // now calculate the relative offset in the block so we can update the hashes.
+            // Every hasher consumes the span before moving on, so the bytes are read from cache.
+            size_t relativePosition = position - block->begin;
+            for (size_t i = 0; i < count; i++) {
+                parcCryptoHasher_UpdateBytes(hashers[i], &block->memory[relativePosition], length);
+            }
 
-        size_t position = start;
-        CCNxCodecNetworkBufferMemory *block = buffer->head;
-        while (block && position < block->begin + block->limit) {
-            if (_ccnxCodecNetworkBufferMemory_ContainsPosition(block, position)) {
-                // determine if we're going all the way to the block's end or are we
-                // stopping early because that's the end of the designated area
-                size_t roof = (end > block->begin + block->limit) ? block->limit : end;
-                size_t length = roof - position;
+            position += length;
+        }
 
-                // now calculate the relative offset in the block so we can update the hash
-                size_t relativePosition = position - block->begin;
+        block = block->next;
+    }
+}
 
-                parcCryptoHasher_UpdateBytes(hasher, &block->memory[relativePosition], length);
+PARCCryptoHash *
+ccnxCodecNetworkBuffer_ComputeDigest(CCNxCodecNetworkBuffer *buffer, size_t start, size_t end, PARCCryptoHasher *hasher)
+{
+    assertNotNull(buffer, "Parameter buffer must be non-null");
+    assertNotNull(hasher, "Parameter hasher must be non-null");
+    assertTrue(end >= start, "End is less than start: start %zu end %zu", start, end);
 
-                position += length;
-            }
+    parcCryptoHasher_Init(hasher);
+    ccnxCodecNetworkBuffer_UpdateHashers(buffer, start, end, 1, &hasher);
+    return parcCryptoHasher_Finalize(hasher);
+}
 
-            block = block->next;
-        }
+PARCSignature *
+ccnxCodecNetworkBuffer_ComputeSignature(CCNxCodecNetworkBuffer *buffer, size_t start, size_t end, PARCSigner *signer)
+{
+    assertNotNull(buffer, "Parameter buffer must be non-null");
+    assertTrue(end >= start, "End is less than start: start %zu end %zu", start, end);
 
-        PARCCryptoHash *hash = parcCryptoHasher_Finalize(hasher);
+    PARCSignature *signature = NULL;
+    if (signer) {
+        // compute the signature over the specified area
+        PARCCryptoHash *hash = ccnxCodecNetworkBuffer_ComputeDigest(buffer, start, end, parcSigner_GetCryptoHasher(signer));
 
         signature = parcSigner_SignDigest(signer, hash);
         parcCryptoHash_Release(&hash);
@@ -69,7 +69,8 @@
  * A network buffer uses a CCNxCodecNetworkBufferMemoryBlockFunctions structure for an allocator and de-allocator.  The allocator is called
  * to add more memory to the scatter/gather list of memory buffers and the de-allocator is used to return those
  * buffers to the owner.  A user could point to "ParcMemoryMemoryBlock" to use the normal parcMemory_allocate() and
- * parcMemory_deallocate() functions.  Or, they can use their own or wrap event buffers or wrap kernel memory blocks.
+ * parcMemory_deallocate() functions, or to "NetworkBufferPoolMemoryBlock" to reuse blocks from a CCNxCodecNetworkBufferPool.
+ * Or, they can use their own or wrap event buffers or wrap kernel memory blocks.
  *
  * The user can address the memory using a linearized position with ccnxCodecNetworkBuffer_Position() and ccnxCodecNetworkBuffer_SetPosition().
  * If a write would span two (or more) memory blocks, the write function will correctly split the write.
@@ -94,6 +95,7 @@
 #include <sys/uio.h>
 #include <parc/algol/parc_Buffer.h>
 #include <parc/security/parc_Signer.h>
+#include <parc/security/parc_CryptoHasher.h>
 
 struct ccnx_codec_network_buffer;
 /**
@@ -158,6 +160,30 @@ extern const CCNxCodecNetworkBufferMemoryBlockFunctions ParcMemoryMemoryBlock;
  */
 CCNxCodecNetworkBuffer *ccnxCodecNetworkBuffer_Create(const CCNxCodecNetworkBufferMemoryBlockFunctions *blockFunctions, void *userarg);
 
+/**
+ * Creates a new network buffer whose first memory block holds `capacity` bytes
+ *
+ * Use this when the encoded size is known in advance, for example from a measuring
+ * CCNxCodecTlvEncoder, so the whole packet is written into one memory block and
+ * ccnxCodecNetworkBuffer_CreateIoVec() returns a single iovec.  The allocator may return less
+ * memory than asked for, in which case later writes go to further blocks as usual.
+ *
+ * @param [in] blockFunctions The allocator/de-allocator to use.
+ * @param [in] userarg Passed to all calls to the blockFunctions, may be NULL.
+ * @param [in] capacity The number of bytes to ask for in the first memory block.
+ *
+ * @return non-null A new network buffer
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_CreateWithCapacity(&ParcMemoryMemoryBlock, NULL, 8192);
+ *     ccnxCodecNetworkBuffer_Release(&netbuff);
+ * }
+ * @endcode
+ */
+CCNxCodecNetworkBuffer *ccnxCodecNetworkBuffer_CreateWithCapacity(const CCNxCodecNetworkBufferMemoryBlockFunctions *blockFunctions, void *userarg, size_t capacity);
+
 /**
  * Create a `CCNxCodecNetworkBuffer` from a buffer block.
  *
@@ -548,6 +574,58 @@ void ccnxCodecNetworkBuffer_PutBuffer(CCNxCodecNetworkBuffer *buffer, PARCBuffer
  */
 PARCBuffer *ccnxCodecNetworkBuffer_CreateParcBuffer(CCNxCodecNetworkBuffer *buffer);
 
+/**
+ * Computes the digest of a range of the network buffer
+ *
+ * The hasher is initialized, updated with the range and finalized, so it may be reused between calls,
+ * but not by two threads at once.
+ *
+ * @param [in] buffer An allocated `CCNxCodecNetworkBuffer`.
+ * @param [in] start The start position (must be 0 <= start < Limit)
+ * @param [in] end The last posiiton (start < end <= Limit)
+ * @param [in] hasher The {@link PARCCryptoHasher} to use
+ *
+ * @return The {@link PARCCryptoHash} of the range
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCCryptoHasher *hasher = parcCryptoHasher_Create(PARCCryptoHashType_SHA256);
+ *     PARCCryptoHash *hash = ccnxCodecNetworkBuffer_ComputeDigest(netbuff, 0, ccnxCodecNetworkBuffer_Limit(netbuff), hasher);
+ *     parcCryptoHash_Release(&hash);
+ *     parcCryptoHasher_Release(&hasher);
+ * }
+ * @endcode
+ */
+PARCCryptoHash *ccnxCodecNetworkBuffer_ComputeDigest(CCNxCodecNetworkBuffer *buffer, size_t start, size_t end, PARCCryptoHasher *hasher);
+
+/**
+ * Feeds a range of the network buffer to several hashers in one walk of the memory blocks
+ *
+ * The hashers are only updated, not initialized or finalized, so a caller can continue a hash
+ * over several ranges.  Each span of a memory block is given to every hasher before moving on,
+ * so computing, for example, a signature digest and a ContentObjectHash together reads the
+ * packet from memory once.
+ *
+ * @param [in] buffer An allocated `CCNxCodecNetworkBuffer`.
+ * @param [in] start The start position (must be 0 <= start <= end)
+ * @param [in] end The last posiiton, not inclusive (end <= Limit)
+ * @param [in] count The number of hashers
+ * @param [in] hashers The {@link PARCCryptoHasher}s to update
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCCryptoHasher *hashers[2] = { parcSigner_GetCryptoHasher(signer), contentObjectHasher };
+ *     parcCryptoHasher_Init(hashers[0]);
+ *     parcCryptoHasher_Init(hashers[1]);
+ *     ccnxCodecNetworkBuffer_UpdateHashers(netbuff, start, end, 2, hashers);
+ *     PARCCryptoHash *hash = parcCryptoHasher_Finalize(hashers[0]);
+ * }
+ * @endcode
+ */
+void ccnxCodecNetworkBuffer_UpdateHashers(const CCNxCodecNetworkBuffer *buffer, size_t start, size_t end, size_t count, PARCCryptoHasher *hashers[count]);
+
 /**
  * Runs a signer over the network buffer
  *
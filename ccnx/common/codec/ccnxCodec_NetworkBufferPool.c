@@ -0,0 +1,356 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * The pool is a LIFO free list of blocks, linked through a small header in front of each block.
+ * Only the owning thread touches the free list, so it needs no atomics.  A block released on another thread
+ * is pushed onto `returned`, a lock-free stack, and the owner takes the whole stack with one atomic exchange
+ * when its free list is empty.  Because the owner never pops a single entry from `returned`, the stack has no ABA problem.
+ *
+ * The header also records the block's capacity.  A request larger than the block size is allocated
+ * directly from the heap with its own capacity, and the deallocator frees it to the heap rather than keeping it.
+ *
+ * Counters written by more than one thread are updated with atomic adds.  The others are only written by the owner.
+ *
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <pthread.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+
+#include <ccnx/common/codec/ccnxCodec_NetworkBufferPool.h>
+
+// Each size leaves room for the network buffer's per-block header (40 bytes on LP64), so that a
+// 2048 byte growth block of the network buffer, or a whole 9000 byte jumbo frame, fits in one pool block
+const size_t CCNxCodecNetworkBufferPool_MtuBlockSize = 2048 + 64;
+const size_t CCNxCodecNetworkBufferPool_JumboBlockSize = 9216;
+
+static const size_t _ccnxCodecNetworkBufferPool_MinimumBlockSize = 256;
+
+typedef struct ccnx_codec_network_buffer_pool_block {
+    size_t capacity;    // The bytes after the header: the pool's block size, or more for a direct allocation
+    struct ccnx_codec_network_buffer_pool_block *next;
+} _CCNxCodecNetworkBufferPoolBlock;
+
+#define _ccnxCodecNetworkBufferPool_BlockMemory(block) ((void *) ((block) + 1))
+#define _ccnxCodecNetworkBufferPool_MemoryBlock(memory) (((_CCNxCodecNetworkBufferPoolBlock *) (memory)) - 1)
+
+struct ccnx_codec_network_buffer_pool {
+    size_t blockSize;
+    size_t maxFreeBlocks;
+    pthread_t owner;
+
+    // Owner only
+    _CCNxCodecNetworkBufferPoolBlock *freeList;
+    size_t freeCount;
+    uint64_t poolAllocations;
+    uint64_t heapDeallocations;
+
+    // Shared, updated atomically
+    _CCNxCodecNetworkBufferPoolBlock *returned;
+    size_t returnedCount;
+    uint64_t heapAllocations;
+    uint64_t remoteReturns;
+    uint64_t directAllocations;
+};
+
+static void
+_ccnxCodecNetworkBufferPool_FreeList(_CCNxCodecNetworkBufferPoolBlock *block)
+{
+    while (block != NULL) {
+        _CCNxCodecNetworkBufferPoolBlock *next = block->next;
+        parcMemory_Deallocate((void **) &block);
+        block = next;
+    }
+}
+
+static bool
+_ccnxCodecNetworkBufferPool_Destructor(CCNxCodecNetworkBufferPool **poolPtr)
+{
+    CCNxCodecNetworkBufferPool *pool = *poolPtr;
+
+    // Every block in use holds a reference, so all blocks are back in one of the lists.
+    _ccnxCodecNetworkBufferPool_FreeList(pool->freeList);
+    _ccnxCodecNetworkBufferPool_FreeList(pool->returned);
+    return true;
+}
+
+parcObject_Override(CCNxCodecNetworkBufferPool, PARCObject,
+                    .destructor = (PARCObjectDestructor *) _ccnxCodecNetworkBufferPool_Destructor);
+
+parcObject_ImplementAcquire(ccnxCodecNetworkBufferPool, CCNxCodecNetworkBufferPool);
+
+parcObject_ImplementRelease(ccnxCodecNetworkBufferPool, CCNxCodecNetworkBufferPool);
+
+static bool
+_ccnxCodecNetworkBufferPool_IsOwner(const CCNxCodecNetworkBufferPool *pool)
+{
+    return pthread_equal(pool->owner, pthread_self()) != 0;
+}
+
+/**
+ * Move the blocks returned by other threads to the free list, freeing any beyond maxFreeBlocks.
+ * Only called by the owner.
+ */
+static void
+_ccnxCodecNetworkBufferPool_CollectReturned(CCNxCodecNetworkBufferPool *pool)
+{
+    _CCNxCodecNetworkBufferPoolBlock *block = __sync_lock_test_and_set(&pool->returned, NULL);
+
+    size_t count = 0;
+    while (block != NULL) {
+        _CCNxCodecNetworkBufferPoolBlock *next = block->next;
+        if (pool->freeCount < pool->maxFreeBlocks) {
+            block->next = pool->freeList;
+            pool->freeList = block;
+            pool->freeCount++;
+        } else {
+            parcMemory_Deallocate((void **) &block);
+            pool->heapDeallocations++;
+        }
+        count++;
+        block = next;
+    }
+    __sync_fetch_and_sub(&pool->returnedCount, count);
+}
+
+static size_t
+_ccnxCodecNetworkBufferPool_Allocator(void *userarg, size_t bytes, void **output)
+{
+    CCNxCodecNetworkBufferPool *pool = userarg;
+    _CCNxCodecNetworkBufferPoolBlock *block = NULL;
+
+    if (bytes > pool->blockSize) {
+        // Too big for a block, so give the caller what it asked for rather than splitting it over blocks
+        block = parcMemory_Allocate(sizeof(_CCNxCodecNetworkBufferPoolBlock) + bytes);
+        if (block == NULL) {
+            *output = NULL;
+            return 0;
+        }
+        block->capacity = bytes;
+        __sync_fetch_and_add(&pool->directAllocations, 1);
+
+        ccnxCodecNetworkBufferPool_Acquire(pool);
+        *output = _ccnxCodecNetworkBufferPool_BlockMemory(block);
+        return bytes;
+    }
+
+    if (_ccnxCodecNetworkBufferPool_IsOwner(pool)) {
+        if (pool->freeList == NULL && __atomic_load_n(&pool->returned, __ATOMIC_RELAXED) != NULL) {
+            _ccnxCodecNetworkBufferPool_CollectReturned(pool);
+        }
+
+        block = pool->freeList;
+        if (block != NULL) {
+            pool->freeList = block->next;
+            pool->freeCount--;
+            pool->poolAllocations++;
+        }
+    }
+
+    if (block == NULL) {
+        block = parcMemory_Allocate(sizeof(_CCNxCodecNetworkBufferPoolBlock) + pool->blockSize);
+        if (block == NULL) {
+            *output = NULL;
+            return 0;
+        }
+        block->capacity = pool->blockSize;
+        __sync_fetch_and_add(&pool->heapAllocations, 1);
+    }
+
+    ccnxCodecNetworkBufferPool_Acquire(pool);
+    *output = _ccnxCodecNetworkBufferPool_BlockMemory(block);
+    return pool->blockSize;
+}
+
+static void
+_ccnxCodecNetworkBufferPool_Deallocator(void *userarg, void **memoryPtr)
+{
+    CCNxCodecNetworkBufferPool *pool = userarg;
+    _CCNxCodecNetworkBufferPoolBlock *block = _ccnxCodecNetworkBufferPool_MemoryBlock(*memoryPtr);
+
+    if (block->capacity != pool->blockSize) {
+        parcMemory_Deallocate((void **) &block);
+    } else if (_ccnxCodecNetworkBufferPool_IsOwner(pool)) {
+        if (pool->freeCount < pool->maxFreeBlocks) {
+            block->next = pool->freeList;
+            pool->freeList = block;
+            pool->freeCount++;
+        } else {
+            parcMemory_Deallocate((void **) &block);
+            pool->heapDeallocations++;
+        }
+    } else {
+        _CCNxCodecNetworkBufferPoolBlock *head;
+        do {
+            head = __atomic_load_n(&pool->returned, __ATOMIC_RELAXED);
+            block->next = head;
+        } while (!__sync_bool_compare_and_swap(&pool->returned, head, block));
+        __sync_fetch_and_add(&pool->returnedCount, 1);
+        __sync_fetch_and_add(&pool->remoteReturns, 1);
+    }
+
+    *memoryPtr = NULL;
+
+    // The block's reference to the pool.  This may destroy the pool.
+    ccnxCodecNetworkBufferPool_Release(&pool);
+}
+
+const CCNxCodecNetworkBufferMemoryBlockFunctions NetworkBufferPoolMemoryBlock = {
+    .allocator   = &_ccnxCodecNetworkBufferPool_Allocator,
+    .deallocator = &_ccnxCodecNetworkBufferPool_Deallocator
+};
+
+CCNxCodecNetworkBufferPool *
+ccnxCodecNetworkBufferPool_Create(size_t blockSize, size_t maxFreeBlocks)
+{
+    trapIllegalValueIf(blockSize < _ccnxCodecNetworkBufferPool_MinimumBlockSize,
+                       "Block size must be at least %zu, got %zu", _ccnxCodecNetworkBufferPool_MinimumBlockSize, blockSize);
+
+    CCNxCodecNetworkBufferPool *pool = parcObject_CreateAndClearInstance(CCNxCodecNetworkBufferPool);
+    if (pool != NULL) {
+        pool->blockSize = blockSize;
+        pool->maxFreeBlocks = maxFreeBlocks;
+        pool->owner = pthread_self();
+    }
+    return pool;
+}
+
+size_t
+ccnxCodecNetworkBufferPool_GetBlockSize(const CCNxCodecNetworkBufferPool *pool)
+{
+    assertNotNull(pool, "Parameter pool must be non-null");
+    return pool->blockSize;
+}
+
+void
+ccnxCodecNetworkBufferPool_GetStatistics(const CCNxCodecNetworkBufferPool *pool, CCNxCodecNetworkBufferPoolStatistics *statistics)
+{
+    assertNotNull(pool, "Parameter pool must be non-null");
+    assertNotNull(statistics, "Parameter statistics must be non-null");
+
+    statistics->blockSize = pool->blockSize;
+    statistics->maxFreeBlocks = pool->maxFreeBlocks;
+    statistics->freeBlocks = pool->freeCount + pool->returnedCount;
+    statistics->poolAllocations = pool->poolAllocations;
+    statistics->heapAllocations = pool->heapAllocations;
+    statistics->heapDeallocations = pool->heapDeallocations;
+    statistics->remoteReturns = pool->remoteReturns;
+    statistics->directAllocations = pool->directAllocations;
+    statistics->outstandingBlocks = (size_t) (statistics->heapAllocations - statistics->heapDeallocations) - statistics->freeBlocks;
+}
+
+void
+ccnxCodecNetworkBufferPool_Display(const CCNxCodecNetworkBufferPool *pool, int indentation)
+{
+    CCNxCodecNetworkBufferPoolStatistics statistics;
+    ccnxCodecNetworkBufferPool_GetStatistics(pool, &statistics);
+
+    printf("%*sCCNxCodecNetworkBufferPool %p blockSize %zu free %zu/%zu outstanding %zu\n",
+           indentation * 3, "", (void *) pool, statistics.blockSize, statistics.freeBlocks, statistics.maxFreeBlocks, statistics.outstandingBlocks);
+    printf("%*s   pool allocations %" PRIu64 " heap allocations %" PRIu64 " heap deallocations %" PRIu64 " remote returns %" PRIu64
+           " direct allocations %" PRIu64 "\n",
+           indentation * 3, "", statistics.poolAllocations, statistics.heapAllocations, statistics.heapDeallocations, statistics.remoteReturns,
+           statistics.directAllocations);
+}
+
+// ================================================================================
+
+static pthread_key_t _ccnxCodecNetworkBufferPool_ThreadKey;
+static pthread_once_t _ccnxCodecNetworkBufferPool_ThreadKeyOnce = PTHREAD_ONCE_INIT;
+
+static void
+_ccnxCodecNetworkBufferPool_ThreadExit(void *pool)
+{
+    ccnxCodecNetworkBufferPool_Release((CCNxCodecNetworkBufferPool **) &pool);
+}
+
+static void
+_ccnxCodecNetworkBufferPool_CreateThreadKey(void)
+{
+    int failure = pthread_key_create(&_ccnxCodecNetworkBufferPool_ThreadKey, _ccnxCodecNetworkBufferPool_ThreadExit);
+    trapUnexpectedStateIf(failure, "pthread_key_create failed: %d", failure);
+}
+
+void
+ccnxCodecNetworkBufferPool_SetThreadPool(CCNxCodecNetworkBufferPool *pool)
+{
+    pthread_once(&_ccnxCodecNetworkBufferPool_ThreadKeyOnce, _ccnxCodecNetworkBufferPool_CreateThreadKey);
+
+    CCNxCodecNetworkBufferPool *previous = pthread_getspecific(_ccnxCodecNetworkBufferPool_ThreadKey);
+
+    if (pool != NULL) {
+        assertTrue(_ccnxCodecNetworkBufferPool_IsOwner(pool), "A pool may only be bound to the thread that created it");
+        pool = ccnxCodecNetworkBufferPool_Acquire(pool);
+    }
+    pthread_setspecific(_ccnxCodecNetworkBufferPool_ThreadKey, pool);
+
+    if (previous != NULL) {
+        ccnxCodecNetworkBufferPool_Release(&previous);
+    }
+}
+
+CCNxCodecNetworkBufferPool *
+ccnxCodecNetworkBufferPool_GetThreadPool(void)
+{
+    pthread_once(&_ccnxCodecNetworkBufferPool_ThreadKeyOnce, _ccnxCodecNetworkBufferPool_CreateThreadKey);
+    return pthread_getspecific(_ccnxCodecNetworkBufferPool_ThreadKey);
+}
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file ccnxCodec_NetworkBufferPool.h
+ * @brief A pool of fixed size memory blocks for CCNxCodecNetworkBuffer
+ *
+ * A `CCNxCodecNetworkBufferPool` keeps the memory blocks released by network buffers and hands them
+ * back out to later network buffers, so that once the pool is warm, encoding a packet does not go to
+ * the heap for its packet memory.  Use it by passing {@link NetworkBufferPoolMemoryBlock} and the pool as
+ * the block functions and userarg of {@link ccnxCodecNetworkBuffer_Create}, or bind the pool to a thread
+ * with {@link ccnxCodecNetworkBufferPool_SetThreadPool} so every {@link ccnxCodecTlvEncoder_Create}
+ * on that thread uses it.
+ *
+ * Every block of a pool has the same size, for example {@link CCNxCodecNetworkBufferPool_MtuBlockSize} or
+ * {@link CCNxCodecNetworkBufferPool_JumboBlockSize}.  A request up to the block size gets a whole block, so the block size
+ * decides how much packet fits in each extent of the network buffer.  A larger request, such as a network buffer
+ * created with the measured length of a big packet, is allocated directly from the heap at the size asked for and
+ * freed to the heap when it is returned.
+ *
+ * A pool belongs to the thread that created it and takes no locks.  That thread allocates and returns blocks
+ * through a private free list.  Other threads may also use the pool: a block they release goes to a lock-free
+ * return list that the owning thread collects when its free list runs out, and a block they allocate comes
+ * from the heap.  Each block in use holds a reference to the pool, so the pool lives until its last block is returned.
+ *
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef Libccnx_codec_ccnxCodecNetworkBufferPool_h
+#define Libccnx_codec_ccnxCodecNetworkBufferPool_h
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <ccnx/common/codec/ccnxCodec_NetworkBuffer.h>
+
+struct ccnx_codec_network_buffer_pool;
+/**
+ * @typedef CCNxCodecNetworkBufferPool
+ * @brief A per-thread pool of fixed size memory blocks for network buffers.
+ */
+typedef struct ccnx_codec_network_buffer_pool CCNxCodecNetworkBufferPool;
+
+/**
+ * @typedef CCNxCodecNetworkBufferPoolStatistics
+ * @brief A snapshot of the counters of a `CCNxCodecNetworkBufferPool`.
+ */
+typedef struct ccnx_codec_network_buffer_pool_statistics {
+    size_t blockSize;            /**< Bytes in each block */
+    size_t maxFreeBlocks;        /**< The most blocks the pool keeps for reuse */
+    size_t freeBlocks;           /**< Blocks held by the pool, ready for reuse */
+    size_t outstandingBlocks;    /**< Blocks held by network buffers */
+    uint64_t poolAllocations;    /**< Blocks served from the pool without going to the heap */
+    uint64_t heapAllocations;    /**< Blocks allocated from the heap */
+    uint64_t heapDeallocations;  /**< Blocks freed to the heap because the pool was full */
+    uint64_t remoteReturns;      /**< Blocks returned by a thread other than the owner */
+    uint64_t directAllocations;  /**< Requests larger than a block, allocated from the heap and not pooled */
+} CCNxCodecNetworkBufferPoolStatistics;
+
+/**
+ * 2112 bytes: the network buffer's 2048 byte growth block plus room for its per-block header.
+ * An Ethernet MTU packet (1500 bytes) fits in one block.
+ */
+extern const size_t CCNxCodecNetworkBufferPool_MtuBlockSize;
+
+/**
+ * 9216 bytes: a 9000 byte jumbo frame plus the network buffer's per-block header, rounded up to 9 KiB.
+ */
+extern const size_t CCNxCodecNetworkBufferPool_JumboBlockSize;
+
+/**
+ * The block functions to use with a `CCNxCodecNetworkBufferPool`.  The userarg must be the pool.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecNetworkBufferPool *pool = ccnxCodecNetworkBufferPool_Create(CCNxCodecNetworkBufferPool_MtuBlockSize, 64);
+ *     CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_Create(&NetworkBufferPoolMemoryBlock, pool);
+ *     ccnxCodecNetworkBufferPool_Release(&pool);
+ *
+ *     // ... encode into netbuff.  Its blocks keep the pool alive.
+ *
+ *     ccnxCodecNetworkBuffer_Release(&netbuff);
+ * }
+ * @endcode
+ */
+extern const CCNxCodecNetworkBufferMemoryBlockFunctions NetworkBufferPoolMemoryBlock;
+
+/**
+ * Create a pool of blocks of `blockSize` bytes, owned by the calling thread.
+ *
+ * The pool starts empty.  Blocks are allocated from the heap as needed and kept when they are returned,
+ * up to `maxFreeBlocks` of them.  Blocks returned beyond that are freed to the heap.
+ *
+ * @param [in] blockSize The number of bytes in each block, at least 256.
+ * @param [in] maxFreeBlocks The most blocks to keep for reuse.
+ *
+ * @return non-null A new pool.
+ * @return null Out of memory.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecNetworkBufferPool *pool = ccnxCodecNetworkBufferPool_Create(CCNxCodecNetworkBufferPool_JumboBlockSize, 16);
+ *     ccnxCodecNetworkBufferPool_Release(&pool);
+ * }
+ * @endcode
+ */
+CCNxCodecNetworkBufferPool *ccnxCodecNetworkBufferPool_Create(size_t blockSize, size_t maxFreeBlocks);
+
+/**
+ * Increase the number of references to a `CCNxCodecNetworkBufferPool`.
+ *
+ * @param [in] pool A pointer to the original instance.
+ * @return The value of the input parameter @p pool.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecNetworkBufferPool *reference = ccnxCodecNetworkBufferPool_Acquire(pool);
+ *     ccnxCodecNetworkBufferPool_Release(&reference);
+ * }
+ * @endcode
+ *
+ * @see ccnxCodecNetworkBufferPool_Release
+ */
+CCNxCodecNetworkBufferPool *ccnxCodecNetworkBufferPool_Acquire(const CCNxCodecNetworkBufferPool *pool);
+
+/**
+ * Release a previously acquired reference to the specified instance,
+ * decrementing the reference count for the instance.
+ *
+ * The pool is destroyed, freeing its free blocks, once the last reference is released.
+ * Every block held by a network buffer holds a reference.
+ *
+ * @param [in,out] poolPtr A pointer to a pointer to the instance to release, set to NULL on return.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecNetworkBufferPool *pool = ccnxCodecNetworkBufferPool_Create(CCNxCodecNetworkBufferPool_MtuBlockSize, 64);
+ *     ccnxCodecNetworkBufferPool_Release(&pool);
+ * }
+ * @endcode
+ */
+void ccnxCodecNetworkBufferPool_Release(CCNxCodecNetworkBufferPool **poolPtr);
+
+/**
+ * Return the size in bytes of each block of the pool.
+ *
+ * @param [in] pool A `CCNxCodecNetworkBufferPool` instance.
+ *
+ * @return The block size given to {@link ccnxCodecNetworkBufferPool_Create}.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t blockSize = ccnxCodecNetworkBufferPool_GetBlockSize(pool);
+ * }
+ * @endcode
+ */
+size_t ccnxCodecNetworkBufferPool_GetBlockSize(const CCNxCodecNetworkBufferPool *pool);
+
+/**
+ * Fill in `statistics` with the current counters of the pool.
+ *
+ * The snapshot is exact when taken on the owning thread while no other thread uses the pool.
+ * Otherwise blocks in flight on other threads may be counted a moment late.
+ *
+ * @param [in] pool A `CCNxCodecNetworkBufferPool` instance.
+ * @param [out] statistics Filled in with the counters.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecNetworkBufferPoolStatistics statistics;
+ *     ccnxCodecNetworkBufferPool_GetStatistics(pool, &statistics);
+ *     printf("%" PRIu64 " heap allocations\n", statistics.heapAllocations);
+ * }
+ * @endcode
+ */
+void ccnxCodecNetworkBufferPool_GetStatistics(const CCNxCodecNetworkBufferPool *pool, CCNxCodecNetworkBufferPoolStatistics *statistics);
+
+/**
+ * Print a human readable representation of the pool and its statistics.
+ *
+ * @param [in] pool A `CCNxCodecNetworkBufferPool` instance.
+ * @param [in] indentation The level of indentation to use to pretty-print the output.
+ *
+ * Example:
+ * @code
+ * {
+ *     ccnxCodecNetworkBufferPool_Display(pool, 0);
+ * }
+ * @endcode
+ */
+void ccnxCodecNetworkBufferPool_Display(const CCNxCodecNetworkBufferPool *pool, int indentation);
+
+/**
+ * Bind a pool to the calling thread, or unbind it with NULL.
+ *
+ * While a pool is bound, {@link ccnxCodecTlvEncoder_Create} on this thread encodes into network buffers
+ * drawn from that pool.  The thread holds a reference to the pool, released when another pool is bound
+ * or when the thread exits.  A pool may only be bound to the thread that created it.
+ *
+ * @param [in] pool The pool to bind, or NULL to go back to parcMemory.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecNetworkBufferPool *pool = ccnxCodecNetworkBufferPool_Create(CCNxCodecNetworkBufferPool_MtuBlockSize, 64);
+ *     ccnxCodecNetworkBufferPool_SetThreadPool(pool);
+ *     ccnxCodecNetworkBufferPool_Release(&pool);
+ *
+ *     // ... encode packets
+ *
+ *     ccnxCodecNetworkBufferPool_SetThreadPool(NULL);
+ * }
+ * @endcode
+ */
+void ccnxCodecNetworkBufferPool_SetThreadPool(CCNxCodecNetworkBufferPool *pool);
+
+/**
+ * Return the pool bound to the calling thread.
+ *
+ * The reference is borrowed from the thread; acquire it to keep it past the next {@link ccnxCodecNetworkBufferPool_SetThreadPool}.
+ *
+ * @return non-null The pool bound with {@link ccnxCodecNetworkBufferPool_SetThreadPool}.
+ * @return null No pool is bound to this thread.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecNetworkBufferPool *pool = ccnxCodecNetworkBufferPool_GetThreadPool();
+ * }
+ * @endcode
+ */
+CCNxCodecNetworkBufferPool *ccnxCodecNetworkBufferPool_GetThreadPool(void);
+#endif // Libccnx_codec_ccnxCodecNetworkBufferPool_h
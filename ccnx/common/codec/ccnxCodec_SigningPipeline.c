@@ -0,0 +1,430 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * Jobs are kept in one list in submission order.  Jobs that still need a signature are also linked,
+ * through `nextToSign`, into a FIFO the workers take from.  Everything is protected by one mutex: a worker
+ * holds it only to take a job and to mark it complete, and signs with the mutex released.
+ *
+ * A job owns its encoder from Submit until the worker completes it, so the encoder is only ever used by one
+ * thread at a time even though it is created on the caller's thread and finished on a worker.
+ *
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <stdio.h>
+#include <pthread.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+#include <parc/security/parc_CryptoHasher.h>
+#include <parc/security/parc_CryptoSuite.h>
+#include <parc/security/parc_Signature.h>
+
+#include <ccnx/common/codec/ccnxCodec_SigningPipeline.h>
+#include <ccnx/common/codec/ccnxCodec_TlvEncoder.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_PacketEncoder.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_TlvDictionary.h>
+
+typedef struct ccnx_codec_signing_job {
+    struct ccnx_codec_signing_job *next;
+    struct ccnx_codec_signing_job *nextToSign;
+
+    CCNxTlvDictionary *packet;
+    CCNxCodecTlvEncoder *encoder;               // NULL once the job is complete
+    PARCCryptoHash *digest;                     // NULL if the packet needs no signature
+    CCNxCodecNetworkBufferIoVec *wireFormat;    // NULL until the job is complete
+    bool complete;
+} _CCNxCodecSigningJob;
+
+typedef struct ccnx_codec_signing_worker {
+    struct ccnx_codec_signing_pipeline *pipeline;
+    PARCSigner *signer;
+    pthread_t thread;
+} _CCNxCodecSigningWorker;
+
+struct ccnx_codec_signing_pipeline {
+    bool preserveOrder;
+    PARCCryptoSuite suite;
+
+    // Only used by Submit, on the caller's thread
+    PARCCryptoHasher *hasher;
+
+    size_t numberOfWorkers;
+    _CCNxCodecSigningWorker *workers;
+
+    pthread_mutex_t lock;
+    pthread_cond_t workAvailable;
+    pthread_cond_t jobCompleted;
+    bool stopping;
+
+    // All jobs, in submission order
+    _CCNxCodecSigningJob *head;
+    _CCNxCodecSigningJob *tail;
+    size_t pending;
+
+    // Jobs waiting for a worker, linked through nextToSign
+    _CCNxCodecSigningJob *signHead;
+    _CCNxCodecSigningJob *signTail;
+};
+
+static CCNxCodecNetworkBufferIoVec *
+_ccnxCodecSigningPipeline_FinishEncoder(CCNxCodecTlvEncoder **encoderPtr)
+{
+    CCNxCodecTlvEncoder *encoder = *encoderPtr;
+    CCNxCodecNetworkBufferIoVec *vec = NULL;
+
+    if (!ccnxCodecTlvEncoder_HasError(encoder)) {
+        ccnxCodecTlvEncoder_Finalize(encoder);
+        vec = ccnxCodecTlvEncoder_CreateIoVec(encoder);
+    }
+
+    ccnxCodecTlvEncoder_Destroy(encoderPtr);
+    return vec;
+}
+
+static void
+_ccnxCodecSigningJob_Destroy(_CCNxCodecSigningJob **jobPtr)
+{
+    _CCNxCodecSigningJob *job = *jobPtr;
+
+    if (job->encoder != NULL) {
+        ccnxCodecTlvEncoder_Destroy(&job->encoder);
+    }
+    if (job->digest != NULL) {
+        parcCryptoHash_Release(&job->digest);
+    }
+    if (job->wireFormat != NULL) {
+        ccnxCodecNetworkBufferIoVec_Release(&job->wireFormat);
+    }
+    if (job->packet != NULL) {
+        ccnxTlvDictionary_Release(&job->packet);
+    }
+    parcMemory_Deallocate((void **) jobPtr);
+}
+
+/**
+ * Sign the digest of a job and append the signature to its encoded packet.
+ *
+ * On failure the job completes with no wire format, and the packet's dictionary is left without a
+ * ValidationPayload, so `ccnxCodecSigningPipeline_Take` returns NULL for it.
+ *
+ * Called on a worker thread without the lock held.
+ */
+static void
+_ccnxCodecSigningPipeline_Sign(PARCSigner *signer, _CCNxCodecSigningJob *job)
+{
+    PARCSignature *signature = parcSigner_SignDigest(signer, job->digest);
+    parcCryptoHash_Release(&job->digest);
+
+    if (signature != NULL) {
+        PARCBuffer *payload = parcSignature_GetSignature(signature);
+
+        if (ccnxCodecSchemaV1PacketEncoder_AppendValidationPayload(job->encoder, 0, payload) >= 0) {
+            job->wireFormat = _ccnxCodecSigningPipeline_FinishEncoder(&job->encoder);
+            if (job->wireFormat != NULL) {
+                ccnxTlvDictionary_PutBuffer(job->packet, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_PAYLOAD, payload);
+            }
+        }
+
+        parcSignature_Release(&signature);
+    }
+
+    if (job->encoder != NULL) {
+        ccnxCodecTlvEncoder_Destroy(&job->encoder);
+    }
+}
+
+static void *
+_ccnxCodecSigningPipeline_Worker(void *arg)
+{
+    _CCNxCodecSigningWorker *worker = arg;
+    CCNxCodecSigningPipeline *pipeline = worker->pipeline;
+
+    pthread_mutex_lock(&pipeline->lock);
+    while (true) {
+        while (!pipeline->stopping && pipeline->signHead == NULL) {
+            pthread_cond_wait(&pipeline->workAvailable, &pipeline->lock);
+        }
+        if (pipeline->stopping) {
+            break;
+        }
+
+        _CCNxCodecSigningJob *job = pipeline->signHead;
+        pipeline->signHead = job->nextToSign;
+        if (pipeline->signHead == NULL) {
+            pipeline->signTail = NULL;
+        }
+        pthread_mutex_unlock(&pipeline->lock);
+
+        _ccnxCodecSigningPipeline_Sign(worker->signer, job);
+
+        pthread_mutex_lock(&pipeline->lock);
+        job->complete = true;
+        pthread_cond_broadcast(&pipeline->jobCompleted);
+    }
+    pthread_mutex_unlock(&pipeline->lock);
+
+    return NULL;
+}
+
+static bool
+_ccnxCodecSigningPipeline_Destructor(CCNxCodecSigningPipeline **pipelinePtr)
+{
+    CCNxCodecSigningPipeline *pipeline = *pipelinePtr;
+
+    pthread_mutex_lock(&pipeline->lock);
+    pipeline->stopping = true;
+    pthread_cond_broadcast(&pipeline->workAvailable);
+    pthread_mutex_unlock(&pipeline->lock);
+
+    for (size_t i = 0; i < pipeline->numberOfWorkers; i++) {
+        pthread_join(pipeline->workers[i].thread, NULL);
+        parcSigner_Release(&pipeline->workers[i].signer);
+    }
+    parcMemory_Deallocate((void **) &pipeline->workers);
+
+    while (pipeline->head != NULL) {
+        _CCNxCodecSigningJob *job = pipeline->head;
+        pipeline->head = job->next;
+        _ccnxCodecSigningJob_Destroy(&job);
+    }
+
+    parcCryptoHasher_Release(&pipeline->hasher);
+
+    pthread_cond_destroy(&pipeline->jobCompleted);
+    pthread_cond_destroy(&pipeline->workAvailable);
+    pthread_mutex_destroy(&pipeline->lock);
+    return true;
+}
+
+parcObject_Override(CCNxCodecSigningPipeline, PARCObject,
+                    .destructor = (PARCObjectDestructor *) _ccnxCodecSigningPipeline_Destructor);
+
+parcObject_ImplementAcquire(ccnxCodecSigningPipeline, CCNxCodecSigningPipeline);
+
+parcObject_ImplementRelease(ccnxCodecSigningPipeline, CCNxCodecSigningPipeline);
+
+CCNxCodecSigningPipeline *
+ccnxCodecSigningPipeline_Create(size_t count, PARCSigner *signers[count], bool preserveOrder)
+{
+    assertTrue(count > 0, "A signing pipeline needs at least one signer");
+    assertNotNull(signers, "Parameter signers must be non-null");
+
+    PARCCryptoSuite suite = parcSigner_GetCryptoSuite(signers[0]);
+    for (size_t i = 1; i < count; i++) {
+        assertTrue(parcSigner_GetCryptoSuite(signers[i]) == suite, "Signer %zu has a different crypto suite than signer 0", i);
+    }
+
+    CCNxCodecSigningPipeline *pipeline = parcObject_CreateAndClearInstance(CCNxCodecSigningPipeline);
+    assertNotNull(pipeline, "parcObject_CreateAndClearInstance returned NULL");
+
+    pipeline->preserveOrder = preserveOrder;
+    pipeline->suite = suite;
+    pipeline->hasher = parcCryptoHasher_Create(parcCryptoSuite_GetCryptoHash(suite));
+
+    pthread_mutex_init(&pipeline->lock, NULL);
+    pthread_cond_init(&pipeline->workAvailable, NULL);
+    pthread_cond_init(&pipeline->jobCompleted, NULL);
+
+    pipeline->numberOfWorkers = count;
+    pipeline->workers = parcMemory_AllocateAndClear(count * sizeof(_CCNxCodecSigningWorker));
+    assertNotNull(pipeline->workers, "parcMemory_AllocateAndClear(%zu) returned NULL", count * sizeof(_CCNxCodecSigningWorker));
+
+    for (size_t i = 0; i < count; i++) {
+        _CCNxCodecSigningWorker *worker = &pipeline->workers[i];
+        worker->pipeline = pipeline;
+        worker->signer = parcSigner_Acquire(signers[i]);
+
+        int failure = pthread_create(&worker->thread, NULL, _ccnxCodecSigningPipeline_Worker, worker);
+        trapUnexpectedStateIf(failure, "pthread_create failed: %d", failure);
+    }
+
+    return pipeline;
+}
+
+bool
+ccnxCodecSigningPipeline_Submit(CCNxCodecSigningPipeline *pipeline, CCNxTlvDictionary *packet)
+{
+    assertNotNull(pipeline, "Parameter pipeline must be non-null");
+    assertNotNull(packet, "Parameter packet must be non-null");
+
+    if (ccnxTlvDictionary_GetSchemaVersion(packet) != CCNxTlvDictionary_SchemaVersion_V1) {
+        return false;
+    }
+
+    // The workers could not produce a signature the packet's ValidationAlg claims
+    if (ccnxTlvDictionary_IsValueInteger(packet, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_CRYPTO_SUITE)
+        && ccnxTlvDictionary_GetInteger(packet, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_CRYPTO_SUITE) != (uint64_t) pipeline->suite) {
+        return false;
+    }
+
+    // The encoder has a signer, so the ValidationAlg gets the SigTime and, for a ContentObject without one,
+    // the crypto suite deduced from the signer, exactly as if the packet were signed inline.  The signature
+    // is deferred, so the packet ends after the ValidationAlg, ready for the worker to append the signature.
+    // The workers' signers are not used from this thread for anything but their algorithm and hash type.
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    ccnxCodecTlvEncoder_SetSigner(encoder, pipeline->workers[0].signer);
+    ccnxCodecTlvEncoder_DeferSignature(encoder);
+    ssize_t length = ccnxCodecSchemaV1PacketEncoder_Encode(encoder, packet);
+    if (length < 0 || ccnxCodecTlvEncoder_HasError(encoder)) {
+        ccnxCodecTlvEncoder_Destroy(&encoder);
+        return false;
+    }
+
+    _CCNxCodecSigningJob *job = parcMemory_AllocateAndClear(sizeof(_CCNxCodecSigningJob));
+    assertNotNull(job, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(_CCNxCodecSigningJob));
+    job->packet = ccnxTlvDictionary_Acquire(packet);
+
+    if (!ccnxTlvDictionary_IsValueBuffer(packet, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_PAYLOAD)) {
+        job->digest = ccnxCodecTlvEncoder_ComputeDigest(encoder, pipeline->hasher);
+    }
+
+    if (job->digest != NULL) {
+        job->encoder = encoder;
+    } else {
+        job->wireFormat = _ccnxCodecSigningPipeline_FinishEncoder(&encoder);
+        job->complete = true;
+    }
+
+    pthread_mutex_lock(&pipeline->lock);
+    if (pipeline->tail != NULL) {
+        pipeline->tail->next = job;
+    } else {
+        pipeline->head = job;
+    }
+    pipeline->tail = job;
+    pipeline->pending++;
+
+    if (!job->complete) {
+        if (pipeline->signTail != NULL) {
+            pipeline->signTail->nextToSign = job;
+        } else {
+            pipeline->signHead = job;
+        }
+        pipeline->signTail = job;
+        pthread_cond_signal(&pipeline->workAvailable);
+    }
+    pthread_mutex_unlock(&pipeline->lock);
+
+    return true;
+}
+
+CCNxCodecNetworkBufferIoVec *
+ccnxCodecSigningPipeline_Take(CCNxCodecSigningPipeline *pipeline, CCNxTlvDictionary **packetPtr)
+{
+    assertNotNull(pipeline, "Parameter pipeline must be non-null");
+
+    _CCNxCodecSigningJob *job = NULL;
+    if (packetPtr != NULL) {
+        *packetPtr = NULL;
+    }
+
+    pthread_mutex_lock(&pipeline->lock);
+    while (pipeline->head != NULL && job == NULL) {
+        _CCNxCodecSigningJob *previous = NULL;
+        _CCNxCodecSigningJob *candidate = pipeline->head;
+        if (!pipeline->preserveOrder) {
+            while (candidate != NULL && !candidate->complete) {
+                previous = candidate;
+                candidate = candidate->next;
+            }
+        }
+
+        if (candidate != NULL && candidate->complete) {
+            job = candidate;
+            if (previous != NULL) {
+                previous->next = job->next;
+            } else {
+                pipeline->head = job->next;
+            }
+            if (pipeline->tail == job) {
+                pipeline->tail = previous;
+            }
+            pipeline->pending--;
+        } else {
+            pthread_cond_wait(&pipeline->jobCompleted, &pipeline->lock);
+        }
+    }
+    pthread_mutex_unlock(&pipeline->lock);
+
+    if (job == NULL) {
+        return NULL;
+    }
+
+    CCNxCodecNetworkBufferIoVec *vec = job->wireFormat;
+    job->wireFormat = NULL;
+    if (packetPtr != NULL) {
+        *packetPtr = job->packet;
+        job->packet = NULL;
+    }
+    _ccnxCodecSigningJob_Destroy(&job);
+
+    return vec;
+}
+
+size_t
+ccnxCodecSigningPipeline_GetPending(const CCNxCodecSigningPipeline *pipeline)
+{
+    assertNotNull(pipeline, "Parameter pipeline must be non-null");
+
+    CCNxCodecSigningPipeline *mutablePipeline = (CCNxCodecSigningPipeline *) pipeline;
+    pthread_mutex_lock(&mutablePipeline->lock);
+    size_t pending = pipeline->pending;
+    pthread_mutex_unlock(&mutablePipeline->lock);
+    return pending;
+}
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file ccnxCodec_SigningPipeline.h
+ * @brief Sign packets on a pool of worker threads
+ *
+ * Signing with a public key algorithm costs far more than encoding and hashing the packet, so a
+ * single thread that encodes and signs is bound by the signer.  A `CCNxCodecSigningPipeline` splits the
+ * work: {@link ccnxCodecSigningPipeline_Submit} encodes the packet and computes the digest of its protected
+ * region on the caller's thread, then hands the digest to one of the worker threads.  The worker signs
+ * the digest with its own `PARCSigner`, appends the ValidationPayload to the already encoded packet, and marks
+ * the packet complete.  {@link ccnxCodecSigningPipeline_Take} returns the wire format of completed packets,
+ * either in the order they were submitted or in the order they completed.
+ *
+ * Give the pipeline one signer per worker, usually one per core.  The signers must all use the same crypto
+ * suite, and are normally instances of the same key.  Each worker only ever uses its own signer, so the
+ * signers need not be thread-safe.
+ *
+ * A packet is encoded as {@link ccnxCodecTlvPacket_DictionaryEncode} would encode it with the workers' signer:
+ * the ValidationAlg gets a signing time, and a ContentObject without a crypto suite gets the signer's.  A packet
+ * that should be signed is submitted without a ValidationPayload, for example after
+ * {@link ccnxValidationRsaSha256_Set}.  A packet without a ValidationAlg, or one that already has its
+ * ValidationPayload, skips the workers and completes immediately.  While a packet is in the pipeline, a worker
+ * puts the ValidationPayload in its dictionary, so the caller must not modify the dictionary until it has
+ * been returned by `ccnxCodecSigningPipeline_Take`.
+ *
+ * A pipeline is used by one thread at a time: the workers are internal, but `Submit` and `Take` are not
+ * meant to be called concurrently from several threads.
+ *
+ * Only schema version 1 packets are supported.
+ *
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef Libccnx_codec_ccnxCodecSigningPipeline_h
+#define Libccnx_codec_ccnxCodecSigningPipeline_h
+
+#include <stdbool.h>
+
+#include <parc/security/parc_Signer.h>
+
+#include <ccnx/common/internal/ccnx_TlvDictionary.h>
+#include <ccnx/common/codec/ccnxCodec_NetworkBuffer.h>
+
+struct ccnx_codec_signing_pipeline;
+/**
+ * @typedef CCNxCodecSigningPipeline
+ * @brief Encodes packets on the caller's thread and signs them on worker threads.
+ */
+typedef struct ccnx_codec_signing_pipeline CCNxCodecSigningPipeline;
+
+/**
+ * Create a signing pipeline with one worker thread per signer.
+ *
+ * The pipeline acquires a reference to each signer.  Worker `i` only ever uses `signers[i]`.
+ *
+ * @param [in] count The number of signers and worker threads, at least 1.
+ * @param [in] signers The signers, all with the same crypto suite.
+ * @param [in] preserveOrder If true, `ccnxCodecSigningPipeline_Take` returns packets in submission order.
+ *
+ * @return non-null A new `CCNxCodecSigningPipeline`, with its workers running.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCSigner *signers[4];
+ *     for (int i = 0; i < 4; i++) {
+ *         signers[i] = _createSigner();
+ *     }
+ *
+ *     CCNxCodecSigningPipeline *pipeline = ccnxCodecSigningPipeline_Create(4, signers, true);
+ *
+ *     for (int i = 0; i < 4; i++) {
+ *         parcSigner_Release(&signers[i]);
+ *     }
+ *
+ *     ccnxCodecSigningPipeline_Release(&pipeline);
+ * }
+ * @endcode
+ */
+CCNxCodecSigningPipeline *ccnxCodecSigningPipeline_Create(size_t count, PARCSigner *signers[count], bool preserveOrder);
+
+/**
+ * Increase the number of references to a `CCNxCodecSigningPipeline`.
+ *
+ * @param [in] pipeline A pointer to a `CCNxCodecSigningPipeline` instance.
+ * @return The value of the input parameter @p pipeline.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecSigningPipeline *reference = ccnxCodecSigningPipeline_Acquire(pipeline);
+ *
+ *     ccnxCodecSigningPipeline_Release(&reference);
+ * }
+ * @endcode
+ */
+CCNxCodecSigningPipeline *ccnxCodecSigningPipeline_Acquire(const CCNxCodecSigningPipeline *pipeline);
+
+/**
+ * Release a previously acquired reference to the specified instance,
+ * decrementing the reference count for the instance.
+ *
+ * When the last reference is released, the workers finish the signature they are computing and exit.
+ * Packets still in the pipeline are discarded.
+ *
+ * @param [in,out] pipelinePtr A pointer to a pointer to the instance to release.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecSigningPipeline *pipeline = ccnxCodecSigningPipeline_Create(count, signers, true);
+ *
+ *     ccnxCodecSigningPipeline_Release(&pipeline);
+ * }
+ * @endcode
+ */
+void ccnxCodecSigningPipeline_Release(CCNxCodecSigningPipeline **pipelinePtr);
+
+/**
+ * Encode a packet and queue it to be signed.
+ *
+ * The packet is encoded and the digest of its protected region computed before this returns, so the
+ * caller's thread does the encoding and hashing while the workers do the signing.
+ * The pipeline holds a reference to `packet` until it is returned by {@link ccnxCodecSigningPipeline_Take}.
+ *
+ * @param [in] pipeline A `CCNxCodecSigningPipeline` instance.
+ * @param [in] packet A schema version 1 packet dictionary.
+ *
+ * @retval true The packet is in the pipeline.
+ * @retval false The packet could not be encoded, or names a crypto suite other than the signers', and is not
+ *               in the pipeline.
+ *
+ * Example:
+ * @code
+ * {
+ *     ccnxValidationRsaSha256_Set(contentObject, keyid, NULL);
+ *     ccnxCodecSigningPipeline_Submit(pipeline, contentObject);
+ * }
+ * @endcode
+ */
+bool ccnxCodecSigningPipeline_Submit(CCNxCodecSigningPipeline *pipeline, CCNxTlvDictionary *packet);
+
+/**
+ * Return the wire format of a completed packet, waiting for one if needed.
+ *
+ * If the pipeline preserves order, this waits for the oldest packet in the pipeline.  Otherwise it
+ * returns whichever packet completed first.
+ *
+ * @param [in] pipeline A `CCNxCodecSigningPipeline` instance.
+ * @param [out] packetPtr If not NULL, set to the dictionary of the returned packet, which the caller must release,
+ *                        or to NULL if the pipeline is empty.
+ *
+ * @retval non-null The signed wire format of the packet, which the caller must release.
+ * @retval null The pipeline is empty, or the packet could not be signed or encoded, for example because it
+ *              was too long (`*packetPtr` is not NULL and has no ValidationPayload).
+ *
+ * Example:
+ * @code
+ * {
+ *     while (ccnxCodecSigningPipeline_GetPending(pipeline) > 0) {
+ *         CCNxTlvDictionary *packet;
+ *         CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSigningPipeline_Take(pipeline, &packet);
+ *         if (vec != NULL) {
+ *             _send(vec);
+ *             ccnxCodecNetworkBufferIoVec_Release(&vec);
+ *         } else {
+ *             _reportFailure(packet);
+ *         }
+ *         ccnxTlvDictionary_Release(&packet);
+ *     }
+ * }
+ * @endcode
+ */
+CCNxCodecNetworkBufferIoVec *ccnxCodecSigningPipeline_Take(CCNxCodecSigningPipeline *pipeline, CCNxTlvDictionary **packetPtr);
+
+/**
+ * The number of packets submitted and not yet taken.
+ *
+ * @param [in] pipeline A `CCNxCodecSigningPipeline` instance.
+ *
+ * @return The number of packets in the pipeline, complete or not.
+ *
+ * Example:
+ * @code
+ * {
+ *     while (ccnxCodecSigningPipeline_GetPending(pipeline) > 0) {
+ *         CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSigningPipeline_Take(pipeline, NULL);
+ *         if (vec != NULL) {
+ *             _send(vec);
+ *             ccnxCodecNetworkBufferIoVec_Release(&vec);
+ *         }
+ *     }
+ * }
+ * @endcode
+ */
+size_t ccnxCodecSigningPipeline_GetPending(const CCNxCodecSigningPipeline *pipeline);
+#endif // Libccnx_codec_ccnxCodecSigningPipeline_h
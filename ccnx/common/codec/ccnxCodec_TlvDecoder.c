@@ -62,21 +62,240 @@
 #include <config.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <LongBow/runtime.h>
 #include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
 #include <parc/algol/parc_Buffer.h>
 #include <ccnx/common/codec/ccnxCodec_NetworkBuffer.h>
 
 #include <ccnx/common/codec/ccnxCodec_TlvDecoder.h>
 
+/*
+ * The extents of a CCNxCodecNetworkBufferIoVec, shared by a decoder and all of its container decoders.
+ * `offsets[i]` is the offset of extent i from the start of the iovec and `offsets[count]` is the total length.
+ * `buffers[i]` wraps extent i.  It is created the first time a value is sliced from the extent.
+ */
+typedef struct ccnx_codec_tlv_decoder_extents {
+    CCNxCodecNetworkBufferIoVec *vec;
+    const struct iovec *iov;
+    int count;
+    size_t *offsets;
+    PARCBuffer **buffers;
+} _CCNxCodecTlvDecoderExtents;
+
+/*
+ * A copy of bytes that straddle two extents, made by ccnxCodecTlvDecoder_GetArray.
+ */
+typedef struct ccnx_codec_tlv_decoder_copy {
+    struct ccnx_codec_tlv_decoder_copy *next;
+    uint8_t bytes[];
+} _CCNxCodecTlvDecoderCopy;
+
 struct ccnx_codec_tlv_decoder {
     // we use a read only buffer because we want independent
     // position and limit from whatever the user gives us.
     PARCBuffer *buffer;
 
+    // If `buffer` is NULL, the decoder reads the bytes [start, limit) of the iovec extents in place.
+    // `extent` is the index of the extent that holds `position`.  It only moves forward, except when
+    // ccnxCodecTlvDecoder_SetPosition moves the decoder back.
+    _CCNxCodecTlvDecoderExtents *extents;
+    size_t start;
+    size_t position;
+    size_t limit;
+    int extent;
+    _CCNxCodecTlvDecoderCopy *copies;
+
+    // If not NULL, the decoder, its extents and its copies are allocated from the arena and freed with it.
+    CCNxCodecArena *arena;
+
     CCNxCodecError *error;
 };
 
+/*
+ * Release the buffers and iovec held by the extents.  Extents allocated from an arena run this as an arena cleanup.
+ */
+static void
+_ccnxCodecTlvDecoderExtents_ReleaseReferences(_CCNxCodecTlvDecoderExtents *extents)
+{
+    if (extents->buffers != NULL) {
+        for (int i = 0; i < extents->count; i++) {
+            if (extents->buffers[i] != NULL) {
+                parcBuffer_Release(&extents->buffers[i]);
+            }
+        }
+    }
+    if (extents->vec != NULL) {
+        ccnxCodecNetworkBufferIoVec_Release(&extents->vec);
+    }
+}
+
+static bool
+_ccnxCodecTlvDecoderExtents_Destructor(_CCNxCodecTlvDecoderExtents **extentsPtr)
+{
+    _CCNxCodecTlvDecoderExtents *extents = *extentsPtr;
+
+    _ccnxCodecTlvDecoderExtents_ReleaseReferences(extents);
+    if (extents->buffers != NULL) {
+        parcMemory_Deallocate((void **) &extents->buffers);
+    }
+    if (extents->offsets != NULL) {
+        parcMemory_Deallocate((void **) &extents->offsets);
+    }
+    return true;
+}
+
+parcObject_Override(_CCNxCodecTlvDecoderExtents, PARCObject,
+                    .destructor = (PARCObjectDestructor *) _ccnxCodecTlvDecoderExtents_Destructor);
+
+/*
+ * Create extents for `count` iovec entries.  The caller fills in `iov`, `offsets` and, optionally, `vec`.
+ * Without an arena the extents are a reference counted object.  With an arena they belong to the arena.
+ */
+static _CCNxCodecTlvDecoderExtents *
+_ccnxCodecTlvDecoderExtents_Create(CCNxCodecArena *arena, int count)
+{
+    _CCNxCodecTlvDecoderExtents *extents;
+
+    if (arena != NULL) {
+        extents = ccnxCodecArena_AllocateAndClear(arena, sizeof(_CCNxCodecTlvDecoderExtents));
+        extents->offsets = ccnxCodecArena_Allocate(arena, (count + 1) * sizeof(size_t));
+        extents->buffers = ccnxCodecArena_AllocateAndClear(arena, count * sizeof(PARCBuffer *));
+        ccnxCodecArena_AddCleanup(arena, (CCNxCodecArenaCleanup *) _ccnxCodecTlvDecoderExtents_ReleaseReferences, extents);
+    } else {
+        extents = parcObject_CreateAndClearInstance(_CCNxCodecTlvDecoderExtents);
+        assertNotNull(extents, "parcObject_CreateAndClearInstance returned NULL");
+        extents->offsets = parcMemory_Allocate((count + 1) * sizeof(size_t));
+        assertNotNull(extents->offsets, "parcMemory_Allocate(%zu) returned NULL", (count + 1) * sizeof(size_t));
+        extents->buffers = parcMemory_AllocateAndClear(count * sizeof(PARCBuffer *));
+        assertNotNull(extents->buffers, "parcMemory_AllocateAndClear(%zu) returned NULL", count * sizeof(PARCBuffer *));
+    }
+    extents->count = count;
+
+    return extents;
+}
+
+static PARCBuffer *
+_ccnxCodecTlvDecoderExtents_GetBuffer(_CCNxCodecTlvDecoderExtents *extents, int extent)
+{
+    if (extents->buffers[extent] == NULL) {
+        size_t length = extents->iov[extent].iov_len;
+        extents->buffers[extent] = parcBuffer_Wrap(extents->iov[extent].iov_base, length, 0, length);
+    }
+    return extents->buffers[extent];
+}
+
+/*
+ * Move `extent` forward to the extent that holds `position`, skipping empty extents.
+ */
+static inline void
+_ccnxCodecTlvDecoder_Seek(CCNxCodecTlvDecoder *decoder)
+{
+    const _CCNxCodecTlvDecoderExtents *extents = decoder->extents;
+    while (decoder->extent + 1 < extents->count && extents->offsets[decoder->extent + 1] <= decoder->position) {
+        decoder->extent++;
+    }
+}
+
+/*
+ * Return a pointer to the `length` bytes at the current position, without advancing.
+ * If the bytes are in one extent the pointer is into that extent, otherwise they are copied to `copy`.
+ * The caller has ensured that `length` bytes remain.
+ */
+static const uint8_t *
+_ccnxCodecTlvDecoder_Peek(CCNxCodecTlvDecoder *decoder, size_t length, uint8_t *copy)
+{
+    _ccnxCodecTlvDecoder_Seek(decoder);
+
+    const _CCNxCodecTlvDecoderExtents *extents = decoder->extents;
+    int extent = decoder->extent;
+    size_t offset = decoder->position - extents->offsets[extent];
+
+    if (decoder->position + length <= extents->offsets[extent + 1]) {
+        return (const uint8_t *) extents->iov[extent].iov_base + offset;
+    }
+
+    size_t copied = 0;
+    while (copied < length) {
+        size_t available = extents->iov[extent].iov_len - offset;
+        size_t count = (length - copied < available) ? length - copied : available;
+        memcpy(&copy[copied], (const uint8_t *) extents->iov[extent].iov_base + offset, count);
+        copied += count;
+        extent++;
+        offset = 0;
+    }
+    return copy;
+}
+
+/*
+ * Read a `length` byte unsigned integer in network byte order and advance past it.
+ */
+static uint64_t
+_ccnxCodecTlvDecoder_IoVecGetUint(CCNxCodecTlvDecoder *decoder, size_t length)
+{
+    trapOutOfBoundsIf(decoder->limit - decoder->position < length, "Decoder underrun reading %zu bytes", length);
+
+    uint8_t copy[sizeof(uint64_t)];
+    const uint8_t *bytes = _ccnxCodecTlvDecoder_Peek(decoder, length, copy);
+
+    uint64_t value = 0;
+    for (size_t i = 0; i < length; i++) {
+        value = (value << 8) | bytes[i];
+    }
+    decoder->position += length;
+    return value;
+}
+
+/*
+ * Return the `length` bytes at the current position and advance past them.
+ * If the bytes are in one extent the result is a slice of that extent, otherwise it is a copy.
+ */
+static PARCBuffer *
+_ccnxCodecTlvDecoder_IoVecGetValue(CCNxCodecTlvDecoder *decoder, size_t length)
+{
+    _ccnxCodecTlvDecoder_Seek(decoder);
+
+    _CCNxCodecTlvDecoderExtents *extents = decoder->extents;
+    size_t offset = decoder->position - extents->offsets[decoder->extent];
+
+    PARCBuffer *value;
+    if (decoder->position + length <= extents->offsets[decoder->extent + 1]) {
+        PARCBuffer *buffer = _ccnxCodecTlvDecoderExtents_GetBuffer(extents, decoder->extent);
+        parcBuffer_SetLimit(buffer, offset + length);
+        parcBuffer_SetPosition(buffer, offset);
+        value = parcBuffer_Slice(buffer);
+    } else {
+        value = parcBuffer_Allocate(length);
+        _ccnxCodecTlvDecoder_Peek(decoder, length, parcBuffer_Overlay(value, 0));
+    }
+
+    decoder->position += length;
+    return value;
+}
+
+static CCNxCodecTlvDecoder *
+_ccnxCodecTlvDecoder_CreateFromExtents(CCNxCodecArena *arena, _CCNxCodecTlvDecoderExtents *extents, size_t start, size_t limit, int extent)
+{
+    CCNxCodecTlvDecoder *decoder;
+
+    if (arena != NULL) {
+        decoder = ccnxCodecArena_AllocateAndClear(arena, sizeof(CCNxCodecTlvDecoder));
+        decoder->arena = ccnxCodecArena_Acquire(arena);
+        decoder->extents = extents;
+    } else {
+        decoder = parcMemory_AllocateAndClear(sizeof(CCNxCodecTlvDecoder));
+        assertNotNull(decoder, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(CCNxCodecTlvDecoder));
+        decoder->extents = parcObject_Acquire(extents);
+    }
+    decoder->start = start;
+    decoder->position = start;
+    decoder->limit = limit;
+    decoder->extent = extent;
+
+    return decoder;
+}
+
 CCNxCodecTlvDecoder *
 ccnxCodecTlvDecoder_Create(PARCBuffer *buffer)
 {
@@ -91,19 +310,103 @@ ccnxCodecTlvDecoder_Create(PARCBuffer *buffer)
     return decoder;
 }
 
+static CCNxCodecTlvDecoder *
+_ccnxCodecTlvDecoder_CreateFromIoVec(CCNxCodecNetworkBufferIoVec *vec, CCNxCodecArena *arena)
+{
+    assertNotNull(vec, "Parameter vec must be non-null");
+
+    int count = ccnxCodecNetworkBufferIoVec_GetCount(vec);
+    if (count < 1) {
+        return NULL;
+    }
+
+    _CCNxCodecTlvDecoderExtents *extents = _ccnxCodecTlvDecoderExtents_Create(arena, count);
+    extents->vec = ccnxCodecNetworkBufferIoVec_Acquire(vec);
+    extents->iov = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+
+    extents->offsets[0] = 0;
+    for (int i = 0; i < count; i++) {
+        extents->offsets[i + 1] = extents->offsets[i] + extents->iov[i].iov_len;
+    }
+
+    CCNxCodecTlvDecoder *decoder = _ccnxCodecTlvDecoder_CreateFromExtents(arena, extents, 0, extents->offsets[count], 0);
+    if (arena == NULL) {
+        parcObject_Release((PARCObject **) &extents);
+    }
+
+    return decoder;
+}
+
+CCNxCodecTlvDecoder *
+ccnxCodecTlvDecoder_CreateFromIoVec(CCNxCodecNetworkBufferIoVec *vec)
+{
+    return _ccnxCodecTlvDecoder_CreateFromIoVec(vec, NULL);
+}
+
+CCNxCodecTlvDecoder *
+ccnxCodecTlvDecoder_CreateFromIoVecWithArena(CCNxCodecNetworkBufferIoVec *vec, CCNxCodecArena *arena)
+{
+    assertNotNull(arena, "Parameter arena must be non-null");
+    return _ccnxCodecTlvDecoder_CreateFromIoVec(vec, arena);
+}
+
+CCNxCodecTlvDecoder *
+ccnxCodecTlvDecoder_CreateWithArena(PARCBuffer *buffer, CCNxCodecArena *arena)
+{
+    assertNotNull(buffer, "Parameter buffer must be non-null");
+    assertNotNull(arena, "Parameter arena must be non-null");
+
+    // The buffer becomes a single extent.  One slice gives the whole decode its own position and limit,
+    // after that containers are only offsets into it.
+    PARCBuffer *slice = parcBuffer_Slice(buffer);
+    size_t length = parcBuffer_Remaining(slice);
+
+    struct iovec *iov = ccnxCodecArena_Allocate(arena, sizeof(struct iovec));
+    iov->iov_base = parcBuffer_Overlay(slice, 0);
+    iov->iov_len = length;
+
+    _CCNxCodecTlvDecoderExtents *extents = _ccnxCodecTlvDecoderExtents_Create(arena, 1);
+    extents->iov = iov;
+    extents->buffers[0] = slice;
+    extents->offsets[0] = 0;
+    extents->offsets[1] = length;
+
+    return _ccnxCodecTlvDecoder_CreateFromExtents(arena, extents, 0, length, 0);
+}
+
 void
 ccnxCodecTlvDecoder_Destroy(CCNxCodecTlvDecoder **decoderPtr)
 {
     assertNotNull(decoderPtr, "Parameter must be non-null double pointer");
     assertNotNull(*decoderPtr, "Parameter must dereferecne to non-null pointer");
     CCNxCodecTlvDecoder *decoder = *decoderPtr;
-    parcBuffer_Release(&decoder->buffer);
-
 
     if (decoder->error) {
         ccnxCodecError_Release(&decoder->error);
     }
 
+    if (decoder->arena) {
+        // Everything else belongs to the arena.  Releasing it may free the decoder itself.
+        CCNxCodecArena *arena = decoder->arena;
+        *decoderPtr = NULL;
+        ccnxCodecArena_Release(&arena);
+        return;
+    }
+
+    if (decoder->buffer) {
+        parcBuffer_Release(&decoder->buffer);
+    }
+
+    if (decoder->extents) {
+        parcObject_Release((PARCObject **) &decoder->extents);
+    }
+
+    while (decoder->copies) {
+        _CCNxCodecTlvDecoderCopy *copy = decoder->copies;
+        decoder->copies = copy->next;
+        parcMemory_Deallocate((void **) &copy);
+    }
+
     parcMemory_Deallocate((void **) &decoder);
     *decoderPtr = NULL;
 }
@@ -112,30 +415,40 @@ bool
 ccnxCodecTlvDecoder_IsEmpty(CCNxCodecTlvDecoder *decoder)
 {
     assertNotNull(decoder, "Parameter decoder must be non-null");
-    return (!parcBuffer_HasRemaining(decoder->buffer));
+    return ccnxCodecTlvDecoder_Remaining(decoder) == 0;
 }
 
 bool
 ccnxCodecTlvDecoder_EnsureRemaining(CCNxCodecTlvDecoder *decoder, size_t bytes)
 {
     assertNotNull(decoder, "Parameter decoder must be non-null");
-    return parcBuffer_Remaining(decoder->buffer) >= bytes;
+    return ccnxCodecTlvDecoder_Remaining(decoder) >= bytes;
 }
 
 size_t
 ccnxCodecTlvDecoder_Remaining(const CCNxCodecTlvDecoder *decoder)
 {
     assertNotNull(decoder, "Parameter decoder must be non-null");
-    return parcBuffer_Remaining(decoder->buffer);
+    if (decoder->buffer) {
+        return parcBuffer_Remaining(decoder->buffer);
+    }
+    return decoder->limit - decoder->position;
 }
 
 uint16_t
 ccnxCodecTlvDecoder_PeekType(CCNxCodecTlvDecoder *decoder)
 {
     assertNotNull(decoder, "Parameter decoder must be non-null");
-    size_t position = parcBuffer_Position(decoder->buffer);
-    uint16_t type = parcBuffer_GetUint16(decoder->buffer);
-    parcBuffer_SetPosition(decoder->buffer, position);
+    if (decoder->buffer) {
+        size_t position = parcBuffer_Position(decoder->buffer);
+        uint16_t type = parcBuffer_GetUint16(decoder->buffer);
+        parcBuffer_SetPosition(decoder->buffer, position);
+        return type;
+    }
+
+    size_t position = decoder->position;
+    uint16_t type = (uint16_t) _ccnxCodecTlvDecoder_IoVecGetUint(decoder, 2);
+    decoder->position = position;
     return type;
 }
 
@@ -143,14 +456,20 @@ uint16_t
 ccnxCodecTlvDecoder_GetType(CCNxCodecTlvDecoder *decoder)
 {
     assertNotNull(decoder, "Parameter decoder must be non-null");
-    return parcBuffer_GetUint16(decoder->buffer);
+    if (decoder->buffer) {
+        return parcBuffer_GetUint16(decoder->buffer);
+    }
+    return (uint16_t) _ccnxCodecTlvDecoder_IoVecGetUint(decoder, 2);
 }
 
 uint16_t
 ccnxCodecTlvDecoder_GetLength(CCNxCodecTlvDecoder *decoder)
 {
     assertNotNull(decoder, "Parameter decoder must be non-null");
-    return parcBuffer_GetUint16(decoder->buffer);
+    if (decoder->buffer) {
+        return parcBuffer_GetUint16(decoder->buffer);
+    }
+    return (uint16_t) _ccnxCodecTlvDecoder_IoVecGetUint(decoder, 2);
 }
 
 PARCBuffer *
@@ -160,12 +479,47 @@ ccnxCodecTlvDecoder_GetValue(CCNxCodecTlvDecoder *decoder, uint16_t length)
     PARCBuffer *value = NULL;
 
     if (ccnxCodecTlvDecoder_EnsureRemaining(decoder, length)) {
-        value = parcBuffer_Slice(decoder->buffer);
-        parcBuffer_SetLimit(value, length);
+        if (decoder->buffer) {
+            value = parcBuffer_Slice(decoder->buffer);
+            parcBuffer_SetLimit(value, length);
+
+            size_t position = parcBuffer_Position(decoder->buffer);
+            position += length;
+            parcBuffer_SetPosition(decoder->buffer, position);
+        } else {
+            value = _ccnxCodecTlvDecoder_IoVecGetValue(decoder, length);
+        }
+    }
 
-        size_t position = parcBuffer_Position(decoder->buffer);
-        position += length;
-        parcBuffer_SetPosition(decoder->buffer, position);
+    return value;
+}
+
+const uint8_t *
+ccnxCodecTlvDecoder_GetArray(CCNxCodecTlvDecoder *decoder, uint16_t length)
+{
+    assertNotNull(decoder, "Parameter decoder must be non-null");
+    const uint8_t *value = NULL;
+
+    if (ccnxCodecTlvDecoder_EnsureRemaining(decoder, length)) {
+        if (decoder->buffer) {
+            // parcBuffer_Overlay advances the position by length
+            value = parcBuffer_Overlay(decoder->buffer, length);
+        } else {
+            // Allocate space for a copy only if the bytes turn out to straddle two extents.
+            _ccnxCodecTlvDecoder_Seek(decoder);
+            if (decoder->position + length <= decoder->extents->offsets[decoder->extent + 1]) {
+                value = _ccnxCodecTlvDecoder_Peek(decoder, length, NULL);
+            } else if (decoder->arena) {
+                value = _ccnxCodecTlvDecoder_Peek(decoder, length, ccnxCodecArena_Allocate(decoder->arena, length));
+            } else {
+                _CCNxCodecTlvDecoderCopy *copy = parcMemory_Allocate(sizeof(_CCNxCodecTlvDecoderCopy) + length);
+                assertNotNull(copy, "parcMemory_Allocate(%zu) returned NULL", sizeof(_CCNxCodecTlvDecoderCopy) + length);
+                copy->next = decoder->copies;
+                decoder->copies = copy;
+                value = _ccnxCodecTlvDecoder_Peek(decoder, length, copy->bytes);
+            }
+            decoder->position += length;
+        }
     }
 
     return value;
@@ -192,24 +546,58 @@ ccnxCodecTlvDecoder_GetContainer(CCNxCodecTlvDecoder *decoder, uint16_t length)
 {
     CCNxCodecTlvDecoder *innerDecoder = NULL;
     if (ccnxCodecTlvDecoder_EnsureRemaining(decoder, length)) {
-        PARCBuffer *value = ccnxCodecTlvDecoder_GetValue(decoder, length);
-        innerDecoder = ccnxCodecTlvDecoder_Create(value);
-        parcBuffer_Release(&value);
+        if (decoder->buffer) {
+            PARCBuffer *value = ccnxCodecTlvDecoder_GetValue(decoder, length);
+            innerDecoder = ccnxCodecTlvDecoder_Create(value);
+            parcBuffer_Release(&value);
+        } else {
+            _ccnxCodecTlvDecoder_Seek(decoder);
+            if (decoder->arena == NULL && decoder->position + length <= decoder->extents->offsets[decoder->extent + 1]) {
+                // The container is in one extent, so decode it from a slice like any other buffer.
+                // With an arena, sharing the extents costs less than the slice.
+                PARCBuffer *value = _ccnxCodecTlvDecoder_IoVecGetValue(decoder, length);
+                innerDecoder = ccnxCodecTlvDecoder_Create(value);
+                parcBuffer_Release(&value);
+            } else {
+                innerDecoder = _ccnxCodecTlvDecoder_CreateFromExtents(decoder->arena, decoder->extents, decoder->position,
+                                                                     decoder->position + length, decoder->extent);
+                decoder->position += length;
+            }
+        }
     }
     return innerDecoder;
 }
 
-bool
-ccnxCodecTlvDecoder_GetUint8(CCNxCodecTlvDecoder *decoder, uint16_t type, uint8_t *output)
+/*
+ * Decode a TLV of the given type with a fixed length unsigned integer value.
+ */
+static bool
+_ccnxCodecTlvDecoder_GetUint(CCNxCodecTlvDecoder *decoder, uint16_t type, size_t valueLength, uint64_t *output)
 {
-    const size_t valueLength = 1;
     bool success = false;
-    if (parcBuffer_Remaining(decoder->buffer) >= 4 + valueLength) {
+    if (ccnxCodecTlvDecoder_Remaining(decoder) >= 4 + valueLength) {
         if (ccnxCodecTlvDecoder_PeekType(decoder) == type) {
             // advance the buffer
             (void) ccnxCodecTlvDecoder_GetType(decoder);
             if (ccnxCodecTlvDecoder_GetLength(decoder) == valueLength) {
-                *output = parcBuffer_GetUint8(decoder->buffer);
+                if (decoder->buffer) {
+                    switch (valueLength) {
+                        case 1:
+                            *output = parcBuffer_GetUint8(decoder->buffer);
+                            break;
+                        case 2:
+                            *output = parcBuffer_GetUint16(decoder->buffer);
+                            break;
+                        case 4:
+                            *output = parcBuffer_GetUint32(decoder->buffer);
+                            break;
+                        default:
+                            *output = parcBuffer_GetUint64(decoder->buffer);
+                            break;
+                    }
+                } else {
+                    *output = _ccnxCodecTlvDecoder_IoVecGetUint(decoder, valueLength);
+                }
                 success = true;
             }
         }
@@ -217,20 +605,24 @@ ccnxCodecTlvDecoder_GetUint8(CCNxCodecTlvDecoder *decoder, uint16_t type, uint8_
     return success;
 }
 
+bool
+ccnxCodecTlvDecoder_GetUint8(CCNxCodecTlvDecoder *decoder, uint16_t type, uint8_t *output)
+{
+    uint64_t value;
+    bool success = _ccnxCodecTlvDecoder_GetUint(decoder, type, 1, &value);
+    if (success) {
+        *output = (uint8_t) value;
+    }
+    return success;
+}
+
 bool
 ccnxCodecTlvDecoder_GetUint16(CCNxCodecTlvDecoder *decoder, uint16_t type, uint16_t *output)
 {
-    const size_t valueLength = 2;
-    bool success = false;
-    if (parcBuffer_Remaining(decoder->buffer) >= 4 + valueLength) {
-        if (ccnxCodecTlvDecoder_PeekType(decoder) == type) {
-            // advance the buffer
-            (void) ccnxCodecTlvDecoder_GetType(decoder);
-            if (ccnxCodecTlvDecoder_GetLength(decoder) == valueLength) {
-                *output = parcBuffer_GetUint16(decoder->buffer);
-                success = true;
-            }
-        }
+    uint64_t value;
+    bool success = _ccnxCodecTlvDecoder_GetUint(decoder, type, 2, &value);
+    if (success) {
+        *output = (uint16_t) value;
     }
     return success;
 }
@@ -238,17 +630,10 @@ ccnxCodecTlvDecoder_GetUint16(CCNxCodecTlvDecoder *decoder, uint16_t type, uint1
 bool
 ccnxCodecTlvDecoder_GetUint32(CCNxCodecTlvDecoder *decoder, uint16_t type, uint32_t *output)
 {
-    const size_t valueLength = 4;
-    bool success = false;
-    if (parcBuffer_Remaining(decoder->buffer) >= 4 + valueLength) {
-        if (ccnxCodecTlvDecoder_PeekType(decoder) == type) {
-            // advance the buffer
-            (void) ccnxCodecTlvDecoder_GetType(decoder);
-            if (ccnxCodecTlvDecoder_GetLength(decoder) == valueLength) {
-                *output = parcBuffer_GetUint32(decoder->buffer);
-                success = true;
-            }
-        }
+    uint64_t value;
+    bool success = _ccnxCodecTlvDecoder_GetUint(decoder, type, 4, &value);
+    if (success) {
+        *output = (uint32_t) value;
     }
     return success;
 }
@@ -256,19 +641,7 @@ ccnxCodecTlvDecoder_GetUint32(CCNxCodecTlvDecoder *decoder, uint16_t type, uint3
 bool
 ccnxCodecTlvDecoder_GetUint64(CCNxCodecTlvDecoder *decoder, uint16_t type, uint64_t *output)
 {
-    const size_t valueLength = 8;
-    bool success = false;
-    if (parcBuffer_Remaining(decoder->buffer) >= 4 + valueLength) {
-        if (ccnxCodecTlvDecoder_PeekType(decoder) == type) {
-            // advance the buffer
-            (void) ccnxCodecTlvDecoder_GetType(decoder);
-            if (ccnxCodecTlvDecoder_GetLength(decoder) == valueLength) {
-                *output = parcBuffer_GetUint64(decoder->buffer);
-                success = true;
-            }
-        }
-    }
-    return success;
+    return _ccnxCodecTlvDecoder_GetUint(decoder, type, 8, output);
 }
 
 
@@ -276,7 +649,31 @@ size_t
 ccnxCodecTlvDecoder_Position(CCNxCodecTlvDecoder *decoder)
 {
     assertNotNull(decoder, "Parameter decoder must be non-null");
-    return parcBuffer_Position(decoder->buffer);
+    if (decoder->buffer) {
+        return parcBuffer_Position(decoder->buffer);
+    }
+    return decoder->position - decoder->start;
+}
+
+bool
+ccnxCodecTlvDecoder_SetPosition(CCNxCodecTlvDecoder *decoder, size_t position)
+{
+    assertNotNull(decoder, "Parameter decoder must be non-null");
+    bool success = false;
+    if (decoder->buffer) {
+        if (position <= parcBuffer_Limit(decoder->buffer)) {
+            parcBuffer_SetPosition(decoder->buffer, position);
+            success = true;
+        }
+    } else if (position <= decoder->limit - decoder->start) {
+        if (decoder->start + position < decoder->position) {
+            // Seek only moves forward, so start it again from the first extent
+            decoder->extent = 0;
+        }
+        decoder->position = decoder->start + position;
+        success = true;
+    }
+    return success;
 }
 
 bool
@@ -284,10 +681,14 @@ ccnxCodecTlvDecoder_Advance(CCNxCodecTlvDecoder *decoder, uint16_t length)
 {
     assertNotNull(decoder, "Parameter decoder must be non-null");
     bool success = false;
-    if (parcBuffer_Remaining(decoder->buffer) >= length) {
-        size_t position = parcBuffer_Position(decoder->buffer);
-        position += length;
-        parcBuffer_SetPosition(decoder->buffer, position);
+    if (ccnxCodecTlvDecoder_Remaining(decoder) >= length) {
+        if (decoder->buffer) {
+            size_t position = parcBuffer_Position(decoder->buffer);
+            position += length;
+            parcBuffer_SetPosition(decoder->buffer, position);
+        } else {
+            decoder->position += length;
+        }
         success = true;
     }
     return success;
@@ -315,7 +716,23 @@ bool
 ccnxCodecTlvDecoder_GetVarInt(CCNxCodecTlvDecoder *decoder, uint16_t length, uint64_t *output)
 {
     assertNotNull(decoder, "Parameter decoder must be non-null");
-    return ccnxCodecTlvDecoder_BufferToVarInt(decoder->buffer, length, output);
+    if (decoder->buffer) {
+        return ccnxCodecTlvDecoder_BufferToVarInt(decoder->buffer, length, output);
+    }
+
+    bool success = false;
+    if (length >= 1 && length <= 8 && ccnxCodecTlvDecoder_Remaining(decoder) >= length) {
+        *output = _ccnxCodecTlvDecoder_IoVecGetUint(decoder, length);
+        success = true;
+    }
+    return success;
+}
+
+CCNxCodecArena *
+ccnxCodecTlvDecoder_GetArena(const CCNxCodecTlvDecoder *decoder)
+{
+    assertNotNull(decoder, "Parameter decoder must be non-null");
+    return decoder->arena;
 }
 
 bool
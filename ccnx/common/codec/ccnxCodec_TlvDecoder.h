@@ -159,6 +159,7 @@
 
 #include <parc/algol/parc_Buffer.h>
 #include <ccnx/common/codec/ccnxCodec_NetworkBuffer.h>
+#include <ccnx/common/codec/ccnxCodec_Arena.h>
 #include <parc/security/parc_Signer.h>
 #include <parc/security/parc_Signature.h>
 
@@ -174,7 +175,7 @@ typedef struct ccnx_codec_tlv_decoder CCNxCodecTlvDecoder;
  * Walks through a TLV-encoded buffer returning buffer slices of the
  * original.  These are 0-copy operations.
  *
- * The decoder should be based on the CCNxCodecNetworkBufferIoVec, see case 1009
+ * To decode scatter/gather memory without first copying it into one buffer, use {@link ccnxCodecTlvDecoder_CreateFromIoVec}.
  *
  * @param [in] buffer The buffer to parse, must be ready to read.
  *
@@ -192,6 +193,108 @@ typedef struct ccnx_codec_tlv_decoder CCNxCodecTlvDecoder;
  */
 CCNxCodecTlvDecoder *ccnxCodecTlvDecoder_Create(PARCBuffer *buffer);
 
+/**
+ * Decodes the TLV-encoded memory of a `CCNxCodecNetworkBufferIoVec` in place
+ *
+ * The decoder reads across the boundaries of the iovec extents without linearizing them.
+ * A value or container that lies within one extent is returned as a 0-copy slice of that extent.
+ * Only a value that straddles two or more extents is copied, and only that value.
+ *
+ * The decoder holds a reference to @p vec until it, and every decoder returned by
+ * {@link ccnxCodecTlvDecoder_GetContainer}, is destroyed.  Buffers returned by the decoder
+ * refer to the memory of @p vec, so the caller must keep @p vec for as long as it uses them.
+ *
+ * @param [in] vec The iovec to parse.
+ *
+ * @return non-null A TLV decoder
+ * @return null An error
+ *
+ * Example:
+ * @code
+ * {
+ *      CCNxCodecNetworkBufferIoVec *vec = ccnxCodecNetworkBuffer_CreateIoVec(netbuff);
+ *      CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_CreateFromIoVec(vec);
+ *      uint16_t type = ccnxCodecTlvDecoder_GetType(decoder);
+ *      ccnxCodecTlvDecoder_Destroy(&decoder);
+ *      ccnxCodecNetworkBufferIoVec_Release(&vec);
+ * }
+ * @endcode
+ */
+CCNxCodecTlvDecoder *ccnxCodecTlvDecoder_CreateFromIoVec(CCNxCodecNetworkBufferIoVec *vec);
+
+/**
+ * Decodes a TLV-encoded buffer with all decoder state allocated from an arena
+ *
+ * The decoder, every decoder returned by {@link ccnxCodecTlvDecoder_GetContainer}, and any copies
+ * made by {@link ccnxCodecTlvDecoder_GetArray} are allocated from @p arena instead of the heap.
+ * Containers are not sliced: they share one view of @p buffer and only keep their own start and limit.
+ * {@link ccnxCodecTlvDecoder_Destroy} frees nothing but the decoder's reference to the arena,
+ * the memory is reclaimed when the arena is destroyed.
+ *
+ * Values returned by {@link ccnxCodecTlvDecoder_GetValue} are still `PARCBuffer` slices from the heap,
+ * as they are handed to the caller.
+ *
+ * @param [in] buffer The buffer to parse, must be ready to read.
+ * @param [in] arena The arena to allocate from.  Each decoder holds a reference to it.
+ *
+ * @return non-null A TLV decoder
+ * @return null An error
+ *
+ * Example:
+ * @code
+ * {
+ *      CCNxCodecArena *arena = ccnxCodecArena_Create();
+ *      CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_CreateWithArena(input, arena);
+ *      uint16_t type = ccnxCodecTlvDecoder_GetType(decoder);
+ *      ccnxCodecTlvDecoder_Destroy(&decoder);
+ *      ccnxCodecArena_Release(&arena);
+ * }
+ * @endcode
+ */
+CCNxCodecTlvDecoder *ccnxCodecTlvDecoder_CreateWithArena(PARCBuffer *buffer, CCNxCodecArena *arena);
+
+/**
+ * Decodes the memory of a `CCNxCodecNetworkBufferIoVec` in place, with all decoder state allocated from an arena
+ *
+ * Combines {@link ccnxCodecTlvDecoder_CreateFromIoVec} and {@link ccnxCodecTlvDecoder_CreateWithArena}.
+ * The arena, not the decoder, holds the reference to @p vec, so it is released when the arena is destroyed.
+ *
+ * @param [in] vec The iovec to parse.
+ * @param [in] arena The arena to allocate from.  Each decoder holds a reference to it.
+ *
+ * @return non-null A TLV decoder
+ * @return null An error
+ *
+ * Example:
+ * @code
+ * {
+ *      CCNxCodecArena *arena = ccnxCodecArena_Create();
+ *      CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_CreateFromIoVecWithArena(vec, arena);
+ *      uint16_t type = ccnxCodecTlvDecoder_GetType(decoder);
+ *      ccnxCodecTlvDecoder_Destroy(&decoder);
+ *      ccnxCodecArena_Release(&arena);
+ * }
+ * @endcode
+ */
+CCNxCodecTlvDecoder *ccnxCodecTlvDecoder_CreateFromIoVecWithArena(CCNxCodecNetworkBufferIoVec *vec, CCNxCodecArena *arena);
+
+/**
+ * Returns the arena the decoder allocates from
+ *
+ * @param [in] decoder An instance of `CCNxCodecTlvDecoder`
+ *
+ * @return non-null The arena given to {@link ccnxCodecTlvDecoder_CreateWithArena}, not acquired.
+ * @return null The decoder allocates from the heap.
+ *
+ * Example:
+ * @code
+ * {
+ *      CCNxCodecArena *arena = ccnxCodecTlvDecoder_GetArena(decoder);
+ * }
+ * @endcode
+ */
+CCNxCodecArena *ccnxCodecTlvDecoder_GetArena(const CCNxCodecTlvDecoder *decoder);
+
 /**
  * Releases the tlv decoder.
  *
@@ -369,6 +472,34 @@ uint16_t ccnxCodecTlvDecoder_GetLength(CCNxCodecTlvDecoder *decoder);
  */
 PARCBuffer *ccnxCodecTlvDecoder_GetValue(CCNxCodecTlvDecoder *decoder, uint16_t length);
 
+/**
+ * Returns a pointer to the next `length` bytes of the decoder and advances past them
+ *
+ * Unlike {@link ccnxCodecTlvDecoder_GetValue}, this does not allocate a buffer.  The returned
+ * pointer is into the decoder's underlying memory and is only valid while that memory is valid.
+ * If the decoder was created from an iovec and the bytes straddle two extents, they are copied
+ * and the pointer is valid until the decoder is destroyed.
+ *
+ * @param [in] decoder The TLV decoder object
+ * @param [in] length The number of bytes
+ *
+ * @return non-null A pointer to `length` bytes
+ * @return null There are fewer than `length` bytes remaining.  The position is not changed.
+ *
+ * Example:
+ * @code
+ * {
+ *      PARCBuffer *input = parcBuffer_Wrap((uint8_t[]) {0xAA, 0xBB, 0x00, 0x04, 0x01, 0x02, 0x03, 0x04}, 8, 0, 8);
+ *      CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(input);
+ *      unsigned type   = ccnxCodecTlvDecoder_GetType(decoder);
+ *      unsigned length = ccnxCodecTlvDecoder_GetLength(decoder);
+ *      const uint8_t *value = ccnxCodecTlvDecoder_GetArray(decoder, length);
+ *      // value points to 0x01020304
+ * }
+ * @endcode
+ */
+const uint8_t *ccnxCodecTlvDecoder_GetArray(CCNxCodecTlvDecoder *decoder, uint16_t length);
+
 /**
  * Ensure the current position is of type `type', then return a buffer of the value
  *
@@ -576,6 +707,30 @@ bool ccnxCodecTlvDecoder_GetUint64(CCNxCodecTlvDecoder *decoder, uint16_t type,
  */
 size_t ccnxCodecTlvDecoder_Position(CCNxCodecTlvDecoder *decoder);
 
+/**
+ * Move the decoder to a position previously returned by `ccnxCodecTlvDecoder_Position()`
+ *
+ * Lets a caller that reads ahead put the decoder back where it was, for example when the value turns out
+ * to be malformed.  If the position is past the end of the decoder, no action is taken.
+ *
+ * @param [in] decoder The decoder to move
+ * @param [in] position The new position, relative to the start of the decoder
+ *
+ * @return true The decoder is at `position`
+ * @return false Error, `position` is past the end of the decoder
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t start = ccnxCodecTlvDecoder_Position(decoder);
+ *     if (!_decodeSomething(decoder)) {
+ *         ccnxCodecTlvDecoder_SetPosition(decoder, start);
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxCodecTlvDecoder_SetPosition(CCNxCodecTlvDecoder *decoder, size_t position);
+
 /**
  * Advance the decoder a given number of bytes
  *
@@ -65,7 +65,9 @@
 #include <LongBow/runtime.h>
 #include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_Buffer.h>
+#include <parc/security/parc_CryptoHasher.h>
 #include <ccnx/common/codec/ccnxCodec_NetworkBuffer.h>
+#include <ccnx/common/codec/ccnxCodec_NetworkBufferPool.h>
 
 #include <ccnx/common/codec/ccnxCodec_TlvEncoder.h>
 
@@ -75,7 +77,10 @@
 #define BOTH_SET  3
 
 struct ccnx_codec_tlv_encoder {
+    // NULL for a measuring encoder, which only tracks position and limit
     CCNxCodecNetworkBuffer *buffer;
+    size_t position;
+    size_t limit;
 
     // OR of NONE_SET, START_SET, END_SET
     int signatureStartEndSet;
@@ -85,21 +90,75 @@ struct ccnx_codec_tlv_encoder {
 
     CCNxCodecError *error;
     PARCSigner *signer;
+
+    // The signer shapes the ValidationAlg, but the ValidationPayload is left for the caller to append
+    bool signatureDeferred;
+
+    // Non-NULL once the ContentObjectHash is enabled.  contentObjectHashed is the position up to
+    // which the hasher has been fed, or 0 if it has not been initialized yet.
+    PARCCryptoHasher *contentObjectHasher;
+    size_t contentObjectHashed;
 };
 
-CCNxCodecTlvEncoder *
-ccnxCodecTlvEncoder_Create(void)
+static CCNxCodecTlvEncoder *
+_ccnxCodecTlvEncoder_Create(CCNxCodecNetworkBuffer *buffer)
 {
     CCNxCodecTlvEncoder *encoder = parcMemory_AllocateAndClear(sizeof(CCNxCodecTlvEncoder));
     assertNotNull(encoder, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(CCNxCodecTlvEncoder));
 
-    encoder->buffer = ccnxCodecNetworkBuffer_Create(&ParcMemoryMemoryBlock, NULL);
+    encoder->buffer = buffer;
     encoder->signatureStartEndSet = NONE_SET;
     encoder->error = NULL;
 
     return encoder;
 }
 
+CCNxCodecTlvEncoder *
+ccnxCodecTlvEncoder_Create(void)
+{
+    CCNxCodecNetworkBufferPool *pool = ccnxCodecNetworkBufferPool_GetThreadPool();
+    if (pool != NULL) {
+        return _ccnxCodecTlvEncoder_Create(ccnxCodecNetworkBuffer_Create(&NetworkBufferPoolMemoryBlock, pool));
+    }
+    return _ccnxCodecTlvEncoder_Create(ccnxCodecNetworkBuffer_Create(&ParcMemoryMemoryBlock, NULL));
+}
+
+CCNxCodecTlvEncoder *
+ccnxCodecTlvEncoder_CreateWithCapacity(size_t capacity)
+{
+    CCNxCodecNetworkBufferPool *pool = ccnxCodecNetworkBufferPool_GetThreadPool();
+    if (pool != NULL) {
+        return _ccnxCodecTlvEncoder_Create(ccnxCodecNetworkBuffer_CreateWithCapacity(&NetworkBufferPoolMemoryBlock, pool, capacity));
+    }
+    return _ccnxCodecTlvEncoder_Create(ccnxCodecNetworkBuffer_CreateWithCapacity(&ParcMemoryMemoryBlock, NULL, capacity));
+}
+
+CCNxCodecTlvEncoder *
+ccnxCodecTlvEncoder_CreateMeasuring(void)
+{
+    return _ccnxCodecTlvEncoder_Create(NULL);
+}
+
+bool
+ccnxCodecTlvEncoder_IsMeasuring(const CCNxCodecTlvEncoder *encoder)
+{
+    assertNotNull(encoder, "Parameter encoder must be non-null");
+    return encoder->buffer == NULL;
+}
+
+/**
+ * Account for `length` bytes written by a measuring encoder
+ */
+static size_t
+_ccnxCodecTlvEncoder_Measure(CCNxCodecTlvEncoder *encoder, size_t length)
+{
+    encoder->position += length;
+    if (encoder->position > encoder->limit) {
+        encoder->limit = encoder->position;
+    }
+    return length;
+}
+
 void
 ccnxCodecTlvEncoder_Destroy(CCNxCodecTlvEncoder **encoderPtr)
 {
@@ -107,7 +166,9 @@ ccnxCodecTlvEncoder_Destroy(CCNxCodecTlvEncoder **encoderPtr)
     assertNotNull(*encoderPtr, "Parameter must dereferecne to non-null pointer");
     CCNxCodecTlvEncoder *encoder = *encoderPtr;
 
-    ccnxCodecNetworkBuffer_Release(&encoder->buffer);
+    if (encoder->buffer) {
+        ccnxCodecNetworkBuffer_Release(&encoder->buffer);
+    }
 
     if (encoder->error) {
         ccnxCodecError_Release(&encoder->error);
@@ -117,6 +178,10 @@ ccnxCodecTlvEncoder_Destroy(CCNxCodecTlvEncoder **encoderPtr)
         parcSigner_Release(&encoder->signer);
     }
 
+    if (encoder->contentObjectHasher) {
+        parcCryptoHasher_Release(&encoder->contentObjectHasher);
+    }
+
     parcMemory_Deallocate((void **) &encoder);
     *encoderPtr = NULL;
 }
@@ -135,6 +200,10 @@ ccnxCodecTlvEncoder_AppendBuffer(CCNxCodecTlvEncoder *encoder, uint16_t type, PA
     assertTrue(parcBuffer_Remaining(value) <= UINT16_MAX, "Value length too long, got %zu maximum %u\n", parcBuffer_Remaining(value), UINT16_MAX);
 
     size_t bytes = 4 + parcBuffer_Remaining(value);
+    if (encoder->buffer == NULL) {
+        return _ccnxCodecTlvEncoder_Measure(encoder, bytes);
+    }
+
     ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, type);
     ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, parcBuffer_Remaining(value));
     ccnxCodecNetworkBuffer_PutBuffer(encoder->buffer, value);
@@ -146,6 +215,10 @@ size_t
 ccnxCodecTlvEncoder_AppendArray(CCNxCodecTlvEncoder *encoder, uint16_t type, uint16_t length, const uint8_t array[length])
 {
     assertNotNull(encoder, "Parameter encoder must be non-null");
+    if (encoder->buffer == NULL) {
+        return _ccnxCodecTlvEncoder_Measure(encoder, length + 4);
+    }
+
     ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, type);
     ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, length);
     ccnxCodecNetworkBuffer_PutArray(encoder->buffer, length, array);
@@ -156,6 +229,9 @@ size_t
 ccnxCodecTlvEncoder_AppendContainer(CCNxCodecTlvEncoder *encoder, uint16_t type, uint16_t length)
 {
     assertNotNull(encoder, "Parameter encoder must be non-null");
+    if (encoder->buffer == NULL) {
+        return _ccnxCodecTlvEncoder_Measure(encoder, 4);
+    }
 
     ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, type);
     ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, length);
@@ -166,6 +242,10 @@ size_t
 ccnxCodecTlvEncoder_AppendUint8(CCNxCodecTlvEncoder *encoder, uint16_t type, uint8_t value)
 {
     assertNotNull(encoder, "Parameter encoder must be non-null");
+    if (encoder->buffer == NULL) {
+        return _ccnxCodecTlvEncoder_Measure(encoder, 5);
+    }
+
     ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, type);
     ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, 1);
     ccnxCodecNetworkBuffer_PutUint8(encoder->buffer, value);
@@ -176,6 +256,10 @@ size_t
 ccnxCodecTlvEncoder_AppendUint16(CCNxCodecTlvEncoder *encoder, uint16_t type, uint16_t value)
 {
     assertNotNull(encoder, "Parameter encoder must be non-null");
+    if (encoder->buffer == NULL) {
+        return _ccnxCodecTlvEncoder_Measure(encoder, 6);
+    }
+
     ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, type);
     ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, 2);
     ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, value);
@@ -186,6 +270,10 @@ size_t
 ccnxCodecTlvEncoder_AppendUint32(CCNxCodecTlvEncoder *encoder, uint16_t type, uint32_t value)
 {
     assertNotNull(encoder, "Parameter encoder must be non-null");
+    if (encoder->buffer == NULL) {
+        return _ccnxCodecTlvEncoder_Measure(encoder, 8);
+    }
+
     ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, type);
     ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, 4);
     ccnxCodecNetworkBuffer_PutUint32(encoder->buffer, value);
@@ -196,6 +284,10 @@ size_t
 ccnxCodecTlvEncoder_AppendUint64(CCNxCodecTlvEncoder *encoder, uint16_t type, uint64_t value)
 {
     assertNotNull(encoder, "Parameter encoder must be non-null");
+    if (encoder->buffer == NULL) {
+        return _ccnxCodecTlvEncoder_Measure(encoder, 12);
+    }
+
     ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, type);
     ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, 8);
     ccnxCodecNetworkBuffer_PutUint64(encoder->buffer, value);
@@ -231,6 +323,9 @@ ccnxCodecTlvEncoder_AppendVarInt(CCNxCodecTlvEncoder *encoder, uint16_t type, ui
     assertNotNull(encoder, "Parameter encoder must be non-null");
 
     unsigned length = _ccnxCodecTlvEncoder_ComputeVarIntLength(value);
+    if (encoder->buffer == NULL) {
+        return _ccnxCodecTlvEncoder_Measure(encoder, length + 4);
+    }
 
     ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, type);
     ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, length);
@@ -252,6 +347,9 @@ size_t
 ccnxCodecTlvEncoder_Position(CCNxCodecTlvEncoder *encoder)
 {
     assertNotNull(encoder, "Parameter encoder must be non-null");
+    if (encoder->buffer == NULL) {
+        return encoder->position;
+    }
     return ccnxCodecNetworkBuffer_Position(encoder->buffer);
 }
 
@@ -259,6 +357,12 @@ size_t
 ccnxCodecTlvEncoder_SetPosition(CCNxCodecTlvEncoder *encoder, size_t position)
 {
     assertNotNull(encoder, "Parameter encoder must be non-null");
+    if (encoder->buffer == NULL) {
+        assertTrue(position <= encoder->limit, "position beyond end of buffer, got %zu maximum %zu", position, encoder->limit);
+        encoder->position = position;
+        return position;
+    }
+
     assertTrue(position <= ccnxCodecNetworkBuffer_Limit(encoder->buffer),
                "position beyond end of buffer, got %zu maximum %zu",
                position, ccnxCodecNetworkBuffer_Limit(encoder->buffer));
@@ -270,6 +374,9 @@ void
 ccnxCodecTlvEncoder_SetContainerLength(CCNxCodecTlvEncoder *encoder, size_t offset, uint16_t length)
 {
     assertNotNull(encoder, "Parameter encoder must be non-null");
+    if (encoder->buffer == NULL) {
+        return;
+    }
 
     size_t currentPosition = ccnxCodecNetworkBuffer_Position(encoder->buffer);
 
@@ -288,6 +395,10 @@ ccnxCodecTlvEncoder_Finalize(CCNxCodecTlvEncoder *encoder)
     // set the limit to whatever our current possition is.  That will truncate the
     // packet in case we wrote beyond where we are now.
 
+    if (encoder->buffer == NULL) {
+        encoder->limit = encoder->position;
+        return;
+    }
     ccnxCodecNetworkBuffer_Finalize(encoder->buffer);
 }
 
@@ -295,6 +406,7 @@ PARCBuffer *
 ccnxCodecTlvEncoder_CreateBuffer(CCNxCodecTlvEncoder *encoder)
 {
     assertNotNull(encoder, "Parameter encoder must be non-null");
+    assertNotNull(encoder->buffer, "A measuring encoder has no output");
 
     PARCBuffer *output = ccnxCodecNetworkBuffer_CreateParcBuffer(encoder->buffer);
     return output;
@@ -304,6 +416,7 @@ CCNxCodecNetworkBufferIoVec *
 ccnxCodecTlvEncoder_CreateIoVec(CCNxCodecTlvEncoder *encoder)
 {
     assertNotNull(encoder, "Parameter encoder must be non-null");
+    assertNotNull(encoder->buffer, "A measuring encoder has no output");
     return ccnxCodecNetworkBuffer_CreateIoVec(encoder->buffer);
 }
 
@@ -311,6 +424,10 @@ size_t
 ccnxCodecTlvEncoder_AppendRawArray(CCNxCodecTlvEncoder *encoder, size_t length, uint8_t array[length])
 {
     assertNotNull(encoder, "Parameter encoder must be non-null");
+    if (encoder->buffer == NULL) {
+        return _ccnxCodecTlvEncoder_Measure(encoder, length);
+    }
+
     ccnxCodecNetworkBuffer_PutArray(encoder->buffer, length, array);
     return length;
 }
@@ -319,6 +436,10 @@ size_t
 ccnxCodecTlvEncoder_PutUint8(CCNxCodecTlvEncoder *encoder, size_t offset, uint8_t value)
 {
     assertNotNull(encoder, "Parameter encoder must be non-null");
+    if (encoder->buffer == NULL) {
+        return 1;
+    }
+
     size_t position = ccnxCodecNetworkBuffer_Position(encoder->buffer);
     ccnxCodecNetworkBuffer_SetPosition(encoder->buffer, offset);
     ccnxCodecNetworkBuffer_PutUint8(encoder->buffer, value);
@@ -330,6 +451,10 @@ size_t
 ccnxCodecTlvEncoder_PutUint16(CCNxCodecTlvEncoder *encoder, size_t offset, uint16_t value)
 {
     assertNotNull(encoder, "Parameter encoder must be non-null");
+    if (encoder->buffer == NULL) {
+        return 2;
+    }
+
     size_t position = ccnxCodecNetworkBuffer_Position(encoder->buffer);
     ccnxCodecNetworkBuffer_SetPosition(encoder->buffer, offset);
     ccnxCodecNetworkBuffer_PutUint16(encoder->buffer, value);
@@ -341,7 +466,7 @@ void
 ccnxCodecTlvEncoder_MarkSignatureStart(CCNxCodecTlvEncoder *encoder)
 {
     assertNotNull(encoder, "Parameter encoder must be non-null");
-    encoder->signatureStart = ccnxCodecNetworkBuffer_Position(encoder->buffer);
+    encoder->signatureStart = ccnxCodecTlvEncoder_Position(encoder);
     encoder->signatureStartEndSet |= START_SET;
 }
 
@@ -349,7 +474,7 @@ void
 ccnxCodecTlvEncoder_MarkSignatureEnd(CCNxCodecTlvEncoder *encoder)
 {
     assertNotNull(encoder, "Parameter encoder must be non-null");
-    encoder->signatureEnd = ccnxCodecNetworkBuffer_Position(encoder->buffer);
+    encoder->signatureEnd = ccnxCodecTlvEncoder_Position(encoder);
     encoder->signatureStartEndSet |= END_SET;
 }
 
@@ -358,8 +483,68 @@ ccnxCodecTlvEncoder_ComputeSignature(CCNxCodecTlvEncoder *encoder)
 {
     assertNotNull(encoder, "Parameter encoder must be non-null");
     assertTrue(encoder->signatureStartEndSet == BOTH_SET, "Did not set both start and end positions");
+    assertNotNull(encoder->buffer, "A measuring encoder cannot compute a signature");
+
+    if (encoder->contentObjectHasher == NULL || encoder->signer == NULL) {
+        return ccnxCodecNetworkBuffer_ComputeSignature(encoder->buffer, encoder->signatureStart, encoder->signatureEnd, encoder->signer);
+    }
+
+    // Walk the protected region once for both the signer's digest and the ContentObjectHash,
+    // which covers the same bytes and continues over the validation payload.
+    PARCCryptoHasher *hashers[2] = { parcSigner_GetCryptoHasher(encoder->signer), encoder->contentObjectHasher };
+    parcCryptoHasher_Init(hashers[0]);
+    parcCryptoHasher_Init(hashers[1]);
+    ccnxCodecNetworkBuffer_UpdateHashers(encoder->buffer, encoder->signatureStart, encoder->signatureEnd, 2, hashers);
+    encoder->contentObjectHashed = encoder->signatureEnd;
+
+    PARCCryptoHash *hash = parcCryptoHasher_Finalize(hashers[0]);
+    PARCSignature *signature = parcSigner_SignDigest(encoder->signer, hash);
+    parcCryptoHash_Release(&hash);
+    return signature;
+}
+
+void
+ccnxCodecTlvEncoder_EnableContentObjectHash(CCNxCodecTlvEncoder *encoder)
+{
+    assertNotNull(encoder, "Parameter encoder must be non-null");
+    if (encoder->contentObjectHasher == NULL) {
+        encoder->contentObjectHasher = parcCryptoHasher_Create(PARCCryptoHashType_SHA256);
+    }
+    encoder->contentObjectHashed = 0;
+}
 
-    return ccnxCodecNetworkBuffer_ComputeSignature(encoder->buffer, encoder->signatureStart, encoder->signatureEnd, encoder->signer);
+PARCCryptoHash *
+ccnxCodecTlvEncoder_FinalizeContentObjectHash(CCNxCodecTlvEncoder *encoder)
+{
+    assertNotNull(encoder, "Parameter encoder must be non-null");
+    assertNotNull(encoder->buffer, "A measuring encoder cannot compute a digest");
+
+    if (encoder->contentObjectHasher == NULL || (encoder->signatureStartEndSet & START_SET) == 0) {
+        return NULL;
+    }
+
+    size_t end = ccnxCodecTlvEncoder_Position(encoder);
+    if (encoder->contentObjectHashed == 0) {
+        // Nothing was signed, so no bytes have been hashed yet
+        parcCryptoHasher_Init(encoder->contentObjectHasher);
+        encoder->contentObjectHashed = encoder->signatureStart;
+    }
+
+    ccnxCodecNetworkBuffer_UpdateHashers(encoder->buffer, encoder->contentObjectHashed, end, 1, &encoder->contentObjectHasher);
+    encoder->contentObjectHashed = 0;
+    return parcCryptoHasher_Finalize(encoder->contentObjectHasher);
+}
+
+PARCCryptoHash *
+ccnxCodecTlvEncoder_ComputeDigest(CCNxCodecTlvEncoder *encoder, PARCCryptoHasher *hasher)
+{
+    assertNotNull(encoder, "Parameter encoder must be non-null");
+    assertNotNull(encoder->buffer, "A measuring encoder cannot compute a digest");
+
+    if (encoder->signatureStartEndSet != BOTH_SET) {
+        return NULL;
+    }
+    return ccnxCodecNetworkBuffer_ComputeDigest(encoder->buffer, encoder->signatureStart, encoder->signatureEnd, hasher);
 }
 
 bool
@@ -421,3 +606,17 @@ ccnxCodecTlvEncoder_GetSigner(const CCNxCodecTlvEncoder *encoder)
     return encoder->signer;
 }
 
+void
+ccnxCodecTlvEncoder_DeferSignature(CCNxCodecTlvEncoder *encoder)
+{
+    assertNotNull(encoder, "Parameter encoder must be non-null");
+    encoder->signatureDeferred = true;
+}
+
+bool
+ccnxCodecTlvEncoder_IsSignatureDeferred(const CCNxCodecTlvEncoder *encoder)
+{
+    assertNotNull(encoder, "Parameter encoder must be non-null");
+    return encoder->signatureDeferred;
+}
+
@@ -141,6 +141,9 @@ typedef struct ccnx_codec_tlv_encoder CCNxCodecTlvEncoder;
  *
  * The encoder is re-usable, as the state is reset for each Initialize.
  *
+ * If a pool is bound to the calling thread with {@link ccnxCodecNetworkBufferPool_SetThreadPool}, the
+ * encoder's network buffer takes its memory blocks from that pool, otherwise from parcMemory.
+ *
  * @return non-null A TLV encoder
  *
  * Example:
@@ -150,6 +153,69 @@ typedef struct ccnx_codec_tlv_encoder CCNxCodecTlvEncoder;
  */
 CCNxCodecTlvEncoder *ccnxCodecTlvEncoder_Create(void);
 
+/**
+ * Creates a TLV encoder whose first memory block holds `capacity` bytes
+ *
+ * If the encoded length is known, for example from a measuring encoder, an encoder created
+ * with that capacity writes the whole encoding into one contiguous memory block, so
+ * ccnxCodecTlvEncoder_CreateIoVec() returns a single iovec.  Like ccnxCodecTlvEncoder_Create(),
+ * it takes its memory from the pool bound to the calling thread, if any.
+ *
+ * @param [in] capacity The number of bytes to reserve for the encoding.
+ *
+ * @return non-null A TLV encoder
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_CreateWithCapacity(8192);
+ *     ccnxCodecTlvEncoder_Destroy(&encoder);
+ * }
+ * @endcode
+ */
+CCNxCodecTlvEncoder *ccnxCodecTlvEncoder_CreateWithCapacity(size_t capacity);
+
+/**
+ * Creates a measuring TLV encoder
+ *
+ * A measuring encoder accepts the same calls as any other encoder but writes nothing.
+ * It only tracks the position and limit, so running an encoding through it gives the
+ * exact encoded length, as returned by ccnxCodecTlvEncoder_Position() after ccnxCodecTlvEncoder_Finalize().
+ * It cannot produce output or compute a signature.
+ *
+ * @return non-null A measuring TLV encoder
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecTlvEncoder *sizer = ccnxCodecTlvEncoder_CreateMeasuring();
+ *     ccnxCodecTlvEncoder_AppendArray(sizer, 1, length, array);
+ *     size_t encodedLength = ccnxCodecTlvEncoder_Position(sizer);
+ *     ccnxCodecTlvEncoder_Destroy(&sizer);
+ * }
+ * @endcode
+ */
+CCNxCodecTlvEncoder *ccnxCodecTlvEncoder_CreateMeasuring(void);
+
+/**
+ * Determines if the encoder is a measuring encoder
+ *
+ * @param [in] encoder An allocated CCNxCodecTlvEncoder
+ *
+ * @return true The encoder was created with ccnxCodecTlvEncoder_CreateMeasuring() and writes nothing
+ * @return false The encoder writes to a network buffer
+ *
+ * Example:
+ * @code
+ * {
+ *     if (!ccnxCodecTlvEncoder_IsMeasuring(encoder)) {
+ *         PARCBuffer *buffer = ccnxCodecTlvEncoder_CreateBuffer(encoder);
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxCodecTlvEncoder_IsMeasuring(const CCNxCodecTlvEncoder *encoder);
+
 /**
  * Destroys the TLV encoder and all internal state
  *
@@ -608,6 +674,73 @@ void ccnxCodecTlvEncoder_MarkSignatureEnd(CCNxCodecTlvEncoder *encoder);
  */
 PARCSignature *ccnxCodecTlvEncoder_ComputeSignature(CCNxCodecTlvEncoder *encoder);
 
+/**
+ * Computes the digest of the designated area, which is what a signer signs.
+ *
+ * This lets the digest be computed on the encoding thread and the signature elsewhere.
+ *
+ * @param [in] encoder An allocated CCNxCodecTlvEncoder
+ * @param [in] hasher The PARCCryptoHasher to use, of the hash type the signer expects
+ *
+ * @retval non-null An allocated PARCCryptoHash
+ * @retval null Both a Start and End have not been set, so there is nothing to sign
+ *
+ * Example:
+ * @code
+ * {
+ *      PARCCryptoHasher *hasher = parcCryptoHasher_Create(PARCCryptoHashType_SHA256);
+ *      PARCCryptoHash *hash = ccnxCodecTlvEncoder_ComputeDigest(encoder, hasher);
+ *      PARCSignature *sig = parcSigner_SignDigest(signer, hash);
+ * }
+ * @endcode
+ */
+PARCCryptoHash *ccnxCodecTlvEncoder_ComputeDigest(CCNxCodecTlvEncoder *encoder, PARCCryptoHasher *hasher);
+
+/**
+ * Computes the ContentObjectHash of the packet while it is encoded.
+ *
+ * The ContentObjectHash is the SHA256 of everything from the signature start to the end of the packet,
+ * so it covers the signed bytes and then the validation payload.  Once enabled,
+ * ccnxCodecTlvEncoder_ComputeSignature() feeds the signed region to both the signer's hasher and the
+ * ContentObjectHash in one walk of the buffer, and ccnxCodecTlvEncoder_FinalizeContentObjectHash()
+ * only has to hash the bytes written after the signature end.
+ *
+ * @param [in] encoder An allocated CCNxCodecTlvEncoder
+ *
+ * Example:
+ * @code
+ * {
+ *      CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+ *      ccnxCodecTlvEncoder_SetSigner(encoder, signer);
+ *      ccnxCodecTlvEncoder_EnableContentObjectHash(encoder);
+ *      ccnxCodecSchemaV1PacketEncoder_Encode(encoder, packetDictionary);
+ *      PARCCryptoHash *hash = ccnxCodecTlvEncoder_FinalizeContentObjectHash(encoder);
+ * }
+ * @endcode
+ */
+void ccnxCodecTlvEncoder_EnableContentObjectHash(CCNxCodecTlvEncoder *encoder);
+
+/**
+ * Finishes the ContentObjectHash enabled by ccnxCodecTlvEncoder_EnableContentObjectHash().
+ *
+ * Hashes from where the signature left off (or from the signature start if nothing was signed)
+ * up to the current position, which should be the end of the packet.
+ *
+ * @param [in] encoder An allocated CCNxCodecTlvEncoder
+ *
+ * @retval non-null An allocated SHA256 PARCCryptoHash
+ * @retval null The hash was not enabled or the signature start was not set
+ *
+ * Example:
+ * @code
+ * {
+ *      PARCCryptoHash *hash = ccnxCodecTlvEncoder_FinalizeContentObjectHash(encoder);
+ *      parcCryptoHash_Release(&hash);
+ * }
+ * @endcode
+ */
+PARCCryptoHash *ccnxCodecTlvEncoder_FinalizeContentObjectHash(CCNxCodecTlvEncoder *encoder);
+
 /**
  * Puts a uint8_t at the specified position.
  *
@@ -768,6 +901,49 @@ void ccnxCodecTlvEncoder_SetSigner(CCNxCodecTlvEncoder *encoder, PARCSigner *sig
  */
 PARCSigner *ccnxCodecTlvEncoder_GetSigner(const CCNxCodecTlvEncoder *encoder);
 
+/**
+ * Leave the signature for the caller to compute
+ *
+ * The encoder's signer is still used to fill in the ValidationAlg (the crypto suite deduced from the
+ * signer and the signing time), but the packet encoder does not sign and ends the packet after the
+ * ValidationAlg.  The caller computes the digest with ccnxCodecTlvEncoder_ComputeDigest(), signs it,
+ * possibly on another thread, and appends the signature with
+ * ccnxCodecSchemaV1PacketEncoder_AppendValidationPayload().
+ *
+ * @param [in] encoder An allocated CCNxCodecTlvEncoder
+ *
+ * Example:
+ * @code
+ * {
+ *      CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+ *      ccnxCodecTlvEncoder_SetSigner(encoder, signer);
+ *      ccnxCodecTlvEncoder_DeferSignature(encoder);
+ *      ccnxCodecSchemaV1PacketEncoder_Encode(encoder, packet);
+ *      PARCCryptoHash *hash = ccnxCodecTlvEncoder_ComputeDigest(encoder, hasher);
+ * }
+ * @endcode
+ */
+void ccnxCodecTlvEncoder_DeferSignature(CCNxCodecTlvEncoder *encoder);
+
+/**
+ * Determines if the signature is left for the caller to compute
+ *
+ * @param [in] encoder An allocated CCNxCodecTlvEncoder
+ *
+ * @return true ccnxCodecTlvEncoder_DeferSignature() was called on the encoder
+ * @return false The packet encoder signs with the encoder's signer, if it has one
+ *
+ * Example:
+ * @code
+ * {
+ *      if (!ccnxCodecTlvEncoder_IsSignatureDeferred(encoder)) {
+ *          PARCSignature *signature = ccnxCodecTlvEncoder_ComputeSignature(encoder);
+ *      }
+ * }
+ * @endcode
+ */
+bool ccnxCodecTlvEncoder_IsSignatureDeferred(const CCNxCodecTlvEncoder *encoder);
+
 /**
  * Appends a TLV container holding the value as a VarInt
  *
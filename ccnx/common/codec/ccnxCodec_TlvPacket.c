@@ -59,23 +59,31 @@
 
 #include <config.h>
 #include <stdio.h>
+#include <string.h>
 #include <LongBow/runtime.h>
 #include <arpa/inet.h>
 #include <ccnx/common/codec/ccnxCodec_TlvPacket.h>
 #include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_Types.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_TlvDictionary.h>
 
 #include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_PacketDecoder.h>
 #include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_PacketEncoder.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_StructureValidator.h>
 
 #include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_FixedHeader.h>
 
+// Bytes of the next packet to prefetch while decoding the current one in a batch.
+// Two cache lines cover the fixed header and the start of the per-hop headers or message.
+#define _ccnxCodecTlvPacket_PrefetchLength 128
+
+/*
+ * Create an empty dictionary of the right message type, or NULL for unsupported packet types.
+ */
 static CCNxTlvDictionary *
-_decodeV1(PARCBuffer *packetBuffer)
+_ccnxCodecTlvPacket_CreateDictionaryV1(CCNxCodecSchemaV1Types_PacketType packetType)
 {
     CCNxTlvDictionary *packetDictionary = NULL;
 
-    CCNxCodecSchemaV1Types_PacketType packetType = (CCNxCodecSchemaV1Types_PacketType) parcBuffer_GetAtIndex(packetBuffer, 1);
-
     switch (packetType) {
         case CCNxCodecSchemaV1Types_PacketType_Interest:
             packetDictionary = ccnxCodecSchemaV1TlvDictionary_CreateInterest();
@@ -98,6 +106,15 @@ _decodeV1(PARCBuffer *packetBuffer)
             break;
     }
 
+    return packetDictionary;
+}
+
+static CCNxTlvDictionary *
+_decodeV1(PARCBuffer *packetBuffer)
+{
+    CCNxCodecSchemaV1Types_PacketType packetType = (CCNxCodecSchemaV1Types_PacketType) parcBuffer_GetAtIndex(packetBuffer, 1);
+    CCNxTlvDictionary *packetDictionary = _ccnxCodecTlvPacket_CreateDictionaryV1(packetType);
+
     if (packetDictionary) {
         // The packetBuffer may be padded or have extraneous content after the CCNx message.
         // Ensure that the buffer limit reflects the CCNx packet length as the decoder uses
@@ -113,15 +130,35 @@ _decodeV1(PARCBuffer *packetBuffer)
     return packetDictionary;
 }
 
+CCNxCodecErrorCodes
+ccnxCodecTlvPacket_Validate(PARCBuffer *packetBuffer, size_t *errorOffset)
+{
+    size_t available = parcBuffer_Remaining(packetBuffer);
+    const uint8_t *packet = parcBuffer_Overlay(packetBuffer, 0);
+    return ccnxCodecSchemaV1StructureValidator_Validate(available, packet, errorOffset);
+}
+
 CCNxTlvDictionary *
 ccnxCodecTlvPacket_Decode(PARCBuffer *packetBuffer)
 {
+    if (ccnxCodecTlvPacket_Validate(packetBuffer, NULL) != TLV_ERR_NO_ERROR) {
+        return NULL;
+    }
     return _decodeV1(packetBuffer);
 }
 
-bool
-ccnxCodecTlvPacket_BufferDecode(PARCBuffer *packetBuffer, CCNxTlvDictionary *packetDictionary)
+/*
+ * Decode with `v1Decoder` if the buffer holds a V1 packet.
+ */
+static bool
+_ccnxCodecTlvPacket_BufferDecode(PARCBuffer *packetBuffer, CCNxTlvDictionary *packetDictionary,
+                                 bool (*v1Decoder)(PARCBuffer *packetBuffer, CCNxTlvDictionary *packetDictionary))
 {
+    // Reject a malformed packet before the decoder allocates anything for it
+    if (ccnxCodecTlvPacket_Validate(packetBuffer, NULL) != TLV_ERR_NO_ERROR) {
+        return false;
+    }
+
     // Determine the version from the first byte of the buffer
     uint8_t version = parcBuffer_GetAtIndex(packetBuffer, 0);
 
@@ -135,7 +172,7 @@ ccnxCodecTlvPacket_BufferDecode(PARCBuffer *packetBuffer, CCNxTlvDictionary *pac
     bool success = false;
     switch (version) {
         case CCNxTlvDictionary_SchemaVersion_V1:
-            success = ccnxCodecSchemaV1PacketDecoder_BufferDecode(packetBuffer, packetDictionary);
+            success = v1Decoder(packetBuffer, packetDictionary);
             break;
 
         default:
@@ -146,41 +183,317 @@ ccnxCodecTlvPacket_BufferDecode(PARCBuffer *packetBuffer, CCNxTlvDictionary *pac
     return success;
 }
 
+bool
+ccnxCodecTlvPacket_BufferDecode(PARCBuffer *packetBuffer, CCNxTlvDictionary *packetDictionary)
+{
+    return _ccnxCodecTlvPacket_BufferDecode(packetBuffer, packetDictionary, ccnxCodecSchemaV1PacketDecoder_BufferDecode);
+}
+
+bool
+ccnxCodecTlvPacket_ArenaDecode(PARCBuffer *packetBuffer, CCNxTlvDictionary *packetDictionary)
+{
+    return _ccnxCodecTlvPacket_BufferDecode(packetBuffer, packetDictionary, ccnxCodecSchemaV1PacketDecoder_ArenaDecode);
+}
+
+bool
+ccnxCodecTlvPacket_LazyDecode(PARCBuffer *packetBuffer, CCNxTlvDictionary *packetDictionary)
+{
+    return _ccnxCodecTlvPacket_BufferDecode(packetBuffer, packetDictionary, ccnxCodecSchemaV1PacketDecoder_LazyDecode);
+}
+
 /*
- * We don't have an iovec based decoder yet, so linearize the memory and use a PARCBuffer
- * See case 903.
+ * Linearize the memory and decode it from a PARCBuffer.
  */
-bool
-ccnxCodecTlvPacket_IoVecDecode(CCNxCodecNetworkBufferIoVec *vec, CCNxTlvDictionary *packetDictionary)
+static bool
+_ccnxCodecTlvPacket_LinearizedIoVecDecode(CCNxCodecNetworkBufferIoVec *vec, CCNxTlvDictionary *packetDictionary)
+{
+    size_t iovcnt = ccnxCodecNetworkBufferIoVec_GetCount(vec);
+    const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+
+    // figure out total size, then linearize it
+    size_t totalbytes = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        totalbytes += array[i].iov_len;
+    }
+
+    PARCBuffer *buffer = parcBuffer_Allocate(totalbytes);
+    for (int i = 0; i < iovcnt; i++) {
+        parcBuffer_PutArray(buffer, array[i].iov_len, array[i].iov_base);
+    }
+
+    parcBuffer_Flip(buffer);
+
+    bool success = ccnxCodecTlvPacket_BufferDecode(buffer, packetDictionary);
+    parcBuffer_Release(&buffer);
+    return success;
+}
+
+/*
+ * Copy the first `length` bytes of the iovec, which may span several extents.
+ */
+static bool
+_ccnxCodecTlvPacket_IoVecPeek(CCNxCodecNetworkBufferIoVec *vec, size_t length, uint8_t output[length])
 {
     size_t iovcnt = ccnxCodecNetworkBufferIoVec_GetCount(vec);
     const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(vec);
 
-    PARCBuffer *buffer = NULL;
-    if (iovcnt == 1) {
-        buffer = parcBuffer_Wrap(array[0].iov_base, array[0].iov_len, 0, array[0].iov_len);
-    } else if (iovcnt > 1) {
-        // figure out total size, then linearize it
-        size_t totalbytes = 0;
-        for (int i = 0; i < iovcnt; i++) {
-            totalbytes += array[i].iov_len;
+    size_t copied = 0;
+    for (int i = 0; i < iovcnt && copied < length; i++) {
+        size_t count = (length - copied < array[i].iov_len) ? length - copied : array[i].iov_len;
+        memcpy(&output[copied], array[i].iov_base, count);
+        copied += count;
+    }
+    return copied == length;
+}
+
+/*
+ * Check the structure of a packet held in an iovec.  The validator needs contiguous memory, so a packet
+ * split over several extents is left to the decoder to check.
+ */
+static CCNxCodecErrorCodes
+_ccnxCodecTlvPacket_IoVecValidate(CCNxCodecNetworkBufferIoVec *vec)
+{
+    CCNxCodecErrorCodes code = TLV_ERR_NO_ERROR;
+    if (ccnxCodecNetworkBufferIoVec_GetCount(vec) == 1) {
+        const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+        code = ccnxCodecSchemaV1StructureValidator_Validate(array[0].iov_len, array[0].iov_base, NULL);
+    }
+    return code;
+}
+
+/*
+ * The decoder reads the iovec in place, so values in the dictionary may be slices of the iovec memory.
+ * The dictionary keeps a reference to the iovec as its wire format so that memory outlives it.
+ * If the dictionary already holds a different wire format, fall back to decoding a linearized copy.
+ */
+bool
+ccnxCodecTlvPacket_IoVecDecode(CCNxCodecNetworkBufferIoVec *vec, CCNxTlvDictionary *packetDictionary)
+{
+    if (ccnxCodecNetworkBufferIoVec_GetCount(vec) < 1) {
+        return false;
+    }
+
+    if (_ccnxCodecTlvPacket_IoVecValidate(vec) != TLV_ERR_NO_ERROR) {
+        return false;
+    }
+
+    uint32_t wireFormatKey = CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_WireFormat;
+    if (ccnxTlvDictionary_GetIoVec(packetDictionary, wireFormatKey) != vec) {
+        if (!ccnxTlvDictionary_PutIoVec(packetDictionary, wireFormatKey, vec)) {
+            return _ccnxCodecTlvPacket_LinearizedIoVecDecode(vec, packetDictionary);
+        }
+    }
+
+    CCNxCodecSchemaV1FixedHeader header;
+    if (!_ccnxCodecTlvPacket_IoVecPeek(vec, sizeof(header), (uint8_t *) &header)) {
+        return false;
+    }
+
+    bool success = false;
+    switch (header.version) {
+        case CCNxTlvDictionary_SchemaVersion_V1: {
+            CCNxCodecTlvDecoder *vecDecoder = ccnxCodecTlvDecoder_CreateFromIoVec(vec);
+
+            // The iovec may be padded or have extraneous content after the CCNx message.
+            // The decoder uses its limit, not the packetLength from the header, to determine when to stop parsing.
+            size_t packetLength = htons(header.packetLength);
+            assertTrue(packetLength <= ccnxCodecTlvDecoder_Remaining(vecDecoder), "Short packet iovec");
+            CCNxCodecTlvDecoder *packetDecoder = ccnxCodecTlvDecoder_GetContainer(vecDecoder, packetLength);
+
+            success = ccnxCodecSchemaV1PacketDecoder_Decode(packetDecoder, packetDictionary);
+
+            ccnxCodecTlvDecoder_Destroy(&packetDecoder);
+            ccnxCodecTlvDecoder_Destroy(&vecDecoder);
+            break;
         }
 
-        buffer = parcBuffer_Allocate(totalbytes);
-        for (int i = 0; i < iovcnt; i++) {
-            parcBuffer_PutArray(buffer, array[i].iov_len, array[i].iov_base);
+        default:
+            // will return false
+            break;
+    }
+
+    return success;
+}
+
+static inline void
+_ccnxCodecTlvPacket_Prefetch(const void *memory)
+{
+    if (memory != NULL) {
+        for (size_t offset = 0; offset < _ccnxCodecTlvPacket_PrefetchLength; offset += 64) {
+            __builtin_prefetch((const uint8_t *) memory + offset, 0, 3);
         }
+    }
+}
+
+/*
+ * Check the fixed header of a packet with `available` bytes and create its empty dictionary.
+ * Returns TLV_ERR_NO_ERROR and sets `packetDictionaryPtr`, or returns the reason the packet cannot be decoded.
+ */
+static CCNxCodecErrorCodes
+_ccnxCodecTlvPacket_BatchPrepare(const CCNxCodecSchemaV1FixedHeader *header, size_t available,
+                                 CCNxTlvDictionary **packetDictionaryPtr)
+{
+    *packetDictionaryPtr = NULL;
+
+    if (available < sizeof(CCNxCodecSchemaV1FixedHeader)) {
+        return TLV_ERR_PACKETLENGTH_TOO_SHORT;
+    }
+
+    if (header->version != CCNxTlvDictionary_SchemaVersion_V1) {
+        return TLV_ERR_VERSION;
+    }
+
+    size_t packetLength = htons(header->packetLength);
+    if (packetLength < sizeof(CCNxCodecSchemaV1FixedHeader)) {
+        return TLV_ERR_PACKETLENGTH_TOO_SHORT;
+    }
+
+    if (packetLength > available) {
+        return TLV_ERR_BEYOND_PACKET_END;
+    }
 
-        parcBuffer_Flip(buffer);
+    *packetDictionaryPtr = _ccnxCodecTlvPacket_CreateDictionaryV1((CCNxCodecSchemaV1Types_PacketType) header->packetType);
+    if (*packetDictionaryPtr == NULL) {
+        return TLV_ERR_PACKETTYPE;
+    }
+
+    return TLV_ERR_NO_ERROR;
+}
+
+/*
+ * Decode one packet and record its outcome.  On failure the dictionary is released.
+ * On success the dictionary takes a reference to the packet's arena.
+ */
+static bool
+_ccnxCodecTlvPacket_BatchFinish(CCNxCodecTlvDecoder *packetDecoder, CCNxCodecArena *arena,
+                                CCNxTlvDictionary **packetDictionaryPtr, CCNxCodecErrorCodes *status)
+{
+    bool success = ccnxCodecSchemaV1PacketDecoder_Decode(packetDecoder, *packetDictionaryPtr);
+
+    CCNxCodecErrorCodes code = TLV_ERR_NO_ERROR;
+    if (success) {
+        ccnxTlvDictionary_SetArena(*packetDictionaryPtr, arena);
     } else {
-        return false;
+        CCNxCodecError *error = ccnxCodecTlvDecoder_GetError(packetDecoder);
+        code = (error != NULL) ? ccnxCodecError_GetErrorCode(error) : TLV_ERR_DECODE;
+        ccnxTlvDictionary_Release(packetDictionaryPtr);
     }
 
-    bool success = ccnxCodecTlvPacket_BufferDecode(buffer, packetDictionary);
-    parcBuffer_Release(&buffer);
+    if (status != NULL) {
+        *status = code;
+    }
     return success;
 }
 
+size_t
+ccnxCodecTlvPacket_DecodeBatch(size_t count, PARCBuffer *packetBuffers[count],
+                               CCNxTlvDictionary *packetDictionaries[count], CCNxCodecErrorCodes status[count])
+{
+    if (count > 0) {
+        _ccnxCodecTlvPacket_Prefetch(parcBuffer_Overlay(packetBuffers[0], 0));
+    }
+
+    size_t decoded = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (i + 1 < count) {
+            _ccnxCodecTlvPacket_Prefetch(parcBuffer_Overlay(packetBuffers[i + 1], 0));
+        }
+
+        PARCBuffer *packetBuffer = packetBuffers[i];
+        size_t available = parcBuffer_Remaining(packetBuffer);
+        const CCNxCodecSchemaV1FixedHeader *header = parcBuffer_Overlay(packetBuffer, 0);
+
+        // A malformed packet costs one pass over its bytes, not a partial decode
+        packetDictionaries[i] = NULL;
+        CCNxCodecErrorCodes code = ccnxCodecSchemaV1StructureValidator_Validate(available, (const uint8_t *) header, NULL);
+        if (code == TLV_ERR_NO_ERROR) {
+            code = _ccnxCodecTlvPacket_BatchPrepare(header, available, &packetDictionaries[i]);
+        }
+        if (code != TLV_ERR_NO_ERROR) {
+            if (status != NULL) {
+                status[i] = code;
+            }
+            continue;
+        }
+
+        // The buffer may be padded or have extraneous content after the CCNx message.
+        size_t packetLength = htons(header->packetLength);
+        parcBuffer_SetLimit(packetBuffer, parcBuffer_Position(packetBuffer) + packetLength);
+
+        // Each packet gets its own arena, so a dictionary kept for a long time, such as one in a
+        // content store, holds only its own packet's memory and references, not the whole burst.
+        CCNxCodecArena *arena = ccnxCodecArena_Create();
+        CCNxCodecTlvDecoder *packetDecoder = ccnxCodecTlvDecoder_CreateWithArena(packetBuffer, arena);
+        if (_ccnxCodecTlvPacket_BatchFinish(packetDecoder, arena, &packetDictionaries[i], (status != NULL) ? &status[i] : NULL)) {
+            decoded++;
+        }
+        ccnxCodecTlvDecoder_Destroy(&packetDecoder);
+        ccnxCodecArena_Release(&arena);
+    }
+
+    return decoded;
+}
+
+static const void *
+_ccnxCodecTlvPacket_IoVecFirstByte(CCNxCodecNetworkBufferIoVec *vec)
+{
+    const void *memory = NULL;
+    if (ccnxCodecNetworkBufferIoVec_GetCount(vec) > 0) {
+        memory = ccnxCodecNetworkBufferIoVec_GetArray(vec)[0].iov_base;
+    }
+    return memory;
+}
+
+size_t
+ccnxCodecTlvPacket_IoVecDecodeBatch(size_t count, CCNxCodecNetworkBufferIoVec *vecs[count],
+                                    CCNxTlvDictionary *packetDictionaries[count], CCNxCodecErrorCodes status[count])
+{
+    if (count > 0) {
+        _ccnxCodecTlvPacket_Prefetch(_ccnxCodecTlvPacket_IoVecFirstByte(vecs[0]));
+    }
+
+    size_t decoded = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (i + 1 < count) {
+            _ccnxCodecTlvPacket_Prefetch(_ccnxCodecTlvPacket_IoVecFirstByte(vecs[i + 1]));
+        }
+
+        CCNxCodecNetworkBufferIoVec *vec = vecs[i];
+        size_t available = ccnxCodecNetworkBufferIoVec_Length(vec);
+        CCNxCodecSchemaV1FixedHeader header;
+        if (!_ccnxCodecTlvPacket_IoVecPeek(vec, sizeof(header), (uint8_t *) &header)) {
+            available = 0;
+        }
+
+        packetDictionaries[i] = NULL;
+        CCNxCodecErrorCodes code = _ccnxCodecTlvPacket_IoVecValidate(vec);
+        if (code == TLV_ERR_NO_ERROR) {
+            code = _ccnxCodecTlvPacket_BatchPrepare(&header, available, &packetDictionaries[i]);
+        }
+        if (code != TLV_ERR_NO_ERROR) {
+            if (status != NULL) {
+                status[i] = code;
+            }
+            continue;
+        }
+
+        // Values decoded in place may be slices of the iovec memory, so the dictionary keeps the iovec.
+        ccnxTlvDictionary_PutIoVec(packetDictionaries[i], CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_WireFormat, vec);
+
+        CCNxCodecArena *arena = ccnxCodecArena_Create();
+        CCNxCodecTlvDecoder *vecDecoder = ccnxCodecTlvDecoder_CreateFromIoVecWithArena(vec, arena);
+        CCNxCodecTlvDecoder *packetDecoder = ccnxCodecTlvDecoder_GetContainer(vecDecoder, htons(header.packetLength));
+        if (_ccnxCodecTlvPacket_BatchFinish(packetDecoder, arena, &packetDictionaries[i], (status != NULL) ? &status[i] : NULL)) {
+            decoded++;
+        }
+        ccnxCodecTlvDecoder_Destroy(&packetDecoder);
+        ccnxCodecTlvDecoder_Destroy(&vecDecoder);
+        ccnxCodecArena_Release(&arena);
+    }
+
+    return decoded;
+}
+
 CCNxCodecNetworkBufferIoVec *
 ccnxCodecTlvPacket_DictionaryEncode(CCNxTlvDictionary *packetDictionary, PARCSigner *signer)
 {
@@ -199,6 +512,27 @@ ccnxCodecTlvPacket_DictionaryEncode(CCNxTlvDictionary *packetDictionary, PARCSig
     return iovec;
 }
 
+CCNxCodecNetworkBufferIoVec *
+ccnxCodecTlvPacket_DictionaryEncodeAndSign(CCNxTlvDictionary *packetDictionary, PARCSigner *signer, PARCCryptoHash **contentObjectHashPtr)
+{
+    assertNotNull(contentObjectHashPtr, "Parameter contentObjectHashPtr must be non-null");
+    *contentObjectHashPtr = NULL;
+
+    CCNxTlvDictionary_SchemaVersion version = ccnxTlvDictionary_GetSchemaVersion(packetDictionary);
+
+    CCNxCodecNetworkBufferIoVec *iovec = NULL;
+    switch (version) {
+        case CCNxTlvDictionary_SchemaVersion_V1:
+            iovec = ccnxCodecSchemaV1PacketEncoder_DictionaryEncodeAndSign(packetDictionary, signer, contentObjectHashPtr);
+            break;
+
+        default:
+            // will return NULL
+            break;
+    }
+    return iovec;
+}
+
 size_t
 ccnxCodecTlvPacket_GetPacketLength(PARCBuffer *packetBuffer)
 {
@@ -67,11 +67,44 @@
 
 #include <parc/algol/parc_Buffer.h>
 #include <parc/security/parc_Signer.h>
+#include <parc/security/parc_CryptoHash.h>
 
 #include <ccnx/common/codec/ccnxCodec_NetworkBuffer.h>
+#include <ccnx/common/codec/ccnxCodec_ErrorCodes.h>
 
 #include <ccnx/common/internal/ccnx_TlvDictionary.h>
 
+/**
+ * Check the TLV structure of a packet without decoding it
+ *
+ * Makes one pass over the packet in place and allocates nothing.  See
+ * `ccnxCodecSchemaV1StructureValidator_Validate` for the checks made and the error codes returned.
+ * The decode functions in this file call it first, so a malformed packet is rejected before any
+ * decoder or dictionary entry is created for it.  A packet in an iovec is only checked when the
+ * iovec has a single extent.
+ *
+ * The buffer must point to byte 0 of the FixedHeader.  It may extend beyond the
+ * end of the packet.  The buffer's position is not changed.
+ *
+ * @param [in] packetBuffer The wire format representation of a packet
+ * @param [out] errorOffset If not NULL, set to the offset from the buffer position of the first error
+ *
+ * @retval TLV_ERR_NO_ERROR The packet is structurally sound
+ * @retval other The first structural error found
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t errorOffset;
+ *     CCNxCodecErrorCodes code = ccnxCodecTlvPacket_Validate(packetBuffer, &errorOffset);
+ *     if (code != TLV_ERR_NO_ERROR) {
+ *         printf("Dropping packet: %s at byte %zu\n", ccnxCodecError_ErrorMessage(code), errorOffset);
+ *     }
+ * }
+ * @endcode
+ */
+CCNxCodecErrorCodes ccnxCodecTlvPacket_Validate(PARCBuffer *packetBuffer, size_t *errorOffset);
+
 /**
  * Decodes a packet in to a dictionary
  *
@@ -107,21 +140,144 @@ CCNxTlvDictionary *ccnxCodecTlvPacket_Decode(PARCBuffer *packetBuffer);
 bool ccnxCodecTlvPacket_BufferDecode(PARCBuffer *packetBuffer, CCNxTlvDictionary *packetDictionary);
 
 /**
- * <#One Line Description#>
+ * Decode a packet buffer into a dictionary, keeping the decode state in a per-packet arena
  *
- * <#Paragraphs Of Explanation#>
+ * Same as {@link ccnxCodecTlvPacket_BufferDecode}, but the decoders are allocated from a `CCNxCodecArena`
+ * owned by the dictionary, so they cost one allocation per packet and are freed with the dictionary.
  *
- * @param [<#in out in,out#>] <#name#> <#description#>
+ * @param [in] packetBuffer The wire format representation of a packet
+ * @param [in] packetDictionary The dictionary to decode into.
  *
- * @retval <#value#> <#explanation#>
+ * @retval true The packet was decoded
+ * @retval false A decoding error, or an unsupported schema version
  *
  * Example:
  * @code
- * <#example#>
+ * {
+ *     CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateInterest();
+ *     bool success = ccnxCodecTlvPacket_ArenaDecode(packetBuffer, dictionary);
+ *     ccnxTlvDictionary_Release(&dictionary);
+ * }
+ * @endcode
+ */
+bool ccnxCodecTlvPacket_ArenaDecode(PARCBuffer *packetBuffer, CCNxTlvDictionary *packetDictionary);
+
+/**
+ * Decode a packet buffer into a dictionary, leaving each section to be decoded when it is first used
+ *
+ * Same as {@link ccnxCodecTlvPacket_BufferDecode}, but only the fixed header and the outer containers are
+ * decoded now.  See `ccnxCodecSchemaV1PacketDecoder_LazyDecode` for when the rest is decoded.
+ *
+ * A section is decoded into the dictionary by whichever getter first touches it, without any locking.
+ * The dictionary must therefore not be shared with another thread until {@link ccnxTlvDictionary_LazyDecodeAll}
+ * has run on it, or it must only ever be read by one thread at a time.
+ *
+ * @param [in] packetBuffer The wire format representation of a packet
+ * @param [in] packetDictionary The dictionary to decode into.
+ *
+ * @retval true The outer containers of the packet were decoded
+ * @retval false A decoding error, or an unsupported schema version
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateContentObject();
+ *     bool success = ccnxCodecTlvPacket_LazyDecode(packetBuffer, dictionary);
+ *     ccnxTlvDictionary_Release(&dictionary);
+ * }
+ * @endcode
+ */
+bool ccnxCodecTlvPacket_LazyDecode(PARCBuffer *packetBuffer, CCNxTlvDictionary *packetDictionary);
+
+/**
+ * Decode a packet held in a `CCNxCodecNetworkBufferIoVec` into a dictionary
+ *
+ * The iovec is decoded in place, without first copying it into one buffer.  Values in the
+ * dictionary may be slices of the iovec memory, so the iovec is stored in the dictionary as its
+ * wire format (if it is not there already) and lives as long as the dictionary.  If the dictionary
+ * already holds a different wire format, a linearized copy of the iovec is decoded instead.
+ *
+ * @param [in] vec The packet to decode.
+ * @param [in] packetDictionary The dictionary to decode into.
+ *
+ * @retval true The packet was decoded
+ * @retval false A decoding error, or an unsupported schema version
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecNetworkBufferIoVec *vec = ccnxCodecNetworkBuffer_CreateIoVec(netbuff);
+ *     CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateInterest();
+ *     bool success = ccnxCodecTlvPacket_IoVecDecode(vec, dictionary);
+ *     ccnxCodecNetworkBufferIoVec_Release(&vec);
+ * }
  * @endcode
  */
 bool ccnxCodecTlvPacket_IoVecDecode(CCNxCodecNetworkBufferIoVec *vec, CCNxTlvDictionary *packetDictionary);
 
+/**
+ * Decode a burst of packets, such as those received by one `recvmmsg` call
+ *
+ * Each buffer must point to byte 0 of the FixedHeader of one packet and may extend beyond the end
+ * of the packet.  For each packet, a dictionary of the right message type is created and filled in.
+ *
+ * Each packet is decoded with its own `CCNxCodecArena` (see {@link ccnxCodecTlvPacket_ArenaDecode}), so the
+ * decoder state of a packet costs about one allocation.  A decoded dictionary holds a reference to its own arena
+ * only, so keeping one dictionary does not keep the rest of the burst.  While one packet is decoded, the headers
+ * of the next are prefetched.
+ *
+ * Unlike {@link ccnxCodecTlvPacket_Decode}, a packet that is shorter than its header says is reported
+ * in @p status rather than trapped.
+ *
+ * @param [in] count The number of packets.
+ * @param [in] packetBuffers The packets.  Their limits are set to the end of each packet.
+ * @param [out] packetDictionaries Set to the decoded dictionaries, or NULL for packets that failed to decode.
+ * @param [out] status If not NULL, set to TLV_ERR_NO_ERROR for each decoded packet, or to the reason it failed.
+ *
+ * @return The number of packets decoded.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxTlvDictionary *dictionaries[count];
+ *     CCNxCodecErrorCodes status[count];
+ *     size_t decoded = ccnxCodecTlvPacket_DecodeBatch(count, buffers, dictionaries, status);
+ *     for (size_t i = 0; i < count; i++) {
+ *         if (dictionaries[i] != NULL) {
+ *             // ... process, then release
+ *             ccnxTlvDictionary_Release(&dictionaries[i]);
+ *         }
+ *     }
+ * }
+ * @endcode
+ */
+size_t ccnxCodecTlvPacket_DecodeBatch(size_t count, PARCBuffer *packetBuffers[count],
+                                      CCNxTlvDictionary *packetDictionaries[count], CCNxCodecErrorCodes status[count]);
+
+/**
+ * Decode a burst of packets held in iovecs
+ *
+ * The iovec version of {@link ccnxCodecTlvPacket_DecodeBatch}.  Each iovec is decoded in place as by
+ * {@link ccnxCodecTlvPacket_IoVecDecode} and is stored in its dictionary as the wire format.
+ *
+ * @param [in] count The number of packets.
+ * @param [in] vecs The packets.
+ * @param [out] packetDictionaries Set to the decoded dictionaries, or NULL for packets that failed to decode.
+ * @param [out] status If not NULL, set to TLV_ERR_NO_ERROR for each decoded packet, or to the reason it failed.
+ *
+ * @return The number of packets decoded.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxTlvDictionary *dictionaries[count];
+ *     size_t decoded = ccnxCodecTlvPacket_IoVecDecodeBatch(count, vecs, dictionaries, NULL);
+ * }
+ * @endcode
+ */
+size_t ccnxCodecTlvPacket_IoVecDecodeBatch(size_t count, CCNxCodecNetworkBufferIoVec *vecs[count],
+                                           CCNxTlvDictionary *packetDictionaries[count], CCNxCodecErrorCodes status[count]);
+
 
 /**
  * Encode the packetDictionary to wire format
@@ -148,6 +304,37 @@ bool ccnxCodecTlvPacket_IoVecDecode(CCNxCodecNetworkBufferIoVec *vec, CCNxTlvDic
  */
 CCNxCodecNetworkBufferIoVec *ccnxCodecTlvPacket_DictionaryEncode(CCNxTlvDictionary *packetDictionary, PARCSigner *signer);
 
+/**
+ * Encode and sign the packetDictionary to wire format, and compute its ContentObjectHash in the same pass.
+ *
+ * Behaves like {@link ccnxCodecTlvPacket_DictionaryEncode}, but the signed region is walked once, feeding both the signer's
+ * hasher and the SHA256 ContentObjectHash while the encoded blocks are still in cache.  The hash is then
+ * finished over the validation payload, so a caller does not need to hash the wire format again.
+ *
+ * If the packet has no ValidationAlg or the signer is NULL, no signature is generated but the
+ * ContentObjectHash is still computed over the message.  On return the dictionary holds the
+ * generated ValidationPayload, as with ccnxCodecTlvPacket_DictionaryEncode.
+ *
+ * @param [in] packetDictionary The dictionary representation of the packet to encode
+ * @param [in] signer If not NULL will be used to sign the wire format
+ * @param [out] contentObjectHashPtr Set to the allocated SHA256 ContentObjectHash, or NULL on error.  Release it when done.
+ *
+ * @retval non-null An IoVec that can be written to the network
+ * @retval null an error
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCCryptoHash *contentObjectHash;
+ *     CCNxCodecNetworkBufferIoVec *iovec = ccnxCodecTlvPacket_DictionaryEncodeAndSign(contentObject, signer, &contentObjectHash);
+ *     // ... writev() the iovec and index the content object by its hash
+ *     parcCryptoHash_Release(&contentObjectHash);
+ *     ccnxCodecNetworkBufferIoVec_Release(&iovec);
+ * }
+ * @endcode
+ */
+CCNxCodecNetworkBufferIoVec *ccnxCodecTlvPacket_DictionaryEncodeAndSign(CCNxTlvDictionary *packetDictionary, PARCSigner *signer, PARCCryptoHash **contentObjectHashPtr);
+
 /**
  * Return the length of the wire format packet based on information in the header
  *
@@ -113,9 +113,11 @@ bool
 ccnxCodecTlvUtilities_PutAsName(CCNxCodecTlvDecoder *decoder, CCNxTlvDictionary *packetDictionary, uint16_t type, uint16_t length, int arrayKey)
 {
     bool success = false;
-        CCNxName *name = ccnxCodecSchemaV1NameCodec_DecodeValue(decoder, length);
+    CCNxName *name = ccnxCodecSchemaV1NameCodec_DecodeValue(decoder, length);
+    if (name != NULL) {
         success = ccnxTlvDictionary_PutName(packetDictionary, arrayKey, name);
         ccnxName_Release(&name);
+    }
     return success;
 }
 
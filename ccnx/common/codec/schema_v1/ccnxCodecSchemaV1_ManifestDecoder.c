@@ -155,14 +155,14 @@ _decodeHashGroup(CCNxCodecTlvDecoder *decoder, CCNxTlvDictionary *packetDictiona
 
             case CCNxCodecSchemaV1Types_CCNxManifestHashGroup_DataPointer: {
                 PARCBuffer *buffer = ccnxCodecTlvDecoder_GetValue(decoder, value_length);
-                ccnxManifestHashGroup_AppendPointer(group, CCNxManifestHashGroupPointerType_Data, buffer);
+                success = ccnxManifestHashGroup_AppendPointer(group, CCNxManifestHashGroupPointerType_Data, buffer);
                 parcBuffer_Release(&buffer);
                 break;
             }
 
             case CCNxCodecSchemaV1Types_CCNxManifestHashGroup_ManifestPointer: {
                 PARCBuffer *buffer = ccnxCodecTlvDecoder_GetValue(decoder, value_length);
-                ccnxManifestHashGroup_AppendPointer(group, CCNxManifestHashGroupPointerType_Manifest, buffer);
+                success = ccnxManifestHashGroup_AppendPointer(group, CCNxManifestHashGroupPointerType_Manifest, buffer);
                 parcBuffer_Release(&buffer);
                 break;
             }
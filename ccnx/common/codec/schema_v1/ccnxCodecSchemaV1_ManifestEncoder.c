@@ -81,18 +81,15 @@
 #include <ccnx/common/ccnx_InterestReturn.h>
 
 static size_t
-_appendPointer(CCNxCodecTlvEncoder *encoder, CCNxManifestHashGroupPointer *ptr)
+_appendPointer(CCNxCodecTlvEncoder *encoder, CCNxManifestHashGroupPointerType type, const uint8_t *digest, size_t digestLength)
 {
-    const PARCBuffer *digest = ccnxManifestHashGroupPointer_GetDigest(ptr);
-    CCNxManifestHashGroupPointerType type = ccnxManifestHashGroupPointer_GetType(ptr);
-
     ssize_t length = -1;
     switch (type) {
         case CCNxManifestHashGroupPointerType_Data:
-            length = ccnxCodecTlvEncoder_AppendBuffer(encoder, CCNxCodecSchemaV1Types_CCNxManifestHashGroup_DataPointer, (PARCBuffer *) digest);
+            length = ccnxCodecTlvEncoder_AppendArray(encoder, CCNxCodecSchemaV1Types_CCNxManifestHashGroup_DataPointer, digestLength, digest);
             break;
         case CCNxManifestHashGroupPointerType_Manifest:
-            length = ccnxCodecTlvEncoder_AppendBuffer(encoder, CCNxCodecSchemaV1Types_CCNxManifestHashGroup_ManifestPointer, (PARCBuffer *) digest);
+            length = ccnxCodecTlvEncoder_AppendArray(encoder, CCNxCodecSchemaV1Types_CCNxManifestHashGroup_ManifestPointer, digestLength, digest);
             break;
         default:
             assertTrue(false, "Invalid pointer type %d", type);
@@ -165,14 +162,14 @@ ccnxCodecSchemaV1ManifestEncoder_Encode(CCNxCodecTlvEncoder *encoder, CCNxTlvDic
 {
     ssize_t length = 0;
 
-    ssize_t numHashGroups = ccnxTlvDictionary_ListSize(packetDictionary, CCNxCodecSchemaV1TlvDictionary_Lists_HASH_GROUP_LIST);
+    CCNxManifestInterface *interface = ccnxManifestInterface_GetInterface(packetDictionary);
+    size_t numHashGroups = interface->getNumberOfHashGroups(packetDictionary);
     for (size_t i = 0; i < numHashGroups; i++) {
 
         // Skip past the TL of the hash group to append the pointers inside
         ssize_t groupLength = 0;
         ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_CCNxMessage_HashGroup, groupLength);
 
-        CCNxManifestInterface *interface = ccnxManifestInterface_GetInterface(packetDictionary);
         CCNxManifestHashGroup *group = interface->getHashGroup(packetDictionary, i);
 
         // Encode any metadata, if present.
@@ -180,12 +177,14 @@ ccnxCodecSchemaV1ManifestEncoder_Encode(CCNxCodecTlvEncoder *encoder, CCNxTlvDic
             groupLength += _appendMetadata(encoder, group);
         }
 
-        // Append the HashGroup pointers
-        size_t numPointers = ccnxManifestHashGroup_GetNumberOfPointers(group);
-        for (size_t p = 0; p < numPointers; p++) {
-            CCNxManifestHashGroupPointer *ptr = ccnxManifestHashGroup_GetPointerAtIndex(group, p);
-            ssize_t ptrLength = _appendPointer(encoder, ptr);
+        // Append the HashGroup pointers straight from the group's digest table
+        CCNxManifestHashGroupPointerType type;
+        const uint8_t *digest;
+        size_t digestLength;
+        for (size_t p = 0; ccnxManifestHashGroup_GetPointerBytesAtIndex(group, p, &type, &digest, &digestLength); p++) {
+            ssize_t ptrLength = _appendPointer(encoder, type, digest, digestLength);
             if (ptrLength < 0) {
+                ccnxManifestHashGroup_Release(&group);
                 return ptrLength;
             }
             groupLength += ptrLength;
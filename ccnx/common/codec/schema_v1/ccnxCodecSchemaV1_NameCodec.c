@@ -111,16 +111,47 @@ ccnxCodecSchemaV1NameCodec_Decode(CCNxCodecTlvDecoder *decoder, uint16_t type)
 CCNxName *
 ccnxCodecSchemaV1NameCodec_DecodeValue(CCNxCodecTlvDecoder *decoder, uint16_t length)
 {
+    // Index the segments in place, then copy them into the name in one pass, rather than
+    // creating a CCNxNameSegment, CCNxNameLabel and PARCBuffer for each segment.
     CCNxName *name = NULL;
-    if (ccnxCodecTlvDecoder_EnsureRemaining(decoder, length)) {
-        name = ccnxName_Create();
-        size_t nameEnd = ccnxCodecTlvDecoder_Position(decoder) + length;
-
-        while (ccnxCodecTlvDecoder_Position(decoder) < nameEnd) {
-            CCNxNameSegment *segment = ccnxCodecSchemaV1NameSegmentCodec_Decode(decoder);
-            ccnxName_Append(name, segment);
-            ccnxNameSegment_Release(&segment);
-        }
+    CCNxNameView view;
+    if (ccnxCodecSchemaV1NameCodec_DecodeValueView(decoder, length, &view)) {
+        name = ccnxNameView_CreateName(&view);
     }
     return name;
 }
+
+bool
+ccnxCodecSchemaV1NameCodec_DecodeView(CCNxCodecTlvDecoder *decoder, uint16_t type, CCNxNameView *view)
+{
+    bool success = false;
+    if (ccnxCodecTlvDecoder_EnsureRemaining(decoder, 4)) {
+        uint16_t tlvtype = ccnxCodecTlvDecoder_PeekType(decoder);
+        if (tlvtype == type) {
+            size_t start = ccnxCodecTlvDecoder_Position(decoder);
+
+            // call just for the side-effect of advancing the buffer
+            (void) ccnxCodecTlvDecoder_GetType(decoder);
+            uint16_t length = ccnxCodecTlvDecoder_GetLength(decoder);
+
+            success = ccnxCodecSchemaV1NameCodec_DecodeValueView(decoder, length, view);
+            if (!success) {
+                // leave the decoder where it was, as documented
+                ccnxCodecTlvDecoder_SetPosition(decoder, start);
+            }
+        }
+    }
+
+    return success;
+}
+
+bool
+ccnxCodecSchemaV1NameCodec_DecodeValueView(CCNxCodecTlvDecoder *decoder, uint16_t length, CCNxNameView *view)
+{
+    bool success = false;
+    const uint8_t *value = ccnxCodecTlvDecoder_GetArray(decoder, length);
+    if (value != NULL) {
+        success = ccnxNameView_Init(view, length, value);
+    }
+    return success;
+}
@@ -68,6 +68,7 @@
 #include <ccnx/common/codec/ccnxCodec_TlvEncoder.h>
 #include <ccnx/common/codec/ccnxCodec_TlvDecoder.h>
 #include <ccnx/common/ccnx_Name.h>
+#include <ccnx/common/ccnx_NameView.h>
 
 /**
  * Encodes the name to the TLV Encoder
@@ -121,4 +122,51 @@ CCNxName *ccnxCodecSchemaV1NameCodec_Decode(CCNxCodecTlvDecoder *decoder, uint16
  * @endcode
  */
 CCNxName *ccnxCodecSchemaV1NameCodec_DecodeValue(CCNxCodecTlvDecoder *decoder, uint16_t length);
+
+/**
+ * Decode the Name at the current position as a `CCNxNameView`, without allocating memory
+ *
+ * The decoder must be pointing to the beginning of the "type".  If the type does not match `type', or the
+ * Name is truncated or malformed, the function returns false and the decoder does not move.  Otherwise the
+ * decoder is advanced past the Name.
+ *
+ * The view points into the decoder's underlying buffer and is only valid while that buffer is valid.
+ *
+ * @param [in] decoder The decoder
+ * @param [in] type The TLV type that the decoder should currently be pointing at
+ * @param [out] view The `CCNxNameView` to initialise
+ *
+ * @return true The view was initialised
+ * @return false An error: either type did not match, the buffer is too short or the Name is malformed
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxNameView view;
+ *     if (ccnxCodecSchemaV1NameCodec_DecodeView(decoder, CCNxCodecSchemaV1Types_CCNxMessage_Name, &view)) {
+ *         PARCHashCode hashCode = ccnxNameView_HashCode(&view);
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxCodecSchemaV1NameCodec_DecodeView(CCNxCodecTlvDecoder *decoder, uint16_t type, CCNxNameView *view);
+
+/**
+ * The decoder points to the first byte of the Name "value".  Initialise a `CCNxNameView` over it
+ *
+ * The decoder is advanced by `length` bytes.  No memory is allocated.
+ *
+ * @param [in] decoder The Tlv Decoder pointing to the start of the Name value
+ * @param [in] length the length of the Name value
+ * @param [out] view The `CCNxNameView` to initialise
+ *
+ * @return true The view was initialised
+ * @return false An error: the buffer is too short or the Name is malformed
+ *
+ * Example:
+ * @code
+ * <#example#>
+ * @endcode
+ */
+bool ccnxCodecSchemaV1NameCodec_DecodeValueView(CCNxCodecTlvDecoder *decoder, uint16_t length, CCNxNameView *view);
 #endif // CCNxCodecSchemaV1_NameCodec_h
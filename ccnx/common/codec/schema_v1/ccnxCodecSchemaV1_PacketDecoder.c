@@ -329,3 +329,289 @@ ccnxCodecSchemaV1PacketDecoder_BufferDecode(PARCBuffer *packetBuffer, CCNxTlvDic
     ccnxCodecTlvDecoder_Destroy(&decoder);
     return success;
 }
+
+bool
+ccnxCodecSchemaV1PacketDecoder_ArenaDecode(PARCBuffer *packetBuffer, CCNxTlvDictionary *packetDictionary)
+{
+    CCNxCodecArena *arena = ccnxCodecArena_Create();
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_CreateWithArena(packetBuffer, arena);
+    bool success = ccnxCodecSchemaV1PacketDecoder_Decode(decoder, packetDictionary);
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+
+    ccnxTlvDictionary_SetArena(packetDictionary, arena);
+    ccnxCodecArena_Release(&arena);
+    return success;
+}
+
+// ===========================================================
+// Lazy decode
+
+typedef enum {
+    _LazySection_OptionalHeaders = 0,
+    _LazySection_Message = 1,
+    _LazySection_ValidationAlg = 2,
+    _LazySection_ValidationPayload = 3,
+    _LazySection_Count = 4
+} _CCNxCodecSchemaV1LazySection;
+
+/*
+ * The section extents found by the scan.  `offset` and `length` are the value of the section's
+ * container, relative to the start of `packet`.
+ */
+typedef struct ccnx_codec_schema_v1_lazy_state {
+    PARCBuffer *packet;
+    uint16_t messageType;
+    unsigned pending;
+    bool failed;
+    struct {
+        size_t offset;
+        size_t length;
+    } sections[_LazySection_Count];
+} _CCNxCodecSchemaV1LazyState;
+
+static void
+_ccnxCodecSchemaV1LazyState_Free(void **statePtr)
+{
+    _CCNxCodecSchemaV1LazyState *state = *statePtr;
+    parcBuffer_Release(&state->packet);
+    parcMemory_Deallocate((void **) statePtr);
+}
+
+/*
+ * Decodes one section the first time it is asked for.  A failed section is not retried, its fields stay unset.
+ */
+static bool
+_ccnxCodecSchemaV1LazyState_DecodeSection(_CCNxCodecSchemaV1LazyState *state, CCNxTlvDictionary *packetDictionary,
+                                          _CCNxCodecSchemaV1LazySection section)
+{
+    if ((state->pending & (1u << section)) == 0) {
+        return true;
+    }
+    state->pending &= ~(1u << section);
+
+    // Point the packet at just the section and wrap that
+    parcBuffer_SetLimit(state->packet, state->sections[section].offset + state->sections[section].length);
+    parcBuffer_SetPosition(state->packet, state->sections[section].offset);
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(state->packet);
+
+    bool success = false;
+    switch (section) {
+        case _LazySection_OptionalHeaders:
+            success = ccnxCodecSchemaV1OptionalHeadersDecoder_Decode(decoder, packetDictionary);
+            break;
+
+        case _LazySection_Message:
+            if (state->messageType == CCNxCodecSchemaV1Types_MessageType_Control) {
+                success = _decodeCPI(decoder, packetDictionary);
+            } else if (state->messageType == CCNxCodecSchemaV1Types_MessageType_Manifest) {
+                success = ccnxCodecSchemaV1ManifestDecoder_Decode(decoder, packetDictionary);
+            } else {
+                success = ccnxCodecSchemaV1MessageDecoder_Decode(decoder, packetDictionary);
+            }
+            break;
+
+        case _LazySection_ValidationAlg:
+            success = ccnxCodecSchemaV1ValidationDecoder_DecodeAlg(decoder, packetDictionary);
+            break;
+
+        case _LazySection_ValidationPayload:
+            success = ccnxCodecSchemaV1ValidationDecoder_DecodePayload(decoder, packetDictionary);
+            break;
+
+        default:
+            trapIllegalValue(section, "Unknown section %d", section);
+    }
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+
+    if (!success) {
+        state->failed = true;
+    }
+    return success;
+}
+
+/*
+ * The CCNxTlvDictionaryLazyDecoder.  Maps a dictionary key to the section that holds it.
+ */
+static bool
+_ccnxCodecSchemaV1PacketDecoder_LazyDecoder(CCNxTlvDictionary *packetDictionary, void *voidState,
+                                            CCNxTlvDictionaryLazyRequest request, uint32_t key)
+{
+    _CCNxCodecSchemaV1LazyState *state = voidState;
+    if (state->pending == 0) {
+        return !state->failed;
+    }
+
+    bool success = true;
+    switch (request) {
+        case CCNxTlvDictionaryLazyRequest_Field:
+            if (key < CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_END) {
+                // Most headers are set by the scan or are not on the wire (e.g. the WireFormat put on
+                // the forwarding path), so only the optional headers are worth decoding for
+                switch (key) {
+                    case CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_INTFRAG: // fallthrough
+                    case CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_OBJFRAG: // fallthrough
+                    case CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_InterestLifetime: // fallthrough
+                    case CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_RecommendedCacheTime:
+                        success = _ccnxCodecSchemaV1LazyState_DecodeSection(state, packetDictionary, _LazySection_OptionalHeaders);
+                        break;
+
+                    default:
+                        break;
+                }
+            } else if (key < CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_END) {
+                // the ValidationFastArray is shared by the algorithm and the payload
+                success = _ccnxCodecSchemaV1LazyState_DecodeSection(state, packetDictionary, _LazySection_ValidationAlg);
+                success &= _ccnxCodecSchemaV1LazyState_DecodeSection(state, packetDictionary, _LazySection_ValidationPayload);
+            } else {
+                success = _ccnxCodecSchemaV1LazyState_DecodeSection(state, packetDictionary, _LazySection_Message);
+            }
+            break;
+
+        case CCNxTlvDictionaryLazyRequest_List:
+            switch (key) {
+                case CCNxCodecSchemaV1TlvDictionary_Lists_HEADERS:
+                    success = _ccnxCodecSchemaV1LazyState_DecodeSection(state, packetDictionary, _LazySection_OptionalHeaders);
+                    break;
+
+                case CCNxCodecSchemaV1TlvDictionary_Lists_MESSAGE_LIST: // fallthrough
+                case CCNxCodecSchemaV1TlvDictionary_Lists_HASH_GROUP_LIST:
+                    success = _ccnxCodecSchemaV1LazyState_DecodeSection(state, packetDictionary, _LazySection_Message);
+                    break;
+
+                case CCNxCodecSchemaV1TlvDictionary_Lists_VALIDATION_ALG_LIST:
+                    success = _ccnxCodecSchemaV1LazyState_DecodeSection(state, packetDictionary, _LazySection_ValidationAlg);
+                    break;
+
+                case CCNxCodecSchemaV1TlvDictionary_Lists_VALIDATION_PAYLOAD_LIST:
+                    success = _ccnxCodecSchemaV1LazyState_DecodeSection(state, packetDictionary, _LazySection_ValidationPayload);
+                    break;
+
+                default:
+                    // not one of ours, nothing to do
+                    break;
+            }
+            break;
+
+        case CCNxTlvDictionaryLazyRequest_All:
+            for (int section = 0; section < _LazySection_Count; section++) {
+                _ccnxCodecSchemaV1LazyState_DecodeSection(state, packetDictionary, section);
+            }
+            success = !state->failed;
+            break;
+
+        default:
+            trapIllegalValue(request, "Unknown lazy request %d", request);
+    }
+
+    return success;
+}
+
+/*
+ * Steps over a container of type `tlvType` and records where its value is.
+ */
+static bool
+_lazyScanContainer(CCNxCodecTlvDecoder *decoder, uint16_t tlvType, _CCNxCodecSchemaV1LazyState *state, _CCNxCodecSchemaV1LazySection section)
+{
+    if (ccnxCodecTlvDecoder_EnsureRemaining(decoder, 4)) {
+        uint16_t tlv_type = ccnxCodecTlvDecoder_GetType(decoder);
+        uint16_t tlv_length = ccnxCodecTlvDecoder_GetLength(decoder);
+
+        if (tlv_type == tlvType) {
+            state->sections[section].offset = ccnxCodecTlvDecoder_Position(decoder);
+            state->sections[section].length = tlv_length;
+            if (ccnxCodecTlvDecoder_Advance(decoder, tlv_length)) {
+                state->pending |= 1u << section;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*
+ * The scan does the same checks as ccnxCodecSchemaV1PacketDecoder_Decode() on the outer containers
+ * and fills in the fixed header, message type and region markers, but does not look inside the sections.
+ */
+static bool
+_lazyScan(CCNxCodecTlvDecoder *decoder, CCNxTlvDictionary *packetDictionary, _CCNxCodecSchemaV1LazyState *state)
+{
+    if (!ccnxCodecSchemaV1FixedHeaderDecoder_Decode(decoder, packetDictionary)) {
+        return false;
+    }
+
+    size_t optionalHeaderLength = ccnxCodecSchemaV1FixedHeaderDecoder_GetOptionalHeaderLength(packetDictionary);
+    state->sections[_LazySection_OptionalHeaders].offset = ccnxCodecTlvDecoder_Position(decoder);
+    state->sections[_LazySection_OptionalHeaders].length = optionalHeaderLength;
+    if (!ccnxCodecTlvDecoder_Advance(decoder, optionalHeaderLength)) {
+        return false;
+    }
+    state->pending |= 1u << _LazySection_OptionalHeaders;
+
+    size_t signatureStartPosition = ccnxCodecTlvDecoder_Position(decoder);
+    CCNxWireFormatFacadeV1_Implementation.setContentObjectHashRegionStart(packetDictionary, signatureStartPosition);
+
+    if (!ccnxCodecTlvDecoder_EnsureRemaining(decoder, 4)) {
+        return false;
+    }
+
+    state->messageType = ccnxCodecTlvDecoder_PeekType(decoder);
+    switch (state->messageType) {
+        case CCNxCodecSchemaV1Types_MessageType_Interest: // fallthrough
+        case CCNxCodecSchemaV1Types_MessageType_ContentObject: // fallthrough
+        case CCNxCodecSchemaV1Types_MessageType_Control:
+            break;
+
+        case CCNxCodecSchemaV1Types_MessageType_Manifest:
+            // the message type is not a field, so it cannot wait for the message to be decoded
+            ccnxTlvDictionary_SetMessageType_Manifest(packetDictionary, CCNxTlvDictionary_SchemaVersion_V1);
+            break;
+
+        default:
+            return false;
+    }
+
+    size_t messageLength = ccnxCodecSchemaV1FixedHeaderDecoder_GetPacketLength(packetDictionary) - ccnxCodecSchemaV1FixedHeaderDecoder_GetHeaderLength(packetDictionary);
+    if (!_lazyScanContainer(decoder, state->messageType, state, _LazySection_Message) ||
+        state->sections[_LazySection_Message].length > messageLength) {
+        return false;
+    }
+
+    bool success = true;
+    if (!ccnxCodecTlvDecoder_IsEmpty(decoder)) {
+        success = _lazyScanContainer(decoder, CCNxCodecSchemaV1Types_MessageType_ValidationAlg, state, _LazySection_ValidationAlg);
+        if (success) {
+            size_t signatureStopPosition = ccnxCodecTlvDecoder_Position(decoder);
+            CCNxWireFormatFacadeV1_Implementation.setProtectedRegionStart(packetDictionary, signatureStartPosition);
+            CCNxWireFormatFacadeV1_Implementation.setProtectedRegionLength(packetDictionary, signatureStopPosition - signatureStartPosition);
+
+            success = _lazyScanContainer(decoder, CCNxCodecSchemaV1Types_MessageType_ValidationPayload, state, _LazySection_ValidationPayload);
+        }
+    }
+
+    size_t contentObjectHashRegionLength = ccnxCodecTlvDecoder_Position(decoder) - signatureStartPosition;
+    CCNxWireFormatFacadeV1_Implementation.setContentObjectHashRegionLength(packetDictionary, contentObjectHashRegionLength);
+
+    return success;
+}
+
+bool
+ccnxCodecSchemaV1PacketDecoder_LazyDecode(PARCBuffer *packetBuffer, CCNxTlvDictionary *packetDictionary)
+{
+    _CCNxCodecSchemaV1LazyState *state = parcMemory_AllocateAndClear(sizeof(_CCNxCodecSchemaV1LazyState));
+    assertNotNull(state, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(_CCNxCodecSchemaV1LazyState));
+
+    // positions in the decoder and in the state's slice both count from the start of the fixed header
+    state->packet = parcBuffer_Slice(packetBuffer);
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(packetBuffer);
+    bool success = _lazyScan(decoder, packetDictionary, state);
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+
+    if (success) {
+        ccnxTlvDictionary_SetLazyDecoder(packetDictionary, _ccnxCodecSchemaV1PacketDecoder_LazyDecoder, state, _ccnxCodecSchemaV1LazyState_Free);
+    } else {
+        void *voidState = state;
+        _ccnxCodecSchemaV1LazyState_Free(&voidState);
+    }
+    return success;
+}
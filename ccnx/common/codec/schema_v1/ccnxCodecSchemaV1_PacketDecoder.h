@@ -106,6 +106,69 @@
  */
 bool ccnxCodecSchemaV1PacketDecoder_BufferDecode(PARCBuffer *packetBuffer, CCNxTlvDictionary *packetDictionary);
 
+/**
+ * Decode a packet buffer into a dictionary, keeping the decode state in a per-packet arena.
+ *
+ * Same as ccnxCodecSchemaV1PacketDecoder_BufferDecode(), except the decoder, its container decoders and
+ * any copies they make are allocated from a `CCNxCodecArena` rather than one heap allocation each.
+ * The arena is handed to the dictionary with ccnxTlvDictionary_SetArena() and freed in one shot when the
+ * dictionary is released.
+ *
+ * @param [in] buffer The packet buffer
+ * @param [in] packetDictionary The dictionary to fill in
+ *
+ * @return true Successful decode
+ * @return false There was an error somewhere
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateContentObject();
+ *     bool success = ccnxCodecSchemaV1PacketDecoder_ArenaDecode(packetBuffer, dictionary);
+ *     ccnxTlvDictionary_Release(&dictionary);
+ * }
+ * @endcode
+ */
+bool ccnxCodecSchemaV1PacketDecoder_ArenaDecode(PARCBuffer *packetBuffer, CCNxTlvDictionary *packetDictionary);
+
+/**
+ * Decode a packet buffer into a dictionary, leaving each section to be decoded when it is first used.
+ *
+ * The up-front cost is one scan of the outer containers: it decodes the fixed header, checks the optional
+ * headers, message, validation algorithm and validation payload containers the same way as
+ * ccnxCodecSchemaV1PacketDecoder_BufferDecode(), and sets the protected and ContentObjectHash regions.
+ * It records where each section is and gives the dictionary a lazy decoder (see ccnxTlvDictionary_SetLazyDecoder()).
+ * The first getter that touches a section, such as `ccnxContentObject_GetName()` or
+ * `ccnxValidationFacadeV1_GetKeyName()`, decodes that whole section.  A forwarder that only looks at the
+ * name and restrictions never pays for decoding the validation section.
+ *
+ * Errors inside a section are only found when it is decoded, and leave its fields unset.
+ * Call ccnxTlvDictionary_LazyDecodeAll() to decode everything and find out whether it was well formed.
+ * The dictionary keeps a reference to the packet buffer.
+ *
+ * Decoding a section writes to the dictionary from inside `const` getters and is not synchronized, so
+ * call ccnxTlvDictionary_LazyDecodeAll() before handing the dictionary to another thread.
+ *
+ * @param [in] buffer The packet buffer
+ * @param [in] packetDictionary The dictionary to fill in
+ *
+ * @return true The outer containers are well formed
+ * @return false There was an error in the fixed header or the outer containers
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateInterest();
+ *     if (ccnxCodecSchemaV1PacketDecoder_LazyDecode(packetBuffer, dictionary)) {
+ *         // decodes only the message section
+ *         CCNxName *name = ccnxInterest_GetName(dictionary);
+ *     }
+ *     ccnxTlvDictionary_Release(&dictionary);
+ * }
+ * @endcode
+ */
+bool ccnxCodecSchemaV1PacketDecoder_LazyDecode(PARCBuffer *packetBuffer, CCNxTlvDictionary *packetDictionary);
+
 /**
  * Decode in to in to a dictionary.
  *
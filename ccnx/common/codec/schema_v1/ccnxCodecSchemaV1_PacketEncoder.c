@@ -59,6 +59,7 @@
 
 #include <config.h>
 #include <stdio.h>
+#include <stddef.h>
 #include <sys/time.h>
 #include <inttypes.h>
 
@@ -266,8 +267,10 @@ _encodeValidationAlg(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDict
     ssize_t innerLength = 0;
 
     // There must be a CryptoSuite in the packet to sign it.
-    // Temporary exception for Content Objects, which are all signed if the codec has a signer.
-    if (ccnxValidationFacadeV1_HasCryptoSuite(packetDictionary) || ccnxTlvDictionary_IsContentObject(packetDictionary)) {
+    // Temporary exception for Content Objects, which are all signed if the codec has a signer,
+    // unless they are marked unsigned because a manifest binds them by hash.
+    bool signContentObject = ccnxTlvDictionary_IsContentObject(packetDictionary) && !ccnxValidationFacadeV1_IsUnsigned(packetDictionary);
+    if (ccnxValidationFacadeV1_HasCryptoSuite(packetDictionary) || signContentObject) {
         ssize_t startPosition = ccnxCodecTlvEncoder_Position(encoder);
 
         ccnxCodecTlvEncoder_AppendContainer(encoder, CCNxCodecSchemaV1Types_MessageType_ValidationAlg, 0);
@@ -306,22 +309,44 @@ _encodeValidationPayload(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packet
     return innerLength;
 }
 
-// =====================================================
-// Public API
-
-CCNxCodecNetworkBufferIoVec *
-ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(CCNxTlvDictionary *packetDictionary, PARCSigner *signer)
+static CCNxCodecNetworkBufferIoVec *
+_dictionaryEncode(CCNxTlvDictionary *packetDictionary, PARCSigner *signer, PARCCryptoHash **contentObjectHashPtr)
 {
     CCNxCodecNetworkBufferIoVec *outputBuffer = NULL;
 
-    CCNxCodecTlvEncoder *packetEncoder = ccnxCodecTlvEncoder_Create();
+    // Measure the packet first, so it is encoded into one memory block and comes out as a single iovec.
+    // The sizer carries the signer so it sees the SigTime and deduced ValidationAlg the signer adds, and
+    // measures the largest signature in place of signing.  If measuring fails, encode anyway so the
+    // error is reported from the real encoder.
+    CCNxCodecTlvEncoder *sizer = ccnxCodecTlvEncoder_CreateMeasuring();
+    if (signer) {
+        ccnxCodecTlvEncoder_SetSigner(sizer, signer);
+    }
+    ssize_t measuredLength = ccnxCodecSchemaV1PacketEncoder_Encode(sizer, packetDictionary);
+    ccnxCodecTlvEncoder_Destroy(&sizer);
+
+    CCNxCodecTlvEncoder *packetEncoder;
+    if (measuredLength > 0) {
+        packetEncoder = ccnxCodecTlvEncoder_CreateWithCapacity(measuredLength);
+    } else {
+        packetEncoder = ccnxCodecTlvEncoder_Create();
+    }
 
     if (signer) {
-//        ccnxCodecTlvEncoder_SetSigner(packetEncoder, signer);
+        ccnxCodecTlvEncoder_SetSigner(packetEncoder, signer);
+    }
+
+    if (contentObjectHashPtr) {
+        *contentObjectHashPtr = NULL;
+        ccnxCodecTlvEncoder_EnableContentObjectHash(packetEncoder);
     }
 
     ssize_t encodedLength = ccnxCodecSchemaV1PacketEncoder_Encode(packetEncoder, packetDictionary);
     if (encodedLength > 0) {
+        if (contentObjectHashPtr) {
+            // the signer already hashed the protected region, so this only adds the validation payload
+            *contentObjectHashPtr = ccnxCodecTlvEncoder_FinalizeContentObjectHash(packetEncoder);
+        }
         ccnxCodecTlvEncoder_Finalize(packetEncoder);
         outputBuffer = ccnxCodecTlvEncoder_CreateIoVec(packetEncoder);
     }
@@ -341,6 +366,22 @@ ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(CCNxTlvDictionary *packetDiction
     return outputBuffer;
 }
 
+// =====================================================
+// Public API
+
+CCNxCodecNetworkBufferIoVec *
+ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(CCNxTlvDictionary *packetDictionary, PARCSigner *signer)
+{
+    return _dictionaryEncode(packetDictionary, signer, NULL);
+}
+
+CCNxCodecNetworkBufferIoVec *
+ccnxCodecSchemaV1PacketEncoder_DictionaryEncodeAndSign(CCNxTlvDictionary *packetDictionary, PARCSigner *signer, PARCCryptoHash **contentObjectHashPtr)
+{
+    assertNotNull(contentObjectHashPtr, "Parameter contentObjectHashPtr must be non-null");
+    return _dictionaryEncode(packetDictionary, signer, contentObjectHashPtr);
+}
+
 ssize_t
 ccnxCodecSchemaV1PacketEncoder_Encode(CCNxCodecTlvEncoder *packetEncoder, CCNxTlvDictionary *packetDictionary)
 {
@@ -392,3 +433,27 @@ ccnxCodecSchemaV1PacketEncoder_Encode(CCNxCodecTlvEncoder *packetEncoder, CCNxTl
 
     return length;
 }
+
+ssize_t
+ccnxCodecSchemaV1PacketEncoder_AppendValidationPayload(CCNxCodecTlvEncoder *packetEncoder, size_t fixedHeaderPosition, const PARCBuffer *payload)
+{
+    assertNotNull(packetEncoder, "Parameter packetEncoder must be non-null");
+    assertNotNull(payload, "Parameter payload must be non-null");
+
+    size_t payloadPosition = ccnxCodecTlvEncoder_Position(packetEncoder);
+    assertTrue(payloadPosition > fixedHeaderPosition, "fixedHeaderPosition %zu must precede the end of the packet %zu",
+               fixedHeaderPosition, payloadPosition);
+
+    ccnxCodecTlvEncoder_AppendBuffer(packetEncoder, CCNxCodecSchemaV1Types_MessageType_ValidationPayload, (PARCBuffer *) payload);
+
+    size_t packetLength = ccnxCodecTlvEncoder_Position(packetEncoder) - fixedHeaderPosition;
+    if (packetLength > UINT16_MAX) {
+        CCNxCodecError *error = ccnxCodecError_Create(TLV_ERR_TOO_LONG, __func__, __LINE__, payloadPosition);
+        ccnxCodecTlvEncoder_SetError(packetEncoder, error);
+        ccnxCodecError_Release(&error);
+        return -1;
+    }
+
+    ccnxCodecTlvEncoder_PutUint16(packetEncoder, fixedHeaderPosition + offsetof(CCNxCodecSchemaV1FixedHeader, packetLength), (uint16_t) packetLength);
+    return packetLength;
+}
@@ -71,6 +71,7 @@
 
 #include <parc/algol/parc_Buffer.h>
 #include <parc/security/parc_Signer.h>
+#include <parc/security/parc_CryptoHash.h>
 
 #include <ccnx/common/internal/ccnx_TlvDictionary.h>
 #include <ccnx/common/codec/ccnxCodec_TlvEncoder.h>
@@ -101,6 +102,37 @@
  */
 CCNxCodecNetworkBufferIoVec *ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(CCNxTlvDictionary *packetDictionary, PARCSigner *signer);
 
+/**
+ * Encode and sign the packetDictionary to wire format, and compute its ContentObjectHash in the same pass.
+ *
+ * Behaves like {@link ccnxCodecSchemaV1PacketEncoder_DictionaryEncode}, but the signed region is walked once, feeding both the signer's
+ * hasher and the SHA256 ContentObjectHash while the encoded blocks are still in cache.  The hash is then
+ * finished over the validation payload, so a caller does not need to hash the wire format again.
+ *
+ * If the packet has no ValidationAlg or the signer is NULL, no signature is generated but the
+ * ContentObjectHash is still computed over the message.  On return the dictionary holds the
+ * generated ValidationPayload, as with ccnxCodecSchemaV1PacketEncoder_DictionaryEncode.
+ *
+ * @param [in] packetDictionary The dictionary representation of the packet to encode
+ * @param [in] signer If not NULL will be used to sign the wire format
+ * @param [out] contentObjectHashPtr Set to the allocated SHA256 ContentObjectHash, or NULL on error.  Release it when done.
+ *
+ * @retval non-null An IoVec that can be written to the network
+ * @retval null an error
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCCryptoHash *contentObjectHash;
+ *     CCNxCodecNetworkBufferIoVec *iovec = ccnxCodecSchemaV1PacketEncoder_DictionaryEncodeAndSign(contentObject, signer, &contentObjectHash);
+ *     // ... writev() the iovec and index the content object by its hash
+ *     parcCryptoHash_Release(&contentObjectHash);
+ *     ccnxCodecNetworkBufferIoVec_Release(&iovec);
+ * }
+ * @endcode
+ */
+CCNxCodecNetworkBufferIoVec *ccnxCodecSchemaV1PacketEncoder_DictionaryEncodeAndSign(CCNxTlvDictionary *packetDictionary, PARCSigner *signer, PARCCryptoHash **contentObjectHashPtr);
+
 /**
  * Encode a packetDictionary to wire format.
  *
@@ -123,4 +155,33 @@ CCNxCodecNetworkBufferIoVec *ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(CCN
  */
 ssize_t ccnxCodecSchemaV1PacketEncoder_Encode(CCNxCodecTlvEncoder *packetEncoder, CCNxTlvDictionary *packetDictionary);
 
+/**
+ * Append a ValidationPayload to a packet that was encoded without one.
+ *
+ * The packet must have been encoded by `ccnxCodecSchemaV1PacketEncoder_Encode()` with a ValidationAlg but no
+ * signer and no ValidationPayload in the dictionary, and the encoder must still be positioned at the end
+ * of that packet.  This appends the ValidationPayload TLV and fixes up the packet length in the fixed header,
+ * so a signature computed later (e.g. on another thread) can complete the packet without re-encoding it.
+ *
+ * @param [in] packetEncoder The encoder holding the packet
+ * @param [in] fixedHeaderPosition The encoder position of the packet's fixed header
+ * @param [in] payload The validation payload (e.g. the signature bits)
+ *
+ * @retval non-negative The total bytes of the packet, from the fixed header to the end of the ValidationPayload
+ * @retval -1 An error
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+ *     ccnxCodecSchemaV1PacketEncoder_Encode(encoder, packetDictionary);
+ *     PARCCryptoHash *digest = ccnxCodecTlvEncoder_ComputeDigest(encoder, hasher);
+ *     PARCSignature *signature = parcSigner_SignDigest(signer, digest);
+ *     ccnxCodecSchemaV1PacketEncoder_AppendValidationPayload(encoder, 0, parcSignature_GetSignature(signature));
+ *     ccnxCodecTlvEncoder_Finalize(encoder);
+ * }
+ * @endcode
+ */
+ssize_t ccnxCodecSchemaV1PacketEncoder_AppendValidationPayload(CCNxCodecTlvEncoder *packetEncoder, size_t fixedHeaderPosition, const PARCBuffer *payload);
+
 #endif // CCNxCodecSchemaV1_PacketEncoder_h
@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * The validator walks each container with a table of which child types are themselves containers.
+ * Everything else is opaque: only its length is used, to step over it.  The V1 schema nests at most
+ * five deep (ValidationAlg / suite / KeyName / Name / segment), so the recursion is bounded.
+ *
+ * Each TLV header is read as one 32-bit load and byte swap, which gives the type and length together.
+ * The walk itself is serial, because every length decides where the next header is.
+ *
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <stdbool.h>
+#include <string.h>
+#include <arpa/inet.h>
+
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_StructureValidator.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_FixedHeader.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_Types.h>
+
+#define _tlvHeaderBytes 4
+
+// The offsets reported for errors in the fixed header
+#define _fixedHeader_VersionOffset 0
+#define _fixedHeader_PacketLengthOffset 2
+#define _fixedHeader_HeaderLengthOffset 7
+
+/*
+ * The kinds of container in the V1 schema.  A TLV whose value is not a list of TLVs is opaque.
+ */
+typedef enum {
+    _Container_Opaque,
+    _Container_OptionalHeaders,
+    _Container_Message,
+    _Container_Manifest,
+    _Container_HashGroup,
+    _Container_HashGroupMetadata,
+    _Container_Name,
+    _Container_Hash,
+    _Container_ValidationAlg,
+    _Container_ValidationAlgParameters,
+    _Container_Link
+} _CCNxCodecSchemaV1StructureContainer;
+
+/*
+ * The kind of the value of a TLV of type `type` found in a `parent` container.
+ */
+static _CCNxCodecSchemaV1StructureContainer
+_childContainer(_CCNxCodecSchemaV1StructureContainer parent, uint16_t type)
+{
+    switch (parent) {
+        case _Container_Message:
+            switch (type) {
+                case CCNxCodecSchemaV1Types_CCNxMessage_Name:
+                    return _Container_Name;
+                case CCNxCodecSchemaV1Types_CCNxMessage_KeyIdRestriction: // fallthrough
+                case CCNxCodecSchemaV1Types_CCNxMessage_ContentObjectHashRestriction:
+                    return _Container_Hash;
+                default:
+                    return _Container_Opaque;
+            }
+
+        case _Container_Manifest:
+            switch (type) {
+                case CCNxCodecSchemaV1Types_CCNxMessage_Name:
+                    return _Container_Name;
+                case CCNxCodecSchemaV1Types_CCNxMessage_HashGroup:
+                    return _Container_HashGroup;
+                default:
+                    return _Container_Opaque;
+            }
+
+        case _Container_HashGroup:
+            return (type == CCNxCodecSchemaV1Types_CCNxManifestHashGroup_Metadata) ? _Container_HashGroupMetadata : _Container_Opaque;
+
+        case _Container_ValidationAlg:
+            // Only the crypto suites have parameters.  Unknown algorithms are kept as opaque buffers.
+            switch (type) {
+                case CCNxCodecSchemaV1Types_ValidationAlg_CRC32C: // fallthrough
+                case CCNxCodecSchemaV1Types_ValidationAlg_HMAC_SHA256: // fallthrough
+                case CCNxCodecSchemaV1Types_ValidationAlg_RSA_SHA256: // fallthrough
+                case CCNxCodecSchemaV1Types_ValidationAlg_EC_SECP_256K1:
+                    return _Container_ValidationAlgParameters;
+                default:
+                    return _Container_Opaque;
+            }
+
+        case _Container_ValidationAlgParameters:
+            return (type == CCNxCodecSchemaV1Types_ValidationAlg_KeyName) ? _Container_Link : _Container_Opaque;
+
+        case _Container_Link:
+            return (type == CCNxCodecSchemaV1Types_Link_Name) ? _Container_Name : _Container_Opaque;
+
+        default:
+            // Optional headers, name segments, hashes and hash group metadata hold only opaque values
+            return _Container_Opaque;
+    }
+}
+
+/*
+ * Read the type and length of the TLV at `tlv` with one load.
+ */
+static inline void
+_readTlvHeader(const uint8_t *tlv, uint16_t *type, uint16_t *length)
+{
+    uint32_t word;
+    memcpy(&word, tlv, sizeof(word));
+    word = ntohl(word);
+    *type = (uint16_t) (word >> 16);
+    *length = (uint16_t) word;
+}
+
+static inline CCNxCodecErrorCodes
+_fail(CCNxCodecErrorCodes code, size_t offset, size_t *errorOffset)
+{
+    if (errorOffset != NULL) {
+        *errorOffset = offset;
+    }
+    return code;
+}
+
+/*
+ * Check that the TLVs in [start, end) exactly fill it, and recursively check the containers among them.
+ */
+static CCNxCodecErrorCodes
+_validateContainer(const uint8_t *packet, size_t start, size_t end, _CCNxCodecSchemaV1StructureContainer container, size_t *errorOffset)
+{
+    size_t offset = start;
+    while (end - offset >= _tlvHeaderBytes) {
+        uint16_t type;
+        uint16_t length;
+        _readTlvHeader(&packet[offset], &type, &length);
+
+        size_t valueStart = offset + _tlvHeaderBytes;
+        if (length > end - valueStart) {
+            return _fail(TLV_ERR_TOO_LONG, offset, errorOffset);
+        }
+
+        _CCNxCodecSchemaV1StructureContainer child = _childContainer(container, type);
+        if (child != _Container_Opaque) {
+            CCNxCodecErrorCodes code = _validateContainer(packet, valueStart, valueStart + length, child, errorOffset);
+            if (code != TLV_ERR_NO_ERROR) {
+                return code;
+            }
+        }
+
+        offset = valueStart + length;
+    }
+
+    if (offset != end) {
+        return _fail(TLV_ERR_EMPTY_SPACE, offset, errorOffset);
+    }
+    return TLV_ERR_NO_ERROR;
+}
+
+/*
+ * The message region is the message TLV, then optionally the ValidationAlg and ValidationPayload.
+ * Like the packet decoder, ignore anything after the ValidationPayload.
+ */
+static CCNxCodecErrorCodes
+_validateMessageRegion(const uint8_t *packet, size_t start, size_t end, size_t *errorOffset)
+{
+    if (end - start < _tlvHeaderBytes) {
+        return _fail((start == end) ? TLV_MISSING_MANDATORY : TLV_ERR_EMPTY_SPACE, start, errorOffset);
+    }
+
+    size_t offset = start;
+    for (int field = 0; field < 3 && offset < end; field++) {
+        if (end - offset < _tlvHeaderBytes) {
+            return _fail(TLV_ERR_EMPTY_SPACE, offset, errorOffset);
+        }
+
+        uint16_t type;
+        uint16_t length;
+        _readTlvHeader(&packet[offset], &type, &length);
+
+        size_t valueStart = offset + _tlvHeaderBytes;
+        if (length > end - valueStart) {
+            return _fail(TLV_ERR_TOO_LONG, offset, errorOffset);
+        }
+
+        _CCNxCodecSchemaV1StructureContainer container;
+        switch (field) {
+            case 0:
+                switch (type) {
+                    case CCNxCodecSchemaV1Types_MessageType_Interest: // fallthrough
+                    case CCNxCodecSchemaV1Types_MessageType_ContentObject:
+                        container = _Container_Message;
+                        break;
+                    case CCNxCodecSchemaV1Types_MessageType_Manifest:
+                        container = _Container_Manifest;
+                        break;
+                    case CCNxCodecSchemaV1Types_MessageType_Control:
+                        // The control message body is JSON, not TLVs
+                        container = _Container_Opaque;
+                        break;
+                    default:
+                        return _fail(TLV_ERR_DECODE, offset, errorOffset);
+                }
+                break;
+
+            case 1:
+                if (type != CCNxCodecSchemaV1Types_MessageType_ValidationAlg) {
+                    return _fail(TLV_ERR_DECODE, offset, errorOffset);
+                }
+                container = _Container_ValidationAlg;
+                break;
+
+            default:
+                if (type != CCNxCodecSchemaV1Types_MessageType_ValidationPayload) {
+                    return _fail(TLV_ERR_DECODE, offset, errorOffset);
+                }
+                container = _Container_Opaque;
+                break;
+        }
+
+        if (container != _Container_Opaque) {
+            CCNxCodecErrorCodes code = _validateContainer(packet, valueStart, valueStart + length, container, errorOffset);
+            if (code != TLV_ERR_NO_ERROR) {
+                return code;
+            }
+        }
+
+        offset = valueStart + length;
+        if (field == 1 && offset == end) {
+            // A ValidationAlg must be followed by its ValidationPayload
+            return _fail(TLV_MISSING_MANDATORY, offset, errorOffset);
+        }
+    }
+
+    return TLV_ERR_NO_ERROR;
+}
+
+CCNxCodecErrorCodes
+ccnxCodecSchemaV1StructureValidator_Validate(size_t length, const uint8_t packet[length], size_t *errorOffset)
+{
+    if (length < sizeof(CCNxCodecSchemaV1FixedHeader)) {
+        return _fail(TLV_ERR_PACKETLENGTH_TOO_SHORT, _fixedHeader_PacketLengthOffset, errorOffset);
+    }
+
+    CCNxCodecSchemaV1FixedHeader header;
+    memcpy(&header, packet, sizeof(header));
+
+    size_t packetLength = htons(header.packetLength);
+    size_t headerLength = header.headerLength;
+
+    if (header.version != 1) {
+        return _fail(TLV_ERR_VERSION, _fixedHeader_VersionOffset, errorOffset);
+    }
+    if (packetLength < sizeof(CCNxCodecSchemaV1FixedHeader)) {
+        return _fail(TLV_ERR_PACKETLENGTH_TOO_SHORT, _fixedHeader_PacketLengthOffset, errorOffset);
+    }
+    if (headerLength < sizeof(CCNxCodecSchemaV1FixedHeader)) {
+        return _fail(TLV_ERR_HEADERLENGTH_TOO_SHORT, _fixedHeader_HeaderLengthOffset, errorOffset);
+    }
+    if (packetLength < headerLength) {
+        return _fail(TLV_ERR_PACKETLENGTHSHORTER, _fixedHeader_PacketLengthOffset, errorOffset);
+    }
+    if (packetLength > length) {
+        return _fail(TLV_ERR_BEYOND_PACKET_END, _fixedHeader_PacketLengthOffset, errorOffset);
+    }
+
+    CCNxCodecErrorCodes code = _validateContainer(packet, sizeof(CCNxCodecSchemaV1FixedHeader), headerLength, _Container_OptionalHeaders, errorOffset);
+    if (code == TLV_ERR_NO_ERROR) {
+        code = _validateMessageRegion(packet, headerLength, packetLength, errorOffset);
+    }
+    return code;
+}
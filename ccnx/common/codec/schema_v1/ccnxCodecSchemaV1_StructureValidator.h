@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2013-2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file ccnxCodecSchemaV1_StructureValidator.h
+ * @brief Checks the TLV structure of a V1 packet before it is decoded
+ *
+ * The decoders find a malformed packet only part way through, after they have created nested decoders,
+ * dictionary entries and a `CCNxCodecError`.  The structure validator makes one pass over the packet in place,
+ * with no allocation, and rejects it up front.
+ *
+ * It checks the fixed header against `packetLength` and `headerLength`, that the message region is a message
+ * TLV followed optionally by a ValidationAlg and ValidationPayload, and that the TLVs inside every container
+ * of the V1 schema exactly fill that container.  As with the packet decoder, bytes after the ValidationPayload
+ * are ignored.  It does not check that values are meaningful, so a packet it
+ * accepts may still fail to decode.
+ *
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+#ifndef CCNxCodecSchemaV1_StructureValidator_h
+#define CCNxCodecSchemaV1_StructureValidator_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ccnx/common/codec/ccnxCodec_ErrorCodes.h>
+
+/**
+ * Check the structure of a V1 packet held in contiguous memory
+ *
+ * The memory must start with the fixed header.  It may be longer than the packet, in which case the bytes
+ * after `packetLength` are not examined.
+ *
+ * The checks, and the error returned when one fails, are:
+ *   - TLV_ERR_PACKETLENGTH_TOO_SHORT: fewer than 8 bytes, or a `packetLength` less than 8.
+ *   - TLV_ERR_VERSION: the version is not 1.
+ *   - TLV_ERR_HEADERLENGTH_TOO_SHORT: a `headerLength` less than 8.
+ *   - TLV_ERR_PACKETLENGTHSHORTER: a `packetLength` less than `headerLength`.
+ *   - TLV_ERR_BEYOND_PACKET_END: a `packetLength` greater than `length`.
+ *   - TLV_ERR_TOO_LONG: a TLV that extends past the end of its container.
+ *   - TLV_ERR_EMPTY_SPACE: one to three bytes left at the end of a container.
+ *   - TLV_MISSING_MANDATORY: no message TLV, or a ValidationAlg without a ValidationPayload.
+ *   - TLV_ERR_DECODE: a TLV in the message region that is not a message, ValidationAlg or ValidationPayload in that order.
+ *
+ * @param [in] length The number of bytes at @p packet.
+ * @param [in] packet The wire format packet.
+ * @param [out] errorOffset If not NULL, set to the byte offset in the packet of the TLV or header field that failed.
+ *
+ * @return TLV_ERR_NO_ERROR The packet is structurally sound.
+ * @return other The first structural error found.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t errorOffset;
+ *     CCNxCodecErrorCodes code = ccnxCodecSchemaV1StructureValidator_Validate(length, packet, &errorOffset);
+ *     if (code != TLV_ERR_NO_ERROR) {
+ *         // drop it without decoding
+ *     }
+ * }
+ * @endcode
+ */
+CCNxCodecErrorCodes ccnxCodecSchemaV1StructureValidator_Validate(size_t length, const uint8_t packet[length], size_t *errorOffset);
+#endif // CCNxCodecSchemaV1_StructureValidator_h
@@ -120,6 +120,9 @@ typedef enum rta_tlv_schema_v1_headers_fastarray {
  * The ValidationFastArray are fields that may appear in the Validation Algorithm and the Validation Payload field.
  *
  * Note that the ValidationFastArray_CRYPTO_SUITE is always expressed in terms of PARCCryptoSuite.
+ *
+ * ValidationFastArray_UNSIGNED is not on the wire.  It marks a packet that must be encoded without a
+ * ValidationAlg even if the encoder has a signer, because it is bound by its ContentObjectHash in a manifest.
  */
 typedef enum rta_tlv_schema_v1_validation_fastarray {
     CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_KEYID = CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_END + 0,
@@ -131,7 +134,8 @@ typedef enum rta_tlv_schema_v1_validation_fastarray {
     CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_KEYNAME_OBJHASH = CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_END + 6,
     CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_PAYLOAD = CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_END + 7,
     CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_SIGNTIME = CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_END + 8,
-    CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_END = CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_END + 9
+    CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_UNSIGNED = CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_END + 9,    /***< Virtual field */
+    CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_END = CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_END + 10
 } CCNxCodecSchemaV1TlvDictionary_ValidationFastArray;
 
 
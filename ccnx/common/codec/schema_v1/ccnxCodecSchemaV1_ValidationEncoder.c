@@ -260,6 +260,40 @@ ccnxCodecSchemaV1ValidationEncoder_EncodeAlg(CCNxCodecTlvEncoder *encoder, CCNxT
     return length;
 }
 
+/**
+ * The bytes in a digest of the given type.  An unknown type is taken to be as long as SHA512.
+ */
+static size_t
+_digestLength(PARCCryptoHashType hashType)
+{
+    switch (hashType) {
+        case PARCCryptoHashType_CRC32C:
+            return 4;
+        case PARCCryptoHashType_SHA256:
+            return 32;
+        default:
+            return 64;
+    }
+}
+
+/**
+ * The largest signature the signer produces, which is what a measuring encoder accounts for in place
+ * of the signature it cannot compute.  An HMAC is as long as the signer's digest; other algorithms
+ * are bounded by their key size (up to 4096-bit RSA).
+ */
+static size_t
+_signatureLengthBound(PARCSigner *signer)
+{
+    switch (parcSigner_GetSigningAlgorithm(signer)) {
+        case PARCSigningAlgorithm_HMAC:
+            return _digestLength(parcSigner_GetCryptoHashType(signer));
+        case PARCSigningAlgorithm_ECDSA:
+            return 72;
+        default:
+            return 512;
+    }
+}
+
 ssize_t
 ccnxCodecSchemaV1ValidationEncoder_EncodePayload(CCNxCodecTlvEncoder *encoder, CCNxTlvDictionary *packetDictionary)
 {
@@ -270,6 +304,16 @@ ccnxCodecSchemaV1ValidationEncoder_EncodePayload(CCNxCodecTlvEncoder *encoder, C
 
         // If signer is NULL, then no signature is genearted
         PARCSigner *signer = ccnxCodecTlvEncoder_GetSigner(encoder);
+        if (signer != NULL && ccnxCodecTlvEncoder_IsMeasuring(encoder)) {
+            // nothing to sign yet, so measure the largest signature and leave the dictionary alone
+            return ccnxCodecTlvEncoder_AppendRawArray(encoder, _signatureLengthBound(signer), NULL);
+        }
+
+        if (signer != NULL && ccnxCodecTlvEncoder_IsSignatureDeferred(encoder)) {
+            // the caller signs the digest later and appends the payload itself
+            return 0;
+        }
+
         if (signer != NULL) {
             // user did not give us one, so fill it in
             PARCSignature *signature = ccnxCodecTlvEncoder_ComputeSignature(encoder);
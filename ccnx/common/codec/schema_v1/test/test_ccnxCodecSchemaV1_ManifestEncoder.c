@@ -62,12 +62,17 @@
 #include "testrig_encoder.c"
 
 #include <ccnx/common/ccnx_Manifest.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_ManifestDecoder.h>
+#include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_TlvDictionary.h>
+
+#include <sys/time.h>
 
 // =========================================================================
 
 LONGBOW_TEST_RUNNER(ccnxCodecSchemaV1_ManifestEncoder)
 {
     LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -92,6 +97,7 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestEncoder_EncodeSingleHashGroup);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestEncoder_EncodeSingleHashGroup_WithMetadata);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestEncoder_AddPointer);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1ManifestEncoder_EncodeDecode_GroupOrder);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -335,6 +341,164 @@ LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1ManifestEncoder_EncodeSingleHashGroup
     ccnxName_Release(&locator);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1ManifestEncoder_EncodeDecode_GroupOrder)
+{
+    CCNxName *locator = ccnxName_CreateFromCString("ccnx:/name");
+    CCNxManifest *manifest = ccnxManifest_Create(locator);
+
+    CCNxManifestHashGroup *groups[3];
+    for (int g = 0; g < 3; g++) {
+        groups[g] = ccnxManifestHashGroup_Create();
+        for (int p = 0; p <= g; p++) {
+            PARCBuffer *digest = parcBuffer_Flip(parcBuffer_PutUint32(parcBuffer_Allocate(4), (uint32_t) (g << 8 | p)));
+            ccnxManifestHashGroup_AppendPointer(groups[g], CCNxManifestHashGroupPointerType_Data, digest);
+            parcBuffer_Release(&digest);
+        }
+        ccnxManifest_AddHashGroup(manifest, groups[g]);
+    }
+
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    ccnxCodecSchemaV1ManifestEncoder_Encode(encoder, manifest);
+    ccnxCodecTlvEncoder_Finalize(encoder);
+    PARCBuffer *encoded = ccnxCodecTlvEncoder_CreateBuffer(encoder);
+
+    CCNxTlvDictionary *decoded = ccnxCodecSchemaV1TlvDictionary_CreateManifest();
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(encoded);
+    assertTrue(ccnxCodecSchemaV1ManifestDecoder_Decode(decoder, decoded), "Failed to decode the manifest");
+
+    assertTrue(ccnxManifest_GetNumberOfHashGroups(decoded) == 3, "Expected 3 groups, got %zu", ccnxManifest_GetNumberOfHashGroups(decoded));
+    for (int g = 0; g < 3; g++) {
+        CCNxManifestHashGroup *actual = ccnxManifest_GetHashGroupByIndex(decoded, g);
+        assertTrue(ccnxManifestHashGroup_Equals(groups[g], actual), "Group %d differs after encode and decode", g);
+        ccnxManifestHashGroup_Release(&actual);
+        ccnxManifestHashGroup_Release(&groups[g]);
+    }
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    ccnxTlvDictionary_Release(&decoded);
+    parcBuffer_Release(&encoded);
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+    ccnxManifest_Release(&manifest);
+    ccnxName_Release(&locator);
+}
+
+// =========================================================================
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxCodecSchemaV1ManifestEncoder_EncodeDecode_LargeGroups);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_elapsedSeconds(const struct timeval *t0)
+{
+    struct timeval t1;
+    gettimeofday(&t1, NULL);
+    timersub(&t1, t0, &t1);
+    return t1.tv_sec + t1.tv_usec * 1E-6;
+}
+
+/*
+ * Encodes and decodes a manifest of 4 hash groups with 1500 SHA-256 pointers each.
+ * The JSON round trip line is the cost that storing groups as JSON strings added to every group access.
+ */
+LONGBOW_TEST_CASE(Performance, ccnxCodecSchemaV1ManifestEncoder_EncodeDecode_LargeGroups)
+{
+    const size_t groupCount = 4;
+    const size_t pointerCount = 1500;
+    const unsigned trials = 20;
+
+    CCNxName *locator = ccnxName_CreateFromCString("ccnx:/name");
+    CCNxManifest *manifest = ccnxManifest_Create(locator);
+    for (size_t g = 0; g < groupCount; g++) {
+        CCNxManifestHashGroup *group = ccnxManifestHashGroup_Create();
+        for (size_t p = 0; p < pointerCount; p++) {
+            PARCBuffer *digest = parcBuffer_Allocate(32);
+            parcBuffer_PutUint64(digest, g);
+            parcBuffer_PutUint64(digest, p);
+            parcBuffer_SetPosition(digest, 32);
+            parcBuffer_Flip(digest);
+            ccnxManifestHashGroup_AppendPointer(group, CCNxManifestHashGroupPointerType_Data, digest);
+            parcBuffer_Release(&digest);
+        }
+        ccnxManifest_AddHashGroup(manifest, group);
+        ccnxManifestHashGroup_Release(&group);
+    }
+
+    struct timeval t0;
+    PARCBuffer *encoded = NULL;
+    gettimeofday(&t0, NULL);
+    for (unsigned i = 0; i < trials; i++) {
+        CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+        ccnxCodecSchemaV1ManifestEncoder_Encode(encoder, manifest);
+        ccnxCodecTlvEncoder_Finalize(encoder);
+        if (encoded != NULL) {
+            parcBuffer_Release(&encoded);
+        }
+        encoded = ccnxCodecTlvEncoder_CreateBuffer(encoder);
+        ccnxCodecTlvEncoder_Destroy(&encoder);
+    }
+    double seconds = _elapsedSeconds(&t0);
+    printf("\n%-16s iterations %u seconds %.3f us/manifest %.1f\n", "Encode", trials, seconds, seconds * 1E6 / trials);
+
+    CCNxTlvDictionary *decoded = NULL;
+    gettimeofday(&t0, NULL);
+    for (unsigned i = 0; i < trials; i++) {
+        if (decoded != NULL) {
+            ccnxTlvDictionary_Release(&decoded);
+        }
+        decoded = ccnxCodecSchemaV1TlvDictionary_CreateManifest();
+        CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(encoded);
+        bool success = ccnxCodecSchemaV1ManifestDecoder_Decode(decoder, decoded);
+        assertTrue(success, "Failed to decode the manifest");
+        ccnxCodecTlvDecoder_Destroy(&decoder);
+        parcBuffer_Rewind(encoded);
+    }
+    seconds = _elapsedSeconds(&t0);
+    printf("\n%-16s iterations %u seconds %.3f us/manifest %.1f\n", "Decode", trials, seconds, seconds * 1E6 / trials);
+    assertTrue(ccnxManifest_GetNumberOfHashGroups(decoded) == groupCount, "Expected %zu groups, got %zu",
+               groupCount, ccnxManifest_GetNumberOfHashGroups(decoded));
+
+    gettimeofday(&t0, NULL);
+    for (unsigned i = 0; i < trials; i++) {
+        for (size_t g = 0; g < groupCount; g++) {
+            CCNxManifestHashGroup *group = ccnxManifest_GetHashGroupByIndex(manifest, g);
+            PARCJSON *json = ccnxManifestHashGroup_ToJson(group);
+            char *jsonString = parcJSON_ToString(json);
+            PARCJSON *parsed = parcJSON_ParseString(jsonString);
+            CCNxManifestHashGroup *copy = ccnxManifestHashGroup_CreateFromJson(parsed);
+
+            ccnxManifestHashGroup_Release(&copy);
+            parcJSON_Release(&parsed);
+            parcMemory_Deallocate(&jsonString);
+            parcJSON_Release(&json);
+            ccnxManifestHashGroup_Release(&group);
+        }
+    }
+    seconds = _elapsedSeconds(&t0);
+    printf("\n%-16s iterations %u seconds %.3f us/manifest %.1f\n", "JSON round trip", trials, seconds, seconds * 1E6 / trials);
+
+    ccnxTlvDictionary_Release(&decoded);
+    parcBuffer_Release(&encoded);
+    ccnxManifest_Release(&manifest);
+    ccnxName_Release(&locator);
+}
+
 int
 main(int argc, char *argv[])
 {
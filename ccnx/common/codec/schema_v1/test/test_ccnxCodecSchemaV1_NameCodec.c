@@ -82,6 +82,10 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvCodecName_Decode_RightType);
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvCodecName_Decode_WrongType);
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvCodecName_Encode);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxTlvCodecName_DecodeValue_Malformed);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxTlvCodecName_DecodeView_RightType);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxTlvCodecName_DecodeView_WrongType);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxTlvCodecName_DecodeView_Malformed);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -168,6 +172,76 @@ LONGBOW_TEST_CASE(Global, ccnxTlvCodecName_Encode)
     parcBuffer_Release(&truth);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxTlvCodecName_DecodeValue_Malformed)
+{
+    // The segment length 0x0B runs one byte past the end of the name
+    uint8_t decodeBytes[] = { 0x00, CCNxNameLabelType_NAME, 0x00, 0x0B, 'b', 'r', 'a', 'n', 'd', 'y', 'w', 'i', 'n', 'e' };
+    PARCBuffer *decodeBuffer = parcBuffer_Wrap(decodeBytes, sizeof(decodeBytes), 0, sizeof(decodeBytes));
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(decodeBuffer);
+    CCNxName *test = ccnxCodecSchemaV1NameCodec_DecodeValue(decoder, sizeof(decodeBytes));
+
+    assertNull(test, "Name should have returned NULL because the segment overruns the name");
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    parcBuffer_Release(&decodeBuffer);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxTlvCodecName_DecodeView_RightType)
+{
+    CCNxName *truth = ccnxName_CreateFromCString("lci:/brandywine");
+
+    uint8_t decodeBytes[] = { 0x10, 0x20, 0x00, 0x0E, 0x00, CCNxNameLabelType_NAME, 0x00, 0x0A, 'b', 'r', 'a', 'n', 'd', 'y', 'w', 'i', 'n', 'e' };
+    PARCBuffer *decodeBuffer = parcBuffer_Wrap(decodeBytes, sizeof(decodeBytes), 0, sizeof(decodeBytes));
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(decodeBuffer);
+
+    uint32_t allocations = parcMemory_Outstanding();
+    CCNxNameView view;
+    bool success = ccnxCodecSchemaV1NameCodec_DecodeView(decoder, 0x1020, &view);
+    assertTrue(parcMemory_Outstanding() == allocations, "Decoding a view should not allocate memory");
+
+    assertTrue(success, "Expected the view to decode");
+    assertTrue(ccnxNameView_EqualsName(&view, truth), "Name segments do not match");
+    assertTrue(ccnxCodecTlvDecoder_Position(decoder) == sizeof(decodeBytes),
+               "Position should be at the end, expected %zu, got %zu", sizeof(decodeBytes), ccnxCodecTlvDecoder_Position(decoder));
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    parcBuffer_Release(&decodeBuffer);
+    ccnxName_Release(&truth);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxTlvCodecName_DecodeView_WrongType)
+{
+    uint8_t decodeBytes[] = { 0x10, 0x20, 0x00, 0x0E, 0x00, CCNxNameLabelType_NAME, 0x00, 0x0A, 'b', 'r', 'a', 'n', 'd', 'y', 'w', 'i', 'n', 'e' };
+    PARCBuffer *decodeBuffer = parcBuffer_Wrap(decodeBytes, sizeof(decodeBytes), 0, sizeof(decodeBytes));
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(decodeBuffer);
+
+    CCNxNameView view;
+    bool success = ccnxCodecSchemaV1NameCodec_DecodeView(decoder, 0xFFFF, &view);
+
+    assertFalse(success, "Expected false because the name type does not match");
+    assertTrue(ccnxCodecTlvDecoder_Position(decoder) == 0, "Position should not have moved, expected 0, got %zu", ccnxCodecTlvDecoder_Position(decoder));
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    parcBuffer_Release(&decodeBuffer);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxTlvCodecName_DecodeView_Malformed)
+{
+    // The name segment says it is 10 bytes long, but the name value only holds 2 of them
+    uint8_t decodeBytes[] = { 0x10, 0x20, 0x00, 0x06, 0x00, CCNxNameLabelType_NAME, 0x00, 0x0A, 'b', 'r' };
+    PARCBuffer *decodeBuffer = parcBuffer_Wrap(decodeBytes, sizeof(decodeBytes), 0, sizeof(decodeBytes));
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(decodeBuffer);
+
+    CCNxNameView view;
+    bool success = ccnxCodecSchemaV1NameCodec_DecodeView(decoder, 0x1020, &view);
+
+    assertFalse(success, "Expected false because the name segment overruns the name");
+    assertTrue(ccnxCodecTlvDecoder_Position(decoder) == 0, "Position should not have moved, expected 0, got %zu", ccnxCodecTlvDecoder_Position(decoder));
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    parcBuffer_Release(&decodeBuffer);
+}
+
 int
 main(int argc, char *argv[])
 {
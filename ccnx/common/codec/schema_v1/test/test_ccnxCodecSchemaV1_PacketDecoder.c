@@ -86,6 +86,7 @@ LONGBOW_TEST_RUNNER(ccnxCodecSchemaV1_PacketDecoder)
     LONGBOW_RUN_TEST_FIXTURE(ContentObject);
     LONGBOW_RUN_TEST_FIXTURE(Control);
     LONGBOW_RUN_TEST_FIXTURE(Interest);
+    LONGBOW_RUN_TEST_FIXTURE(Lazy);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -714,6 +715,150 @@ LONGBOW_TEST_CASE(Interest, interest_validation_alg_overrun)
 
 // =========================================================================
 
+LONGBOW_TEST_FIXTURE(Lazy)
+{
+    LONGBOW_RUN_TEST_CASE(Lazy, ccnxCodecSchemaV1PacketDecoder_LazyDecode_OnFirstTouch);
+    LONGBOW_RUN_TEST_CASE(Lazy, ccnxCodecSchemaV1PacketDecoder_LazyDecode_Regions);
+    LONGBOW_RUN_TEST_CASE(Lazy, ccnxCodecSchemaV1PacketDecoder_LazyDecode_BadContainers);
+    LONGBOW_RUN_TEST_CASE(Lazy, ccnxCodecSchemaV1PacketDecoder_LazyDecode_BadSection);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Lazy)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Lazy)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * Does the same as ccnxCodecSchemaV1PacketDecoder_LazyDecode(), but keeps the state so the test can see what is pending.
+ */
+LONGBOW_TEST_CASE(Lazy, ccnxCodecSchemaV1PacketDecoder_LazyDecode_OnFirstTouch)
+{
+    PARCBuffer *packetBuffer = parcBuffer_Wrap(v1_content_nameA_keyid1_rsasha256, sizeof(v1_content_nameA_keyid1_rsasha256), 0, sizeof(v1_content_nameA_keyid1_rsasha256));
+    CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateContentObject();
+
+    _CCNxCodecSchemaV1LazyState *state = parcMemory_AllocateAndClear(sizeof(_CCNxCodecSchemaV1LazyState));
+    state->packet = parcBuffer_Slice(packetBuffer);
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(packetBuffer);
+    bool success = _lazyScan(decoder, dictionary, state);
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    assertTrue(success, "Failed to scan the packet");
+    ccnxTlvDictionary_SetLazyDecoder(dictionary, _ccnxCodecSchemaV1PacketDecoder_LazyDecoder, state, _ccnxCodecSchemaV1LazyState_Free);
+
+    unsigned all = (1u << _LazySection_Count) - 1;
+    assertTrue(state->pending == all, "Expected every section pending, got 0x%X", state->pending);
+
+    CCNxName *name = CCNxContentObjectFacadeV1_Implementation.getName(dictionary);
+    CCNxName *trueName = ccnxName_CreateFromCString(v1_content_nameA_keyid1_rsasha256_URI);
+    assertTrue(ccnxName_Equals(name, trueName), "Wrong name")
+    {
+        ccnxName_Display(trueName, 3);
+        ccnxName_Display(name, 3);
+    }
+    assertTrue(state->pending == (all & ~(1u << _LazySection_Message)), "Expected only the message decoded, got 0x%X", state->pending);
+
+    PARCBuffer *keyid = ccnxValidationFacadeV1_GetKeyId(dictionary);
+    assertNotNull(keyid, "Expected the keyid from the validation section");
+    assertTrue(state->pending == (1u << _LazySection_OptionalHeaders), "Expected only the optional headers pending, got 0x%X", state->pending);
+
+    assertTrue(ccnxTlvDictionary_LazyDecodeAll(dictionary), "Expected every section to decode");
+    assertTrue(state->pending == 0, "Expected nothing pending, got 0x%X", state->pending);
+
+    ccnxName_Release(&trueName);
+    ccnxTlvDictionary_Release(&dictionary);
+    parcBuffer_Release(&packetBuffer);
+}
+
+LONGBOW_TEST_CASE(Lazy, ccnxCodecSchemaV1PacketDecoder_LazyDecode_Regions)
+{
+    PARCBuffer *packetBuffer = parcBuffer_Wrap(v1_interest_nameA_crc32c, sizeof(v1_interest_nameA_crc32c), 0, sizeof(v1_interest_nameA_crc32c));
+
+    CCNxTlvDictionary *expected = ccnxCodecSchemaV1TlvDictionary_CreateInterest();
+    assertTrue(ccnxCodecSchemaV1PacketDecoder_BufferDecode(packetBuffer, expected), "Failed to decode");
+
+    CCNxTlvDictionary *actual = ccnxCodecSchemaV1TlvDictionary_CreateInterest();
+    assertTrue(ccnxCodecSchemaV1PacketDecoder_LazyDecode(packetBuffer, actual), "Failed to lazily decode");
+
+    // The regions come from the scan, before any section is decoded
+    uint32_t keys[] = {
+        CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ProtectedStart,
+        CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ProtectedLength,
+        CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ContentObjectHashRegionStart,
+        CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ContentObjectHashRegionLength,
+    };
+    for (int i = 0; i < sizeof(keys) / sizeof(keys[0]); i++) {
+        uint64_t truth = ccnxTlvDictionary_GetInteger(expected, keys[i]);
+        uint64_t test = ccnxTlvDictionary_GetInteger(actual, keys[i]);
+        assertTrue(test == truth, "Key %u expected %" PRIu64 " got %" PRIu64, keys[i], truth, test);
+    }
+
+    ccnxTlvDictionary_Release(&actual);
+    ccnxTlvDictionary_Release(&expected);
+    parcBuffer_Release(&packetBuffer);
+}
+
+/*
+ * Errors in the outer containers are found by the scan, just like the full decode.
+ */
+LONGBOW_TEST_CASE(Lazy, ccnxCodecSchemaV1PacketDecoder_LazyDecode_BadContainers)
+{
+    struct {
+        size_t length;
+        uint8_t *packet;
+    } cases[] = {
+        { sizeof(v1_interest_bad_message_length),     v1_interest_bad_message_length     },
+        { sizeof(v1_interest_bad_validation_alg),     v1_interest_bad_validation_alg     },
+        { sizeof(v1_interest_validation_alg_overrun), v1_interest_validation_alg_overrun },
+    };
+
+    for (int i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        PARCBuffer *packetBuffer = parcBuffer_Wrap(cases[i].packet, cases[i].length, 0, cases[i].length);
+        CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateInterest();
+        bool success = ccnxCodecSchemaV1PacketDecoder_LazyDecode(packetBuffer, dictionary);
+        assertFalse(success, "Case %d should have failed the scan", i);
+        ccnxTlvDictionary_Release(&dictionary);
+        parcBuffer_Release(&packetBuffer);
+    }
+}
+
+/*
+ * An error inside a section is only found when that section is decoded.
+ */
+LONGBOW_TEST_CASE(Lazy, ccnxCodecSchemaV1PacketDecoder_LazyDecode_BadSection)
+{
+    // A proper ValidationAlg container holding a TLV that runs past its end
+    uint8_t packet[sizeof(v1_interest_bad_validation_alg)];
+    memcpy(packet, v1_interest_bad_validation_alg, sizeof(packet));
+    packet[50] = 0x03;
+    packet[56] = 0x09;
+
+    PARCBuffer *packetBuffer = parcBuffer_Wrap(packet, sizeof(packet), 0, sizeof(packet));
+    CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateInterest();
+    assertFalse(ccnxCodecSchemaV1PacketDecoder_BufferDecode(packetBuffer, dictionary), "The full decode should fail");
+    ccnxTlvDictionary_Release(&dictionary);
+
+    dictionary = ccnxCodecSchemaV1TlvDictionary_CreateInterest();
+    assertTrue(ccnxCodecSchemaV1PacketDecoder_LazyDecode(packetBuffer, dictionary), "The scan should pass");
+
+    CCNxName *name = ccnxTlvDictionary_GetName(dictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_NAME);
+    assertNotNull(name, "The message section is fine and should decode");
+    assertFalse(ccnxTlvDictionary_LazyDecodeAll(dictionary), "The validation section should fail to decode");
+
+    ccnxTlvDictionary_Release(&dictionary);
+    parcBuffer_Release(&packetBuffer);
+}
+
+// =========================================================================
+
 
 int
 main(int argc, char *argv[])
@@ -69,6 +69,10 @@
 #include <ccnx/common/ccnx_ContentObject.h>
 
 #include <ccnx/common/validation/ccnxValidation_CRC32C.h>
+#include <ccnx/common/validation/ccnxValidation_HmacSha256.h>
+
+#include <parc/security/parc_SymmetricKeySigner.h>
+#include <parc/security/parc_SymmetricKeyStore.h>
 
 
 // =========================================================================
@@ -105,6 +109,10 @@ LONGBOW_TEST_FIXTURE(ContentObject)
     LONGBOW_RUN_TEST_CASE(ContentObject, zero_length_payload);
     LONGBOW_RUN_TEST_CASE(ContentObject, null_payload);
     LONGBOW_RUN_TEST_CASE(ContentObject, no_cryptosuite);
+    LONGBOW_RUN_TEST_CASE(ContentObject, unsigned_with_signer);
+    LONGBOW_RUN_TEST_CASE(ContentObject, DictionaryEncode_SingleIoVec);
+    LONGBOW_RUN_TEST_CASE(ContentObject, DictionaryEncode_SignedSingleIoVec);
+    LONGBOW_RUN_TEST_CASE(ContentObject, DictionaryEncode_HmacSha512SingleIoVec);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(ContentObject)
@@ -275,6 +283,129 @@ LONGBOW_TEST_CASE(ContentObject, null_payload)
     ccnxName_Release(&name);
 }
 
+/*
+ * An 8 KB content object spans several default memory blocks, but DictionaryEncode measures
+ * it first so it should come out as one iovec with the same bytes as an unmeasured encoding.
+ */
+LONGBOW_TEST_CASE(ContentObject, DictionaryEncode_SingleIoVec)
+{
+    CCNxName *name = ccnxName_CreateFromCString("lci:/large/payload");
+    PARCBuffer *payload = parcBuffer_Allocate(8192);
+    for (size_t i = 0; i < 8192; i++) {
+        parcBuffer_PutUint8(payload, (uint8_t) i);
+    }
+    parcBuffer_Flip(payload);
+
+    CCNxTlvDictionary *message =
+        ccnxContentObject_CreateWithImplAndPayload(&CCNxContentObjectFacadeV1_Implementation,
+                                                   name, CCNxPayloadType_DATA, payload);
+
+    CCNxCodecNetworkBufferIoVec *iovec = ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(message, NULL);
+    assertNotNull(iovec, "Got null iovec from ccnxCodecSchemaV1PacketEncoder_DictionaryEncode");
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(iovec) == 1, "Expected 1 iovec, got %d", ccnxCodecNetworkBufferIoVec_GetCount(iovec));
+
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    ssize_t length = ccnxCodecSchemaV1PacketEncoder_Encode(encoder, message);
+    ccnxCodecTlvEncoder_Finalize(encoder);
+    PARCBuffer *truth = ccnxCodecTlvEncoder_CreateBuffer(encoder);
+
+    assertTrue(ccnxCodecNetworkBufferIoVec_Length(iovec) == length, "Wrong length, expected %zd got %zu", length, ccnxCodecNetworkBufferIoVec_Length(iovec));
+    const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(iovec);
+    PARCBuffer *test = parcBuffer_Wrap(array[0].iov_base, array[0].iov_len, 0, array[0].iov_len);
+    assertTrue(parcBuffer_Equals(test, truth), "Single iovec encoding differs from the default encoding");
+
+    parcBuffer_Release(&test);
+    parcBuffer_Release(&truth);
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+    ccnxCodecNetworkBufferIoVec_Release(&iovec);
+    ccnxTlvDictionary_Release(&message);
+    parcBuffer_Release(&payload);
+    ccnxName_Release(&name);
+}
+
+/*
+ * With no cryptosuite in the dictionary, the signer supplies the ValidationAlg and the SigTime.
+ * Both must be measured along with the signature or the packet would spill into a second block.
+ */
+LONGBOW_TEST_CASE(ContentObject, DictionaryEncode_SignedSingleIoVec)
+{
+    CCNxName *name = ccnxName_CreateFromCString("lci:/large/payload");
+    PARCBuffer *payload = parcBuffer_Allocate(8192);
+    for (size_t i = 0; i < 8192; i++) {
+        parcBuffer_PutUint8(payload, (uint8_t) i);
+    }
+    parcBuffer_Flip(payload);
+
+    CCNxTlvDictionary *message =
+        ccnxContentObject_CreateWithImplAndPayload(&CCNxContentObjectFacadeV1_Implementation,
+                                                   name, CCNxPayloadType_DATA, payload);
+
+    PARCBuffer *secretKey = parcBuffer_WrapCString("abcdefghijklmnopqrstuvwxyx");
+    PARCSigner *signer = ccnxValidationHmacSha256_CreateSigner(secretKey);
+
+    CCNxCodecNetworkBufferIoVec *iovec = ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(message, signer);
+    assertNotNull(iovec, "Got null iovec from ccnxCodecSchemaV1PacketEncoder_DictionaryEncode");
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(iovec) == 1, "Expected 1 iovec, got %d", ccnxCodecNetworkBufferIoVec_GetCount(iovec));
+
+    PARCBuffer *signature = ccnxTlvDictionary_GetBuffer(message, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_PAYLOAD);
+    assertNotNull(signature, "The packet was not signed");
+
+    // fixed header, message, ValidationAlg with SigTime, ValidationPayload
+    const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(iovec);
+    const uint8_t *packet = array[0].iov_base;
+    const CCNxCodecSchemaV1FixedHeader *header = array[0].iov_base;
+    size_t messageLength = 4 + ((packet[header->headerLength + 2] << 8) | packet[header->headerLength + 3]);
+    size_t expected = header->headerLength + messageLength + (4 + 12) + (4 + parcBuffer_Remaining(signature));
+    assertTrue(array[0].iov_len == expected, "Expected %zu bytes, got %zu", expected, array[0].iov_len);
+
+    ccnxCodecNetworkBufferIoVec_Release(&iovec);
+    parcSigner_Release(&signer);
+    parcBuffer_Release(&secretKey);
+    ccnxTlvDictionary_Release(&message);
+    parcBuffer_Release(&payload);
+    ccnxName_Release(&name);
+}
+
+/*
+ * An HMAC-SHA512 signature is 64 bytes, so the measured bound must come from the signer's hash
+ * type or the signature would spill into a second block.
+ */
+LONGBOW_TEST_CASE(ContentObject, DictionaryEncode_HmacSha512SingleIoVec)
+{
+    CCNxName *name = ccnxName_CreateFromCString("lci:/large/payload");
+    PARCBuffer *payload = parcBuffer_Allocate(8192);
+    for (size_t i = 0; i < 8192; i++) {
+        parcBuffer_PutUint8(payload, (uint8_t) i);
+    }
+    parcBuffer_Flip(payload);
+
+    CCNxTlvDictionary *message =
+        ccnxContentObject_CreateWithImplAndPayload(&CCNxContentObjectFacadeV1_Implementation,
+                                                   name, CCNxPayloadType_DATA, payload);
+
+    PARCBuffer *secretKey = parcBuffer_WrapCString("abcdefghijklmnopqrstuvwxyx");
+    PARCSymmetricKeyStore *keyStore = parcSymmetricKeyStore_Create(secretKey);
+    PARCSymmetricKeySigner *symmetricSigner = parcSymmetricKeySigner_Create(keyStore, PARCCryptoHashType_SHA512);
+    PARCSigner *signer = parcSigner_Create(symmetricSigner, PARCSymmetricKeySignerAsSigner);
+    parcSymmetricKeySigner_Release(&symmetricSigner);
+    parcSymmetricKeyStore_Release(&keyStore);
+
+    CCNxCodecNetworkBufferIoVec *iovec = ccnxCodecSchemaV1PacketEncoder_DictionaryEncode(message, signer);
+    assertNotNull(iovec, "Got null iovec from ccnxCodecSchemaV1PacketEncoder_DictionaryEncode");
+
+    PARCBuffer *signature = ccnxTlvDictionary_GetBuffer(message, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_PAYLOAD);
+    assertNotNull(signature, "The packet was not signed");
+    assertTrue(parcBuffer_Remaining(signature) == 64, "HMAC-SHA512 should be 64 bytes, got %zu", parcBuffer_Remaining(signature));
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(iovec) == 1, "Expected 1 iovec, got %d", ccnxCodecNetworkBufferIoVec_GetCount(iovec));
+
+    ccnxCodecNetworkBufferIoVec_Release(&iovec);
+    parcSigner_Release(&signer);
+    parcBuffer_Release(&secretKey);
+    ccnxTlvDictionary_Release(&message);
+    parcBuffer_Release(&payload);
+    ccnxName_Release(&name);
+}
+
 /*
  * A content object without a cryptosuite should not be signed
  */
@@ -303,6 +434,44 @@ LONGBOW_TEST_CASE(ContentObject, no_cryptosuite)
     ccnxName_Release(&name);
 }
 
+/*
+ * A content object marked unsigned gets no ValidationAlg or ValidationPayload even though the encoder has a signer,
+ * while the same content object without the mark is signed.
+ */
+LONGBOW_TEST_CASE(ContentObject, unsigned_with_signer)
+{
+    CCNxName *name = ccnxName_CreateFromCString("lci:/no/payload");
+    PARCSigner *signer = ccnxValidationCRC32C_CreateSigner();
+
+    for (int markUnsigned = 0; markUnsigned < 2; markUnsigned++) {
+        CCNxTlvDictionary *message =
+            ccnxContentObject_CreateWithImplAndPayload(&CCNxContentObjectFacadeV1_Implementation,
+                                                       name, CCNxPayloadType_DATA, NULL);
+        if (markUnsigned) {
+            ccnxContentObject_SetUnsigned(message);
+        }
+
+        CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+        ccnxCodecTlvEncoder_SetSigner(encoder, signer);
+        ssize_t length = ccnxCodecSchemaV1PacketEncoder_Encode(encoder, message);
+        assertFalse(length < 0, "Got encoding error: %s", ccnxCodecError_ToString(ccnxCodecTlvEncoder_GetError(encoder)));
+
+        if (markUnsigned) {
+            assertTrue(length == 33, "Unsigned content object should be 33 bytes, got %zd", length);
+            assertFalse(ccnxTlvDictionary_IsValueBuffer(message, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_PAYLOAD),
+                        "Unsigned content object should not get a validation payload");
+        } else {
+            assertTrue(length > 33, "Signed content object should be longer than 33 bytes, got %zd", length);
+        }
+
+        ccnxCodecTlvEncoder_Destroy(&encoder);
+        ccnxTlvDictionary_Release(&message);
+    }
+
+    parcSigner_Release(&signer);
+    ccnxName_Release(&name);
+}
+
 // =========================================================================
 
 LONGBOW_TEST_FIXTURE(Interest)
@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2014-2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * Check that every good test vector passes, and that each kind of structural error is reported
+ * with the right code and offset.
+ *
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../ccnxCodecSchemaV1_StructureValidator.c"
+
+#include <stdio.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+#include <LongBow/unit-test.h>
+
+#include <ccnx/common/codec/ccnxCodec_Error.h>
+
+#include <ccnx/common/codec/schema_v1/testdata/v1_interest_all_fields.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_interest_nameA.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_interest_nameA_crc32c.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_content_nameA_crc32c.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_content_nameA_keyid1_rsasha256.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_content_nameless_nosig.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_content_no_payload.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_content_zero_payload.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_cpi_add_route_crc32c.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_interest_bad_message_length.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_interest_bad_validation_alg.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_interest_validation_alg_overrun.h>
+
+// An Interest whose name has two stray bytes after its last segment
+static uint8_t _nameEmptySpace[] = {
+    0x01, 0x00, 0x00,   26,     // ver = 1, type = interest, length = 26
+    0x20, 0x00, 0x00,    8,     // HopLimit = 32, reserved = 0, header length = 8
+    // ------------------------
+    0x00, 0x01, 0x00,   14,     // type = interest, length = 14
+    0x00, 0x00, 0x00,   10,     // type = name, length = 10
+    0x00, 0x01, 0x00,    4,     // type = name segment, length = 4
+    'a',  'b',  'c',  'd',
+    0xEE, 0xEE,                 // not a TLV
+};
+
+// An Interest with a ValidationAlg but no ValidationPayload
+static uint8_t _missingValidationPayload[] = {
+    0x01, 0x00, 0x00,   32,     // ver = 1, type = interest, length = 32
+    0x20, 0x00, 0x00,    8,     // HopLimit = 32, reserved = 0, header length = 8
+    // ------------------------
+    0x00, 0x01, 0x00,   12,     // type = interest, length = 12
+    0x00, 0x00, 0x00,    8,     // type = name, length = 8
+    0x00, 0x01, 0x00,    4,     // type = name segment, length = 4
+    'a',  'b',  'c',  'd',
+    // ------------------------
+    0x00, 0x03, 0x00,    4,     // validation alg, length = 4
+    0x00, 0x02, 0x00,    0,     // CRC32C
+};
+
+// A Manifest whose hash group metadata holds a TLV longer than the metadata
+static uint8_t _manifestMetadataOverrun[] = {
+    0x01, 0x01, 0x00,   28,     // ver = 1, type = content object, length = 28
+    0x00, 0x00, 0x00,    8,     // reserved = 0, header length = 8
+    // ------------------------
+    0x00, 0x06, 0x00,   16,     // type = manifest, length = 16
+    0x00, 0x07, 0x00,   12,     // type = hash group, length = 12
+    0x00, 0x01, 0x00,    8,     // type = metadata, length = 8
+    0x00, 0x02, 0x00,    8,     // type = block size, length = 8, but only 4 bytes are left
+    0x00, 0x00, 0x10, 0x00,
+};
+
+// A Content Object signed with RSA whose KeyName link has a name segment longer than the name
+static uint8_t _keyNameOverrun[] = {
+    0x01, 0x01, 0x00,   52,     // ver = 1, type = content object, length = 52
+    0x00, 0x00, 0x00,    8,     // reserved = 0, header length = 8
+    // ------------------------
+    0x00, 0x02, 0x00,    8,     // type = content object, length = 8
+    0x00, 0x00, 0x00,    4,     // type = name, length = 4
+    0x00, 0x01, 0x00,    0,     // type = name segment, length = 0
+    // ------------------------
+    0x00, 0x03, 0x00,   20,     // validation alg, length = 20
+    0x00, 0x06, 0x00,   16,     // RSA-SHA256, length = 16
+    0x00, 0x0E, 0x00,   12,     // KeyName, length = 12
+    0x00, 0x00, 0x00,    8,     // type = link name, length = 8
+    0x00, 0x01, 0x00,    9,     // type = name segment, length = 9, but only 4 bytes are left
+    'a',  'b',  'c',  'd',
+    // ------------------------
+    0x00, 0x04, 0x00,    4,     // validation payload, length = 4
+    0x00, 0x00, 0x00, 0x00,
+};
+
+// The offset of the low byte of the length of the KeyName link's name segment
+#define _keyNameOverrun_SegmentLength 39
+
+static void
+_assertValid(const char *label, size_t length, const uint8_t packet[length])
+{
+    size_t errorOffset = 0;
+    CCNxCodecErrorCodes code = ccnxCodecSchemaV1StructureValidator_Validate(length, packet, &errorOffset);
+    assertTrue(code == TLV_ERR_NO_ERROR, "%s: expected no error, got '%s' at offset %zu",
+               label, ccnxCodecError_ErrorMessage(code), errorOffset);
+}
+
+static void
+_assertInvalid(const char *label, size_t length, const uint8_t packet[length], CCNxCodecErrorCodes expectedCode, size_t expectedOffset)
+{
+    size_t errorOffset = 0;
+    CCNxCodecErrorCodes code = ccnxCodecSchemaV1StructureValidator_Validate(length, packet, &errorOffset);
+    assertTrue(code == expectedCode, "%s: expected '%s', got '%s'",
+               label, ccnxCodecError_ErrorMessage(expectedCode), ccnxCodecError_ErrorMessage(code));
+    assertTrue(errorOffset == expectedOffset, "%s: expected offset %zu, got %zu", label, expectedOffset, errorOffset);
+}
+
+LONGBOW_TEST_RUNNER(ccnxCodecSchemaV1_StructureValidator)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(ccnxCodecSchemaV1_StructureValidator)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(ccnxCodecSchemaV1_StructureValidator)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_Good);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_Padded);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_Truncated);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_FixedHeader);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_MessageTooLong);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_ValidationAlg);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_EmptySpace);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_Missing);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_Nested);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_NullErrorOffset);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    if (parcSafeMemory_ReportAllocation(STDOUT_FILENO) != 0) {
+        printf("('%s' leaks memory by %d (allocs - frees)) ", longBowTestCase_GetName(testCase), parcMemory_Outstanding());
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_Good)
+{
+    _assertValid("interest_all_fields", sizeof(v1_interest_all_fields), v1_interest_all_fields);
+    _assertValid("interest_nameA", sizeof(v1_interest_nameA), v1_interest_nameA);
+    _assertValid("interest_nameA_crc32c", sizeof(v1_interest_nameA_crc32c), v1_interest_nameA_crc32c);
+    _assertValid("content_nameA_crc32c", sizeof(v1_content_nameA_crc32c), v1_content_nameA_crc32c);
+    _assertValid("content_nameA_keyid1_rsasha256", sizeof(v1_content_nameA_keyid1_rsasha256), v1_content_nameA_keyid1_rsasha256);
+    _assertValid("content_nameless_nosig", sizeof(v1_content_nameless_nosig), v1_content_nameless_nosig);
+    _assertValid("content_no_payload", sizeof(v1_content_no_payload), v1_content_no_payload);
+    _assertValid("content_zero_payload", sizeof(v1_content_zero_payload), v1_content_zero_payload);
+    _assertValid("cpi_add_route_crc32c", sizeof(v1_cpi_add_route_crc32c), v1_cpi_add_route_crc32c);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_Padded)
+{
+    uint8_t padded[sizeof(v1_interest_all_fields) + 16];
+    memset(padded, 0xFF, sizeof(padded));
+    memcpy(padded, v1_interest_all_fields, sizeof(v1_interest_all_fields));
+
+    _assertValid("padded interest", sizeof(padded), padded);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_Truncated)
+{
+    for (size_t length = 0; length < sizeof(v1_interest_all_fields); length++) {
+        CCNxCodecErrorCodes code = ccnxCodecSchemaV1StructureValidator_Validate(length, v1_interest_all_fields, NULL);
+        assertTrue(code != TLV_ERR_NO_ERROR, "Accepted a packet truncated to %zu bytes", length);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_FixedHeader)
+{
+    uint8_t packet[sizeof(v1_interest_nameA)];
+
+    _assertInvalid("short buffer", 4, v1_interest_nameA, TLV_ERR_PACKETLENGTH_TOO_SHORT, _fixedHeader_PacketLengthOffset);
+    _assertInvalid("truncated packet", sizeof(v1_interest_nameA) - 1, v1_interest_nameA,
+                   TLV_ERR_BEYOND_PACKET_END, _fixedHeader_PacketLengthOffset);
+
+    memcpy(packet, v1_interest_nameA, sizeof(packet));
+    packet[0] = 0xFF;
+    _assertInvalid("version 255", sizeof(packet), packet, TLV_ERR_VERSION, _fixedHeader_VersionOffset);
+
+    memcpy(packet, v1_interest_nameA, sizeof(packet));
+    packet[2] = 0;
+    packet[3] = 4;
+    _assertInvalid("packetLength 4", sizeof(packet), packet, TLV_ERR_PACKETLENGTH_TOO_SHORT, _fixedHeader_PacketLengthOffset);
+
+    memcpy(packet, v1_interest_nameA, sizeof(packet));
+    packet[7] = 4;
+    _assertInvalid("headerLength 4", sizeof(packet), packet, TLV_ERR_HEADERLENGTH_TOO_SHORT, _fixedHeader_HeaderLengthOffset);
+
+    memcpy(packet, v1_interest_nameA, sizeof(packet));
+    packet[7] = 0xFF;
+    _assertInvalid("headerLength 255", sizeof(packet), packet, TLV_ERR_PACKETLENGTHSHORTER, _fixedHeader_PacketLengthOffset);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_MessageTooLong)
+{
+    // The message TLV claims more bytes than the packet has after the fixed header
+    _assertInvalid("bad_message_length", sizeof(v1_interest_bad_message_length), v1_interest_bad_message_length, TLV_ERR_TOO_LONG, 14);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_ValidationAlg)
+{
+    // The ValidationAlg is longer than the rest of the packet
+    _assertInvalid("validation_alg_overrun", sizeof(v1_interest_validation_alg_overrun), v1_interest_validation_alg_overrun,
+                   TLV_ERR_TOO_LONG, 49);
+
+    // The TLV after the message is not a ValidationAlg
+    _assertInvalid("bad_validation_alg", sizeof(v1_interest_bad_validation_alg), v1_interest_bad_validation_alg, TLV_ERR_DECODE, 49);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_EmptySpace)
+{
+    _assertInvalid("name with stray bytes", sizeof(_nameEmptySpace), _nameEmptySpace, TLV_ERR_EMPTY_SPACE, 24);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_Missing)
+{
+    // Only the fixed header of the Interest
+    uint8_t headerOnly[8];
+    memcpy(headerOnly, _missingValidationPayload, sizeof(headerOnly));
+    headerOnly[3] = sizeof(headerOnly);
+    _assertInvalid("no message", sizeof(headerOnly), headerOnly, TLV_MISSING_MANDATORY, 8);
+
+    _assertInvalid("no validation payload", sizeof(_missingValidationPayload), _missingValidationPayload,
+                   TLV_MISSING_MANDATORY, sizeof(_missingValidationPayload));
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_Nested)
+{
+    _assertInvalid("manifest metadata", sizeof(_manifestMetadataOverrun), _manifestMetadataOverrun, TLV_ERR_TOO_LONG, 20);
+
+    // ValidationAlg / RSA-SHA256 / KeyName / Name / segment
+    _assertInvalid("key name segment", sizeof(_keyNameOverrun), _keyNameOverrun, TLV_ERR_TOO_LONG, 36);
+
+    uint8_t packet[sizeof(_keyNameOverrun)];
+    memcpy(packet, _keyNameOverrun, sizeof(packet));
+    packet[_keyNameOverrun_SegmentLength] = 4;
+    _assertValid("key name segment fixed", sizeof(packet), packet);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSchemaV1StructureValidator_Validate_NullErrorOffset)
+{
+    CCNxCodecErrorCodes code = ccnxCodecSchemaV1StructureValidator_Validate(sizeof(_nameEmptySpace), _nameEmptySpace, NULL);
+    assertTrue(code == TLV_ERR_EMPTY_SPACE, "Expected '%s', got '%s'",
+               ccnxCodecError_ErrorMessage(TLV_ERR_EMPTY_SPACE), ccnxCodecError_ErrorMessage(code));
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(ccnxCodecSchemaV1_StructureValidator);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
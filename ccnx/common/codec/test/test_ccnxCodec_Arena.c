@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../ccnxCodec_Arena.c"
+#include <parc/algol/parc_SafeMemory.h>
+#include <LongBow/unit-test.h>
+
+LONGBOW_TEST_RUNNER(ccnxCodec_Arena)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(ccnxCodec_Arena)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(ccnxCodec_Arena)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecArena_Create);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecArena_Allocate_Aligned);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecArena_Allocate_NewChunk);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecArena_Allocate_Large);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecArena_AllocateAndClear);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecArena_AddCleanup);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecArena_Create)
+{
+    CCNxCodecArena *arena = ccnxCodecArena_Create();
+    assertNotNull(arena, "Expected non-null arena");
+    assertTrue(ccnxCodecArena_GetBytesUsed(arena) == 0, "Expected an empty arena, got %zu bytes", ccnxCodecArena_GetBytesUsed(arena));
+    assertTrue(ccnxCodecArena_GetChunkCount(arena) == 0, "Expected no chunks, got %zu", ccnxCodecArena_GetChunkCount(arena));
+
+    CCNxCodecArena *reference = ccnxCodecArena_Acquire(arena);
+    assertTrue(reference == arena, "Expected Acquire to return the same arena");
+    ccnxCodecArena_Release(&reference);
+    ccnxCodecArena_Release(&arena);
+    assertNull(arena, "Expected Release to clear the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecArena_Allocate_Aligned)
+{
+    CCNxCodecArena *arena = ccnxCodecArena_Create();
+
+    uint8_t *previous = NULL;
+    for (size_t length = 1; length < 20; length++) {
+        uint8_t *memory = ccnxCodecArena_Allocate(arena, length);
+        assertTrue(((uintptr_t) memory % _ccnxCodecArena_Alignment) == 0, "Allocation of %zu bytes not aligned: %p", length, (void *) memory);
+        assertTrue(memory > previous, "Expected allocations to move forward");
+        memset(memory, 0xFF, length);
+        previous = memory;
+    }
+    assertTrue(ccnxCodecArena_GetChunkCount(arena) == 0, "Expected the allocations to fit in the first chunk");
+
+    ccnxCodecArena_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecArena_Allocate_NewChunk)
+{
+    CCNxCodecArena *arena = ccnxCodecArena_Create();
+
+    // Fill the built-in chunk exactly, then one more byte needs a chunk from the heap.
+    uint8_t *first = ccnxCodecArena_Allocate(arena, _ccnxCodecArena_InitialSize);
+    memset(first, 0xAA, _ccnxCodecArena_InitialSize);
+    assertTrue(ccnxCodecArena_GetChunkCount(arena) == 0, "Expected the first chunk to hold %d bytes", _ccnxCodecArena_InitialSize);
+
+    uint8_t *second = ccnxCodecArena_Allocate(arena, 1);
+    assertTrue(ccnxCodecArena_GetChunkCount(arena) == 1, "Expected a new chunk, got %zu", ccnxCodecArena_GetChunkCount(arena));
+    *second = 0xBB;
+    assertTrue(first[_ccnxCodecArena_InitialSize - 1] == 0xAA, "The new chunk must not overlap the first");
+
+    ccnxCodecArena_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecArena_Allocate_Large)
+{
+    CCNxCodecArena *arena = ccnxCodecArena_Create();
+
+    size_t length = _ccnxCodecArena_ChunkSize * 3;
+    uint8_t *memory = ccnxCodecArena_Allocate(arena, length);
+    memset(memory, 0xCC, length);
+    assertTrue(ccnxCodecArena_GetChunkCount(arena) == 1, "Expected one chunk for a large allocation, got %zu", ccnxCodecArena_GetChunkCount(arena));
+    assertTrue(ccnxCodecArena_GetBytesUsed(arena) >= length, "Expected at least %zu bytes used, got %zu", length, ccnxCodecArena_GetBytesUsed(arena));
+
+    ccnxCodecArena_Release(&arena);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecArena_AllocateAndClear)
+{
+    CCNxCodecArena *arena = ccnxCodecArena_Create();
+
+    uint8_t *dirty = ccnxCodecArena_Allocate(arena, 64);
+    memset(dirty, 0xFF, 64);
+
+    uint8_t *clean = ccnxCodecArena_AllocateAndClear(arena, 64);
+    for (int i = 0; i < 64; i++) {
+        assertTrue(clean[i] == 0, "Byte %d not cleared", i);
+    }
+
+    ccnxCodecArena_Release(&arena);
+}
+
+typedef struct cleanup_record {
+    int order[3];
+    int count;
+} _CleanupRecord;
+
+typedef struct cleanup_arg {
+    _CleanupRecord *record;
+    int id;
+} _CleanupArg;
+
+static void
+_recordCleanup(void *data)
+{
+    _CleanupArg *arg = data;
+    arg->record->order[arg->record->count++] = arg->id;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecArena_AddCleanup)
+{
+    _CleanupRecord record = { .count = 0 };
+    CCNxCodecArena *arena = ccnxCodecArena_Create();
+
+    for (int i = 0; i < 3; i++) {
+        _CleanupArg *arg = ccnxCodecArena_Allocate(arena, sizeof(_CleanupArg));
+        arg->record = &record;
+        arg->id = i;
+        ccnxCodecArena_AddCleanup(arena, _recordCleanup, arg);
+    }
+
+    CCNxCodecArena *reference = ccnxCodecArena_Acquire(arena);
+    ccnxCodecArena_Release(&arena);
+    assertTrue(record.count == 0, "Cleanups must not run while the arena has references");
+
+    ccnxCodecArena_Release(&reference);
+    assertTrue(record.count == 3, "Expected 3 cleanups, got %d", record.count);
+    assertTrue(record.order[0] == 2 && record.order[1] == 1 && record.order[2] == 0, "Expected cleanups in reverse order");
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(ccnxCodec_Arena);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -71,6 +71,7 @@
 #include <parc/security/parc_Security.h>
 #include <parc/security/parc_Pkcs12KeyStore.h>
 #include <parc/security/parc_PublicKeySigner.h>
+#include <parc/security/parc_CryptoHasher.h>
 
 typedef struct test_data {
     CCNxCodecNetworkBuffer *buffer;
@@ -121,8 +122,10 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_Acquire);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_ComputeSignature);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_UpdateHashers_SpanThree);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_Create);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_CreateFromArray);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_CreateWithCapacity);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_CreateIoVec);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBuffer_Display);
@@ -264,6 +267,52 @@ LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_ComputeSignature)
     parcSecurity_Fini();
 }
 
+/*
+ * Hash a range that starts in the first block and ends in the third, with two hashers at once,
+ * and compare to hashing the flat array.
+ */
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_UpdateHashers_SpanThree)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    size_t arrayLength = 8192;
+    uint8_t array[arrayLength];
+    for (size_t i = 0; i < arrayLength; i++) {
+        array[i] = i * 7;
+    }
+    ccnxCodecNetworkBuffer_PutArray(data->buffer, arrayLength, array);
+    assertNotNull(data->buffer->head->next->next, "Expected the array to span three blocks");
+
+    size_t start = 10;
+    size_t end = arrayLength - 10;
+
+    PARCCryptoHasher *hashers[2] = {
+        parcCryptoHasher_Create(PARCCryptoHashType_SHA256),
+        parcCryptoHasher_Create(PARCCryptoHashType_SHA256)
+    };
+    parcCryptoHasher_Init(hashers[0]);
+    parcCryptoHasher_Init(hashers[1]);
+    ccnxCodecNetworkBuffer_UpdateHashers(data->buffer, start, end, 2, hashers);
+    PARCCryptoHash *first = parcCryptoHasher_Finalize(hashers[0]);
+    PARCCryptoHash *second = parcCryptoHasher_Finalize(hashers[1]);
+
+    parcCryptoHasher_Init(hashers[0]);
+    parcCryptoHasher_UpdateBytes(hashers[0], array + start, end - start);
+    PARCCryptoHash *truth = parcCryptoHasher_Finalize(hashers[0]);
+
+    PARCCryptoHash *digest = ccnxCodecNetworkBuffer_ComputeDigest(data->buffer, start, end, hashers[1]);
+
+    assertTrue(parcCryptoHash_Equals(truth, first), "First hasher has the wrong digest");
+    assertTrue(parcCryptoHash_Equals(truth, second), "Second hasher has the wrong digest");
+    assertTrue(parcCryptoHash_Equals(truth, digest), "ComputeDigest has the wrong digest");
+
+    parcCryptoHash_Release(&digest);
+    parcCryptoHash_Release(&truth);
+    parcCryptoHash_Release(&second);
+    parcCryptoHash_Release(&first);
+    parcCryptoHasher_Release(&hashers[1]);
+    parcCryptoHasher_Release(&hashers[0]);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_Create)
 {
     TestData *data = longBowTestCase_GetClipBoardData(testCase);
@@ -303,6 +352,27 @@ LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_CreateFromArray)
     ccnxCodecNetworkBuffer_Release(&netbuff);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_CreateWithCapacity)
+{
+    size_t length = 10000;
+    uint8_t *memory = parcMemory_AllocateAndClear(length);
+    assertNotNull(memory, "parcMemory_AllocateAndClear(%zu) returned NULL", length);
+
+    CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_CreateWithCapacity(&ParcMemoryMemoryBlock, NULL, length);
+    assertTrue(netbuff->head->capacity == length, "Wrong capacity, expected %zu got %zu", length, netbuff->head->capacity);
+
+    // Filling the block exactly must not add another block
+    ccnxCodecNetworkBuffer_PutArray(netbuff, length, memory);
+    assertTrue(_ccnxCodecNetworkBuffer_BlockCount(netbuff) == 1, "Expected 1 block, got %zu", _ccnxCodecNetworkBuffer_BlockCount(netbuff));
+
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecNetworkBuffer_CreateIoVec(netbuff);
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(vec) == 1, "Expected 1 iovec, got %d", ccnxCodecNetworkBufferIoVec_GetCount(vec));
+
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    ccnxCodecNetworkBuffer_Release(&netbuff);
+    parcMemory_Deallocate((void **) &memory);
+}
+
 
 LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBuffer_CreateIoVec)
 {
@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../ccnxCodec_NetworkBufferPool.c"
+#include <parc/algol/parc_SafeMemory.h>
+#include <LongBow/unit-test.h>
+
+#include <ccnx/common/codec/ccnxCodec_TlvEncoder.h>
+
+LONGBOW_TEST_RUNNER(ccnxCodec_NetworkBufferPool)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(ccnxCodec_NetworkBufferPool)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(ccnxCodec_NetworkBufferPool)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBufferPool_Create);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBufferPool_Allocate_Reuse);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBufferPool_Allocate_Large);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBufferPool_MaxFreeBlocks);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBufferPool_NetworkBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBufferPool_NetworkBuffer_OutlivesPool);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBufferPool_RemoteReturn);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBufferPool_RemoteAllocate);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBufferPool_ThreadPool);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBufferPool_ThreadPool_Encoder);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecNetworkBufferPool_Display);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static CCNxCodecNetworkBufferPoolStatistics
+_getStatistics(const CCNxCodecNetworkBufferPool *pool)
+{
+    CCNxCodecNetworkBufferPoolStatistics statistics;
+    ccnxCodecNetworkBufferPool_GetStatistics(pool, &statistics);
+    return statistics;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBufferPool_Create)
+{
+    CCNxCodecNetworkBufferPool *pool = ccnxCodecNetworkBufferPool_Create(CCNxCodecNetworkBufferPool_JumboBlockSize, 8);
+    assertNotNull(pool, "Expected non-null pool");
+    assertTrue(ccnxCodecNetworkBufferPool_GetBlockSize(pool) == CCNxCodecNetworkBufferPool_JumboBlockSize,
+               "Wrong block size, expected %zu got %zu", CCNxCodecNetworkBufferPool_JumboBlockSize, ccnxCodecNetworkBufferPool_GetBlockSize(pool));
+
+    CCNxCodecNetworkBufferPoolStatistics statistics = _getStatistics(pool);
+    assertTrue(statistics.maxFreeBlocks == 8, "Wrong maxFreeBlocks, got %zu", statistics.maxFreeBlocks);
+    assertTrue(statistics.freeBlocks == 0, "Expected an empty pool, got %zu free blocks", statistics.freeBlocks);
+    assertTrue(statistics.outstandingBlocks == 0, "Expected no outstanding blocks, got %zu", statistics.outstandingBlocks);
+
+    CCNxCodecNetworkBufferPool *reference = ccnxCodecNetworkBufferPool_Acquire(pool);
+    assertTrue(reference == pool, "Expected Acquire to return the same pool");
+    ccnxCodecNetworkBufferPool_Release(&reference);
+    ccnxCodecNetworkBufferPool_Release(&pool);
+    assertNull(pool, "Release did not null the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBufferPool_Allocate_Reuse)
+{
+    CCNxCodecNetworkBufferPool *pool = ccnxCodecNetworkBufferPool_Create(CCNxCodecNetworkBufferPool_MtuBlockSize, 8);
+
+    // A request up to the block size gets a whole block
+    void *first;
+    size_t actual = NetworkBufferPoolMemoryBlock.allocator(pool, 100, &first);
+    assertTrue(actual == CCNxCodecNetworkBufferPool_MtuBlockSize, "Expected a whole block, got %zu bytes", actual);
+    NetworkBufferPoolMemoryBlock.deallocator(pool, &first);
+    assertNull(first, "Deallocator did not null the pointer");
+
+    CCNxCodecNetworkBufferPoolStatistics statistics = _getStatistics(pool);
+    assertTrue(statistics.heapAllocations == 1, "Expected 1 heap allocation, got %" PRIu64, statistics.heapAllocations);
+    assertTrue(statistics.freeBlocks == 1, "Expected 1 free block, got %zu", statistics.freeBlocks);
+    assertTrue(statistics.outstandingBlocks == 0, "Expected no outstanding blocks, got %zu", statistics.outstandingBlocks);
+
+    void *second;
+    NetworkBufferPoolMemoryBlock.allocator(pool, 100, &second);
+    statistics = _getStatistics(pool);
+    assertTrue(statistics.poolAllocations == 1, "Expected the free block to be reused, got %" PRIu64 " pool allocations", statistics.poolAllocations);
+    assertTrue(statistics.heapAllocations == 1, "Expected no more heap allocations, got %" PRIu64, statistics.heapAllocations);
+    assertTrue(statistics.outstandingBlocks == 1, "Expected 1 outstanding block, got %zu", statistics.outstandingBlocks);
+
+    NetworkBufferPoolMemoryBlock.deallocator(pool, &second);
+    ccnxCodecNetworkBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBufferPool_Allocate_Large)
+{
+    CCNxCodecNetworkBufferPool *pool = ccnxCodecNetworkBufferPool_Create(CCNxCodecNetworkBufferPool_MtuBlockSize, 8);
+
+    // A request larger than a block is allocated at the size asked for, and not kept by the pool
+    void *large;
+    size_t actual = NetworkBufferPoolMemoryBlock.allocator(pool, 100000, &large);
+    assertTrue(actual == 100000, "Expected the requested 100000 bytes, got %zu", actual);
+    memset(large, 0xA5, actual);
+
+    CCNxCodecNetworkBufferPoolStatistics statistics = _getStatistics(pool);
+    assertTrue(statistics.directAllocations == 1, "Expected 1 direct allocation, got %" PRIu64, statistics.directAllocations);
+    assertTrue(statistics.heapAllocations == 0, "Expected no block allocations, got %" PRIu64, statistics.heapAllocations);
+
+    NetworkBufferPoolMemoryBlock.deallocator(pool, &large);
+    assertNull(large, "Deallocator did not null the pointer");
+
+    statistics = _getStatistics(pool);
+    assertTrue(statistics.freeBlocks == 0, "Expected the large allocation not to be pooled, got %zu free blocks", statistics.freeBlocks);
+    assertTrue(statistics.outstandingBlocks == 0, "Expected no outstanding blocks, got %zu", statistics.outstandingBlocks);
+
+    ccnxCodecNetworkBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBufferPool_MaxFreeBlocks)
+{
+    CCNxCodecNetworkBufferPool *pool = ccnxCodecNetworkBufferPool_Create(CCNxCodecNetworkBufferPool_MtuBlockSize, 2);
+
+    void *blocks[5];
+    for (int i = 0; i < 5; i++) {
+        NetworkBufferPoolMemoryBlock.allocator(pool, 1000, &blocks[i]);
+    }
+    for (int i = 0; i < 5; i++) {
+        NetworkBufferPoolMemoryBlock.deallocator(pool, &blocks[i]);
+    }
+
+    CCNxCodecNetworkBufferPoolStatistics statistics = _getStatistics(pool);
+    assertTrue(statistics.freeBlocks == 2, "Expected the pool to keep 2 blocks, got %zu", statistics.freeBlocks);
+    assertTrue(statistics.heapDeallocations == 3, "Expected 3 heap deallocations, got %" PRIu64, statistics.heapDeallocations);
+    assertTrue(statistics.outstandingBlocks == 0, "Expected no outstanding blocks, got %zu", statistics.outstandingBlocks);
+
+    ccnxCodecNetworkBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBufferPool_NetworkBuffer)
+{
+    CCNxCodecNetworkBufferPool *pool = ccnxCodecNetworkBufferPool_Create(CCNxCodecNetworkBufferPool_MtuBlockSize, 16);
+
+    uint8_t packet[5000];
+    memset(packet, 0xA5, sizeof(packet));
+
+    uint64_t heapAllocations = 0;
+    for (int round = 0; round < 3; round++) {
+        CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_Create(&NetworkBufferPoolMemoryBlock, pool);
+        ccnxCodecNetworkBuffer_PutArray(netbuff, sizeof(packet), packet);
+        CCNxCodecNetworkBufferIoVec *vec = ccnxCodecNetworkBuffer_CreateIoVec(netbuff);
+        assertTrue(ccnxCodecNetworkBufferIoVec_Length(vec) == sizeof(packet), "Wrong length, got %zu", ccnxCodecNetworkBufferIoVec_Length(vec));
+        assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(vec) == 3, "Expected 3 blocks, got %d", ccnxCodecNetworkBufferIoVec_GetCount(vec));
+        ccnxCodecNetworkBufferIoVec_Release(&vec);
+        ccnxCodecNetworkBuffer_Release(&netbuff);
+
+        CCNxCodecNetworkBufferPoolStatistics statistics = _getStatistics(pool);
+        assertTrue(statistics.outstandingBlocks == 0, "Round %d: expected no outstanding blocks, got %zu", round, statistics.outstandingBlocks);
+        if (round == 0) {
+            heapAllocations = statistics.heapAllocations;
+        } else {
+            assertTrue(statistics.heapAllocations == heapAllocations,
+                       "Round %d: expected no heap allocations once the pool is warm, got %" PRIu64, round, statistics.heapAllocations - heapAllocations);
+        }
+    }
+
+    ccnxCodecNetworkBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBufferPool_NetworkBuffer_OutlivesPool)
+{
+    CCNxCodecNetworkBufferPool *pool = ccnxCodecNetworkBufferPool_Create(CCNxCodecNetworkBufferPool_MtuBlockSize, 16);
+    CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_Create(&NetworkBufferPoolMemoryBlock, pool);
+    ccnxCodecNetworkBufferPool_Release(&pool);
+
+    uint8_t packet[3000] = { 0 };
+    ccnxCodecNetworkBuffer_PutArray(netbuff, sizeof(packet), packet);
+    assertTrue(ccnxCodecNetworkBuffer_Limit(netbuff) == sizeof(packet), "Wrong limit, got %zu", ccnxCodecNetworkBuffer_Limit(netbuff));
+
+    // The blocks hold the pool, so this frees the pool too
+    ccnxCodecNetworkBuffer_Release(&netbuff);
+}
+
+static void *
+_deallocateOnThread(void *args)
+{
+    void **blockPtr = args;
+    CCNxCodecNetworkBufferPool *pool = blockPtr[0];
+    NetworkBufferPoolMemoryBlock.deallocator(pool, &blockPtr[1]);
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBufferPool_RemoteReturn)
+{
+    CCNxCodecNetworkBufferPool *pool = ccnxCodecNetworkBufferPool_Create(CCNxCodecNetworkBufferPool_MtuBlockSize, 16);
+
+    void *args[2] = { pool, NULL };
+    NetworkBufferPoolMemoryBlock.allocator(pool, 1000, &args[1]);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, _deallocateOnThread, args);
+    pthread_join(thread, NULL);
+    assertNull(args[1], "Deallocator did not null the pointer");
+
+    CCNxCodecNetworkBufferPoolStatistics statistics = _getStatistics(pool);
+    assertTrue(statistics.remoteReturns == 1, "Expected 1 remote return, got %" PRIu64, statistics.remoteReturns);
+    assertTrue(statistics.freeBlocks == 1, "Expected the returned block to be free, got %zu", statistics.freeBlocks);
+
+    // The owner picks up the returned block
+    void *block;
+    NetworkBufferPoolMemoryBlock.allocator(pool, 1000, &block);
+    statistics = _getStatistics(pool);
+    assertTrue(statistics.poolAllocations == 1, "Expected the returned block to be reused, got %" PRIu64 " pool allocations", statistics.poolAllocations);
+    assertTrue(statistics.heapAllocations == 1, "Expected 1 heap allocation, got %" PRIu64, statistics.heapAllocations);
+
+    NetworkBufferPoolMemoryBlock.deallocator(pool, &block);
+    ccnxCodecNetworkBufferPool_Release(&pool);
+}
+
+static void *
+_allocateOnThread(void *args)
+{
+    void **blockPtr = args;
+    CCNxCodecNetworkBufferPool *pool = blockPtr[0];
+    NetworkBufferPoolMemoryBlock.allocator(pool, 1000, &blockPtr[1]);
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBufferPool_RemoteAllocate)
+{
+    CCNxCodecNetworkBufferPool *pool = ccnxCodecNetworkBufferPool_Create(CCNxCodecNetworkBufferPool_MtuBlockSize, 16);
+
+    // Put a block in the free list.  Another thread must not take it.
+    void *block;
+    NetworkBufferPoolMemoryBlock.allocator(pool, 1000, &block);
+    NetworkBufferPoolMemoryBlock.deallocator(pool, &block);
+
+    void *args[2] = { pool, NULL };
+    pthread_t thread;
+    pthread_create(&thread, NULL, _allocateOnThread, args);
+    pthread_join(thread, NULL);
+    assertNotNull(args[1], "Expected a block from another thread");
+
+    CCNxCodecNetworkBufferPoolStatistics statistics = _getStatistics(pool);
+    assertTrue(statistics.heapAllocations == 2, "Expected 2 heap allocations, got %" PRIu64, statistics.heapAllocations);
+    assertTrue(statistics.poolAllocations == 0, "Expected no pool allocations, got %" PRIu64, statistics.poolAllocations);
+    assertTrue(statistics.freeBlocks == 1, "Expected 1 free block, got %zu", statistics.freeBlocks);
+
+    NetworkBufferPoolMemoryBlock.deallocator(pool, &args[1]);
+    statistics = _getStatistics(pool);
+    assertTrue(statistics.freeBlocks == 2, "Expected 2 free blocks, got %zu", statistics.freeBlocks);
+
+    ccnxCodecNetworkBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBufferPool_ThreadPool)
+{
+    assertNull(ccnxCodecNetworkBufferPool_GetThreadPool(), "Expected no pool bound to the thread");
+
+    CCNxCodecNetworkBufferPool *pool = ccnxCodecNetworkBufferPool_Create(CCNxCodecNetworkBufferPool_MtuBlockSize, 16);
+    ccnxCodecNetworkBufferPool_SetThreadPool(pool);
+    assertTrue(ccnxCodecNetworkBufferPool_GetThreadPool() == pool, "Expected the bound pool");
+
+    // The thread holds its own reference
+    ccnxCodecNetworkBufferPool_Release(&pool);
+    assertNotNull(ccnxCodecNetworkBufferPool_GetThreadPool(), "Expected the pool to stay bound");
+
+    CCNxCodecNetworkBufferPool *jumbo = ccnxCodecNetworkBufferPool_Create(CCNxCodecNetworkBufferPool_JumboBlockSize, 16);
+    ccnxCodecNetworkBufferPool_SetThreadPool(jumbo);
+    assertTrue(ccnxCodecNetworkBufferPool_GetThreadPool() == jumbo, "Expected the second pool to replace the first");
+    ccnxCodecNetworkBufferPool_Release(&jumbo);
+
+    ccnxCodecNetworkBufferPool_SetThreadPool(NULL);
+    assertNull(ccnxCodecNetworkBufferPool_GetThreadPool(), "Expected no pool bound to the thread");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBufferPool_ThreadPool_Encoder)
+{
+    CCNxCodecNetworkBufferPool *pool = ccnxCodecNetworkBufferPool_Create(CCNxCodecNetworkBufferPool_MtuBlockSize, 16);
+    ccnxCodecNetworkBufferPool_SetThreadPool(pool);
+
+    uint8_t payload[1200] = { 0 };
+    for (int round = 0; round < 2; round++) {
+        CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+        ccnxCodecTlvEncoder_AppendArray(encoder, 0x0001, sizeof(payload), payload);
+        ccnxCodecTlvEncoder_AppendArray(encoder, 0x0002, sizeof(payload), payload);
+        ccnxCodecTlvEncoder_Finalize(encoder);
+        CCNxCodecNetworkBufferIoVec *vec = ccnxCodecTlvEncoder_CreateIoVec(encoder);
+        ccnxCodecTlvEncoder_Destroy(&encoder);
+
+        CCNxCodecNetworkBufferPoolStatistics statistics = _getStatistics(pool);
+        assertTrue(statistics.outstandingBlocks == 2, "Round %d: expected the packet in 2 pool blocks, got %zu", round, statistics.outstandingBlocks);
+        if (round > 0) {
+            assertTrue(statistics.heapAllocations == 2, "Expected the second packet to reuse the blocks, got %" PRIu64 " heap allocations", statistics.heapAllocations);
+        }
+        ccnxCodecNetworkBufferIoVec_Release(&vec);
+    }
+
+    ccnxCodecNetworkBufferPool_SetThreadPool(NULL);
+    ccnxCodecNetworkBufferPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecNetworkBufferPool_Display)
+{
+    CCNxCodecNetworkBufferPool *pool = ccnxCodecNetworkBufferPool_Create(CCNxCodecNetworkBufferPool_MtuBlockSize, 16);
+    ccnxCodecNetworkBufferPool_Display(pool, 1);
+    ccnxCodecNetworkBufferPool_Release(&pool);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(ccnxCodec_NetworkBufferPool);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
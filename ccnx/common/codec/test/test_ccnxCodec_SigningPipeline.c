@@ -0,0 +1,459 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../ccnxCodec_SigningPipeline.c"
+#include <parc/algol/parc_SafeMemory.h>
+#include <LongBow/unit-test.h>
+
+#include <parc/security/parc_Security.h>
+#include <parc/security/parc_Pkcs12KeyStore.h>
+#include <parc/security/parc_PublicKeySigner.h>
+
+#include <ccnx/common/ccnx_ContentObject.h>
+#include <ccnx/common/ccnx_Interest.h>
+#include <ccnx/common/codec/ccnxCodec_TlvPacket.h>
+#include <ccnx/common/internal/ccnx_ValidationFacadeV1.h>
+#include <ccnx/common/validation/ccnxValidation_HmacSha256.h>
+#include <ccnx/common/validation/ccnxValidation_RsaSha256.h>
+
+#define NUMBER_OF_SIGNERS 3
+#define NUMBER_OF_PACKETS 20
+
+typedef struct test_data {
+    PARCSigner *signers[NUMBER_OF_SIGNERS];
+    CCNxTlvDictionary *packets[NUMBER_OF_PACKETS];
+    PARCBuffer *expectedSignatures[NUMBER_OF_PACKETS];
+} TestData;
+
+static PARCSigner *
+_createSigner(void)
+{
+    PARCPkcs12KeyStore *publicKeyStore = parcPkcs12KeyStore_Open("test_rsa.p12", "blueberry", PARCCryptoHashType_SHA256);
+    PARCKeyStore *keyStore = parcKeyStore_Create(publicKeyStore, PARCPkcs12KeyStoreAsKeyStore);
+    parcPkcs12KeyStore_Release(&publicKeyStore);
+    PARCPublicKeySigner *publicKeySigner = parcPublicKeySigner_Create(keyStore, PARCSigningAlgorithm_RSA, PARCCryptoHashType_SHA256);
+    PARCSigner *signer = parcSigner_Create(publicKeySigner, PARCPublicKeySignerAsSigner);
+    parcPublicKeySigner_Release(&publicKeySigner);
+    parcKeyStore_Release(&keyStore);
+    assertNotNull(signer, "Got null result from opening openssl pkcs12 file");
+    return signer;
+}
+
+/**
+ * The signature the pipeline should produce for a packet: RSA PKCS#1 v1.5 signatures are deterministic,
+ * so signing the same protected region on this thread gives the same bits.
+ */
+static PARCBuffer *
+_signInline(PARCSigner *signer, CCNxTlvDictionary *packet)
+{
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    ccnxCodecSchemaV1PacketEncoder_Encode(encoder, packet);
+    PARCCryptoHash *digest = ccnxCodecTlvEncoder_ComputeDigest(encoder, parcSigner_GetCryptoHasher(signer));
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+
+    PARCSignature *signature = parcSigner_SignDigest(signer, digest);
+    PARCBuffer *bits = parcBuffer_Acquire(parcSignature_GetSignature(signature));
+    parcSignature_Release(&signature);
+    parcCryptoHash_Release(&digest);
+    return bits;
+}
+
+LONGBOW_TEST_RUNNER(ccnxCodec_SigningPipeline)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(ccnxCodec_SigningPipeline)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(ccnxCodec_SigningPipeline)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSigningPipeline_Create);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSigningPipeline_Take_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSigningPipeline_Submit_PreserveOrder);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSigningPipeline_Submit_AnyOrder);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSigningPipeline_Submit_Unsigned);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSigningPipeline_Submit_DeducedValidationAlg);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSigningPipeline_Submit_WrongCryptoSuite);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSigningPipeline_Submit_TooLongToSign);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecSigningPipeline_Release_Pending);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    parcSecurity_Init();
+
+    TestData *data = parcMemory_AllocateAndClear(sizeof(TestData));
+    assertNotNull(data, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(TestData));
+
+    for (int i = 0; i < NUMBER_OF_SIGNERS; i++) {
+        data->signers[i] = _createSigner();
+    }
+
+    PARCBuffer *keyid = parcBuffer_Wrap((uint8_t [4]) { 1, 2, 3, 4 }, 4, 0, 4);
+    for (int i = 0; i < NUMBER_OF_PACKETS; i++) {
+        char uri[64];
+        sprintf(uri, "lci:/signing/pipeline/chunk=%d", i);
+        CCNxName *name = ccnxName_CreateFromCString(uri);
+        PARCBuffer *payload = parcBuffer_Allocate(100 + i);
+        parcBuffer_Flip(parcBuffer_PutUint32(payload, i));
+
+        data->packets[i] = ccnxContentObject_CreateWithNameAndPayload(name, payload);
+        ccnxValidationRsaSha256_Set(data->packets[i], keyid, NULL);
+        // A fixed signing time, so the pipeline's encoding matches one made without a signer
+        ccnxValidationFacadeV1_SetSigningTime(data->packets[i], 1000000 + i);
+        data->expectedSignatures[i] = _signInline(data->signers[0], data->packets[i]);
+
+        parcBuffer_Release(&payload);
+        ccnxName_Release(&name);
+    }
+    parcBuffer_Release(&keyid);
+
+    longBowTestCase_SetClipBoardData(testCase, data);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    for (int i = 0; i < NUMBER_OF_PACKETS; i++) {
+        ccnxTlvDictionary_Release(&data->packets[i]);
+        parcBuffer_Release(&data->expectedSignatures[i]);
+    }
+    for (int i = 0; i < NUMBER_OF_SIGNERS; i++) {
+        parcSigner_Release(&data->signers[i]);
+    }
+    parcMemory_Deallocate((void **) &data);
+
+    parcSecurity_Fini();
+
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/**
+ * Check that `vec` is the signed wire format of packet `i`: the dictionary now holds the expected signature,
+ * and encoding the dictionary from scratch gives the same bytes the pipeline produced.
+ */
+static void
+_assertSignedPacket(TestData *data, int i, CCNxCodecNetworkBufferIoVec *vec)
+{
+    assertNotNull(vec, "Got null wire format for packet %d", i);
+
+    PARCBuffer *signature = ccnxTlvDictionary_GetBuffer(data->packets[i], CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_PAYLOAD);
+    assertTrue(parcBuffer_Equals(signature, data->expectedSignatures[i]), "Packet %d has the wrong signature", i);
+
+    CCNxCodecNetworkBufferIoVec *expected = ccnxCodecTlvPacket_DictionaryEncode(data->packets[i], NULL);
+    assertTrue(ccnxCodecNetworkBufferIoVec_Equals(vec, expected), "Packet %d wire format differs from a fresh encoding", i);
+    ccnxCodecNetworkBufferIoVec_Release(&expected);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSigningPipeline_Create)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    CCNxCodecSigningPipeline *pipeline = ccnxCodecSigningPipeline_Create(NUMBER_OF_SIGNERS, data->signers, true);
+    assertNotNull(pipeline, "Got null pipeline");
+    assertTrue(pipeline->numberOfWorkers == NUMBER_OF_SIGNERS, "Wrong number of workers, expected %d got %zu",
+               NUMBER_OF_SIGNERS, pipeline->numberOfWorkers);
+    assertTrue(ccnxCodecSigningPipeline_GetPending(pipeline) == 0, "New pipeline should be empty");
+
+    CCNxCodecSigningPipeline *reference = ccnxCodecSigningPipeline_Acquire(pipeline);
+    ccnxCodecSigningPipeline_Release(&reference);
+    ccnxCodecSigningPipeline_Release(&pipeline);
+    assertNull(pipeline, "Release did not null the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSigningPipeline_Take_Empty)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    CCNxCodecSigningPipeline *pipeline = ccnxCodecSigningPipeline_Create(1, data->signers, true);
+
+    CCNxTlvDictionary *packet = data->packets[0];
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSigningPipeline_Take(pipeline, &packet);
+    assertNull(vec, "Take on an empty pipeline should return null");
+    assertNull(packet, "Take on an empty pipeline should set the packet to null");
+
+    ccnxCodecSigningPipeline_Release(&pipeline);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSigningPipeline_Submit_PreserveOrder)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    CCNxCodecSigningPipeline *pipeline = ccnxCodecSigningPipeline_Create(NUMBER_OF_SIGNERS, data->signers, true);
+
+    for (int i = 0; i < NUMBER_OF_PACKETS; i++) {
+        bool success = ccnxCodecSigningPipeline_Submit(pipeline, data->packets[i]);
+        assertTrue(success, "Failed to submit packet %d", i);
+    }
+    assertTrue(ccnxCodecSigningPipeline_GetPending(pipeline) == NUMBER_OF_PACKETS, "Wrong pending count, expected %d got %zu",
+               NUMBER_OF_PACKETS, ccnxCodecSigningPipeline_GetPending(pipeline));
+
+    for (int i = 0; i < NUMBER_OF_PACKETS; i++) {
+        CCNxTlvDictionary *packet;
+        CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSigningPipeline_Take(pipeline, &packet);
+        assertTrue(packet == data->packets[i], "Packet %d out of order", i);
+        _assertSignedPacket(data, i, vec);
+
+        ccnxCodecNetworkBufferIoVec_Release(&vec);
+        ccnxTlvDictionary_Release(&packet);
+    }
+
+    assertNull(ccnxCodecSigningPipeline_Take(pipeline, NULL), "Pipeline should be empty");
+    ccnxCodecSigningPipeline_Release(&pipeline);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSigningPipeline_Submit_AnyOrder)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    CCNxCodecSigningPipeline *pipeline = ccnxCodecSigningPipeline_Create(NUMBER_OF_SIGNERS, data->signers, false);
+
+    for (int i = 0; i < NUMBER_OF_PACKETS; i++) {
+        ccnxCodecSigningPipeline_Submit(pipeline, data->packets[i]);
+    }
+
+    bool seen[NUMBER_OF_PACKETS] = { false };
+    for (int taken = 0; taken < NUMBER_OF_PACKETS; taken++) {
+        CCNxTlvDictionary *packet;
+        CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSigningPipeline_Take(pipeline, &packet);
+
+        int i = 0;
+        while (i < NUMBER_OF_PACKETS && data->packets[i] != packet) {
+            i++;
+        }
+        assertTrue(i < NUMBER_OF_PACKETS, "Take returned a packet that was not submitted");
+        assertFalse(seen[i], "Packet %d returned twice", i);
+        seen[i] = true;
+        _assertSignedPacket(data, i, vec);
+
+        ccnxCodecNetworkBufferIoVec_Release(&vec);
+        ccnxTlvDictionary_Release(&packet);
+    }
+
+    assertTrue(ccnxCodecSigningPipeline_GetPending(pipeline) == 0, "Pipeline should be empty");
+    ccnxCodecSigningPipeline_Release(&pipeline);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSigningPipeline_Submit_Unsigned)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    // An Interest without a ValidationAlg is not signed even though the pipeline has a signer
+    CCNxName *name = ccnxName_CreateFromCString("lci:/unsigned");
+    CCNxTlvDictionary *unsignedPacket = ccnxInterest_CreateSimple(name);
+    ccnxName_Release(&name);
+
+    CCNxCodecSigningPipeline *pipeline = ccnxCodecSigningPipeline_Create(1, data->signers, true);
+    ccnxCodecSigningPipeline_Submit(pipeline, unsignedPacket);
+
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSigningPipeline_Take(pipeline, NULL);
+    CCNxCodecNetworkBufferIoVec *expected = ccnxCodecTlvPacket_DictionaryEncode(unsignedPacket, NULL);
+    assertTrue(ccnxCodecNetworkBufferIoVec_Equals(vec, expected), "Unsigned packet should pass through unchanged");
+    assertFalse(ccnxTlvDictionary_IsValueBuffer(unsignedPacket, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_PAYLOAD),
+                "Unsigned packet should not get a ValidationPayload");
+
+    ccnxCodecNetworkBufferIoVec_Release(&expected);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    ccnxCodecSigningPipeline_Release(&pipeline);
+    ccnxTlvDictionary_Release(&unsignedPacket);
+}
+
+/**
+ * A ContentObject without a ValidationAlg is signed, as it would be by ccnxCodecTlvPacket_DictionaryEncode with
+ * a signer: the pipeline encodes the crypto suite deduced from its signer and a signing time.
+ */
+LONGBOW_TEST_CASE(Global, ccnxCodecSigningPipeline_Submit_DeducedValidationAlg)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/deduced");
+    CCNxTlvDictionary *packet = ccnxContentObject_CreateWithNameAndPayload(name, NULL);
+    ccnxName_Release(&name);
+
+    CCNxCodecSigningPipeline *pipeline = ccnxCodecSigningPipeline_Create(1, data->signers, true);
+    assertTrue(ccnxCodecSigningPipeline_Submit(pipeline, packet), "Failed to submit the packet");
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSigningPipeline_Take(pipeline, NULL);
+    assertNotNull(vec, "Got null wire format");
+
+    CCNxTlvDictionary *decoded = ccnxCodecSchemaV1TlvDictionary_CreateContentObject();
+    assertTrue(ccnxCodecTlvPacket_IoVecDecode(vec, decoded), "Failed to decode the signed packet");
+    assertTrue(ccnxValidationFacadeV1_GetCryptoSuite(decoded) == PARCCryptoSuite_RSA_SHA256, "Expected the signer's crypto suite");
+    assertTrue(ccnxValidationFacadeV1_HasSigningTime(decoded), "Expected a signing time");
+
+    PARCBuffer *signature = ccnxValidationFacadeV1_GetPayload(decoded);
+    assertTrue(parcBuffer_Equals(signature, ccnxTlvDictionary_GetBuffer(packet, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_PAYLOAD)),
+               "The wire format should carry the signature put in the dictionary");
+
+    ccnxTlvDictionary_Release(&decoded);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    ccnxCodecSigningPipeline_Release(&pipeline);
+    ccnxTlvDictionary_Release(&packet);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSigningPipeline_Submit_WrongCryptoSuite)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/hmac");
+    CCNxTlvDictionary *packet = ccnxContentObject_CreateWithNameAndPayload(name, NULL);
+    ccnxName_Release(&name);
+    PARCBuffer *keyid = parcBuffer_Wrap((uint8_t [4]) { 1, 2, 3, 4 }, 4, 0, 4);
+    ccnxValidationHmacSha256_Set(packet, keyid);
+    parcBuffer_Release(&keyid);
+
+    CCNxCodecSigningPipeline *pipeline = ccnxCodecSigningPipeline_Create(1, data->signers, true);
+    assertFalse(ccnxCodecSigningPipeline_Submit(pipeline, packet), "An HMAC packet should be rejected by an RSA pipeline");
+    assertTrue(ccnxCodecSigningPipeline_GetPending(pipeline) == 0, "The rejected packet should not be in the pipeline");
+
+    ccnxCodecSigningPipeline_Release(&pipeline);
+    ccnxTlvDictionary_Release(&packet);
+}
+
+static CCNxTlvDictionary *
+_createContentObjectWithPayloadLength(const char *uri, size_t payloadLength)
+{
+    CCNxName *name = ccnxName_CreateFromCString(uri);
+    PARCBuffer *payload = parcBuffer_Allocate(payloadLength);
+    parcBuffer_SetPosition(payload, payloadLength);
+    parcBuffer_Flip(payload);
+    CCNxTlvDictionary *packet = ccnxContentObject_CreateWithNameAndPayload(name, payload);
+    parcBuffer_Release(&payload);
+    ccnxName_Release(&name);
+    return packet;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSigningPipeline_Submit_TooLongToSign)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    // Measure the packet up to the signature, then size the payload so it fits until the signature is added
+    CCNxTlvDictionary *probe = _createContentObjectWithPayloadLength("lci:/too/long", 0);
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    ccnxCodecTlvEncoder_SetSigner(encoder, data->signers[0]);
+    ccnxCodecTlvEncoder_DeferSignature(encoder);
+    ssize_t overhead = ccnxCodecSchemaV1PacketEncoder_Encode(encoder, probe);
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+    ccnxTlvDictionary_Release(&probe);
+    assertTrue(overhead > 0, "Could not measure the packet, got %zd", overhead);
+
+    CCNxTlvDictionary *tooLong = _createContentObjectWithPayloadLength("lci:/too/long", UINT16_MAX - 100 - overhead);
+    CCNxCodecSigningPipeline *pipeline = ccnxCodecSigningPipeline_Create(1, data->signers, true);
+    assertTrue(ccnxCodecSigningPipeline_Submit(pipeline, tooLong), "The unsigned packet fits, so Submit should accept it");
+    assertTrue(ccnxCodecSigningPipeline_Submit(pipeline, data->packets[0]), "Submit failed");
+
+    // The failed packet comes back without a wire format or a ValidationPayload, and the next one still completes
+    CCNxTlvDictionary *packet;
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecSigningPipeline_Take(pipeline, &packet);
+    assertNull(vec, "Expected no wire format for a packet too long to sign");
+    assertTrue(packet == tooLong, "Expected the failed packet to be returned");
+    assertFalse(ccnxTlvDictionary_IsValueBuffer(packet, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_PAYLOAD),
+                "A packet that failed to encode should not have a ValidationPayload");
+    ccnxTlvDictionary_Release(&packet);
+
+    assertTrue(ccnxCodecSigningPipeline_GetPending(pipeline) == 1, "Expected 1 pending packet, got %zu", ccnxCodecSigningPipeline_GetPending(pipeline));
+    vec = ccnxCodecSigningPipeline_Take(pipeline, &packet);
+    assertNotNull(vec, "Expected the packet after the failed one to be signed");
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    ccnxTlvDictionary_Release(&packet);
+
+    ccnxCodecSigningPipeline_Release(&pipeline);
+    ccnxTlvDictionary_Release(&tooLong);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecSigningPipeline_Release_Pending)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    // Releasing a pipeline with packets still in it must stop the workers and not leak the packets.
+    CCNxCodecSigningPipeline *pipeline = ccnxCodecSigningPipeline_Create(NUMBER_OF_SIGNERS, data->signers, true);
+    for (int i = 0; i < NUMBER_OF_PACKETS; i++) {
+        ccnxCodecSigningPipeline_Submit(pipeline, data->packets[i]);
+    }
+    ccnxCodecSigningPipeline_Release(&pipeline);
+}
+
+int
+main(int argc, char *argv[argc])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(ccnxCodec_SigningPipeline);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
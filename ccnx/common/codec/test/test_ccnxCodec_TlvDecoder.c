@@ -71,6 +71,8 @@ LONGBOW_TEST_RUNNER(parc_Tlv)
     // Test Fixtures are run in the order specified, but all tests should be idempotent.
     // Never rely on the execution order of tests or share state between them.
     LONGBOW_RUN_TEST_FIXTURE(Decoder);
+    LONGBOW_RUN_TEST_FIXTURE(IoVec);
+    LONGBOW_RUN_TEST_FIXTURE(Arena);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -96,6 +98,8 @@ LONGBOW_TEST_FIXTURE(Decoder)
     LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_PeekType);
     LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetValue);
     LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetValue_TooLong);
+    LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetArray);
+    LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetArray_TooLong);
     LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetContainer);
     LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetContainer_TooLong);
 
@@ -132,6 +136,7 @@ LONGBOW_TEST_FIXTURE(Decoder)
 
     LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_Advance_Good);
     LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_Advance_TooLong);
+    LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_SetPosition);
 
     LONGBOW_RUN_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetVarInt);
 }
@@ -321,6 +326,45 @@ LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetValue_TooLong)
     ccnxCodecTlvDecoder_Destroy(&outerDecoder);
 }
 
+LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetArray)
+{
+    uint8_t truthBytes[] = { 0x00, 0x02, 0x00, 0x05, 'h', 'e', 'l', 'l', 'o' };
+
+    PARCBuffer *buffer = parcBuffer_Wrap(truthBytes, sizeof(truthBytes), 0, sizeof(truthBytes));
+
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(buffer);
+    parcBuffer_Release(&buffer);
+
+    (void) ccnxCodecTlvDecoder_GetType(decoder);
+    uint16_t length = ccnxCodecTlvDecoder_GetLength(decoder);
+    const uint8_t *value = ccnxCodecTlvDecoder_GetArray(decoder, length);
+
+    assertTrue(value == &truthBytes[4], "Expected a pointer into the wrapped memory");
+    assertTrue(ccnxCodecTlvDecoder_IsEmpty(decoder), "Expected the decoder to be advanced to the end");
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+}
+
+LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetArray_TooLong)
+{
+    // Length is beyond end of buffer
+    uint8_t truthBytes[] = { 0x00, 0x02, 0x00, 0x99, 'h', 'e', 'l', 'l', 'o' };
+
+    PARCBuffer *buffer = parcBuffer_Wrap(truthBytes, sizeof(truthBytes), 0, sizeof(truthBytes));
+
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(buffer);
+    parcBuffer_Release(&buffer);
+
+    (void) ccnxCodecTlvDecoder_GetType(decoder);
+    uint16_t length = ccnxCodecTlvDecoder_GetLength(decoder);
+    const uint8_t *value = ccnxCodecTlvDecoder_GetArray(decoder, length);
+
+    assertNull(value, "Value should be null because of buffer underrun");
+    assertTrue(ccnxCodecTlvDecoder_Position(decoder) == 4, "Position should not have moved, got %zu", ccnxCodecTlvDecoder_Position(decoder));
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+}
+
 LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_IsEmpty_True)
 {
     /**
@@ -796,6 +840,23 @@ LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_Advance_TooLong)
     parcBuffer_Release(&buffer);
 }
 
+LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_SetPosition)
+{
+    PARCBuffer *buffer = parcBuffer_Wrap((uint8_t[]) { 0xFF, 0xFF, 0x00, 0x04, 0xFF, 0x01, 0x02, 0x03 }, 8, 0, 8);
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_Create(buffer);
+
+    ccnxCodecTlvDecoder_Advance(decoder, 6);
+    assertTrue(ccnxCodecTlvDecoder_SetPosition(decoder, 2), "Failed to set the position back");
+    assertTrue(ccnxCodecTlvDecoder_Position(decoder) == 2, "Wrong position, got %zu expected 2", ccnxCodecTlvDecoder_Position(decoder));
+    assertTrue(ccnxCodecTlvDecoder_GetLength(decoder) == 4, "Did not decode the length at the new position");
+
+    assertFalse(ccnxCodecTlvDecoder_SetPosition(decoder, 9), "Should have returned false setting a position beyond the end");
+    assertTrue(ccnxCodecTlvDecoder_Position(decoder) == 4, "Wrong position, got %zu expected 4", ccnxCodecTlvDecoder_Position(decoder));
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    parcBuffer_Release(&buffer);
+}
+
 LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetVarInt)
 {
     struct test_vector {
@@ -837,6 +898,446 @@ LONGBOW_TEST_CASE(Decoder, ccnxCodecTlvDecoder_GetVarInt)
     }
 }
 
+
+// ============================================
+
+typedef struct {
+    size_t maxallocation;
+} _IoVecAllocatorArg;
+
+static size_t
+_ioVecAllocator(void *userarg, size_t bytes, void **output)
+{
+    _IoVecAllocatorArg *arg = userarg;
+    if (bytes > arg->maxallocation) {
+        bytes = arg->maxallocation;
+    }
+
+    *output = parcMemory_Allocate(bytes);
+    assertNotNull(*output, "parcMemory_Allocate(%zu) returned NULL", bytes);
+    return bytes;
+}
+
+static void
+_ioVecDeallocator(void *userarg, void **memory)
+{
+    parcMemory_Deallocate((void **) memory);
+}
+
+static const CCNxCodecNetworkBufferMemoryBlockFunctions _ioVecMemoryBlock = {
+    .allocator   = &_ioVecAllocator,
+    .deallocator = &_ioVecDeallocator
+};
+
+/*
+ * Create an iovec of many small extents.  32 bytes of each 64-byte block are needed for bookkeeping,
+ * so each extent holds 32 bytes and most TLVs of a few bytes straddle two extents somewhere.
+ */
+static CCNxCodecNetworkBufferIoVec *
+_createIoVec(size_t length, const uint8_t array[length])
+{
+    static _IoVecAllocatorArg maxalloc = { .maxallocation = 64 };
+
+    CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_Create(&_ioVecMemoryBlock, &maxalloc);
+    ccnxCodecNetworkBuffer_PutArray(netbuff, length, (uint8_t *) array);
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecNetworkBuffer_CreateIoVec(netbuff);
+    ccnxCodecNetworkBuffer_Release(&netbuff);
+
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(vec) > 1, "Expected several extents, got %d", ccnxCodecNetworkBufferIoVec_GetCount(vec));
+    return vec;
+}
+
+/*
+ * Encode `count` TLVs with types 0x0100 + i and lengths i % 11.
+ */
+static size_t
+_createTlvSequence(size_t count, size_t capacity, uint8_t array[capacity])
+{
+    size_t length = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t valueLength = i % 11;
+        assertTrue(length + 4 + valueLength <= capacity, "Array too small");
+
+        array[length++] = 0x01;
+        array[length++] = (uint8_t) i;
+        array[length++] = 0x00;
+        array[length++] = (uint8_t) valueLength;
+        for (size_t j = 0; j < valueLength; j++) {
+            array[length++] = (uint8_t) (i * 16 + j);
+        }
+    }
+    return length;
+}
+
+/*
+ * Decode every TLV from both decoders and check that they agree.
+ */
+static void
+_assertDecodersMatch(CCNxCodecTlvDecoder *expected, CCNxCodecTlvDecoder *actual)
+{
+    for (int i = 0; !ccnxCodecTlvDecoder_IsEmpty(expected); i++) {
+        assertFalse(ccnxCodecTlvDecoder_IsEmpty(actual), "TLV %d: iovec decoder ended early", i);
+        assertTrue(ccnxCodecTlvDecoder_Position(expected) == ccnxCodecTlvDecoder_Position(actual),
+                   "TLV %d: expected position %zu, got %zu", i, ccnxCodecTlvDecoder_Position(expected), ccnxCodecTlvDecoder_Position(actual));
+        assertTrue(ccnxCodecTlvDecoder_Remaining(expected) == ccnxCodecTlvDecoder_Remaining(actual),
+                   "TLV %d: expected remaining %zu, got %zu", i, ccnxCodecTlvDecoder_Remaining(expected), ccnxCodecTlvDecoder_Remaining(actual));
+        assertTrue(ccnxCodecTlvDecoder_PeekType(expected) == ccnxCodecTlvDecoder_PeekType(actual), "TLV %d: wrong peeked type", i);
+        assertTrue(ccnxCodecTlvDecoder_GetType(expected) == ccnxCodecTlvDecoder_GetType(actual), "TLV %d: wrong type", i);
+
+        uint16_t length = ccnxCodecTlvDecoder_GetLength(expected);
+        assertTrue(length == ccnxCodecTlvDecoder_GetLength(actual), "TLV %d: wrong length", i);
+
+        if (i % 2 == 0) {
+            PARCBuffer *expectedValue = ccnxCodecTlvDecoder_GetValue(expected, length);
+            PARCBuffer *actualValue = ccnxCodecTlvDecoder_GetValue(actual, length);
+            assertTrue(parcBuffer_Equals(expectedValue, actualValue), "TLV %d: wrong value", i);
+            parcBuffer_Release(&expectedValue);
+            parcBuffer_Release(&actualValue);
+        } else {
+            const uint8_t *expectedValue = ccnxCodecTlvDecoder_GetArray(expected, length);
+            const uint8_t *actualValue = ccnxCodecTlvDecoder_GetArray(actual, length);
+            assertTrue(memcmp(expectedValue, actualValue, length) == 0, "TLV %d: wrong array", i);
+        }
+    }
+    assertTrue(ccnxCodecTlvDecoder_IsEmpty(actual), "Expected the iovec decoder to be empty");
+}
+
+LONGBOW_TEST_FIXTURE(IoVec)
+{
+    LONGBOW_RUN_TEST_CASE(IoVec, ccnxCodecTlvDecoder_CreateFromIoVec);
+    LONGBOW_RUN_TEST_CASE(IoVec, ccnxCodecTlvDecoder_IoVec_Sequence);
+    LONGBOW_RUN_TEST_CASE(IoVec, ccnxCodecTlvDecoder_IoVec_GetContainer);
+    LONGBOW_RUN_TEST_CASE(IoVec, ccnxCodecTlvDecoder_IoVec_GetUint);
+    LONGBOW_RUN_TEST_CASE(IoVec, ccnxCodecTlvDecoder_IoVec_TooLong);
+    LONGBOW_RUN_TEST_CASE(IoVec, ccnxCodecTlvDecoder_IoVec_SetPosition);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(IoVec)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(IoVec)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(IoVec, ccnxCodecTlvDecoder_CreateFromIoVec)
+{
+    uint8_t array[256];
+    size_t length = _createTlvSequence(20, sizeof(array), array);
+    CCNxCodecNetworkBufferIoVec *vec = _createIoVec(length, array);
+
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_CreateFromIoVec(vec);
+    assertNotNull(decoder, "Expected non-null decoder");
+    assertTrue(ccnxCodecTlvDecoder_Remaining(decoder) == length, "Expected %zu remaining, got %zu", length, ccnxCodecTlvDecoder_Remaining(decoder));
+    assertTrue(ccnxCodecTlvDecoder_Position(decoder) == 0, "Expected position 0, got %zu", ccnxCodecTlvDecoder_Position(decoder));
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
+LONGBOW_TEST_CASE(IoVec, ccnxCodecTlvDecoder_IoVec_Sequence)
+{
+    uint8_t array[512];
+    size_t length = _createTlvSequence(40, sizeof(array), array);
+
+    PARCBuffer *buffer = parcBuffer_Wrap(array, length, 0, length);
+    CCNxCodecTlvDecoder *expected = ccnxCodecTlvDecoder_Create(buffer);
+    CCNxCodecNetworkBufferIoVec *vec = _createIoVec(length, array);
+    CCNxCodecTlvDecoder *actual = ccnxCodecTlvDecoder_CreateFromIoVec(vec);
+
+    _assertDecodersMatch(expected, actual);
+
+    ccnxCodecTlvDecoder_Destroy(&actual);
+    ccnxCodecTlvDecoder_Destroy(&expected);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(IoVec, ccnxCodecTlvDecoder_IoVec_GetContainer)
+{
+    // A short TLV to shift the container off an extent boundary, then a container of a TLV sequence.
+    uint8_t array[512] = { 0x00, 0x01, 0x00, 0x03, 0xA1, 0xA2, 0xA3, 0x00, 0x02 };
+    size_t innerLength = _createTlvSequence(30, sizeof(array) - 11, &array[11]);
+    array[9] = (uint8_t) (innerLength >> 8);
+    array[10] = (uint8_t) innerLength;
+    size_t length = 11 + innerLength;
+
+    PARCBuffer *buffer = parcBuffer_Wrap(array, length, 0, length);
+    CCNxCodecTlvDecoder *expected = ccnxCodecTlvDecoder_Create(buffer);
+    CCNxCodecNetworkBufferIoVec *vec = _createIoVec(length, array);
+    CCNxCodecTlvDecoder *actual = ccnxCodecTlvDecoder_CreateFromIoVec(vec);
+
+    // The first TLV is within one extent, so its "container" is a plain buffer decoder.
+    (void) ccnxCodecTlvDecoder_GetType(actual);
+    CCNxCodecTlvDecoder *small = ccnxCodecTlvDecoder_GetContainer(actual, ccnxCodecTlvDecoder_GetLength(actual));
+    assertNotNull(small->buffer, "Expected a container within one extent to be decoded from a slice");
+    ccnxCodecTlvDecoder_Destroy(&small);
+    ccnxCodecTlvDecoder_Advance(expected, 7);
+
+    assertTrue(ccnxCodecTlvDecoder_GetType(expected) == ccnxCodecTlvDecoder_GetType(actual), "Wrong container type");
+    uint16_t containerLength = ccnxCodecTlvDecoder_GetLength(expected);
+    assertTrue(containerLength == ccnxCodecTlvDecoder_GetLength(actual), "Wrong container length");
+
+    CCNxCodecTlvDecoder *expectedInner = ccnxCodecTlvDecoder_GetContainer(expected, containerLength);
+    CCNxCodecTlvDecoder *actualInner = ccnxCodecTlvDecoder_GetContainer(actual, containerLength);
+    assertNull(actualInner->buffer, "Expected a container across extents to be decoded in place");
+    assertTrue(ccnxCodecTlvDecoder_IsEmpty(actual), "Expected the outer decoder to be past the container");
+
+    _assertDecodersMatch(expectedInner, actualInner);
+
+    ccnxCodecTlvDecoder_Destroy(&actualInner);
+    ccnxCodecTlvDecoder_Destroy(&expectedInner);
+    ccnxCodecTlvDecoder_Destroy(&actual);
+    ccnxCodecTlvDecoder_Destroy(&expected);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(IoVec, ccnxCodecTlvDecoder_IoVec_SetPosition)
+{
+    uint8_t array[512];
+    size_t length = _createTlvSequence(40, sizeof(array), array);
+
+    PARCBuffer *buffer = parcBuffer_Wrap(array, length, 0, length);
+    CCNxCodecTlvDecoder *expected = ccnxCodecTlvDecoder_Create(buffer);
+    CCNxCodecNetworkBufferIoVec *vec = _createIoVec(length, array);
+    CCNxCodecTlvDecoder *actual = ccnxCodecTlvDecoder_CreateFromIoVec(vec);
+
+    // Move past several extents, then back into the first so the extent must be found again.
+    ccnxCodecTlvDecoder_Advance(actual, length - 1);
+    assertTrue(ccnxCodecTlvDecoder_SetPosition(actual, 0), "Failed to set the position back");
+    _assertDecodersMatch(expected, actual);
+
+    assertFalse(ccnxCodecTlvDecoder_SetPosition(actual, length + 1), "Should have returned false setting a position beyond the end");
+
+    ccnxCodecTlvDecoder_Destroy(&actual);
+    ccnxCodecTlvDecoder_Destroy(&expected);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(IoVec, ccnxCodecTlvDecoder_IoVec_GetUint)
+{
+    // Repeat TLVs of 1, 2, 4 and 8 byte integers (and a 3 byte VarInt) so they fall at every offset in an extent.
+    uint8_t array[512];
+    size_t length = 0;
+    for (int i = 0; i < 8; i++) {
+        size_t sizes[] = { 1, 2, 4, 8, 3 };
+        for (int j = 0; j < 5; j++) {
+            array[length++] = 0x00;
+            array[length++] = (uint8_t) sizes[j];
+            array[length++] = 0x00;
+            array[length++] = (uint8_t) sizes[j];
+            for (size_t k = 0; k < sizes[j]; k++) {
+                array[length++] = (uint8_t) (0xF0 + i + k);
+            }
+        }
+    }
+
+    PARCBuffer *buffer = parcBuffer_Wrap(array, length, 0, length);
+    CCNxCodecTlvDecoder *expected = ccnxCodecTlvDecoder_Create(buffer);
+    CCNxCodecNetworkBufferIoVec *vec = _createIoVec(length, array);
+    CCNxCodecTlvDecoder *actual = ccnxCodecTlvDecoder_CreateFromIoVec(vec);
+
+    for (int i = 0; i < 8; i++) {
+        uint8_t expected8, actual8;
+        uint16_t expected16, actual16;
+        uint32_t expected32, actual32;
+        uint64_t expected64, actual64;
+
+        assertTrue(ccnxCodecTlvDecoder_GetUint8(expected, 1, &expected8), "Failed to decode uint8");
+        assertTrue(ccnxCodecTlvDecoder_GetUint8(actual, 1, &actual8), "Failed to decode uint8 from iovec");
+        assertTrue(expected8 == actual8, "Expected %02X, got %02X", expected8, actual8);
+
+        assertTrue(ccnxCodecTlvDecoder_GetUint16(expected, 2, &expected16), "Failed to decode uint16");
+        assertTrue(ccnxCodecTlvDecoder_GetUint16(actual, 2, &actual16), "Failed to decode uint16 from iovec");
+        assertTrue(expected16 == actual16, "Expected %04X, got %04X", expected16, actual16);
+
+        assertTrue(ccnxCodecTlvDecoder_GetUint32(expected, 4, &expected32), "Failed to decode uint32");
+        assertTrue(ccnxCodecTlvDecoder_GetUint32(actual, 4, &actual32), "Failed to decode uint32 from iovec");
+        assertTrue(expected32 == actual32, "Expected %08X, got %08X", expected32, actual32);
+
+        assertTrue(ccnxCodecTlvDecoder_GetUint64(expected, 8, &expected64), "Failed to decode uint64");
+        assertTrue(ccnxCodecTlvDecoder_GetUint64(actual, 8, &actual64), "Failed to decode uint64 from iovec");
+        assertTrue(expected64 == actual64, "Expected %" PRIX64 ", got %" PRIX64, expected64, actual64);
+
+        ccnxCodecTlvDecoder_Advance(expected, 4);
+        ccnxCodecTlvDecoder_Advance(actual, 4);
+        assertTrue(ccnxCodecTlvDecoder_GetVarInt(expected, 3, &expected64), "Failed to decode VarInt");
+        assertTrue(ccnxCodecTlvDecoder_GetVarInt(actual, 3, &actual64), "Failed to decode VarInt from iovec");
+        assertTrue(expected64 == actual64, "Expected %" PRIX64 ", got %" PRIX64, expected64, actual64);
+    }
+    assertTrue(ccnxCodecTlvDecoder_IsEmpty(actual), "Expected the iovec decoder to be empty");
+
+    ccnxCodecTlvDecoder_Destroy(&actual);
+    ccnxCodecTlvDecoder_Destroy(&expected);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(IoVec, ccnxCodecTlvDecoder_IoVec_TooLong)
+{
+    uint8_t array[256];
+    size_t length = _createTlvSequence(20, sizeof(array), array);
+    CCNxCodecNetworkBufferIoVec *vec = _createIoVec(length, array);
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_CreateFromIoVec(vec);
+
+    assertNull(ccnxCodecTlvDecoder_GetValue(decoder, length + 1), "Expected NULL value past the end");
+    assertNull(ccnxCodecTlvDecoder_GetArray(decoder, length + 1), "Expected NULL array past the end");
+    assertNull(ccnxCodecTlvDecoder_GetContainer(decoder, length + 1), "Expected NULL container past the end");
+    assertFalse(ccnxCodecTlvDecoder_Advance(decoder, length + 1), "Expected Advance past the end to fail");
+    assertTrue(ccnxCodecTlvDecoder_Position(decoder) == 0, "Expected the position not to change");
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
+// ============================================
+
+LONGBOW_TEST_FIXTURE(Arena)
+{
+    LONGBOW_RUN_TEST_CASE(Arena, ccnxCodecTlvDecoder_CreateWithArena);
+    LONGBOW_RUN_TEST_CASE(Arena, ccnxCodecTlvDecoder_Arena_GetContainer);
+    LONGBOW_RUN_TEST_CASE(Arena, ccnxCodecTlvDecoder_Arena_OutlivesCaller);
+    LONGBOW_RUN_TEST_CASE(Arena, ccnxCodecTlvDecoder_CreateFromIoVecWithArena);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Arena)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Arena)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Arena, ccnxCodecTlvDecoder_CreateWithArena)
+{
+    uint8_t array[512];
+    size_t length = _createTlvSequence(40, sizeof(array), array);
+
+    PARCBuffer *buffer = parcBuffer_Wrap(array, length, 0, length);
+    CCNxCodecArena *arena = ccnxCodecArena_Create();
+    CCNxCodecTlvDecoder *expected = ccnxCodecTlvDecoder_Create(buffer);
+    CCNxCodecTlvDecoder *actual = ccnxCodecTlvDecoder_CreateWithArena(buffer, arena);
+
+    assertTrue(ccnxCodecTlvDecoder_GetArena(actual) == arena, "Expected the decoder to use the arena");
+    assertNull(ccnxCodecTlvDecoder_GetArena(expected), "Expected a plain decoder to have no arena");
+
+    _assertDecodersMatch(expected, actual);
+    assertTrue(parcBuffer_Position(buffer) == 0, "The decoder must not move the caller's buffer");
+    assertTrue(ccnxCodecArena_GetChunkCount(arena) == 0, "Expected the decoder to fit in the first chunk");
+
+    ccnxCodecTlvDecoder_Destroy(&actual);
+    ccnxCodecTlvDecoder_Destroy(&expected);
+    ccnxCodecArena_Release(&arena);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Arena, ccnxCodecTlvDecoder_Arena_GetContainer)
+{
+    uint8_t array[512] = { 0x00, 0x01, 0x00, 0x03, 0xA1, 0xA2, 0xA3, 0x00, 0x02 };
+    size_t innerLength = _createTlvSequence(30, sizeof(array) - 11, &array[11]);
+    array[9] = (uint8_t) (innerLength >> 8);
+    array[10] = (uint8_t) innerLength;
+    size_t length = 11 + innerLength;
+
+    PARCBuffer *buffer = parcBuffer_Wrap(array, length, 0, length);
+    CCNxCodecArena *arena = ccnxCodecArena_Create();
+    CCNxCodecTlvDecoder *expected = ccnxCodecTlvDecoder_Create(buffer);
+    CCNxCodecTlvDecoder *actual = ccnxCodecTlvDecoder_CreateWithArena(buffer, arena);
+    ccnxCodecTlvDecoder_Advance(expected, 7);
+    ccnxCodecTlvDecoder_Advance(actual, 7);
+
+    assertTrue(ccnxCodecTlvDecoder_GetType(expected) == ccnxCodecTlvDecoder_GetType(actual), "Wrong container type");
+    uint16_t containerLength = ccnxCodecTlvDecoder_GetLength(expected);
+    assertTrue(containerLength == ccnxCodecTlvDecoder_GetLength(actual), "Wrong container length");
+
+    size_t bytesUsed = ccnxCodecArena_GetBytesUsed(arena);
+    CCNxCodecTlvDecoder *expectedInner = ccnxCodecTlvDecoder_GetContainer(expected, containerLength);
+    CCNxCodecTlvDecoder *actualInner = ccnxCodecTlvDecoder_GetContainer(actual, containerLength);
+    assertNull(actualInner->buffer, "Expected an arena container to share the outer view, not slice it");
+    assertTrue(actualInner->extents == actual->extents, "Expected an arena container to share the extents");
+    assertTrue(ccnxCodecTlvDecoder_GetArena(actualInner) == arena, "Expected the container to use the arena");
+    assertTrue(ccnxCodecArena_GetBytesUsed(arena) > bytesUsed, "Expected the container to be allocated from the arena");
+    assertTrue(ccnxCodecTlvDecoder_Position(actualInner) == 0, "Expected the container to start at position 0");
+
+    _assertDecodersMatch(expectedInner, actualInner);
+
+    ccnxCodecTlvDecoder_Destroy(&actualInner);
+    ccnxCodecTlvDecoder_Destroy(&expectedInner);
+    ccnxCodecTlvDecoder_Destroy(&actual);
+    ccnxCodecTlvDecoder_Destroy(&expected);
+    ccnxCodecArena_Release(&arena);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Arena, ccnxCodecTlvDecoder_Arena_OutlivesCaller)
+{
+    uint8_t array[256];
+    size_t length = _createTlvSequence(20, sizeof(array), array);
+
+    PARCBuffer *buffer = parcBuffer_Wrap(array, length, 0, length);
+    CCNxCodecArena *arena = ccnxCodecArena_Create();
+    CCNxCodecTlvDecoder *decoder = ccnxCodecTlvDecoder_CreateWithArena(buffer, arena);
+
+    // The decoder holds the arena, so the caller may let go of both its references first.
+    ccnxCodecArena_Release(&arena);
+    parcBuffer_Release(&buffer);
+
+    (void) ccnxCodecTlvDecoder_GetType(decoder);
+    uint16_t valueLength = ccnxCodecTlvDecoder_GetLength(decoder);
+    (void) ccnxCodecTlvDecoder_Advance(decoder, valueLength);
+    (void) ccnxCodecTlvDecoder_GetType(decoder);
+    valueLength = ccnxCodecTlvDecoder_GetLength(decoder);
+    PARCBuffer *value = ccnxCodecTlvDecoder_GetValue(decoder, valueLength);
+    assertTrue(parcBuffer_Remaining(value) == 1, "Expected a 1 byte value, got %zu", parcBuffer_Remaining(value));
+    assertTrue(parcBuffer_GetAtIndex(value, 0) == 0x10, "Wrong value");
+
+    ccnxCodecTlvDecoder_Destroy(&decoder);
+
+    // Values are ordinary buffers and outlive the arena.
+    assertTrue(parcBuffer_GetAtIndex(value, 0) == 0x10, "Wrong value after the arena was freed");
+    parcBuffer_Release(&value);
+}
+
+LONGBOW_TEST_CASE(Arena, ccnxCodecTlvDecoder_CreateFromIoVecWithArena)
+{
+    uint8_t array[512];
+    size_t length = _createTlvSequence(40, sizeof(array), array);
+
+    PARCBuffer *buffer = parcBuffer_Wrap(array, length, 0, length);
+    CCNxCodecTlvDecoder *expected = ccnxCodecTlvDecoder_Create(buffer);
+    CCNxCodecNetworkBufferIoVec *vec = _createIoVec(length, array);
+    CCNxCodecArena *arena = ccnxCodecArena_Create();
+    CCNxCodecTlvDecoder *actual = ccnxCodecTlvDecoder_CreateFromIoVecWithArena(vec, arena);
+
+    // The arena holds the iovec, so the caller may release it.
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    assertTrue(ccnxCodecTlvDecoder_GetArena(actual) == arena, "Expected the decoder to use the arena");
+
+    // Arrays that straddle extents are copied into the arena.
+    _assertDecodersMatch(expected, actual);
+
+    ccnxCodecTlvDecoder_Destroy(&actual);
+    ccnxCodecTlvDecoder_Destroy(&expected);
+    ccnxCodecArena_Release(&arena);
+    parcBuffer_Release(&buffer);
+}
+
 // ============================================
 
 int
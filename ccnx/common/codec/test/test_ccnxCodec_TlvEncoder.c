@@ -105,6 +105,8 @@ LONGBOW_TEST_FIXTURE(Encoder)
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_PutUint16);
 
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_Create);
+    LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_CreateWithCapacity);
+    LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_CreateMeasuring);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_Finalize);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_Finalize_TrimLimit_Buffer);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_Finalize_TrimLimit_IoVec);
@@ -123,7 +125,11 @@ LONGBOW_TEST_FIXTURE(Encoder)
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_MarkSignatureEnd);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_MarkSignatureStart);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_ComputeSignature);
+    LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_FinalizeContentObjectHash);
+    LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_FinalizeContentObjectHash_Unsigned);
+    LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_FinalizeContentObjectHash_NotEnabled);
     LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_GetSigner);
+    LONGBOW_RUN_TEST_CASE(Encoder, ccnxCodecTlvEncoder_DeferSignature);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Encoder)
@@ -351,6 +357,77 @@ LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_Create)
     assertTrue(before == after, "Memory leak, expected %zu got %zu bytes\n", before, after);
 }
 
+LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_CreateWithCapacity)
+{
+    uint8_t array[8000] = { 0 };
+
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_CreateWithCapacity(4 + sizeof(array));
+    assertFalse(ccnxCodecTlvEncoder_IsMeasuring(encoder), "Expected an encoder with output");
+    ccnxCodecTlvEncoder_AppendArray(encoder, 1, sizeof(array), array);
+    ccnxCodecTlvEncoder_Finalize(encoder);
+
+    CCNxCodecNetworkBufferIoVec *iovec = ccnxCodecTlvEncoder_CreateIoVec(encoder);
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(iovec) == 1, "Expected 1 iovec, got %d", ccnxCodecNetworkBufferIoVec_GetCount(iovec));
+    assertTrue(ccnxCodecNetworkBufferIoVec_Length(iovec) == 4 + sizeof(array), "Wrong length, got %zu", ccnxCodecNetworkBufferIoVec_Length(iovec));
+
+    ccnxCodecNetworkBufferIoVec_Release(&iovec);
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+}
+
+/*
+ * Run the same calls through a measuring encoder and a real one and compare positions
+ */
+static void
+_encodeSample(CCNxCodecTlvEncoder *encoder)
+{
+    uint8_t array[] = { 1, 2, 3, 4, 5 };
+    PARCBuffer *buffer = parcBuffer_Wrap(array, sizeof(array), 0, sizeof(array));
+
+    size_t start = ccnxCodecTlvEncoder_Position(encoder);
+    ccnxCodecTlvEncoder_AppendContainer(encoder, 1, 0);
+    ccnxCodecTlvEncoder_MarkSignatureStart(encoder);
+    ccnxCodecTlvEncoder_AppendBuffer(encoder, 2, buffer);
+    ccnxCodecTlvEncoder_AppendArray(encoder, 3, sizeof(array), array);
+    ccnxCodecTlvEncoder_AppendUint8(encoder, 4, 1);
+    ccnxCodecTlvEncoder_AppendUint16(encoder, 5, 2);
+    ccnxCodecTlvEncoder_AppendUint32(encoder, 6, 3);
+    ccnxCodecTlvEncoder_AppendUint64(encoder, 7, 4);
+    ccnxCodecTlvEncoder_AppendVarInt(encoder, 8, 0x123456);
+    ccnxCodecTlvEncoder_AppendRawArray(encoder, sizeof(array), array);
+    ccnxCodecTlvEncoder_MarkSignatureEnd(encoder);
+    ccnxCodecTlvEncoder_SetContainerLength(encoder, start, ccnxCodecTlvEncoder_Position(encoder) - start - 4);
+    ccnxCodecTlvEncoder_PutUint16(encoder, start, 9);
+
+    // Write something, back up over it and finalize, so the limit is trimmed
+    size_t end = ccnxCodecTlvEncoder_Position(encoder);
+    ccnxCodecTlvEncoder_AppendArray(encoder, 10, sizeof(array), array);
+    ccnxCodecTlvEncoder_SetPosition(encoder, end);
+    ccnxCodecTlvEncoder_Finalize(encoder);
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_CreateMeasuring)
+{
+    CCNxCodecTlvEncoder *sizer = ccnxCodecTlvEncoder_CreateMeasuring();
+    assertTrue(ccnxCodecTlvEncoder_IsMeasuring(sizer), "Expected a measuring encoder");
+    _encodeSample(sizer);
+
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    _encodeSample(encoder);
+    PARCBuffer *output = ccnxCodecTlvEncoder_CreateBuffer(encoder);
+
+    assertTrue(ccnxCodecTlvEncoder_Position(sizer) == parcBuffer_Remaining(output),
+               "Measured %zu bytes, encoded %zu", ccnxCodecTlvEncoder_Position(sizer), parcBuffer_Remaining(output));
+    assertTrue(sizer->signatureStart == encoder->signatureStart && sizer->signatureEnd == encoder->signatureEnd,
+               "Wrong signature positions, measured %zu-%zu, encoded %zu-%zu",
+               sizer->signatureStart, sizer->signatureEnd, encoder->signatureStart, encoder->signatureEnd);
+
+    parcBuffer_Release(&output);
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+    ccnxCodecTlvEncoder_Destroy(&sizer);
+}
+
 /**
  * Check for memory leaks
  */
@@ -695,6 +772,86 @@ LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_ComputeSignature)
     ccnxCodecTlvEncoder_Destroy(&encoder);
 }
 
+/*
+ * The ContentObjectHash runs from the signature start to the current position, so compare it
+ * to a separate digest of the same range.
+ */
+static void
+_assertContentObjectHash(CCNxCodecTlvEncoder *encoder, PARCCryptoHash *hash)
+{
+    assertNotNull(hash, "Got null ContentObjectHash");
+
+    PARCCryptoHasher *hasher = parcCryptoHasher_Create(PARCCryptoHashType_SHA256);
+    PARCCryptoHash *truth = ccnxCodecNetworkBuffer_ComputeDigest(encoder->buffer, encoder->signatureStart, ccnxCodecTlvEncoder_Position(encoder), hasher);
+    assertTrue(parcCryptoHash_Equals(truth, hash), "Wrong ContentObjectHash")
+    {
+        parcBuffer_Display(parcCryptoHash_GetDigest(truth), 3);
+        parcBuffer_Display(parcCryptoHash_GetDigest(hash), 3);
+    }
+
+    parcCryptoHash_Release(&truth);
+    parcCryptoHasher_Release(&hasher);
+}
+
+LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_FinalizeContentObjectHash)
+{
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    ccnxCodecTlvEncoder_AppendUint8(encoder, 0x0001, 0x01);
+    ccnxCodecTlvEncoder_EnableContentObjectHash(encoder);
+    ccnxCodecTlvEncoder_MarkSignatureStart(encoder);
+    ccnxCodecTlvEncoder_AppendUint8(encoder, 0x1020, 0xFF);
+    ccnxCodecTlvEncoder_MarkSignatureEnd(encoder);
+
+    PARCSigner *signer = ccnxValidationCRC32C_CreateSigner();
+    ccnxCodecTlvEncoder_SetSigner(encoder, signer);
+    parcSigner_Release(&signer);
+
+    // Sharing the walk with the ContentObjectHash must not change the signature
+    PARCSignature *sig = ccnxCodecTlvEncoder_ComputeSignature(encoder);
+    uint8_t truesig[] = { 0xA3, 0xAA, 0xC8, 0x4B };
+    PARCBuffer *truesigBuffer = parcBuffer_Rewind(parcBuffer_CreateFromArray(truesig, sizeof(truesig)));
+    assertTrue(parcBuffer_Equals(truesigBuffer, parcSignature_GetSignature(sig)), "wrong crc value");
+    assertTrue(encoder->contentObjectHashed == encoder->signatureEnd,
+               "Signature should hash up to %zu, got %zu", encoder->signatureEnd, encoder->contentObjectHashed);
+
+    ccnxCodecTlvEncoder_AppendBuffer(encoder, 0x0004, parcSignature_GetSignature(sig));
+
+    PARCCryptoHash *hash = ccnxCodecTlvEncoder_FinalizeContentObjectHash(encoder);
+    _assertContentObjectHash(encoder, hash);
+
+    parcCryptoHash_Release(&hash);
+    parcBuffer_Release(&truesigBuffer);
+    parcSignature_Release(&sig);
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+}
+
+LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_FinalizeContentObjectHash_Unsigned)
+{
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    ccnxCodecTlvEncoder_AppendUint8(encoder, 0x0001, 0x01);
+    ccnxCodecTlvEncoder_EnableContentObjectHash(encoder);
+    ccnxCodecTlvEncoder_MarkSignatureStart(encoder);
+    ccnxCodecTlvEncoder_AppendUint8(encoder, 0x1020, 0xFF);
+
+    PARCCryptoHash *hash = ccnxCodecTlvEncoder_FinalizeContentObjectHash(encoder);
+    _assertContentObjectHash(encoder, hash);
+
+    parcCryptoHash_Release(&hash);
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+}
+
+LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_FinalizeContentObjectHash_NotEnabled)
+{
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    ccnxCodecTlvEncoder_MarkSignatureStart(encoder);
+    ccnxCodecTlvEncoder_AppendUint8(encoder, 0x1020, 0xFF);
+
+    PARCCryptoHash *hash = ccnxCodecTlvEncoder_FinalizeContentObjectHash(encoder);
+    assertNull(hash, "Should not get a ContentObjectHash unless enabled");
+
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+}
+
 LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_GetSigner)
 {
     CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
@@ -707,6 +864,16 @@ LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_GetSigner)
     ccnxCodecTlvEncoder_Destroy(&encoder);
 }
 
+LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_DeferSignature)
+{
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    assertFalse(ccnxCodecTlvEncoder_IsSignatureDeferred(encoder), "A new encoder should sign");
+
+    ccnxCodecTlvEncoder_DeferSignature(encoder);
+    assertTrue(ccnxCodecTlvEncoder_IsSignatureDeferred(encoder), "Expected the signature to be deferred");
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+}
+
 LONGBOW_TEST_CASE(Encoder, ccnxCodecTlvEncoder_PutUint8)
 {
     PARCBuffer *truth = parcBuffer_Wrap((uint8_t[]) { 0x10, 0xEE, 0x00, 0x01, 0xFF }, 5, 0, 5);
@@ -67,14 +67,18 @@
 #include <config.h>
 #include <stdio.h>
 #include <fcntl.h>
+#include <inttypes.h>
+#include <sys/time.h>
 
 #include "../ccnxCodec_TlvPacket.c"
 #include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
 
 #include <LongBow/unit-test.h>
 
 #include <ccnx/common/codec/ccnxCodec_NetworkBuffer.h>
 #include <ccnx/common/validation/ccnxValidation_HmacSha256.h>
+#include <parc/security/parc_CryptoHasher.h>
 
 #include <ccnx/common/ccnx_Interest.h>
 #include <ccnx/common/ccnx_ContentObject.h>
@@ -84,6 +88,7 @@
 #include <ccnx/common/codec/schema_v1/testdata/v1_interest_all_fields.h>
 #include <ccnx/common/codec/schema_v1/testdata/v1_content_nameA_keyid1_rsasha256.h>
 #include <ccnx/common/codec/schema_v1/testdata/v1_interest_bad_message_length.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_interest_validation_alg_overrun.h>
 
 LONGBOW_TEST_RUNNER(rta_TlvPacket)
 {
@@ -92,6 +97,7 @@ LONGBOW_TEST_RUNNER(rta_TlvPacket)
     // Never rely on the execution order of tests or share state between them.
     LONGBOW_RUN_TEST_FIXTURE(Global);
     LONGBOW_RUN_TEST_FIXTURE(Local);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -111,6 +117,19 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, rtaTlvPacket_BufferDecode_V1);
     LONGBOW_RUN_TEST_CASE(Global, rtaTlvPacket_BufferDecode_VFF);
 
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_ArenaDecode_Interest);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_ArenaDecode_ContentObject);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_ArenaDecode_Error);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_LazyDecode_Interest);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_LazyDecode_ContentObject);
+
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_DecodeBatch);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_DecodeBatch_Malformed);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_IoVecDecodeBatch);
+
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_Validate);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_BufferDecode_Malformed);
+
     LONGBOW_RUN_TEST_CASE(Global, rtaTlvPacket_IoVecDecode_OneBuffer);
     LONGBOW_RUN_TEST_CASE(Global, rtaTlvPacket_IoVecDecode_SeveralBuffer);
 
@@ -121,6 +140,8 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_Decode_VFF);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_EncodeWithSignature);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_DictionaryEncodeAndSign);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_DictionaryEncodeAndSign_Unsigned);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_GetPacketLength);
     LONGBOW_RUN_TEST_CASE(Global, ccnxCodecTlvPacket_MinimalHeaderLength);
 }
@@ -185,6 +206,269 @@ LONGBOW_TEST_CASE(Global, rtaTlvPacket_BufferDecode_VFF)
     parcBuffer_Release(&packetBuffer);
 }
 
+/*
+ * Decode the packet with and without an arena and check that the dictionaries are equal.
+ */
+static void
+_assertArenaDecodeMatches(size_t length, uint8_t packet[length], CCNxTlvDictionary *(*createDictionary)(void))
+{
+    PARCBuffer *packetBuffer = parcBuffer_Wrap(packet, length, 0, length);
+
+    CCNxTlvDictionary *expected = createDictionary();
+    assertTrue(ccnxCodecTlvPacket_BufferDecode(packetBuffer, expected), "Failed to decode packet");
+    assertNull(ccnxTlvDictionary_GetArena(expected), "A plain decode should not hold an arena");
+
+    parcBuffer_Rewind(packetBuffer);
+    CCNxTlvDictionary *actual = createDictionary();
+    assertTrue(ccnxCodecTlvPacket_ArenaDecode(packetBuffer, actual), "Failed to decode packet with an arena");
+
+    CCNxCodecArena *arena = ccnxTlvDictionary_GetArena(actual);
+    assertNotNull(arena, "Expected the dictionary to hold the decode arena");
+    assertTrue(ccnxCodecArena_GetChunkCount(arena) == 0, "Expected the decode to fit in the first chunk, got %zu more",
+               ccnxCodecArena_GetChunkCount(arena));
+
+    assertTrue(ccnxTlvDictionary_Equals(expected, actual), "Arena decode differs from buffer decode")
+    {
+        ccnxTlvDictionary_Display(expected, 3);
+        ccnxTlvDictionary_Display(actual, 3);
+    }
+
+    ccnxTlvDictionary_Release(&actual);
+    ccnxTlvDictionary_Release(&expected);
+    parcBuffer_Release(&packetBuffer);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_ArenaDecode_Interest)
+{
+    _assertArenaDecodeMatches(sizeof(v1_interest_all_fields), v1_interest_all_fields, ccnxCodecSchemaV1TlvDictionary_CreateInterest);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_ArenaDecode_ContentObject)
+{
+    _assertArenaDecodeMatches(sizeof(v1_content_nameA_keyid1_rsasha256), v1_content_nameA_keyid1_rsasha256,
+                              ccnxCodecSchemaV1TlvDictionary_CreateContentObject);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_ArenaDecode_Error)
+{
+    PARCBuffer *packetBuffer = parcBuffer_Wrap(v1_interest_bad_message_length, sizeof(v1_interest_bad_message_length), 0, sizeof(v1_interest_bad_message_length));
+
+    CCNxTlvDictionary *dict = ccnxCodecSchemaV1TlvDictionary_CreateInterest();
+    bool success = ccnxCodecTlvPacket_ArenaDecode(packetBuffer, dict);
+    assertFalse(success, "Expected the decode of a bad packet to fail");
+
+    // The teardown checks that the arena is freed with the dictionary.
+    ccnxTlvDictionary_Release(&dict);
+    parcBuffer_Release(&packetBuffer);
+}
+
+/*
+ * Equals decodes the rest of the lazy dictionary, so it must come out the same as a full decode.
+ */
+static void
+_assertLazyDecodeMatches(size_t length, uint8_t packet[length], CCNxTlvDictionary *(*createDictionary)(void))
+{
+    PARCBuffer *packetBuffer = parcBuffer_Wrap(packet, length, 0, length);
+
+    CCNxTlvDictionary *expected = createDictionary();
+    assertTrue(ccnxCodecTlvPacket_BufferDecode(packetBuffer, expected), "Failed to decode packet");
+
+    parcBuffer_Rewind(packetBuffer);
+    CCNxTlvDictionary *actual = createDictionary();
+    assertTrue(ccnxCodecTlvPacket_LazyDecode(packetBuffer, actual), "Failed to lazily decode packet");
+
+    assertTrue(ccnxTlvDictionary_Equals(expected, actual), "Lazy decode differs from buffer decode")
+    {
+        ccnxTlvDictionary_Display(expected, 3);
+        ccnxTlvDictionary_Display(actual, 3);
+    }
+    assertTrue(ccnxTlvDictionary_LazyDecodeAll(actual), "Expected every section to decode");
+
+    ccnxTlvDictionary_Release(&actual);
+    ccnxTlvDictionary_Release(&expected);
+    parcBuffer_Release(&packetBuffer);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_LazyDecode_Interest)
+{
+    _assertLazyDecodeMatches(sizeof(v1_interest_all_fields), v1_interest_all_fields, ccnxCodecSchemaV1TlvDictionary_CreateInterest);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_LazyDecode_ContentObject)
+{
+    _assertLazyDecodeMatches(sizeof(v1_content_nameA_keyid1_rsasha256), v1_content_nameA_keyid1_rsasha256,
+                             ccnxCodecSchemaV1TlvDictionary_CreateContentObject);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_Validate)
+{
+    // Put the packet 4 bytes into the buffer to check that offsets are from the buffer position
+    uint8_t shifted[4 + sizeof(v1_interest_bad_message_length)];
+    memset(shifted, 0xAA, 4);
+    memcpy(shifted + 4, v1_interest_bad_message_length, sizeof(v1_interest_bad_message_length));
+
+    PARCBuffer *packetBuffer = parcBuffer_Wrap(shifted, sizeof(shifted), 4, sizeof(shifted));
+    size_t errorOffset = 0;
+    CCNxCodecErrorCodes code = ccnxCodecTlvPacket_Validate(packetBuffer, &errorOffset);
+    assertTrue(code == TLV_ERR_TOO_LONG, "Expected '%s', got '%s'",
+               ccnxCodecError_ErrorMessage(TLV_ERR_TOO_LONG), ccnxCodecError_ErrorMessage(code));
+    assertTrue(errorOffset == 14, "Expected the error at the message TLV, offset 14, got %zu", errorOffset);
+    assertTrue(parcBuffer_Position(packetBuffer) == 4, "The buffer position should not change");
+    parcBuffer_Release(&packetBuffer);
+
+    packetBuffer = parcBuffer_Wrap(v1_interest_all_fields, sizeof(v1_interest_all_fields), 0, sizeof(v1_interest_all_fields));
+    code = ccnxCodecTlvPacket_Validate(packetBuffer, NULL);
+    assertTrue(code == TLV_ERR_NO_ERROR, "Good packet got '%s'", ccnxCodecError_ErrorMessage(code));
+    parcBuffer_Release(&packetBuffer);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_BufferDecode_Malformed)
+{
+    // A buffer too short for the fixed header is rejected, not read past its end
+    PARCBuffer *packetBuffer = parcBuffer_Wrap(v1_interest_all_fields, sizeof(v1_interest_all_fields), 0, 4);
+    CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateInterest();
+    assertFalse(ccnxCodecTlvPacket_BufferDecode(packetBuffer, dictionary), "Decoded a 4 byte buffer");
+    ccnxTlvDictionary_Release(&dictionary);
+    parcBuffer_Release(&packetBuffer);
+
+    packetBuffer = parcBuffer_Wrap(v1_interest_validation_alg_overrun, sizeof(v1_interest_validation_alg_overrun), 0,
+                                   sizeof(v1_interest_validation_alg_overrun));
+    dictionary = ccnxCodecSchemaV1TlvDictionary_CreateInterest();
+    assertFalse(ccnxCodecTlvPacket_BufferDecode(packetBuffer, dictionary), "Decoded a packet with an overrun ValidationAlg");
+    assertNull(ccnxTlvDictionary_GetName(dictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_NAME),
+               "A malformed packet should be rejected before any of it is decoded");
+    ccnxTlvDictionary_Release(&dictionary);
+    parcBuffer_Release(&packetBuffer);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_DecodeBatch_Malformed)
+{
+    PARCBuffer *buffers[] = {
+        parcBuffer_Wrap(v1_interest_validation_alg_overrun, sizeof(v1_interest_validation_alg_overrun), 0, sizeof(v1_interest_validation_alg_overrun)),
+        parcBuffer_Wrap(v1_interest_all_fields, sizeof(v1_interest_all_fields), 0, sizeof(v1_interest_all_fields)),
+    };
+    const size_t count = sizeof(buffers) / sizeof(buffers[0]);
+
+    CCNxTlvDictionary *dictionaries[count];
+    CCNxCodecErrorCodes status[count];
+    size_t decoded = ccnxCodecTlvPacket_DecodeBatch(count, buffers, dictionaries, status);
+    assertTrue(decoded == 1, "Expected 1 packet to decode, got %zu", decoded);
+
+    assertTrue(status[0] == TLV_ERR_TOO_LONG, "Overrun: got %s", ccnxCodecError_ErrorMessage(status[0]));
+    assertNull(dictionaries[0], "Expected no dictionary for the malformed packet");
+    assertTrue(status[1] == TLV_ERR_NO_ERROR, "Interest: got %s", ccnxCodecError_ErrorMessage(status[1]));
+
+    ccnxTlvDictionary_Release(&dictionaries[1]);
+    for (size_t i = 0; i < count; i++) {
+        parcBuffer_Release(&buffers[i]);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_DecodeBatch)
+{
+    uint8_t versionFF[sizeof(v1_interest_all_fields)];
+    memcpy(versionFF, v1_interest_all_fields, sizeof(versionFF));
+    versionFF[0] = 0xFF;
+
+    // The interest is padded, so the batch must set the limit from the packet length
+    uint8_t padded[sizeof(v1_interest_all_fields) + 16];
+    memset(padded, 0xAA, sizeof(padded));
+    memcpy(padded, v1_interest_all_fields, sizeof(v1_interest_all_fields));
+
+    PARCBuffer *buffers[] = {
+        parcBuffer_Wrap(padded, sizeof(padded), 0, sizeof(padded)),
+        parcBuffer_Wrap(v1_content_nameA_keyid1_rsasha256, sizeof(v1_content_nameA_keyid1_rsasha256), 0, sizeof(v1_content_nameA_keyid1_rsasha256)),
+        parcBuffer_Wrap(v1_interest_bad_message_length, sizeof(v1_interest_bad_message_length), 0, sizeof(v1_interest_bad_message_length)),
+        parcBuffer_Wrap(versionFF, sizeof(versionFF), 0, sizeof(versionFF)),
+        parcBuffer_Wrap(v1_interest_all_fields, sizeof(v1_interest_all_fields), 0, 4),
+        parcBuffer_Wrap(v1_interest_all_fields, sizeof(v1_interest_all_fields), 0, sizeof(v1_interest_all_fields) - 1),
+    };
+    const size_t count = sizeof(buffers) / sizeof(buffers[0]);
+
+    CCNxTlvDictionary *dictionaries[count];
+    CCNxCodecErrorCodes status[count];
+    size_t decoded = ccnxCodecTlvPacket_DecodeBatch(count, buffers, dictionaries, status);
+    assertTrue(decoded == 2, "Expected 2 packets to decode, got %zu", decoded);
+
+    assertTrue(status[0] == TLV_ERR_NO_ERROR, "Interest: got %s", ccnxCodecError_ErrorMessage(status[0]));
+    assertTrue(ccnxTlvDictionary_IsInterest(dictionaries[0]), "Expected an Interest dictionary");
+    assertTrue(status[1] == TLV_ERR_NO_ERROR, "ContentObject: got %s", ccnxCodecError_ErrorMessage(status[1]));
+    assertTrue(ccnxTlvDictionary_IsContentObject(dictionaries[1]), "Expected a ContentObject dictionary");
+
+    assertTrue(status[2] != TLV_ERR_NO_ERROR, "Expected the bad message length to fail");
+    assertTrue(status[3] == TLV_ERR_VERSION, "Version 0xFF: got %s", ccnxCodecError_ErrorMessage(status[3]));
+    assertTrue(status[4] == TLV_ERR_PACKETLENGTH_TOO_SHORT, "Short buffer: got %s", ccnxCodecError_ErrorMessage(status[4]));
+    assertTrue(status[5] == TLV_ERR_BEYOND_PACKET_END, "Truncated packet: got %s", ccnxCodecError_ErrorMessage(status[5]));
+    for (size_t i = 2; i < count; i++) {
+        assertNull(dictionaries[i], "Expected no dictionary for failed packet %zu", i);
+    }
+
+    // Each dictionary holds the only reference to its own arena, so it does not keep the rest of the burst
+    CCNxCodecArena *arena = ccnxTlvDictionary_GetArena(dictionaries[0]);
+    assertNotNull(arena, "Expected the dictionary to hold an arena");
+    assertTrue(ccnxTlvDictionary_GetArena(dictionaries[1]) != arena, "Expected each packet to have its own arena");
+    assertTrue(parcObject_GetReferenceCount(arena) == 1, "Expected only the dictionary to hold its arena, got %" PRIu64,
+               parcObject_GetReferenceCount(arena));
+
+    // Compare with the single packet decode
+    PARCBuffer *interest = parcBuffer_Wrap(v1_interest_all_fields, sizeof(v1_interest_all_fields), 0, sizeof(v1_interest_all_fields));
+    CCNxTlvDictionary *expected = ccnxCodecTlvPacket_Decode(interest);
+    assertTrue(ccnxTlvDictionary_Equals(expected, dictionaries[0]), "Batch decode differs from single decode")
+    {
+        ccnxTlvDictionary_Display(expected, 3);
+        ccnxTlvDictionary_Display(dictionaries[0], 3);
+    }
+    ccnxTlvDictionary_Release(&expected);
+    parcBuffer_Release(&interest);
+
+    ccnxTlvDictionary_Release(&dictionaries[0]);
+    ccnxTlvDictionary_Release(&dictionaries[1]);
+    for (size_t i = 0; i < count; i++) {
+        parcBuffer_Release(&buffers[i]);
+    }
+}
+
+static CCNxCodecNetworkBufferIoVec *
+_createIoVec(size_t length, uint8_t packet[length])
+{
+    CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_Create(&ParcMemoryMemoryBlock, NULL);
+    ccnxCodecNetworkBuffer_PutArray(netbuff, length, packet);
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecNetworkBuffer_CreateIoVec(netbuff);
+    ccnxCodecNetworkBuffer_Release(&netbuff);
+    return vec;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_IoVecDecodeBatch)
+{
+    CCNxCodecNetworkBufferIoVec *vecs[] = {
+        _createIoVec(sizeof(v1_interest_all_fields), v1_interest_all_fields),
+        _createIoVec(4, v1_interest_all_fields),
+        _createIoVec(sizeof(v1_content_nameA_keyid1_rsasha256), v1_content_nameA_keyid1_rsasha256),
+    };
+    const size_t count = sizeof(vecs) / sizeof(vecs[0]);
+
+    CCNxTlvDictionary *dictionaries[count];
+    CCNxCodecErrorCodes status[count];
+    size_t decoded = ccnxCodecTlvPacket_IoVecDecodeBatch(count, vecs, dictionaries, status);
+    assertTrue(decoded == 2, "Expected 2 packets to decode, got %zu", decoded);
+
+    assertTrue(status[0] == TLV_ERR_NO_ERROR, "Interest: got %s", ccnxCodecError_ErrorMessage(status[0]));
+    assertTrue(status[1] == TLV_ERR_PACKETLENGTH_TOO_SHORT, "Short iovec: got %s", ccnxCodecError_ErrorMessage(status[1]));
+    assertNull(dictionaries[1], "Expected no dictionary for the short iovec");
+    assertTrue(status[2] == TLV_ERR_NO_ERROR, "ContentObject: got %s", ccnxCodecError_ErrorMessage(status[2]));
+
+    assertTrue(ccnxTlvDictionary_GetIoVec(dictionaries[0], CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_WireFormat) == vecs[0],
+               "Expected the iovec to be saved as the wire format");
+    assertTrue(ccnxTlvDictionary_GetArena(dictionaries[0]) != ccnxTlvDictionary_GetArena(dictionaries[2]),
+               "Expected each packet to have its own arena");
+
+    ccnxTlvDictionary_Release(&dictionaries[0]);
+    ccnxTlvDictionary_Release(&dictionaries[2]);
+    for (size_t i = 0; i < count; i++) {
+        ccnxCodecNetworkBufferIoVec_Release(&vecs[i]);
+    }
+}
+
 typedef struct allocator_arg {
     size_t maxallocation;
 } AllocatorArg;
@@ -235,6 +519,26 @@ runIoVecTest(AllocatorArg maxalloc)
     bool success = ccnxCodecTlvPacket_IoVecDecode(vec, output);
     assertTrue(success, "Failed to decode buffer in iovec format");
 
+    // The values are sliced from the iovec, so the dictionary must hold the iovec as its wire format
+    assertTrue(ccnxTlvDictionary_GetIoVec(output, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_WireFormat) == vec,
+               "Expected the iovec to be saved as the wire format");
+
+    PARCBuffer *buffer = parcBuffer_Wrap(v1_interest_all_fields, sizeof(v1_interest_all_fields), 0, sizeof(v1_interest_all_fields));
+    CCNxTlvDictionary *expected = ccnxTlvDictionary_Create(CCNxCodecSchemaV1TlvDictionary_MessageFastArray_END, CCNxCodecSchemaV1TlvDictionary_Lists_END);
+    ccnxTlvDictionary_SetMessageType_Interest(expected, CCNxTlvDictionary_SchemaVersion_V1);
+    success = ccnxCodecTlvPacket_BufferDecode(buffer, expected);
+    assertTrue(success, "Failed to decode buffer");
+
+    CCNxName *expectedName = ccnxTlvDictionary_GetName(expected, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_NAME);
+    CCNxName *actualName = ccnxTlvDictionary_GetName(output, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_NAME);
+    assertTrue(ccnxName_Equals(expectedName, actualName), "Names decoded from the iovec and the buffer differ");
+
+    PARCBuffer *expectedPayload = ccnxTlvDictionary_GetBuffer(expected, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOAD);
+    PARCBuffer *actualPayload = ccnxTlvDictionary_GetBuffer(output, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_PAYLOAD);
+    assertTrue(parcBuffer_Equals(expectedPayload, actualPayload), "Payloads decoded from the iovec and the buffer differ");
+
+    ccnxTlvDictionary_Release(&expected);
+    parcBuffer_Release(&buffer);
     ccnxTlvDictionary_Release(&output);
     ccnxCodecNetworkBufferIoVec_Release(&vec);
     ccnxCodecNetworkBuffer_Release(&netbuff);
@@ -351,6 +655,99 @@ LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_EncodeWithSignature)
     ccnxContentObject_Release(&obj);
 }
 
+/*
+ * SHA256 of the iovec from the end of the fixed and optional headers to the end of the packet,
+ * which is what the ContentObjectHash covers.
+ */
+static PARCCryptoHash *
+_hashIoVecAfterHeaders(CCNxCodecNetworkBufferIoVec *iovec)
+{
+    const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(iovec);
+    int count = ccnxCodecNetworkBufferIoVec_GetCount(iovec);
+    size_t skip = ((const uint8_t *) array[0].iov_base)[7];
+
+    PARCCryptoHasher *hasher = parcCryptoHasher_Create(PARCCryptoHashType_SHA256);
+    parcCryptoHasher_Init(hasher);
+    for (int i = 0; i < count; i++) {
+        size_t offset = (skip < array[i].iov_len) ? skip : array[i].iov_len;
+        parcCryptoHasher_UpdateBytes(hasher, (const uint8_t *) array[i].iov_base + offset, array[i].iov_len - offset);
+        skip -= offset;
+    }
+    PARCCryptoHash *hash = parcCryptoHasher_Finalize(hasher);
+    parcCryptoHasher_Release(&hasher);
+    return hash;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_DictionaryEncodeAndSign)
+{
+    CCNxName *name = ccnxName_CreateFromCString("ccnx:/foo/bar");
+    PARCBuffer *payload = parcBuffer_WrapCString("payload");
+    CCNxContentObject *obj = ccnxContentObject_CreateWithNameAndPayload(name, payload);
+    ccnxName_Release(&name);
+    parcBuffer_Release(&payload);
+
+    PARCBuffer *secretKey = parcBuffer_WrapCString("abcdefghijklmnopqrstuvwxyx");
+    PARCSigner *signer = ccnxValidationHmacSha256_CreateSigner(secretKey);
+    parcBuffer_Release(&secretKey);
+
+    PARCKeyStore *keyStore = parcSigner_GetKeyStore(signer);
+    const PARCCryptoHash *secretHash = parcKeyStore_GetVerifierKeyDigest(keyStore);
+    const PARCBuffer *keyid = parcCryptoHash_GetDigest(secretHash);
+    ccnxValidationHmacSha256_Set(obj, keyid);
+    parcCryptoHash_Release((PARCCryptoHash **) &secretHash);
+
+    PARCCryptoHash *contentObjectHash = NULL;
+    CCNxCodecNetworkBufferIoVec *iovec = ccnxCodecTlvPacket_DictionaryEncodeAndSign(obj, signer, &contentObjectHash);
+    assertNotNull(iovec, "Got null iovec");
+    assertNotNull(contentObjectHash, "Got null ContentObjectHash");
+
+    // The signer is wired through, so the signature is in the dictionary and at the end of the wire format
+    PARCBuffer *sigbits = ccnxTlvDictionary_GetBuffer(obj, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_PAYLOAD);
+    assertNotNull(sigbits, "The signer did not generate a ValidationPayload");
+    assertTrue(parcBuffer_Remaining(sigbits) == 32, "HMAC-SHA256 should be 32 bytes, got %zu", parcBuffer_Remaining(sigbits));
+
+    // The signature space was reserved when measuring, so the packet is one block
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(iovec) == 1, "Expected 1 iovec, got %d", ccnxCodecNetworkBufferIoVec_GetCount(iovec));
+    const struct iovec *array = ccnxCodecNetworkBufferIoVec_GetArray(iovec);
+    size_t length = ccnxCodecNetworkBufferIoVec_Length(iovec);
+    assertTrue(memcmp((const uint8_t *) array[0].iov_base + length - 32, parcBuffer_Overlay(sigbits, 0), 32) == 0,
+               "The signature is not the last 32 bytes of the packet");
+
+    PARCCryptoHash *truth = _hashIoVecAfterHeaders(iovec);
+    assertTrue(parcCryptoHash_Equals(truth, contentObjectHash), "Wrong ContentObjectHash")
+    {
+        parcBuffer_Display(parcCryptoHash_GetDigest(truth), 3);
+        parcBuffer_Display(parcCryptoHash_GetDigest(contentObjectHash), 3);
+    }
+
+    parcCryptoHash_Release(&truth);
+    parcCryptoHash_Release(&contentObjectHash);
+    ccnxCodecNetworkBufferIoVec_Release(&iovec);
+    parcSigner_Release(&signer);
+    ccnxContentObject_Release(&obj);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxCodecTlvPacket_DictionaryEncodeAndSign_Unsigned)
+{
+    CCNxName *name = ccnxName_CreateFromCString("ccnx:/foo/bar");
+    PARCBuffer *payload = parcBuffer_WrapCString("payload");
+    CCNxContentObject *obj = ccnxContentObject_CreateWithNameAndPayload(name, payload);
+    ccnxName_Release(&name);
+    parcBuffer_Release(&payload);
+
+    PARCCryptoHash *contentObjectHash = NULL;
+    CCNxCodecNetworkBufferIoVec *iovec = ccnxCodecTlvPacket_DictionaryEncodeAndSign(obj, NULL, &contentObjectHash);
+    assertNotNull(iovec, "Got null iovec");
+
+    PARCCryptoHash *truth = _hashIoVecAfterHeaders(iovec);
+    assertTrue(parcCryptoHash_Equals(truth, contentObjectHash), "Wrong ContentObjectHash");
+
+    parcCryptoHash_Release(&truth);
+    parcCryptoHash_Release(&contentObjectHash);
+    ccnxCodecNetworkBufferIoVec_Release(&iovec);
+    ccnxContentObject_Release(&obj);
+}
+
 static uint8_t testDataV1_Interest_AllFields[] = {
     0x01, 0x00, 0x00,  100,     // ver = 1, type = interest, length = 100
     0x20, 0x00, 0x11,   14,     // HopLimit = 32, reserved = 0, flags = 0x11, header length = 14
@@ -478,6 +875,296 @@ LONGBOW_TEST_CASE(Global, _decodeV1_Error)
 
 // =================================================================
 
+/*
+ * The Performance fixture counts every parcMemory allocation, so it reports the allocations per packet
+ * as well as the time per packet.  It runs on the stdlib allocator so the timing is not skewed by safe memory.
+ */
+static uint64_t _allocationCount;
+static uint64_t _deallocationCount;
+
+static void *
+_countingAllocate(size_t size)
+{
+    _allocationCount++;
+    return parcStdlibMemory_Allocate(size);
+}
+
+static void *
+_countingAllocateAndClear(size_t size)
+{
+    _allocationCount++;
+    return parcStdlibMemory_AllocateAndClear(size);
+}
+
+static int
+_countingMemAlign(void **pointer, size_t alignment, size_t size)
+{
+    _allocationCount++;
+    return parcStdlibMemory_MemAlign(pointer, alignment, size);
+}
+
+static void
+_countingDeallocate(void **pointer)
+{
+    _deallocationCount++;
+    parcStdlibMemory_Deallocate(pointer);
+}
+
+static void *
+_countingReallocate(void *pointer, size_t newSize)
+{
+    if (pointer == NULL) {
+        _allocationCount++;
+    }
+    return parcStdlibMemory_Reallocate(pointer, newSize);
+}
+
+static char *
+_countingStringDuplicate(const char *string, size_t length)
+{
+    _allocationCount++;
+    return parcStdlibMemory_StringDuplicate(string, length);
+}
+
+static uint32_t
+_countingOutstanding(void)
+{
+    return (uint32_t) (_allocationCount - _deallocationCount);
+}
+
+static PARCMemoryInterface _countingMemory = {
+    .Allocate         = (uintptr_t) _countingAllocate,
+    .AllocateAndClear = (uintptr_t) _countingAllocateAndClear,
+    .MemAlign         = (uintptr_t) _countingMemAlign,
+    .Deallocate       = (uintptr_t) _countingDeallocate,
+    .Reallocate       = (uintptr_t) _countingReallocate,
+    .StringDuplicate  = (uintptr_t) _countingStringDuplicate,
+    .Outstanding      = (uintptr_t) _countingOutstanding
+};
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxCodecTlvPacket_BufferDecode_ArenaDecode);
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxCodecTlvPacket_Decode_DecodeBatch);
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxCodecTlvPacket_BufferDecode_LazyDecode);
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxCodecTlvPacket_Validate_Malformed);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    _allocationCount = 0;
+    _deallocationCount = 0;
+    parcMemory_SetInterface(&_countingMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    if (_allocationCount != _deallocationCount) {
+        printf("%s leaks memory by %" PRIu64 " allocations\n", longBowTestCase_GetName(testCase), _allocationCount - _deallocationCount);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static void
+_benchmarkDecode(const char *label, size_t length, uint8_t packet[length], CCNxTlvDictionary *(*createDictionary)(void),
+                 bool (*decode)(PARCBuffer *packetBuffer, CCNxTlvDictionary *packetDictionary))
+{
+    unsigned trials = 200000;
+    PARCBuffer *packetBuffer = parcBuffer_Wrap(packet, length, 0, length);
+
+    uint64_t allocationsBefore = _allocationCount;
+    struct timeval t0, t1;
+    gettimeofday(&t0, NULL);
+    for (unsigned i = 0; i < trials; i++) {
+        CCNxTlvDictionary *dictionary = createDictionary();
+        bool success = decode(packetBuffer, dictionary);
+        assertTrue(success, "Failed to decode %s", label);
+        ccnxTlvDictionary_Release(&dictionary);
+        parcBuffer_Rewind(packetBuffer);
+    }
+    gettimeofday(&t1, NULL);
+    timersub(&t1, &t0, &t1);
+    double seconds = t1.tv_sec + t1.tv_usec * 1E-6;
+    double allocations = (double) (_allocationCount - allocationsBefore) / trials;
+
+    printf("\n%-32s iterations %u seconds %.3f ns/packet %.1f allocations/packet %.1f\n",
+           label, trials, seconds, seconds * 1E9 / trials, allocations);
+
+    parcBuffer_Release(&packetBuffer);
+}
+
+LONGBOW_TEST_CASE(Performance, ccnxCodecTlvPacket_BufferDecode_ArenaDecode)
+{
+    _benchmarkDecode("Interest BufferDecode", sizeof(v1_interest_all_fields), v1_interest_all_fields,
+                     ccnxCodecSchemaV1TlvDictionary_CreateInterest, ccnxCodecTlvPacket_BufferDecode);
+    _benchmarkDecode("Interest ArenaDecode", sizeof(v1_interest_all_fields), v1_interest_all_fields,
+                     ccnxCodecSchemaV1TlvDictionary_CreateInterest, ccnxCodecTlvPacket_ArenaDecode);
+
+    _benchmarkDecode("ContentObject BufferDecode", sizeof(v1_content_nameA_keyid1_rsasha256), v1_content_nameA_keyid1_rsasha256,
+                     ccnxCodecSchemaV1TlvDictionary_CreateContentObject, ccnxCodecTlvPacket_BufferDecode);
+    _benchmarkDecode("ContentObject ArenaDecode", sizeof(v1_content_nameA_keyid1_rsasha256), v1_content_nameA_keyid1_rsasha256,
+                     ccnxCodecSchemaV1TlvDictionary_CreateContentObject, ccnxCodecTlvPacket_ArenaDecode);
+}
+
+/*
+ * Decode bursts of `burst` packets, alternating Interests and Content Objects, one at a time and as a batch.
+ */
+static void
+_benchmarkDecodeBatch(size_t burst)
+{
+    unsigned bursts = 200000 / (unsigned) burst;
+    PARCBuffer *buffers[burst];
+    CCNxTlvDictionary *dictionaries[burst];
+    CCNxCodecErrorCodes status[burst];
+    for (size_t i = 0; i < burst; i++) {
+        if (i % 2 == 0) {
+            buffers[i] = parcBuffer_Wrap(v1_interest_all_fields, sizeof(v1_interest_all_fields), 0, sizeof(v1_interest_all_fields));
+        } else {
+            buffers[i] = parcBuffer_Wrap(v1_content_nameA_keyid1_rsasha256, sizeof(v1_content_nameA_keyid1_rsasha256), 0,
+                                         sizeof(v1_content_nameA_keyid1_rsasha256));
+        }
+    }
+
+    struct timeval t0, t1;
+    for (int batch = 0; batch < 2; batch++) {
+        uint64_t allocationsBefore = _allocationCount;
+        gettimeofday(&t0, NULL);
+        for (unsigned b = 0; b < bursts; b++) {
+            if (batch) {
+                size_t decoded = ccnxCodecTlvPacket_DecodeBatch(burst, buffers, dictionaries, status);
+                assertTrue(decoded == burst, "Decoded %zu of %zu packets", decoded, burst);
+            } else {
+                for (size_t i = 0; i < burst; i++) {
+                    dictionaries[i] = ccnxCodecTlvPacket_Decode(buffers[i]);
+                    assertNotNull(dictionaries[i], "Failed to decode packet %zu", i);
+                }
+            }
+
+            for (size_t i = 0; i < burst; i++) {
+                ccnxTlvDictionary_Release(&dictionaries[i]);
+                parcBuffer_Rewind(buffers[i]);
+            }
+        }
+        gettimeofday(&t1, NULL);
+        timersub(&t1, &t0, &t1);
+        double seconds = t1.tv_sec + t1.tv_usec * 1E-6;
+        double packets = (double) bursts * burst;
+        double allocations = (double) (_allocationCount - allocationsBefore) / packets;
+
+        printf("\n%-12s burst %3zu iterations %u seconds %.3f ns/packet %.1f allocations/packet %.1f\n",
+               batch ? "DecodeBatch" : "Decode", burst, bursts, seconds, seconds * 1E9 / packets, allocations);
+    }
+
+    for (size_t i = 0; i < burst; i++) {
+        parcBuffer_Release(&buffers[i]);
+    }
+}
+
+LONGBOW_TEST_CASE(Performance, ccnxCodecTlvPacket_Decode_DecodeBatch)
+{
+    _benchmarkDecodeBatch(32);
+    _benchmarkDecodeBatch(64);
+    _benchmarkDecodeBatch(256);
+}
+
+/*
+ * What a forwarder looks at: the name and the restrictions to match against the PIT and Content Store.
+ */
+static void
+_benchmarkForwardingDecode(const char *label, size_t length, uint8_t packet[length], CCNxTlvDictionary *(*createDictionary)(void),
+                           bool (*decode)(PARCBuffer *packetBuffer, CCNxTlvDictionary *packetDictionary))
+{
+    unsigned trials = 200000;
+    PARCBuffer *packetBuffer = parcBuffer_Wrap(packet, length, 0, length);
+
+    uint64_t allocationsBefore = _allocationCount;
+    struct timeval t0, t1;
+    gettimeofday(&t0, NULL);
+    for (unsigned i = 0; i < trials; i++) {
+        CCNxTlvDictionary *dictionary = createDictionary();
+        bool success = decode(packetBuffer, dictionary);
+        assertTrue(success, "Failed to decode %s", label);
+
+        CCNxName *name = ccnxTlvDictionary_GetName(dictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_NAME);
+        assertNotNull(name, "Missing name in %s", label);
+        (void) ccnxTlvDictionary_GetBuffer(dictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_KEYID_RESTRICTION);
+        (void) ccnxTlvDictionary_GetBuffer(dictionary, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_OBJHASH_RESTRICTION);
+
+        ccnxTlvDictionary_Release(&dictionary);
+        parcBuffer_Rewind(packetBuffer);
+    }
+    gettimeofday(&t1, NULL);
+    timersub(&t1, &t0, &t1);
+    double seconds = t1.tv_sec + t1.tv_usec * 1E-6;
+    double allocations = (double) (_allocationCount - allocationsBefore) / trials;
+
+    printf("\n%-32s iterations %u seconds %.3f ns/packet %.1f allocations/packet %.1f\n",
+           label, trials, seconds, seconds * 1E9 / trials, allocations);
+
+    parcBuffer_Release(&packetBuffer);
+}
+
+LONGBOW_TEST_CASE(Performance, ccnxCodecTlvPacket_BufferDecode_LazyDecode)
+{
+    _benchmarkForwardingDecode("Interest BufferDecode", sizeof(v1_interest_all_fields), v1_interest_all_fields,
+                               ccnxCodecSchemaV1TlvDictionary_CreateInterest, ccnxCodecTlvPacket_BufferDecode);
+    _benchmarkForwardingDecode("Interest LazyDecode", sizeof(v1_interest_all_fields), v1_interest_all_fields,
+                               ccnxCodecSchemaV1TlvDictionary_CreateInterest, ccnxCodecTlvPacket_LazyDecode);
+
+    _benchmarkForwardingDecode("ContentObject BufferDecode", sizeof(v1_content_nameA_keyid1_rsasha256), v1_content_nameA_keyid1_rsasha256,
+                               ccnxCodecSchemaV1TlvDictionary_CreateContentObject, ccnxCodecTlvPacket_BufferDecode);
+    _benchmarkForwardingDecode("ContentObject LazyDecode", sizeof(v1_content_nameA_keyid1_rsasha256), v1_content_nameA_keyid1_rsasha256,
+                               ccnxCodecSchemaV1TlvDictionary_CreateContentObject, ccnxCodecTlvPacket_LazyDecode);
+}
+
+/*
+ * Reject a malformed packet `trials` times, either with the structure validator or by running the decoder
+ * until it fails, as happened before the validator.
+ */
+static void
+_benchmarkReject(const char *label, size_t length, uint8_t packet[length], bool validate)
+{
+    unsigned trials = 200000;
+    PARCBuffer *packetBuffer = parcBuffer_Wrap(packet, length, 0, length);
+
+    uint64_t allocationsBefore = _allocationCount;
+    struct timeval t0, t1;
+    gettimeofday(&t0, NULL);
+    for (unsigned i = 0; i < trials; i++) {
+        if (validate) {
+            CCNxCodecErrorCodes code = ccnxCodecTlvPacket_Validate(packetBuffer, NULL);
+            assertTrue(code != TLV_ERR_NO_ERROR, "Validated %s", label);
+        } else {
+            CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateInterest();
+            bool success = ccnxCodecSchemaV1PacketDecoder_BufferDecode(packetBuffer, dictionary);
+            assertFalse(success, "Decoded %s", label);
+            ccnxTlvDictionary_Release(&dictionary);
+        }
+        parcBuffer_Rewind(packetBuffer);
+    }
+    gettimeofday(&t1, NULL);
+    timersub(&t1, &t0, &t1);
+    double seconds = t1.tv_sec + t1.tv_usec * 1E-6;
+    double allocations = (double) (_allocationCount - allocationsBefore) / trials;
+
+    printf("\n%-32s iterations %u seconds %.3f ns/packet %.1f allocations/packet %.1f\n",
+           label, trials, seconds, seconds * 1E9 / trials, allocations);
+
+    parcBuffer_Release(&packetBuffer);
+}
+
+LONGBOW_TEST_CASE(Performance, ccnxCodecTlvPacket_Validate_Malformed)
+{
+    // The overrun is in the ValidationAlg, so the decoder has done most of the packet before it fails
+    _benchmarkReject("Overrun decoder reject", sizeof(v1_interest_validation_alg_overrun), v1_interest_validation_alg_overrun, false);
+    _benchmarkReject("Overrun validator reject", sizeof(v1_interest_validation_alg_overrun), v1_interest_validation_alg_overrun, true);
+}
+
+// =================================================================
+
 int
 main(int argc, char *argv[])
 {
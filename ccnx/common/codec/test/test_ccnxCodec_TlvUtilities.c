@@ -481,9 +481,10 @@ LONGBOW_TEST_CASE(Global, ccnxCodecTlvUtilities_EncodeCustomList)
 
     // put 3 buffers of {0x01, 0x02} and {0x03} and {0x04, 0x05, x06} on the list
     int listkey = 1;
-    ccnxTlvDictionary_PutListBuffer(dictionary, listkey, 2, buffers[2]);
-    ccnxTlvDictionary_PutListBuffer(dictionary, listkey, 1, buffers[1]);
+    // lists keep the order they were put in, which is the wire order
     ccnxTlvDictionary_PutListBuffer(dictionary, listkey, 0, buffers[0]);
+    ccnxTlvDictionary_PutListBuffer(dictionary, listkey, 1, buffers[1]);
+    ccnxTlvDictionary_PutListBuffer(dictionary, listkey, 2, buffers[2]);
 
     CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
     ccnxCodecTlvUtilities_EncodeCustomList(encoder, dictionary, listkey);
@@ -282,6 +282,8 @@ CCNxContentObjectInterface CCNxContentObjectFacadeV1_Implementation = {
 
     .setSignature        = &_ccnxContentObjectFacadeV1_SetSignature,
     .getKeyId            = &_ccnxContentObjectFacadeV1_GetKeyId,
+    .setUnsigned         = &ccnxValidationFacadeV1_SetUnsigned,
+    .isUnsigned          = &ccnxValidationFacadeV1_IsUnsigned,
 
     .getName             = &_ccnxContentObjectFacadeV1_GetName,
     .getPayload          = &_ccnxContentObjectFacadeV1_GetPayload,
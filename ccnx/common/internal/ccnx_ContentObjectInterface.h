@@ -96,6 +96,12 @@ typedef struct ccnx_contentobject_interface {
     /** @see ccnxContentObject_GetKeyId */
     PARCBuffer         *(*getKeyId)(const CCNxTlvDictionary * dict);
 
+    /** @see ccnxContentObject_SetUnsigned */
+    bool                (*setUnsigned)(CCNxTlvDictionary *dict);
+
+    /** @see ccnxContentObject_IsUnsigned */
+    bool                (*isUnsigned)(const CCNxTlvDictionary *dict);
+
     /** @see ccnxContentObject_GetPayload */
     PARCBuffer         *(*getPayload)(const CCNxTlvDictionary * dict);
 
@@ -64,7 +64,8 @@
 
 #include <LongBow/runtime.h>
 
-#include <parc/algol/parc_JSON.h>
+#include <parc/algol/parc_LinkedList.h>
+#include <parc/algol/parc_Object.h>
 
 #include <ccnx/common/ccnx_Manifest.h>
 #include <ccnx/common/internal/ccnx_ManifestInterface.h>
@@ -95,42 +96,53 @@ _ccnxManifestFacadeV1_GetName(const CCNxTlvDictionary *dict)
     return ccnxTlvDictionary_GetName(dict, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_NAME);
 }
 
+/*
+ * The hash groups are kept as a PARCLinkedList of CCNxManifestHashGroup objects, in the order they were added,
+ * so encoding and comparing a manifest does not need to rebuild the groups.  Each group is a private copy
+ * of the one the caller added, so the caller's later changes do not reach the manifest.
+ */
+static PARCLinkedList *
+_ccnxManifestFacadeV1_GetHashGroupList(const CCNxTlvDictionary *dict)
+{
+    return ccnxTlvDictionary_GetObject(dict, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_HASH_GROUP);
+}
+
 static void
 _ccnxManifestFacadeV1_AddHashGroup(CCNxTlvDictionary *dict, const CCNxManifestHashGroup *group)
 {
-    PARCJSON *json = ccnxManifestHashGroup_ToJson(group);
-    size_t numGroups = _ccnxManifestFacadeV1_GetNumberOfHashGroups(dict);
-
-    char *jsonString = parcJSON_ToString(json);
-    PARCBuffer *buffer = parcBuffer_AllocateCString(jsonString);
-    parcMemory_Deallocate(&jsonString);
-    parcJSON_Release(&json);
+    PARCLinkedList *groups = _ccnxManifestFacadeV1_GetHashGroupList(dict);
+    if (groups == NULL) {
+        groups = parcLinkedList_Create();
+        ccnxTlvDictionary_PutObject(dict, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_HASH_GROUP, groups);
+        parcLinkedList_Release(&groups);
+        groups = _ccnxManifestFacadeV1_GetHashGroupList(dict);
+    } else if (parcObject_GetReferenceCount(groups) > 1) {
+        // Shared with a ShallowCopy, so take a private copy before appending to it
+        PARCLinkedList *copy = parcLinkedList_Copy(groups);
+        ccnxTlvDictionary_ReplaceObject(dict, CCNxCodecSchemaV1TlvDictionary_MessageFastArray_HASH_GROUP, copy);
+        parcLinkedList_Release(&copy);
+        groups = _ccnxManifestFacadeV1_GetHashGroupList(dict);
+    }
 
-    ccnxTlvDictionary_PutListBuffer(dict, CCNxCodecSchemaV1TlvDictionary_Lists_HASH_GROUP_LIST, (uint32_t) numGroups, buffer);
-    parcBuffer_Release(&buffer);
+    CCNxManifestHashGroup *snapshot = ccnxManifestHashGroup_Copy(group);
+    parcLinkedList_Append(groups, snapshot);
+    ccnxManifestHashGroup_Release(&snapshot);
 }
 
 static CCNxManifestHashGroup *
 _ccnxManifestFacadeV1_GetHashGroup(const CCNxTlvDictionary *dict, size_t index)
 {
-    PARCBuffer *buffer = NULL;
-    uint32_t key;
-    ccnxTlvDictionary_ListGetByPosition(dict, CCNxCodecSchemaV1TlvDictionary_Lists_HASH_GROUP_LIST, index, &buffer, &key);
-
-    char *jsonString = parcBuffer_ToString(buffer);
-    PARCJSON *json = parcJSON_ParseString(jsonString);
-    parcMemory_Deallocate(&jsonString);
-
-    CCNxManifestHashGroup *group = ccnxManifestHashGroup_CreateFromJson(json);
-    parcJSON_Release(&json);
+    PARCLinkedList *groups = _ccnxManifestFacadeV1_GetHashGroupList(dict);
+    assertNotNull(groups, "The manifest has no hash groups");
 
-    return group;
+    return ccnxManifestHashGroup_Acquire(parcLinkedList_GetAtIndex(groups, index));
 }
 
 static size_t
 _ccnxManifestFacadeV1_GetNumberOfHashGroups(const CCNxTlvDictionary *dict)
 {
-    size_t numHashGroups = ccnxTlvDictionary_ListSize(dict, CCNxCodecSchemaV1TlvDictionary_Lists_HASH_GROUP_LIST);
+    PARCLinkedList *groups = _ccnxManifestFacadeV1_GetHashGroupList(dict);
+    size_t numHashGroups = (groups == NULL) ? 0 : parcLinkedList_Size(groups);
     return numHashGroups;
 }
 
@@ -146,17 +158,11 @@ _ccnxManifestFacadeV1_Equals(const CCNxTlvDictionary *dictA, const CCNxTlvDictio
 
     if (ccnxName_Equals(_ccnxManifestFacadeV1_GetName(dictA), _ccnxManifestFacadeV1_GetName(dictB))) {
         if (_ccnxManifestFacadeV1_GetNumberOfHashGroups(dictA) == _ccnxManifestFacadeV1_GetNumberOfHashGroups(dictB)) {
-            for (size_t i = 0; i < _ccnxManifestFacadeV1_GetNumberOfHashGroups(dictA); i++) {
-                CCNxManifestHashGroup *groupA = _ccnxManifestFacadeV1_GetHashGroup(dictA, i);
-                CCNxManifestHashGroup *groupB = _ccnxManifestFacadeV1_GetHashGroup(dictB, i);
-
-                if (!ccnxManifestHashGroup_Equals(groupA, groupB)) {
-                    ccnxManifestHashGroup_Release(&groupA);
-                    ccnxManifestHashGroup_Release(&groupB);
-                    return false;
-                }
+            if (_ccnxManifestFacadeV1_GetNumberOfHashGroups(dictA) == 0) {
+                return true;
             }
-            return true;
+            // Compares the groups in order with ccnxManifestHashGroup_Equals
+            return parcLinkedList_Equals(_ccnxManifestFacadeV1_GetHashGroupList(dictA), _ccnxManifestFacadeV1_GetHashGroupList(dictB));
         }
     }
     return false;
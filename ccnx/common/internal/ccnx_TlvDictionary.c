@@ -32,6 +32,7 @@
 
 #include <config.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/time.h>
 #include <inttypes.h>
 #include <stdio.h>
@@ -52,6 +53,7 @@
 
 struct ccnx_tlv_dictionary_entry;
 typedef struct ccnx_tlv_list_entry _CCNxTlvDictionaryListEntry;
+typedef struct ccnx_tlv_dictionary_list _CCNxTlvDictionaryList;
 
 typedef enum {
     CCNxTlvDictionaryType_Unknown,
@@ -62,13 +64,35 @@ typedef enum {
     CCNxTlvDictionaryType_Manifest
 } _CCNxTlvDictionaryType;
 
-// These form a singly linked list
+// An unknown TLV, stored by value in its list
 struct ccnx_tlv_list_entry {
-    _CCNxTlvDictionaryListEntry *next;
     PARCBuffer *buffer;
     uint16_t key;
 };
 
+#define LIST_INITIAL_CAPACITY 4
+
+// Lists this long get an index for ListGetByType, shorter ones are scanned
+#define LIST_INDEX_THRESHOLD  8
+
+/*
+ * A list of unknown TLVs in the order they were put (wire order when decoded).
+ * A ShallowCopy shares its source's lists by reference count, and a dictionary copies a shared
+ * list before it appends to it, so neither sees the other's new entries.
+ */
+struct ccnx_tlv_dictionary_list {
+    unsigned refcount;
+    size_t count;
+    size_t capacity;
+
+    // Open addressing from key to (position + 1) of the first entry with that key, 0 for an empty slot.
+    // NULL until the list reaches LIST_INDEX_THRESHOLD entries.
+    uint32_t *index;
+    size_t indexMask;
+
+    _CCNxTlvDictionaryListEntry entries[];
+};
+
 #define ENTRY_UNSET   ((int) 0)
 #define ENTRY_BUFFER  ((int) 1)
 #define ENTRY_NAME    ((int) 2)
@@ -131,6 +155,9 @@ _ccnxTlvDictionaryTypeToString(_CCNxTlvDictionaryType dictionaryType)
 
 typedef struct ccnx_tlv_dictionary_entry {
     int entryType;
+
+    // true if the value is held by the source of a ShallowCopy and must not be released here
+    bool borrowed;
     union u_entry {
         PARCBuffer *buffer;
         uint64_t integer;
@@ -143,12 +170,12 @@ typedef struct ccnx_tlv_dictionary_entry {
 
 struct ccnx_tlv_dictionary {
 #define FIXED_LIST_LENGTH 8
-    // These are linked lists where we put unknown TLV types.  This one static allocation should
+    // These are the lists where we put unknown TLV types.  This one static allocation should
     // be enough for all the current packet formats.
-    _CCNxTlvDictionaryListEntry *fixedListHeads[FIXED_LIST_LENGTH];
+    _CCNxTlvDictionaryList *fixedLists[FIXED_LIST_LENGTH];
 
     // if we need to allocate beyond FIXED_LIST_LENGTH, put them here
-    _CCNxTlvDictionaryListEntry **extraListHeads;
+    _CCNxTlvDictionaryList **extraLists;
 
     size_t fastArraySize;
     size_t listSize;
@@ -169,40 +196,206 @@ struct ccnx_tlv_dictionary {
     // the wire, it will need to be initialized based on the dictionaryType and schemaVersion.
     CCNxMessageInterface *messageInterface;
 
+    // The decode state of the packet, if it was decoded with an arena.  Released with the dictionary.
+    CCNxCodecArena *arena;
+
+    // The dictionary this one is a ShallowCopy of.  It holds the borrowed entries and list tails.
+    CCNxTlvDictionary *source;
+
+    // Fills in the rest of the dictionary on first use, see ccnxTlvDictionary_SetLazyDecoder()
+    CCNxTlvDictionaryLazyDecoder *lazyDecoder;
+    void *lazyState;
+    void (*lazyStateFreeFunction)(void **statePtr);
+    bool lazyDecoding;
+
     // will be allocated as part of the ccnx_tlv_dictionary
     _CCNxTlvDictionaryEntry directArray[CCNxCodecSchemaV1TlvDictionary_MessageFastArray_END];
 };
 
-static _CCNxTlvDictionaryListEntry *
-_ccnxTlvDictionaryListEntry_Create(uint32_t key, const PARCBuffer *buffer)
+static size_t
+_ccnxTlvDictionaryList_Hash(uint16_t key, size_t mask)
 {
-    _CCNxTlvDictionaryListEntry *entry = parcMemory_AllocateAndClear(sizeof(_CCNxTlvDictionaryListEntry));
-    assertNotNull(entry, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(_CCNxTlvDictionaryListEntry));
-    entry->key = key;
-    entry->buffer = parcBuffer_Acquire(buffer);
+    uint32_t hash = key * 2654435761u;
+    return (hash ^ (hash >> 16)) & mask;
+}
 
-    return entry;
+static void
+_ccnxTlvDictionaryList_IndexInsert(_CCNxTlvDictionaryList *list, size_t position)
+{
+    uint16_t key = list->entries[position].key;
+    size_t slot = _ccnxTlvDictionaryList_Hash(key, list->indexMask);
+    while (list->index[slot] != 0) {
+        if (list->entries[list->index[slot] - 1].key == key) {
+            // keep the first entry with the key
+            return;
+        }
+        slot = (slot + 1) & list->indexMask;
+    }
+    list->index[slot] = (uint32_t) position + 1;
 }
 
+/*
+ * (Re)builds the index with at least twice as many slots as the capacity, so it stays at most half full.
+ */
 static void
-_ccnxTlvDictionaryListEntry_Release(_CCNxTlvDictionaryListEntry **entryPtr)
+_ccnxTlvDictionaryList_BuildIndex(_CCNxTlvDictionaryList *list)
+{
+    if (list->index) {
+        parcMemory_Deallocate((void **) &list->index);
+    }
+
+    size_t slots = 1;
+    while (slots < 2 * list->capacity) {
+        slots <<= 1;
+    }
+
+    list->index = parcMemory_AllocateAndClear(slots * sizeof(uint32_t));
+    assertNotNull(list->index, "parcMemory_AllocateAndClear(%zu) returned NULL", slots * sizeof(uint32_t));
+    list->indexMask = slots - 1;
+
+    for (size_t i = 0; i < list->count; i++) {
+        _ccnxTlvDictionaryList_IndexInsert(list, i);
+    }
+}
+
+static _CCNxTlvDictionaryList *
+_ccnxTlvDictionaryList_Create(size_t capacity)
 {
-    _CCNxTlvDictionaryListEntry *entry = *entryPtr;
-    parcBuffer_Release(&entry->buffer);
-    parcMemory_Deallocate((void **) &entry);
-    *entryPtr = NULL;
+    size_t bytes = sizeof(_CCNxTlvDictionaryList) + capacity * sizeof(_CCNxTlvDictionaryListEntry);
+    _CCNxTlvDictionaryList *list = parcMemory_AllocateAndClear(bytes);
+    assertNotNull(list, "parcMemory_AllocateAndClear(%zu) returned NULL", bytes);
+    list->refcount = 1;
+    list->capacity = capacity;
+    return list;
+}
+
+static _CCNxTlvDictionaryList *
+_ccnxTlvDictionaryList_Acquire(_CCNxTlvDictionaryList *list)
+{
+    __sync_add_and_fetch(&list->refcount, 1);
+    return list;
 }
 
 static void
-_ccnxTlvDictionaryEntry_ListRelease(_CCNxTlvDictionaryListEntry **listHeadPtr)
+_ccnxTlvDictionaryList_Release(_CCNxTlvDictionaryList **listPtr)
 {
-    _CCNxTlvDictionaryListEntry *listHead = *listHeadPtr;
-    while (listHead) {
-        _CCNxTlvDictionaryListEntry *next = listHead->next;
-        _ccnxTlvDictionaryListEntry_Release(&listHead);
-        listHead = next;
+    _CCNxTlvDictionaryList *list = *listPtr;
+    if (__sync_sub_and_fetch(&list->refcount, 1) == 0) {
+        for (size_t i = 0; i < list->count; i++) {
+            parcBuffer_Release(&list->entries[i].buffer);
+        }
+        if (list->index) {
+            parcMemory_Deallocate((void **) &list->index);
+        }
+        parcMemory_Deallocate((void **) &list);
+    }
+    *listPtr = NULL;
+}
+
+/*
+ * A private copy of a shared list with room for at least one more entry
+ */
+static _CCNxTlvDictionaryList *
+_ccnxTlvDictionaryList_Copy(const _CCNxTlvDictionaryList *original)
+{
+    size_t capacity = (original->count < original->capacity) ? original->capacity : 2 * original->capacity;
+    _CCNxTlvDictionaryList *list = _ccnxTlvDictionaryList_Create(capacity);
+    for (size_t i = 0; i < original->count; i++) {
+        list->entries[i].key = original->entries[i].key;
+        list->entries[i].buffer = parcBuffer_Acquire(original->entries[i].buffer);
+    }
+    list->count = original->count;
+
+    if (original->index) {
+        _ccnxTlvDictionaryList_BuildIndex(list);
+    }
+    return list;
+}
+
+/*
+ * Appends to the list and returns it, which may have moved.  The list must not be shared.
+ */
+static _CCNxTlvDictionaryList *
+_ccnxTlvDictionaryList_Append(_CCNxTlvDictionaryList *list, uint16_t key, const PARCBuffer *buffer)
+{
+    if (list->count == list->capacity) {
+        list->capacity *= 2;
+        size_t bytes = sizeof(_CCNxTlvDictionaryList) + list->capacity * sizeof(_CCNxTlvDictionaryListEntry);
+        list = parcMemory_Reallocate(list, bytes);
+        assertNotNull(list, "parcMemory_Reallocate(%zu) returned NULL", bytes);
+        if (list->index) {
+            _ccnxTlvDictionaryList_BuildIndex(list);
+        }
+    }
+
+    size_t position = list->count++;
+    list->entries[position].key = key;
+    list->entries[position].buffer = parcBuffer_Acquire(buffer);
+
+    if (list->index) {
+        _ccnxTlvDictionaryList_IndexInsert(list, position);
+    } else if (list->count >= LIST_INDEX_THRESHOLD) {
+        _ccnxTlvDictionaryList_BuildIndex(list);
+    }
+    return list;
+}
+
+static PARCBuffer *
+_ccnxTlvDictionaryList_GetByType(const _CCNxTlvDictionaryList *list, uint16_t key)
+{
+    if (list->index) {
+        size_t slot = _ccnxTlvDictionaryList_Hash(key, list->indexMask);
+        while (list->index[slot] != 0) {
+            const _CCNxTlvDictionaryListEntry *entry = &list->entries[list->index[slot] - 1];
+            if (entry->key == key) {
+                return entry->buffer;
+            }
+            slot = (slot + 1) & list->indexMask;
+        }
+        return NULL;
+    }
+
+    for (size_t i = 0; i < list->count; i++) {
+        if (list->entries[i].key == key) {
+            return list->entries[i].buffer;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Runs the lazy decoder, if there is one and we are not already inside it.  Filling in the
+ * dictionary on first use does not change its logical value, so the const is cast away here.
+ * Nothing here is locked: a lazily decoded dictionary is only read by one thread until
+ * ccnxTlvDictionary_LazyDecodeAll() has run (see ccnxTlvDictionary_SetLazyDecoder()).
+ */
+static bool
+_ccnxTlvDictionary_LazyDecode(const CCNxTlvDictionary *dictionary, CCNxTlvDictionaryLazyRequest request, uint32_t key)
+{
+    bool success = true;
+    if (dictionary->lazyDecoder != NULL && !dictionary->lazyDecoding) {
+        CCNxTlvDictionary *mutableDictionary = (CCNxTlvDictionary *) dictionary;
+        mutableDictionary->lazyDecoding = true;
+        success = mutableDictionary->lazyDecoder(mutableDictionary, mutableDictionary->lazyState, request, key);
+        mutableDictionary->lazyDecoding = false;
+    }
+    return success;
+}
+
+static inline void
+_ccnxTlvDictionary_EnsureField(const CCNxTlvDictionary *dictionary, uint32_t key)
+{
+    if (dictionary->lazyDecoder != NULL && dictionary->directArray[key].entryType == ENTRY_UNSET) {
+        _ccnxTlvDictionary_LazyDecode(dictionary, CCNxTlvDictionaryLazyRequest_Field, key);
+    }
+}
+
+static inline void
+_ccnxTlvDictionary_EnsureList(const CCNxTlvDictionary *dictionary, uint32_t listKey)
+{
+    if (dictionary->lazyDecoder != NULL) {
+        _ccnxTlvDictionary_LazyDecode(dictionary, CCNxTlvDictionaryLazyRequest_List, listKey);
     }
-    *listHeadPtr = NULL;
 }
 
 static void
@@ -212,6 +405,10 @@ _ccnxTlvDictionary_FinalRelease(CCNxTlvDictionary **dictionaryPtr)
 
     // release any entries stored in the fast array
     for (int i = 0; i < dictionary->fastArraySize; i++) {
+        if (dictionary->directArray[i].borrowed) {
+            continue;
+        }
+
         switch (dictionary->directArray[i].entryType) {
             case ENTRY_BUFFER:
                 parcBuffer_Release(&dictionary->directArray[i]._entry.buffer);
@@ -235,24 +432,36 @@ _ccnxTlvDictionary_FinalRelease(CCNxTlvDictionary **dictionaryPtr)
     }
 
     for (int i = 0; i < FIXED_LIST_LENGTH; i++) {
-        if (dictionary->fixedListHeads[i]) {
-            _ccnxTlvDictionaryEntry_ListRelease(&dictionary->fixedListHeads[i]);
+        if (dictionary->fixedLists[i]) {
+            _ccnxTlvDictionaryList_Release(&dictionary->fixedLists[i]);
         }
     }
 
-    if (dictionary->extraListHeads) {
+    if (dictionary->extraLists) {
         for (int i = FIXED_LIST_LENGTH; i < dictionary->listSize; i++) {
-            if (dictionary->extraListHeads[i - FIXED_LIST_LENGTH]) {
-                _ccnxTlvDictionaryEntry_ListRelease(&dictionary->extraListHeads[i - FIXED_LIST_LENGTH]);
+            if (dictionary->extraLists[i - FIXED_LIST_LENGTH]) {
+                _ccnxTlvDictionaryList_Release(&dictionary->extraLists[i - FIXED_LIST_LENGTH]);
             }
         }
-        parcMemory_Deallocate((void **) &(dictionary->extraListHeads));
+        parcMemory_Deallocate((void **) &(dictionary->extraLists));
     }
 
     if (dictionary->infoFreeFunction) {
         dictionary->infoFreeFunction(&dictionary->info);
     }
 
+    if (dictionary->lazyStateFreeFunction) {
+        dictionary->lazyStateFreeFunction(&dictionary->lazyState);
+    }
+
+    if (dictionary->arena) {
+        ccnxCodecArena_Release(&dictionary->arena);
+    }
+
+    if (dictionary->source) {
+        ccnxTlvDictionary_Release(&dictionary->source);
+    }
+
 #if DEBUG_ALLOCS
     printf("finalize dictionary %p (final)\n", dictionary);
 #endif
@@ -292,7 +501,7 @@ ccnxTlvDictionary_Create(size_t bufferCount, size_t listCount)
         dictionary->infoFreeFunction = NULL;
         dictionary->info = NULL;
 
-        dictionary->extraListHeads = NULL;
+        dictionary->extraLists = NULL;
         // dictionary->directArray is allocated as part of parcObject
     }
 
@@ -306,6 +515,9 @@ ccnxTlvDictionary_Create(size_t bufferCount, size_t listCount)
 CCNxTlvDictionary *
 ccnxTlvDictionary_ShallowCopy(const CCNxTlvDictionary *source)
 {
+    // The copy borrows the source's values, so they must all be there first
+    _ccnxTlvDictionary_LazyDecode(source, CCNxTlvDictionaryLazyRequest_All, 0);
+
     size_t bufferCount = source->fastArraySize;
     size_t listCount = source->listSize;
     CCNxTlvDictionary  *newDictionary = ccnxTlvDictionary_Create(bufferCount, listCount);
@@ -316,45 +528,42 @@ ccnxTlvDictionary_ShallowCopy(const CCNxTlvDictionary *source)
         newDictionary->generation = source->generation;
         newDictionary->creationTime = source->creationTime;
         newDictionary->messageInterface = source->messageInterface;
+
+        // The source frees its info, so the copy must not
         newDictionary->info = source->info;
-        newDictionary->infoFreeFunction = source->infoFreeFunction;
-
-        // Update listHeads
-        for (uint32_t key = 0; key < source->listSize; ++key) {
-            size_t listSize = ccnxTlvDictionary_ListSize(source, key);
-            for (size_t i = 0; i < listSize; ++i) {
-                PARCBuffer *buffer;
-                uint32_t bKey;
-                ccnxTlvDictionary_ListGetByPosition(source, key, i, &buffer, &bKey);
-                parcBuffer_Acquire(buffer);
-                ccnxTlvDictionary_PutListBuffer(newDictionary, key, bKey, buffer);
-                parcBuffer_Release(&buffer);
+        newDictionary->infoFreeFunction = NULL;
+
+        // Copy-on-write: the copy keeps the source alive and borrows its values instead of acquiring
+        // each one.  Puts into the copy only touch the copy, and the values are immutable once put
+        // (except integers, which are stored by value), so neither side sees the other's changes.
+        newDictionary->source = ccnxTlvDictionary_Acquire(source);
+
+        memcpy(newDictionary->directArray, source->directArray, sizeof(_CCNxTlvDictionaryEntry) * bufferCount);
+        for (size_t key = 0; key < bufferCount; ++key) {
+            newDictionary->directArray[key].borrowed = (newDictionary->directArray[key].entryType != ENTRY_UNSET);
+
+            // A PARCObject may be a container its owner updates in place (the manifest's hash group list),
+            // so the copy holds a reference.  The owner sees the count above one and copies it before changing it.
+            if (newDictionary->directArray[key].entryType == ENTRY_OBJECT) {
+                parcObject_Acquire(newDictionary->directArray[key]._entry.object);
+                newDictionary->directArray[key].borrowed = false;
             }
         }
 
-        // Update directArray
-        for (uint32_t key = 0; key < source->fastArraySize; ++key) {
-            switch (source->directArray[key].entryType) {
-                case ENTRY_BUFFER:
-                    ccnxTlvDictionary_PutBuffer(newDictionary, key, ccnxTlvDictionary_GetBuffer(source, key));
-                    break;
-                case ENTRY_NAME:
-                    ccnxTlvDictionary_PutName(newDictionary, key, ccnxTlvDictionary_GetName(source, key));
-                    break;
-                case ENTRY_IOVEC:
-                    ccnxTlvDictionary_PutIoVec(newDictionary, key, ccnxTlvDictionary_GetIoVec(source, key));
-                    break;
-                case ENTRY_JSON:
-                    ccnxTlvDictionary_PutJson(newDictionary, key, ccnxTlvDictionary_GetJson(source, key));
-                    break;
-                case ENTRY_INTEGER:
-                    ccnxTlvDictionary_PutInteger(newDictionary, key, ccnxTlvDictionary_GetInteger(source, key));
-                    break;
-                case ENTRY_OBJECT:
-                    ccnxTlvDictionary_PutObject(newDictionary, key, ccnxTlvDictionary_GetObject(source, key));
-                    break;
-                default:
-                    break;
+        // The lists are shared until one side appends to them
+        for (int i = 0; i < FIXED_LIST_LENGTH; i++) {
+            if (source->fixedLists[i]) {
+                newDictionary->fixedLists[i] = _ccnxTlvDictionaryList_Acquire(source->fixedLists[i]);
+            }
+        }
+        if (source->extraLists) {
+            size_t extraSize = sizeof(_CCNxTlvDictionaryList *) * (listCount - FIXED_LIST_LENGTH);
+            newDictionary->extraLists = parcMemory_AllocateAndClear(extraSize);
+            assertNotNull(newDictionary->extraLists, "parcMemory_AllocateAndClear(%zu) returned NULL", extraSize);
+            for (size_t i = 0; i < listCount - FIXED_LIST_LENGTH; i++) {
+                if (source->extraLists[i]) {
+                    newDictionary->extraLists[i] = _ccnxTlvDictionaryList_Acquire(source->extraLists[i]);
+                }
             }
         }
     }
@@ -368,6 +577,7 @@ ccnxTlvDictionary_PutBuffer(CCNxTlvDictionary *dictionary, uint32_t key, const P
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertNotNull(buffer, "Parameter buffer must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
+    _ccnxTlvDictionary_EnsureField(dictionary, key);
 
     if (dictionary->directArray[key].entryType == ENTRY_UNSET) {
         dictionary->directArray[key].entryType = ENTRY_BUFFER;
@@ -383,6 +593,7 @@ ccnxTlvDictionary_PutObject(CCNxTlvDictionary *dictionary, uint32_t key, const P
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertNotNull(object, "Parameter object must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key %ud must be less than %zu", key, dictionary->fastArraySize);
+    _ccnxTlvDictionary_EnsureField(dictionary, key);
 
     if (dictionary->directArray[key].entryType == ENTRY_UNSET) {
         dictionary->directArray[key].entryType = ENTRY_OBJECT;
@@ -392,12 +603,34 @@ ccnxTlvDictionary_PutObject(CCNxTlvDictionary *dictionary, uint32_t key, const P
     return false;
 }
 
+bool
+ccnxTlvDictionary_ReplaceObject(CCNxTlvDictionary *dictionary, uint32_t key, const PARCObject *object)
+{
+    assertNotNull(dictionary, "Parameter dictionary must be non-null");
+    assertNotNull(object, "Parameter object must be non-null");
+    assertTrue(key < dictionary->fastArraySize, "Parameter key %ud must be less than %zu", key, dictionary->fastArraySize);
+    _ccnxTlvDictionary_EnsureField(dictionary, key);
+
+    if (dictionary->directArray[key].entryType == ENTRY_OBJECT) {
+        PARCObject *previous = dictionary->directArray[key]._entry.object;
+        dictionary->directArray[key]._entry.object = parcObject_Acquire(object);
+        if (!dictionary->directArray[key].borrowed) {
+            parcObject_Release(&previous);
+        }
+        dictionary->directArray[key].borrowed = false;
+        return true;
+    }
+
+    return ccnxTlvDictionary_PutObject(dictionary, key, object);
+}
+
 bool
 ccnxTlvDictionary_PutName(CCNxTlvDictionary *dictionary, uint32_t key, const CCNxName *name)
 {
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertNotNull(name, "Parameter buffer must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
+    _ccnxTlvDictionary_EnsureField(dictionary, key);
 
     if (dictionary->directArray[key].entryType == ENTRY_UNSET) {
         dictionary->directArray[key].entryType = ENTRY_NAME;
@@ -412,9 +645,11 @@ ccnxTlvDictionary_PutInteger(CCNxTlvDictionary *dictionary, uint32_t key, const
 {
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
+    _ccnxTlvDictionary_EnsureField(dictionary, key);
 
     if (dictionary->directArray[key].entryType == ENTRY_UNSET || dictionary->directArray[key].entryType == ENTRY_INTEGER) {
         dictionary->directArray[key].entryType = ENTRY_INTEGER;
+        dictionary->directArray[key].borrowed = false;
         dictionary->directArray[key]._entry.integer = value;
         return true;
     }
@@ -427,6 +662,7 @@ ccnxTlvDictionary_PutIoVec(CCNxTlvDictionary *dictionary, uint32_t key, const CC
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertNotNull(vec, "Parameter buffer must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
+    _ccnxTlvDictionary_EnsureField(dictionary, key);
 
     if (dictionary->directArray[key].entryType == ENTRY_UNSET) {
         dictionary->directArray[key].entryType = ENTRY_IOVEC;
@@ -442,6 +678,7 @@ ccnxTlvDictionary_PutJson(CCNxTlvDictionary *dictionary, uint32_t key, const PAR
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertNotNull(json, "Parameter json must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
+    _ccnxTlvDictionary_EnsureField(dictionary, key);
 
     if (dictionary->directArray[key].entryType == ENTRY_UNSET) {
         dictionary->directArray[key].entryType = ENTRY_JSON;
@@ -456,6 +693,7 @@ ccnxTlvDictionary_GetIoVec(const CCNxTlvDictionary *dictionary, uint32_t key)
 {
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
+    _ccnxTlvDictionary_EnsureField(dictionary, key);
 
     if (dictionary->directArray[key].entryType == ENTRY_IOVEC) {
         return dictionary->directArray[key]._entry.vec;
@@ -463,27 +701,32 @@ ccnxTlvDictionary_GetIoVec(const CCNxTlvDictionary *dictionary, uint32_t key)
     return NULL;
 }
 
-// If you need to change the list head, use this
-static _CCNxTlvDictionaryListEntry **
-_getListHeadReference(CCNxTlvDictionary *dictionary, uint32_t listKey)
+// If you need to change the list, use this
+static _CCNxTlvDictionaryList **
+_getListReference(CCNxTlvDictionary *dictionary, uint32_t listKey)
 {
     if (listKey < FIXED_LIST_LENGTH) {
-        return &dictionary->fixedListHeads[listKey];
+        return &dictionary->fixedLists[listKey];
     } else {
-        if (dictionary->extraListHeads == NULL) {
-            dictionary->extraListHeads = parcMemory_AllocateAndClear(sizeof(_CCNxTlvDictionaryListEntry *) * (dictionary->listSize - FIXED_LIST_LENGTH));
+        if (dictionary->extraLists == NULL) {
+            dictionary->extraLists = parcMemory_AllocateAndClear(sizeof(_CCNxTlvDictionaryList *) * (dictionary->listSize - FIXED_LIST_LENGTH));
         }
 
-        return &dictionary->extraListHeads[listKey - FIXED_LIST_LENGTH];
+        return &dictionary->extraLists[listKey - FIXED_LIST_LENGTH];
     }
 }
 
-// If not going to modify the list, use this
-static _CCNxTlvDictionaryListEntry *
-_getListHead(const CCNxTlvDictionary *dictionary, uint32_t listKey)
+// If not going to modify the list, use this.  Returns NULL for an empty list.
+static _CCNxTlvDictionaryList *
+_getList(const CCNxTlvDictionary *dictionary, uint32_t listKey)
 {
-    _CCNxTlvDictionaryListEntry **head = _getListHeadReference((CCNxTlvDictionary *) dictionary, listKey);
-    return *head;
+    if (listKey < FIXED_LIST_LENGTH) {
+        return dictionary->fixedLists[listKey];
+    }
+    if (dictionary->extraLists == NULL) {
+        return NULL;
+    }
+    return dictionary->extraLists[listKey - FIXED_LIST_LENGTH];
 }
 
 bool
@@ -492,18 +735,19 @@ ccnxTlvDictionary_PutListBuffer(CCNxTlvDictionary *dictionary, uint32_t listKey,
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertNotNull(buffer, "Parameter buffer must be non-null");
     assertTrue(listKey < dictionary->listSize, "Parameter key must be less than %zu", dictionary->listSize);
-
-    _CCNxTlvDictionaryListEntry *entry = _ccnxTlvDictionaryListEntry_Create(key, buffer);
-
-    _CCNxTlvDictionaryListEntry **head = _getListHeadReference(dictionary, listKey);
-    if (*head) {
-        // insert new value at list head
-        entry->next = *head;
-        *head = entry;
-    } else {
-        // new value is the list head
-        *head = entry;
+    _ccnxTlvDictionary_EnsureList(dictionary, listKey);
+
+    _CCNxTlvDictionaryList **listPtr = _getListReference(dictionary, listKey);
+    if (*listPtr == NULL) {
+        *listPtr = _ccnxTlvDictionaryList_Create(LIST_INITIAL_CAPACITY);
+    } else if ((*listPtr)->refcount > 1) {
+        // shared with a ShallowCopy, so take a private copy before changing it
+        _CCNxTlvDictionaryList *copy = _ccnxTlvDictionaryList_Copy(*listPtr);
+        _ccnxTlvDictionaryList_Release(listPtr);
+        *listPtr = copy;
     }
+
+    *listPtr = _ccnxTlvDictionaryList_Append(*listPtr, key, buffer);
     return true;
 }
 
@@ -512,6 +756,7 @@ ccnxTlvDictionary_IsValueBuffer(const CCNxTlvDictionary *dictionary, uint32_t ke
 {
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
+    _ccnxTlvDictionary_EnsureField(dictionary, key);
     return (dictionary->directArray[key].entryType == ENTRY_BUFFER);
 }
 
@@ -520,6 +765,7 @@ ccnxTlvDictionary_IsValueObject(const CCNxTlvDictionary *dictionary, uint32_t ke
 {
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
+    _ccnxTlvDictionary_EnsureField(dictionary, key);
     return (dictionary->directArray[key].entryType == ENTRY_OBJECT);
 }
 
@@ -528,6 +774,7 @@ ccnxTlvDictionary_IsValueInteger(const CCNxTlvDictionary *dictionary, uint32_t k
 {
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
+    _ccnxTlvDictionary_EnsureField(dictionary, key);
     return (dictionary->directArray[key].entryType == ENTRY_INTEGER);
 }
 
@@ -536,6 +783,7 @@ ccnxTlvDictionary_IsValueName(const CCNxTlvDictionary *dictionary, uint32_t key)
 {
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
+    _ccnxTlvDictionary_EnsureField(dictionary, key);
     return (dictionary->directArray[key].entryType == ENTRY_NAME);
 }
 
@@ -544,6 +792,7 @@ ccnxTlvDictionary_IsValueIoVec(const CCNxTlvDictionary *dictionary, uint32_t key
 {
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
+    _ccnxTlvDictionary_EnsureField(dictionary, key);
     return (dictionary->directArray[key].entryType == ENTRY_IOVEC);
 }
 
@@ -552,6 +801,7 @@ ccnxTlvDictionary_IsValueJson(const CCNxTlvDictionary *dictionary, uint32_t key)
 {
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
+    _ccnxTlvDictionary_EnsureField(dictionary, key);
     return (dictionary->directArray[key].entryType == ENTRY_JSON);
 }
 
@@ -560,6 +810,7 @@ ccnxTlvDictionary_GetBuffer(const CCNxTlvDictionary *dictionary, uint32_t key)
 {
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
+    _ccnxTlvDictionary_EnsureField(dictionary, key);
 
     // For now return NULL for backward compatability with prior code, case 1011
     if (dictionary->directArray[key].entryType == ENTRY_BUFFER) {
@@ -573,6 +824,7 @@ ccnxTlvDictionary_GetName(const CCNxTlvDictionary *dictionary, uint32_t key)
 {
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
+    _ccnxTlvDictionary_EnsureField(dictionary, key);
 
     if (dictionary->directArray[key].entryType == ENTRY_NAME) {
         return dictionary->directArray[key]._entry.name;
@@ -585,6 +837,7 @@ ccnxTlvDictionary_GetInteger(const CCNxTlvDictionary *dictionary, uint32_t key)
 {
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
+    _ccnxTlvDictionary_EnsureField(dictionary, key);
 
     trapIllegalValueIf(dictionary->directArray[key].entryType != ENTRY_INTEGER,
                        "Key %u is of type %d",
@@ -602,6 +855,7 @@ ccnxTlvDictionary_GetJson(const CCNxTlvDictionary *dictionary, uint32_t key)
 {
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
+    _ccnxTlvDictionary_EnsureField(dictionary, key);
 
     if (dictionary->directArray[key].entryType == ENTRY_JSON) {
         return dictionary->directArray[key]._entry.json;
@@ -614,6 +868,7 @@ ccnxTlvDictionary_GetObject(const CCNxTlvDictionary *dictionary, uint32_t key)
 {
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertTrue(key < dictionary->fastArraySize, "Parameter key must be less than %zu", dictionary->fastArraySize);
+    _ccnxTlvDictionary_EnsureField(dictionary, key);
 
     if (dictionary->directArray[key].entryType == ENTRY_OBJECT) {
         return dictionary->directArray[key]._entry.object;
@@ -629,16 +884,13 @@ ccnxTlvDictionary_ListGetByPosition(const CCNxTlvDictionary *dictionary, uint32_
     assertNotNull(bufferPtr, "Parameter bufferPtr must be non-null");
     assertNotNull(keyPtr, "Parameter keyPtr must be non-null");
     assertTrue(listKey < dictionary->listSize, "Parameter key must be less than %zu", dictionary->listSize);
+    _ccnxTlvDictionary_EnsureList(dictionary, listKey);
 
-    _CCNxTlvDictionaryListEntry *entry = _getListHead(dictionary, listKey);
-    while (entry) {
-        if (listPosition == 0) {
-            *bufferPtr = entry->buffer;
-            *keyPtr = entry->key;
-            return true;
-        }
-        entry = entry->next;
-        --listPosition;
+    const _CCNxTlvDictionaryList *list = _getList(dictionary, listKey);
+    if (list && listPosition < list->count) {
+        *bufferPtr = list->entries[listPosition].buffer;
+        *keyPtr = list->entries[listPosition].key;
+        return true;
     }
 
     return false;
@@ -650,18 +902,13 @@ ccnxTlvDictionary_ListGetByType(const CCNxTlvDictionary *dictionary, uint32_t li
 {
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertTrue(listKey < dictionary->listSize, "Parameter key must be less than %zu", dictionary->listSize);
+    _ccnxTlvDictionary_EnsureList(dictionary, listKey);
 
-    PARCBuffer *buffer = NULL;
-    _CCNxTlvDictionaryListEntry *entry = _getListHead(dictionary, listKey);
-    while (entry) {
-        if (entry->key == type) {
-            buffer = entry->buffer;
-            break;
-        }
-        entry = entry->next;
+    const _CCNxTlvDictionaryList *list = _getList(dictionary, listKey);
+    if (list == NULL || type > UINT16_MAX) {
+        return NULL;
     }
-
-    return buffer;
+    return _ccnxTlvDictionaryList_GetByType(list, (uint16_t) type);
 }
 
 
@@ -670,15 +917,10 @@ ccnxTlvDictionary_ListSize(const CCNxTlvDictionary *dictionary, uint32_t listKey
 {
     assertNotNull(dictionary, "Parameter dictionary must be non-null");
     assertTrue(listKey < dictionary->listSize, "Parameter key must be less than %zu", dictionary->listSize);
+    _ccnxTlvDictionary_EnsureList(dictionary, listKey);
 
-    size_t size = 0;
-    _CCNxTlvDictionaryListEntry *entry = _getListHead(dictionary, listKey);
-    while (entry) {
-        size++;
-        entry = entry->next;
-    }
-
-    return size;
+    const _CCNxTlvDictionaryList *list = _getList(dictionary, listKey);
+    return (list == NULL) ? 0 : list->count;
 }
 
 void
@@ -764,6 +1006,48 @@ ccnxTlvDictionary_GetMessageInterface(const CCNxTlvDictionary *dictionary)
     return dictionary->messageInterface;
 }
 
+void
+ccnxTlvDictionary_SetArena(CCNxTlvDictionary *dictionary, CCNxCodecArena *arena)
+{
+    assertNotNull(dictionary, "Parameter dictionary must be non-null");
+    if (arena) {
+        ccnxCodecArena_Acquire(arena);
+    }
+    if (dictionary->arena) {
+        ccnxCodecArena_Release(&dictionary->arena);
+    }
+    dictionary->arena = arena;
+}
+
+CCNxCodecArena *
+ccnxTlvDictionary_GetArena(const CCNxTlvDictionary *dictionary)
+{
+    assertNotNull(dictionary, "Parameter dictionary must be non-null");
+    return dictionary->arena;
+}
+
+void
+ccnxTlvDictionary_SetLazyDecoder(CCNxTlvDictionary *dictionary, CCNxTlvDictionaryLazyDecoder *decoder,
+                                 void *state, void (*stateFreeFunction)(void **statePtr))
+{
+    assertNotNull(dictionary, "Parameter dictionary must be non-null");
+    assertFalse(dictionary->lazyDecoding, "Cannot change the lazy decoder while it is running");
+
+    if (dictionary->lazyStateFreeFunction) {
+        dictionary->lazyStateFreeFunction(&dictionary->lazyState);
+    }
+    dictionary->lazyDecoder = decoder;
+    dictionary->lazyState = state;
+    dictionary->lazyStateFreeFunction = stateFreeFunction;
+}
+
+bool
+ccnxTlvDictionary_LazyDecodeAll(const CCNxTlvDictionary *dictionary)
+{
+    assertNotNull(dictionary, "Parameter dictionary must be non-null");
+    return _ccnxTlvDictionary_LazyDecode(dictionary, CCNxTlvDictionaryLazyRequest_All, 0);
+}
+
 struct timeval
 ccnxTlvDictionary_GetLifetime(const CCNxTlvDictionary *dictionary)
 {
@@ -825,6 +1109,8 @@ _ccnxTlvDictionary_DisplayListEntry(const _CCNxTlvDictionaryListEntry *entry, in
 void
 ccnxTlvDictionary_Display(const CCNxTlvDictionary *dictionary, int indent)
 {
+    _ccnxTlvDictionary_LazyDecode(dictionary, CCNxTlvDictionaryLazyRequest_All, 0);
+
     parcDisplayIndented_PrintLine(indent, "CCNxTlvDictionary@%p fastArraySize %zu listSize %zu dictionaryType %s schemaVersion %d refcount %" PRIu64 "\n",
                                   (void *) dictionary,
                                   dictionary->fastArraySize,
@@ -869,13 +1155,11 @@ ccnxTlvDictionary_Display(const CCNxTlvDictionary *dictionary, int indent)
     }
 
     for (int i = 0; i < dictionary->listSize; i++) {
-        _CCNxTlvDictionaryListEntry *entry = _getListHead(dictionary, i);
-        if (entry) {
-            int position = 0;
-            printf("   Displaying custom entry list index %3d head %p\n", i, (void *) entry);
-            while (entry) {
-                _ccnxTlvDictionary_DisplayListEntry(entry, i, position);
-                entry = entry->next;
+        const _CCNxTlvDictionaryList *list = _getList(dictionary, i);
+        if (list && list->count > 0) {
+            printf("   Displaying custom entry list index %3d list %p count %zu refcount %u\n", i, (void *) list, list->count, list->refcount);
+            for (size_t position = 0; position < list->count; position++) {
+                _ccnxTlvDictionary_DisplayListEntry(&list->entries[position], i, (int) position);
             }
         }
     }
@@ -950,31 +1234,26 @@ _ccnxTlvDictionaryListEntry_Equals(const _CCNxTlvDictionaryListEntry *a, const _
 }
 
 static bool
-_ccnxTlvDictionary_ListEquals(const _CCNxTlvDictionaryListEntry *listHeadA, const _CCNxTlvDictionaryListEntry *listHeadB)
+_ccnxTlvDictionary_ListEquals(const _CCNxTlvDictionaryList *listA, const _CCNxTlvDictionaryList *listB)
 {
-    if (listHeadA == NULL && listHeadB == NULL) {
-        return true;
-    }
+    size_t countA = (listA == NULL) ? 0 : listA->count;
+    size_t countB = (listB == NULL) ? 0 : listB->count;
 
-    if (listHeadA == NULL || listHeadB == NULL) {
+    if (countA != countB) {
         return false;
     }
 
-    // walk both linked lists in parallel
-    while (listHeadA && listHeadB) {
-        if (!_ccnxTlvDictionaryListEntry_Equals(listHeadA, listHeadB)) {
-            return false;
-        }
-
-        listHeadA = listHeadA->next;
-        listHeadB = listHeadB->next;
+    if (listA == listB) {
+        return true;
     }
 
-    // they must both be NULL otherwise the lists did not end at same place
-    if (listHeadA == NULL && listHeadB == NULL) {
-        return true;
+    // walk both lists in parallel
+    for (size_t i = 0; i < countA; i++) {
+        if (!_ccnxTlvDictionaryListEntry_Equals(&listA->entries[i], &listB->entries[i])) {
+            return false;
+        }
     }
-    return false;
+    return true;
 }
 
 /*
@@ -998,9 +1277,7 @@ _ccnxTlvDictionary_ListsEquals(const CCNxTlvDictionary *a, const CCNxTlvDictiona
 {
     bool equals = true;
     for (int i = 0; i < a->listSize && equals; i++) {
-        _CCNxTlvDictionaryListEntry *entry_a = _getListHead(a, i);
-        _CCNxTlvDictionaryListEntry *entry_b = _getListHead(b, i);
-        equals = _ccnxTlvDictionary_ListEquals(entry_a, entry_b);
+        equals = _ccnxTlvDictionary_ListEquals(_getList(a, i), _getList(b, i));
     }
     return equals;
 }
@@ -1016,6 +1293,9 @@ ccnxTlvDictionary_Equals(const CCNxTlvDictionary *a, const CCNxTlvDictionary *b)
         return false;
     }
 
+    _ccnxTlvDictionary_LazyDecode(a, CCNxTlvDictionaryLazyRequest_All, 0);
+    _ccnxTlvDictionary_LazyDecode(b, CCNxTlvDictionaryLazyRequest_All, 0);
+
     // They are both non-null
     bool equals = false;
     if (a->fastArraySize == b->fastArraySize) {
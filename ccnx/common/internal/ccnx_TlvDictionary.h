@@ -60,6 +60,7 @@
 
 #include <ccnx/common/ccnx_Name.h>
 #include <ccnx/common/codec/ccnxCodec_NetworkBuffer.h>
+#include <ccnx/common/codec/ccnxCodec_Arena.h>
 
 
 struct ccnx_tlv_dictionary;
@@ -70,6 +71,29 @@ typedef enum {
     CCNxTlvDictionary_SchemaVersion_V1 = 1,
 } CCNxTlvDictionary_SchemaVersion;
 
+/**
+ * What a lazy decoder is asked to decode.
+ *
+ * `Field` and `List` carry the fast array key or list key that was touched.  `All` asks for everything
+ * that is still pending and ignores the key.
+ */
+typedef enum {
+    CCNxTlvDictionaryLazyRequest_Field = 0,
+    CCNxTlvDictionaryLazyRequest_List = 1,
+    CCNxTlvDictionaryLazyRequest_All = 2,
+} CCNxTlvDictionaryLazyRequest;
+
+/**
+ * Decodes the part of a packet that holds `key` into the dictionary.
+ *
+ * Called by the dictionary the first time an unset field or a list is touched.  The decoder
+ * puts its values with the normal `ccnxTlvDictionary_Put` functions.  It is not called recursively.
+ *
+ * @return true The request decoded, or there was nothing left to decode for it.
+ * @return false A section failed to decode.
+ */
+typedef bool (CCNxTlvDictionaryLazyDecoder)(CCNxTlvDictionary *dictionary, void *state, CCNxTlvDictionaryLazyRequest request, uint32_t key);
+
 
 /**
  * Creates a new TLV dictionary with the given size
@@ -466,7 +490,8 @@ CCNxCodecNetworkBufferIoVec *ccnxTlvDictionary_GetIoVec(const CCNxTlvDictionary
  * Insert a new List item into the dictionary.
  *
  * The key must be within the interval [0, bufferCount] for the dictionary.
- * You can only set a Buffer field once. The key must be UNSET.
+ * The item is appended, so a list keeps the order its items were put in (wire order
+ * for a decoded packet).  Duplicate keys are allowed.
  *
  * @param [in] dictionary The dictionary instance to be modified
  * @param [in] listKey The list key used when indexing the dictionary lists
@@ -595,6 +620,31 @@ PARCJSON *ccnxTlvDictionary_GetJson(const CCNxTlvDictionary *dictionary, uint32_
  */
 bool ccnxTlvDictionary_PutObject(CCNxTlvDictionary *dictionary, uint32_t key, const PARCObject *json);
 
+/**
+ * Associate the specified key with a `PARCObject` instance, replacing any `PARCObject` already there.
+ *
+ * The key must be within the dictionary, and the entry must be UNSET or a PARCObject.
+ * The dictionary releases its reference to the previous object.
+ *
+ * @param [in] dictionary The dictionary instance to be modified
+ * @param [in] key The key used when indexing the dictionary
+ * @param [in] object The new PARCObject value to associate with the key
+ *
+ * @return true If the put/replace was successful.
+ * @return false Otherwise (e.g., the entry holds another type)
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxTlvDictionary *dict = ccnxTlvDictionary_Create(5, 3);
+ *     ccnxTlvDictionary_PutObject(dict, 1, object);
+ *     bool success = ccnxTlvDictionary_ReplaceObject(dict, 1, newObject);
+ *     // success will be true and the dictionary now holds newObject
+ * }
+ * @endcode
+ */
+bool ccnxTlvDictionary_ReplaceObject(CCNxTlvDictionary *dictionary, uint32_t key, const PARCObject *object);
+
 /**
  * Determine if the value associated with the specified key is a `PARCObject` instance.
  *
@@ -649,7 +699,8 @@ PARCObject *ccnxTlvDictionary_GetObject(const CCNxTlvDictionary *dictionary, uin
 /**
  * Fetches a buffer from the ordinal position 'listItem' from the list key 'key'
  *
- * The entry 'key' must be type list.
+ * The entry 'key' must be type list.  Position 0 is the first item put in the list.
+ * Lists are stored as arrays, so this does not walk the list.
  *
  * @param [in] dictionary The dictionary instance being examined
  * @param [in] listKey The key used to identify the list to be searched
@@ -680,6 +731,9 @@ bool ccnxTlvDictionary_ListGetByPosition(const CCNxTlvDictionary *dictionary, ui
 /**
  * Returns the first buffer in the list identified by 'listkey' with the buffer type 'type'
  *
+ * The first buffer is the earliest one put in the list.  Long lists keep an index by type,
+ * so this does not walk them.
+ *
  * @param [in] dictionary The dictionary instance being examined
  * @param [in] listKey The key used to index into the dictionary lists
  * @param [in] type The type of element used to search within the dictionary list
@@ -1058,12 +1112,18 @@ bool ccnxTlvDictionary_Equals(const CCNxTlvDictionary *a, const CCNxTlvDictionar
 /**
  * Allocates a new instance of the specified CCNxTlvDictionary that is
  * a "Shallow" copy of the original.  The new instance contains the
- * same contents as the original CCNxTlvDictionary but an Acquire()
- * operation is used where possible to form a new link to the original
- * contained content (a Copy() operation is used otherwise). Note that
- * this means that modifying the content of the copy will, in most
- * cases, modify the content of the original. In any case, the
- * contents are protected from premature deallocation.
+ * same contents as the original CCNxTlvDictionary.
+ *
+ * The copy is copy-on-write: it holds a reference to the original and
+ * shares its values and unknown-TLV lists instead of acquiring each one,
+ * so making a copy does not depend on how much the original holds.
+ * Values put into the copy (or list entries added to it) only change the copy,
+ * and values put into the original after the copy is made are not seen by the copy.
+ * The shared objects themselves (a PARCBuffer, for example) are the same
+ * instances, so modifying their content modifies it in both dictionaries.
+ * The copy holds its own reference to each `PARCObject` value, so an owner that
+ * updates one in place can tell from its reference count that it is shared.
+ * The original is kept until the copy is released.
  *
  * @param [in] source The dictionary to copy
  *
@@ -1137,4 +1197,89 @@ void ccnxTlvDictionary_SetMessageInterface(CCNxTlvDictionary *dictionary, const
  * @see `ccnxInterestInterface_GetInterface`
  */
 CCNxMessageInterface *ccnxTlvDictionary_GetMessageInterface(const CCNxTlvDictionary *dictionary);
+
+/**
+ * Tie the lifetime of an arena to the dictionary.
+ *
+ * A packet decoded with an arena keeps its decode state there.  The dictionary holds a reference to the
+ * arena and releases it when the dictionary is destroyed, so all of the packet's decode memory is freed in one shot.
+ * Setting a new arena releases the previous one.
+ *
+ * @param [in] dictionary The dictionary instance.
+ * @param [in] arena The arena to hold, or NULL to release the current one.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecArena *arena = ccnxCodecArena_Create();
+ *     ccnxTlvDictionary_SetArena(dictionary, arena);
+ *     ccnxCodecArena_Release(&arena);
+ * }
+ * @endcode
+ * @see `ccnxCodecSchemaV1PacketDecoder_ArenaDecode`
+ */
+void ccnxTlvDictionary_SetArena(CCNxTlvDictionary *dictionary, CCNxCodecArena *arena);
+
+/**
+ * Return the arena held by the dictionary.
+ *
+ * @param [in] dictionary The dictionary instance.
+ *
+ * @return non-null The arena given to {@link ccnxTlvDictionary_SetArena}, not acquired.
+ * @return null The dictionary holds no arena.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxCodecArena *arena = ccnxTlvDictionary_GetArena(dictionary);
+ * }
+ * @endcode
+ */
+CCNxCodecArena *ccnxTlvDictionary_GetArena(const CCNxTlvDictionary *dictionary);
+
+/**
+ * Defer filling in part of the dictionary until it is used.
+ *
+ * The Get, IsValue, Put and List functions call `decoder` before they look at an unset field or at a list,
+ * so the caller sees the same values as if the dictionary had been filled in up front.  The dictionary
+ * owns `state` and calls `stateFreeFunction` on it when it is destroyed or a new decoder is set.
+ *
+ * A ShallowCopy, Equals or Display decodes everything first.  Decoding on first touch changes the
+ * dictionary inside a `const` getter, so a lazily decoded dictionary must not be read from several
+ * threads until {@link ccnxTlvDictionary_LazyDecodeAll} has been called.
+ *
+ * @param [in] dictionary The dictionary instance.
+ * @param [in] decoder The decoder to call, or NULL to remove the current one.
+ * @param [in] state Passed to every call of `decoder`.
+ * @param [in] stateFreeFunction Frees `state`, may be NULL.
+ *
+ * Example:
+ * @code
+ * {
+ *     ccnxTlvDictionary_SetLazyDecoder(dictionary, _decodeSection, state, _stateFree);
+ * }
+ * @endcode
+ * @see `ccnxCodecSchemaV1PacketDecoder_LazyDecode`
+ */
+void ccnxTlvDictionary_SetLazyDecoder(CCNxTlvDictionary *dictionary, CCNxTlvDictionaryLazyDecoder *decoder,
+                                      void *state, void (*stateFreeFunction)(void **statePtr));
+
+/**
+ * Decode everything a lazy decoder still has pending.
+ *
+ * @param [in] dictionary The dictionary instance.
+ *
+ * @return true Everything decoded, or the dictionary has no lazy decoder.
+ * @return false Some part of the packet failed to decode.
+ *
+ * Example:
+ * @code
+ * {
+ *     if (!ccnxTlvDictionary_LazyDecodeAll(dictionary)) {
+ *         // drop the packet
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxTlvDictionary_LazyDecodeAll(const CCNxTlvDictionary *dictionary);
 #endif // libccnx_ccnx_TlvDictionary_h
@@ -134,6 +134,13 @@ ccnxValidationFacadeV1_GetCryptoSuite(const CCNxTlvDictionary *message)
     trapUnexpectedState("Dictionary does not have a CryptoSuite set");
 }
 
+bool
+ccnxValidationFacadeV1_IsUnsigned(const CCNxTlvDictionary *message)
+{
+    _assertInvariants(message);
+    return ccnxTlvDictionary_IsValueInteger(message, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_UNSIGNED);
+}
+
 bool
 ccnxValidationFacadeV1_HasSigningTime(const CCNxTlvDictionary *message)
 {
@@ -235,6 +242,16 @@ ccnxValidationFacadeV1_SetSigningTime(CCNxTlvDictionary *message, uint64_t signi
     return ccnxTlvDictionary_PutInteger(message, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_SIGNTIME, signingTime);
 }
 
+bool
+ccnxValidationFacadeV1_SetUnsigned(CCNxTlvDictionary *message)
+{
+    _assertInvariants(message);
+    if (ccnxValidationFacadeV1_HasCryptoSuite(message)) {
+        return false;
+    }
+    return ccnxTlvDictionary_PutInteger(message, CCNxCodecSchemaV1TlvDictionary_ValidationFastArray_UNSIGNED, 1);
+}
+
 bool
 ccnxValidationFacadeV1_SetPayload(CCNxTlvDictionary *message, const PARCBuffer *validationPayload)
 {
@@ -251,6 +251,25 @@ bool ccnxValidationFacadeV1_HasCryptoSuite(const CCNxTlvDictionary *message);
  */
 PARCCryptoSuite ccnxValidationFacadeV1_GetCryptoSuite(const CCNxTlvDictionary *message);
 
+/**
+ * Determines if the packet is marked to be sent without a signature
+ *
+ * @param [in] message An allocated dictionary
+ *
+ * @retval true The packet was marked with ccnxValidationFacadeV1_SetUnsigned()
+ * @retval false The packet may be signed
+ *
+ * Example:
+ * @code
+ * {
+ *    if (!ccnxValidationFacadeV1_IsUnsigned(contentObject)) {
+ *      // sign it
+ *    }
+ * }
+ * @endcode
+ */
+bool ccnxValidationFacadeV1_IsUnsigned(const CCNxTlvDictionary *message);
+
 /**
  * Determines if the packet specified a signing time
  *
@@ -480,6 +499,31 @@ bool ccnxValidationFacadeV1_SetCryptoSuite(CCNxTlvDictionary *message, PARCCrypt
  */
 bool ccnxValidationFacadeV1_SetSigningTime(CCNxTlvDictionary *message, uint64_t signingTime);
 
+/**
+ * Marks the packet to be encoded without a signature
+ *
+ * Normally a Content Object is signed if the codec has a signer, even when the dictionary has no crypto suite.
+ * A Content Object that is bound by its ContentObjectHash in a signed manifest does not need its own signature,
+ * so marking it unsigned lets the codec skip the ValidationAlg and ValidationPayload, and the cost of signing.
+ *
+ * A crypto suite set in the dictionary, e.g. by ccnxValidationRsaSha256_Set(), takes precedence over this mark,
+ * so a packet cannot be marked unsigned once it has a crypto suite.
+ *
+ * @param [in] message The message to update
+ *
+ * @retval true The packet is marked unsigned
+ * @retval false The packet already has a crypto suite or was already marked
+ *
+ * Example:
+ * @code
+ * {
+ *    CCNxContentObject *chunk = ccnxContentObject_CreateWithPayload(payload);
+ *    ccnxValidationFacadeV1_SetUnsigned(chunk);
+ * }
+ * @endcode
+ */
+bool ccnxValidationFacadeV1_SetUnsigned(CCNxTlvDictionary *message);
+
 /**
  * Saves the validation payload in the dictionary
  *
@@ -65,6 +65,7 @@
 #include <LongBow/runtime.h>
 
 #include <parc/algol/parc_FileOutputStream.h>
+#include <parc/algol/parc_Memory.h>
 
 #include <ccnx/common/internal/ccnx_WireFormatMessageInterface.h>
 #include <ccnx/common/internal/ccnx_WireFormatFacadeV1.h>
@@ -74,6 +75,8 @@
 #include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_Types.h>
 #include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_FixedHeader.h>
 
+#include <ccnx/common/validation/ccnxValidation_SHA256Batch.h>
+
 
 static CCNxTlvDictionary *
 _ccnxWireFormatFacadeV1_FromInterestPacketType(const PARCBuffer *wireFormat)
@@ -441,8 +444,138 @@ _ccnxWireFormatFacadeV1_HashProtectedRegion(const CCNxTlvDictionary *dictionary,
 }
 
 
-static PARCCryptoHash  *
-_ccnxWireFormatFacadeV1_ComputeContentObjectHash(CCNxTlvDictionary *dictionary)
+/*
+ * Describes the region of `dictionary` whose extents are stored under `startKey` and `lengthKey` as a
+ * region of its iovec, or of `*bufferIoVec` which is set to span its wire format buffer.  Returns false
+ * if the extents are not set or do not lie within the packet.
+ */
+static bool
+_ccnxWireFormatFacadeV1_GetRegion(const CCNxTlvDictionary *dictionary, uint32_t startKey, uint32_t lengthKey,
+                                  struct iovec *bufferIoVec, CCNxValidationSHA256BatchRegion *region)
+{
+    if (!ccnxTlvDictionary_IsValueInteger(dictionary, startKey)
+        || !ccnxTlvDictionary_IsValueInteger(dictionary, lengthKey)) {
+        return false;
+    }
+
+    region->start = ccnxTlvDictionary_GetInteger(dictionary, startKey);
+    region->length = ccnxTlvDictionary_GetInteger(dictionary, lengthKey);
+
+    CCNxCodecNetworkBufferIoVec *vec = _ccnxWireFormatFacadeV1_GetIoVec(dictionary);
+    if (vec) {
+        if (region->start + region->length > ccnxCodecNetworkBufferIoVec_Length(vec)) {
+            return false;
+        }
+        region->iov = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+        region->iovcnt = ccnxCodecNetworkBufferIoVec_GetCount(vec);
+        return true;
+    }
+
+    PARCBuffer *wireFormat = _ccnxWireFormatFacadeV1_GetWireFormatBuffer(dictionary);
+    if (wireFormat == NULL || region->start + region->length > parcBuffer_Remaining(wireFormat)) {
+        return false;
+    }
+    bufferIoVec->iov_base = parcByteArray_Array(parcBuffer_Array(wireFormat)) + parcBuffer_ArrayOffset(wireFormat);
+    bufferIoVec->iov_len = region->start + region->length;
+    region->iov = bufferIoVec;
+    region->iovcnt = 1;
+    return true;
+}
+
+// Up to this many regions are described on the stack; a larger burst allocates its scratch arrays
+#define _ccnxWireFormatFacadeV1_HashBatchSize 32
+
+/*
+ * Hashes the region named by `startKey` and `lengthKey` of each dictionary.  Every valid region is
+ * gathered first and handed to ccnxValidationSHA256Batch_Hash in a single call, so the batch hasher
+ * can fill all of its lanes.  `hashed[i]`, if not NULL, records whether dictionary `i` had a valid region.
+ */
+static size_t
+_ccnxWireFormatFacadeV1_HashRegions(size_t count, CCNxTlvDictionary *dictionaries[count], uint32_t startKey, uint32_t lengthKey,
+                                    uint8_t digests[count][CCNxValidationSHA256Batch_DigestLength], bool hashed[count])
+{
+    CCNxValidationSHA256BatchRegion stackRegions[_ccnxWireFormatFacadeV1_HashBatchSize];
+    struct iovec stackBufferIoVecs[_ccnxWireFormatFacadeV1_HashBatchSize];
+    uint8_t stackDigests[_ccnxWireFormatFacadeV1_HashBatchSize][CCNxValidationSHA256Batch_DigestLength];
+    size_t stackIndex[_ccnxWireFormatFacadeV1_HashBatchSize];
+
+    CCNxValidationSHA256BatchRegion *regions = stackRegions;
+    struct iovec *bufferIoVecs = stackBufferIoVecs;
+    uint8_t (*batchDigests)[CCNxValidationSHA256Batch_DigestLength] = stackDigests;
+    size_t *index = stackIndex;
+
+    if (count > _ccnxWireFormatFacadeV1_HashBatchSize) {
+        regions = parcMemory_Allocate(count * sizeof(CCNxValidationSHA256BatchRegion));
+        bufferIoVecs = parcMemory_Allocate(count * sizeof(struct iovec));
+        batchDigests = parcMemory_Allocate(count * CCNxValidationSHA256Batch_DigestLength);
+        index = parcMemory_Allocate(count * sizeof(size_t));
+        assertNotNull(regions, "parcMemory_Allocate(%zu) returned NULL", count * sizeof(CCNxValidationSHA256BatchRegion));
+        assertNotNull(bufferIoVecs, "parcMemory_Allocate(%zu) returned NULL", count * sizeof(struct iovec));
+        assertNotNull(batchDigests, "parcMemory_Allocate(%zu) returned NULL", count * CCNxValidationSHA256Batch_DigestLength);
+        assertNotNull(index, "parcMemory_Allocate(%zu) returned NULL", count * sizeof(size_t));
+    }
+
+    size_t batchCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        bool valid = _ccnxWireFormatFacadeV1_GetRegion(dictionaries[i], startKey, lengthKey,
+                                                       &bufferIoVecs[batchCount], &regions[batchCount]);
+        if (valid) {
+            index[batchCount++] = i;
+        }
+        if (hashed != NULL) {
+            hashed[i] = valid;
+        }
+    }
+
+    ccnxValidationSHA256Batch_Hash(batchCount, regions, batchDigests);
+
+    for (size_t j = 0; j < batchCount; j++) {
+        memcpy(digests[index[j]], batchDigests[j], CCNxValidationSHA256Batch_DigestLength);
+    }
+
+    if (regions != stackRegions) {
+        parcMemory_Deallocate((void **) &regions);
+        parcMemory_Deallocate((void **) &bufferIoVecs);
+        parcMemory_Deallocate((void **) &batchDigests);
+        parcMemory_Deallocate((void **) &index);
+    }
+
+    return batchCount;
+}
+
+static size_t
+_ccnxWireFormatFacadeV1_HashProtectedRegions(size_t count, CCNxTlvDictionary *dictionaries[count],
+                                             uint8_t digests[count][CCNxWireFormatMessage_SHA256DigestLength],
+                                             bool hashed[count])
+{
+    return _ccnxWireFormatFacadeV1_HashRegions(count, dictionaries,
+                                               CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ProtectedStart,
+                                               CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ProtectedLength,
+                                               digests, hashed);
+}
+
+/*
+ * The ContentObject Hash region runs from the start of the message through the end of the
+ * ValidationPayload, so it is not the protected region that _HashProtectedRegions covers.
+ */
+static size_t
+_ccnxWireFormatFacadeV1_ComputeContentObjectHashDigests(size_t count, CCNxTlvDictionary *dictionaries[count],
+                                                        uint8_t digests[count][CCNxWireFormatMessage_ContentObjectHashLength],
+                                                        bool hashed[count])
+{
+    for (size_t i = 0; i < count; i++) {
+        assertTrue(ccnxTlvDictionary_IsContentObject(dictionaries[i]) || ccnxTlvDictionary_IsManifest(dictionaries[i]),
+                   "Message %zu must be a ContentObject or Manifest", i);
+    }
+
+    return _ccnxWireFormatFacadeV1_HashRegions(count, dictionaries,
+                                               CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ContentObjectHashRegionStart,
+                                               CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ContentObjectHashRegionLength,
+                                               digests, hashed);
+}
+
+static bool
+_ccnxWireFormatFacadeV1_ComputeContentObjectHashDigest(const CCNxTlvDictionary *dictionary, uint8_t digest[CCNxWireFormatMessage_ContentObjectHashLength])
 {
     // This assumes the dictionary has been passed through something like the V1 packet decoder,
     // (e.g. ccnxCodecSchemaV1PacketDecoder_Decode) and has had the protected region extents set.
@@ -450,30 +583,31 @@ _ccnxWireFormatFacadeV1_ComputeContentObjectHash(CCNxTlvDictionary *dictionary)
 
     assertTrue(ccnxTlvDictionary_IsContentObject(dictionary) || ccnxTlvDictionary_IsManifest(dictionary), "Message must be a ContentObject or Manifest");
 
+    CCNxValidationSHA256BatchRegion region;
+    struct iovec bufferIoVec;
+    if (!_ccnxWireFormatFacadeV1_GetRegion(dictionary,
+                                           CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ContentObjectHashRegionStart,
+                                           CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ContentObjectHashRegionLength,
+                                           &bufferIoVec, &region)) {
+        return false;
+    }
+
+    // A batch of one takes the batch hasher's one-at-a-time path, which reuses a per-thread
+    // digest context, so nothing is allocated here.
+    ccnxValidationSHA256Batch_Hash(1, &region, (uint8_t (*)[CCNxValidationSHA256Batch_DigestLength])digest);
+    return true;
+}
+
+static PARCCryptoHash  *
+_ccnxWireFormatFacadeV1_ComputeContentObjectHash(CCNxTlvDictionary *dictionary)
+{
     PARCCryptoHash *result = NULL;
 
-    if (ccnxTlvDictionary_IsValueInteger(dictionary, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ContentObjectHashRegionStart)
-        && ccnxTlvDictionary_IsValueInteger(dictionary, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ContentObjectHashRegionLength)) {
-        PARCCryptoHasher *hasher = parcCryptoHasher_Create(PARCCryptoHashType_SHA256);
-        size_t startPosition = ccnxTlvDictionary_GetInteger(dictionary, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ContentObjectHashRegionStart);
-        size_t length = ccnxTlvDictionary_GetInteger(dictionary, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ContentObjectHashRegionLength);
-
-        CCNxCodecNetworkBufferIoVec *vec = _ccnxWireFormatFacadeV1_GetIoVec(dictionary);
-        if (vec) {
-            size_t totalLength = ccnxCodecNetworkBufferIoVec_Length(vec);
-            if (startPosition + length <= totalLength) {
-                result = _hashProtectedRegionIoVec(vec, hasher, startPosition, length);
-            }
-        } else {
-            PARCBuffer *wireFormat = _ccnxWireFormatFacadeV1_GetWireFormatBuffer(dictionary);
-            if (wireFormat) {
-                size_t totalLength = parcBuffer_Remaining(wireFormat);
-                if (startPosition + length <= totalLength) {
-                    result = _ccnxWireFormatFacadeV1_ComputeBufferHash(wireFormat, hasher, startPosition, length);
-                }
-            }
-        }
-        parcCryptoHasher_Release(&hasher);
+    uint8_t digest[CCNxWireFormatMessage_ContentObjectHashLength];
+    if (_ccnxWireFormatFacadeV1_ComputeContentObjectHashDigest(dictionary, digest)) {
+        PARCBuffer *buffer = parcBuffer_Flip(parcBuffer_PutArray(parcBuffer_Allocate(sizeof(digest)), sizeof(digest), digest));
+        result = parcCryptoHash_Create(PARCCryptoHashType_SHA256, buffer);
+        parcBuffer_Release(&buffer);
     }
 
     return result; // Could be NULL
@@ -513,12 +647,18 @@ CCNxWireFormatMessageInterface CCNxWireFormatFacadeV1_Implementation = {
 
     .hashProtectedRegion              = &_ccnxWireFormatFacadeV1_HashProtectedRegion,
 
+    .hashProtectedRegions             = &_ccnxWireFormatFacadeV1_HashProtectedRegions,
+
     .setContentObjectHashRegionStart  = &_ccnxWireFormatFacadeV1_SetContentObjectHashRegionStart,
 
     .setContentObjectHashRegionLength = &_ccnxWireFormatFacadeV1_SetContentObjectHashRegionLength,
 
     .computeContentObjectHash         = &_ccnxWireFormatFacadeV1_ComputeContentObjectHash,
 
+    .computeContentObjectHashDigest   = &_ccnxWireFormatFacadeV1_ComputeContentObjectHashDigest,
+
+    .computeContentObjectHashDigests  = &_ccnxWireFormatFacadeV1_ComputeContentObjectHashDigests,
+
     .setHopLimit                      = &_ccnxWireFormatFacadeV1_SetHopLimit,
 
     .convertInterestToInterestReturn  = &_ccnxWireFormatFacadeV1_ConvertInterestToInterestReturn,
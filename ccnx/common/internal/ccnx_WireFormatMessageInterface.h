@@ -64,6 +64,16 @@
 
 #include <ccnx/common/internal/ccnx_TlvDictionary.h>
 
+/**
+ * The length, in bytes, of a SHA256 digest.
+ */
+#define CCNxWireFormatMessage_SHA256DigestLength 32
+
+/**
+ * The length, in bytes, of a ContentObject Hash.
+ */
+#define CCNxWireFormatMessage_ContentObjectHashLength CCNxWireFormatMessage_SHA256DigestLength
+
 typedef struct ccnx_wireformatmessage_interface {
     char              *description;      // A human-readable label for this implementation
 
@@ -112,6 +122,10 @@ typedef struct ccnx_wireformatmessage_interface {
     /** @see ccnxWireFormatMessage_HashProtectedRegion */
     PARCCryptoHash    *(*hashProtectedRegion)(const CCNxTlvDictionary * dictionary, PARCCryptoHasher * hasher);
 
+    /** @see ccnxWireFormatMessage_HashProtectedRegions */
+    size_t (*hashProtectedRegions)(size_t count, CCNxTlvDictionary *dictionaries[count],
+                                   uint8_t digests[count][CCNxWireFormatMessage_SHA256DigestLength], bool hashed[count]);
+
     /** @see ccnxWireFormatMessage_SetHopLimit */
     bool (*setHopLimit)(CCNxTlvDictionary *dictionary, uint32_t hopLimit);
 
@@ -121,6 +135,13 @@ typedef struct ccnx_wireformatmessage_interface {
     /** @see ccnxWireFormatMessage_CreateContentObjectHash */
     PARCCryptoHash    *(*computeContentObjectHash)(CCNxTlvDictionary * dictionary);
 
+    /** @see ccnxWireFormatMessage_ComputeContentObjectHashDigest */
+    bool (*computeContentObjectHashDigest)(const CCNxTlvDictionary *dictionary, uint8_t digest[CCNxWireFormatMessage_ContentObjectHashLength]);
+
+    /** @see ccnxWireFormatMessage_ComputeContentObjectHashDigests */
+    size_t (*computeContentObjectHashDigests)(size_t count, CCNxTlvDictionary *dictionaries[count],
+                                              uint8_t digests[count][CCNxWireFormatMessage_ContentObjectHashLength], bool hashed[count]);
+
     /** @see ccnxWireFormatMessage_ConvertInterestToInterestReturn */
     bool (*convertInterestToInterestReturn)(CCNxTlvDictionary *dictionary, uint8_t returnCode);
 } CCNxWireFormatMessageInterface;
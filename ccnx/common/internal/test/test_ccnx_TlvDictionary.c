@@ -176,10 +176,17 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_SetMessageType_Control);
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_SetMessageType_InterestReturn);
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_SetGetMessageTypeImplementation);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_SetArena);
 
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_Equals);
     LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_ShallowCopy);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_ShallowCopy_SharesValues);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_ShallowCopy_OutlivesSource);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_ShallowCopy_CopyOnWrite);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_ShallowCopy_OfCopy);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_SetLazyDecoder);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxTlvDictionary_SetLazyDecoder_ShallowCopy);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -231,7 +238,7 @@ LONGBOW_TEST_CASE(Global, ccnxTlvDictionary_Create)
     CCNxTlvDictionary *dictionary = ccnxTlvDictionary_Create(20, 30);
     assertNotNull(dictionary, "Got null dictionary from Create");
     assertNotNull(dictionary->directArray, "DirectArray is null");
-    assertNotNull(dictionary->fixedListHeads, "fixedListHeads is null");
+    assertNotNull(dictionary->fixedLists, "fixedLists is null");
 
     ccnxTlvDictionary_Release(&dictionary);
 }
@@ -317,6 +324,29 @@ LONGBOW_TEST_CASE(Global, ccnxTlvDictionary_SetGetMessageTypeImplementation)
     ccnxTlvDictionary_Release(&dictionary);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxTlvDictionary_SetArena)
+{
+    CCNxTlvDictionary *dictionary = ccnxTlvDictionary_Create(1, 1);
+    assertNull(ccnxTlvDictionary_GetArena(dictionary), "Expected no arena by default");
+
+    CCNxCodecArena *first = ccnxCodecArena_Create();
+    CCNxCodecArena *second = ccnxCodecArena_Create();
+
+    ccnxTlvDictionary_SetArena(dictionary, first);
+    assertTrue(ccnxTlvDictionary_GetArena(dictionary) == first, "Expected the first arena");
+
+    // Replacing the arena releases the first one, the teardown checks that nothing leaks.
+    ccnxTlvDictionary_SetArena(dictionary, second);
+    assertTrue(ccnxTlvDictionary_GetArena(dictionary) == second, "Expected the second arena");
+
+    ccnxCodecArena_Release(&first);
+    ccnxCodecArena_Release(&second);
+
+    // The dictionary still holds the second arena.
+    assertNotNull(ccnxCodecArena_Allocate(ccnxTlvDictionary_GetArena(dictionary), 16), "Expected the arena to be usable");
+    ccnxTlvDictionary_Release(&dictionary);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxTlvDictionary_Equals)
 {
     CCNxTlvDictionary *a = ccnxTlvDictionary_Create(1, 1);
@@ -363,6 +393,196 @@ LONGBOW_TEST_CASE(Global, ccnxTlvDictionary_ShallowCopy)
     ccnxTlvDictionary_Release(&b);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxTlvDictionary_ShallowCopy_SharesValues)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxTlvDictionary *a = data->dictionary;
+
+    PARCBuffer *first = parcBuffer_WrapCString("first");
+    PARCBuffer *second = parcBuffer_WrapCString("second");
+    ccnxTlvDictionary_PutListBuffer(a, SchemaEnd, 1, first);
+    ccnxTlvDictionary_PutListBuffer(a, SchemaEnd, 2, second);
+
+    CCNxTlvDictionary *b = ccnxTlvDictionary_ShallowCopy(a);
+
+    assertTrue(ccnxTlvDictionary_GetBuffer(a, SchemaBuffer) == ccnxTlvDictionary_GetBuffer(b, SchemaBuffer), "Buffer not shared");
+    assertTrue(ccnxTlvDictionary_GetName(a, SchemaName) == ccnxTlvDictionary_GetName(b, SchemaName), "Name not shared");
+    assertTrue(ccnxTlvDictionary_GetIoVec(a, SchemaIoVec) == ccnxTlvDictionary_GetIoVec(b, SchemaIoVec), "IoVec not shared");
+    assertTrue(ccnxTlvDictionary_GetJson(a, SchemaJson) == ccnxTlvDictionary_GetJson(b, SchemaJson), "Json not shared");
+    assertTrue(ccnxTlvDictionary_GetInteger(b, SchemaInteger) == 42, "Wrong integer");
+
+    // The lists are shared, not rebuilt, so they keep their order
+    assertTrue(_getList(a, SchemaEnd) == _getList(b, SchemaEnd), "List not shared");
+    PARCBuffer *test;
+    uint32_t key;
+    ccnxTlvDictionary_ListGetByPosition(b, SchemaEnd, 0, &test, &key);
+    assertTrue(test == first && key == 1, "Wrong list entry at position 0");
+    ccnxTlvDictionary_ListGetByPosition(b, SchemaEnd, 1, &test, &key);
+    assertTrue(test == second && key == 2, "Wrong list entry at position 1");
+
+    assertTrue(ccnxTlvDictionary_Equals(a, b), "Expected Dictionaries to be Equal after ShallowCopy");
+
+    ccnxTlvDictionary_Release(&b);
+    parcBuffer_Release(&second);
+    parcBuffer_Release(&first);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxTlvDictionary_ShallowCopy_OutlivesSource)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    CCNxTlvDictionary *a = ccnxTlvDictionary_ShallowCopy(data->dictionary);
+    PARCBuffer *buffer = parcBuffer_WrapCString("listed");
+    ccnxTlvDictionary_PutListBuffer(a, SchemaEnd + 5, 7, buffer);
+    parcBuffer_Release(&buffer);
+
+    CCNxTlvDictionary *b = ccnxTlvDictionary_ShallowCopy(a);
+    ccnxTlvDictionary_Release(&a);
+
+    assertNotNull(ccnxTlvDictionary_GetBuffer(b, SchemaBuffer), "Lost the buffer");
+    assertNotNull(ccnxTlvDictionary_GetName(b, SchemaName), "Lost the name");
+    assertNotNull(ccnxTlvDictionary_ListGetByType(b, SchemaEnd + 5, 7), "Lost the list entry");
+    assertTrue(ccnxTlvDictionary_Equals(data->dictionary, b) == false, "Copy has a list entry the original does not");
+
+    ccnxTlvDictionary_Release(&b);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxTlvDictionary_ShallowCopy_CopyOnWrite)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxTlvDictionary *a = data->dictionary;
+
+    PARCBuffer *shared = parcBuffer_WrapCString("shared");
+    ccnxTlvDictionary_PutListBuffer(a, SchemaEnd, 1, shared);
+
+    CCNxTlvDictionary *b = ccnxTlvDictionary_ShallowCopy(a);
+
+    // a borrowed value cannot be replaced, the same as in the original
+    PARCBuffer *other = parcBuffer_WrapCString("other");
+    assertFalse(ccnxTlvDictionary_PutBuffer(b, SchemaBuffer, other), "Should not replace a borrowed buffer");
+
+    ccnxTlvDictionary_PutInteger(b, SchemaInteger, 7);
+    assertTrue(ccnxTlvDictionary_GetInteger(b, SchemaInteger) == 7, "Copy did not take the new integer");
+    assertTrue(ccnxTlvDictionary_GetInteger(a, SchemaInteger) == 42, "Original integer changed");
+
+    ccnxTlvDictionary_PutBuffer(b, SchemaFree, other);
+    assertNull(ccnxTlvDictionary_GetBuffer(a, SchemaFree), "Original got the copy's buffer");
+
+    ccnxTlvDictionary_PutListBuffer(b, SchemaEnd, 2, other);
+    ccnxTlvDictionary_PutListBuffer(b, SchemaEnd + 5, 3, other);
+    assertTrue(ccnxTlvDictionary_ListSize(b, SchemaEnd) == 2, "Copy should have 2 list entries");
+    assertTrue(ccnxTlvDictionary_ListSize(a, SchemaEnd) == 1, "Original should have 1 list entry");
+    assertTrue(ccnxTlvDictionary_ListSize(a, SchemaEnd + 5) == 0, "Original should have an empty extra list");
+    assertTrue(ccnxTlvDictionary_ListGetByType(b, SchemaEnd, 1) == shared, "Copy lost the shared list entry");
+
+    // and the original can still change after the copy was made
+    ccnxTlvDictionary_PutListBuffer(a, SchemaEnd, 4, other);
+    assertNull(ccnxTlvDictionary_ListGetByType(b, SchemaEnd, 4), "Copy got the original's new list entry");
+
+    ccnxTlvDictionary_Release(&b);
+    parcBuffer_Release(&other);
+    parcBuffer_Release(&shared);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxTlvDictionary_ShallowCopy_OfCopy)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    PARCBuffer *buffer = parcBuffer_WrapCString("middle");
+    CCNxTlvDictionary *b = ccnxTlvDictionary_ShallowCopy(data->dictionary);
+    ccnxTlvDictionary_PutListBuffer(b, SchemaEnd, 1, buffer);
+    ccnxTlvDictionary_PutBuffer(b, SchemaFree, buffer);
+
+    CCNxTlvDictionary *c = ccnxTlvDictionary_ShallowCopy(b);
+    ccnxTlvDictionary_PutListBuffer(c, SchemaEnd, 2, buffer);
+    assertTrue(ccnxTlvDictionary_GetBuffer(c, SchemaFree) == buffer, "Copy of a copy lost the buffer");
+    assertTrue(ccnxTlvDictionary_ListSize(c, SchemaEnd) == 2, "Copy of a copy should have 2 list entries");
+
+    ccnxTlvDictionary_Release(&b);
+    ccnxTlvDictionary_Release(&c);
+    parcBuffer_Release(&buffer);
+}
+
+typedef struct test_lazy_state {
+    unsigned calls;
+    PARCBuffer *buffer;
+} TestLazyState;
+
+/*
+ * Fills in SchemaFree and one entry of list SchemaEnd, and puts into SchemaFree to check it is not called recursively.
+ */
+static bool
+_testLazyDecoder(CCNxTlvDictionary *dictionary, void *voidState, CCNxTlvDictionaryLazyRequest request, uint32_t key)
+{
+    TestLazyState *state = voidState;
+    state->calls++;
+    if ((request != CCNxTlvDictionaryLazyRequest_List && key == SchemaFree) || request == CCNxTlvDictionaryLazyRequest_All) {
+        ccnxTlvDictionary_PutBuffer(dictionary, SchemaFree, state->buffer);
+    }
+    if ((request == CCNxTlvDictionaryLazyRequest_List && key == SchemaEnd) || request == CCNxTlvDictionaryLazyRequest_All) {
+        if (ccnxTlvDictionary_ListSize(dictionary, SchemaEnd) == 0) {
+            ccnxTlvDictionary_PutListBuffer(dictionary, SchemaEnd, 7, state->buffer);
+        }
+    }
+    return true;
+}
+
+static void
+_testLazyStateFree(void **statePtr)
+{
+    TestLazyState *state = *statePtr;
+    parcBuffer_Release(&state->buffer);
+    parcMemory_Deallocate(statePtr);
+}
+
+static TestLazyState *
+_testLazyDecoderSet(CCNxTlvDictionary *dictionary)
+{
+    TestLazyState *state = parcMemory_AllocateAndClear(sizeof(TestLazyState));
+    state->buffer = parcBuffer_WrapCString("lazy");
+    ccnxTlvDictionary_SetLazyDecoder(dictionary, _testLazyDecoder, state, _testLazyStateFree);
+    return state;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxTlvDictionary_SetLazyDecoder)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    TestLazyState *state = _testLazyDecoderSet(data->dictionary);
+
+    // set fields do not call the decoder
+    assertNotNull(ccnxTlvDictionary_GetBuffer(data->dictionary, SchemaBuffer), "Lost SchemaBuffer");
+    assertTrue(state->calls == 0, "Expected no calls for a set field, got %u", state->calls);
+
+    assertTrue(ccnxTlvDictionary_GetBuffer(data->dictionary, SchemaFree) == state->buffer, "Expected the lazily decoded buffer");
+    assertTrue(state->calls == 1, "Expected 1 call, got %u", state->calls);
+    assertTrue(ccnxTlvDictionary_IsValueBuffer(data->dictionary, SchemaFree), "Expected SchemaFree set");
+    assertTrue(state->calls == 1, "Expected no call once the field is set, got %u", state->calls);
+
+    PARCBuffer *buffer;
+    uint32_t key;
+    assertTrue(ccnxTlvDictionary_ListGetByPosition(data->dictionary, SchemaEnd, 0, &buffer, &key), "Expected a list entry");
+    assertTrue(key == 7 && buffer == state->buffer, "Wrong list entry, key %u", key);
+
+    assertTrue(ccnxTlvDictionary_LazyDecodeAll(data->dictionary), "Expected LazyDecodeAll to succeed");
+    assertTrue(ccnxTlvDictionary_ListSize(data->dictionary, SchemaEnd) == 1, "Expected one list entry");
+
+    // The teardown checks the dictionary freed the state
+}
+
+LONGBOW_TEST_CASE(Global, ccnxTlvDictionary_SetLazyDecoder_ShallowCopy)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    TestLazyState *state = _testLazyDecoderSet(data->dictionary);
+
+    CCNxTlvDictionary *copy = ccnxTlvDictionary_ShallowCopy(data->dictionary);
+    assertTrue(state->calls == 1, "Expected the copy to decode everything once, got %u", state->calls);
+    assertTrue(ccnxTlvDictionary_GetBuffer(copy, SchemaFree) == state->buffer, "Copy lost the lazily decoded buffer");
+    assertTrue(ccnxTlvDictionary_ListSize(copy, SchemaEnd) == 1, "Copy lost the lazily decoded list");
+    assertTrue(ccnxTlvDictionary_Equals(copy, data->dictionary), "Copy should equal the source");
+
+    ccnxTlvDictionary_Release(&copy);
+}
+
 // ================================================================
 
 LONGBOW_TEST_FIXTURE(KnownKeys)
@@ -482,6 +702,9 @@ LONGBOW_TEST_FIXTURE(UnknownKeys)
     LONGBOW_RUN_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListGetByPosition);
     LONGBOW_RUN_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListGetByType);
     LONGBOW_RUN_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListSize);
+    LONGBOW_RUN_TEST_CASE(UnknownKeys, ccnxTlvDictionary_List_PutOrder);
+    LONGBOW_RUN_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListGetByType_Indexed);
+    LONGBOW_RUN_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListGetByType_Missing);
     LONGBOW_RUN_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListEquals);
 }
 
@@ -599,6 +822,80 @@ LONGBOW_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListSize)
     parcBuffer_Release(&c);
 }
 
+/*
+ * Entries are kept in the order they were put, which is wire order for a decoded packet
+ */
+LONGBOW_TEST_CASE(UnknownKeys, ccnxTlvDictionary_List_PutOrder)
+{
+    uint32_t listKey = FIXED_LIST_LENGTH + 1;
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCBuffer *buffer = parcBuffer_Allocate(1);
+
+    size_t count = 100;
+    for (uint32_t i = 0; i < count; i++) {
+        ccnxTlvDictionary_PutListBuffer(data->dictionary, listKey, 2000 + i, buffer);
+    }
+
+    assertTrue(ccnxTlvDictionary_ListSize(data->dictionary, listKey) == count,
+               "Wrong size, expected %zu got %zu", count, ccnxTlvDictionary_ListSize(data->dictionary, listKey));
+
+    for (uint32_t i = 0; i < count; i++) {
+        PARCBuffer *test = NULL;
+        uint32_t testkey = 0;
+        bool success = ccnxTlvDictionary_ListGetByPosition(data->dictionary, listKey, i, &test, &testkey);
+        assertTrue(success, "Failed to get position %u", i);
+        assertTrue(testkey == 2000 + i, "Wrong key at position %u, expected %u got %u", i, 2000 + i, testkey);
+    }
+
+    PARCBuffer *test = NULL;
+    uint32_t testkey = 0;
+    assertFalse(ccnxTlvDictionary_ListGetByPosition(data->dictionary, listKey, count, &test, &testkey), "Got a position past the end");
+
+    parcBuffer_Release(&buffer);
+}
+
+/*
+ * A list long enough to be indexed returns the first entry of each type
+ */
+LONGBOW_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListGetByType_Indexed)
+{
+    uint32_t listKey = SchemaEnd;
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    size_t count = 4 * LIST_INDEX_THRESHOLD;
+    PARCBuffer *buffers[count];
+    for (size_t i = 0; i < count; i++) {
+        buffers[i] = parcBuffer_Allocate(1);
+        // every key appears twice, the second time at i + count / 2
+        ccnxTlvDictionary_PutListBuffer(data->dictionary, listKey, 3000 + (i % (count / 2)), buffers[i]);
+    }
+
+    assertNotNull(_getList(data->dictionary, listKey)->index, "Expected a list of %zu entries to be indexed", count);
+
+    for (size_t i = 0; i < count / 2; i++) {
+        PARCBuffer *test = ccnxTlvDictionary_ListGetByType(data->dictionary, listKey, 3000 + i);
+        assertTrue(test == buffers[i], "Wrong buffer for key %zu, expected %p got %p", 3000 + i, (void *) buffers[i], (void *) test);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        parcBuffer_Release(&buffers[i]);
+    }
+}
+
+LONGBOW_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListGetByType_Missing)
+{
+    uint32_t listKey = SchemaEnd;
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    assertNull(ccnxTlvDictionary_ListGetByType(data->dictionary, listKey, 1000), "Got a buffer from an empty list");
+    assertNull(ccnxTlvDictionary_ListGetByType(data->dictionary, FIXED_LIST_LENGTH + 1, 1000), "Got a buffer from an empty extra list");
+
+    PARCBuffer *buffer = parcBuffer_Allocate(1);
+    ccnxTlvDictionary_PutListBuffer(data->dictionary, listKey, 1000, buffer);
+    assertNull(ccnxTlvDictionary_ListGetByType(data->dictionary, listKey, 1001), "Got a buffer for a missing type");
+    parcBuffer_Release(&buffer);
+}
+
 LONGBOW_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListEquals)
 {
     TestData *data = longBowTestCase_GetClipBoardData(testCase);
@@ -614,7 +911,7 @@ LONGBOW_TEST_CASE(UnknownKeys, ccnxTlvDictionary_ListEquals)
     ccnxTlvDictionary_PutListBuffer(data->dictionary, 7, 1001, b);
     ccnxTlvDictionary_PutListBuffer(data->dictionary, 7, 1002, c);
 
-    bool equals = _ccnxTlvDictionary_ListEquals(_getListHead(data->dictionary, 6), _getListHead(data->dictionary, 7));
+    bool equals = _ccnxTlvDictionary_ListEquals(_getList(data->dictionary, 6), _getList(data->dictionary, 7));
     assertTrue(equals, "Lists should be equal");
 
     parcBuffer_Release(&a);
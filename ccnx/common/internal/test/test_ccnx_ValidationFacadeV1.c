@@ -104,6 +104,8 @@ LONGBOW_TEST_FIXTURE(Setters)
     LONGBOW_RUN_TEST_CASE(Setters, ccnxValidationFacadeV1_SetPayload);
     LONGBOW_RUN_TEST_CASE(Setters, ccnxValidationFacadeV1_SetCryptoSuite);
     LONGBOW_RUN_TEST_CASE(Setters, ccnxValidationFacadeV1_SetSigningTime);
+    LONGBOW_RUN_TEST_CASE(Setters, ccnxValidationFacadeV1_SetUnsigned);
+    LONGBOW_RUN_TEST_CASE(Setters, ccnxValidationFacadeV1_SetUnsigned_HasCryptoSuite);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Setters)
@@ -280,6 +282,30 @@ LONGBOW_TEST_CASE(Setters, ccnxValidationFacadeV1_SetSigningTime)
     ccnxTlvDictionary_Release(&dictionary);
 }
 
+LONGBOW_TEST_CASE(Setters, ccnxValidationFacadeV1_SetUnsigned)
+{
+    CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateContentObject();
+    assertFalse(ccnxValidationFacadeV1_IsUnsigned(dictionary), "New dictionary should not be unsigned");
+
+    bool success = ccnxValidationFacadeV1_SetUnsigned(dictionary);
+    assertTrue(success, "Failed to set unsigned");
+    assertTrue(ccnxValidationFacadeV1_IsUnsigned(dictionary), "Dictionary should be unsigned");
+
+    ccnxTlvDictionary_Release(&dictionary);
+}
+
+LONGBOW_TEST_CASE(Setters, ccnxValidationFacadeV1_SetUnsigned_HasCryptoSuite)
+{
+    CCNxTlvDictionary *dictionary = ccnxCodecSchemaV1TlvDictionary_CreateContentObject();
+    ccnxValidationFacadeV1_SetCryptoSuite(dictionary, PARCCryptoSuite_RSA_SHA256);
+
+    bool success = ccnxValidationFacadeV1_SetUnsigned(dictionary);
+    assertFalse(success, "Should not mark a dictionary with a crypto suite unsigned");
+    assertFalse(ccnxValidationFacadeV1_IsUnsigned(dictionary), "Dictionary should not be unsigned");
+
+    ccnxTlvDictionary_Release(&dictionary);
+}
+
 // =============================================================
 
 LONGBOW_TEST_FIXTURE(Getters)
@@ -163,6 +163,7 @@ LONGBOW_TEST_FIXTURE(SchemaV1)
     LONGBOW_RUN_TEST_CASE(SchemaV1, ccnxWireFormatFacadeV1_HashProtectedRegion_Buffer);
     LONGBOW_RUN_TEST_CASE(SchemaV1, ccnxWireFormatFacadeV1_HashProtectedRegion_IoVec);
     LONGBOW_RUN_TEST_CASE(SchemaV1, ccnxWireFormatFacadeV1_ComputeContentObjectHash);
+    LONGBOW_RUN_TEST_CASE(SchemaV1, ccnxWireFormatFacadeV1_ComputeContentObjectHashDigest);
 
     LONGBOW_RUN_TEST_CASE(SchemaV1, ccnxWireFormatFacadeV1_Create_Interest);
     LONGBOW_RUN_TEST_CASE(SchemaV1, ccnxWireFormatFacadeV1_Create_ContentObject);
@@ -560,6 +561,34 @@ LONGBOW_TEST_CASE(SchemaV1, ccnxWireFormatFacadeV1_ComputeContentObjectHash)
     ccnxContentObject_Release(&contentObject);
 }
 
+LONGBOW_TEST_CASE(SchemaV1, ccnxWireFormatFacadeV1_ComputeContentObjectHashDigest)
+{
+    PARCBuffer *wireFormatBuffer = parcBuffer_Wrap(_v1_ContentObject_WithKnownHash, sizeof(_v1_ContentObject_WithKnownHash),
+                                                   0, sizeof(_v1_ContentObject_WithKnownHash));
+
+    CCNxWireFormatMessage *message = ccnxWireFormatMessage_Create(wireFormatBuffer);
+    CCNxTlvDictionary *contentObject = ccnxWireFormatMessage_GetDictionary(message);
+    assertTrue(ccnxCodecTlvPacket_BufferDecode(wireFormatBuffer, contentObject), "Expected to decode the wireformat buffer");
+
+    uint8_t digest[CCNxWireFormatMessage_ContentObjectHashLength];
+    bool success = _ccnxWireFormatFacadeV1_ComputeContentObjectHashDigest(contentObject, digest);
+    assertTrue(success, "Expected to compute the content object hash");
+
+    PARCBuffer *digestBuffer = parcBuffer_Wrap(digest, sizeof(digest), 0, sizeof(digest));
+    char *computedHash = parcBuffer_ToHexString(digestBuffer);
+
+    char *knownHash = "4FB301EA5FD523B9A71287B721DC20C94B2D4827674A8CA275B7D57C60447876";
+
+    assertTrue(strncasecmp(computedHash, knownHash, strlen(knownHash)) == 0, "Expected a matching ContentObject hash");
+    assertTrue(parcBuffer_Position(wireFormatBuffer) == 0, "Computing the digest should not move the wire format position");
+
+    parcMemory_Deallocate(&computedHash);
+    parcBuffer_Release(&digestBuffer);
+    parcBuffer_Release(&wireFormatBuffer);
+
+    ccnxContentObject_Release(&contentObject);
+}
+
 // =======================================================================
 
 LONGBOW_TEST_FIXTURE(Local)
@@ -131,6 +131,8 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxContentObject_Equals);
     LONGBOW_RUN_TEST_CASE(Global, ccnxContentObject_SetSignature);
     LONGBOW_RUN_TEST_CASE(Global, ccnxContentObject_GetKeyId);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxContentObject_SetUnsigned);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxContentObject_SetUnsigned_Signed);
     LONGBOW_RUN_TEST_CASE(Global, ccnxContentObject_CreateWithNameAndPayload);
     LONGBOW_RUN_TEST_CASE(Global, ccnxContentObject_CreateWithPayload);
 
@@ -414,6 +416,45 @@ LONGBOW_TEST_CASE(Global, ccnxContentObject_GetKeyId)
     ccnxContentObject_Release(&contentObject);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxContentObject_SetUnsigned)
+{
+    CCNxName *name = ccnxName_CreateFromCString("ccnx:/hello/dolly");
+    PARCBuffer *payload = parcBuffer_WrapCString("hello");
+
+    CCNxContentObject *contentObject = ccnxContentObject_CreateWithNameAndPayload(name, payload);
+    assertFalse(ccnxContentObject_IsUnsigned(contentObject), "New content object should not be unsigned");
+
+    assertTrue(ccnxContentObject_SetUnsigned(contentObject), "Failed to mark the content object unsigned");
+    assertTrue(ccnxContentObject_IsUnsigned(contentObject), "Content object should be unsigned");
+
+    parcBuffer_Release(&payload);
+    ccnxName_Release(&name);
+    ccnxContentObject_Release(&contentObject);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxContentObject_SetUnsigned_Signed)
+{
+    CCNxName *name = ccnxName_CreateFromCString("ccnx:/hello/dolly");
+    PARCBuffer *payload = parcBuffer_WrapCString("hello");
+
+    CCNxContentObject *contentObject = ccnxContentObject_CreateWithNameAndPayload(name, payload);
+
+    PARCBuffer *keyId = parcBuffer_WrapCString("keyhash");
+    PARCBuffer *sigbits = parcBuffer_WrapCString("siggybits");
+    PARCSignature *signature = parcSignature_Create(PARCSigningAlgorithm_RSA, PARCCryptoHashType_SHA256, parcBuffer_Flip(sigbits));
+    ccnxContentObject_SetSignature(contentObject, keyId, signature, NULL);
+
+    assertFalse(ccnxContentObject_SetUnsigned(contentObject), "A signed content object cannot be marked unsigned");
+    assertFalse(ccnxContentObject_IsUnsigned(contentObject), "Content object should not be unsigned");
+
+    parcBuffer_Release(&payload);
+    parcBuffer_Release(&sigbits);
+    parcBuffer_Release(&keyId);
+    parcSignature_Release(&signature);
+    ccnxName_Release(&name);
+    ccnxContentObject_Release(&contentObject);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxContentObject_HasExpiryTime)
 {
     CCNxName *name = ccnxName_CreateFromCString("ccnx:/hello/dolly");
@@ -198,6 +198,8 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxManifest_AcquireRelease);
     LONGBOW_RUN_TEST_CASE(Global, ccnxManifest_Create);
     LONGBOW_RUN_TEST_CASE(Global, ccnxManifest_AddHashGroup);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifest_AddHashGroup_Snapshot);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifest_AddHashGroup_ShallowCopy);
     LONGBOW_RUN_TEST_CASE(Global, ccnxManifest_GetHashGroup);
     LONGBOW_RUN_TEST_CASE(Global, ccnxManifest_GetNumberOfHashGroups);
     LONGBOW_RUN_TEST_CASE(Global, ccnxManifest_GetName);
@@ -270,6 +272,63 @@ LONGBOW_TEST_CASE(Global, ccnxManifest_AddHashGroup)
     ccnxManifestHashGroup_Release(&group);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxManifest_AddHashGroup_Snapshot)
+{
+    CCNxName *name = ccnxName_CreateFromCString("ccnx:/my/manifest");
+    CCNxManifest *manifest = ccnxManifest_Create(name);
+    ccnxName_Release(&name);
+
+    PARCBuffer *digest = parcBuffer_Allocate(32);
+    CCNxManifestHashGroup *group = ccnxManifestHashGroup_Create();
+    ccnxManifestHashGroup_AppendPointer(group, CCNxManifestHashGroupPointerType_Data, digest);
+    ccnxManifest_AddHashGroup(manifest, group);
+
+    // Changing the caller's group after adding it must not change the manifest
+    ccnxManifestHashGroup_AppendPointer(group, CCNxManifestHashGroupPointerType_Data, digest);
+    ccnxManifestHashGroup_SetDataSize(group, 1234);
+
+    CCNxManifestHashGroup *stored = ccnxManifest_GetHashGroupByIndex(manifest, 0);
+    assertTrue(ccnxManifestHashGroup_GetNumberOfPointers(stored) == 1,
+               "Expected the manifest to keep 1 pointer, got %zu", ccnxManifestHashGroup_GetNumberOfPointers(stored));
+    assertTrue(ccnxManifestHashGroup_GetDataSize(stored) == 0,
+               "Expected the manifest to keep data size 0, got %zu", ccnxManifestHashGroup_GetDataSize(stored));
+
+    ccnxManifestHashGroup_Release(&stored);
+    ccnxManifestHashGroup_Release(&group);
+    parcBuffer_Release(&digest);
+    ccnxManifest_Release(&manifest);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifest_AddHashGroup_ShallowCopy)
+{
+    CCNxName *name = ccnxName_CreateFromCString("ccnx:/my/manifest");
+    CCNxManifest *source = ccnxManifest_Create(name);
+    ccnxName_Release(&name);
+
+    CCNxManifestHashGroup *group = ccnxManifestHashGroup_Create();
+    ccnxManifest_AddHashGroup(source, group);
+
+    CCNxManifest *copy = ccnxTlvDictionary_ShallowCopy(source);
+
+    // Each side's new group is only seen by that side
+    ccnxManifest_AddHashGroup(copy, group);
+    assertTrue(ccnxManifest_GetNumberOfHashGroups(source) == 1,
+               "Expected the source to keep 1 hash group, got %zu", ccnxManifest_GetNumberOfHashGroups(source));
+    assertTrue(ccnxManifest_GetNumberOfHashGroups(copy) == 2,
+               "Expected the copy to have 2 hash groups, got %zu", ccnxManifest_GetNumberOfHashGroups(copy));
+
+    ccnxManifest_AddHashGroup(source, group);
+    ccnxManifest_AddHashGroup(source, group);
+    assertTrue(ccnxManifest_GetNumberOfHashGroups(source) == 3,
+               "Expected the source to have 3 hash groups, got %zu", ccnxManifest_GetNumberOfHashGroups(source));
+    assertTrue(ccnxManifest_GetNumberOfHashGroups(copy) == 2,
+               "Expected the copy to keep 2 hash groups, got %zu", ccnxManifest_GetNumberOfHashGroups(copy));
+
+    ccnxManifest_Release(&copy);
+    ccnxManifestHashGroup_Release(&group);
+    ccnxManifest_Release(&source);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxManifest_GetHashGroup)
 {
     ManifestTestData *data = longBowTestCase_GetClipBoardData(testCase);
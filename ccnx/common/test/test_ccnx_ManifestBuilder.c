@@ -0,0 +1,562 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <LongBow/unit-test.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_LinkedList.h>
+#include <parc/security/parc_Security.h>
+#include <parc/security/parc_Pkcs12KeyStore.h>
+#include <parc/security/parc_PublicKeySigner.h>
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../ccnx_ManifestBuilder.c"
+
+#include <ccnx/common/ccnx_ContentObject.h>
+#include <ccnx/common/internal/ccnx_ValidationFacadeV1.h>
+
+typedef struct {
+    PARCLinkedList *digests;
+    size_t count;
+    CCNxManifest *root;
+} _ManifestCollector;
+
+/*
+ * Check that every manifest pointer refers to a manifest emitted earlier, then remember the manifest.
+ */
+static void
+_collectManifest(CCNxManifest *manifest, const PARCBuffer *digest, bool isRoot, void *context)
+{
+    _ManifestCollector *collector = context;
+
+    assertNull(collector->root, "Expected nothing to be emitted after the root");
+    assertNotNull(ccnxWireFormatMessage_GetIoVec(manifest), "Expected the manifest to carry its wire format");
+    assertTrue(isRoot || ccnxManifest_GetName(manifest) == NULL, "Expected only the root to be named");
+    assertTrue(isRoot || !ccnxValidationFacadeV1_HasCryptoSuite(manifest), "Expected only the root to be signed");
+
+    for (size_t g = 0; g < ccnxManifest_GetNumberOfHashGroups(manifest); g++) {
+        CCNxManifestHashGroup *group = ccnxManifest_GetHashGroupByIndex(manifest, g);
+
+        CCNxManifestHashGroupPointerType type;
+        const uint8_t *bytes;
+        size_t length;
+        for (size_t i = 0; ccnxManifestHashGroup_GetPointerBytesAtIndex(group, i, &type, &bytes, &length); i++) {
+            if (type == CCNxManifestHashGroupPointerType_Manifest) {
+                PARCBuffer *pointer = parcBuffer_Wrap((uint8_t *) bytes, length, 0, length);
+                assertTrue(parcLinkedList_Contains(collector->digests, pointer), "Expected pointer %zu to refer to an emitted manifest", i);
+                parcBuffer_Release(&pointer);
+            }
+        }
+        ccnxManifestHashGroup_Release(&group);
+    }
+
+    PARCBuffer *copy = parcBuffer_Copy(digest);
+    parcLinkedList_Append(collector->digests, copy);
+    parcBuffer_Release(&copy);
+
+    collector->count++;
+    if (isRoot) {
+        collector->root = ccnxManifest_Acquire(manifest);
+    }
+}
+
+static void
+_initCollector(_ManifestCollector *collector)
+{
+    collector->digests = parcLinkedList_Create();
+    collector->count = 0;
+    collector->root = NULL;
+}
+
+static void
+_finiCollector(_ManifestCollector *collector)
+{
+    parcLinkedList_Release(&collector->digests);
+    if (collector->root != NULL) {
+        ccnxManifest_Release(&collector->root);
+    }
+}
+
+static CCNxManifestHashGroup *
+_rootGroup(const _ManifestCollector *collector)
+{
+    assertNotNull(collector->root, "Expected a root manifest");
+    assertTrue(ccnxManifest_GetNumberOfHashGroups(collector->root) == 1, "Expected the root to have one hash group");
+    return ccnxManifest_GetHashGroupByIndex(collector->root, 0);
+}
+
+LONGBOW_TEST_RUNNER(ccnx_ManifestBuilder)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+LONGBOW_TEST_RUNNER_SETUP(ccnx_ManifestBuilder)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_RUNNER_TEARDOWN(ccnx_ManifestBuilder)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestBuilder_AcquireRelease);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestBuilder_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestBuilder_AppendData_SingleManifest);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestBuilder_AppendDigest_Tree);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestBuilder_AppendDigest_FullLevels);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestBuilder_AppendDigest_TooLong);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestBuilder_Append_AfterFinish);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestBuilder_SetRootSigner);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestBuilder_SetRootSigner_AfterFinish);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    if (parcSafeMemory_ReportAllocation(STDOUT_FILENO) != 0) {
+        printf("('%s' leaks memory by %d (allocs - frees)) ", longBowTestCase_GetName(testCase), parcMemory_Outstanding());
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestBuilder_AcquireRelease)
+{
+    _ManifestCollector collector;
+    _initCollector(&collector);
+
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(NULL, 4, 1024, _collectManifest, &collector);
+    assertNotNull(builder, "Expected non-null result from ccnxManifestBuilder_Create");
+
+    CCNxManifestBuilder *reference = ccnxManifestBuilder_Acquire(builder);
+    assertTrue(reference == builder, "Expected ccnxManifestBuilder_Acquire to return the same instance");
+    ccnxManifestBuilder_Release(&reference);
+    ccnxManifestBuilder_Release(&builder);
+    assertNull(builder, "Expected ccnxManifestBuilder_Release to null the pointer");
+
+    assertTrue(collector.count == 0, "Expected nothing to be emitted without ccnxManifestBuilder_Finish");
+    _finiCollector(&collector);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestBuilder_Empty)
+{
+    _ManifestCollector collector;
+    _initCollector(&collector);
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/object");
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(name, 4, 1024, _collectManifest, &collector);
+
+    size_t emitted = ccnxManifestBuilder_Finish(builder);
+    assertTrue(emitted == 1, "Expected only the root manifest, got %zu", emitted);
+    assertTrue(ccnxName_Equals(ccnxManifest_GetName(collector.root), name), "Expected the root to be named");
+
+    CCNxManifestHashGroup *group = _rootGroup(&collector);
+    assertTrue(ccnxManifestHashGroup_GetNumberOfPointers(group) == 0, "Expected no pointers");
+    ccnxManifestHashGroup_Release(&group);
+
+    ccnxManifestBuilder_Release(&builder);
+    ccnxName_Release(&name);
+    _finiCollector(&collector);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestBuilder_AppendData_SingleManifest)
+{
+    _ManifestCollector collector;
+    _initCollector(&collector);
+
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(NULL, 4, 8, _collectManifest, &collector);
+    PARCCryptoHasher *hasher = parcCryptoHasher_Create(PARCCryptoHashType_SHA256);
+    parcCryptoHasher_Init(hasher);
+
+    const char *chunks[] = { "chunk #0", "chunk #1", "chunk" };
+    size_t totalSize = 0;
+    for (size_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+        PARCBuffer *chunk = parcBuffer_WrapCString((char *) chunks[i]);
+        assertTrue(ccnxManifestBuilder_AppendData(builder, chunk), "Expected chunk %zu to be added", i);
+        parcCryptoHasher_UpdateBuffer(hasher, chunk);
+        totalSize += parcBuffer_Remaining(chunk);
+        parcBuffer_Release(&chunk);
+    }
+
+    size_t emitted = ccnxManifestBuilder_Finish(builder);
+    assertTrue(emitted == 1, "Expected one manifest, got %zu", emitted);
+    assertTrue(ccnxManifestBuilder_GetTreeHeight(builder) == 1, "Expected a tree of height 1");
+
+    CCNxManifestHashGroup *group = _rootGroup(&collector);
+    assertTrue(ccnxManifestHashGroup_GetNumberOfPointers(group) == 3, "Expected 3 pointers");
+    assertTrue(ccnxManifestHashGroup_GetTreeHeight(group) == 1, "Expected TreeHeight 1");
+    assertTrue(ccnxManifestHashGroup_GetDataSize(group) == totalSize, "Expected DataSize %zu", totalSize);
+    assertTrue(ccnxManifestHashGroup_GetBlockSize(group) == 8, "Expected BlockSize 8");
+
+    PARCCryptoHash *expected = parcCryptoHasher_Finalize(hasher);
+    assertTrue(parcBuffer_Equals(parcCryptoHash_GetDigest(expected), ccnxManifestHashGroup_GetOverallDataDigest(group)),
+               "Expected the OverallDataSha256 of the whole object");
+    parcCryptoHash_Release(&expected);
+
+    ccnxManifestHashGroup_Release(&group);
+    parcCryptoHasher_Release(&hasher);
+    ccnxManifestBuilder_Release(&builder);
+    _finiCollector(&collector);
+}
+
+static void
+_appendDigests(CCNxManifestBuilder *builder, size_t count, size_t chunkSize)
+{
+    for (size_t i = 0; i < count; i++) {
+        PARCBuffer *digest = parcBuffer_Flip(parcBuffer_PutUint32(parcBuffer_Allocate(32), (uint32_t) i));
+        assertTrue(ccnxManifestBuilder_AppendDigest(builder, digest, chunkSize), "Expected digest %zu to be added", i);
+        parcBuffer_Release(&digest);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestBuilder_AppendDigest_Tree)
+{
+    _ManifestCollector collector;
+    _initCollector(&collector);
+
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(NULL, 3, 100, _collectManifest, &collector);
+    _appendDigests(builder, 10, 100);
+
+    // 4 leaves of 3, 3, 3 and 1 pointers, 2 interior manifests over them, and the root.
+    size_t emitted = ccnxManifestBuilder_Finish(builder);
+    assertTrue(emitted == 7, "Expected 7 manifests, got %zu", emitted);
+    assertTrue(ccnxManifestBuilder_GetTreeHeight(builder) == 3, "Expected a tree of height 3, got %zu", ccnxManifestBuilder_GetTreeHeight(builder));
+
+    CCNxManifestHashGroup *group = _rootGroup(&collector);
+    assertTrue(ccnxManifestHashGroup_GetNumberOfPointers(group) == 2, "Expected 2 pointers in the root");
+    assertTrue(ccnxManifestHashGroup_GetPointerTypeAtIndex(group, 0) == CCNxManifestHashGroupPointerType_Manifest, "Expected manifest pointers in the root");
+    assertTrue(ccnxManifestHashGroup_GetTreeHeight(group) == 3, "Expected TreeHeight 3");
+    assertTrue(ccnxManifestHashGroup_GetDataSize(group) == 1000, "Expected DataSize 1000, got %zu", ccnxManifestHashGroup_GetDataSize(group));
+    assertNull(ccnxManifestHashGroup_GetOverallDataDigest(group), "Expected no OverallDataSha256 when given only digests");
+    ccnxManifestHashGroup_Release(&group);
+
+    ccnxManifestBuilder_Release(&builder);
+    _finiCollector(&collector);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestBuilder_AppendDigest_FullLevels)
+{
+    _ManifestCollector collector;
+    _initCollector(&collector);
+
+    // Exactly fanout^2 chunks must not add a root over a single manifest.
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(NULL, 4, 0, _collectManifest, &collector);
+    _appendDigests(builder, 16, 10);
+
+    size_t emitted = ccnxManifestBuilder_Finish(builder);
+    assertTrue(emitted == 5, "Expected 5 manifests, got %zu", emitted);
+    assertTrue(ccnxManifestBuilder_GetTreeHeight(builder) == 2, "Expected a tree of height 2");
+
+    CCNxManifestHashGroup *group = _rootGroup(&collector);
+    assertTrue(ccnxManifestHashGroup_GetNumberOfPointers(group) == 4, "Expected 4 pointers in the root");
+    assertTrue(ccnxManifestHashGroup_GetDataSize(group) == 160, "Expected DataSize 160");
+    assertTrue(ccnxManifestHashGroup_GetBlockSize(group) == 0, "Expected no BlockSize");
+    ccnxManifestHashGroup_Release(&group);
+
+    ccnxManifestBuilder_Release(&builder);
+    _finiCollector(&collector);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestBuilder_AppendDigest_TooLong)
+{
+    _ManifestCollector collector;
+    _initCollector(&collector);
+
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(NULL, 4, 0, _collectManifest, &collector);
+
+    PARCBuffer *digest = parcBuffer_Allocate(CCNxManifestHashGroup_MaxDigestLength + 1);
+    assertFalse(ccnxManifestBuilder_AppendDigest(builder, digest, 1), "Expected a digest that is too long to be rejected");
+    parcBuffer_Release(&digest);
+
+    ccnxManifestBuilder_Release(&builder);
+    _finiCollector(&collector);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestBuilder_Append_AfterFinish)
+{
+    _ManifestCollector collector;
+    _initCollector(&collector);
+
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(NULL, 4, 0, _collectManifest, &collector);
+    _appendDigests(builder, 2, 10);
+    ccnxManifestBuilder_Finish(builder);
+
+    PARCBuffer *chunk = parcBuffer_WrapCString("late");
+    assertFalse(ccnxManifestBuilder_AppendData(builder, chunk), "Expected no chunks after ccnxManifestBuilder_Finish");
+    assertFalse(ccnxManifestBuilder_AppendDigest(builder, chunk, 4), "Expected no chunks after ccnxManifestBuilder_Finish");
+    parcBuffer_Release(&chunk);
+
+    size_t emitted = ccnxManifestBuilder_Finish(builder);
+    assertTrue(emitted == 1, "Expected a second ccnxManifestBuilder_Finish to emit nothing more, got %zu", emitted);
+
+    ccnxManifestBuilder_Release(&builder);
+    _finiCollector(&collector);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestBuilder_SetRootSigner)
+{
+    _ManifestCollector collector;
+    _initCollector(&collector);
+
+    PARCBuffer *secretKey = parcBuffer_WrapCString("abcdefghijklmnopqrstuvwxyx");
+    PARCSigner *signer = ccnxValidationHmacSha256_CreateSigner(secretKey);
+    PARCBuffer *keyid = parcBuffer_WrapCString("keyid");
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/object");
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(name, 4, 0, _collectManifest, &collector);
+    assertTrue(ccnxManifestBuilder_SetRootSigner(builder, signer, keyid, NULL), "Expected an HMAC signer to be accepted");
+
+    _appendDigests(builder, 10, 100);
+    size_t emitted = ccnxManifestBuilder_Finish(builder);
+    assertTrue(emitted > 1, "Expected a tree of several manifests, got %zu", emitted);
+
+    assertTrue(ccnxValidationFacadeV1_HasCryptoSuite(collector.root), "Expected the root to have a ValidationAlg");
+    assertTrue(ccnxValidationFacadeV1_GetCryptoSuite(collector.root) == PARCCryptoSuite_HMAC_SHA256, "Expected an HMAC-SHA256 root");
+    PARCBuffer *keyidTest = ccnxValidationFacadeV1_GetKeyId(collector.root);
+    assertTrue(parcBuffer_Equals(keyid, keyidTest), "Expected the root to carry the KeyId");
+
+    PARCBuffer *payload = ccnxValidationFacadeV1_GetPayload(collector.root);
+    assertNotNull(payload, "Expected the root to have a ValidationPayload");
+    assertTrue(parcBuffer_Remaining(payload) == 32, "Expected a 32 byte HMAC, got %zu", parcBuffer_Remaining(payload));
+
+    ccnxManifestBuilder_Release(&builder);
+    ccnxName_Release(&name);
+    parcBuffer_Release(&keyid);
+    parcSigner_Release(&signer);
+    parcBuffer_Release(&secretKey);
+    _finiCollector(&collector);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestBuilder_SetRootSigner_AfterFinish)
+{
+    _ManifestCollector collector;
+    _initCollector(&collector);
+
+    PARCBuffer *secretKey = parcBuffer_WrapCString("abcdefghijklmnopqrstuvwxyx");
+    PARCSigner *signer = ccnxValidationHmacSha256_CreateSigner(secretKey);
+
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(NULL, 4, 0, _collectManifest, &collector);
+    ccnxManifestBuilder_Finish(builder);
+    assertFalse(ccnxManifestBuilder_SetRootSigner(builder, signer, NULL, NULL), "Expected no signer after the root is emitted");
+    assertFalse(ccnxValidationFacadeV1_HasCryptoSuite(collector.root), "Expected an unsigned root");
+
+    ccnxManifestBuilder_Release(&builder);
+    parcSigner_Release(&signer);
+    parcBuffer_Release(&secretKey);
+    _finiCollector(&collector);
+}
+
+// =================================================================
+
+/*
+ * The Performance fixture compares publishing an object by signing every chunk with publishing it
+ * as unsigned chunks under a manifest tree whose root is the only signed packet.
+ */
+#define _benchmarkKeyStore "test_ccnx_ManifestBuilder.p12"
+#define _benchmarkChunkSize 4096
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxManifestBuilder_SignEveryChunk_SignRoot);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcSecurity_Init();
+    bool success = parcPkcs12KeyStore_CreateFile(_benchmarkKeyStore, "1234", "ccnxuser", 2048, 1);
+    assertTrue(success, "parcPkcs12KeyStore_CreateFile() failed.");
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    unlink(_benchmarkKeyStore);
+    parcSecurity_Fini();
+    if (parcSafeMemory_ReportAllocation(STDOUT_FILENO) != 0) {
+        printf("('%s' leaks memory by %d (allocs - frees)) ", longBowTestCase_GetName(testCase), parcMemory_Outstanding());
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static PARCSigner *
+_createRsaSigner(void)
+{
+    PARCPkcs12KeyStore *publicKeyStore = parcPkcs12KeyStore_Open(_benchmarkKeyStore, "1234", PARCCryptoHashType_SHA256);
+    PARCKeyStore *keyStore = parcKeyStore_Create(publicKeyStore, PARCPkcs12KeyStoreAsKeyStore);
+    parcPkcs12KeyStore_Release(&publicKeyStore);
+    PARCPublicKeySigner *publicKeySigner = parcPublicKeySigner_Create(keyStore, PARCSigningAlgorithm_RSA, PARCCryptoHashType_SHA256);
+    PARCSigner *signer = parcSigner_Create(publicKeySigner, PARCPublicKeySignerAsSigner);
+    parcPublicKeySigner_Release(&publicKeySigner);
+    parcKeyStore_Release(&keyStore);
+    assertNotNull(signer, "Could not open the benchmark keystore");
+    return signer;
+}
+
+/*
+ * Encode a chunk the way a publisher would: the encoder has a signer, so the chunk is signed unless it is marked unsigned.
+ * Returns the ContentObjectHash of the chunk.
+ */
+static PARCCryptoHash *
+_publishChunk(CCNxContentObject *chunk, PARCSigner *signer)
+{
+    CCNxCodecTlvEncoder *encoder = ccnxCodecTlvEncoder_Create();
+    ccnxCodecTlvEncoder_SetSigner(encoder, signer);
+    ssize_t length = ccnxCodecSchemaV1PacketEncoder_Encode(encoder, chunk);
+    assertTrue(length > 0, "Could not encode the chunk");
+    ccnxCodecTlvEncoder_Finalize(encoder);
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecTlvEncoder_CreateIoVec(encoder);
+    ccnxCodecTlvEncoder_Destroy(&encoder);
+
+    const CCNxCodecSchemaV1FixedHeader *header = ccnxCodecNetworkBufferIoVec_GetArray(vec)[0].iov_base;
+    ccnxTlvDictionary_PutInteger(chunk, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ContentObjectHashRegionStart, header->headerLength);
+    ccnxTlvDictionary_PutInteger(chunk, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ContentObjectHashRegionLength,
+                                 ccnxCodecNetworkBufferIoVec_Length(vec) - header->headerLength);
+    ccnxWireFormatMessage_PutIoVec(chunk, vec);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+
+    return ccnxWireFormatMessage_CreateContentObjectHash(chunk);
+}
+
+static void
+_discardManifest(CCNxManifest *manifest, const PARCBuffer *digest, bool isRoot, void *context)
+{
+    size_t *count = context;
+    (*count)++;
+}
+
+static void
+_benchmarkPublish(PARCSigner *signer, unsigned chunks, bool amortized)
+{
+    PARCBuffer *data = parcBuffer_Allocate(_benchmarkChunkSize);
+    memset(parcBuffer_Overlay(data, 0), 0xA5, _benchmarkChunkSize);
+
+    size_t manifests = 0;
+    CCNxName *rootName = ccnxName_CreateFromCString("lci:/benchmark/object");
+    CCNxManifestBuilder *builder = NULL;
+    if (amortized) {
+        builder = ccnxManifestBuilder_Create(rootName, 1000, _benchmarkChunkSize, _discardManifest, &manifests);
+        ccnxManifestBuilder_SetRootSigner(builder, signer, NULL, NULL);
+    }
+
+    struct timeval t0, t1;
+    gettimeofday(&t0, NULL);
+    for (unsigned i = 0; i < chunks; i++) {
+        CCNxContentObject *chunk = ccnxContentObject_CreateWithPayload(data);
+        if (amortized) {
+            ccnxContentObject_SetUnsigned(chunk);
+        }
+
+        PARCCryptoHash *hash = _publishChunk(chunk, signer);
+        if (amortized) {
+            ccnxManifestBuilder_AppendDigest(builder, parcCryptoHash_GetDigest(hash), _benchmarkChunkSize);
+        }
+
+        parcCryptoHash_Release(&hash);
+        ccnxContentObject_Release(&chunk);
+    }
+    if (amortized) {
+        ccnxManifestBuilder_Finish(builder);
+    }
+    gettimeofday(&t1, NULL);
+    timersub(&t1, &t0, &t1);
+    double seconds = t1.tv_sec + t1.tv_usec * 1E-6;
+
+    printf("\n%-20s chunks %u manifests %zu seconds %.3f chunks/second %.0f\n",
+           amortized ? "Sign root manifest" : "Sign every chunk", chunks, manifests, seconds, chunks / seconds);
+
+    if (builder != NULL) {
+        ccnxManifestBuilder_Release(&builder);
+    }
+    ccnxName_Release(&rootName);
+    parcBuffer_Release(&data);
+}
+
+LONGBOW_TEST_CASE(Performance, ccnxManifestBuilder_SignEveryChunk_SignRoot)
+{
+    PARCSigner *signer = _createRsaSigner();
+
+    _benchmarkPublish(signer, 2000, false);
+    _benchmarkPublish(signer, 2000, true);
+
+    parcSigner_Release(&signer);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(ccnx_ManifestBuilder);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
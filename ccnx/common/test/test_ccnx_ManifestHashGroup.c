@@ -62,6 +62,7 @@
 #include "../ccnx_ManifestHashGroup.c"
 
 #include <inttypes.h>
+#include <pthread.h>
 #include <ccnx/common/ccnx_Manifest.h>
 
 #include <ccnx/common/ccnx_Name.h>
@@ -98,8 +99,13 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxManifestHashGroup_AcquireRelease);
     LONGBOW_RUN_TEST_CASE(Global, ccnxManifestHashGroup_Create);
     LONGBOW_RUN_TEST_CASE(Global, ccnxManifestHashGroup_CreateFromJson);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestHashGroup_Copy);
     LONGBOW_RUN_TEST_CASE(Global, ccnxManifestHashGroup_AppendGetPointer);
     LONGBOW_RUN_TEST_CASE(Global, ccnxManifestHashGroup_PrependGetPointer);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestHashGroup_GetPointerAtIndex_Concurrent);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestHashGroup_PrependPointer_Order);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestHashGroup_AppendPointer_DigestTooLong);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestHashGroup_GetPointerBytesAtIndex);
     LONGBOW_RUN_TEST_CASE(Global, ccnxManifestHashGroup_ToString);
     LONGBOW_RUN_TEST_CASE(Global, ccnxManifestHashGroup_ToJson);
     LONGBOW_RUN_TEST_CASE(Global, ccnxManifestHashGroup_IsFull);
@@ -170,6 +176,30 @@ LONGBOW_TEST_CASE(Global, ccnxManifestHashGroup_CreateFromJson)
     ccnxManifestHashGroup_Release(&group);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxManifestHashGroup_Copy)
+{
+    CCNxManifestHashGroup *group = ccnxManifestHashGroup_Create();
+    PARCBuffer *digest = parcBuffer_Flip(parcBuffer_PutUint32(parcBuffer_Allocate(32), 0xCAFE));
+    ccnxManifestHashGroup_AppendPointer(group, CCNxManifestHashGroupPointerType_Data, digest);
+    ccnxManifestHashGroup_AppendPointer(group, CCNxManifestHashGroupPointerType_Manifest, digest);
+    ccnxManifestHashGroup_SetDataSize(group, 100);
+    CCNxName *locator = ccnxName_CreateFromCString("ccnx:/locator");
+    ccnxManifestHashGroup_SetLocator(group, locator);
+
+    CCNxManifestHashGroup *copy = ccnxManifestHashGroup_Copy(group);
+    assertTrue(ccnxManifestHashGroup_Equals(group, copy), "Expected the copy to equal the original");
+
+    ccnxManifestHashGroup_AppendPointer(group, CCNxManifestHashGroupPointerType_Data, digest);
+    assertTrue(ccnxManifestHashGroup_GetNumberOfPointers(copy) == 2,
+               "Expected the copy to keep 2 pointers, got %zu", ccnxManifestHashGroup_GetNumberOfPointers(copy));
+    assertFalse(ccnxManifestHashGroup_Equals(group, copy), "Expected the copy not to change with the original");
+
+    ccnxName_Release(&locator);
+    parcBuffer_Release(&digest);
+    ccnxManifestHashGroup_Release(&copy);
+    ccnxManifestHashGroup_Release(&group);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxManifestHashGroup_AppendGetPointer)
 {
     CCNxManifestHashGroup *group = ccnxManifestHashGroup_Create();
@@ -194,6 +224,53 @@ LONGBOW_TEST_CASE(Global, ccnxManifestHashGroup_AppendGetPointer)
     ccnxManifestHashGroup_Release(&group);
 }
 
+#define _concurrentPointers 64
+
+typedef struct {
+    const CCNxManifestHashGroup *group;
+    CCNxManifestHashGroupPointer *pointers[_concurrentPointers];
+} _ConcurrentReader;
+
+static void *
+_readPointers(void *arg)
+{
+    _ConcurrentReader *reader = arg;
+    for (size_t i = 0; i < _concurrentPointers; i++) {
+        reader->pointers[i] = ccnxManifestHashGroup_GetPointerAtIndex(reader->group, i);
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestHashGroup_GetPointerAtIndex_Concurrent)
+{
+    CCNxManifestHashGroup *group = ccnxManifestHashGroup_Create();
+    for (size_t i = 0; i < _concurrentPointers; i++) {
+        PARCBuffer *digest = parcBuffer_Flip(parcBuffer_PutUint64(parcBuffer_Allocate(32), i));
+        ccnxManifestHashGroup_AppendPointer(group, CCNxManifestHashGroupPointerType_Data, digest);
+        parcBuffer_Release(&digest);
+    }
+
+    // Every reader must get the same cached pointer, and the losers' pointers must not leak
+    const int threadCount = 4;
+    _ConcurrentReader readers[threadCount];
+    pthread_t threads[threadCount];
+    for (int t = 0; t < threadCount; t++) {
+        readers[t].group = group;
+        pthread_create(&threads[t], NULL, _readPointers, &readers[t]);
+    }
+    for (int t = 0; t < threadCount; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    for (size_t i = 0; i < _concurrentPointers; i++) {
+        for (int t = 1; t < threadCount; t++) {
+            assertTrue(readers[t].pointers[i] == readers[0].pointers[i], "Reader %d got a different pointer at index %zu", t, i);
+        }
+    }
+
+    ccnxManifestHashGroup_Release(&group);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxManifestHashGroup_PrependGetPointer)
 {
     CCNxManifestHashGroup *group = ccnxManifestHashGroup_Create();
@@ -218,6 +295,85 @@ LONGBOW_TEST_CASE(Global, ccnxManifestHashGroup_PrependGetPointer)
     ccnxManifestHashGroup_Release(&group);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxManifestHashGroup_PrependPointer_Order)
+{
+    CCNxManifestHashGroup *group = ccnxManifestHashGroup_Create();
+
+    // Enough pointers to grow the digest table more than once, alternating the pointer types.
+    size_t count = 100;
+    for (size_t i = 0; i < count; i++) {
+        PARCBuffer *buffer = parcBuffer_Flip(parcBuffer_PutUint32(parcBuffer_Allocate(4), i));
+        CCNxManifestHashGroupPointerType type = (i % 3 == 0) ? CCNxManifestHashGroupPointerType_Manifest : CCNxManifestHashGroupPointerType_Data;
+        assertTrue(ccnxManifestHashGroup_PrependPointer(group, type, buffer), "Expected the insertion to succeed");
+        parcBuffer_Release(&buffer);
+    }
+
+    for (size_t index = 0; index < count; index++) {
+        size_t i = count - 1 - index;
+        CCNxManifestHashGroupPointerType expectedType = (i % 3 == 0) ? CCNxManifestHashGroupPointerType_Manifest : CCNxManifestHashGroupPointerType_Data;
+        CCNxManifestHashGroupPointerType actualType = ccnxManifestHashGroup_GetPointerTypeAtIndex(group, index);
+        assertTrue(expectedType == actualType, "Expected type %d at index %zu, got %d", expectedType, index, actualType);
+
+        CCNxManifestHashGroupPointer *ptr = ccnxManifestHashGroup_GetPointerAtIndex(group, index);
+        uint32_t actual = parcBuffer_GetUint32((PARCBuffer *) ccnxManifestHashGroupPointer_GetDigest(ptr));
+        assertTrue(actual == i, "Expected digest %zu at index %zu, got %u", i, index, actual);
+    }
+
+    ccnxManifestHashGroup_Release(&group);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestHashGroup_AppendPointer_DigestTooLong)
+{
+    CCNxManifestHashGroup *group = ccnxManifestHashGroup_Create();
+
+    PARCBuffer *buffer = parcBuffer_Allocate(CCNxManifestHashGroup_MaxDigestLength + 1);
+    assertFalse(ccnxManifestHashGroup_AppendPointer(group, CCNxManifestHashGroupPointerType_Data, buffer),
+                "Expected a digest longer than %d bytes to be rejected", CCNxManifestHashGroup_MaxDigestLength);
+    assertFalse(ccnxManifestHashGroup_PrependPointer(group, CCNxManifestHashGroupPointerType_Data, buffer),
+                "Expected a digest longer than %d bytes to be rejected", CCNxManifestHashGroup_MaxDigestLength);
+    parcBuffer_Release(&buffer);
+
+    size_t actual = ccnxManifestHashGroup_GetNumberOfPointers(group);
+    assertTrue(actual == 0, "Expected no pointers, got %zu", actual);
+
+    ccnxManifestHashGroup_Release(&group);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestHashGroup_GetPointerBytesAtIndex)
+{
+    CCNxManifestHashGroup *group = ccnxManifestHashGroup_Create();
+
+    uint8_t digest1[CCNxManifestHashGroup_MaxDigestLength];
+    uint8_t digest2[16];
+    memset(digest1, 0xA5, sizeof(digest1));
+    memset(digest2, 0x5A, sizeof(digest2));
+
+    PARCBuffer *buffer1 = parcBuffer_Wrap(digest1, sizeof(digest1), 0, sizeof(digest1));
+    PARCBuffer *buffer2 = parcBuffer_Wrap(digest2, sizeof(digest2), 0, sizeof(digest2));
+    ccnxManifestHashGroup_AppendPointer(group, CCNxManifestHashGroupPointerType_Data, buffer1);
+    ccnxManifestHashGroup_AppendPointer(group, CCNxManifestHashGroupPointerType_Manifest, buffer2);
+    parcBuffer_Release(&buffer1);
+    parcBuffer_Release(&buffer2);
+
+    CCNxManifestHashGroupPointerType type;
+    const uint8_t *digest;
+    size_t length;
+
+    assertTrue(ccnxManifestHashGroup_GetPointerBytesAtIndex(group, 0, &type, &digest, &length), "Expected the first pointer");
+    assertTrue(type == CCNxManifestHashGroupPointerType_Data, "Expected a data pointer, got %d", type);
+    assertTrue(length == sizeof(digest1), "Expected length %zu, got %zu", sizeof(digest1), length);
+    assertTrue(memcmp(digest, digest1, length) == 0, "Expected the first digest");
+
+    assertTrue(ccnxManifestHashGroup_GetPointerBytesAtIndex(group, 1, &type, &digest, &length), "Expected the second pointer");
+    assertTrue(type == CCNxManifestHashGroupPointerType_Manifest, "Expected a manifest pointer, got %d", type);
+    assertTrue(length == sizeof(digest2), "Expected length %zu, got %zu", sizeof(digest2), length);
+    assertTrue(memcmp(digest, digest2, length) == 0, "Expected the second digest");
+
+    assertFalse(ccnxManifestHashGroup_GetPointerBytesAtIndex(group, 2, &type, &digest, &length), "Expected no pointer past the end");
+
+    ccnxManifestHashGroup_Release(&group);
+}
+
 static CCNxManifestHashGroup *
 _createHashGroup(CCNxName *locator, size_t n, size_t blockSize, size_t dataSize, size_t entrySize, size_t treeHeight)
 {
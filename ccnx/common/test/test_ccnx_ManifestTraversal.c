@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+#include <LongBow/unit-test.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_Buffer.h>
+
+#include <ccnx/common/ccnx_ManifestBuilder.h>
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../ccnx_ManifestTraversal.c"
+
+#define _MaxManifests 64
+
+/*
+ * The manifests of a tree made by a CCNxManifestBuilder, which stand in for the network.
+ */
+typedef struct {
+    size_t count;
+    PARCBuffer *digests[_MaxManifests];
+    CCNxManifest *manifests[_MaxManifests];
+    CCNxManifest *root;
+} _ManifestStore;
+
+static void
+_storeManifest(CCNxManifest *manifest, const PARCBuffer *digest, bool isRoot, void *context)
+{
+    _ManifestStore *store = context;
+    assertTrue(store->count < _MaxManifests, "Too many manifests for the test store");
+
+    store->digests[store->count] = parcBuffer_Copy(digest);
+    store->manifests[store->count] = ccnxManifest_Acquire(manifest);
+    store->count++;
+    if (isRoot) {
+        store->root = manifest;
+    }
+}
+
+static void
+_buildTree(_ManifestStore *store, const CCNxName *name, size_t fanout, size_t chunks)
+{
+    memset(store, 0, sizeof(*store));
+
+    CCNxManifestBuilder *builder = ccnxManifestBuilder_Create(name, fanout, 0, _storeManifest, store);
+    for (size_t i = 0; i < chunks; i++) {
+        PARCBuffer *digest = parcBuffer_Flip(parcBuffer_PutUint32(parcBuffer_Allocate(32), (uint32_t) i));
+        ccnxManifestBuilder_AppendDigest(builder, digest, 1);
+        parcBuffer_Release(&digest);
+    }
+    ccnxManifestBuilder_Finish(builder);
+    ccnxManifestBuilder_Release(&builder);
+}
+
+static void
+_releaseTree(_ManifestStore *store)
+{
+    for (size_t i = 0; i < store->count; i++) {
+        parcBuffer_Release(&store->digests[i]);
+        ccnxManifest_Release(&store->manifests[i]);
+    }
+}
+
+static size_t
+_findManifestIndex(const _ManifestStore *store, size_t length, const uint8_t digest[length])
+{
+    for (size_t i = 0; i < store->count; i++) {
+        if (parcBuffer_Remaining(store->digests[i]) == length && memcmp(parcBuffer_Overlay(store->digests[i], 0), digest, length) == 0) {
+            return i;
+        }
+    }
+    return store->count;
+}
+
+static const CCNxManifest *
+_findManifest(const _ManifestStore *store, size_t length, const uint8_t digest[length])
+{
+    size_t index = _findManifestIndex(store, length, digest);
+    return (index < store->count) ? store->manifests[index] : NULL;
+}
+
+/*
+ * Append the store indices of the manifests under `manifest` in depth-first order.
+ */
+static void
+_preorder(const _ManifestStore *store, const CCNxManifest *manifest, size_t *count, size_t order[_MaxManifests])
+{
+    for (size_t g = 0; g < ccnxManifest_GetNumberOfHashGroups(manifest); g++) {
+        CCNxManifestHashGroup *group = ccnxManifest_GetHashGroupByIndex(manifest, g);
+
+        CCNxManifestHashGroupPointerType type;
+        const uint8_t *digest;
+        size_t digestLength;
+        for (size_t i = 0; ccnxManifestHashGroup_GetPointerBytesAtIndex(group, i, &type, &digest, &digestLength); i++) {
+            if (type == CCNxManifestHashGroupPointerType_Manifest) {
+                size_t index = _findManifestIndex(store, digestLength, digest);
+                assertTrue(index < store->count, "Expected the tree to point to a stored manifest");
+                order[(*count)++] = index;
+                _preorder(store, store->manifests[index], count, order);
+            }
+        }
+
+        ccnxManifestHashGroup_Release(&group);
+    }
+}
+
+/*
+ * Run the traversal to the end, answering the oldest manifest request whenever it waits.
+ * Check that the data pointers come out in order and return how many there were.
+ * If `requestOrder` is not NULL, it is set to the store indices of the manifests in the order they were requested.
+ */
+static size_t
+_traverse(const _ManifestStore *store, CCNxManifestTraversal *traversal, size_t prefetchDepth, size_t requestOrder[_MaxManifests])
+{
+    size_t requestCount = 0;
+    PARCBuffer *pending[_MaxManifests];
+    size_t pendingHead = 0;
+    size_t pendingTail = 0;
+    size_t dataCount = 0;
+
+    CCNxManifestTraversalEntry entry;
+    CCNxManifestTraversalStatus status;
+    while ((status = ccnxManifestTraversal_Next(traversal, &entry)) != CCNxManifestTraversalStatus_Done) {
+        assertTrue(ccnxManifestTraversal_GetOutstanding(traversal) <= prefetchDepth, "Expected at most %zu outstanding manifests", prefetchDepth);
+        assertTrue(traversal->requested <= prefetchDepth, "Expected at most %zu manifests held ahead of the walk, got %zu",
+                   prefetchDepth, traversal->requested);
+
+        if (status == CCNxManifestTraversalStatus_Waiting) {
+            assertTrue(pendingHead < pendingTail, "Expected the traversal to wait only for a requested manifest");
+            PARCBuffer *digest = pending[pendingHead++];
+            const CCNxManifest *manifest = _findManifest(store, parcBuffer_Remaining(digest), parcBuffer_Overlay(digest, 0));
+            assertNotNull(manifest, "Expected the traversal to request a manifest of the tree");
+            assertTrue(ccnxManifestTraversal_AddManifest(traversal, digest, manifest), "Expected the manifest to be accepted");
+            parcBuffer_Release(&digest);
+        } else if (entry.type == CCNxManifestHashGroupPointerType_Manifest) {
+            pending[pendingTail++] = parcBuffer_Flip(parcBuffer_CreateFromArray(entry.digest, entry.digestLength));
+            if (requestOrder != NULL) {
+                requestOrder[requestCount++] = _findManifestIndex(store, entry.digestLength, entry.digest);
+            }
+        } else {
+            assertTrue(entry.digestLength == 32, "Expected a 32 byte data digest, got %zu", entry.digestLength);
+            uint32_t index = ((uint32_t) entry.digest[0] << 24) | ((uint32_t) entry.digest[1] << 16) | ((uint32_t) entry.digest[2] << 8) | entry.digest[3];
+            assertTrue(index == dataCount, "Expected data pointer %zu, got %u", dataCount, index);
+            dataCount++;
+        }
+    }
+
+    assertTrue(pendingHead == pendingTail, "Expected every requested manifest to be used");
+    return dataCount;
+}
+
+LONGBOW_TEST_RUNNER(ccnx_ManifestTraversal)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+LONGBOW_TEST_RUNNER_SETUP(ccnx_ManifestTraversal)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_RUNNER_TEARDOWN(ccnx_ManifestTraversal)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestTraversal_AcquireRelease);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestTraversal_Next_SingleManifest);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestTraversal_Next_Tree);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestTraversal_Next_PrefetchDepth);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestTraversal_Next_WalkOrder);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestTraversal_NextInterest);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxManifestTraversal_AddManifest_Unrequested);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    if (parcSafeMemory_ReportAllocation(STDOUT_FILENO) != 0) {
+        printf("('%s' leaks memory by %d (allocs - frees)) ", longBowTestCase_GetName(testCase), parcMemory_Outstanding());
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestTraversal_AcquireRelease)
+{
+    _ManifestStore store;
+    _buildTree(&store, NULL, 4, 3);
+
+    CCNxManifestTraversal *traversal = ccnxManifestTraversal_Create(store.root, NULL, 1);
+    assertNotNull(traversal, "Expected non-null result from ccnxManifestTraversal_Create");
+
+    CCNxManifestTraversal *reference = ccnxManifestTraversal_Acquire(traversal);
+    assertTrue(reference == traversal, "Expected ccnxManifestTraversal_Acquire to return the same instance");
+    ccnxManifestTraversal_Release(&reference);
+    ccnxManifestTraversal_Release(&traversal);
+    assertNull(traversal, "Expected ccnxManifestTraversal_Release to null the pointer");
+
+    _releaseTree(&store);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestTraversal_Next_SingleManifest)
+{
+    _ManifestStore store;
+    _buildTree(&store, NULL, 4, 3);
+
+    CCNxName *locator = ccnxName_CreateFromCString("lci:/object");
+    CCNxManifestTraversal *traversal = ccnxManifestTraversal_Create(store.root, locator, 1);
+
+    CCNxManifestTraversalEntry entry;
+    for (size_t i = 0; i < 3; i++) {
+        CCNxManifestTraversalStatus status = ccnxManifestTraversal_Next(traversal, &entry);
+        assertTrue(status == CCNxManifestTraversalStatus_Entry, "Expected pointer %zu, got status %d", i, status);
+        assertTrue(entry.type == CCNxManifestHashGroupPointerType_Data, "Expected a data pointer");
+        assertTrue(ccnxName_Equals(entry.name, locator), "Expected the locator of the root");
+    }
+    assertTrue(ccnxManifestTraversal_Next(traversal, &entry) == CCNxManifestTraversalStatus_Done, "Expected the traversal to be done");
+    assertTrue(ccnxManifestTraversal_Next(traversal, &entry) == CCNxManifestTraversalStatus_Done, "Expected the traversal to stay done");
+
+    ccnxManifestTraversal_Release(&traversal);
+    ccnxName_Release(&locator);
+    _releaseTree(&store);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestTraversal_Next_Tree)
+{
+    _ManifestStore store;
+    _buildTree(&store, NULL, 3, 40);
+
+    CCNxManifestTraversal *traversal = ccnxManifestTraversal_Create(store.root, NULL, 4);
+    size_t dataCount = _traverse(&store, traversal, 4, NULL);
+    assertTrue(dataCount == 40, "Expected 40 data pointers, got %zu", dataCount);
+    assertTrue(ccnxManifestTraversal_GetOutstanding(traversal) == 0, "Expected no outstanding manifests");
+
+    ccnxManifestTraversal_Release(&traversal);
+    _releaseTree(&store);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestTraversal_Next_PrefetchDepth)
+{
+    _ManifestStore store;
+    _buildTree(&store, NULL, 2, 17);
+
+    for (size_t depth = 1; depth <= 5; depth++) {
+        CCNxManifestTraversal *traversal = ccnxManifestTraversal_Create(store.root, NULL, depth);
+        size_t dataCount = _traverse(&store, traversal, depth, NULL);
+        assertTrue(dataCount == 17, "Expected 17 data pointers with depth %zu, got %zu", depth, dataCount);
+        ccnxManifestTraversal_Release(&traversal);
+    }
+
+    _releaseTree(&store);
+}
+
+/*
+ * With a prefetch depth of 1 each manifest is requested just as the walk needs it, so the requests
+ * follow the depth-first walk rather than the levels of the tree.
+ */
+LONGBOW_TEST_CASE(Global, ccnxManifestTraversal_Next_WalkOrder)
+{
+    _ManifestStore store;
+    _buildTree(&store, NULL, 2, 17);
+
+    size_t expected[_MaxManifests];
+    size_t expectedCount = 0;
+    _preorder(&store, store.root, &expectedCount, expected);
+
+    size_t requestOrder[_MaxManifests];
+    CCNxManifestTraversal *traversal = ccnxManifestTraversal_Create(store.root, NULL, 1);
+    size_t dataCount = _traverse(&store, traversal, 1, requestOrder);
+    assertTrue(dataCount == 17, "Expected 17 data pointers, got %zu", dataCount);
+
+    for (size_t i = 0; i < expectedCount; i++) {
+        assertTrue(requestOrder[i] == expected[i], "Request %zu: expected manifest %zu, got %zu", i, expected[i], requestOrder[i]);
+    }
+
+    ccnxManifestTraversal_Release(&traversal);
+    _releaseTree(&store);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestTraversal_NextInterest)
+{
+    CCNxName *name = ccnxName_CreateFromCString("lci:/object");
+
+    _ManifestStore store;
+    _buildTree(&store, name, 2, 3);
+
+    CCNxManifestTraversal *traversal = ccnxManifestTraversal_Create(store.root, NULL, 2);
+
+    size_t dataCount = 0;
+    CCNxManifestTraversalEntry entry;
+    CCNxInterest *interest;
+    CCNxManifestTraversalStatus status;
+    while ((status = ccnxManifestTraversal_NextInterest(traversal, &entry, &interest)) == CCNxManifestTraversalStatus_Entry) {
+        assertNotNull(interest, "Expected an Interest for a named tree");
+        assertTrue(ccnxName_Equals(ccnxInterest_GetName(interest), name), "Expected the Interest to use the name of the root");
+        assertNotNull(ccnxWireFormatMessage_GetIoVec(interest), "Expected the Interest to be encoded");
+
+        PARCBuffer *restriction = ccnxInterest_GetContentObjectHashRestriction(interest);
+        assertTrue(parcBuffer_Remaining(restriction) == entry.digestLength
+                   && memcmp(parcBuffer_Overlay(restriction, 0), entry.digest, entry.digestLength) == 0,
+                   "Expected the Interest to be restricted to the digest of the pointer");
+
+        if (entry.type == CCNxManifestHashGroupPointerType_Manifest) {
+            const CCNxManifest *manifest = _findManifest(&store, entry.digestLength, entry.digest);
+            assertTrue(ccnxManifestTraversal_AddManifest(traversal, restriction, manifest), "Expected the manifest to be accepted");
+        } else {
+            dataCount++;
+        }
+        ccnxInterest_Release(&interest);
+    }
+    assertTrue(status == CCNxManifestTraversalStatus_Done, "Expected the traversal to finish, got status %d", status);
+    assertTrue(dataCount == 3, "Expected 3 data Interests, got %zu", dataCount);
+
+    ccnxManifestTraversal_Release(&traversal);
+    _releaseTree(&store);
+    ccnxName_Release(&name);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxManifestTraversal_AddManifest_Unrequested)
+{
+    _ManifestStore store;
+    _buildTree(&store, NULL, 2, 5);
+
+    CCNxManifestTraversal *traversal = ccnxManifestTraversal_Create(store.root, NULL, 1);
+
+    // Nothing has been requested yet, so even a manifest of the tree is not accepted.
+    assertFalse(ccnxManifestTraversal_AddManifest(traversal, store.digests[0], store.manifests[0]), "Expected an unrequested manifest to be refused");
+    assertTrue(ccnxManifestTraversal_GetOutstanding(traversal) == 0, "Expected no outstanding manifests");
+
+    ccnxManifestTraversal_Release(&traversal);
+    _releaseTree(&store);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(ccnx_ManifestTraversal);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -63,6 +63,7 @@
 
 #include <stdio.h>
 #include <limits.h>
+#include <sys/time.h>
 
 #include <parc/algol/parc_SafeMemory.h>
 
@@ -93,6 +94,7 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_CreateFromCString_NoScheme);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_CreateFromCString_ZeroComponents);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_CreateFromBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxName_GetSegmentTypeValueArray);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_IsValid_True);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_IsValid_False);
@@ -101,6 +103,9 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_HashCode);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_LeftMostHashCode);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_HashCode_LeftMostHashCode);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxName_LeftMostHashCode_SegmentHashCode);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxName_LeftMostHashCode_Cached);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxName_LeftMostHashCode_TrimAppend);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_ToString);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_ToString_Root);
@@ -112,6 +117,7 @@ LONGBOW_TEST_FIXTURE(Global)
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_Trim);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_Trim_MAXINT);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxName_Trim_Append);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_StartsWith_True);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_StartsWith_FalseShorterPrefix);
     LONGBOW_RUN_TEST_CASE(Global, ccnxName_StartsWith_FalseLongerPrefix);
@@ -260,6 +266,24 @@ LONGBOW_TEST_CASE(Global, ccnxName_Trim_MAXINT)
     ccnxName_Release(&name);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxName_Trim_Append)
+{
+    CCNxName *name = ccnxName_CreateFromCString("ccnx:/a/bb/ccc");
+    CCNxName *expected = ccnxName_CreateFromCString("ccnx:/a/dddd");
+
+    ccnxName_Trim(name, 2);
+
+    CCNxNameSegment *segment = ccnxNameSegment_CreateTypeValueArray(CCNxNameLabelType_NAME, 4, "dddd");
+    ccnxName_Append(name, segment);
+    ccnxNameSegment_Release(&segment);
+
+    assertTrue(ccnxName_Equals(expected, name), "Expected the trimmed and appended name to equal the expected name.");
+    assertTrue(ccnxName_HashCode(expected) == ccnxName_HashCode(name), "Expected equal hash codes.");
+
+    ccnxName_Release(&expected);
+    ccnxName_Release(&name);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxName_Copy_Zero)
 {
     const char *uri = "ccnx:/"; // A Name with 1 zero-length segment
@@ -361,6 +385,68 @@ LONGBOW_TEST_CASE(Global, ccnxName_LeftMostHashCode)
     ccnxName_Release(&nameB);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxName_LeftMostHashCode_SegmentHashCode)
+{
+    CCNxName *name = ccnxName_CreateFromCString("lci:/a/b/c/d/e/");
+    CCNxName *copy = ccnxName_Copy(name);
+
+    // The hash code of a name is the same whether or not its segments have been created.
+    PARCHashCode expected = 0;
+    for (size_t i = 0; i < ccnxName_GetSegmentCount(name); i++) {
+        expected = parcHashCode_HashHashCode(expected, ccnxNameSegment_HashCode(ccnxName_GetSegment(name, i)));
+
+        PARCHashCode actual = ccnxName_LeftMostHashCode(copy, i + 1);
+        assertTrue(expected == actual, "Expected %" PRIPARCHashCode " == %" PRIPARCHashCode, expected, actual);
+    }
+
+    ccnxName_Release(&copy);
+    ccnxName_Release(&name);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxName_LeftMostHashCode_Cached)
+{
+    CCNxName *name = ccnxName_CreateFromCString("lci:/a/b/c/d/e/");
+    assertTrue(name->hashedSegmentCount == 0, "Expected no prefix hash codes before the first request");
+
+    PARCHashCode hashCode = ccnxName_LeftMostHashCode(name, 2);
+    assertTrue(name->hashedSegmentCount == ccnxName_GetSegmentCount(name),
+               "Expected every prefix hash code to be computed, got %zu", name->hashedSegmentCount);
+
+    CCNxName *prefix = ccnxName_CreatePrefix(name, 2);
+    assertTrue(prefix->hashedSegmentCount == 2, "Expected the prefix to keep its hash codes, got %zu", prefix->hashedSegmentCount);
+    assertTrue(ccnxName_HashCode(prefix) == hashCode, "Expected the prefix hash code to equal the leftmost hash code");
+
+    ccnxName_Release(&prefix);
+    ccnxName_Release(&name);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxName_LeftMostHashCode_TrimAppend)
+{
+    CCNxName *name = ccnxName_CreateFromCString("lci:/a/b/c/d");
+    CCNxName *expected = ccnxName_CreateFromCString("lci:/a/b/x/y/z");
+
+    (void) ccnxName_HashCode(name);
+
+    ccnxName_Trim(name, 2);
+    assertTrue(name->hashedSegmentCount == 2, "Expected Trim to discard the removed hash codes, got %zu", name->hashedSegmentCount);
+
+    CCNxName *suffix = ccnxName_CreateFromCString("lci:/x/y/z");
+    for (size_t i = 0; i < ccnxName_GetSegmentCount(suffix); i++) {
+        ccnxName_Append(name, ccnxName_GetSegment(suffix, i));
+    }
+    ccnxName_Release(&suffix);
+
+    for (size_t count = 0; count <= ccnxName_GetSegmentCount(expected); count++) {
+        PARCHashCode expectedHashCode = ccnxName_LeftMostHashCode(expected, count);
+        PARCHashCode actualHashCode = ccnxName_LeftMostHashCode(name, count);
+        assertTrue(expectedHashCode == actualHashCode, "Count %zu expected %" PRIPARCHashCode " actual %" PRIPARCHashCode,
+                   count, expectedHashCode, actualHashCode);
+    }
+
+    ccnxName_Release(&expected);
+    ccnxName_Release(&name);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxName_CreateAndDestroy)
 {
     CCNxName *name = ccnxName_Create();
@@ -451,6 +537,26 @@ LONGBOW_TEST_CASE(Global, ccnxName_CreateFromBuffer)
     parcBuffer_Release(&buffer);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxName_GetSegmentTypeValueArray)
+{
+    CCNxName *name = ccnxName_CreateFromCString("lci:/parc/Chunk=0x0102");
+
+    for (size_t i = 0; i < ccnxName_GetSegmentCount(name); i++) {
+        CCNxNameLabelType type;
+        size_t length;
+        const uint8_t *value = ccnxName_GetSegmentTypeValueArray(name, i, &type, &length);
+
+        CCNxNameSegment *segment = ccnxName_GetSegment(name, i);
+        PARCBuffer *expected = ccnxNameSegment_GetValue(segment);
+
+        assertTrue(type == ccnxNameSegment_GetType(segment), "Expected type %d, actual %d", ccnxNameSegment_GetType(segment), type);
+        assertTrue(length == parcBuffer_Remaining(expected), "Expected length %zu, actual %zu", parcBuffer_Remaining(expected), length);
+        assertTrue(memcmp(value, parcBuffer_Overlay(expected, 0), length) == 0, "Segment %zu values differ", i);
+    }
+
+    ccnxName_Release(&name);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxName_ToString_LCI)
 {
     const char *lci = "lci:/a/b";
@@ -733,6 +839,9 @@ LONGBOW_TEST_CASE(Specialization, ccnxName_Prefix_0)
 LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
 {
     LONGBOW_RUN_TEST_CASE(Performance, ccnxName_Create);
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxName_Compare);
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxName_HashCode);
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxName_LeftMostHashCode_AllPrefixes);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Performance)
@@ -766,6 +875,98 @@ LONGBOW_TEST_CASE(Performance, ccnxName_Create)
     parcBuffer_Release(&value);
 }
 
+static CCNxName *
+_createNameWithSegments(size_t segmentCount)
+{
+    CCNxName *result = ccnxName_Create();
+
+    for (size_t i = 0; i < segmentCount; i++) {
+        char value[16];
+        int length = snprintf(value, sizeof(value), "segment%zu", i);
+        CCNxNameSegment *segment = ccnxNameSegment_CreateTypeValueArray(CCNxNameLabelType_NAME, length, value);
+        ccnxName_Append(result, segment);
+        ccnxNameSegment_Release(&segment);
+    }
+
+    return result;
+}
+
+LONGBOW_TEST_CASE(Performance, ccnxName_Compare)
+{
+    unsigned trials = 1000000;
+
+    for (size_t segmentCount = 2; segmentCount <= 32; segmentCount *= 2) {
+        CCNxName *a = _createNameWithSegments(segmentCount);
+        CCNxName *b = _createNameWithSegments(segmentCount);
+
+        struct timeval t0, t1;
+        int sum = 0;
+        gettimeofday(&t0, NULL);
+        for (unsigned i = 0; i < trials; i++) {
+            sum += ccnxName_Compare(a, b);
+        }
+        gettimeofday(&t1, NULL);
+        timersub(&t1, &t0, &t1);
+        double seconds = t1.tv_sec + t1.tv_usec * 1E-6;
+        printf("\nccnxName_Compare segments %2zu iterations %u seconds %.3f ns/compare %.1f (%d)\n",
+               segmentCount, trials, seconds, seconds * 1E9 / trials, sum);
+
+        ccnxName_Release(&a);
+        ccnxName_Release(&b);
+    }
+}
+
+LONGBOW_TEST_CASE(Performance, ccnxName_HashCode)
+{
+    unsigned trials = 1000000;
+
+    for (size_t segmentCount = 2; segmentCount <= 32; segmentCount *= 2) {
+        CCNxName *name = _createNameWithSegments(segmentCount);
+
+        struct timeval t0, t1;
+        PARCHashCode sum = 0;
+        gettimeofday(&t0, NULL);
+        for (unsigned i = 0; i < trials; i++) {
+            sum += ccnxName_HashCode(name);
+        }
+        gettimeofday(&t1, NULL);
+        timersub(&t1, &t0, &t1);
+        double seconds = t1.tv_sec + t1.tv_usec * 1E-6;
+        printf("\nccnxName_HashCode segments %2zu iterations %u seconds %.3f ns/hash %.1f (%" PRIPARCHashCode ")\n",
+               segmentCount, trials, seconds, seconds * 1E9 / trials, sum);
+
+        ccnxName_Release(&name);
+    }
+}
+
+LONGBOW_TEST_CASE(Performance, ccnxName_LeftMostHashCode_AllPrefixes)
+{
+    unsigned trials = 100000;
+
+    // A longest-prefix match asks for the hash code of every prefix, longest first, of a newly decoded name.
+    for (size_t segmentCount = 2; segmentCount <= 32; segmentCount *= 2) {
+        CCNxName *original = _createNameWithSegments(segmentCount);
+
+        struct timeval t0, t1;
+        PARCHashCode sum = 0;
+        gettimeofday(&t0, NULL);
+        for (unsigned i = 0; i < trials; i++) {
+            CCNxName *name = ccnxName_Copy(original);
+            for (size_t count = segmentCount; count > 0; count--) {
+                sum += ccnxName_LeftMostHashCode(name, count);
+            }
+            ccnxName_Release(&name);
+        }
+        gettimeofday(&t1, NULL);
+        timersub(&t1, &t0, &t1);
+        double seconds = t1.tv_sec + t1.tv_usec * 1E-6;
+        printf("\nccnxName_LeftMostHashCode all prefixes segments %2zu iterations %u seconds %.3f ns/name %.1f (%" PRIPARCHashCode ")\n",
+               segmentCount, trials, seconds, seconds * 1E9 / trials, sum);
+
+        ccnxName_Release(&original);
+    }
+}
+
 int
 main(int argc, char *argv[])
 {
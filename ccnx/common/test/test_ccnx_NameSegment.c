@@ -120,6 +120,7 @@ LONGBOW_TEST_FIXTURE(Global)
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxNameSegment_Equals_Contract);
     LONGBOW_RUN_TEST_CASE(Global, ccnxNameSegment_HashCode);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameSegment_HashCodeTypeValue);
     LONGBOW_RUN_TEST_CASE(Global, ccnxNameSegment_Display);
 
     LONGBOW_RUN_TEST_CASE(Global, ccnxNameSegment_IsValid);
@@ -753,6 +754,20 @@ LONGBOW_TEST_CASE(Global, ccnxNameSegment_HashCode)
     parcBuffer_Release(&bufC);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxNameSegment_HashCodeTypeValue)
+{
+    PARCBuffer *buf = parcBuffer_WrapCString("Test");
+    CCNxNameSegment *segment = ccnxNameSegment_CreateTypeValue(CCNxNameLabelType_NAME, buf);
+
+    PARCHashCode expected = ccnxNameSegment_HashCode(segment);
+    PARCHashCode actual = ccnxNameSegment_HashCodeTypeValue(CCNxNameLabelType_NAME, 4, (const uint8_t *) "Test");
+
+    assertTrue(expected == actual, "Expected %" PRIPARCHashCode " actual %" PRIPARCHashCode, expected, actual);
+
+    ccnxNameSegment_Release(&segment);
+    parcBuffer_Release(&buf);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxNameSegment_Display)
 {
     PARCBuffer *buf = parcBuffer_WrapCString("Test");
@@ -0,0 +1,630 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+#include <sys/time.h>
+#include <LongBow/unit-test.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_Buffer.h>
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../ccnx_NameTrie.c"
+
+/*
+ * Encode the value of the Name TLV of `name` into `buffer`, and return its length.
+ */
+static size_t
+_encodeName(const CCNxName *name, size_t capacity, uint8_t buffer[capacity])
+{
+    size_t length = 0;
+
+    for (size_t i = 0; i < ccnxName_GetSegmentCount(name); i++) {
+        CCNxNameLabelType type;
+        size_t segmentLength;
+        const uint8_t *value = ccnxName_GetSegmentTypeValueArray(name, i, &type, &segmentLength);
+
+        assertTrue(length + 4 + segmentLength <= capacity, "Name too long for the buffer");
+        buffer[length++] = (uint8_t) (type >> 8);
+        buffer[length++] = (uint8_t) type;
+        buffer[length++] = (uint8_t) (segmentLength >> 8);
+        buffer[length++] = (uint8_t) segmentLength;
+        memcpy(&buffer[length], value, segmentLength);
+        length += segmentLength;
+    }
+
+    return length;
+}
+
+static void
+_put(CCNxNameTrie *trie, const char *uri, const char *value)
+{
+    CCNxName *name = ccnxName_CreateFromCString(uri);
+    PARCBuffer *buffer = parcBuffer_WrapCString((char *) value);
+    ccnxNameTrie_Put(trie, name, buffer);
+    parcBuffer_Release(&buffer);
+    ccnxName_Release(&name);
+}
+
+static void
+_assertValue(const PARCObject *actual, const char *expected)
+{
+    if (expected == NULL) {
+        assertNull(actual, "Expected no value");
+    } else {
+        PARCBuffer *buffer = parcBuffer_WrapCString((char *) expected);
+        assertTrue(parcBuffer_Equals(buffer, actual), "Expected the value '%s'", expected);
+        parcBuffer_Release(&buffer);
+    }
+}
+
+LONGBOW_TEST_RUNNER(ccnx_NameTrie)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+LONGBOW_TEST_RUNNER_SETUP(ccnx_NameTrie)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_RUNNER_TEARDOWN(ccnx_NameTrie)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameTrie_AcquireRelease);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameTrie_Put_Get);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameTrie_Put_Replace);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameTrie_Get_Missing);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameTrie_Get_SegmentType);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameTrie_GetView);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameTrie_Remove);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameTrie_Remove_KeepsLongerNames);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameTrie_LongestPrefixMatch);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameTrie_LongestPrefixMatch_Root);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameTrie_LongestPrefixMatchView);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameTrie_ForEachWithPrefix);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameTrie_ForEachWithPrefix_Stop);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameTrie_ManyNames);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    if (parcSafeMemory_ReportAllocation(STDOUT_FILENO) != 0) {
+        printf("('%s' leaks memory by %d (allocs - frees)) ", longBowTestCase_GetName(testCase), parcMemory_Outstanding());
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameTrie_AcquireRelease)
+{
+    CCNxNameTrie *trie = ccnxNameTrie_Create();
+    assertNotNull(trie, "Expected non-null result from ccnxNameTrie_Create");
+    assertTrue(ccnxNameTrie_Size(trie) == 0, "Expected a new trie to be empty");
+
+    CCNxNameTrie *reference = ccnxNameTrie_Acquire(trie);
+    assertTrue(reference == trie, "Expected ccnxNameTrie_Acquire to return the same instance");
+
+    ccnxNameTrie_Release(&reference);
+    ccnxNameTrie_Release(&trie);
+    assertNull(trie, "Expected ccnxNameTrie_Release to null the pointer");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameTrie_Put_Get)
+{
+    CCNxNameTrie *trie = ccnxNameTrie_Create();
+
+    _put(trie, "lci:/parc/csl", "csl");
+    _put(trie, "lci:/parc/csl/things", "things");
+    _put(trie, "lci:/xerox", "xerox");
+
+    assertTrue(ccnxNameTrie_Size(trie) == 3, "Expected 3 entries, got %zu", ccnxNameTrie_Size(trie));
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/parc/csl/things");
+    _assertValue(ccnxNameTrie_Get(trie, name), "things");
+    ccnxName_Release(&name);
+
+    name = ccnxName_CreateFromCString("lci:/parc/csl");
+    _assertValue(ccnxNameTrie_Get(trie, name), "csl");
+    ccnxName_Release(&name);
+
+    name = ccnxName_CreateFromCString("lci:/xerox");
+    _assertValue(ccnxNameTrie_Get(trie, name), "xerox");
+    ccnxName_Release(&name);
+
+    ccnxNameTrie_Release(&trie);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameTrie_Put_Replace)
+{
+    CCNxNameTrie *trie = ccnxNameTrie_Create();
+    CCNxName *name = ccnxName_CreateFromCString("lci:/parc/csl");
+    PARCBuffer *first = parcBuffer_WrapCString("first");
+    PARCBuffer *second = parcBuffer_WrapCString("second");
+
+    assertTrue(ccnxNameTrie_Put(trie, name, first), "Expected the first Put to add the name");
+    assertFalse(ccnxNameTrie_Put(trie, name, second), "Expected the second Put to replace the value");
+    assertTrue(ccnxNameTrie_Size(trie) == 1, "Expected 1 entry, got %zu", ccnxNameTrie_Size(trie));
+    _assertValue(ccnxNameTrie_Get(trie, name), "second");
+
+    parcBuffer_Release(&first);
+    parcBuffer_Release(&second);
+    ccnxName_Release(&name);
+    ccnxNameTrie_Release(&trie);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameTrie_Get_Missing)
+{
+    CCNxNameTrie *trie = ccnxNameTrie_Create();
+    _put(trie, "lci:/parc/csl/things", "things");
+
+    // A prefix of an entry is a node in the trie, but has no value.
+    CCNxName *name = ccnxName_CreateFromCString("lci:/parc/csl");
+    assertNull(ccnxNameTrie_Get(trie, name), "Expected no value for a prefix of an entry");
+    ccnxName_Release(&name);
+
+    name = ccnxName_CreateFromCString("lci:/parc/csl/things/b00se");
+    assertNull(ccnxNameTrie_Get(trie, name), "Expected no value for an extension of an entry");
+    ccnxName_Release(&name);
+
+    name = ccnxName_CreateFromCString("lci:/xerox");
+    assertNull(ccnxNameTrie_Get(trie, name), "Expected no value for an unrelated name");
+    ccnxName_Release(&name);
+
+    ccnxNameTrie_Release(&trie);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameTrie_Get_SegmentType)
+{
+    CCNxNameTrie *trie = ccnxNameTrie_Create();
+    uint8_t value = 0x01;
+
+    CCNxName *chunk = ccnxName_CreateFromCString("lci:/parc");
+    ccnxName_AppendTypeValueArray(chunk, CCNxNameLabelType_CHUNK, 1, &value);
+    CCNxName *name = ccnxName_CreateFromCString("lci:/parc");
+    ccnxName_AppendTypeValueArray(name, CCNxNameLabelType_NAME, 1, &value);
+
+    PARCBuffer *buffer = parcBuffer_WrapCString("chunk");
+    ccnxNameTrie_Put(trie, chunk, buffer);
+    parcBuffer_Release(&buffer);
+
+    _assertValue(ccnxNameTrie_Get(trie, chunk), "chunk");
+    assertNull(ccnxNameTrie_Get(trie, name), "Expected segments with the same value and different types not to match");
+
+    ccnxName_Release(&chunk);
+    ccnxName_Release(&name);
+    ccnxNameTrie_Release(&trie);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameTrie_GetView)
+{
+    CCNxNameTrie *trie = ccnxNameTrie_Create();
+    _put(trie, "lci:/parc/csl", "csl");
+
+    uint8_t encoded[64];
+    CCNxNameView view;
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/parc/csl");
+    ccnxNameView_Init(&view, _encodeName(name, sizeof(encoded), encoded), encoded);
+    _assertValue(ccnxNameTrie_GetView(trie, &view), "csl");
+    ccnxName_Release(&name);
+
+    name = ccnxName_CreateFromCString("lci:/parc");
+    ccnxNameView_Init(&view, _encodeName(name, sizeof(encoded), encoded), encoded);
+    assertNull(ccnxNameTrie_GetView(trie, &view), "Expected no value for a prefix of an entry");
+    ccnxName_Release(&name);
+
+    ccnxNameTrie_Release(&trie);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameTrie_Remove)
+{
+    CCNxNameTrie *trie = ccnxNameTrie_Create();
+    _put(trie, "lci:/parc/csl/things", "things");
+    _put(trie, "lci:/parc/csl", "csl");
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/parc");
+    assertFalse(ccnxNameTrie_Remove(trie, name), "Expected Remove of a name without a value to fail");
+    ccnxName_Release(&name);
+
+    name = ccnxName_CreateFromCString("lci:/parc/csl/things");
+    assertTrue(ccnxNameTrie_Remove(trie, name), "Expected Remove of an entry to succeed");
+    assertNull(ccnxNameTrie_Get(trie, name), "Expected no value after Remove");
+    assertFalse(ccnxNameTrie_Remove(trie, name), "Expected a second Remove to fail");
+    ccnxName_Release(&name);
+
+    assertTrue(ccnxNameTrie_Size(trie) == 1, "Expected 1 entry, got %zu", ccnxNameTrie_Size(trie));
+    assertTrue(trie->liveNodeCount == 2, "Expected the node of the removed entry to be freed, got %u nodes", trie->liveNodeCount);
+
+    name = ccnxName_CreateFromCString("lci:/parc/csl");
+    assertTrue(ccnxNameTrie_Remove(trie, name), "Expected Remove of an entry to succeed");
+    ccnxName_Release(&name);
+
+    assertTrue(ccnxNameTrie_Size(trie) == 0, "Expected an empty trie, got %zu", ccnxNameTrie_Size(trie));
+    assertTrue(trie->liveNodeCount == 0, "Expected only the root node to remain, got %u other nodes", trie->liveNodeCount);
+
+    ccnxNameTrie_Release(&trie);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameTrie_Remove_KeepsLongerNames)
+{
+    CCNxNameTrie *trie = ccnxNameTrie_Create();
+    _put(trie, "lci:/parc/csl/things", "things");
+    _put(trie, "lci:/parc/csl", "csl");
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/parc/csl");
+    assertTrue(ccnxNameTrie_Remove(trie, name), "Expected Remove of an entry to succeed");
+    ccnxName_Release(&name);
+
+    name = ccnxName_CreateFromCString("lci:/parc/csl/things");
+    _assertValue(ccnxNameTrie_Get(trie, name), "things");
+    ccnxName_Release(&name);
+
+    ccnxNameTrie_Release(&trie);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameTrie_LongestPrefixMatch)
+{
+    CCNxNameTrie *trie = ccnxNameTrie_Create();
+    _put(trie, "lci:/parc", "parc");
+    _put(trie, "lci:/parc/csl/things", "things");
+
+    struct {
+        const char *uri;
+        const char *expected;
+        size_t matchLength;
+    } cases[] = {
+        { "lci:/parc",                    "parc",   1 },
+        { "lci:/parc/csl",                "parc",   1 },
+        { "lci:/parc/csl/things",         "things", 3 },
+        { "lci:/parc/csl/things/b00se/1", "things", 3 },
+        { "lci:/parc/ics/things",         "parc",   1 },
+        { "lci:/xerox/parc",              NULL,     0 },
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        CCNxName *name = ccnxName_CreateFromCString(cases[i].uri);
+        size_t matchLength = SIZE_MAX;
+        PARCObject *actual = ccnxNameTrie_LongestPrefixMatch(trie, name, &matchLength);
+
+        _assertValue(actual, cases[i].expected);
+        if (cases[i].expected != NULL) {
+            assertTrue(matchLength == cases[i].matchLength, "%s: expected a match of %zu segments, got %zu",
+                       cases[i].uri, cases[i].matchLength, matchLength);
+        }
+        ccnxName_Release(&name);
+    }
+
+    ccnxNameTrie_Release(&trie);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameTrie_LongestPrefixMatch_Root)
+{
+    CCNxNameTrie *trie = ccnxNameTrie_Create();
+
+    CCNxName *root = ccnxName_Create();
+    PARCBuffer *buffer = parcBuffer_WrapCString("default");
+    ccnxNameTrie_Put(trie, root, buffer);
+    parcBuffer_Release(&buffer);
+    ccnxName_Release(&root);
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/parc/csl");
+    size_t matchLength = SIZE_MAX;
+    _assertValue(ccnxNameTrie_LongestPrefixMatch(trie, name, &matchLength), "default");
+    assertTrue(matchLength == 0, "Expected a match of 0 segments, got %zu", matchLength);
+    ccnxName_Release(&name);
+
+    ccnxNameTrie_Release(&trie);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameTrie_LongestPrefixMatchView)
+{
+    CCNxNameTrie *trie = ccnxNameTrie_Create();
+    _put(trie, "lci:/parc", "parc");
+    _put(trie, "lci:/parc/csl/things", "things");
+
+    uint8_t encoded[64];
+    CCNxNameView view;
+
+    CCNxName *name = ccnxName_CreateFromCString("lci:/parc/csl/things/b00se");
+    ccnxNameView_Init(&view, _encodeName(name, sizeof(encoded), encoded), encoded);
+
+    size_t matchLength = SIZE_MAX;
+    _assertValue(ccnxNameTrie_LongestPrefixMatchView(trie, &view, &matchLength), "things");
+    assertTrue(matchLength == 3, "Expected a match of 3 segments, got %zu", matchLength);
+    ccnxName_Release(&name);
+
+    name = ccnxName_CreateFromCString("lci:/parc/ics");
+    ccnxNameView_Init(&view, _encodeName(name, sizeof(encoded), encoded), encoded);
+    _assertValue(ccnxNameTrie_LongestPrefixMatchView(trie, &view, NULL), "parc");
+    ccnxName_Release(&name);
+
+    ccnxNameTrie_Release(&trie);
+}
+
+static bool
+_collect(const CCNxName *name, PARCObject *value, void *context)
+{
+    PARCObject *expected = ccnxNameTrie_Get((CCNxNameTrie *) context, name);
+    assertTrue(expected == value, "Expected the visited name to map to the visited value");
+    return true;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameTrie_ForEachWithPrefix)
+{
+    CCNxNameTrie *trie = ccnxNameTrie_Create();
+    _put(trie, "lci:/parc", "parc");
+    _put(trie, "lci:/parc/csl", "csl");
+    _put(trie, "lci:/parc/csl/things", "things");
+    _put(trie, "lci:/parc/csl/stuff", "stuff");
+    _put(trie, "lci:/parc/ics/things", "ics");
+    _put(trie, "lci:/xerox", "xerox");
+
+    CCNxName *prefix = ccnxName_CreateFromCString("lci:/parc/csl");
+    size_t count = ccnxNameTrie_ForEachWithPrefix(trie, prefix, _collect, trie);
+    assertTrue(count == 3, "Expected 3 entries under lci:/parc/csl, got %zu", count);
+    ccnxName_Release(&prefix);
+
+    prefix = ccnxName_CreateFromCString("lci:/parc");
+    count = ccnxNameTrie_ForEachWithPrefix(trie, prefix, _collect, trie);
+    assertTrue(count == 5, "Expected 5 entries under lci:/parc, got %zu", count);
+    ccnxName_Release(&prefix);
+
+    prefix = ccnxName_Create();
+    count = ccnxNameTrie_ForEachWithPrefix(trie, prefix, _collect, trie);
+    assertTrue(count == 6, "Expected 6 entries in all, got %zu", count);
+    ccnxName_Release(&prefix);
+
+    prefix = ccnxName_CreateFromCString("lci:/ibm");
+    count = ccnxNameTrie_ForEachWithPrefix(trie, prefix, _collect, trie);
+    assertTrue(count == 0, "Expected no entries under lci:/ibm, got %zu", count);
+    ccnxName_Release(&prefix);
+
+    ccnxNameTrie_Release(&trie);
+}
+
+static bool
+_stop(const CCNxName *name, PARCObject *value, void *context)
+{
+    return false;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameTrie_ForEachWithPrefix_Stop)
+{
+    CCNxNameTrie *trie = ccnxNameTrie_Create();
+    _put(trie, "lci:/parc/csl", "csl");
+    _put(trie, "lci:/parc/ics", "ics");
+
+    CCNxName *prefix = ccnxName_CreateFromCString("lci:/parc");
+    size_t count = ccnxNameTrie_ForEachWithPrefix(trie, prefix, _stop, NULL);
+    assertTrue(count == 1, "Expected the enumeration to stop after 1 entry, got %zu", count);
+    ccnxName_Release(&prefix);
+
+    ccnxNameTrie_Release(&trie);
+}
+
+static CCNxName *
+_createSyntheticName(unsigned i)
+{
+    char value[32];
+    CCNxName *result = ccnxName_Create();
+
+    int length = snprintf(value, sizeof(value), "site%u", i % 97);
+    ccnxName_AppendTypeValueArray(result, CCNxNameLabelType_NAME, length, (uint8_t *) value);
+    length = snprintf(value, sizeof(value), "dir%u", i % 1009);
+    ccnxName_AppendTypeValueArray(result, CCNxNameLabelType_NAME, length, (uint8_t *) value);
+    length = snprintf(value, sizeof(value), "object%u", i);
+    ccnxName_AppendTypeValueArray(result, CCNxNameLabelType_NAME, length, (uint8_t *) value);
+
+    return result;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameTrie_ManyNames)
+{
+    CCNxNameTrie *trie = ccnxNameTrie_Create();
+    unsigned count = 20000;
+
+    for (unsigned i = 0; i < count; i++) {
+        CCNxName *name = _createSyntheticName(i);
+        ccnxNameTrie_Put(trie, name, name);
+        ccnxName_Release(&name);
+    }
+    assertTrue(ccnxNameTrie_Size(trie) == count, "Expected %u entries, got %zu", count, ccnxNameTrie_Size(trie));
+
+    // Removing names shifts entries back in the hash table.
+    for (unsigned i = 0; i < count; i += 2) {
+        CCNxName *name = _createSyntheticName(i);
+        assertTrue(ccnxNameTrie_Remove(trie, name), "Expected Remove of entry %u to succeed", i);
+        ccnxName_Release(&name);
+    }
+
+    for (unsigned i = 0; i < count; i++) {
+        CCNxName *name = _createSyntheticName(i);
+        PARCObject *value = ccnxNameTrie_Get(trie, name);
+        if (i % 2 == 0) {
+            assertNull(value, "Expected entry %u to be removed", i);
+        } else {
+            assertTrue(ccnxName_Equals(name, value), "Expected entry %u to map to its own name", i);
+        }
+        ccnxName_Release(&name);
+    }
+
+    for (unsigned i = 1; i < count; i += 2) {
+        CCNxName *name = _createSyntheticName(i);
+        assertTrue(ccnxNameTrie_Remove(trie, name), "Expected Remove of entry %u to succeed", i);
+        ccnxName_Release(&name);
+    }
+
+    assertTrue(ccnxNameTrie_Size(trie) == 0, "Expected an empty trie, got %zu", ccnxNameTrie_Size(trie));
+    assertTrue(trie->liveNodeCount == 0, "Expected only the root node to remain, got %u other nodes", trie->liveNodeCount);
+    assertTrue(trie->segmentValuesLength - trie->segmentValuesGarbage == 0, "Expected no live segment values");
+    assertTrue(trie->segmentValuesLength < 2 * _ccnxNameTrie_MinimumGarbage, "Expected the segment values to be compacted");
+
+    ccnxNameTrie_Release(&trie);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxNameTrie_LongestPrefixMatch);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * Load a large synthetic name set, then look up a longer name under every entry, from both a CCNxName and a
+ * wire format CCNxNameView.  The lookups run on one thread, so the rates are per core.
+ */
+LONGBOW_TEST_CASE(Performance, ccnxNameTrie_LongestPrefixMatch)
+{
+    unsigned count = 1000000;
+    uint8_t chunk = 0;
+
+    CCNxNameTrie *trie = ccnxNameTrie_Create();
+    CCNxName **names = parcMemory_Allocate(count * sizeof(CCNxName *));
+
+    struct timeval t0, t1;
+    gettimeofday(&t0, NULL);
+    for (unsigned i = 0; i < count; i++) {
+        CCNxName *name = _createSyntheticName(i);
+        ccnxNameTrie_Put(trie, name, name);
+        names[i] = ccnxName_AppendTypeValueArray(ccnxName_Copy(name), CCNxNameLabelType_CHUNK, 1, &chunk);
+        ccnxName_Release(&name);
+    }
+    gettimeofday(&t1, NULL);
+    timersub(&t1, &t0, &t1);
+    double seconds = t1.tv_sec + t1.tv_usec * 1E-6;
+    printf("\nccnxNameTrie_Put entries %u nodes %u seconds %.3f inserts/second %.0f\n",
+           count, trie->liveNodeCount, seconds, count / seconds);
+
+    size_t matched = 0;
+    gettimeofday(&t0, NULL);
+    for (unsigned i = 0; i < count; i++) {
+        size_t matchLength = 0;
+        ccnxNameTrie_LongestPrefixMatch(trie, names[i], &matchLength);
+        matched += matchLength;
+    }
+    gettimeofday(&t1, NULL);
+    timersub(&t1, &t0, &t1);
+    seconds = t1.tv_sec + t1.tv_usec * 1E-6;
+    printf("ccnxNameTrie_LongestPrefixMatch lookups %u seconds %.3f lookups/second/core %.0f (%zu)\n",
+           count, seconds, count / seconds, matched);
+
+    size_t encodedLength = 64;
+    uint8_t *encoded = parcMemory_Allocate(count * encodedLength);
+    CCNxNameView *views = parcMemory_Allocate(count * sizeof(CCNxNameView));
+    for (unsigned i = 0; i < count; i++) {
+        uint8_t *buffer = &encoded[i * encodedLength];
+        ccnxNameView_Init(&views[i], _encodeName(names[i], encodedLength, buffer), buffer);
+    }
+
+    matched = 0;
+    gettimeofday(&t0, NULL);
+    for (unsigned i = 0; i < count; i++) {
+        size_t matchLength = 0;
+        ccnxNameTrie_LongestPrefixMatchView(trie, &views[i], &matchLength);
+        matched += matchLength;
+    }
+    gettimeofday(&t1, NULL);
+    timersub(&t1, &t0, &t1);
+    seconds = t1.tv_sec + t1.tv_usec * 1E-6;
+    printf("ccnxNameTrie_LongestPrefixMatchView lookups %u seconds %.3f lookups/second/core %.0f (%zu)\n",
+           count, seconds, count / seconds, matched);
+
+    for (unsigned i = 0; i < count; i++) {
+        ccnxName_Release(&names[i]);
+    }
+    parcMemory_Deallocate(&views);
+    parcMemory_Deallocate(&encoded);
+    parcMemory_Deallocate(&names);
+    ccnxNameTrie_Release(&trie);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(ccnx_NameTrie);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
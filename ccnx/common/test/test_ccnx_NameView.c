@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+#include <LongBow/unit-test.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_SafeMemory.h>
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../ccnx_NameView.c"
+
+// lci:/apple/pie/Chunk=%01
+static const uint8_t _applePie[] = {
+    0x00, 0x01, 0x00, 0x05, 'a',  'p',  'p', 'l', 'e',
+    0x00, 0x01, 0x00, 0x03, 'p',  'i',  'e',
+    0x00, 0x10, 0x00, 0x01, 0x01
+};
+
+// lci:/apple
+static const uint8_t _apple[] = {
+    0x00, 0x01, 0x00, 0x05, 'a', 'p', 'p', 'l', 'e'
+};
+
+// lci:/apple/tart
+static const uint8_t _appleTart[] = {
+    0x00, 0x01, 0x00, 0x05, 'a', 'p', 'p', 'l', 'e',
+    0x00, 0x01, 0x00, 0x04, 't', 'a', 'r', 't'
+};
+
+static CCNxName *
+_createApplePieName(void)
+{
+    CCNxName *result = ccnxName_CreateFromCString("lci:/apple/pie");
+    uint8_t chunk = 0x01;
+    ccnxName_AppendTypeValueArray(result, CCNxNameLabelType_CHUNK, 1, &chunk);
+    return result;
+}
+
+LONGBOW_TEST_RUNNER(ccnx_NameView)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+LONGBOW_TEST_RUNNER_SETUP(ccnx_NameView)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_RUNNER_TEARDOWN(ccnx_NameView)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameView_Init);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameView_Init_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameView_Init_ShortHeader);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameView_Init_Overrun);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameView_GetSegment);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameViewIterator_Next);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameView_Equals);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameView_EqualsName);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameView_Compare);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameView_StartsWith);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameView_StartsWithName);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameView_HashCode);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameView_PrefixHashCodes);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxNameView_CreateName);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    if (parcSafeMemory_ReportAllocation(STDOUT_FILENO) != 0) {
+        printf("('%s' leaks memory by %d (allocs - frees)) ", longBowTestCase_GetName(testCase), parcMemory_Outstanding());
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameView_Init)
+{
+    CCNxNameView view;
+    bool success = ccnxNameView_Init(&view, sizeof(_applePie), _applePie);
+
+    assertTrue(success, "Expected a well-formed name to initialise the view");
+    assertTrue(ccnxNameView_GetSegmentCount(&view) == 3, "Expected 3 segments, got %zu", ccnxNameView_GetSegmentCount(&view));
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameView_Init_Empty)
+{
+    CCNxNameView view;
+    bool success = ccnxNameView_Init(&view, 0, _applePie);
+
+    assertTrue(success, "Expected a zero length name to initialise the view");
+    assertTrue(ccnxNameView_GetSegmentCount(&view) == 0, "Expected 0 segments, got %zu", ccnxNameView_GetSegmentCount(&view));
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameView_Init_ShortHeader)
+{
+    // The last segment has only 3 bytes of its 4 byte header
+    CCNxNameView view;
+    bool success = ccnxNameView_Init(&view, sizeof(_apple) + 3, _appleTart);
+
+    assertFalse(success, "Expected a truncated segment header to fail");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameView_Init_Overrun)
+{
+    // The last segment is one byte shorter than its length
+    CCNxNameView view;
+    bool success = ccnxNameView_Init(&view, sizeof(_appleTart) - 1, _appleTart);
+
+    assertFalse(success, "Expected a segment that overruns the name to fail");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameView_GetSegment)
+{
+    CCNxNameView view;
+    ccnxNameView_Init(&view, sizeof(_applePie), _applePie);
+
+    CCNxNameViewSegment segment;
+    bool success = ccnxNameView_GetSegment(&view, 1, &segment);
+    assertTrue(success, "Expected segment 1 to exist");
+    assertTrue(segment.type == CCNxNameLabelType_NAME, "Expected type NAME, got %d", segment.type);
+    assertTrue(segment.length == 3, "Expected length 3, got %zu", segment.length);
+    assertTrue(memcmp(segment.value, "pie", 3) == 0, "Expected the value 'pie'");
+
+    success = ccnxNameView_GetSegment(&view, 3, &segment);
+    assertFalse(success, "Expected segment 3 to not exist");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameViewIterator_Next)
+{
+    CCNxNameView view;
+    ccnxNameView_Init(&view, sizeof(_applePie), _applePie);
+
+    CCNxNameLabelType expectedTypes[] = { CCNxNameLabelType_NAME, CCNxNameLabelType_NAME, CCNxNameLabelType_CHUNK };
+    size_t expectedLengths[] = { 5, 3, 1 };
+
+    CCNxNameViewIterator iterator;
+    CCNxNameViewSegment segment;
+    ccnxNameViewIterator_Init(&iterator, &view);
+
+    size_t count = 0;
+    while (ccnxNameViewIterator_Next(&iterator, &segment)) {
+        assertTrue(segment.type == expectedTypes[count], "Segment %zu expected type %d, got %d", count, expectedTypes[count], segment.type);
+        assertTrue(segment.length == expectedLengths[count], "Segment %zu expected length %zu, got %zu", count, expectedLengths[count], segment.length);
+        count++;
+    }
+    assertTrue(count == 3, "Expected 3 segments, got %zu", count);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameView_Equals)
+{
+    uint8_t copy[sizeof(_applePie)];
+    memcpy(copy, _applePie, sizeof(_applePie));
+
+    CCNxNameView a;
+    CCNxNameView b;
+    CCNxNameView c;
+    ccnxNameView_Init(&a, sizeof(_applePie), _applePie);
+    ccnxNameView_Init(&b, sizeof(copy), copy);
+    ccnxNameView_Init(&c, sizeof(_appleTart), _appleTart);
+
+    assertTrue(ccnxNameView_Equals(&a, &a), "Expected a view to equal itself");
+    assertTrue(ccnxNameView_Equals(&a, &b), "Expected views of equal names to be equal");
+    assertFalse(ccnxNameView_Equals(&a, &c), "Expected views of different names to not be equal");
+    assertFalse(ccnxNameView_Equals(&a, NULL), "Expected a view to not equal NULL");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameView_EqualsName)
+{
+    CCNxNameView view;
+    ccnxNameView_Init(&view, sizeof(_applePie), _applePie);
+
+    CCNxName *equal = _createApplePieName();
+    CCNxName *different = ccnxName_CreateFromCString("lci:/apple/pie/crust");
+
+    assertTrue(ccnxNameView_EqualsName(&view, equal), "Expected the view to equal the name");
+    assertFalse(ccnxNameView_EqualsName(&view, different), "Expected the view to not equal the name");
+
+    ccnxName_Release(&equal);
+    ccnxName_Release(&different);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameView_Compare)
+{
+    CCNxNameView apple;
+    CCNxNameView appleTart;
+    CCNxNameView applePie;
+    ccnxNameView_Init(&apple, sizeof(_apple), _apple);
+    ccnxNameView_Init(&appleTart, sizeof(_appleTart), _appleTart);
+    ccnxNameView_Init(&applePie, sizeof(_applePie), _applePie);
+
+    // The same order as ccnxName_Compare: "pie" is shorter than "tart", and a prefix sorts first.
+    assertTrue(ccnxNameView_Compare(&apple, &appleTart) < 0, "Expected a prefix to sort first");
+    assertTrue(ccnxNameView_Compare(&appleTart, &apple) > 0, "Expected a prefix to sort first");
+    assertTrue(ccnxNameView_Compare(&applePie, &appleTart) < 0, "Expected the shorter segment to sort first");
+    assertTrue(ccnxNameView_Compare(&applePie, &applePie) == 0, "Expected a view to compare equal to itself");
+
+    CCNxName *namePie = _createApplePieName();
+    CCNxName *nameTart = ccnxName_CreateFromCString("lci:/apple/tart");
+    assertTrue(ccnxName_Compare(namePie, nameTart) < 0, "Expected ccnxName_Compare to agree");
+    ccnxName_Release(&namePie);
+    ccnxName_Release(&nameTart);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameView_StartsWith)
+{
+    CCNxNameView apple;
+    CCNxNameView appleTart;
+    CCNxNameView applePie;
+    ccnxNameView_Init(&apple, sizeof(_apple), _apple);
+    ccnxNameView_Init(&appleTart, sizeof(_appleTart), _appleTart);
+    ccnxNameView_Init(&applePie, sizeof(_applePie), _applePie);
+
+    assertTrue(ccnxNameView_StartsWith(&applePie, &apple), "Expected /apple to be a prefix of /apple/pie/chunk");
+    assertTrue(ccnxNameView_StartsWith(&applePie, &applePie), "Expected a name to be a prefix of itself");
+    assertFalse(ccnxNameView_StartsWith(&applePie, &appleTart), "Expected /apple/tart to not be a prefix");
+    assertFalse(ccnxNameView_StartsWith(&apple, &applePie), "Expected a longer name to not be a prefix");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameView_StartsWithName)
+{
+    CCNxNameView view;
+    ccnxNameView_Init(&view, sizeof(_applePie), _applePie);
+
+    CCNxName *apple = ccnxName_CreateFromCString("lci:/apple");
+    CCNxName *appleTart = ccnxName_CreateFromCString("lci:/apple/tart");
+    CCNxName *root = ccnxName_Create();
+
+    assertTrue(ccnxNameView_StartsWithName(&view, apple), "Expected /apple to be a prefix");
+    assertTrue(ccnxNameView_StartsWithName(&view, root), "Expected the empty name to be a prefix");
+    assertFalse(ccnxNameView_StartsWithName(&view, appleTart), "Expected /apple/tart to not be a prefix");
+
+    ccnxName_Release(&apple);
+    ccnxName_Release(&appleTart);
+    ccnxName_Release(&root);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameView_HashCode)
+{
+    CCNxNameView view;
+    ccnxNameView_Init(&view, sizeof(_applePie), _applePie);
+
+    CCNxName *name = _createApplePieName();
+
+    PARCHashCode expected = ccnxName_HashCode(name);
+    PARCHashCode actual = ccnxNameView_HashCode(&view);
+    assertTrue(expected == actual, "Expected %" PRIPARCHashCode " actual %" PRIPARCHashCode, expected, actual);
+
+    for (size_t count = 0; count <= 4; count++) {
+        expected = ccnxName_LeftMostHashCode(name, count);
+        actual = ccnxNameView_LeftMostHashCode(&view, count);
+        assertTrue(expected == actual, "Count %zu expected %" PRIPARCHashCode " actual %" PRIPARCHashCode, count, expected, actual);
+    }
+
+    ccnxName_Release(&name);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameView_PrefixHashCodes)
+{
+    CCNxNameView view;
+    ccnxNameView_Init(&view, sizeof(_applePie), _applePie);
+
+    PARCHashCode hashCodes[8];
+    size_t count = ccnxNameView_PrefixHashCodes(&view, 8, hashCodes);
+    assertTrue(count == 3, "Expected 3 prefixes, got %zu", count);
+
+    for (size_t i = 0; i < count; i++) {
+        PARCHashCode expected = ccnxNameView_LeftMostHashCode(&view, i + 1);
+        assertTrue(expected == hashCodes[i], "Prefix %zu expected %" PRIPARCHashCode " actual %" PRIPARCHashCode, i + 1, expected, hashCodes[i]);
+    }
+
+    count = ccnxNameView_PrefixHashCodes(&view, 2, hashCodes);
+    assertTrue(count == 2, "Expected 2 prefixes, got %zu", count);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxNameView_CreateName)
+{
+    CCNxNameView view;
+    ccnxNameView_Init(&view, sizeof(_applePie), _applePie);
+
+    CCNxName *expected = _createApplePieName();
+    CCNxName *actual = ccnxNameView_CreateName(&view);
+
+    assertTrue(ccnxName_Equals(expected, actual), "Expected the created name to equal the viewed name");
+
+    ccnxName_Release(&expected);
+    ccnxName_Release(&actual);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(ccnx_NameView);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+#include <LongBow/unit-test.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_SafeMemory.h>
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../ccnx_PacketSummary.c"
+
+#include <ccnx/common/ccnx_Name.h>
+
+#include <ccnx/common/codec/schema_v1/testdata/v1_interest_all_fields.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_content_nameA_keyid1_rsasha256.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_cpi_add_route_crc32c.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_interest_bad_message_length.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_interest_validation_alg_overrun.h>
+
+typedef struct allocator_arg {
+    size_t maxallocation;
+} AllocatorArg;
+
+static size_t
+_testAllocator(void *userarg, size_t bytes, void **output)
+{
+    AllocatorArg *arg = userarg;
+    if (bytes > arg->maxallocation) {
+        bytes = arg->maxallocation;
+    }
+
+    *output = parcMemory_Allocate(bytes);
+    assertNotNull(*output, "parcMemory_Allocate(%zu) returned NULL", bytes);
+    if (*output) {
+        return bytes;
+    }
+    return 0;
+}
+
+static void
+_testDeallocator(void *userarg, void **memory)
+{
+    parcMemory_Deallocate((void **) memory);
+}
+
+static const CCNxCodecNetworkBufferMemoryBlockFunctions _testMemoryBlock = {
+    .allocator   = &_testAllocator,
+    .deallocator = &_testDeallocator
+};
+
+static void
+_assertPrefixHashCodes(const CCNxPacketSummary *summary, const char *uri)
+{
+    CCNxName *name = ccnxName_CreateFromCString(uri);
+    assertTrue(summary->nameSegmentCount == ccnxName_GetSegmentCount(name),
+               "Expected %zu segments, got %zu", ccnxName_GetSegmentCount(name), summary->nameSegmentCount);
+    assertTrue(summary->prefixHashCodeCount == summary->nameSegmentCount,
+               "Expected %zu prefix hash codes, got %zu", summary->nameSegmentCount, summary->prefixHashCodeCount);
+
+    for (size_t i = 0; i < summary->prefixHashCodeCount; i++) {
+        PARCHashCode expected = ccnxName_LeftMostHashCode(name, i + 1);
+        assertTrue(expected == summary->prefixHashCodes[i],
+                   "Prefix %zu expected %" PRIPARCHashCode " actual %" PRIPARCHashCode, i + 1, expected, summary->prefixHashCodes[i]);
+    }
+    ccnxName_Release(&name);
+}
+
+static void
+_assertSummaryEquals(const CCNxPacketSummary *expected, const CCNxPacketSummary *actual)
+{
+    assertTrue(expected->packetType == actual->packetType, "Wrong packet type");
+    assertTrue(expected->messageType == actual->messageType, "Wrong message type");
+    assertTrue(expected->packetLength == actual->packetLength, "Wrong packet length");
+    assertTrue(expected->name.offset == actual->name.offset && expected->name.length == actual->name.length, "Wrong name extent");
+    assertTrue(expected->nameSegmentCount == actual->nameSegmentCount, "Wrong name segment count");
+    assertTrue(expected->keyIdRestriction.offset == actual->keyIdRestriction.offset, "Wrong KeyId restriction");
+    assertTrue(expected->objectHashRestriction.offset == actual->objectHashRestriction.offset, "Wrong object hash restriction");
+    assertTrue(expected->interestLifetime == actual->interestLifetime, "Wrong Interest Lifetime");
+    assertTrue(expected->validationAlg == actual->validationAlg, "Wrong validation algorithm");
+}
+
+static CCNxCodecNetworkBufferIoVec *
+_createIoVec(CCNxCodecNetworkBuffer **netbuffPtr, AllocatorArg *maxalloc, size_t length, const uint8_t packet[length])
+{
+    *netbuffPtr = ccnxCodecNetworkBuffer_Create(&_testMemoryBlock, maxalloc);
+    ccnxCodecNetworkBuffer_PutArray(*netbuffPtr, length, packet);
+    return ccnxCodecNetworkBuffer_CreateIoVec(*netbuffPtr);
+}
+
+LONGBOW_TEST_RUNNER(ccnx_PacketSummary)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+LONGBOW_TEST_RUNNER_SETUP(ccnx_PacketSummary)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_RUNNER_TEARDOWN(ccnx_PacketSummary)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, ccnxPacketSummary_Parse_Interest);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxPacketSummary_Parse_ContentObject);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxPacketSummary_Parse_Control);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxPacketSummary_Parse_Padded);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxPacketSummary_Parse_Truncated);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxPacketSummary_Parse_BadVersion);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxPacketSummary_Parse_BadMessageLength);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxPacketSummary_Parse_ValidationAlgOverrun);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxPacketSummary_ParseIoVec_OneBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxPacketSummary_ParseIoVec_SeveralBuffer);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    if (parcSafeMemory_ReportAllocation(STDOUT_FILENO) != 0) {
+        printf("('%s' leaks memory by %d (allocs - frees)) ", longBowTestCase_GetName(testCase), parcMemory_Outstanding());
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxPacketSummary_Parse_Interest)
+{
+    CCNxPacketSummary summary;
+    bool success = ccnxPacketSummary_Parse(&summary, sizeof(v1_interest_all_fields), v1_interest_all_fields);
+    assertTrue(success, "Failed to parse a good Interest");
+
+    assertTrue(summary.packetType == CCNxCodecSchemaV1Types_PacketType_Interest, "Wrong packet type %d", summary.packetType);
+    assertTrue(summary.messageType == CCNxCodecSchemaV1Types_MessageType_Interest, "Wrong message type %d", summary.messageType);
+    assertTrue(summary.hopLimit == 32, "Wrong hop limit %u", summary.hopLimit);
+    assertTrue(summary.packetLength == sizeof(v1_interest_all_fields), "Wrong packet length %zu", summary.packetLength);
+    assertTrue(summary.headerLength == 14, "Wrong header length %zu", summary.headerLength);
+
+    assertTrue(summary.name.offset == 22 && summary.name.length == 45,
+               "Wrong name extent %zu/%zu", summary.name.offset, summary.name.length);
+    _assertPrefixHashCodes(&summary, v1_interest_all_fields_URI);
+
+    assertTrue(summary.keyIdRestriction.offset == 71 && summary.keyIdRestriction.length == 36,
+               "Wrong KeyId restriction extent %zu/%zu", summary.keyIdRestriction.offset, summary.keyIdRestriction.length);
+    assertTrue(summary.objectHashRestriction.offset == 111 && summary.objectHashRestriction.length == 36,
+               "Wrong object hash restriction extent %zu/%zu", summary.objectHashRestriction.offset, summary.objectHashRestriction.length);
+
+    assertTrue(summary.hasInterestLifetime, "Expected an Interest Lifetime");
+    assertTrue(summary.interestLifetime == v1_interest_all_fields_Lifetime, "Wrong Interest Lifetime %" PRIu64, summary.interestLifetime);
+    assertTrue(summary.validationAlg == 0, "Expected no validation, got %d", summary.validationAlg);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxPacketSummary_Parse_ContentObject)
+{
+    CCNxPacketSummary summary;
+    bool success = ccnxPacketSummary_Parse(&summary, sizeof(v1_content_nameA_keyid1_rsasha256), v1_content_nameA_keyid1_rsasha256);
+    assertTrue(success, "Failed to parse a good Content Object");
+
+    assertTrue(summary.packetType == CCNxCodecSchemaV1Types_PacketType_ContentObject, "Wrong packet type %d", summary.packetType);
+    assertTrue(summary.messageType == CCNxCodecSchemaV1Types_MessageType_ContentObject, "Wrong message type %d", summary.messageType);
+    assertTrue(summary.packetLength == sizeof(v1_content_nameA_keyid1_rsasha256), "Wrong packet length %zu", summary.packetLength);
+
+    assertTrue(summary.name.offset == 40 && summary.name.length == 17,
+               "Wrong name extent %zu/%zu", summary.name.offset, summary.name.length);
+    _assertPrefixHashCodes(&summary, v1_content_nameA_keyid1_rsasha256_URI);
+
+    assertTrue(summary.keyIdRestriction.offset == 0, "Expected no KeyId restriction");
+    assertTrue(summary.objectHashRestriction.offset == 0, "Expected no object hash restriction");
+    assertFalse(summary.hasInterestLifetime, "Expected no Interest Lifetime");
+    assertTrue(summary.validationAlg == CCNxCodecSchemaV1Types_ValidationAlg_RSA_SHA256,
+               "Expected RSA-SHA256, got %d", summary.validationAlg);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxPacketSummary_Parse_Control)
+{
+    CCNxPacketSummary summary;
+    bool success = ccnxPacketSummary_Parse(&summary, sizeof(v1_cpi_add_route_crc32c), v1_cpi_add_route_crc32c);
+    assertTrue(success, "Failed to parse a good control packet");
+
+    assertTrue(summary.packetType == CCNxCodecSchemaV1Types_PacketType_Control, "Wrong packet type %d", summary.packetType);
+    assertTrue(summary.messageType == CCNxCodecSchemaV1Types_MessageType_Control, "Wrong message type %d", summary.messageType);
+    assertTrue(summary.name.offset == 0, "Expected no name");
+    assertTrue(summary.prefixHashCodeCount == 0, "Expected no prefix hash codes");
+    assertTrue(summary.validationAlg == CCNxCodecSchemaV1Types_ValidationAlg_CRC32C,
+               "Expected CRC32C, got %d", summary.validationAlg);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxPacketSummary_Parse_Padded)
+{
+    uint8_t padded[sizeof(v1_interest_all_fields) + 16];
+    memcpy(padded, v1_interest_all_fields, sizeof(v1_interest_all_fields));
+    memset(padded + sizeof(v1_interest_all_fields), 0xFF, sizeof(padded) - sizeof(v1_interest_all_fields));
+
+    CCNxPacketSummary expected;
+    ccnxPacketSummary_Parse(&expected, sizeof(v1_interest_all_fields), v1_interest_all_fields);
+
+    CCNxPacketSummary actual;
+    bool success = ccnxPacketSummary_Parse(&actual, sizeof(padded), padded);
+    assertTrue(success, "Bytes after the packet should be ignored");
+    _assertSummaryEquals(&expected, &actual);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxPacketSummary_Parse_Truncated)
+{
+    for (size_t length = 0; length < sizeof(v1_interest_all_fields); length++) {
+        CCNxPacketSummary summary;
+        bool success = ccnxPacketSummary_Parse(&summary, length, v1_interest_all_fields);
+        assertFalse(success, "Should have rejected a packet truncated to %zu bytes", length);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, ccnxPacketSummary_Parse_BadVersion)
+{
+    uint8_t packet[sizeof(v1_interest_all_fields)];
+    memcpy(packet, v1_interest_all_fields, sizeof(packet));
+    packet[0] = 0xFF;
+
+    CCNxPacketSummary summary;
+    bool success = ccnxPacketSummary_Parse(&summary, sizeof(packet), packet);
+    assertFalse(success, "Should have rejected schema version 255");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxPacketSummary_Parse_BadMessageLength)
+{
+    CCNxPacketSummary summary;
+    bool success = ccnxPacketSummary_Parse(&summary, sizeof(v1_interest_bad_message_length), v1_interest_bad_message_length);
+    assertFalse(success, "Should have rejected a message TLV that overruns the packet");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxPacketSummary_Parse_ValidationAlgOverrun)
+{
+    CCNxPacketSummary summary;
+    bool success = ccnxPacketSummary_Parse(&summary, sizeof(v1_interest_validation_alg_overrun), v1_interest_validation_alg_overrun);
+    assertFalse(success, "Should have rejected a validation algorithm that overruns its container");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxPacketSummary_ParseIoVec_OneBuffer)
+{
+    AllocatorArg maxalloc = { .maxallocation = 2048 };
+    CCNxCodecNetworkBuffer *netbuff;
+    CCNxCodecNetworkBufferIoVec *vec = _createIoVec(&netbuff, &maxalloc, sizeof(v1_interest_all_fields), v1_interest_all_fields);
+
+    CCNxPacketSummary expected;
+    ccnxPacketSummary_Parse(&expected, sizeof(v1_interest_all_fields), v1_interest_all_fields);
+
+    CCNxPacketSummary actual;
+    bool success = ccnxPacketSummary_ParseIoVec(&actual, vec);
+    assertTrue(success, "Failed to parse a good Interest from an iovec");
+    _assertSummaryEquals(&expected, &actual);
+    _assertPrefixHashCodes(&actual, v1_interest_all_fields_URI);
+
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    ccnxCodecNetworkBuffer_Release(&netbuff);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxPacketSummary_ParseIoVec_SeveralBuffer)
+{
+    // 32 bytes is needed for bookkeeping, so this means we'll have a 32-byte memory block
+    AllocatorArg maxalloc = { .maxallocation = 64 };
+    CCNxCodecNetworkBuffer *netbuff;
+    CCNxCodecNetworkBufferIoVec *vec = _createIoVec(&netbuff, &maxalloc, sizeof(v1_interest_all_fields), v1_interest_all_fields);
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(vec) > 1, "Expected the packet to be split over several extents");
+
+    CCNxPacketSummary expected;
+    ccnxPacketSummary_Parse(&expected, sizeof(v1_interest_all_fields), v1_interest_all_fields);
+
+    CCNxPacketSummary actual;
+    bool success = ccnxPacketSummary_ParseIoVec(&actual, vec);
+    assertTrue(success, "Failed to parse a good Interest from a split iovec");
+    _assertSummaryEquals(&expected, &actual);
+
+    // The 45-byte name cannot fit in one 32-byte extent, so it is counted but not hashed
+    assertTrue(actual.prefixHashCodeCount == 0, "Expected no prefix hash codes for a split name, got %zu", actual.prefixHashCodeCount);
+
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+    ccnxCodecNetworkBuffer_Release(&netbuff);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(ccnx_PacketSummary);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
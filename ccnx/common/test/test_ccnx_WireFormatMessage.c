@@ -62,6 +62,7 @@
 #include "../ccnx_WireFormatMessage.c"
 
 #include <stdio.h>
+#include <sys/time.h>
 
 #include <LongBow/unit-test.h>
 
@@ -80,6 +81,7 @@ LONGBOW_TEST_RUNNER(ccnx_WireFormatMessage)
 
     LONGBOW_RUN_TEST_FIXTURE(Global);
     LONGBOW_RUN_TEST_FIXTURE(Static);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -108,7 +110,10 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxWireFormatMessage_GetWireFormatBuffer);
     //
     LONGBOW_RUN_TEST_CASE(Global, ccnxWireFormatMessage_CreateContentObjectHash);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxWireFormatMessage_ComputeContentObjectHashDigest);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxWireFormatMessage_ComputeContentObjectHashDigests);
     LONGBOW_RUN_TEST_CASE(Global, ccnxWireFormatMessage_HashProtectedRegion);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxWireFormatMessage_HashProtectedRegions);
     //
     LONGBOW_RUN_TEST_CASE(Global, ccnxWireFormatMessage_PutWireFormatBuffer);
     LONGBOW_RUN_TEST_CASE(Global, ccnxWireFormatMessage_SetProtectedRegionLength);
@@ -461,6 +466,141 @@ LONGBOW_TEST_CASE(Global, ccnxWireFormatMessage_CreateContentObjectHash)
     parcBuffer_Release(&buffer);
 }
 
+/*
+ * Encode then decode a ContentObject so the dictionary has its ContentObjectHash extents set.
+ */
+static CCNxWireFormatMessage *
+_createHashableMessage(const char *uri, PARCBuffer *payload)
+{
+    CCNxName *name = ccnxName_CreateFromCString(uri);
+    CCNxContentObject *contentObject = ccnxContentObject_CreateWithNameAndPayload(name, payload);
+    ccnxName_Release(&name);
+
+    CCNxCodecNetworkBufferIoVec *iovec = ccnxCodecTlvPacket_DictionaryEncode(contentObject, NULL);
+    ccnxContentObject_Release(&contentObject);
+    PARCBuffer *encodedMessage = _iovecToParcBuffer(iovec);
+    ccnxCodecNetworkBufferIoVec_Release(&iovec);
+
+    CCNxWireFormatMessage *message = ccnxWireFormatMessage_Create(encodedMessage);
+    bool success = ccnxCodecTlvPacket_BufferDecode(encodedMessage, ccnxWireFormatMessage_GetDictionary(message));
+    assertTrue(success, "Failed to decode buffer");
+    parcBuffer_Release(&encodedMessage);
+
+    return message;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxWireFormatMessage_ComputeContentObjectHashDigest)
+{
+    const char string[] = "Hello dev null\n";
+    PARCBuffer *buffer = parcBuffer_Wrap((void *) string, sizeof(string), 0, sizeof(string));
+
+    uint8_t digest[CCNxWireFormatMessage_ContentObjectHashLength];
+
+    CCNxWireFormatMessage *message = ccnxWireFormatMessage_FromContentObjectPacketType(CCNxTlvDictionary_SchemaVersion_V1, buffer);
+    assertFalse(ccnxWireFormatMessage_ComputeContentObjectHashDigest(message, digest), "Expect false as it hasn't been encoded yet");
+    ccnxWireFormatMessage_Release(&message);
+
+    message = _createHashableMessage("lci:/test/content", buffer);
+
+    bool success = ccnxWireFormatMessage_ComputeContentObjectHashDigest(message, digest);
+    assertTrue(success, "Expected a digest from a good packet");
+
+    PARCCryptoHash *hash = ccnxWireFormatMessage_CreateContentObjectHash(message);
+    PARCBuffer *expected = parcCryptoHash_GetDigest(hash);
+    assertTrue(parcBuffer_Remaining(expected) == sizeof(digest), "Wrong digest length, expected %zu got %zu",
+               sizeof(digest), parcBuffer_Remaining(expected));
+    assertTrue(memcmp(parcBuffer_Overlay(expected, 0), digest, sizeof(digest)) == 0,
+               "Digest does not match ccnxWireFormatMessage_CreateContentObjectHash");
+
+    parcCryptoHash_Release(&hash);
+    ccnxWireFormatMessage_Release(&message);
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxWireFormatMessage_ComputeContentObjectHashDigests)
+{
+    // More messages than fit in one stack batch, so the regions are gathered into allocated arrays
+    const size_t count = 40;
+    const char string[] = "Hello dev null\n";
+    PARCBuffer *buffer = parcBuffer_Wrap((void *) string, sizeof(string), 0, sizeof(string));
+
+    CCNxWireFormatMessage *messages[count];
+    for (size_t i = 0; i < count; i++) {
+        if (i == 5) {
+            // Not encoded, so it has no ContentObject Hash region
+            messages[i] = ccnxWireFormatMessage_FromContentObjectPacketType(CCNxTlvDictionary_SchemaVersion_V1, buffer);
+        } else {
+            char uri[64];
+            snprintf(uri, sizeof(uri), "lci:/test/chunk=%zu", i);
+            messages[i] = _createHashableMessage(uri, buffer);
+        }
+    }
+
+    uint8_t digests[count][CCNxWireFormatMessage_ContentObjectHashLength];
+    bool hashed[count];
+    size_t result = ccnxWireFormatMessage_ComputeContentObjectHashDigests(count, messages, digests, hashed);
+    assertTrue(result == count - 1, "Expected %zu digests, got %zu", count - 1, result);
+
+    for (size_t i = 0; i < count; i++) {
+        PARCCryptoHash *hash = ccnxWireFormatMessage_CreateContentObjectHash(messages[i]);
+        assertTrue(hashed[i] == (hash != NULL), "Message %zu: hashed %d but CreateContentObjectHash returned %p", i, hashed[i], (void *) hash);
+        if (hash != NULL) {
+            PARCBuffer *expected = parcCryptoHash_GetDigest(hash);
+            assertTrue(memcmp(parcBuffer_Overlay(expected, 0), digests[i], CCNxWireFormatMessage_ContentObjectHashLength) == 0,
+                       "Message %zu: digest does not match ccnxWireFormatMessage_CreateContentObjectHash", i);
+            parcCryptoHash_Release(&hash);
+        }
+        ccnxWireFormatMessage_Release(&messages[i]);
+    }
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxWireFormatMessage_HashProtectedRegions)
+{
+    const size_t count = 20;
+    uint8_t bytes[300];
+    for (size_t i = 0; i < sizeof(bytes); i++) {
+        bytes[i] = (uint8_t) (i * 7 + 3);
+    }
+    PARCBuffer *buffer = parcBuffer_Wrap(bytes, sizeof(bytes), 0, sizeof(bytes));
+
+    CCNxWireFormatMessage *messages[count];
+    for (size_t i = 0; i < count; i++) {
+        messages[i] = ccnxWireFormatMessage_FromContentObjectPacketType(CCNxTlvDictionary_SchemaVersion_V1, buffer);
+        if (i == 5) {
+            // No protected region
+            continue;
+        }
+        // Message 6's region runs past the end of the buffer
+        size_t start = i;
+        size_t length = (i == 6) ? sizeof(bytes) : 13 * i;
+        ccnxWireFormatMessage_SetProtectedRegionStart(messages[i], start);
+        ccnxWireFormatMessage_SetProtectedRegionLength(messages[i], length);
+    }
+
+    uint8_t digests[count][CCNxWireFormatMessage_SHA256DigestLength];
+    bool hashed[count];
+    size_t result = ccnxWireFormatMessage_HashProtectedRegions(count, messages, digests, hashed);
+    assertTrue(result == count - 2, "Expected %zu digests, got %zu", count - 2, result);
+
+    PARCCryptoHasher *hasher = parcCryptoHasher_Create(PARCCryptoHashType_SHA256);
+    for (size_t i = 0; i < count; i++) {
+        PARCCryptoHash *hash = ccnxWireFormatMessage_HashProtectedRegion(messages[i], hasher);
+        assertTrue(hashed[i] == (hash != NULL), "Message %zu: hashed %d but HashProtectedRegion returned %p", i, hashed[i], (void *) hash);
+        if (hash != NULL) {
+            PARCBuffer *expected = parcCryptoHash_GetDigest(hash);
+            assertTrue(memcmp(parcBuffer_Overlay(expected, 0), digests[i], CCNxWireFormatMessage_SHA256DigestLength) == 0,
+                       "Message %zu: digest does not match ccnxWireFormatMessage_HashProtectedRegion", i);
+            parcCryptoHash_Release(&hash);
+        }
+        ccnxWireFormatMessage_Release(&messages[i]);
+    }
+
+    parcCryptoHasher_Release(&hasher);
+    parcBuffer_Release(&buffer);
+}
+
 LONGBOW_TEST_CASE(Global, ccnxWireFormatMessage_WriteToFile)
 {
     const char string[] = "Hello dev null\n";
@@ -533,6 +673,82 @@ LONGBOW_TEST_CASE(Static, _getImplForSchema)
     assertTrue(impl = &CCNxWireFormatFacadeV1_Implementation, "Expected to see CCNxWireFormatFacadeV1_Implementation");
 }
 
+// =========================================================================
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxWireFormatMessage_ContentObjectHash);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * Compare the allocating ContentObject Hash against the digest API, one message at a time and in batches,
+ * over a 1200 byte payload.
+ */
+LONGBOW_TEST_CASE(Performance, ccnxWireFormatMessage_ContentObjectHash)
+{
+    const size_t batchSize = 32;
+    const unsigned iterations = 10000;
+
+    PARCBuffer *payload = parcBuffer_Allocate(1200);
+    parcBuffer_Flip(parcBuffer_SetLimit(payload, 1200));
+
+    CCNxWireFormatMessage *messages[batchSize];
+    for (size_t i = 0; i < batchSize; i++) {
+        char uri[64];
+        snprintf(uri, sizeof(uri), "lci:/performance/chunk=%zu", i);
+        messages[i] = _createHashableMessage(uri, payload);
+    }
+
+    uint8_t digests[batchSize][CCNxWireFormatMessage_ContentObjectHashLength];
+    struct timeval t0, t1, t2, t3, create, single, batch;
+
+    gettimeofday(&t0, NULL);
+    for (unsigned i = 0; i < iterations; i++) {
+        for (size_t j = 0; j < batchSize; j++) {
+            PARCCryptoHash *hash = ccnxWireFormatMessage_CreateContentObjectHash(messages[j]);
+            parcCryptoHash_Release(&hash);
+        }
+    }
+    gettimeofday(&t1, NULL);
+    for (unsigned i = 0; i < iterations; i++) {
+        for (size_t j = 0; j < batchSize; j++) {
+            ccnxWireFormatMessage_ComputeContentObjectHashDigest(messages[j], digests[j]);
+        }
+    }
+    gettimeofday(&t2, NULL);
+    for (unsigned i = 0; i < iterations; i++) {
+        ccnxWireFormatMessage_ComputeContentObjectHashDigests(batchSize, messages, digests, NULL);
+    }
+    gettimeofday(&t3, NULL);
+
+    timersub(&t1, &t0, &create);
+    timersub(&t2, &t1, &single);
+    timersub(&t3, &t2, &batch);
+
+    double hashes = (double) iterations * batchSize;
+    printf("CreateContentObjectHash        %.6f sec  %.0f hashes/sec\n",
+           create.tv_sec + create.tv_usec * 1E-6, hashes / (create.tv_sec + create.tv_usec * 1E-6));
+    printf("ComputeContentObjectHashDigest %.6f sec  %.0f hashes/sec\n",
+           single.tv_sec + single.tv_usec * 1E-6, hashes / (single.tv_sec + single.tv_usec * 1E-6));
+    printf("ComputeContentObjectHashDigests %.6f sec  %.0f hashes/sec\n",
+           batch.tv_sec + batch.tv_usec * 1E-6, hashes / (batch.tv_sec + batch.tv_usec * 1E-6));
+
+    for (size_t i = 0; i < batchSize; i++) {
+        ccnxWireFormatMessage_Release(&messages[i]);
+    }
+    parcBuffer_Release(&payload);
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -63,17 +63,39 @@
  */
 #include <config.h>
 #include <stdio.h>
+#include <string.h>
+#include <pthread.h>
 #include <LongBow/runtime.h>
 
 #include <parc/algol/parc_Memory.h>
 #include <parc/security/parc_CryptoHasher.h>
 
 #include <ccnx/common/internal/ccnx_ValidationFacadeV1.h>
+#include <ccnx/common/validation/ccnxValidation_CRC32C.h>
 #include <ccnx/common/codec/schema_v1/ccnxCodecSchemaV1_TlvDictionary.h>
 
 #include <fcntl.h>
 #include <errno.h>
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define _ccnxValidationCRC32C_HaveSSE42 1
+#endif
+
+// The CRC32C polynomial 0x1EDC6F41 in reflected bit order
+#define _ccnxValidationCRC32C_Polynomial 0x82F63B78
+
+/*
+ * The slicing-by-8 tables.  _ccnxValidationCRC32C_Table[0] is the byte-at-a-time table and
+ * _ccnxValidationCRC32C_Table[k][n] is the CRC of byte n followed by k zero bytes.
+ */
+static uint32_t _ccnxValidationCRC32C_Table[8][256];
+
+typedef uint32_t (_CRC32CUpdateFunction)(uint32_t crc, size_t length, const uint8_t *bytes);
+
+static _CRC32CUpdateFunction *_ccnxValidationCRC32C_UpdateFunction;
+static pthread_once_t _ccnxValidationCRC32C_InitOnce = PTHREAD_ONCE_INIT;
+
 typedef struct crc32_signer {
     PARCCryptoHasher *hasher;
 } _CRC32Signer;
@@ -82,6 +104,201 @@ typedef struct crc32_verifier {
     PARCCryptoHasher *hasher;
 } _CRC32Verifier;
 
+/*
+ * Software CRC32C, slicing-by-8.  `crc` is the raw register, without the initial or final inversion.
+ */
+static uint32_t
+_ccnxValidationCRC32C_UpdateSoftware(uint32_t crc, size_t length, const uint8_t *bytes)
+{
+    while (length > 0 && ((uintptr_t) bytes & 7) != 0) {
+        crc = _ccnxValidationCRC32C_Table[0][(crc ^ *bytes++) & 0xFF] ^ (crc >> 8);
+        length--;
+    }
+
+    while (length >= 8) {
+        uint32_t low;
+        uint32_t high;
+        memcpy(&low, bytes, sizeof(low));
+        memcpy(&high, bytes + 4, sizeof(high));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        low = __builtin_bswap32(low);
+        high = __builtin_bswap32(high);
+#endif
+        low ^= crc;
+        crc = _ccnxValidationCRC32C_Table[7][low & 0xFF] ^
+              _ccnxValidationCRC32C_Table[6][(low >> 8) & 0xFF] ^
+              _ccnxValidationCRC32C_Table[5][(low >> 16) & 0xFF] ^
+              _ccnxValidationCRC32C_Table[4][low >> 24] ^
+              _ccnxValidationCRC32C_Table[3][high & 0xFF] ^
+              _ccnxValidationCRC32C_Table[2][(high >> 8) & 0xFF] ^
+              _ccnxValidationCRC32C_Table[1][(high >> 16) & 0xFF] ^
+              _ccnxValidationCRC32C_Table[0][high >> 24];
+        bytes += 8;
+        length -= 8;
+    }
+
+    while (length > 0) {
+        crc = _ccnxValidationCRC32C_Table[0][(crc ^ *bytes++) & 0xFF] ^ (crc >> 8);
+        length--;
+    }
+
+    return crc;
+}
+
+#ifdef _ccnxValidationCRC32C_HaveSSE42
+/*
+ * CRC32C with the SSE4.2 `crc32` instruction, which computes exactly this polynomial.
+ */
+__attribute__((target("sse4.2")))
+static uint32_t
+_ccnxValidationCRC32C_UpdateSSE42(uint32_t crc, size_t length, const uint8_t *bytes)
+{
+    while (length > 0 && ((uintptr_t) bytes & 7) != 0) {
+        crc = _mm_crc32_u8(crc, *bytes++);
+        length--;
+    }
+
+    uint64_t crc64 = crc;
+    while (length >= 8) {
+        uint64_t word;
+        memcpy(&word, bytes, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        bytes += 8;
+        length -= 8;
+    }
+    crc = (uint32_t) crc64;
+
+    while (length > 0) {
+        crc = _mm_crc32_u8(crc, *bytes++);
+        length--;
+    }
+
+    return crc;
+}
+#endif
+
+static void
+_ccnxValidationCRC32C_Init(void)
+{
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t crc = n;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ _ccnxValidationCRC32C_Polynomial : crc >> 1;
+        }
+        _ccnxValidationCRC32C_Table[0][n] = crc;
+    }
+
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t crc = _ccnxValidationCRC32C_Table[0][n];
+        for (int k = 1; k < 8; k++) {
+            crc = _ccnxValidationCRC32C_Table[0][crc & 0xFF] ^ (crc >> 8);
+            _ccnxValidationCRC32C_Table[k][n] = crc;
+        }
+    }
+
+    _ccnxValidationCRC32C_UpdateFunction = _ccnxValidationCRC32C_UpdateSoftware;
+#ifdef _ccnxValidationCRC32C_HaveSSE42
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2")) {
+        _ccnxValidationCRC32C_UpdateFunction = _ccnxValidationCRC32C_UpdateSSE42;
+    }
+#endif
+}
+
+uint32_t
+ccnxValidationCRC32C_Update(uint32_t crc32c, size_t length, const uint8_t bytes[length])
+{
+    pthread_once(&_ccnxValidationCRC32C_InitOnce, _ccnxValidationCRC32C_Init);
+    return ~_ccnxValidationCRC32C_UpdateFunction(~crc32c, length, bytes);
+}
+
+uint32_t
+ccnxValidationCRC32C_UpdateIoVec(uint32_t crc32c, CCNxCodecNetworkBufferIoVec *vec, size_t start, size_t length)
+{
+    const struct iovec *iov = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+    int iovcnt = ccnxCodecNetworkBufferIoVec_GetCount(vec);
+
+    for (int i = 0; i < iovcnt && length > 0; i++) {
+        if (start >= iov[i].iov_len) {
+            start -= iov[i].iov_len;
+            continue;
+        }
+
+        size_t count = iov[i].iov_len - start;
+        count = (count > length) ? length : count;
+        crc32c = ccnxValidationCRC32C_Update(crc32c, count, (const uint8_t *) iov[i].iov_base + start);
+
+        start = 0;
+        length -= count;
+    }
+
+    assertTrue(length == 0, "The iovec ended %zu bytes before the region", length);
+    return crc32c;
+}
+
+/*
+ * Compute the CRC32C of the protected region, reading the wire format in place.
+ * Returns false if the message has no protected region or wire format, or the region is beyond its end.
+ */
+static bool
+_ccnxValidationCRC32C_ComputeProtectedRegion(const CCNxTlvDictionary *message, uint32_t *crc32cPtr)
+{
+    if (!ccnxTlvDictionary_IsValueInteger(message, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ProtectedStart) ||
+        !ccnxTlvDictionary_IsValueInteger(message, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ProtectedLength)) {
+        return false;
+    }
+
+    size_t start = ccnxTlvDictionary_GetInteger(message, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ProtectedStart);
+    size_t length = ccnxTlvDictionary_GetInteger(message, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_ProtectedLength);
+
+    CCNxCodecNetworkBufferIoVec *vec = ccnxTlvDictionary_GetIoVec(message, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_WireFormat);
+    if (vec != NULL) {
+        if (start + length > ccnxCodecNetworkBufferIoVec_Length(vec)) {
+            return false;
+        }
+        *crc32cPtr = ccnxValidationCRC32C_UpdateIoVec(0, vec, start, length);
+        return true;
+    }
+
+    PARCBuffer *wireFormat = ccnxTlvDictionary_GetBuffer(message, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_WireFormat);
+    if (wireFormat != NULL) {
+        if (start + length > parcBuffer_Limit(wireFormat)) {
+            return false;
+        }
+        size_t position = parcBuffer_Position(wireFormat);
+        parcBuffer_SetPosition(wireFormat, start);
+        *crc32cPtr = ccnxValidationCRC32C_Update(0, length, parcBuffer_Overlay(wireFormat, 0));
+        parcBuffer_SetPosition(wireFormat, position);
+        return true;
+    }
+
+    return false;
+}
+
+bool
+ccnxValidationCRC32C_VerifyMessage(const CCNxTlvDictionary *message)
+{
+    if (ccnxTlvDictionary_GetSchemaVersion(message) != CCNxTlvDictionary_SchemaVersion_V1 || !ccnxValidationCRC32C_Test(message)) {
+        return false;
+    }
+
+    // The validation payload is the CRC32C in network byte order
+    PARCBuffer *payload = ccnxValidationFacadeV1_GetPayload(message);
+    if (payload == NULL || parcBuffer_Remaining(payload) != sizeof(uint32_t)) {
+        return false;
+    }
+
+    uint32_t crc32c;
+    if (!_ccnxValidationCRC32C_ComputeProtectedRegion(message, &crc32c)) {
+        return false;
+    }
+
+    const uint8_t *expected = parcBuffer_Overlay(payload, 0);
+    uint32_t expectedCrc32c = ((uint32_t) expected[0] << 24) | ((uint32_t) expected[1] << 16) |
+                              ((uint32_t) expected[2] << 8) | (uint32_t) expected[3];
+    return crc32c == expectedCrc32c;
+}
+
 bool
 ccnxValidationCRC32C_Set(CCNxTlvDictionary *message)
 {
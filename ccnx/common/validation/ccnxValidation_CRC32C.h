@@ -67,6 +67,7 @@
 #include <parc/security/parc_Signer.h>
 #include <parc/security/parc_Verifier.h>
 #include <ccnx/common/internal/ccnx_TlvDictionary.h>
+#include <ccnx/common/codec/ccnxCodec_NetworkBuffer.h>
 
 /**
  * Sets the Validation algorithm to RSA-SHA256
@@ -125,4 +126,74 @@ PARCSigner *ccnxValidationCRC32C_CreateSigner(void);
  * @endcode
  */
 PARCVerifier *ccnxValidationCRC32C_CreateVerifier(void);
+
+/**
+ * Continues a CRC32C over more bytes
+ *
+ * Uses the SSE4.2 `crc32` instruction when the CPU has it, otherwise a slicing-by-8 table.
+ * Does not allocate memory.  Start a new CRC with `crc32c` of 0.  The result is the finished CRC32C
+ * (with the final inversion), so it may be passed back in to continue over the next bytes.
+ *
+ * @param [in] crc32c The CRC32C of the bytes so far, or 0 to start.
+ * @param [in] length The number of bytes
+ * @param [in] bytes The bytes
+ *
+ * @return The CRC32C of the bytes so far followed by `bytes`
+ *
+ * Example:
+ * @code
+ * {
+ *     uint32_t crc32c = ccnxValidationCRC32C_Update(0, 9, (const uint8_t *) "123456789");
+ *     // crc32c is 0xE3069283
+ * }
+ * @endcode
+ */
+uint32_t ccnxValidationCRC32C_Update(uint32_t crc32c, size_t length, const uint8_t bytes[length]);
+
+/**
+ * Continues a CRC32C over a region of an iovec
+ *
+ * Like {@link ccnxValidationCRC32C_Update}, but reads `length` bytes beginning at byte `start` of the iovec,
+ * which may span several of its extents.  The region must be within the iovec.
+ *
+ * @param [in] crc32c The CRC32C of the bytes so far, or 0 to start.
+ * @param [in] vec The iovec
+ * @param [in] start The offset of the region from the start of the iovec
+ * @param [in] length The length of the region
+ *
+ * @return The CRC32C of the bytes so far followed by the region
+ *
+ * Example:
+ * @code
+ * {
+ *     uint32_t crc32c = ccnxValidationCRC32C_UpdateIoVec(0, vec, start, length);
+ * }
+ * @endcode
+ */
+uint32_t ccnxValidationCRC32C_UpdateIoVec(uint32_t crc32c, CCNxCodecNetworkBufferIoVec *vec, size_t start, size_t length);
+
+/**
+ * Verifies the CRC32C of a decoded message without allocating memory
+ *
+ * The message must have been decoded from the wire, so it has a wire format (buffer or iovec) and the extent
+ * of its protected region.  The CRC32C is computed over the protected region in place and compared to the
+ * validation payload.  This is the fast path for links that use CRC32C on every packet; it gives the same
+ * answer as running a PARCVerifier from {@link ccnxValidationCRC32C_CreateVerifier} over the protected region.
+ *
+ * @param [in] message A decoded message
+ *
+ * @return `true` The message uses CRC32C and the validation payload matches the protected region
+ * @return `false` The message does not use CRC32C, is missing its wire format, or the CRC32C does not match
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxTlvDictionary *message = ccnxCodecTlvPacket_Decode(packetBuffer);
+ *     if (ccnxValidationCRC32C_Test(message) && !ccnxValidationCRC32C_VerifyMessage(message)) {
+ *         // drop the packet
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxValidationCRC32C_VerifyMessage(const CCNxTlvDictionary *message);
 #endif // CCNx_Common_ccnxValidation_CRC32C_h
@@ -0,0 +1,481 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * The AVX2 implementation keeps eight SHA256 computations in flight, one per 32-bit lane.  Each
+ * lane pulls 64-byte blocks from its own region and takes the next region as soon as it finishes,
+ * so a burst of mixed packet sizes keeps every lane busy until the burst runs out.  Blocks that lie
+ * inside one iovec extent are read in place; only blocks that straddle extents and the padded
+ * final block(s) are assembled in a per-lane scratch block.
+ *
+ * CPUs with the SHA extensions hash a single stream faster than the eight lanes combined, so there
+ * the regions go one at a time through OpenSSL, which uses those instructions.  The one-at-a-time path
+ * reuses a digest context per thread, so it allocates only on a thread's first call.
+ *
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+#include <LongBow/runtime.h>
+
+#include <openssl/evp.h>
+
+#include <ccnx/common/validation/ccnxValidation_SHA256Batch.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#include <cpuid.h>
+#ifndef bit_SHA
+#define bit_SHA (1 << 29)
+#endif
+#define _ccnxValidationSHA256Batch_HaveAVX2 1
+#endif
+
+#define _ccnxValidationSHA256Batch_BlockLength 64
+#define _ccnxValidationSHA256Batch_LaneCount 8
+
+typedef void (_SHA256BatchFunction)(size_t count, const CCNxValidationSHA256BatchRegion regions[count],
+                                    uint8_t digests[count][CCNxValidationSHA256Batch_DigestLength]);
+
+static _SHA256BatchFunction *_ccnxValidationSHA256Batch_Function;
+static unsigned _ccnxValidationSHA256Batch_Lanes;
+static pthread_once_t _ccnxValidationSHA256Batch_InitOnce = PTHREAD_ONCE_INIT;
+
+static pthread_key_t _ccnxValidationSHA256Batch_ContextKey;
+static pthread_once_t _ccnxValidationSHA256Batch_ContextKeyOnce = PTHREAD_ONCE_INIT;
+
+/*
+ * Walks the bytes of a region in order, one contiguous span at a time.
+ */
+typedef struct sha256batch_reader {
+    const struct iovec *iov;
+    int iovcnt;
+    int index;          // The current iovec
+    size_t offset;      // The next byte in iov[index]
+    size_t remaining;   // Bytes of the region not yet returned
+} _SHA256BatchReader;
+
+static void
+_ccnxValidationSHA256Batch_ReaderInit(_SHA256BatchReader *reader, const CCNxValidationSHA256BatchRegion *region)
+{
+    reader->iov = region->iov;
+    reader->iovcnt = region->iovcnt;
+    reader->index = 0;
+    reader->offset = region->start;
+    reader->remaining = region->length;
+}
+
+/*
+ * Returns the next contiguous span of at most `maximum` bytes and advances past it.
+ * The caller must only call this while `reader->remaining > 0`.
+ */
+static const uint8_t *
+_ccnxValidationSHA256Batch_ReaderNext(_SHA256BatchReader *reader, size_t maximum, size_t *lengthPtr)
+{
+    while (reader->offset >= reader->iov[reader->index].iov_len) {
+        reader->offset -= reader->iov[reader->index].iov_len;
+        reader->index++;
+        assertTrue(reader->index < reader->iovcnt, "Region extends past the end of its iovec array");
+    }
+
+    const uint8_t *bytes = (const uint8_t *) reader->iov[reader->index].iov_base + reader->offset;
+    size_t length = reader->iov[reader->index].iov_len - reader->offset;
+    length = (length > maximum) ? maximum : length;
+    length = (length > reader->remaining) ? reader->remaining : length;
+
+    reader->offset += length;
+    reader->remaining -= length;
+    *lengthPtr = length;
+    return bytes;
+}
+
+/*
+ * Copies the next `length` bytes of the region to `output`, across iovec extents if need be.
+ */
+static void
+_ccnxValidationSHA256Batch_ReaderCopy(_SHA256BatchReader *reader, size_t length, uint8_t *output)
+{
+    while (length > 0) {
+        size_t spanLength;
+        const uint8_t *span = _ccnxValidationSHA256Batch_ReaderNext(reader, length, &spanLength);
+        memcpy(output, span, spanLength);
+        output += spanLength;
+        length -= spanLength;
+    }
+}
+
+static void
+_ccnxValidationSHA256Batch_ThreadExit(void *context)
+{
+    EVP_MD_CTX_free(context);
+}
+
+static void
+_ccnxValidationSHA256Batch_CreateContextKey(void)
+{
+    int failure = pthread_key_create(&_ccnxValidationSHA256Batch_ContextKey, _ccnxValidationSHA256Batch_ThreadExit);
+    trapUnexpectedStateIf(failure, "pthread_key_create failed: %d", failure);
+}
+
+/*
+ * The calling thread's digest context, created on first use and freed when the thread exits.
+ */
+static EVP_MD_CTX *
+_ccnxValidationSHA256Batch_GetThreadContext(void)
+{
+    pthread_once(&_ccnxValidationSHA256Batch_ContextKeyOnce, _ccnxValidationSHA256Batch_CreateContextKey);
+
+    EVP_MD_CTX *context = pthread_getspecific(_ccnxValidationSHA256Batch_ContextKey);
+    if (context == NULL) {
+        context = EVP_MD_CTX_new();
+        assertNotNull(context, "EVP_MD_CTX_new returned NULL");
+        pthread_setspecific(_ccnxValidationSHA256Batch_ContextKey, context);
+    }
+    return context;
+}
+
+static void
+_ccnxValidationSHA256Batch_HashScalar(size_t count, const CCNxValidationSHA256BatchRegion regions[count],
+                                      uint8_t digests[count][CCNxValidationSHA256Batch_DigestLength])
+{
+    EVP_MD_CTX *context = (count > 0) ? _ccnxValidationSHA256Batch_GetThreadContext() : NULL;
+
+    for (size_t i = 0; i < count; i++) {
+        _SHA256BatchReader reader;
+        _ccnxValidationSHA256Batch_ReaderInit(&reader, &regions[i]);
+
+        int success = EVP_DigestInit_ex(context, EVP_sha256(), NULL);
+        while (success && reader.remaining > 0) {
+            size_t length;
+            const uint8_t *bytes = _ccnxValidationSHA256Batch_ReaderNext(&reader, reader.remaining, &length);
+            success = EVP_DigestUpdate(context, bytes, length);
+        }
+        success = success && EVP_DigestFinal_ex(context, digests[i], NULL);
+        trapUnexpectedStateIf(!success, "SHA256 digest failed");
+    }
+}
+
+#ifdef _ccnxValidationSHA256Batch_HaveAVX2
+
+static const uint32_t _ccnxValidationSHA256Batch_InitialHash[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static const uint32_t _ccnxValidationSHA256Batch_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/*
+ * One lane of the AVX2 implementation: the region it is hashing and where its digest goes.
+ */
+typedef struct sha256batch_lane {
+    _SHA256BatchReader reader;
+    size_t length;      // The region length, for the padding
+    size_t job;         // Index of the region in the caller's array
+    bool busy;
+    bool lengthBlock;   // The next block is the padding block holding only the length
+    uint8_t scratch[_ccnxValidationSHA256Batch_BlockLength];
+} _SHA256BatchLane;
+
+static void
+_ccnxValidationSHA256Batch_PutBitLength(uint8_t block[_ccnxValidationSHA256Batch_BlockLength], size_t length)
+{
+    uint64_t bits = (uint64_t) length * 8;
+    for (int i = 0; i < 8; i++) {
+        block[_ccnxValidationSHA256Batch_BlockLength - 1 - i] = (uint8_t) (bits >> (8 * i));
+    }
+}
+
+/*
+ * Returns the lane's next 64-byte block of the padded message.  Sets `*last` if it is the final block.
+ */
+static const uint8_t *
+_ccnxValidationSHA256Batch_NextBlock(_SHA256BatchLane *lane, bool *last)
+{
+    *last = false;
+
+    if (lane->reader.remaining >= _ccnxValidationSHA256Batch_BlockLength) {
+        size_t length;
+        const uint8_t *bytes = _ccnxValidationSHA256Batch_ReaderNext(&lane->reader, _ccnxValidationSHA256Batch_BlockLength, &length);
+        if (length == _ccnxValidationSHA256Batch_BlockLength) {
+            return bytes;
+        }
+        memcpy(lane->scratch, bytes, length);
+        _ccnxValidationSHA256Batch_ReaderCopy(&lane->reader, _ccnxValidationSHA256Batch_BlockLength - length, lane->scratch + length);
+        return lane->scratch;
+    }
+
+    if (lane->lengthBlock) {
+        memset(lane->scratch, 0, _ccnxValidationSHA256Batch_BlockLength - 8);
+        _ccnxValidationSHA256Batch_PutBitLength(lane->scratch, lane->length);
+        *last = true;
+        return lane->scratch;
+    }
+
+    // The tail: the last partial block, the 0x80 terminator, and the length if it fits.
+    size_t filled = lane->reader.remaining;
+    _ccnxValidationSHA256Batch_ReaderCopy(&lane->reader, filled, lane->scratch);
+    lane->scratch[filled++] = 0x80;
+    if (filled <= _ccnxValidationSHA256Batch_BlockLength - 8) {
+        memset(lane->scratch + filled, 0, _ccnxValidationSHA256Batch_BlockLength - 8 - filled);
+        _ccnxValidationSHA256Batch_PutBitLength(lane->scratch, lane->length);
+        *last = true;
+    } else {
+        memset(lane->scratch + filled, 0, _ccnxValidationSHA256Batch_BlockLength - filled);
+        lane->lengthBlock = true;
+    }
+    return lane->scratch;
+}
+
+#define _ROTR(x, n)     _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+#define _SIGMA0(x)      _mm256_xor_si256(_mm256_xor_si256(_ROTR((x), 2), _ROTR((x), 13)), _ROTR((x), 22))
+#define _SIGMA1(x)      _mm256_xor_si256(_mm256_xor_si256(_ROTR((x), 6), _ROTR((x), 11)), _ROTR((x), 25))
+#define _sigma0(x)      _mm256_xor_si256(_mm256_xor_si256(_ROTR((x), 7), _ROTR((x), 18)), _mm256_srli_epi32((x), 3))
+#define _sigma1(x)      _mm256_xor_si256(_mm256_xor_si256(_ROTR((x), 17), _ROTR((x), 19)), _mm256_srli_epi32((x), 10))
+#define _CH(e, f, g)    _mm256_xor_si256(_mm256_and_si256((e), (f)), _mm256_andnot_si256((e), (g)))
+#define _MAJ(a, b, c)   _mm256_or_si256(_mm256_and_si256((a), (b)), _mm256_and_si256(_mm256_or_si256((a), (b)), (c)))
+
+/*
+ * Runs the SHA256 compression function on one block per lane.  `state[w][lane]` is word `w` of a lane's
+ * intermediate hash.
+ */
+__attribute__((target("avx2")))
+static void
+_ccnxValidationSHA256Batch_CompressAVX2(uint32_t state[8][_ccnxValidationSHA256Batch_LaneCount],
+                                        const uint8_t *blocks[_ccnxValidationSHA256Batch_LaneCount])
+{
+    // Each 16-byte row of a block, byte swapped to big endian words, then transposed so that
+    // vector t holds message word t of every lane.
+    const __m256i byteSwap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                              3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    __m256i w[16];
+    for (int row = 0; row < 4; row++) {
+        __m256i r[8];
+        for (int lane = 0; lane < 4; lane++) {
+            // lanes 0-3 in the low halves, lanes 4-7 in the high halves
+            __m128i low = _mm_loadu_si128((const __m128i *) (blocks[lane] + 16 * row));
+            __m128i high = _mm_loadu_si128((const __m128i *) (blocks[lane + 4] + 16 * row));
+            r[lane] = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1), byteSwap);
+        }
+        // r[lane] = { w0 w1 w2 w3 | w0' w1' w2' w3' } for lanes (lane, lane + 4); transpose 4x4 within halves.
+        __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+        __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+        __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+        __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+        __m256i c0 = _mm256_unpacklo_epi64(t0, t2);
+        __m256i c1 = _mm256_unpackhi_epi64(t0, t2);
+        __m256i c2 = _mm256_unpacklo_epi64(t1, t3);
+        __m256i c3 = _mm256_unpackhi_epi64(t1, t3);
+        // c_k = { word k of lanes 0..3 | word k of lanes 4..7 }
+        w[4 * row + 0] = c0;
+        w[4 * row + 1] = c1;
+        w[4 * row + 2] = c2;
+        w[4 * row + 3] = c3;
+    }
+
+    __m256i a = _mm256_loadu_si256((const __m256i *) state[0]);
+    __m256i b = _mm256_loadu_si256((const __m256i *) state[1]);
+    __m256i c = _mm256_loadu_si256((const __m256i *) state[2]);
+    __m256i d = _mm256_loadu_si256((const __m256i *) state[3]);
+    __m256i e = _mm256_loadu_si256((const __m256i *) state[4]);
+    __m256i f = _mm256_loadu_si256((const __m256i *) state[5]);
+    __m256i g = _mm256_loadu_si256((const __m256i *) state[6]);
+    __m256i h = _mm256_loadu_si256((const __m256i *) state[7]);
+
+    for (int t = 0; t < 64; t++) {
+        if (t >= 16) {
+            w[t & 15] = _mm256_add_epi32(_mm256_add_epi32(_sigma1(w[(t - 2) & 15]), w[(t - 7) & 15]),
+                                         _mm256_add_epi32(_sigma0(w[(t - 15) & 15]), w[t & 15]));
+        }
+        __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, _SIGMA1(e)),
+                                      _mm256_add_epi32(_mm256_add_epi32(_CH(e, f, g), _mm256_set1_epi32((int) _ccnxValidationSHA256Batch_K[t])), w[t & 15]));
+        __m256i t2 = _mm256_add_epi32(_SIGMA0(a), _MAJ(a, b, c));
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(t1, t2);
+    }
+
+    _mm256_storeu_si256((__m256i *) state[0], _mm256_add_epi32(a, _mm256_loadu_si256((const __m256i *) state[0])));
+    _mm256_storeu_si256((__m256i *) state[1], _mm256_add_epi32(b, _mm256_loadu_si256((const __m256i *) state[1])));
+    _mm256_storeu_si256((__m256i *) state[2], _mm256_add_epi32(c, _mm256_loadu_si256((const __m256i *) state[2])));
+    _mm256_storeu_si256((__m256i *) state[3], _mm256_add_epi32(d, _mm256_loadu_si256((const __m256i *) state[3])));
+    _mm256_storeu_si256((__m256i *) state[4], _mm256_add_epi32(e, _mm256_loadu_si256((const __m256i *) state[4])));
+    _mm256_storeu_si256((__m256i *) state[5], _mm256_add_epi32(f, _mm256_loadu_si256((const __m256i *) state[5])));
+    _mm256_storeu_si256((__m256i *) state[6], _mm256_add_epi32(g, _mm256_loadu_si256((const __m256i *) state[6])));
+    _mm256_storeu_si256((__m256i *) state[7], _mm256_add_epi32(h, _mm256_loadu_si256((const __m256i *) state[7])));
+}
+
+#undef _ROTR
+#undef _SIGMA0
+#undef _SIGMA1
+#undef _sigma0
+#undef _sigma1
+#undef _CH
+#undef _MAJ
+
+static void
+_ccnxValidationSHA256Batch_HashAVX2(size_t count, const CCNxValidationSHA256BatchRegion regions[count],
+                                    uint8_t digests[count][CCNxValidationSHA256Batch_DigestLength])
+{
+    static const uint8_t idleBlock[_ccnxValidationSHA256Batch_BlockLength];
+
+    _SHA256BatchLane lanes[_ccnxValidationSHA256Batch_LaneCount];
+    uint32_t state[8][_ccnxValidationSHA256Batch_LaneCount];
+    size_t next = 0;
+    unsigned active = 0;
+
+    for (int lane = 0; lane < _ccnxValidationSHA256Batch_LaneCount; lane++) {
+        lanes[lane].busy = false;
+    }
+
+    for (;;) {
+        for (int lane = 0; lane < _ccnxValidationSHA256Batch_LaneCount && next < count; lane++) {
+            if (!lanes[lane].busy) {
+                _ccnxValidationSHA256Batch_ReaderInit(&lanes[lane].reader, &regions[next]);
+                lanes[lane].length = regions[next].length;
+                lanes[lane].job = next;
+                lanes[lane].busy = true;
+                lanes[lane].lengthBlock = false;
+                for (int word = 0; word < 8; word++) {
+                    state[word][lane] = _ccnxValidationSHA256Batch_InitialHash[word];
+                }
+                next++;
+                active++;
+            }
+        }
+
+        if (active == 0) {
+            break;
+        }
+
+        const uint8_t *blocks[_ccnxValidationSHA256Batch_LaneCount];
+        bool last[_ccnxValidationSHA256Batch_LaneCount];
+        for (int lane = 0; lane < _ccnxValidationSHA256Batch_LaneCount; lane++) {
+            last[lane] = false;
+            blocks[lane] = lanes[lane].busy ? _ccnxValidationSHA256Batch_NextBlock(&lanes[lane], &last[lane]) : idleBlock;
+        }
+
+        _ccnxValidationSHA256Batch_CompressAVX2(state, blocks);
+
+        for (int lane = 0; lane < _ccnxValidationSHA256Batch_LaneCount; lane++) {
+            if (last[lane]) {
+                uint8_t *digest = digests[lanes[lane].job];
+                for (int word = 0; word < 8; word++) {
+                    uint32_t value = state[word][lane];
+                    digest[4 * word + 0] = (uint8_t) (value >> 24);
+                    digest[4 * word + 1] = (uint8_t) (value >> 16);
+                    digest[4 * word + 2] = (uint8_t) (value >> 8);
+                    digest[4 * word + 3] = (uint8_t) value;
+                }
+                lanes[lane].busy = false;
+                active--;
+            }
+        }
+    }
+}
+#endif
+
+static void
+_ccnxValidationSHA256Batch_Init(void)
+{
+    _ccnxValidationSHA256Batch_Function = _ccnxValidationSHA256Batch_HashScalar;
+    _ccnxValidationSHA256Batch_Lanes = 1;
+#ifdef _ccnxValidationSHA256Batch_HaveAVX2
+    // With the SHA extensions, OpenSSL hashes one region faster than eight AVX2 lanes hash eight.
+    unsigned eax, ebx, ecx, edx;
+    bool haveSHA = __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & bit_SHA);
+
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && !haveSHA) {
+        _ccnxValidationSHA256Batch_Function = _ccnxValidationSHA256Batch_HashAVX2;
+        _ccnxValidationSHA256Batch_Lanes = _ccnxValidationSHA256Batch_LaneCount;
+    }
+#endif
+}
+
+void
+ccnxValidationSHA256Batch_Hash(size_t count, const CCNxValidationSHA256BatchRegion regions[count],
+                               uint8_t digests[count][CCNxValidationSHA256Batch_DigestLength])
+{
+    pthread_once(&_ccnxValidationSHA256Batch_InitOnce, _ccnxValidationSHA256Batch_Init);
+
+    // A single region gains nothing from the lanes
+    if (count < 2) {
+        _ccnxValidationSHA256Batch_HashScalar(count, regions, digests);
+    } else {
+        _ccnxValidationSHA256Batch_Function(count, regions, digests);
+    }
+}
+
+unsigned
+ccnxValidationSHA256Batch_GetLanes(void)
+{
+    pthread_once(&_ccnxValidationSHA256Batch_InitOnce, _ccnxValidationSHA256Batch_Init);
+    return _ccnxValidationSHA256Batch_Lanes;
+}
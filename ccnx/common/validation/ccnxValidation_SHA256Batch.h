@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file ccnxValidation_SHA256Batch.h
+ * @brief SHA256 of several byte regions at once
+ *
+ * Verifying a burst of received packets means hashing each packet's protected region.  These
+ * functions take the regions of a whole burst and return one SHA256 digest per region.  On CPUs with
+ * AVX2 but without the SHA extensions they run eight independent SHA256 computations in the lanes of
+ * the vector registers; elsewhere they hash the regions one after another with OpenSSL, which uses the
+ * SHA extensions when present.  The digests are identical either way.
+ *
+ * A region is a byte range of an iovec array, so a packet held as a `CCNxCodecNetworkBufferIoVec`
+ * or as a single contiguous buffer can be hashed without copying it.
+ *
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef CCNx_Common_ccnxValidation_SHA256Batch_h
+#define CCNx_Common_ccnxValidation_SHA256Batch_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/uio.h>
+
+/**
+ * The length, in bytes, of a SHA256 digest.
+ */
+#define CCNxValidationSHA256Batch_DigestLength 32
+
+/**
+ * The bytes [start, start + length) of the concatenation of `iov[0]` through `iov[iovcnt - 1]`.
+ */
+typedef struct ccnx_validation_sha256batch_region {
+    const struct iovec *iov;
+    int iovcnt;
+    size_t start;
+    size_t length;
+} CCNxValidationSHA256BatchRegion;
+
+/**
+ * Computes the SHA256 digest of each region.
+ *
+ * `digests[i]` receives the digest of `regions[i]`.  The caller must ensure each region lies within
+ * its iovec array.  Safe to call from several threads at once.
+ *
+ * @param [in] count The number of regions.
+ * @param [in] regions The regions to hash.
+ * @param [out] digests Receives one digest per region.
+ *
+ * Example:
+ * @code
+ * {
+ *     struct iovec iov[2] = { { header, headerLength }, { body, bodyLength } };
+ *     CCNxValidationSHA256BatchRegion regions[1] = { { .iov = iov, .iovcnt = 2, .start = 8, .length = headerLength + bodyLength - 8 } };
+ *     uint8_t digests[1][CCNxValidationSHA256Batch_DigestLength];
+ *     ccnxValidationSHA256Batch_Hash(1, regions, digests);
+ * }
+ * @endcode
+ */
+void ccnxValidationSHA256Batch_Hash(size_t count, const CCNxValidationSHA256BatchRegion regions[count],
+                                    uint8_t digests[count][CCNxValidationSHA256Batch_DigestLength]);
+
+/**
+ * The number of regions `ccnxValidationSHA256Batch_Hash()` hashes in parallel on this CPU.
+ *
+ * @return 8 The AVX2 implementation is in use
+ * @return 1 The regions are hashed one at a time
+ *
+ * Example:
+ * @code
+ * {
+ *     printf("SHA256 lanes: %u\n", ccnxValidationSHA256Batch_GetLanes());
+ * }
+ * @endcode
+ */
+unsigned ccnxValidationSHA256Batch_GetLanes(void);
+#endif // CCNx_Common_ccnxValidation_SHA256Batch_h
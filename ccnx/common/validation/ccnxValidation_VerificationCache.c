@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * The table is set associative: a key's first eight bytes pick a set of four entries, and a new key
+ * replaces an empty entry or the least recently used one in its set.  Each set belongs to one shard, and
+ * a shard's mutex guards its sets and its clock, which stamps entries as they are used.  Keys are SHA256
+ * values, so their bytes are already uniformly distributed and need no further hashing.
+ *
+ * The counters are shared by all shards and updated with atomic adds.
+ *
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include <pthread.h>
+
+#include <LongBow/runtime.h>
+
+#include <sys/uio.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+#include <parc/security/parc_CryptoHash.h>
+#include <parc/security/parc_CryptoSuite.h>
+#include <parc/security/parc_KeyId.h>
+#include <parc/security/parc_Signature.h>
+
+#include <ccnx/common/ccnx_WireFormatMessage.h>
+#include <ccnx/common/internal/ccnx_ValidationFacadeV1.h>
+#include <ccnx/common/validation/ccnxValidation_CRC32C.h>
+#include <ccnx/common/validation/ccnxValidation_SHA256Batch.h>
+#include <ccnx/common/validation/ccnxValidation_VerificationCache.h>
+
+#define _ccnxValidationVerificationCache_KeyLength 32
+#define _ccnxValidationVerificationCache_Ways 4
+#define _ccnxValidationVerificationCache_MaximumShards 64
+
+static const size_t _ccnxValidationVerificationCache_MinimumCapacity = 64;
+
+typedef struct ccnx_validation_verification_cache_entry {
+    uint8_t key[_ccnxValidationVerificationCache_KeyLength];
+    uint64_t stamp;     // When the entry was last used, 0 if the entry is empty
+} _CCNxValidationVerificationCacheEntry;
+
+typedef struct ccnx_validation_verification_cache_shard {
+    pthread_mutex_t lock;
+    uint64_t clock;
+} _CCNxValidationVerificationCacheShard;
+
+struct ccnx_validation_verification_cache {
+    size_t capacity;
+    size_t setMask;
+    size_t shardMask;
+    _CCNxValidationVerificationCacheShard *shards;
+    _CCNxValidationVerificationCacheEntry *entries;
+
+    // Updated atomically
+    size_t count;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t failures;
+    uint64_t evictions;
+};
+
+static bool
+_ccnxValidationVerificationCache_Destructor(CCNxValidationVerificationCache **cachePtr)
+{
+    CCNxValidationVerificationCache *cache = *cachePtr;
+
+    for (size_t i = 0; i <= cache->shardMask; i++) {
+        pthread_mutex_destroy(&cache->shards[i].lock);
+    }
+    parcMemory_Deallocate((void **) &cache->shards);
+    parcMemory_Deallocate((void **) &cache->entries);
+    return true;
+}
+
+parcObject_Override(CCNxValidationVerificationCache, PARCObject,
+                    .destructor = (PARCObjectDestructor *) _ccnxValidationVerificationCache_Destructor);
+
+parcObject_ImplementAcquire(ccnxValidationVerificationCache, CCNxValidationVerificationCache);
+
+parcObject_ImplementRelease(ccnxValidationVerificationCache, CCNxValidationVerificationCache);
+
+CCNxValidationVerificationCache *
+ccnxValidationVerificationCache_Create(size_t capacity)
+{
+    size_t rounded = _ccnxValidationVerificationCache_MinimumCapacity;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    size_t sets = rounded / _ccnxValidationVerificationCache_Ways;
+    size_t shards = (sets < _ccnxValidationVerificationCache_MaximumShards) ? sets : _ccnxValidationVerificationCache_MaximumShards;
+
+    CCNxValidationVerificationCache *cache = parcObject_CreateAndClearInstance(CCNxValidationVerificationCache);
+    if (cache != NULL) {
+        cache->capacity = rounded;
+        cache->setMask = sets - 1;
+        cache->shardMask = shards - 1;
+        cache->entries = parcMemory_AllocateAndClear(rounded * sizeof(_CCNxValidationVerificationCacheEntry));
+        assertNotNull(cache->entries, "parcMemory_AllocateAndClear(%zu) returned NULL", rounded * sizeof(_CCNxValidationVerificationCacheEntry));
+        cache->shards = parcMemory_AllocateAndClear(shards * sizeof(_CCNxValidationVerificationCacheShard));
+        assertNotNull(cache->shards, "parcMemory_AllocateAndClear(%zu) returned NULL", shards * sizeof(_CCNxValidationVerificationCacheShard));
+        for (size_t i = 0; i < shards; i++) {
+            pthread_mutex_init(&cache->shards[i].lock, NULL);
+        }
+    }
+    return cache;
+}
+
+static size_t
+_ccnxValidationVerificationCache_GetSet(const CCNxValidationVerificationCache *cache, const uint8_t key[_ccnxValidationVerificationCache_KeyLength])
+{
+    uint64_t bits;
+    memcpy(&bits, key, sizeof(bits));
+    return (size_t) bits & cache->setMask;
+}
+
+/*
+ * Returns true if the key is in the cache, and marks its entry as just used.
+ */
+static bool
+_ccnxValidationVerificationCache_Lookup(CCNxValidationVerificationCache *cache, const uint8_t key[_ccnxValidationVerificationCache_KeyLength])
+{
+    size_t set = _ccnxValidationVerificationCache_GetSet(cache, key);
+    _CCNxValidationVerificationCacheShard *shard = &cache->shards[set & cache->shardMask];
+    _CCNxValidationVerificationCacheEntry *entries = &cache->entries[set * _ccnxValidationVerificationCache_Ways];
+
+    bool found = false;
+    pthread_mutex_lock(&shard->lock);
+    for (int way = 0; way < _ccnxValidationVerificationCache_Ways; way++) {
+        if (entries[way].stamp != 0 && memcmp(entries[way].key, key, _ccnxValidationVerificationCache_KeyLength) == 0) {
+            entries[way].stamp = ++shard->clock;
+            found = true;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return found;
+}
+
+static void
+_ccnxValidationVerificationCache_Insert(CCNxValidationVerificationCache *cache, const uint8_t key[_ccnxValidationVerificationCache_KeyLength])
+{
+    size_t set = _ccnxValidationVerificationCache_GetSet(cache, key);
+    _CCNxValidationVerificationCacheShard *shard = &cache->shards[set & cache->shardMask];
+    _CCNxValidationVerificationCacheEntry *entries = &cache->entries[set * _ccnxValidationVerificationCache_Ways];
+
+    pthread_mutex_lock(&shard->lock);
+
+    // Another thread may have verified the same message meanwhile; otherwise take the oldest entry
+    _CCNxValidationVerificationCacheEntry *victim = &entries[0];
+    for (int way = 0; way < _ccnxValidationVerificationCache_Ways; way++) {
+        if (entries[way].stamp != 0 && memcmp(entries[way].key, key, _ccnxValidationVerificationCache_KeyLength) == 0) {
+            victim = &entries[way];
+            break;
+        }
+        if (entries[way].stamp < victim->stamp) {
+            victim = &entries[way];
+        }
+    }
+
+    if (victim->stamp == 0) {
+        __sync_fetch_and_add(&cache->count, 1);
+    } else if (memcmp(victim->key, key, _ccnxValidationVerificationCache_KeyLength) != 0) {
+        __sync_fetch_and_add(&cache->evictions, 1);
+    }
+    memcpy(victim->key, key, _ccnxValidationVerificationCache_KeyLength);
+    victim->stamp = ++shard->clock;
+
+    pthread_mutex_unlock(&shard->lock);
+}
+
+static void
+_ccnxValidationVerificationCache_PutLength(uint8_t length[4], size_t value)
+{
+    length[0] = (uint8_t) (value >> 24);
+    length[1] = (uint8_t) (value >> 16);
+    length[2] = (uint8_t) (value >> 8);
+    length[3] = (uint8_t) value;
+}
+
+/*
+ * The key is the SHA256 of `digest` (the protected region's SHA256), the crypto suite, the KeyId and the
+ * validation payload.  The KeyId and payload are length prefixed, so the boundary between them is unambiguous.
+ */
+static void
+_ccnxValidationVerificationCache_ComputeKey(const uint8_t digest[CCNxWireFormatMessage_SHA256DigestLength], PARCCryptoSuite suite,
+                                            const PARCBuffer *keyid, const PARCBuffer *payload,
+                                            uint8_t key[_ccnxValidationVerificationCache_KeyLength])
+{
+    uint8_t suiteBytes[4];
+    uint8_t keyidLength[4];
+    uint8_t payloadLength[4];
+    _ccnxValidationVerificationCache_PutLength(suiteBytes, suite);
+    _ccnxValidationVerificationCache_PutLength(keyidLength, parcBuffer_Remaining(keyid));
+    _ccnxValidationVerificationCache_PutLength(payloadLength, parcBuffer_Remaining(payload));
+
+    struct iovec iov[] = {
+        { .iov_base = (void *) digest,                                 .iov_len = CCNxWireFormatMessage_SHA256DigestLength },
+        { .iov_base = suiteBytes,                                      .iov_len = sizeof(suiteBytes)                       },
+        { .iov_base = keyidLength,                                     .iov_len = sizeof(keyidLength)                      },
+        { .iov_base = parcBuffer_Overlay((PARCBuffer *) keyid, 0),     .iov_len = parcBuffer_Remaining(keyid)              },
+        { .iov_base = payloadLength,                                   .iov_len = sizeof(payloadLength)                    },
+        { .iov_base = parcBuffer_Overlay((PARCBuffer *) payload, 0),   .iov_len = parcBuffer_Remaining(payload)            },
+    };
+    size_t length = 0;
+    for (size_t i = 0; i < sizeof(iov) / sizeof(iov[0]); i++) {
+        length += iov[i].iov_len;
+    }
+
+    // A batch of one hashes the gather list with the batch hasher's per-thread digest context
+    CCNxValidationSHA256BatchRegion region = { .iov = iov, .iovcnt = sizeof(iov) / sizeof(iov[0]), .start = 0, .length = length };
+    ccnxValidationSHA256Batch_Hash(1, &region, (uint8_t (*)[CCNxValidationSHA256Batch_DigestLength])key);
+}
+
+static PARCSigningAlgorithm
+_ccnxValidationVerificationCache_GetSigningAlgorithm(PARCCryptoSuite suite)
+{
+    switch (suite) {
+        case PARCCryptoSuite_RSA_SHA256:
+        case PARCCryptoSuite_RSA_SHA512:
+            return PARCSigningAlgorithm_RSA;
+        case PARCCryptoSuite_DSA_SHA256:
+            return PARCSigningAlgorithm_DSA;
+        case PARCCryptoSuite_HMAC_SHA256:
+        case PARCCryptoSuite_HMAC_SHA512:
+            return PARCSigningAlgorithm_HMAC;
+        case PARCCryptoSuite_EC_SECP_256K1:
+            return PARCSigningAlgorithm_ECDSA;
+        default:
+            return PARCSigningAlgorithm_UNKNOWN;
+    }
+}
+
+/*
+ * The uncached path: check the signature over the protected region.  `digest` is the protected region's
+ * SHA256, already computed for the cache key.  A public key signature over a SHA256 is checked against it
+ * directly; other suites (an HMAC is keyed, and some suites use SHA512) hash with the verifier's hasher.
+ */
+static bool
+_ccnxValidationVerificationCache_Verify(PARCVerifier *verifier, const CCNxTlvDictionary *message, PARCCryptoSuite suite,
+                                        const PARCBuffer *keyIdBuffer, PARCBuffer *payload,
+                                        uint8_t digest[CCNxWireFormatMessage_SHA256DigestLength])
+{
+    bool valid = false;
+
+    PARCKeyId *keyid = parcKeyId_Create((PARCBuffer *) keyIdBuffer);
+    PARCCryptoHashType hashType = parcCryptoSuite_GetCryptoHash(suite);
+    PARCSigningAlgorithm signingAlgorithm = _ccnxValidationVerificationCache_GetSigningAlgorithm(suite);
+
+    PARCCryptoHash *hash = NULL;
+    if (hashType == PARCCryptoHashType_SHA256 && signingAlgorithm != PARCSigningAlgorithm_HMAC) {
+        PARCBuffer *digestBuffer = parcBuffer_Wrap(digest, CCNxWireFormatMessage_SHA256DigestLength, 0, CCNxWireFormatMessage_SHA256DigestLength);
+        hash = parcCryptoHash_Create(PARCCryptoHashType_SHA256, digestBuffer);
+        parcBuffer_Release(&digestBuffer);
+    } else {
+        PARCCryptoHasher *hasher = parcVerifier_GetCryptoHasher(verifier, keyid, hashType);
+        if (hasher != NULL) {
+            hash = ccnxWireFormatMessage_HashProtectedRegion(message, hasher);
+        }
+    }
+
+    if (hash != NULL) {
+        PARCSignature *signature = parcSignature_Create(signingAlgorithm, hashType, payload);
+        valid = parcVerifier_VerifyDigestSignature(verifier, keyid, hash, suite, signature);
+        parcSignature_Release(&signature);
+        parcCryptoHash_Release(&hash);
+    }
+
+    parcKeyId_Release(&keyid);
+    return valid;
+}
+
+bool
+ccnxValidationVerificationCache_VerifyMessage(CCNxValidationVerificationCache *cache, PARCVerifier *verifier,
+                                              const CCNxTlvDictionary *message)
+{
+    assertNotNull(cache, "Parameter cache must be non-null");
+    assertNotNull(verifier, "Parameter verifier must be non-null");
+    assertNotNull(message, "Parameter message must be non-null");
+
+    if (ccnxTlvDictionary_GetSchemaVersion(message) != CCNxTlvDictionary_SchemaVersion_V1 || !ccnxValidationFacadeV1_HasCryptoSuite(message)) {
+        return false;
+    }
+
+    PARCCryptoSuite suite = ccnxValidationFacadeV1_GetCryptoSuite(message);
+    if (suite == PARCCryptoSuite_NULL_CRC32C) {
+        return ccnxValidationCRC32C_VerifyMessage(message);
+    }
+
+    PARCBuffer *keyid = ccnxValidationFacadeV1_GetKeyId(message);
+    PARCBuffer *payload = ccnxValidationFacadeV1_GetPayload(message);
+    if (keyid == NULL || payload == NULL) {
+        return false;
+    }
+
+    uint8_t digest[1][CCNxWireFormatMessage_SHA256DigestLength];
+    CCNxWireFormatMessage *wireFormat = (CCNxWireFormatMessage *) message;
+    if (ccnxWireFormatMessage_HashProtectedRegions(1, &wireFormat, digest, NULL) != 1) {
+        return false;
+    }
+
+    uint8_t key[_ccnxValidationVerificationCache_KeyLength];
+    _ccnxValidationVerificationCache_ComputeKey(digest[0], suite, keyid, payload, key);
+
+    if (_ccnxValidationVerificationCache_Lookup(cache, key)) {
+        __sync_fetch_and_add(&cache->hits, 1);
+        return true;
+    }
+
+    __sync_fetch_and_add(&cache->misses, 1);
+    bool valid = _ccnxValidationVerificationCache_Verify(verifier, message, suite, keyid, payload, digest[0]);
+    if (valid) {
+        _ccnxValidationVerificationCache_Insert(cache, key);
+    } else {
+        __sync_fetch_and_add(&cache->failures, 1);
+    }
+    return valid;
+}
+
+void
+ccnxValidationVerificationCache_Clear(CCNxValidationVerificationCache *cache)
+{
+    assertNotNull(cache, "Parameter cache must be non-null");
+
+    for (size_t shardIndex = 0; shardIndex <= cache->shardMask; shardIndex++) {
+        _CCNxValidationVerificationCacheShard *shard = &cache->shards[shardIndex];
+        pthread_mutex_lock(&shard->lock);
+        for (size_t set = shardIndex; set <= cache->setMask; set += cache->shardMask + 1) {
+            _CCNxValidationVerificationCacheEntry *entries = &cache->entries[set * _ccnxValidationVerificationCache_Ways];
+            for (int way = 0; way < _ccnxValidationVerificationCache_Ways; way++) {
+                if (entries[way].stamp != 0) {
+                    entries[way].stamp = 0;
+                    __sync_fetch_and_sub(&cache->count, 1);
+                }
+            }
+        }
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+void
+ccnxValidationVerificationCache_GetStatistics(const CCNxValidationVerificationCache *cache,
+                                              CCNxValidationVerificationCacheStatistics *statistics)
+{
+    assertNotNull(cache, "Parameter cache must be non-null");
+    assertNotNull(statistics, "Parameter statistics must be non-null");
+
+    statistics->capacity = cache->capacity;
+    statistics->entries = __atomic_load_n(&cache->count, __ATOMIC_RELAXED);
+    statistics->hits = __atomic_load_n(&cache->hits, __ATOMIC_RELAXED);
+    statistics->misses = __atomic_load_n(&cache->misses, __ATOMIC_RELAXED);
+    statistics->failures = __atomic_load_n(&cache->failures, __ATOMIC_RELAXED);
+    statistics->evictions = __atomic_load_n(&cache->evictions, __ATOMIC_RELAXED);
+}
+
+void
+ccnxValidationVerificationCache_Display(const CCNxValidationVerificationCache *cache, int indentation)
+{
+    CCNxValidationVerificationCacheStatistics statistics;
+    ccnxValidationVerificationCache_GetStatistics(cache, &statistics);
+
+    printf("%*sCCNxValidationVerificationCache %p entries %zu/%zu\n",
+           indentation * 3, "", (void *) cache, statistics.entries, statistics.capacity);
+    printf("%*s   hits %" PRIu64 " misses %" PRIu64 " failures %" PRIu64 " evictions %" PRIu64 "\n",
+           indentation * 3, "", statistics.hits, statistics.misses, statistics.failures, statistics.evictions);
+}
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file ccnxValidation_VerificationCache.h
+ * @brief Remembers which signed messages have already been verified
+ *
+ * In a multi-hop cache deployment every node verifies the same signed content object, and a node may
+ * see many copies of it.  A `CCNxValidationVerificationCache` sits in front of a `PARCVerifier` and
+ * remembers the messages that verified.  A repeated message then costs a SHA256 of its protected region
+ * and a table lookup rather than an RSA or ECDSA verification.
+ *
+ * An entry is keyed by the SHA256 of the protected region together with the KeyId, the crypto suite
+ * and the validation payload (the signature bits).  Two messages with the same protected region but
+ * different signatures are different entries, so a forged signature is never accepted because a good
+ * copy was seen before.  Only successful verifications are cached: a message that fails, perhaps because
+ * its key was not yet known, is verified again the next time it is seen.
+ *
+ * The cache holds a fixed number of entries, evicting the least recently used entry of a small set when
+ * full.  It may be shared by several threads; the table is split into independently locked shards.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxValidationVerificationCache *cache = ccnxValidationVerificationCache_Create(65536);
+ *
+ *     if (ccnxValidationVerificationCache_VerifyMessage(cache, verifier, message)) {
+ *         // forward or store the message
+ *     }
+ *
+ *     ccnxValidationVerificationCache_Release(&cache);
+ * }
+ * @endcode
+ *
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef CCNx_Common_ccnxValidation_VerificationCache_h
+#define CCNx_Common_ccnxValidation_VerificationCache_h
+
+#include <stdint.h>
+
+#include <parc/security/parc_Verifier.h>
+#include <ccnx/common/internal/ccnx_TlvDictionary.h>
+
+struct ccnx_validation_verification_cache;
+/**
+ * @typedef CCNxValidationVerificationCache
+ * @brief A bounded, thread-safe set of messages whose signature verified.
+ */
+typedef struct ccnx_validation_verification_cache CCNxValidationVerificationCache;
+
+/**
+ * @typedef CCNxValidationVerificationCacheStatistics
+ * @brief A snapshot of the counters of a `CCNxValidationVerificationCache`.
+ */
+typedef struct ccnx_validation_verification_cache_statistics {
+    size_t capacity;            /**< The most entries the cache holds */
+    size_t entries;             /**< Entries in the cache */
+    uint64_t hits;              /**< Messages accepted from the cache without calling the verifier */
+    uint64_t misses;            /**< Messages passed to the verifier */
+    uint64_t failures;          /**< Misses the verifier rejected */
+    uint64_t evictions;         /**< Entries replaced to make room for a new one */
+} CCNxValidationVerificationCacheStatistics;
+
+/**
+ * Create a verification cache.
+ *
+ * @param [in] capacity The number of entries.  It is rounded up to a power of two of at least 64.
+ *
+ * @return non-null A new `CCNxValidationVerificationCache`
+ * @return null An error
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxValidationVerificationCache *cache = ccnxValidationVerificationCache_Create(65536);
+ *     ccnxValidationVerificationCache_Release(&cache);
+ * }
+ * @endcode
+ */
+CCNxValidationVerificationCache *ccnxValidationVerificationCache_Create(size_t capacity);
+
+/**
+ * Increase the number of references to a `CCNxValidationVerificationCache`.
+ *
+ * @param [in] cache A `CCNxValidationVerificationCache` instance.
+ *
+ * @return The input `CCNxValidationVerificationCache` pointer.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxValidationVerificationCache *shared = ccnxValidationVerificationCache_Acquire(cache);
+ *     ccnxValidationVerificationCache_Release(&shared);
+ * }
+ * @endcode
+ */
+CCNxValidationVerificationCache *ccnxValidationVerificationCache_Acquire(const CCNxValidationVerificationCache *cache);
+
+/**
+ * Release a previously acquired reference to the specified instance,
+ * decrementing the reference count for the instance.
+ *
+ * The pointer to the instance is set to NULL as a side-effect of this function.
+ *
+ * If the invocation causes the last reference to the instance to be released,
+ * the instance is deallocated and the instance's implementation will perform
+ * additional cleanup and release other privately held references.
+ *
+ * @param [in,out] cachePtr A pointer to a pointer to the instance to release.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxValidationVerificationCache *cache = ccnxValidationVerificationCache_Create(1024);
+ *     ccnxValidationVerificationCache_Release(&cache);
+ * }
+ * @endcode
+ */
+void ccnxValidationVerificationCache_Release(CCNxValidationVerificationCache **cachePtr);
+
+/**
+ * Verify the signature of a decoded message, consulting the cache first.
+ *
+ * The message must be a V1 dictionary that went through the packet decoder, so its protected region
+ * and validation section are set.  If an entry for the message is in the cache, returns true without
+ * calling the verifier.  Otherwise the verifier checks the signature over the protected region and,
+ * if it is good, the message is added to the cache.
+ *
+ * A message must carry a KeyId to be cached.  CRC32C messages are checked with
+ * `ccnxValidationCRC32C_VerifyMessage()`, which is cheaper than a lookup, and never cached.
+ *
+ * The verifier must be the same for every call on a cache, or at least trust the same keys; an entry
+ * records that a message verified, not which verifier said so.  A `PARCVerifier` is not thread-safe, so
+ * threads sharing a cache should each pass their own verifier.
+ *
+ * @param [in] cache A `CCNxValidationVerificationCache` instance.
+ * @param [in] verifier The verifier to use on a miss.
+ * @param [in] message The decoded message.
+ *
+ * @return true The signature is good
+ * @return false The signature is bad, or the message is unsigned or has no protected region
+ *
+ * Example:
+ * @code
+ * {
+ *     if (!ccnxValidationVerificationCache_VerifyMessage(cache, verifier, message)) {
+ *         // drop the message
+ *     }
+ * }
+ * @endcode
+ */
+bool ccnxValidationVerificationCache_VerifyMessage(CCNxValidationVerificationCache *cache, PARCVerifier *verifier,
+                                                   const CCNxTlvDictionary *message);
+
+/**
+ * Remove every entry, for example after a key is revoked.  The counters are not reset.
+ *
+ * @param [in] cache A `CCNxValidationVerificationCache` instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcVerifier_RemoveKeyId(verifier, keyid);
+ *     ccnxValidationVerificationCache_Clear(cache);
+ * }
+ * @endcode
+ */
+void ccnxValidationVerificationCache_Clear(CCNxValidationVerificationCache *cache);
+
+/**
+ * Take a snapshot of the cache counters.
+ *
+ * The counters are updated without locks, so a snapshot taken while other threads verify may be
+ * slightly out of date.
+ *
+ * @param [in] cache A `CCNxValidationVerificationCache` instance.
+ * @param [out] statistics Filled in with the current counters.
+ *
+ * Example:
+ * @code
+ * {
+ *     CCNxValidationVerificationCacheStatistics statistics;
+ *     ccnxValidationVerificationCache_GetStatistics(cache, &statistics);
+ *     printf("%" PRIu64 " hits %" PRIu64 " misses\n", statistics.hits, statistics.misses);
+ * }
+ * @endcode
+ */
+void ccnxValidationVerificationCache_GetStatistics(const CCNxValidationVerificationCache *cache,
+                                                   CCNxValidationVerificationCacheStatistics *statistics);
+
+/**
+ * Print a human readable representation of the cache and its counters.
+ *
+ * @param [in] cache A `CCNxValidationVerificationCache` instance.
+ * @param [in] indentation The level of indentation to use to pretty-print the output.
+ *
+ * Example:
+ * @code
+ * {
+ *     ccnxValidationVerificationCache_Display(cache, 0);
+ * }
+ * @endcode
+ */
+void ccnxValidationVerificationCache_Display(const CCNxValidationVerificationCache *cache, int indentation);
+#endif // CCNx_Common_ccnxValidation_VerificationCache_h
@@ -67,6 +67,9 @@
 
 #include <sys/time.h>
 
+#include <ccnx/common/codec/ccnxCodec_TlvPacket.h>
+#include <ccnx/common/codec/schema_v1/testdata/v1_interest_nameA_crc32c.h>
+
 /*
  * Ground truth set derived from CRC RevEng http://reveng.sourceforge.net
  * e.g. reveng -c  -m CRC-32C 313233343536373839 gives the canonical check value 0xe306928e
@@ -122,6 +125,13 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, ccnxValidationCRC32C_CreateSigner);
     LONGBOW_RUN_TEST_CASE(Global, ccnxValidationCRC32C_CreateVerifier);
     LONGBOW_RUN_TEST_CASE(Global, ccnxValidationCRC32C_DictionaryCryptoSuiteValue);
+
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationCRC32C_Update);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationCRC32C_Update_Software);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationCRC32C_UpdateIoVec);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationCRC32C_VerifyMessage_Buffer);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationCRC32C_VerifyMessage_IoVec);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationCRC32C_VerifyMessage_Corrupt);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -234,6 +244,160 @@ LONGBOW_TEST_CASE(Global, ccnxValidationCRC32C_DictionaryCryptoSuiteValue)
     ccnxTlvDictionary_Release(&dictionary);
 }
 
+LONGBOW_TEST_CASE(Global, ccnxValidationCRC32C_Update)
+{
+    for (int i = 0; vectors[i].buffer != NULL; i++) {
+        uint32_t crc32c = ccnxValidationCRC32C_Update(0, vectors[i].length, vectors[i].buffer);
+        assertTrue(crc32c == vectors[i].crc32c, "CRC32C values wrong, index %d got 0x%08x expected 0x%08x",
+                   i, crc32c, vectors[i].crc32c);
+
+        // Continuing the CRC over a split gives the same answer
+        size_t split = vectors[i].length / 2;
+        crc32c = ccnxValidationCRC32C_Update(0, split, vectors[i].buffer);
+        crc32c = ccnxValidationCRC32C_Update(crc32c, vectors[i].length - split, vectors[i].buffer + split);
+        assertTrue(crc32c == vectors[i].crc32c, "Split CRC32C values wrong, index %d got 0x%08x expected 0x%08x",
+                   i, crc32c, vectors[i].crc32c);
+    }
+}
+
+/**
+ * The software path must agree with the bit-at-a-time definition at every alignment and length,
+ * whether or not this machine uses the hardware path.
+ */
+LONGBOW_TEST_CASE(Global, ccnxValidationCRC32C_Update_Software)
+{
+    uint8_t buffer[256 + 8];
+    for (int i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t) (i * 37 + 11);
+    }
+
+    // Initializes the tables
+    ccnxValidationCRC32C_Update(0, 0, buffer);
+
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t length = 0; length <= 256; length++) {
+            uint32_t expected = 0xFFFFFFFF;
+            for (size_t i = 0; i < length; i++) {
+                expected ^= buffer[offset + i];
+                for (int bit = 0; bit < 8; bit++) {
+                    expected = (expected & 1) ? (expected >> 1) ^ _ccnxValidationCRC32C_Polynomial : expected >> 1;
+                }
+            }
+            expected = ~expected;
+
+            uint32_t software = ~_ccnxValidationCRC32C_UpdateSoftware(0xFFFFFFFF, length, &buffer[offset]);
+            assertTrue(software == expected, "Software CRC32C wrong, offset %zu length %zu got 0x%08x expected 0x%08x",
+                       offset, length, software, expected);
+
+            uint32_t crc32c = ccnxValidationCRC32C_Update(0, length, &buffer[offset]);
+            assertTrue(crc32c == expected, "CRC32C wrong, offset %zu length %zu got 0x%08x expected 0x%08x",
+                       offset, length, crc32c, expected);
+        }
+    }
+}
+
+static size_t
+_smallBlockAllocator(void *userarg, size_t bytes, void **output)
+{
+    // 32 bytes is needed for bookkeeping, so this gives 32-byte memory blocks
+    bytes = (bytes > 64) ? 64 : bytes;
+    *output = parcMemory_Allocate(bytes);
+    return bytes;
+}
+
+static void
+_smallBlockDeallocator(void *userarg, void **memory)
+{
+    parcMemory_Deallocate(memory);
+}
+
+static const CCNxCodecNetworkBufferMemoryBlockFunctions _smallBlocks = {
+    .allocator   = &_smallBlockAllocator,
+    .deallocator = &_smallBlockDeallocator
+};
+
+static CCNxCodecNetworkBufferIoVec *
+_createSmallBlockIoVec(size_t length, uint8_t bytes[length])
+{
+    CCNxCodecNetworkBuffer *netbuff = ccnxCodecNetworkBuffer_Create(&_smallBlocks, NULL);
+    ccnxCodecNetworkBuffer_PutArray(netbuff, length, bytes);
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecNetworkBuffer_CreateIoVec(netbuff);
+    ccnxCodecNetworkBuffer_Release(&netbuff);
+    return vec;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationCRC32C_UpdateIoVec)
+{
+    uint8_t bytes[200];
+    for (int i = 0; i < sizeof(bytes); i++) {
+        bytes[i] = (uint8_t) i;
+    }
+
+    CCNxCodecNetworkBufferIoVec *vec = _createSmallBlockIoVec(sizeof(bytes), bytes);
+    assertTrue(ccnxCodecNetworkBufferIoVec_GetCount(vec) > 1, "Expected the iovec to have several extents");
+
+    size_t regions[][2] = { { 0, 200 }, { 0, 0 }, { 5, 20 }, { 31, 2 }, { 40, 100 }, { 199, 1 } };
+    for (int i = 0; i < sizeof(regions) / sizeof(regions[0]); i++) {
+        size_t start = regions[i][0];
+        size_t length = regions[i][1];
+        uint32_t expected = ccnxValidationCRC32C_Update(0, length, &bytes[start]);
+        uint32_t actual = ccnxValidationCRC32C_UpdateIoVec(0, vec, start, length);
+        assertTrue(actual == expected, "Wrong CRC32C for region {%zu, %zu}, got 0x%08x expected 0x%08x",
+                   start, length, actual, expected);
+    }
+
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationCRC32C_VerifyMessage_Buffer)
+{
+    PARCBuffer *wireFormat = parcBuffer_Wrap(v1_interest_nameA_crc32c, sizeof(v1_interest_nameA_crc32c), 0, sizeof(v1_interest_nameA_crc32c));
+    CCNxTlvDictionary *message = ccnxCodecTlvPacket_Decode(wireFormat);
+    assertNotNull(message, "Failed to decode the packet");
+
+    assertFalse(ccnxValidationCRC32C_VerifyMessage(message), "Should not verify without a wire format");
+
+    parcBuffer_Rewind(wireFormat);
+    ccnxTlvDictionary_PutBuffer(message, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_WireFormat, wireFormat);
+    assertTrue(ccnxValidationCRC32C_VerifyMessage(message), "Failed to verify the CRC32C");
+    assertTrue(parcBuffer_Position(wireFormat) == 0, "The wire format position should be unchanged");
+
+    ccnxTlvDictionary_Release(&message);
+    parcBuffer_Release(&wireFormat);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationCRC32C_VerifyMessage_IoVec)
+{
+    CCNxCodecNetworkBufferIoVec *vec = _createSmallBlockIoVec(sizeof(v1_interest_nameA_crc32c), v1_interest_nameA_crc32c);
+
+    CCNxTlvDictionary *message = ccnxCodecSchemaV1TlvDictionary_CreateInterest();
+    assertTrue(ccnxCodecTlvPacket_IoVecDecode(vec, message), "Failed to decode the packet");
+    assertTrue(ccnxValidationCRC32C_VerifyMessage(message), "Failed to verify the CRC32C over the iovec");
+
+    ccnxTlvDictionary_Release(&message);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationCRC32C_VerifyMessage_Corrupt)
+{
+    uint8_t packet[sizeof(v1_interest_nameA_crc32c)];
+    memcpy(packet, v1_interest_nameA_crc32c, sizeof(packet));
+
+    // Change the last byte of the name, which is inside the protected region
+    packet[48] ^= 0x01;
+
+    PARCBuffer *wireFormat = parcBuffer_Wrap(packet, sizeof(packet), 0, sizeof(packet));
+    CCNxTlvDictionary *message = ccnxCodecTlvPacket_Decode(wireFormat);
+    assertNotNull(message, "Failed to decode the packet");
+
+    parcBuffer_Rewind(wireFormat);
+    ccnxTlvDictionary_PutBuffer(message, CCNxCodecSchemaV1TlvDictionary_HeadersFastArray_WireFormat, wireFormat);
+    assertFalse(ccnxValidationCRC32C_VerifyMessage(message), "Should not verify a corrupted packet");
+
+    ccnxTlvDictionary_Release(&message);
+    parcBuffer_Release(&wireFormat);
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include "../ccnxValidation_SHA256Batch.c"
+
+#include <stdio.h>
+#include <sys/time.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+#include <LongBow/unit-test.h>
+
+LONGBOW_TEST_RUNNER(ccnxValidation_SHA256Batch)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Local);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(ccnxValidation_SHA256Batch)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(ccnxValidation_SHA256Batch)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * A deterministic pseudo-random byte, so failures are reproducible.
+ */
+static uint8_t
+_testByte(size_t i)
+{
+    return (uint8_t) ((i * 2654435761u) >> 13);
+}
+
+/*
+ * Splits `length` bytes of `buffer` into `iovcnt` extents of varying size, some of them empty.
+ */
+static void
+_splitIoVec(uint8_t *buffer, size_t length, int iovcnt, struct iovec iov[iovcnt], unsigned seed)
+{
+    size_t offset = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        size_t extent = (i == iovcnt - 1) ? length - offset : (seed * (i + 7)) % (length - offset + 1);
+        iov[i].iov_base = buffer + offset;
+        iov[i].iov_len = extent;
+        offset += extent;
+    }
+}
+
+/*
+ * Hashes `count` regions of assorted lengths, offsets and extents with `function` and checks each
+ * digest against OpenSSL's one-shot SHA256.
+ */
+static void
+_assertBatchMatchesSHA256(_SHA256BatchFunction *function, size_t count)
+{
+    const size_t maximum = 1100;
+    uint8_t *buffers[count];
+    struct iovec iov[count][4];
+    CCNxValidationSHA256BatchRegion regions[count];
+    uint8_t digests[count][CCNxValidationSHA256Batch_DigestLength];
+
+    for (size_t i = 0; i < count; i++) {
+        // Cover every length around the 55/56/64 byte padding boundaries, then larger ones
+        size_t length = (i < 140) ? i : (i * 37) % maximum;
+        size_t start = i % 5;
+        size_t total = start + length + (i % 3);
+
+        buffers[i] = parcMemory_Allocate(total + 1);
+        for (size_t j = 0; j < total; j++) {
+            buffers[i][j] = _testByte(i * maximum + j);
+        }
+        _splitIoVec(buffers[i], total, 1 + (int) (i % 4), iov[i], (unsigned) i);
+        regions[i] = (CCNxValidationSHA256BatchRegion) { .iov = iov[i], .iovcnt = 1 + (int) (i % 4), .start = start, .length = length };
+    }
+
+    function(count, regions, digests);
+
+    for (size_t i = 0; i < count; i++) {
+        uint8_t expected[CCNxValidationSHA256Batch_DigestLength];
+        EVP_Digest(buffers[i] + regions[i].start, regions[i].length, expected, NULL, EVP_sha256(), NULL);
+        assertTrue(memcmp(expected, digests[i], sizeof(expected)) == 0,
+                   "Wrong digest for region %zu, start %zu length %zu iovcnt %d",
+                   i, regions[i].start, regions[i].length, regions[i].iovcnt);
+        parcMemory_Deallocate(&buffers[i]);
+    }
+}
+
+// ===========================================================
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationSHA256Batch_Hash);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationSHA256Batch_Hash_KnownAnswer);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationSHA256Batch_Hash_Zero);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationSHA256Batch_GetLanes);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationSHA256Batch_Hash)
+{
+    _assertBatchMatchesSHA256(ccnxValidationSHA256Batch_Hash, 1);
+    _assertBatchMatchesSHA256(ccnxValidationSHA256Batch_Hash, 7);
+    _assertBatchMatchesSHA256(ccnxValidationSHA256Batch_Hash, 200);
+}
+
+/*
+ * FIPS 180-2 test vectors "abc" and the two-block "abcdbcde...nopq", hashed in one batch.
+ */
+LONGBOW_TEST_CASE(Global, ccnxValidationSHA256Batch_Hash_KnownAnswer)
+{
+    char abc[] = "abc";
+    char twoBlock[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    struct iovec iov[2] = {
+        { .iov_base = abc,      .iov_len = strlen(abc)      },
+        { .iov_base = twoBlock, .iov_len = strlen(twoBlock) },
+    };
+    CCNxValidationSHA256BatchRegion regions[2] = {
+        { .iov = &iov[0], .iovcnt = 1, .start = 0, .length = iov[0].iov_len },
+        { .iov = &iov[1], .iovcnt = 1, .start = 0, .length = iov[1].iov_len },
+    };
+    uint8_t expected[2][CCNxValidationSHA256Batch_DigestLength] = {
+        { 0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+          0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad },
+        { 0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+          0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1 },
+    };
+
+    uint8_t digests[2][CCNxValidationSHA256Batch_DigestLength];
+    ccnxValidationSHA256Batch_Hash(2, regions, digests);
+
+    assertTrue(memcmp(expected[0], digests[0], CCNxValidationSHA256Batch_DigestLength) == 0, "Wrong digest for \"abc\"");
+    assertTrue(memcmp(expected[1], digests[1], CCNxValidationSHA256Batch_DigestLength) == 0, "Wrong digest for the two block vector");
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationSHA256Batch_Hash_Zero)
+{
+    // Must not touch the (NULL) arrays
+    ccnxValidationSHA256Batch_Hash(0, NULL, NULL);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationSHA256Batch_GetLanes)
+{
+    unsigned lanes = ccnxValidationSHA256Batch_GetLanes();
+    assertTrue(lanes == 1 || lanes == _ccnxValidationSHA256Batch_LaneCount, "Unexpected lane count %u", lanes);
+}
+
+// ===========================================================
+
+LONGBOW_TEST_FIXTURE(Local)
+{
+    LONGBOW_RUN_TEST_CASE(Local, _ccnxValidationSHA256Batch_HashScalar);
+    LONGBOW_RUN_TEST_CASE(Local, _ccnxValidationSHA256Batch_GetThreadContext);
+    LONGBOW_RUN_TEST_CASE(Local, _ccnxValidationSHA256Batch_HashAVX2);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Local)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Local)
+{
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Local, _ccnxValidationSHA256Batch_HashScalar)
+{
+    _assertBatchMatchesSHA256(_ccnxValidationSHA256Batch_HashScalar, 200);
+}
+
+LONGBOW_TEST_CASE(Local, _ccnxValidationSHA256Batch_GetThreadContext)
+{
+    EVP_MD_CTX *context = _ccnxValidationSHA256Batch_GetThreadContext();
+    assertNotNull(context, "Expected a digest context");
+    assertTrue(_ccnxValidationSHA256Batch_GetThreadContext() == context, "Expected the thread to reuse its digest context");
+}
+
+/**
+ * The AVX2 lanes must agree with OpenSSL whether or not the dispatcher would pick them on this machine.
+ */
+LONGBOW_TEST_CASE(Local, _ccnxValidationSHA256Batch_HashAVX2)
+{
+#ifdef _ccnxValidationSHA256Batch_HaveAVX2
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("avx2")) {
+        testSkip("This CPU does not have AVX2");
+    }
+
+    // Fewer regions than lanes, exactly one per lane, and enough that lanes are refilled
+    _assertBatchMatchesSHA256(_ccnxValidationSHA256Batch_HashAVX2, 3);
+    _assertBatchMatchesSHA256(_ccnxValidationSHA256Batch_HashAVX2, _ccnxValidationSHA256Batch_LaneCount);
+    _assertBatchMatchesSHA256(_ccnxValidationSHA256Batch_HashAVX2, 200);
+#else
+    testSkip("No AVX2 implementation on this platform");
+#endif
+}
+
+// ===========================================================
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, ccnxValidationSHA256Batch_Hash);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_timeBatch(_SHA256BatchFunction *function, size_t count, const CCNxValidationSHA256BatchRegion regions[count],
+           uint8_t digests[count][CCNxValidationSHA256Batch_DigestLength], unsigned iterations)
+{
+    struct timeval t0, t1, delta;
+    gettimeofday(&t0, NULL);
+    for (unsigned i = 0; i < iterations; i++) {
+        function(count, regions, digests);
+    }
+    gettimeofday(&t1, NULL);
+    timersub(&t1, &t0, &delta);
+    return delta.tv_sec + delta.tv_usec * 1E-6;
+}
+
+/*
+ * MB/s of one region at a time against the dispatched batch and the AVX2 lanes, for bursts of 64
+ * packets from 100 bytes to 8 KB.
+ */
+LONGBOW_TEST_CASE(Performance, ccnxValidationSHA256Batch_Hash)
+{
+    const size_t burst = 64;
+    const size_t sizes[] = { 100, 256, 512, 1024, 1500, 4096, 8192 };
+
+    printf("lanes %u\n", ccnxValidationSHA256Batch_GetLanes());
+    printf("%6s %12s %12s %12s\n", "bytes", "scalar MB/s", "batch MB/s", "avx2 MB/s");
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t size = sizes[s];
+        uint8_t *buffer = parcMemory_AllocateAndClear(burst * size);
+        struct iovec iov[burst];
+        CCNxValidationSHA256BatchRegion regions[burst];
+        uint8_t digests[burst][CCNxValidationSHA256Batch_DigestLength];
+
+        for (size_t i = 0; i < burst; i++) {
+            iov[i].iov_base = buffer + i * size;
+            iov[i].iov_len = size;
+            regions[i] = (CCNxValidationSHA256BatchRegion) { .iov = &iov[i], .iovcnt = 1, .start = 0, .length = size };
+        }
+
+        unsigned iterations = (unsigned) (200000000 / (burst * size));
+        double megabytes = (double) iterations * burst * size / 1E6;
+
+        double scalar = _timeBatch(_ccnxValidationSHA256Batch_HashScalar, burst, regions, digests, iterations);
+        double batch = _timeBatch(ccnxValidationSHA256Batch_Hash, burst, regions, digests, iterations);
+        double avx2 = 0;
+#ifdef _ccnxValidationSHA256Batch_HaveAVX2
+        if (__builtin_cpu_supports("avx2")) {
+            avx2 = _timeBatch(_ccnxValidationSHA256Batch_HashAVX2, burst, regions, digests, iterations);
+        }
+#endif
+        printf("%6zu %12.0f %12.0f %12.0f\n", size, megabytes / scalar, megabytes / batch, (avx2 > 0) ? megabytes / avx2 : 0.0);
+
+        parcMemory_Deallocate(&buffer);
+    }
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(ccnxValidation_SHA256Batch);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -0,0 +1,511 @@
+/*
+ * Copyright (c) 2013-2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../ccnxValidation_VerificationCache.c"
+
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/security/parc_CryptoHasher.h>
+
+#include <LongBow/unit-test.h>
+
+#include <ccnx/common/ccnx_ContentObject.h>
+#include <ccnx/common/codec/ccnxCodec_TlvPacket.h>
+#include <ccnx/common/validation/ccnxValidation_HmacSha256.h>
+#include <ccnx/common/validation/ccnxValidation_RsaSha256.h>
+
+/*
+ * A verifier that accepts a signature whose first byte is 1, counts how often it is asked, and remembers
+ * the last digest it was given.
+ */
+typedef struct test_verifier {
+    PARCCryptoHasher *hasher;
+    unsigned hasherRequests;
+    unsigned verifications;
+    uint8_t digest[CCNxWireFormatMessage_SHA256DigestLength];
+} _TestVerifier;
+
+static bool
+_testVerifier_Destructor(_TestVerifier **verifierPtr)
+{
+    parcCryptoHasher_Release(&(*verifierPtr)->hasher);
+    return true;
+}
+
+parcObject_ImplementAcquire(_testVerifier, _TestVerifier);
+parcObject_ImplementRelease(_testVerifier, _TestVerifier);
+
+parcObject_Override(_TestVerifier, PARCObject,
+                    .destructor = (PARCObjectDestructor *) _testVerifier_Destructor);
+
+static PARCCryptoHasher *
+_testVerifier_GetCryptoHasher(_TestVerifier *verifier, PARCKeyId *keyid, PARCCryptoHashType hashType)
+{
+    verifier->hasherRequests++;
+    return verifier->hasher;
+}
+
+static bool
+_testVerifier_VerifyDigest(_TestVerifier *verifier, PARCKeyId *keyid, PARCCryptoHash *locallyComputedHash,
+                           PARCCryptoSuite suite, PARCSignature *signatureToVerify)
+{
+    verifier->verifications++;
+    PARCBuffer *digest = parcCryptoHash_GetDigest(locallyComputedHash);
+    if (parcBuffer_Remaining(digest) == sizeof(verifier->digest)) {
+        memcpy(verifier->digest, parcBuffer_Overlay(digest, 0), sizeof(verifier->digest));
+    }
+    PARCBuffer *bits = parcSignature_GetSignature(signatureToVerify);
+    return parcBuffer_Remaining(bits) > 0 && parcBuffer_GetAtIndex(bits, 0) == 1;
+}
+
+static bool
+_testVerifier_AllowedCryptoSuite(_TestVerifier *verifier, PARCKeyId *keyid, PARCCryptoSuite suite)
+{
+    return true;
+}
+
+static PARCVerifierInterface *_testVerifierInterface = &(PARCVerifierInterface) {
+    .GetCryptoHasher    = (PARCCryptoHasher *(*)(void *, PARCKeyId *, PARCCryptoHashType))_testVerifier_GetCryptoHasher,
+    .VerifyDigest       = (bool (*)(void *, PARCKeyId *, PARCCryptoHash *, PARCCryptoSuite, PARCSignature *))_testVerifier_VerifyDigest,
+    .AddKey             = NULL,
+    .RemoveKeyId        = NULL,
+    .AllowedCryptoSuite = (bool (*)(void *, PARCKeyId *, PARCCryptoSuite))_testVerifier_AllowedCryptoSuite,
+};
+
+typedef struct test_data {
+    _TestVerifier *testVerifier;
+    PARCVerifier *verifier;
+    PARCBuffer *keyid;
+} TestData;
+
+static TestData *
+_commonSetup(void)
+{
+    TestData *data = parcMemory_AllocateAndClear(sizeof(TestData));
+    assertNotNull(data, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(TestData));
+
+    data->testVerifier = parcObject_CreateAndClearInstance(_TestVerifier);
+    data->testVerifier->hasher = parcCryptoHasher_Create(PARCCryptoHashType_SHA256);
+    data->verifier = parcVerifier_Create(data->testVerifier, _testVerifierInterface);
+    data->keyid = parcBuffer_WrapCString("the keyid");
+    return data;
+}
+
+static void
+_commonTeardown(TestData *data)
+{
+    parcBuffer_Release(&data->keyid);
+    parcVerifier_Release(&data->verifier);
+    _testVerifier_Release(&data->testVerifier);
+    parcMemory_Deallocate((void **) &data);
+}
+
+/*
+ * Encode and decode a ContentObject whose signature is 32 bytes of `marker`, signed with HMAC-SHA256 or,
+ * if `rsa` is true, RSA-SHA256.
+ */
+static CCNxTlvDictionary *
+_createSignedMessageWithSuite(const char *uri, const PARCBuffer *keyid, uint8_t marker, bool rsa)
+{
+    CCNxName *name = ccnxName_CreateFromCString(uri);
+    PARCBuffer *payload = parcBuffer_WrapCString("the payload");
+    CCNxContentObject *contentObject = ccnxContentObject_CreateWithNameAndPayload(name, payload);
+    parcBuffer_Release(&payload);
+    ccnxName_Release(&name);
+
+    if (keyid != NULL) {
+        if (rsa) {
+            ccnxValidationRsaSha256_Set(contentObject, keyid, NULL);
+        } else {
+            ccnxValidationHmacSha256_Set(contentObject, keyid);
+        }
+    }
+
+    uint8_t bits[32];
+    memset(bits, marker, sizeof(bits));
+    PARCBuffer *signature = parcBuffer_Flip(parcBuffer_PutArray(parcBuffer_Allocate(sizeof(bits)), sizeof(bits), bits));
+    ccnxValidationFacadeV1_SetPayload(contentObject, signature);
+    parcBuffer_Release(&signature);
+
+    CCNxCodecNetworkBufferIoVec *vec = ccnxCodecTlvPacket_DictionaryEncode(contentObject, NULL);
+    ccnxContentObject_Release(&contentObject);
+
+    PARCBuffer *wireFormat = parcBuffer_Allocate(ccnxCodecNetworkBufferIoVec_Length(vec));
+    const struct iovec *iov = ccnxCodecNetworkBufferIoVec_GetArray(vec);
+    for (int i = 0; i < ccnxCodecNetworkBufferIoVec_GetCount(vec); i++) {
+        parcBuffer_PutArray(wireFormat, iov[i].iov_len, iov[i].iov_base);
+    }
+    parcBuffer_Flip(wireFormat);
+    ccnxCodecNetworkBufferIoVec_Release(&vec);
+
+    CCNxTlvDictionary *message = ccnxWireFormatMessage_Create(wireFormat);
+    bool success = ccnxCodecTlvPacket_BufferDecode(wireFormat, message);
+    assertTrue(success, "Failed to decode the signed message");
+    parcBuffer_Release(&wireFormat);
+
+    return message;
+}
+
+static CCNxTlvDictionary *
+_createSignedMessage(const char *uri, const PARCBuffer *keyid, uint8_t marker)
+{
+    return _createSignedMessageWithSuite(uri, keyid, marker, false);
+}
+
+LONGBOW_TEST_RUNNER(ccnxValidation_VerificationCache)
+{
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(ccnxValidation_VerificationCache)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(ccnxValidation_VerificationCache)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// ===========================================================
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationVerificationCache_Create);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationVerificationCache_AcquireRelease);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationVerificationCache_VerifyMessage_Hit);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationVerificationCache_VerifyMessage_Digest);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationVerificationCache_VerifyMessage_BadSignature);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationVerificationCache_VerifyMessage_NoKeyId);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationVerificationCache_VerifyMessage_Eviction);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationVerificationCache_VerifyMessage_Threads);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationVerificationCache_Clear);
+    LONGBOW_RUN_TEST_CASE(Global, ccnxValidationVerificationCache_Display);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    longBowTestCase_SetClipBoardData(testCase, _commonSetup());
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    _commonTeardown(longBowTestCase_GetClipBoardData(testCase));
+
+    uint32_t outstandingAllocations = parcSafeMemory_ReportAllocation(STDERR_FILENO);
+    if (outstandingAllocations != 0) {
+        printf("%s leaks memory by %d allocations\n", longBowTestCase_GetName(testCase), outstandingAllocations);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationVerificationCache_Create)
+{
+    size_t requested[] = { 0, 1, 64, 65, 1000 };
+    size_t expected[] = { 64, 64, 64, 128, 1024 };
+
+    for (int i = 0; i < sizeof(requested) / sizeof(requested[0]); i++) {
+        CCNxValidationVerificationCache *cache = ccnxValidationVerificationCache_Create(requested[i]);
+        assertNotNull(cache, "Expected non-null return from ccnxValidationVerificationCache_Create");
+
+        CCNxValidationVerificationCacheStatistics statistics;
+        ccnxValidationVerificationCache_GetStatistics(cache, &statistics);
+        assertTrue(statistics.capacity == expected[i], "Capacity %zu: expected %zu got %zu", requested[i], expected[i], statistics.capacity);
+        assertTrue(statistics.entries == 0 && statistics.hits == 0 && statistics.misses == 0, "Expected a new cache to be empty");
+
+        ccnxValidationVerificationCache_Release(&cache);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationVerificationCache_AcquireRelease)
+{
+    CCNxValidationVerificationCache *cache = ccnxValidationVerificationCache_Create(64);
+    CCNxValidationVerificationCache *second = ccnxValidationVerificationCache_Acquire(cache);
+    assertTrue(second == cache, "Expected Acquire to return the same instance");
+
+    ccnxValidationVerificationCache_Release(&second);
+    assertNull(second, "Expected Release to NULL the pointer");
+    ccnxValidationVerificationCache_Release(&cache);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationVerificationCache_VerifyMessage_Hit)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxValidationVerificationCache *cache = ccnxValidationVerificationCache_Create(64);
+    CCNxTlvDictionary *message = _createSignedMessage("lci:/cache/hit", data->keyid, 1);
+
+    for (int i = 0; i < 5; i++) {
+        assertTrue(ccnxValidationVerificationCache_VerifyMessage(cache, data->verifier, message), "Expected verification %d to pass", i);
+    }
+    assertTrue(data->testVerifier->verifications == 1, "Expected the verifier to be called once, got %u", data->testVerifier->verifications);
+
+    // A second copy of the same wire format is the same entry
+    CCNxTlvDictionary *copy = _createSignedMessage("lci:/cache/hit", data->keyid, 1);
+    assertTrue(ccnxValidationVerificationCache_VerifyMessage(cache, data->verifier, copy), "Expected the copy to pass");
+    assertTrue(data->testVerifier->verifications == 1, "Expected the copy to be a hit, got %u verifications", data->testVerifier->verifications);
+
+    CCNxValidationVerificationCacheStatistics statistics;
+    ccnxValidationVerificationCache_GetStatistics(cache, &statistics);
+    assertTrue(statistics.hits == 5, "Expected 5 hits, got %" PRIu64, statistics.hits);
+    assertTrue(statistics.misses == 1, "Expected 1 miss, got %" PRIu64, statistics.misses);
+    assertTrue(statistics.entries == 1, "Expected 1 entry, got %zu", statistics.entries);
+
+    ccnxTlvDictionary_Release(&copy);
+    ccnxTlvDictionary_Release(&message);
+    ccnxValidationVerificationCache_Release(&cache);
+}
+
+/**
+ * On a miss, an RSA-SHA256 signature is checked against the protected region digest computed for the key,
+ * while an HMAC, which is keyed, is hashed again with the verifier's hasher.
+ */
+LONGBOW_TEST_CASE(Global, ccnxValidationVerificationCache_VerifyMessage_Digest)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxValidationVerificationCache *cache = ccnxValidationVerificationCache_Create(64);
+    CCNxTlvDictionary *rsa = _createSignedMessageWithSuite("lci:/cache/rsa", data->keyid, 1, true);
+    CCNxTlvDictionary *hmac = _createSignedMessage("lci:/cache/hmac", data->keyid, 1);
+
+    assertTrue(ccnxValidationVerificationCache_VerifyMessage(cache, data->verifier, rsa), "Expected the RSA message to pass");
+    assertTrue(data->testVerifier->hasherRequests == 0, "Expected no hasher for RSA-SHA256, got %u", data->testVerifier->hasherRequests);
+
+    uint8_t expected[1][CCNxWireFormatMessage_SHA256DigestLength];
+    CCNxWireFormatMessage *wireFormat = (CCNxWireFormatMessage *) rsa;
+    ccnxWireFormatMessage_HashProtectedRegions(1, &wireFormat, expected, NULL);
+    assertTrue(memcmp(data->testVerifier->digest, expected[0], sizeof(expected[0])) == 0,
+               "The verifier was not given the protected region digest");
+
+    assertTrue(ccnxValidationVerificationCache_VerifyMessage(cache, data->verifier, hmac), "Expected the HMAC message to pass");
+    assertTrue(data->testVerifier->hasherRequests == 1, "Expected one hasher for HMAC-SHA256, got %u", data->testVerifier->hasherRequests);
+    assertTrue(data->testVerifier->verifications == 2, "Expected 2 verifications, got %u", data->testVerifier->verifications);
+
+    ccnxTlvDictionary_Release(&hmac);
+    ccnxTlvDictionary_Release(&rsa);
+    ccnxValidationVerificationCache_Release(&cache);
+}
+
+/**
+ * A bad signature over the same protected region as a good one must not be accepted from the cache, and
+ * failures are not cached.
+ */
+LONGBOW_TEST_CASE(Global, ccnxValidationVerificationCache_VerifyMessage_BadSignature)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxValidationVerificationCache *cache = ccnxValidationVerificationCache_Create(64);
+    CCNxTlvDictionary *good = _createSignedMessage("lci:/cache/forged", data->keyid, 1);
+    CCNxTlvDictionary *forged = _createSignedMessage("lci:/cache/forged", data->keyid, 0);
+
+    assertTrue(ccnxValidationVerificationCache_VerifyMessage(cache, data->verifier, good), "Expected the good message to pass");
+    assertFalse(ccnxValidationVerificationCache_VerifyMessage(cache, data->verifier, forged), "Expected the forged message to fail");
+    assertFalse(ccnxValidationVerificationCache_VerifyMessage(cache, data->verifier, forged), "Expected the forged message to fail again");
+    assertTrue(data->testVerifier->verifications == 3, "Expected 3 verifications, got %u", data->testVerifier->verifications);
+
+    CCNxValidationVerificationCacheStatistics statistics;
+    ccnxValidationVerificationCache_GetStatistics(cache, &statistics);
+    assertTrue(statistics.failures == 2, "Expected 2 failures, got %" PRIu64, statistics.failures);
+    assertTrue(statistics.entries == 1, "Expected 1 entry, got %zu", statistics.entries);
+
+    ccnxTlvDictionary_Release(&forged);
+    ccnxTlvDictionary_Release(&good);
+    ccnxValidationVerificationCache_Release(&cache);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationVerificationCache_VerifyMessage_NoKeyId)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxValidationVerificationCache *cache = ccnxValidationVerificationCache_Create(64);
+    CCNxTlvDictionary *message = _createSignedMessage("lci:/cache/nokeyid", NULL, 1);
+
+    assertFalse(ccnxValidationVerificationCache_VerifyMessage(cache, data->verifier, message), "Expected a message without a KeyId to fail");
+    assertTrue(data->testVerifier->verifications == 0, "Expected no verifications, got %u", data->testVerifier->verifications);
+
+    ccnxTlvDictionary_Release(&message);
+    ccnxValidationVerificationCache_Release(&cache);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationVerificationCache_VerifyMessage_Eviction)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxValidationVerificationCache *cache = ccnxValidationVerificationCache_Create(64);
+
+    const unsigned count = 200;
+    for (unsigned i = 0; i < count; i++) {
+        char uri[64];
+        snprintf(uri, sizeof(uri), "lci:/cache/eviction/chunk=%u", i);
+        CCNxTlvDictionary *message = _createSignedMessage(uri, data->keyid, 1);
+        assertTrue(ccnxValidationVerificationCache_VerifyMessage(cache, data->verifier, message), "Expected message %u to pass", i);
+        ccnxTlvDictionary_Release(&message);
+    }
+
+    CCNxValidationVerificationCacheStatistics statistics;
+    ccnxValidationVerificationCache_GetStatistics(cache, &statistics);
+    assertTrue(statistics.entries <= statistics.capacity, "Entries %zu exceed capacity %zu", statistics.entries, statistics.capacity);
+    assertTrue(statistics.entries + statistics.evictions == count, "Expected entries %zu + evictions %" PRIu64 " == %u",
+               statistics.entries, statistics.evictions, count);
+
+    ccnxValidationVerificationCache_Release(&cache);
+}
+
+typedef struct thread_arg {
+    CCNxValidationVerificationCache *cache;
+    CCNxTlvDictionary **messages;
+    size_t count;
+    unsigned passed;
+} _ThreadArg;
+
+static void *
+_verifyThread(void *voidArg)
+{
+    _ThreadArg *arg = voidArg;
+
+    // Each thread has its own verifier
+    _TestVerifier *testVerifier = parcObject_CreateAndClearInstance(_TestVerifier);
+    testVerifier->hasher = parcCryptoHasher_Create(PARCCryptoHashType_SHA256);
+    PARCVerifier *verifier = parcVerifier_Create(testVerifier, _testVerifierInterface);
+
+    for (int round = 0; round < 10; round++) {
+        for (size_t i = 0; i < arg->count; i++) {
+            if (ccnxValidationVerificationCache_VerifyMessage(arg->cache, verifier, arg->messages[i])) {
+                arg->passed++;
+            }
+        }
+    }
+
+    parcVerifier_Release(&verifier);
+    _testVerifier_Release(&testVerifier);
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationVerificationCache_VerifyMessage_Threads)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxValidationVerificationCache *cache = ccnxValidationVerificationCache_Create(1024);
+
+    const size_t count = 32;
+    CCNxTlvDictionary *messages[count];
+    for (size_t i = 0; i < count; i++) {
+        char uri[64];
+        snprintf(uri, sizeof(uri), "lci:/cache/threads/chunk=%zu", i);
+        messages[i] = _createSignedMessage(uri, data->keyid, 1);
+    }
+
+    const int threadCount = 4;
+    pthread_t threads[threadCount];
+    _ThreadArg args[threadCount];
+    for (int i = 0; i < threadCount; i++) {
+        args[i] = (_ThreadArg) { .cache = cache, .messages = messages, .count = count, .passed = 0 };
+        pthread_create(&threads[i], NULL, _verifyThread, &args[i]);
+    }
+    for (int i = 0; i < threadCount; i++) {
+        pthread_join(threads[i], NULL);
+        assertTrue(args[i].passed == 10 * count, "Thread %d: expected %zu passes, got %u", i, 10 * count, args[i].passed);
+    }
+
+    CCNxValidationVerificationCacheStatistics statistics;
+    ccnxValidationVerificationCache_GetStatistics(cache, &statistics);
+    assertTrue(statistics.hits + statistics.misses == threadCount * 10 * count, "Expected %zu lookups, got %" PRIu64,
+               threadCount * 10 * count, statistics.hits + statistics.misses);
+    assertTrue(statistics.misses >= count && statistics.misses <= threadCount * count, "Unexpected miss count %" PRIu64, statistics.misses);
+    assertTrue(statistics.entries == count, "Expected %zu entries, got %zu", count, statistics.entries);
+
+    for (size_t i = 0; i < count; i++) {
+        ccnxTlvDictionary_Release(&messages[i]);
+    }
+    ccnxValidationVerificationCache_Release(&cache);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationVerificationCache_Clear)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    CCNxValidationVerificationCache *cache = ccnxValidationVerificationCache_Create(64);
+    CCNxTlvDictionary *message = _createSignedMessage("lci:/cache/clear", data->keyid, 1);
+
+    ccnxValidationVerificationCache_VerifyMessage(cache, data->verifier, message);
+    ccnxValidationVerificationCache_Clear(cache);
+
+    CCNxValidationVerificationCacheStatistics statistics;
+    ccnxValidationVerificationCache_GetStatistics(cache, &statistics);
+    assertTrue(statistics.entries == 0, "Expected no entries after Clear, got %zu", statistics.entries);
+
+    ccnxValidationVerificationCache_VerifyMessage(cache, data->verifier, message);
+    assertTrue(data->testVerifier->verifications == 2, "Expected a miss after Clear, got %u verifications", data->testVerifier->verifications);
+
+    ccnxTlvDictionary_Release(&message);
+    ccnxValidationVerificationCache_Release(&cache);
+}
+
+LONGBOW_TEST_CASE(Global, ccnxValidationVerificationCache_Display)
+{
+    CCNxValidationVerificationCache *cache = ccnxValidationVerificationCache_Create(64);
+    ccnxValidationVerificationCache_Display(cache, 0);
+    ccnxValidationVerificationCache_Release(&cache);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(ccnxValidation_VerificationCache);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}